@@ -286,13 +286,41 @@ VmVariantList PyAllocateResults(FunctionAbi* self, VmVariantList& f_args,
 // out of scope.
 class PyBufferReleaser {
  public:
-  PyBufferReleaser(Py_buffer& b) : b_(b) {}
-  ~PyBufferReleaser() { PyBuffer_Release(&b_); }
+  PyBufferReleaser(Py_buffer& b) : b_(&b) {}
+  ~PyBufferReleaser() {
+    if (b_) PyBuffer_Release(b_);
+  }
+
+  // Transfers responsibility for releasing the buffer to the caller.
+  void Detach() { b_ = nullptr; }
 
  private:
-  Py_buffer& b_;
+  Py_buffer* b_;
 };
 
+// Minimum alignment of Python buffer contents that may be wrapped in HAL
+// buffers without copying. Less aligned buffers are copied into new
+// allocations so that CPU executables compiled to assume binding alignment up
+// to this value (--iree-codegen-llvm-binding-alignment) can use them. Note
+// that this is lower than the alignment of buffers allocated by the runtime
+// (see iree_hal_allocator_query_buffer_alignment) so that typical numpy arrays
+// can still be wrapped.
+constexpr uintptr_t kMinZeroCopyAlignment = 16;
+
+// Free function of the data allocator attached to HAL buffers that wrap
+// Python buffers. Releases the view (and with it the reference to the
+// exporting object) once the HAL buffer is destroyed. The last HAL buffer
+// reference may be dropped from any thread so the GIL must be acquired.
+void ReleaseWrappedPyBuffer(void* self, void* ptr) {
+  auto* py_view = static_cast<Py_buffer*>(self);
+  if (Py_IsInitialized()) {
+    PyGILState_STATE gil_state = PyGILState_Ensure();
+    PyBuffer_Release(py_view);
+    PyGILState_Release(gil_state);
+  }
+  delete py_view;
+}
+
 pybind11::error_already_set RaiseBufferMismatchError(
     std::string message, py::handle obj,
     const RawSignatureParser::Description& desc) {
@@ -712,8 +740,10 @@ void FunctionAbi::PackBuffer(const RawSignatureParser::Description& desc,
                              py::handle py_arg, VmVariantList& f_args,
                              bool writable) {
   // Request a view of the buffer (use the raw python C API to avoid some
-  // allocation and copying at the pybind level).
-  Py_buffer py_view;
+  // allocation and copying at the pybind level). The view is heap allocated
+  // as it may outlive this call when wrapped by the HAL buffer.
+  auto py_view_storage = std::make_unique<Py_buffer>();
+  Py_buffer& py_view = *py_view_storage;
   // Note that only C-Contiguous ND-arrays are presently supported, so
   // only request that via PyBUF_ND. Long term, we should consult an
   // "oracle" in the runtime to determine the precise required format and
@@ -730,39 +760,55 @@ void FunctionAbi::PackBuffer(const RawSignatureParser::Description& desc,
   }
   PyBufferReleaser py_view_releaser(py_view);
 
-  // Whether the py object needs to be retained with the argument.
-  // Should be set to true if directly mapping, false if copied.
-  bool depends_on_pyobject = false;
-
   // Verify compatibility.
   absl::InlinedVector<int, 2> dynamic_dims;
   MapBufferAttrs(py_view, desc, dynamic_dims);
 
-  // Allocate a HalBuffer.
-  // This is hard-coded to C-contiguous right now.
+  // Try to wrap the original memory and retain the exporting object for the
+  // lifetime of the HAL buffer (which spans at least the invocation). This is
+  // hard-coded to C-contiguous right now (guaranteed by PyBUF_ND).
+  // Functions may write to their arguments (such as tied operands updated in
+  // place) and the raw ABI does not tell us which ones so only arguments the
+  // caller has made writable are wrapped; all others are copied such that the
+  // caller's data is never modified.
   // TODO(laurenzo): Expand to other layouts as needed.
-  // TODO(laurenzo): Wrap and retain original buffer (depends_on_pyobject=true).
-  iree_hal_buffer_t* raw_buffer;
-  CheckApiStatus(iree_hal_allocator_allocate_buffer(
-                     device_.allocator(),
-                     static_cast<iree_hal_memory_type_t>(
-                         IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
-                         IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE),
-                     IREE_HAL_BUFFER_USAGE_ALL, py_view.len, &raw_buffer),
-                 "Failed to allocate device visible buffer");
-  CheckApiStatus(
-      iree_hal_buffer_write_data(raw_buffer, 0, py_view.buf, py_view.len),
-      "Error writing to input buffer");
+  iree_hal_buffer_t* raw_buffer = nullptr;
+  if (writable && py_view.len > 0 &&
+      reinterpret_cast<uintptr_t>(py_view.buf) % kMinZeroCopyAlignment == 0) {
+    iree_allocator_t py_view_allocator = {py_view_storage.get(), nullptr,
+                                          ReleaseWrappedPyBuffer};
+    iree_status_t status = iree_hal_allocator_wrap_buffer(
+        device_.allocator(),
+        static_cast<iree_hal_memory_type_t>(
+            IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
+            IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE),
+        IREE_HAL_MEMORY_ACCESS_ALL, IREE_HAL_BUFFER_USAGE_ALL,
+        iree_make_byte_span(py_view.buf, py_view.len), py_view_allocator,
+        &raw_buffer);
+    if (iree_status_is_ok(status)) {
+      // Only hand off the view once the wrap is guaranteed successful.
+      py_view_releaser.Detach();
+      py_view_storage.release();
+    } else {
+      // Allocators that cannot access host memory fall back to copying.
+      iree_status_ignore(status);
+      raw_buffer = nullptr;
+    }
+  }
 
-  // Only capture the reference to the exporting object (incrementing it)
-  // once guaranteed successful.
-  if (depends_on_pyobject) {
-    // Note for future implementation: there needs to be a place to stash
-    // references to be kept alive which back a buffer. This is likely an
-    // additional bag of refs returned from this function, which can then
-    // be attached to an invocation.
-    throw RaisePyError(PyExc_NotImplementedError,
-                       "Dependent buffer arguments not implemented");
+  // Allocate a HalBuffer and copy the contents if the memory was not
+  // directly mapped.
+  if (!raw_buffer) {
+    CheckApiStatus(iree_hal_allocator_allocate_buffer(
+                       device_.allocator(),
+                       static_cast<iree_hal_memory_type_t>(
+                           IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
+                           IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE),
+                       IREE_HAL_BUFFER_USAGE_ALL, py_view.len, &raw_buffer),
+                   "Failed to allocate device visible buffer");
+    CheckApiStatus(
+        iree_hal_buffer_write_data(raw_buffer, 0, py_view.buf, py_view.len),
+        "Error writing to input buffer");
   }
 
   // Create the buffer_view. (note that numpy shape is ssize_t)
@@ -834,6 +880,18 @@ void SetupFunctionAbiBindings(pybind11::module m) {
                         false /* writable */);
              return f_args;
            })
+      // Packs inputs by wrapping the memory of the arguments instead of
+      // copying it where possible. The function may modify the arguments in
+      // place and they must not be changed by the caller until the invocation
+      // completes.
+      .def("pack_inputs_aliased",
+           [](FunctionAbi* self, py::args py_args, py::kwargs py_kwargs) {
+             VmVariantList f_args = VmVariantList::Create(py_args.size());
+             self->Pack(py_args, py_kwargs,
+                        absl::MakeConstSpan(self->raw_config().inputs), f_args,
+                        true /* writable */);
+             return f_args;
+           })
       .def("serialize_vm_list",
            [](FunctionAbi* self, VmVariantList& vm_list) {
              return SerializeVmVariantList(vm_list);
@@ -196,6 +196,59 @@ class FunctionAbiTest(absltest.TestCase):
     self.assertEqual("<VmVariantList(1): [HalBufferView(10x128x64:0x3000020)]>",
                      repr(packed))
 
+  def test_static_arg_outlives_source(self):
+    fabi = iree.runtime.FunctionAbi(self.device, self.htf,
+                                    ATTRS_SIP_LINEAR_2ARG)
+    f_args = fabi.pack_inputs_aliased(np.full((1,), 2.0, dtype=np.float32),
+                                      np.full((1,), 3.0, dtype=np.float32))
+    # Arguments that are wrapped instead of copied must keep the source
+    # arrays alive after the caller drops them.
+    self.assertEqual(["1xf32=2", "1xf32=3"], fabi.serialize_vm_list(f_args))
+
+  def test_static_arg_unaligned_success(self):
+    fabi = iree.runtime.FunctionAbi(self.device, self.htf,
+                                    ATTRS_SIP_LINEAR_2ARG)
+    # Views that are not sufficiently aligned cannot be wrapped and are copied.
+    storage = np.full((8,), 4.0, dtype=np.float32)
+    offset = (-storage.ctypes.data % 16) // storage.itemsize + 1
+    arg0 = storage[offset:offset + 1]
+    arg1 = np.full((1,), 5.0, dtype=np.float32)
+    f_args = fabi.pack_inputs_aliased(arg0, arg1)
+    arg0[0] = 6.0
+    self.assertEqual(["1xf32=4", "1xf32=5"], fabi.serialize_vm_list(f_args))
+
+  def test_static_arg_copied(self):
+    fabi = iree.runtime.FunctionAbi(self.device, self.htf,
+                                    ATTRS_SIP_LINEAR_2ARG)
+    # The function may write its arguments so they are copied by default.
+    arg0 = np.full((1,), 2.0, dtype=np.float32)
+    arg1 = np.full((1,), 3.0, dtype=np.float32)
+    f_args = fabi.pack_inputs(arg0, arg1)
+    arg0[0] = 4.0
+    self.assertEqual(["1xf32=2", "1xf32=3"], fabi.serialize_vm_list(f_args))
+
+  def test_static_arg_aliased(self):
+    fabi = iree.runtime.FunctionAbi(self.device, self.htf,
+                                    ATTRS_SIP_LINEAR_2ARG)
+    # Aligned arguments packed with aliasing share memory with the source.
+    storage = np.full((8,), 2.0, dtype=np.float32)
+    offset = (-storage.ctypes.data % 16) // storage.itemsize
+    arg0 = storage[offset:offset + 1]
+    arg1 = np.full((1,), 3.0, dtype=np.float32)
+    f_args = fabi.pack_inputs_aliased(arg0, arg1)
+    arg0[0] = 4.0
+    self.assertEqual(["1xf32=4", "1xf32=3"], fabi.serialize_vm_list(f_args))
+
+  def test_static_arg_aliased_readonly(self):
+    fabi = iree.runtime.FunctionAbi(self.device, self.htf,
+                                    ATTRS_SIP_LINEAR_2ARG)
+    # Read-only arrays cannot be aliased as the function may write to them.
+    arg0 = np.full((1,), 2.0, dtype=np.float32)
+    arg0.flags.writeable = False
+    arg1 = np.full((1,), 3.0, dtype=np.float32)
+    with self.assertRaisesRegex(ValueError, "read-only"):
+      fabi.pack_inputs_aliased(arg0, arg1)
+
   def test_static_arg_rank_mismatch(self):
     fabi = iree.runtime.FunctionAbi(
         self.device, self.htf,
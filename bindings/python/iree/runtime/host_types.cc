@@ -132,7 +132,10 @@ class PyMappedMemory {
     }
   }
   PyMappedMemory(PyMappedMemory&& other)
-      : mapped_memory_(other.mapped_memory_), buf_(std::move(other.buf_)) {}
+      : parent_keep_alive_(std::move(other.parent_keep_alive_)),
+        desc_(std::move(other.desc_)),
+        mapped_memory_(other.mapped_memory_),
+        buf_(std::move(other.buf_)) {}
 
   const Description& desc() const { return desc_; }
 
@@ -189,7 +189,14 @@ class BoundFunction:
     self._serialized_inputs = None
     self._serialized_outputs = None
 
-  def __call__(self, *args, **kwargs):
+  def __call__(self, *args, alias_inputs: bool = False, **kwargs):
+    """Invokes the function with the given arguments.
+
+    By default array arguments are copied into new buffers. With alias_inputs
+    the memory of writable, sufficiently aligned arrays is wrapped instead of
+    copied; the function may then modify those arrays in place and they must
+    not be modified by the caller during the call.
+    """
     # Convert tensors, device arrays, ints, ... to IREE-friendly inputs.
     args = [normalize_value(value) for value in args]
     kwargs = {k: normalize_value(v) for k, v in kwargs.items()}
@@ -199,7 +206,10 @@ class BoundFunction:
     # NOTE: This is just doing sync dispatch right now. In the future,
     # this should default to async and potentially have some kind of policy
     # flag that can allow it to be overridden.
-    inputs = self._abi.pack_inputs(*args, **kwargs)
+    if alias_inputs:
+      inputs = self._abi.pack_inputs_aliased(*args, **kwargs)
+    else:
+      inputs = self._abi.pack_inputs(*args, **kwargs)
     self._serialized_inputs = tuple(self._abi.serialize_vm_list(inputs))
     results = self._abi.allocate_results(inputs, static_alloc=False)
     self._context._vm_context.invoke(self._vm_function, inputs, results)
@@ -94,6 +94,29 @@ class SystemApiTest(absltest.TestCase):
     results = f(arg0, arg1)
     np.testing.assert_allclose(results, [4., 10., 18., 28.])
 
+  def test_static_invoke_aliased(self):
+    ctx = iree.runtime.SystemContext()
+    ctx.add_module(create_simple_mul_module())
+    f = ctx.modules.arithmetic["simple_mul"]
+    arg0 = np.array([1., 2., 3., 4.], dtype=np.float32)
+    arg1 = np.array([4., 5., 6., 7.], dtype=np.float32)
+    results = f(arg0, arg1, alias_inputs=True)
+    np.testing.assert_allclose(results, [4., 10., 18., 28.])
+    np.testing.assert_allclose(arg0, [1., 2., 3., 4.])
+    np.testing.assert_allclose(arg1, [4., 5., 6., 7.])
+
+  def test_static_invoke_aliased_readonly(self):
+    ctx = iree.runtime.SystemContext()
+    ctx.add_module(create_simple_mul_module())
+    f = ctx.modules.arithmetic["simple_mul"]
+    arg0 = np.array([1., 2., 3., 4.], dtype=np.float32)
+    arg0.flags.writeable = False
+    arg1 = np.array([4., 5., 6., 7.], dtype=np.float32)
+    # Read-only arrays are copied by default but cannot be aliased.
+    np.testing.assert_allclose(f(arg0, arg1), [4., 10., 18., 28.])
+    with self.assertRaisesRegex(ValueError, "read-only"):
+      f(arg0, arg1, alias_inputs=True)
+
   def test_serialize_values(self):
     ctx = iree.runtime.SystemContext()
     self.assertTrue(ctx.is_dynamic)
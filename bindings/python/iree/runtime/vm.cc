@@ -20,6 +20,7 @@
 #include "bindings/python/iree/runtime/function_abi.h"
 #include "bindings/python/iree/runtime/status_utils.h"
 #include "iree/base/api.h"
+#include "iree/base/internal/file_mapping.h"
 #include "iree/base/status.h"
 #include "iree/hal/api.h"
 #include "iree/modules/hal/hal_module.h"
@@ -175,6 +176,25 @@ VmModule VmModule::FromFlatbufferBlob(py::buffer flatbuffer_blob) {
   return VmModule::CreateRetained(module);
 }
 
+VmModule VmModule::FromFlatbufferFile(const std::string& path) {
+  iree_file_mapping_t* mapping = nullptr;
+  CheckApiStatus(iree_file_mapping_open_read(path.c_str(),
+                                             iree_allocator_system(), &mapping),
+                 "Error mapping flatbuffer file");
+
+  // The module takes ownership of the mapping and releases it when destroyed.
+  iree_vm_module_t* module;
+  auto status = iree_vm_bytecode_module_create(
+      iree_file_mapping_contents(mapping),
+      iree_file_mapping_deallocator(mapping), iree_allocator_system(), &module);
+  if (!iree_status_is_ok(status)) {
+    iree_file_mapping_release(mapping);
+  }
+
+  CheckApiStatus(status, "Error creating vm module from flatbuffer file");
+  return VmModule::CreateRetained(module);
+}
+
 absl::optional<iree_vm_function_t> VmModule::LookupFunction(
     const std::string& name, iree_vm_function_linkage_t linkage) {
   iree_vm_function_t f;
@@ -280,6 +300,8 @@ void SetupVmBindings(pybind11::module m) {
 
   py::class_<VmModule>(m, "VmModule")
       .def_static("from_flatbuffer", &VmModule::FromFlatbufferBlob)
+      .def_static("from_flatbuffer_file", &VmModule::FromFlatbufferFile,
+                  py::arg("path"))
       .def_property_readonly("name", &VmModule::name)
       .def("lookup_function", &VmModule::LookupFunction, py::arg("name"),
            py::arg("linkage") = IREE_VM_FUNCTION_LINKAGE_EXPORT);
@@ -117,6 +117,11 @@ class VmModule : public ApiRefCounted<VmModule, iree_vm_module_t> {
  public:
   static VmModule FromFlatbufferBlob(py::buffer flatbuffer_blob);
 
+  // Creates a module from the flatbuffer file at |path|. The file is memory
+  // mapped instead of being read into memory such that the module contents are
+  // paged in on demand and shared across processes.
+  static VmModule FromFlatbufferFile(const std::string& path);
+
   absl::optional<iree_vm_function_t> LookupFunction(
       const std::string& name, iree_vm_function_linkage_t linkage);
 
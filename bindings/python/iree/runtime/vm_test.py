@@ -15,6 +15,9 @@
 
 # pylint: disable=unused-variable
 
+import os
+import tempfile
+
 from absl import logging
 from absl.testing import absltest
 import iree.compiler
@@ -98,6 +101,25 @@ class VmTest(absltest.TestCase):
     notfound = m.lookup_function("notfound")
     self.assertIs(notfound, None)
 
+  def test_module_from_flatbuffer_file(self):
+    binary = iree.compiler.compile_str(
+        """
+        func @add_scalar(%arg0: i32, %arg1: i32) -> i32 attributes { iree.module.export } {
+          %0 = addi %arg0, %arg1 : i32
+          return %0 : i32
+        }
+        """,
+        target_backends=["vmla"],
+    )
+    with tempfile.NamedTemporaryFile(suffix=".vmfb", delete=False) as f:
+      f.write(binary)
+      path = f.name
+    try:
+      m = iree.runtime.VmModule.from_flatbuffer_file(path)
+      self.assertIsNot(m.lookup_function("add_scalar"), None)
+    finally:
+      os.remove(path)
+
   def test_dynamic_module_context(self):
     instance = iree.runtime.VmInstance()
     context = iree.runtime.VmContext(instance)
@@ -14,7 +14,6 @@
 
 #include "bindings/tflite/model.h"
 
-#include <stdio.h>
 #include <string.h>
 
 #include "iree/base/tracing.h"
@@ -144,35 +143,36 @@ TFL_CAPI_EXPORT extern TfLiteModel* TfLiteModelCreateFromFile(
   iree_allocator_t allocator = iree_allocator_system();
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // TODO(#3909): use file mapping C API.
-  FILE* file = fopen(model_path, "r");
-  if (!file) {
-    IREE_TRACE_MESSAGE(ERROR, "failed to open model file");
+  // Map the file so that the model data is paged in on demand and shared with
+  // other processes loading the same model.
+  iree_file_mapping_t* mapping = NULL;
+  iree_status_t status =
+      iree_file_mapping_open_read(model_path, allocator, &mapping);
+  if (!iree_status_is_ok(iree_status_consume_code(status))) {
+    IREE_TRACE_MESSAGE(ERROR, "failed to map model file");
     IREE_TRACE_MESSAGE_DYNAMIC(ERROR, model_path, strlen(model_path));
     IREE_TRACE_ZONE_END(z0);
     return NULL;
   }
-  fseek(file, 0, SEEK_END);
-  size_t file_size = ftell(file);
-  fseek(file, 0, SEEK_SET);
+
   TfLiteModel* model = NULL;
-  iree_status_t status = iree_allocator_malloc(
-      allocator, sizeof(TfLiteModel) + file_size, (void**)&model);
+  status = iree_allocator_malloc(allocator, sizeof(*model), (void**)&model);
   if (!iree_status_is_ok(iree_status_consume_code(status))) {
-    IREE_TRACE_MESSAGE(ERROR, "failed model+data allocation");
+    IREE_TRACE_MESSAGE(ERROR, "failed model allocation");
+    iree_file_mapping_release(mapping);
     IREE_TRACE_ZONE_END(z0);
     return NULL;
   }
   memset(model, 0, sizeof(*model));
   iree_atomic_ref_count_init(&model->ref_count);
   model->allocator = allocator;
-  model->owned_model_data = (uint8_t*)model + file_size;
-  (void)fread(model->owned_model_data, 1, file_size, file);
-  fclose(file);
+  model->mapping = mapping;
 
-  status = _TfLiteModelInitializeModule(model->owned_model_data, file_size,
+  iree_const_byte_span_t model_data = iree_file_mapping_contents(mapping);
+  status = _TfLiteModelInitializeModule(model_data.data, model_data.data_length,
                                         allocator, model);
   if (!iree_status_is_ok(iree_status_consume_code(status))) {
+    _TfLiteModelRelease(model);
     IREE_TRACE_ZONE_END(z0);
     return NULL;
   }
@@ -191,6 +191,7 @@ void _TfLiteModelRelease(TfLiteModel* model) {
   if (model && iree_atomic_ref_count_dec(&model->ref_count) == 1) {
     IREE_TRACE_ZONE_BEGIN(z0);
     iree_vm_module_release(model->module);
+    iree_file_mapping_release(model->mapping);
     iree_allocator_free(model->allocator, model);
     IREE_TRACE_ZONE_END(z0);
   }
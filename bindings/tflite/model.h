@@ -17,6 +17,7 @@
 
 #include "iree/base/api.h"
 #include "iree/base/internal/atomics.h"
+#include "iree/base/internal/file_mapping.h"
 #include "iree/vm/api.h"
 
 // NOTE: we pull in our own copy here in case the tflite API changes upstream.
@@ -35,7 +36,8 @@ typedef struct _TfLiteModelExports {
 struct TfLiteModel {
   iree_atomic_ref_count_t ref_count;
   iree_allocator_t allocator;
-  void* owned_model_data;
+  // Mapping of the model file when created with TfLiteModelCreateFromFile.
+  iree_file_mapping_t* mapping;
 
   iree_vm_module_t* module;
   _TfLiteModelExports exports;
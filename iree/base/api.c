@@ -1002,18 +1002,18 @@ IREE_API_EXPORT iree_time_t iree_time_now() {
   GetSystemTimePreciseAsFileTime(&system_time);
 
   const int64_t kUnixEpochStartTicks = 116444736000000000i64;
-  const int64_t kFtToMicroSec = 10;
+  const int64_t kFtToNanoSec = 100;
   LARGE_INTEGER li;
   li.LowPart = system_time.dwLowDateTime;
   li.HighPart = system_time.dwHighDateTime;
   li.QuadPart -= kUnixEpochStartTicks;
-  li.QuadPart /= kFtToMicroSec;
+  li.QuadPart *= kFtToNanoSec;
   return li.QuadPart;
 #elif defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_APPLE) || \
     defined(IREE_PLATFORM_LINUX)
   struct timespec clock_time;
   clock_gettime(CLOCK_REALTIME, &clock_time);
-  return clock_time.tv_nsec;
+  return clock_time.tv_sec * 1000000000ll + clock_time.tv_nsec;
 #else
 #error "IREE system clock needs to be set up for your platform"
 #endif  // IREE_PLATFORM_*
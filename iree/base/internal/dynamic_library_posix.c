@@ -25,16 +25,33 @@
 
 #include <dlfcn.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)
+#include <sys/syscall.h>
+#if defined(SYS_memfd_create)
+// memfd_create is available in the kernel since 3.17 but glibc only added the
+// wrapper in 2.27 so we call the syscall directly.
+#define IREE_DYNAMIC_LIBRARY_HAVE_MEMFD 1
+#endif  // SYS_memfd_create
+#endif  // IREE_PLATFORM_ANDROID || IREE_PLATFORM_LINUX
+
 struct iree_dynamic_library_s {
   iree_atomic_ref_count_t ref_count;
   iree_allocator_t allocator;
 
   // dlopen shared object handle.
   void* handle;
+
+  // In-memory file the library was loaded from or -1 if loaded from a file on
+  // the filesystem. The file is kept open for the lifetime of the library so
+  // that its /proc/self/fd/ path is not reused by another library while this
+  // one is loaded (as the loader deduplicates libraries by path). Libraries
+  // leaked by tracing builds are detected at load time instead.
+  int memfd;
 };
 
 // Allocate a new string from |allocator| returned in |out_file_path| containing
@@ -145,6 +162,7 @@ static iree_status_t iree_dynamic_library_create(
   iree_atomic_ref_count_init(&library->ref_count);
   library->allocator = allocator;
   library->handle = handle;
+  library->memfd = -1;
 
   *out_library = library;
   return iree_ok_status();
@@ -191,10 +209,102 @@ iree_status_t iree_dynamic_library_load_from_files(
   return status;
 }
 
-// TODO(#3845): use dlopen on an fd with either dlopen(/proc/self/fd/NN),
-// fdlopen, or android_dlopen_ext to avoid needing to write the file to disk.
-// Can fallback to memfd_create + dlopen where available, and fallback from
-// that to disk (maybe just windows/mac).
+#if defined(IREE_DYNAMIC_LIBRARY_HAVE_MEMFD)
+
+// Writes all of |source_data| to |fd|, retrying on partial writes.
+static iree_status_t iree_dynamic_library_write_fd(
+    int fd, iree_const_byte_span_t source_data) {
+  const uint8_t* data = source_data.data;
+  iree_host_size_t remaining = source_data.data_length;
+  while (remaining > 0) {
+    ssize_t written = write(fd, data, remaining);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return iree_make_status(iree_status_code_from_errno(errno),
+                              "unable to write %zu bytes to memfd", remaining);
+    }
+    data += written;
+    remaining -= (iree_host_size_t)written;
+  }
+  return iree_ok_status();
+}
+
+// Loads the library contents in |buffer| from an anonymous in-memory file
+// created with memfd_create. This avoids touching the filesystem entirely,
+// which matters on systems with slow or read-only temp directories.
+//
+// Returns IREE_STATUS_UNAVAILABLE if memfd_create or /proc/self/fd/ is not
+// available such that the caller can fall back to a temp file. Failures from
+// dlopen itself are returned as-is as a temp file would not load either.
+static iree_status_t iree_dynamic_library_load_from_memfd(
+    iree_string_view_t identifier, iree_const_byte_span_t buffer,
+    iree_dynamic_library_flags_t flags, iree_allocator_t allocator,
+    iree_dynamic_library_t** out_library) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // The name is only used for debugging (it shows up in /proc/self/maps).
+  char name[64];
+  snprintf(name, sizeof(name), "iree_dylib_%.*s", (int)identifier.size,
+           identifier.data);
+  int fd = (int)syscall(SYS_memfd_create, name, /*MFD_CLOEXEC=*/1u);
+  if (fd < 0) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                            "memfd_create unavailable (%d)", errno);
+  }
+
+  iree_status_t status = iree_dynamic_library_write_fd(fd, buffer);
+
+  // dlopen requires a path and /proc/self/fd/ gives us one for the memfd.
+  void* handle = NULL;
+  char fd_path[32];
+  if (iree_status_is_ok(status)) {
+    snprintf(fd_path, sizeof(fd_path), "/proc/self/fd/%d", fd);
+    if (access(fd_path, R_OK) != 0) {
+      status = iree_make_status(IREE_STATUS_UNAVAILABLE,
+                                "/proc/self/fd unavailable (%d)", errno);
+    }
+  }
+  if (iree_status_is_ok(status)) {
+    // The loader deduplicates by path and a library leaked by a tracing build
+    // may still be registered under this fd number. Fall back to a temp file
+    // instead of silently getting the stale library back.
+    void* existing_handle = dlopen(fd_path, RTLD_LAZY | RTLD_NOLOAD);
+    if (existing_handle) {
+      dlclose(existing_handle);
+      status = iree_make_status(IREE_STATUS_UNAVAILABLE,
+                                "memfd path %s already loaded", fd_path);
+    }
+  }
+  if (iree_status_is_ok(status)) {
+    handle = dlopen(fd_path, RTLD_LAZY | RTLD_LOCAL);
+    if (!handle) {
+      // The library itself is bad; loading it from a temp file would fail the
+      // same way so return the loader error directly.
+      status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                                "dlopen of in-memory library failed: %s",
+                                dlerror());
+    }
+  }
+
+  iree_dynamic_library_t* library = NULL;
+  if (iree_status_is_ok(status)) {
+    status = iree_dynamic_library_create(handle, allocator, &library);
+  }
+
+  if (iree_status_is_ok(status)) {
+    library->memfd = fd;
+    *out_library = library;
+  } else {
+    if (handle) dlclose(handle);
+    close(fd);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+#endif  // IREE_DYNAMIC_LIBRARY_HAVE_MEMFD
+
 iree_status_t iree_dynamic_library_load_from_memory(
     iree_string_view_t identifier, iree_const_byte_span_t buffer,
     iree_dynamic_library_flags_t flags, iree_allocator_t allocator,
@@ -203,6 +313,21 @@ iree_status_t iree_dynamic_library_load_from_memory(
   IREE_ASSERT_ARGUMENT(out_library);
   *out_library = NULL;
 
+#if defined(IREE_DYNAMIC_LIBRARY_HAVE_MEMFD)
+  // Try loading from an in-memory file first and only fall back to the
+  // filesystem if the platform does not support it (old kernels, sandboxes
+  // without /proc, etc).
+  iree_status_t memfd_status = iree_dynamic_library_load_from_memfd(
+      identifier, buffer, flags, allocator, out_library);
+  if (!iree_status_is_unavailable(memfd_status)) {
+    IREE_TRACE_ZONE_END(z0);
+    return memfd_status;
+  }
+  iree_status_ignore(memfd_status);
+#endif  // IREE_DYNAMIC_LIBRARY_HAVE_MEMFD
+
+  // TODO(#3845): use fdlopen or android_dlopen_ext on platforms without
+  // memfd_create to avoid needing to write the file to disk.
   // Extract the library to a temp file.
   char* temp_path = NULL;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
@@ -241,6 +366,12 @@ static void iree_dynamic_library_delete(iree_dynamic_library_t* library) {
   }
 #endif  // IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
 
+  // The loader keeps its own mapping of the file so the memfd can always be
+  // closed, even if the library itself is leaked above.
+  if (library->memfd != -1) {
+    close(library->memfd);
+  }
+
   iree_allocator_free(allocator, library);
 
   IREE_TRACE_ZONE_END(z0);
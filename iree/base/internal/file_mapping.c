@@ -0,0 +1,221 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/base/internal/file_mapping.h"
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/target_platform.h"
+#include "iree/base/tracing.h"
+
+#if defined(IREE_PLATFORM_WINDOWS)
+// Windows.h is included via target_platform.h.
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif  // IREE_PLATFORM_WINDOWS
+
+struct iree_file_mapping_s {
+  iree_atomic_ref_count_t ref_count;
+  iree_allocator_t allocator;
+
+  // Mapped file contents. Empty files cannot be mapped and instead reference
+  // iree_file_mapping_empty_data so that the data pointer is never NULL.
+  iree_const_byte_span_t contents;
+
+#if defined(IREE_PLATFORM_WINDOWS)
+  // File mapping object backing the mapped view.
+  HANDLE mapping_handle;
+#endif  // IREE_PLATFORM_WINDOWS
+};
+
+// Non-NULL storage used as the contents of empty files.
+static const uint8_t iree_file_mapping_empty_data[1] = {0};
+
+//===----------------------------------------------------------------------===//
+// Platform-specific mapping
+//===----------------------------------------------------------------------===//
+
+#if defined(IREE_PLATFORM_WINDOWS)
+
+static iree_status_t iree_file_mapping_map_platform(
+    const char* path, iree_file_mapping_t* mapping) {
+  HANDLE file_handle =
+      CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+  if (file_handle == INVALID_HANDLE_VALUE) {
+    return iree_make_status(
+        iree_status_code_from_win32_error(GetLastError()),
+        "failed to open file '%s'", path);
+  }
+
+  iree_status_t status = iree_ok_status();
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file_handle, &file_size)) {
+    status = iree_make_status(iree_status_code_from_win32_error(GetLastError()),
+                              "failed to query size of file '%s'", path);
+  }
+
+  // Mapping empty files is not allowed so we leave the contents empty.
+  if (iree_status_is_ok(status) && file_size.QuadPart > 0) {
+    mapping->mapping_handle =
+        CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping->mapping_handle) {
+      status =
+          iree_make_status(iree_status_code_from_win32_error(GetLastError()),
+                           "failed to create mapping of file '%s'", path);
+    }
+  }
+  if (iree_status_is_ok(status) && mapping->mapping_handle) {
+    void* data = MapViewOfFile(mapping->mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+      status =
+          iree_make_status(iree_status_code_from_win32_error(GetLastError()),
+                           "failed to map view of file '%s'", path);
+    } else {
+      mapping->contents = iree_make_const_byte_span(
+          data, (iree_host_size_t)file_size.QuadPart);
+    }
+  }
+
+  // The mapping retains the file and we no longer need our handle.
+  CloseHandle(file_handle);
+  return status;
+}
+
+static void iree_file_mapping_unmap_platform(iree_file_mapping_t* mapping) {
+  if (mapping->contents.data_length > 0) {
+    UnmapViewOfFile(mapping->contents.data);
+  }
+  if (mapping->mapping_handle) {
+    CloseHandle(mapping->mapping_handle);
+  }
+}
+
+#else
+
+static iree_status_t iree_file_mapping_map_platform(
+    const char* path, iree_file_mapping_t* mapping) {
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "failed to open file '%s'", path);
+  }
+
+  iree_status_t status = iree_ok_status();
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    status = iree_make_status(iree_status_code_from_errno(errno),
+                              "failed to query size of file '%s'", path);
+  }
+
+  // Mapping empty files is not allowed so we leave the contents empty.
+  if (iree_status_is_ok(status) && file_stat.st_size > 0) {
+    void* data = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_SHARED,
+                      fd, 0);
+    if (data == MAP_FAILED) {
+      status = iree_make_status(iree_status_code_from_errno(errno),
+                                "failed to map file '%s'", path);
+    } else {
+      mapping->contents =
+          iree_make_const_byte_span(data, (iree_host_size_t)file_stat.st_size);
+    }
+  }
+
+  // The mapping retains the file and we no longer need our descriptor.
+  close(fd);
+  return status;
+}
+
+static void iree_file_mapping_unmap_platform(iree_file_mapping_t* mapping) {
+  if (mapping->contents.data_length > 0) {
+    munmap((void*)mapping->contents.data, mapping->contents.data_length);
+  }
+}
+
+#endif  // IREE_PLATFORM_WINDOWS
+
+//===----------------------------------------------------------------------===//
+// iree_file_mapping_t
+//===----------------------------------------------------------------------===//
+
+iree_status_t iree_file_mapping_open_read(
+    const char* path, iree_allocator_t allocator,
+    iree_file_mapping_t** out_mapping) {
+  IREE_ASSERT_ARGUMENT(path);
+  IREE_ASSERT_ARGUMENT(out_mapping);
+  *out_mapping = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_file_mapping_t* mapping = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(allocator, sizeof(*mapping), (void**)&mapping));
+  memset(mapping, 0, sizeof(*mapping));
+  iree_atomic_ref_count_init(&mapping->ref_count);
+  mapping->allocator = allocator;
+  mapping->contents =
+      iree_make_const_byte_span(iree_file_mapping_empty_data, 0);
+
+  iree_status_t status = iree_file_mapping_map_platform(path, mapping);
+
+  if (iree_status_is_ok(status)) {
+    *out_mapping = mapping;
+  } else {
+    iree_file_mapping_unmap_platform(mapping);
+    iree_allocator_free(allocator, mapping);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static void iree_file_mapping_destroy(iree_file_mapping_t* mapping) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_file_mapping_unmap_platform(mapping);
+  iree_allocator_free(mapping->allocator, mapping);
+  IREE_TRACE_ZONE_END(z0);
+}
+
+void iree_file_mapping_retain(iree_file_mapping_t* mapping) {
+  if (mapping) {
+    iree_atomic_ref_count_inc(&mapping->ref_count);
+  }
+}
+
+void iree_file_mapping_release(iree_file_mapping_t* mapping) {
+  if (mapping && iree_atomic_ref_count_dec(&mapping->ref_count) == 1) {
+    iree_file_mapping_destroy(mapping);
+  }
+}
+
+iree_const_byte_span_t iree_file_mapping_contents(
+    const iree_file_mapping_t* mapping) {
+  IREE_ASSERT_ARGUMENT(mapping);
+  return mapping->contents;
+}
+
+static void iree_file_mapping_deallocator_free(void* self, void* ptr) {
+  iree_file_mapping_release((iree_file_mapping_t*)self);
+}
+
+iree_allocator_t iree_file_mapping_deallocator(iree_file_mapping_t* mapping) {
+  iree_allocator_t allocator = {
+      /*self=*/mapping,
+      /*alloc=*/NULL,
+      /*free=*/iree_file_mapping_deallocator_free,
+  };
+  return allocator;
+}
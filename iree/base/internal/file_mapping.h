@@ -0,0 +1,64 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IREE_BASE_INTERNAL_FILE_MAPPING_H_
+#define IREE_BASE_INTERNAL_FILE_MAPPING_H_
+
+#include "iree/base/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A read-only view of a file mapped into host memory.
+//
+// The contents are demand-paged from the system file cache instead of being
+// read into private heap memory. This keeps the resident memory of large files
+// (such as modules with big constant pools) down to what is actually touched
+// and allows the pages to be shared across processes mapping the same file.
+typedef struct iree_file_mapping_s iree_file_mapping_t;
+
+// Maps the entire file at |path| into memory for reading.
+// The file contents must not be modified for the lifetime of the mapping.
+iree_status_t iree_file_mapping_open_read(
+    const char* path, iree_allocator_t allocator,
+    iree_file_mapping_t** out_mapping);
+
+// Retains the given |mapping| for the caller.
+void iree_file_mapping_retain(iree_file_mapping_t* mapping);
+
+// Releases the given |mapping| from the caller.
+void iree_file_mapping_release(iree_file_mapping_t* mapping);
+
+// Returns the mapped contents of the file. Valid for the lifetime of the
+// mapping.
+iree_const_byte_span_t iree_file_mapping_contents(
+    const iree_file_mapping_t* mapping);
+
+// Returns an allocator that releases |mapping| when the contents are freed.
+// This allows a reference to the mapping to be transferred to APIs taking a
+// deallocator for their data such as iree_vm_bytecode_module_create. The
+// caller retains ownership if the API fails and must release the mapping.
+//
+// Example:
+//   iree_vm_bytecode_module_create(iree_file_mapping_contents(mapping),
+//                                  iree_file_mapping_deallocator(mapping),
+//                                  allocator, &module);
+iree_allocator_t iree_file_mapping_deallocator(iree_file_mapping_t* mapping);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // IREE_BASE_INTERNAL_FILE_MAPPING_H_
@@ -0,0 +1,107 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/base/internal/file_mapping.h"
+
+#include <cstdio>
+#include <string>
+
+#include "iree/base/internal/file_io.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace {
+
+using ::iree::testing::status::StatusIs;
+
+std::string GetUniquePath(const char* unique_name) {
+  char* test_tmpdir = getenv("TEST_TMPDIR");
+  if (!test_tmpdir) {
+    test_tmpdir = getenv("TMPDIR");
+  }
+  if (!test_tmpdir) {
+    test_tmpdir = getenv("TEMP");
+  }
+  IREE_CHECK(test_tmpdir) << "TEST_TMPDIR/TMPDIR/TEMP not defined";
+  return test_tmpdir + std::string("/iree_test_") + unique_name;
+}
+
+std::string MapContents(iree_file_mapping_t* mapping) {
+  iree_const_byte_span_t contents = iree_file_mapping_contents(mapping);
+  return std::string(reinterpret_cast<const char*>(contents.data),
+                     contents.data_length);
+}
+
+TEST(FileMapping, OpenRead) {
+  auto path = GetUniquePath("FileMappingOpenRead");
+  std::string to_write = "Test with name FileMappingOpenRead\n";
+  IREE_ASSERT_OK(file_io::SetFileContents(
+      path.c_str(),
+      iree_make_const_byte_span(to_write.data(), to_write.size())));
+
+  iree_file_mapping_t* mapping = NULL;
+  IREE_ASSERT_OK(iree_file_mapping_open_read(
+      path.c_str(), iree_allocator_system(), &mapping));
+  EXPECT_EQ(to_write, MapContents(mapping));
+  iree_file_mapping_release(mapping);
+}
+
+TEST(FileMapping, OpenReadEmpty) {
+  auto path = GetUniquePath("FileMappingOpenReadEmpty");
+  FILE* file = fopen(path.c_str(), "wb");
+  ASSERT_NE(nullptr, file);
+  fclose(file);
+
+  iree_file_mapping_t* mapping = NULL;
+  IREE_ASSERT_OK(iree_file_mapping_open_read(
+      path.c_str(), iree_allocator_system(), &mapping));
+  iree_const_byte_span_t contents = iree_file_mapping_contents(mapping);
+  EXPECT_NE(nullptr, contents.data);
+  EXPECT_EQ(0, contents.data_length);
+  iree_file_mapping_release(mapping);
+}
+
+TEST(FileMapping, OpenReadNotFound) {
+  auto path = GetUniquePath("FileMappingOpenReadNotFound");
+  iree_file_mapping_t* mapping = NULL;
+  EXPECT_THAT(iree_file_mapping_open_read(path.c_str(),
+                                          iree_allocator_system(), &mapping),
+              StatusIs(StatusCode::kNotFound));
+  EXPECT_EQ(nullptr, mapping);
+}
+
+TEST(FileMapping, Deallocator) {
+  auto path = GetUniquePath("FileMappingDeallocator");
+  std::string to_write = "Test with name FileMappingDeallocator\n";
+  IREE_ASSERT_OK(file_io::SetFileContents(
+      path.c_str(),
+      iree_make_const_byte_span(to_write.data(), to_write.size())));
+
+  iree_file_mapping_t* mapping = NULL;
+  IREE_ASSERT_OK(iree_file_mapping_open_read(
+      path.c_str(), iree_allocator_system(), &mapping));
+
+  // The deallocator should release the reference it was given; retain one for
+  // ourselves to check the contents are still valid afterward.
+  iree_file_mapping_retain(mapping);
+  iree_allocator_t deallocator = iree_file_mapping_deallocator(mapping);
+  iree_allocator_free(deallocator,
+                      (void*)iree_file_mapping_contents(mapping).data);
+  EXPECT_EQ(to_write, MapContents(mapping));
+  iree_file_mapping_release(mapping);
+}
+
+}  // namespace
+}  // namespace iree
@@ -0,0 +1,286 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/base/internal/numa.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iree/base/target_platform.h"
+#include "iree/base/tracing.h"
+
+#if defined(IREE_PLATFORM_LINUX) || defined(IREE_PLATFORM_ANDROID)
+#include <dirent.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(SYS_mbind)
+#define IREE_NUMA_HAVE_MBIND 1
+#endif  // SYS_mbind
+#endif  // IREE_PLATFORM_LINUX || IREE_PLATFORM_ANDROID
+
+//===----------------------------------------------------------------------===//
+// Node queries
+//===----------------------------------------------------------------------===//
+
+#if defined(IREE_PLATFORM_LINUX) || defined(IREE_PLATFORM_ANDROID)
+
+iree_host_size_t iree_numa_node_count(void) {
+  // The file contains a cpulist-style range such as "0" or "0-3"; the last
+  // number is the highest node ID.
+  FILE* file = fopen("/sys/devices/system/node/possible", "r");
+  if (!file) return 1;
+  char buffer[64] = {0};
+  size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+  fclose(file);
+  unsigned int max_node_id = 0;
+  for (size_t i = 0; i < length;) {
+    unsigned int node_id = 0;
+    int consumed = 0;
+    if (sscanf(buffer + i, "%u%n", &node_id, &consumed) != 1) {
+      ++i;
+      continue;
+    }
+    if (node_id > max_node_id) max_node_id = node_id;
+    i += consumed;
+  }
+  return (iree_host_size_t)max_node_id + 1;
+}
+
+// Parses the sysfs node list file at |path| (cpulist format such as "0-1,3")
+// into up to |capacity| IDs in |out_node_ids| and returns the total count.
+// Returns 0 if the file could not be read.
+static iree_host_size_t iree_numa_parse_node_list(
+    const char* path, iree_host_size_t capacity,
+    iree_numa_node_id_t* out_node_ids) {
+  FILE* file = fopen(path, "r");
+  if (!file) return 0;
+  char buffer[256] = {0};
+  size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+  fclose(file);
+  iree_host_size_t count = 0;
+  for (size_t i = 0; i < length;) {
+    unsigned int first_id = 0;
+    unsigned int last_id = 0;
+    int consumed = 0;
+    if (sscanf(buffer + i, "%u%n", &first_id, &consumed) != 1) {
+      ++i;
+      continue;
+    }
+    i += consumed;
+    last_id = first_id;
+    if (buffer[i] == '-' &&
+        sscanf(buffer + i + 1, "%u%n", &last_id, &consumed) == 1) {
+      i += 1 + consumed;
+    }
+    for (unsigned int id = first_id; id <= last_id; ++id) {
+      if (count < capacity) out_node_ids[count] = id;
+      ++count;
+    }
+  }
+  return count;
+}
+
+iree_host_size_t iree_numa_query_cpu_nodes(iree_host_size_t capacity,
+                                           iree_numa_node_id_t* out_node_ids) {
+  // has_cpu lists only online nodes with processors; kernels without it
+  // (pre-2.6.35) get the online list, which may include memory-only nodes.
+  iree_host_size_t count = iree_numa_parse_node_list(
+      "/sys/devices/system/node/has_cpu", capacity, out_node_ids);
+  if (!count) {
+    count = iree_numa_parse_node_list("/sys/devices/system/node/online",
+                                      capacity, out_node_ids);
+  }
+  if (!count) {
+    if (capacity) out_node_ids[0] = 0;
+    count = 1;
+  }
+  return count;
+}
+
+iree_numa_node_id_t iree_numa_node_for_processor(uint32_t processor_id) {
+  // Each CPU directory contains a nodeN link to the node it is attached to.
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u", processor_id);
+  DIR* dir = opendir(path);
+  if (!dir) return 0;
+  iree_numa_node_id_t node_id = 0;
+  struct dirent* entry = NULL;
+  while ((entry = readdir(dir)) != NULL) {
+    unsigned int value = 0;
+    if (strncmp(entry->d_name, "node", 4) == 0 &&
+        sscanf(entry->d_name + 4, "%u", &value) == 1) {
+      node_id = value;
+      break;
+    }
+  }
+  closedir(dir);
+  return node_id;
+}
+
+#else
+
+iree_host_size_t iree_numa_node_count(void) { return 1; }
+
+iree_host_size_t iree_numa_query_cpu_nodes(iree_host_size_t capacity,
+                                           iree_numa_node_id_t* out_node_ids) {
+  if (capacity) out_node_ids[0] = 0;
+  return 1;
+}
+
+iree_numa_node_id_t iree_numa_node_for_processor(uint32_t processor_id) {
+  return 0;
+}
+
+#endif  // IREE_PLATFORM_LINUX || IREE_PLATFORM_ANDROID
+
+//===----------------------------------------------------------------------===//
+// Node-local allocator
+//===----------------------------------------------------------------------===//
+
+// Allocations smaller than this are made from the system allocator.
+#define IREE_NUMA_MIN_PLACED_ALLOCATION_SIZE (64 * 1024)
+
+// Header prefixed to every allocation so that frees and reallocations know how
+// the allocation was made. Sized to keep the user pointer SIMD aligned.
+typedef struct {
+  // Size of the user allocation following the header.
+  iree_host_size_t byte_length;
+  // Total length of the mapping backing the allocation or 0 if the allocation
+  // came from the system allocator.
+  iree_host_size_t mapping_length;
+  uint8_t reserved[64 - 2 * sizeof(iree_host_size_t)];
+} iree_numa_allocation_header_t;
+
+static iree_status_t iree_numa_allocate_placed(iree_numa_node_id_t node_id,
+                                               iree_host_size_t byte_length,
+                                               void** out_ptr) {
+#if defined(IREE_NUMA_HAVE_MBIND)
+  iree_host_size_t page_size = (iree_host_size_t)sysconf(_SC_PAGESIZE);
+  iree_host_size_t mapping_length =
+      (sizeof(iree_numa_allocation_header_t) + byte_length + page_size - 1) &
+      ~(page_size - 1);
+  void* base = mmap(NULL, mapping_length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "failed to map %zu bytes for node %u",
+                            mapping_length, node_id);
+  }
+
+  // Pages are not yet populated so setting the policy now places them on the
+  // node as they are touched. Failure (such as running in a container without
+  // permission) is not fatal: the memory is still usable, just not placed.
+  unsigned long node_mask[16] = {0};
+  const unsigned long bits_per_word = sizeof(node_mask[0]) * 8;
+  if (node_id < IREE_ARRAYSIZE(node_mask) * bits_per_word) {
+    node_mask[node_id / bits_per_word] = 1ul << (node_id % bits_per_word);
+    const int mpol_preferred = 1;  // MPOL_PREFERRED from <linux/mempolicy.h>
+    syscall(SYS_mbind, base, mapping_length, mpol_preferred, node_mask,
+            IREE_ARRAYSIZE(node_mask) * bits_per_word + 1, 0);
+  }
+
+  iree_numa_allocation_header_t* header =
+      (iree_numa_allocation_header_t*)base;
+  header->byte_length = byte_length;
+  header->mapping_length = mapping_length;
+  *out_ptr = header + 1;
+  return iree_ok_status();
+#else
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "NUMA placement not supported");
+#endif  // IREE_NUMA_HAVE_MBIND
+}
+
+static iree_status_t iree_numa_allocate_system(iree_allocation_mode_t mode,
+                                               iree_host_size_t byte_length,
+                                               void** out_ptr) {
+  void* base = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_system_allocate(
+      NULL, mode & IREE_ALLOCATION_MODE_ZERO_CONTENTS,
+      sizeof(iree_numa_allocation_header_t) + byte_length, &base));
+  iree_numa_allocation_header_t* header =
+      (iree_numa_allocation_header_t*)base;
+  header->byte_length = byte_length;
+  header->mapping_length = 0;
+  *out_ptr = header + 1;
+  return iree_ok_status();
+}
+
+static void iree_numa_free(void* self, void* ptr) {
+  if (!ptr) return;
+  iree_numa_allocation_header_t* header =
+      (iree_numa_allocation_header_t*)ptr - 1;
+  if (header->mapping_length) {
+#if defined(IREE_NUMA_HAVE_MBIND)
+    munmap(header, header->mapping_length);
+#endif  // IREE_NUMA_HAVE_MBIND
+  } else {
+    iree_allocator_system_free(NULL, header);
+  }
+}
+
+static iree_status_t iree_numa_allocate(void* self, iree_allocation_mode_t mode,
+                                        iree_host_size_t byte_length,
+                                        void** out_ptr) {
+  IREE_ASSERT_ARGUMENT(out_ptr);
+  if (byte_length == 0) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "allocations must be >0 bytes");
+  }
+  iree_numa_node_id_t node_id = (iree_numa_node_id_t)(uintptr_t)self;
+
+  // Fresh mappings are always zeroed so we don't need to handle the mode.
+  void* ptr = NULL;
+  iree_status_t status = iree_status_from_code(IREE_STATUS_UNAVAILABLE);
+  if (node_id != IREE_NUMA_NODE_ANY &&
+      byte_length >= IREE_NUMA_MIN_PLACED_ALLOCATION_SIZE) {
+    status = iree_numa_allocate_placed(node_id, byte_length, &ptr);
+  }
+  if (iree_status_is_unavailable(status)) {
+    iree_status_ignore(status);
+    status = iree_numa_allocate_system(mode, byte_length, &ptr);
+  }
+  IREE_RETURN_IF_ERROR(status);
+
+  // Reallocation is always a copy as the new allocation may need to be made
+  // through a different path than the existing one.
+  void* existing_ptr = *out_ptr;
+  if (existing_ptr && (mode & IREE_ALLOCATION_MODE_TRY_REUSE_EXISTING)) {
+    const iree_numa_allocation_header_t* existing_header =
+        (const iree_numa_allocation_header_t*)existing_ptr - 1;
+    iree_host_size_t copy_length =
+        iree_min(existing_header->byte_length, byte_length);
+    memcpy(ptr, existing_ptr, copy_length);
+    if ((mode & IREE_ALLOCATION_MODE_ZERO_CONTENTS) &&
+        byte_length > copy_length) {
+      memset((uint8_t*)ptr + copy_length, 0, byte_length - copy_length);
+    }
+    iree_numa_free(self, existing_ptr);
+  }
+
+  *out_ptr = ptr;
+  return iree_ok_status();
+}
+
+iree_allocator_t iree_numa_node_allocator(iree_numa_node_id_t node_id) {
+  iree_allocator_t allocator = {
+      /*self=*/(void*)(uintptr_t)node_id,
+      /*alloc=*/iree_numa_allocate,
+      /*free=*/iree_numa_free,
+  };
+  return allocator;
+}
@@ -0,0 +1,62 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IREE_BASE_INTERNAL_NUMA_H_
+#define IREE_BASE_INTERNAL_NUMA_H_
+
+#include "iree/base/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Identifies a NUMA node (memory domain) on the system.
+// Systems without NUMA support (or platforms where we can't query it) report
+// all processors and memory as belonging to node 0.
+typedef uint32_t iree_numa_node_id_t;
+
+// Indicates that no specific NUMA node is preferred.
+#define IREE_NUMA_NODE_ANY UINT32_MAX
+
+// Returns the total number of NUMA nodes on the system (always >= 1).
+iree_host_size_t iree_numa_node_count(void);
+
+// Queries the IDs of the online NUMA nodes that have processors attached in
+// ascending order. Memory-only nodes and offline nodes are excluded and the
+// IDs may not be contiguous. Up to |capacity| IDs are written to
+// |out_node_ids| and the total number of such nodes is returned (always >= 1).
+iree_host_size_t iree_numa_query_cpu_nodes(iree_host_size_t capacity,
+                                           iree_numa_node_id_t* out_node_ids);
+
+// Returns the NUMA node the OS processor with |processor_id| is attached to.
+// On Linux |processor_id| is the logical CPU number as used by
+// sched_setaffinity (cpuinfo linux_id). Returns 0 if unknown.
+iree_numa_node_id_t iree_numa_node_for_processor(uint32_t processor_id);
+
+// Returns an allocator that places the pages of its allocations on the
+// given NUMA |node_id| instead of whichever node first touches them.
+// Allocations are preferred but not required to be on the node such that
+// exhaustion of the node falls back to others instead of failing.
+//
+// Small allocations are routed to the system allocator as the page granularity
+// of placement would waste more memory than it saves in bandwidth. If NUMA
+// placement is not supported or |node_id| is IREE_NUMA_NODE_ANY all
+// allocations are routed to the system allocator.
+iree_allocator_t iree_numa_node_allocator(iree_numa_node_id_t node_id);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // IREE_BASE_INTERNAL_NUMA_H_
@@ -0,0 +1,98 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/base/internal/numa.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+TEST(NUMA, NodeQueries) {
+  iree_host_size_t node_count = iree_numa_node_count();
+  EXPECT_GE(node_count, 1);
+  EXPECT_LT(iree_numa_node_for_processor(0), node_count);
+}
+
+TEST(NUMA, QueryCPUNodes) {
+  iree_host_size_t node_count = iree_numa_query_cpu_nodes(0, NULL);
+  ASSERT_GE(node_count, 1);
+  EXPECT_LE(node_count, iree_numa_node_count());
+  std::vector<iree_numa_node_id_t> node_ids(node_count);
+  EXPECT_EQ(node_count,
+            iree_numa_query_cpu_nodes(node_ids.size(), node_ids.data()));
+  for (iree_host_size_t i = 0; i < node_count; ++i) {
+    EXPECT_LT(node_ids[i], iree_numa_node_count());
+  }
+  EXPECT_TRUE(std::is_sorted(node_ids.begin(), node_ids.end()));
+
+  // The node of the first processor must have a processor attached.
+  EXPECT_NE(node_ids.end(), std::find(node_ids.begin(), node_ids.end(),
+                                      iree_numa_node_for_processor(0)));
+}
+
+// Returns true if all |length| bytes of |ptr| are zero.
+bool IsZero(const void* ptr, iree_host_size_t length) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(ptr);
+  for (iree_host_size_t i = 0; i < length; ++i) {
+    if (bytes[i]) return false;
+  }
+  return true;
+}
+
+TEST(NUMA, AllocateSmallAndLarge) {
+  iree_allocator_t allocator = iree_numa_node_allocator(0);
+  for (iree_host_size_t length : {16, 4096, 1024 * 1024}) {
+    void* ptr = NULL;
+    IREE_ASSERT_OK(iree_allocator_malloc(allocator, length, &ptr));
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(ptr) % 16);
+    EXPECT_TRUE(IsZero(ptr, length));
+    memset(ptr, 0xCD, length);
+    iree_allocator_free(allocator, ptr);
+  }
+}
+
+TEST(NUMA, ReallocPreservesContents) {
+  iree_allocator_t allocator = iree_numa_node_allocator(0);
+  void* ptr = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 128, &ptr));
+  memset(ptr, 0xAB, 128);
+
+  // Grow across the placement threshold and then shrink back.
+  IREE_ASSERT_OK(iree_allocator_realloc(allocator, 256 * 1024, &ptr));
+  for (int i = 0; i < 128; ++i) {
+    ASSERT_EQ(0xAB, reinterpret_cast<uint8_t*>(ptr)[i]);
+  }
+  IREE_ASSERT_OK(iree_allocator_realloc(allocator, 64, &ptr));
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_EQ(0xAB, reinterpret_cast<uint8_t*>(ptr)[i]);
+  }
+  iree_allocator_free(allocator, ptr);
+}
+
+TEST(NUMA, AnyNode) {
+  iree_allocator_t allocator = iree_numa_node_allocator(IREE_NUMA_NODE_ANY);
+  void* ptr = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 1024 * 1024, &ptr));
+  EXPECT_TRUE(IsZero(ptr, 1024 * 1024));
+  iree_allocator_free(allocator, ptr);
+}
+
+}  // namespace
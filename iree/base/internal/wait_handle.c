@@ -31,3 +31,9 @@ iree_status_t iree_wait_handle_wrap_primitive(
 void iree_wait_handle_deinitialize(iree_wait_handle_t* handle) {
   memset(handle, 0, sizeof(*handle));
 }
+
+bool iree_wait_primitive_compare_identical(const iree_wait_handle_t* lhs,
+                                           const iree_wait_handle_t* rhs) {
+  return lhs->type == rhs->type &&
+         memcmp(&lhs->value, &rhs->value, sizeof(lhs->value)) == 0;
+}
@@ -161,6 +161,12 @@ iree_status_t iree_wait_handle_wrap_primitive(
 // deinitializing a handle will not close the resource.
 void iree_wait_handle_deinitialize(iree_wait_handle_t* handle);
 
+// Returns true if the two handles are identical in representation.
+// Note that two unique handles may point to the same underlying primitive
+// object (such as when they have been cloned).
+bool iree_wait_primitive_compare_identical(const iree_wait_handle_t* lhs,
+                                           const iree_wait_handle_t* rhs);
+
 //===----------------------------------------------------------------------===//
 // iree_wait_set_t
 //===----------------------------------------------------------------------===//
@@ -338,7 +338,7 @@ iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
   // Make the syscall only when we have at least one valid fd.
   // Don't use this as a sleep.
   if (set->handle_count <= 0) {
-    memset(out_wake_handle, 0, sizeof(*out_wake_handle));
+    if (out_wake_handle) memset(out_wake_handle, 0, sizeof(*out_wake_handle));
     return iree_ok_status();
   }
 
@@ -355,8 +355,8 @@ iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
                             &signaled_count));
 
   // Find at least one signaled handle.
-  memset(out_wake_handle, 0, sizeof(*out_wake_handle));
-  if (signaled_count > 0) {
+  if (out_wake_handle) memset(out_wake_handle, 0, sizeof(*out_wake_handle));
+  if (out_wake_handle && signaled_count > 0) {
     for (iree_host_size_t i = 0; i < set->handle_count; ++i) {
       bool signaled = false;
       IREE_RETURN_AND_END_ZONE_IF_ERROR(
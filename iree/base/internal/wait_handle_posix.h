@@ -52,12 +52,6 @@ iree_status_t iree_wait_primitive_create_native(bool initial_state,
 // the handle.
 void iree_wait_primitive_close(iree_wait_handle_t* handle);
 
-// Returns true if the two handles are identical in representation.
-// Note that two unique handles may point to the same underlying primitive
-// object (such as when they have been cloned).
-bool iree_wait_primitive_compare_identical(const iree_wait_handle_t* lhs,
-                                           const iree_wait_handle_t* rhs);
-
 // Returns an fd that can be used to read/wait on the handle.
 // Returns -1 if the handle is invalid.
 int iree_wait_primitive_get_read_fd(const iree_wait_handle_t* handle);
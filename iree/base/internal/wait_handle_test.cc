@@ -476,6 +476,32 @@ TEST(WaitSet, WaitAny) {
   iree_event_deinitialize(&ev_set);
 }
 
+// Tests iree_wait_any with the optional wake handle omitted.
+TEST(WaitSet, WaitAnyNoWakeHandle) {
+  iree_event_t ev_unset, ev_set;
+  IREE_ASSERT_OK(iree_event_initialize(/*initial_state=*/false, &ev_unset));
+  IREE_ASSERT_OK(iree_event_initialize(/*initial_state=*/true, &ev_set));
+  iree_wait_set_t* wait_set = NULL;
+  IREE_ASSERT_OK(
+      iree_wait_set_allocate(128, iree_allocator_system(), &wait_set));
+
+  // Empty and unsignaled polls must not write to the wake handle either.
+  IREE_ASSERT_OK(iree_wait_any(wait_set, IREE_TIME_INFINITE_PAST,
+                               /*out_wake_handle=*/NULL));
+  IREE_ASSERT_OK(iree_wait_set_insert(wait_set, ev_unset));
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_DEADLINE_EXCEEDED,
+                        iree_wait_any(wait_set, IREE_TIME_INFINITE_PAST,
+                                      /*out_wake_handle=*/NULL));
+
+  IREE_ASSERT_OK(iree_wait_set_insert(wait_set, ev_set));
+  IREE_ASSERT_OK(iree_wait_any(wait_set, IREE_TIME_INFINITE_FUTURE,
+                               /*out_wake_handle=*/NULL));
+
+  iree_wait_set_free(wait_set);
+  iree_event_deinitialize(&ev_unset);
+  iree_event_deinitialize(&ev_set);
+}
+
 // Tests iree_wait_any when polling (deadline_ns = IREE_TIME_INFINITE_PAST).
 TEST(WaitSet, WaitAnyPolling) {
   iree_event_t ev_unset_0, ev_unset_1;
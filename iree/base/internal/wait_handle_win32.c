@@ -85,16 +85,6 @@ static bool iree_wait_primitive_compare(const iree_wait_handle_t* lhs,
   }
 }
 
-// Returns true if the two handles are identical in representation.
-// Note that two unique handles may point to the same underlying primitive
-// object (such as when they have been cloned); if testing for duplicate
-// primitives prefer iree_wait_primitive_compare.
-static bool iree_wait_primitive_compare_identical(
-    const iree_wait_handle_t* lhs, const iree_wait_handle_t* rhs) {
-  return lhs->type == rhs->type &&
-         memcmp(&lhs->value, &rhs->value, sizeof(lhs->value)) == 0;
-}
-
 //===----------------------------------------------------------------------===//
 // iree_wait_set_t
 //===----------------------------------------------------------------------===//
@@ -16,6 +16,8 @@
 
 #include <assert.h>
 
+#include "iree/base/internal/math.h"
+
 #if defined(IREE_PLATFORM_EMSCRIPTEN)
 
 #include <emscripten/threading.h>
@@ -144,6 +146,21 @@ static inline void iree_futex_wake(void* address, int32_t count) {
           NULL, 0);
 }
 
+// Waits like iree_futex_wait but only wakes for iree_futex_wake_bitset calls
+// with a |bitset| intersecting the one provided here.
+static inline void iree_futex_wait_bitset(void* address,
+                                          uint32_t expected_value,
+                                          uint32_t bitset) {
+  syscall(SYS_futex, address, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+          expected_value, NULL, NULL, bitset);
+}
+
+// Wakes all threads waiting on |address| with a bitset intersecting |bitset|.
+static inline void iree_futex_wake_bitset(void* address, uint32_t bitset) {
+  syscall(SYS_futex, address, FUTEX_WAKE_BITSET | FUTEX_PRIVATE_FLAG, INT32_MAX,
+          NULL, NULL, bitset);
+}
+
 #endif  // IREE_PLATFORM_*
 
 #endif  // IREE_PLATFORM_HAS_FUTEX
@@ -634,3 +651,120 @@ void iree_notification_await(iree_notification_t* notification,
     }
   }
 }
+
+//==============================================================================
+// iree_notification_set_t
+//==============================================================================
+
+#if defined(IREE_PLATFORM_HAS_FUTEX_BITSET)
+
+// Futex bitsets are only 32 bits wide so members 32-63 alias members 0-31.
+// Aliased members may be woken spuriously but always recheck their posted bit
+// before returning.
+static inline uint32_t iree_notification_set_futex_bits(uint64_t member_mask) {
+  return (uint32_t)member_mask | (uint32_t)(member_mask >> 32);
+}
+
+void iree_notification_set_initialize(iree_notification_set_t* out_set) {
+  memset(out_set, 0, sizeof(*out_set));
+}
+
+void iree_notification_set_deinitialize(iree_notification_set_t* set) {
+  SYNC_ASSERT(iree_atomic_load_int64(&set->waiter_mask,
+                                     iree_memory_order_seq_cst) == 0);
+}
+
+void iree_notification_set_post(iree_notification_set_t* set,
+                                uint64_t member_mask) {
+  // Mark the members as posted before bumping the epoch; any member that read
+  // the old epoch and has not yet checked its bit will either see the bit or
+  // fail its futex wait due to the epoch change.
+  iree_atomic_fetch_or_int64(&set->posted_mask, (int64_t)member_mask,
+                             iree_memory_order_seq_cst);
+  iree_atomic_fetch_add_int32(&set->epoch, 1, iree_memory_order_seq_cst);
+  uint64_t wake_mask = (uint64_t)iree_atomic_load_int64(
+                           &set->waiter_mask, iree_memory_order_seq_cst) &
+                       member_mask;
+  if (IREE_UNLIKELY(wake_mask)) {
+    iree_futex_wake_bitset(&set->epoch,
+                           iree_notification_set_futex_bits(wake_mask));
+  }
+}
+
+iree_wait_token_t iree_notification_set_prepare_wait(
+    iree_notification_set_t* set, iree_host_size_t member_index) {
+  uint64_t member_bit = 1ull << member_index;
+  iree_atomic_fetch_or_int64(&set->waiter_mask, (int64_t)member_bit,
+                             iree_memory_order_seq_cst);
+  // Consume any prior posts: the caller checks its state after this and will
+  // observe whatever those posts were notifying about.
+  iree_atomic_fetch_and_int64(&set->posted_mask, ~(int64_t)member_bit,
+                              iree_memory_order_acq_rel);
+  return 0;
+}
+
+void iree_notification_set_commit_wait(iree_notification_set_t* set,
+                                       iree_host_size_t member_index,
+                                       iree_wait_token_t wait_token) {
+  uint64_t member_bit = 1ull << member_index;
+  while (true) {
+    uint32_t epoch =
+        iree_atomic_load_int32(&set->epoch, iree_memory_order_seq_cst);
+    if (iree_atomic_load_int64(&set->posted_mask, iree_memory_order_seq_cst) &
+        member_bit) {
+      break;
+    }
+    iree_futex_wait_bitset(&set->epoch, epoch,
+                           iree_notification_set_futex_bits(member_bit));
+  }
+  iree_atomic_fetch_and_int64(&set->waiter_mask, ~(int64_t)member_bit,
+                              iree_memory_order_seq_cst);
+}
+
+void iree_notification_set_cancel_wait(iree_notification_set_t* set,
+                                       iree_host_size_t member_index) {
+  uint64_t member_bit = 1ull << member_index;
+  iree_atomic_fetch_and_int64(&set->waiter_mask, ~(int64_t)member_bit,
+                              iree_memory_order_seq_cst);
+}
+
+#else
+
+void iree_notification_set_initialize(iree_notification_set_t* out_set) {
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(out_set->members); ++i) {
+    iree_notification_initialize(&out_set->members[i]);
+  }
+}
+
+void iree_notification_set_deinitialize(iree_notification_set_t* set) {
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(set->members); ++i) {
+    iree_notification_deinitialize(&set->members[i]);
+  }
+}
+
+void iree_notification_set_post(iree_notification_set_t* set,
+                                uint64_t member_mask) {
+  while (member_mask) {
+    int member_index = iree_math_count_trailing_zeros_u64(member_mask);
+    member_mask &= member_mask - 1;
+    iree_notification_post(&set->members[member_index], 1);
+  }
+}
+
+iree_wait_token_t iree_notification_set_prepare_wait(
+    iree_notification_set_t* set, iree_host_size_t member_index) {
+  return iree_notification_prepare_wait(&set->members[member_index]);
+}
+
+void iree_notification_set_commit_wait(iree_notification_set_t* set,
+                                       iree_host_size_t member_index,
+                                       iree_wait_token_t wait_token) {
+  iree_notification_commit_wait(&set->members[member_index], wait_token);
+}
+
+void iree_notification_set_cancel_wait(iree_notification_set_t* set,
+                                       iree_host_size_t member_index) {
+  iree_notification_cancel_wait(&set->members[member_index]);
+}
+
+#endif  // IREE_PLATFORM_HAS_FUTEX_BITSET
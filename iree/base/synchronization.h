@@ -65,6 +65,13 @@
 #endif  // !IREE_SANITIZER_THREAD
 #endif  // IREE_PLATFORM_*
 
+// Linux futexes can wake an arbitrary subset of the waiters on a single address
+// with FUTEX_WAKE_BITSET.
+#if defined(IREE_PLATFORM_HAS_FUTEX) && \
+    (defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX))
+#define IREE_PLATFORM_HAS_FUTEX_BITSET 1
+#endif  // IREE_PLATFORM_HAS_FUTEX && IREE_PLATFORM_*
+
 #if defined(IREE_PLATFORM_APPLE)
 #include <os/lock.h>
 #endif  // IREE_PLATFORM_APPLE
@@ -364,6 +371,66 @@ void iree_notification_await(iree_notification_t* notification,
                              iree_condition_fn_t condition_fn,
                              void* condition_arg);
 
+//==============================================================================
+// iree_notification_set_t
+//==============================================================================
+
+// Maximum number of members in an iree_notification_set_t.
+#define IREE_NOTIFICATION_SET_CAPACITY 64
+
+// A set of notifications each with a single waiter (a member) where any subset
+// of the members can be notified with a single post.
+//
+// This has the same prepare/commit/cancel semantics as iree_notification_t
+// but all members share a single futex such that waking N members is one
+// syscall instead of N. This reduces the latency of the last member woken and
+// lets the kernel see all of the threads that will be needed at once.
+//
+// Platforms without FUTEX_WAKE_BITSET fall back to one iree_notification_t per
+// member.
+typedef struct {
+#if defined(IREE_PLATFORM_HAS_FUTEX_BITSET)
+  // Futex word incremented on every post that all members wait on.
+  iree_atomic_int32_t epoch;
+  // Bitmask of members that have been posted since they prepared to wait.
+  iree_atomic_int64_t posted_mask;
+  // Bitmask of members that are preparing to wait or waiting.
+  iree_atomic_int64_t waiter_mask;
+#else
+  iree_notification_t members[IREE_NOTIFICATION_SET_CAPACITY];
+#endif  // IREE_PLATFORM_HAS_FUTEX_BITSET
+} iree_notification_set_t;
+
+// Initializes a notification set with no waiters.
+void iree_notification_set_initialize(iree_notification_set_t* out_set);
+
+// Deinitializes |set|. No members may be waiting.
+void iree_notification_set_deinitialize(iree_notification_set_t* set);
+
+// Notifies each member with a bit set in |member_mask|. Members that are not
+// waiting will not wait on their next commit if they prepared prior to the
+// post. Acts as (at least) a memory_order_release barrier.
+void iree_notification_set_post(iree_notification_set_t* set,
+                                uint64_t member_mask);
+
+// Prepares for a wait operation on |member_index|, returning a token that must
+// be passed to iree_notification_set_commit_wait to perform the actual wait.
+// Only one thread may wait as a particular member at a time.
+// Acts as a memory_order_acq_rel barrier.
+iree_wait_token_t iree_notification_set_prepare_wait(
+    iree_notification_set_t* set, iree_host_size_t member_index);
+
+// Commits a pending wait operation when the caller has ensured it must wait.
+// Waiting will continue until the member has been posted.
+// Acts as (at least) a memory_order_acquire barrier.
+void iree_notification_set_commit_wait(iree_notification_set_t* set,
+                                       iree_host_size_t member_index,
+                                       iree_wait_token_t wait_token);
+
+// Cancels a pending wait operation on |member_index| without blocking.
+void iree_notification_set_cancel_wait(iree_notification_set_t* set,
+                                       iree_host_size_t member_index);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
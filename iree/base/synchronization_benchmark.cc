@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 #include "iree/base/synchronization.h"
@@ -260,4 +264,132 @@ BENCHMARK_TEMPLATE(BM_Contended, std::mutex)
 // mutex/futex (as that's what is used), but at the moment we don't really
 // care beyond that.
 
+// A pool of threads that each repeatedly wait to be woken either through their
+// own iree_notification_t or as a member of a shared iree_notification_set_t.
+// This models the task executor waking the workers it posted tasks to.
+class FanOutWaiters {
+ public:
+  FanOutWaiters(int waiter_count, bool use_set)
+      : notifications_(waiter_count), use_set_(use_set) {
+    for (auto& notification : notifications_) {
+      iree_notification_initialize(&notification);
+    }
+    iree_notification_set_initialize(&notification_set_);
+    for (int i = 0; i < waiter_count; ++i) {
+      threads_.emplace_back([this, i]() { ThreadMain(i); });
+    }
+  }
+
+  ~FanOutWaiters() {
+    exiting_ = true;
+    WakeAll();
+    round_.fetch_add(1);
+    for (auto& thread : threads_) thread.join();
+    for (auto& notification : notifications_) {
+      iree_notification_deinitialize(&notification);
+    }
+    iree_notification_set_deinitialize(&notification_set_);
+  }
+
+  // Blocks until all waiters have prepared to wait and had a chance to block.
+  void WaitUntilAllWaiting() {
+    while (waiting_count_.load() != static_cast<int>(threads_.size())) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  // Wakes all waiters.
+  void WakeAll() {
+    if (use_set_) {
+      uint64_t member_mask = threads_.size() == 64
+                                 ? UINT64_MAX
+                                 : (1ull << threads_.size()) - 1;
+      iree_notification_set_post(&notification_set_, member_mask);
+    } else {
+      for (auto& notification : notifications_) {
+        iree_notification_post(&notification, 1);
+      }
+    }
+  }
+
+  // Blocks until all waiters have woken and then starts the next round.
+  void WaitUntilAllWoken() {
+    while (woken_count_.load() != static_cast<int>(threads_.size())) {
+      std::this_thread::yield();
+    }
+    waiting_count_ = 0;
+    woken_count_ = 0;
+    round_.fetch_add(1);
+  }
+
+ private:
+  void ThreadMain(int index) {
+    while (true) {
+      int round = round_.load();
+      iree_wait_token_t wait_token =
+          use_set_ ? iree_notification_set_prepare_wait(&notification_set_,
+                                                        index)
+                   : iree_notification_prepare_wait(&notifications_[index]);
+      if (exiting_) {
+        if (use_set_) {
+          iree_notification_set_cancel_wait(&notification_set_, index);
+        } else {
+          iree_notification_cancel_wait(&notifications_[index]);
+        }
+        break;
+      }
+      waiting_count_.fetch_add(1);
+      if (use_set_) {
+        iree_notification_set_commit_wait(&notification_set_, index,
+                                          wait_token);
+      } else {
+        iree_notification_commit_wait(&notifications_[index], wait_token);
+      }
+      woken_count_.fetch_add(1);
+      while (round_.load() == round) std::this_thread::yield();
+    }
+  }
+
+  std::vector<iree_notification_t> notifications_;
+  iree_notification_set_t notification_set_;
+  bool use_set_;
+  std::vector<std::thread> threads_;
+  std::atomic<bool> exiting_{false};
+  std::atomic<int> round_{0};
+  std::atomic<int> waiting_count_{0};
+  std::atomic<int> woken_count_{0};
+};
+
+// Measures the time from waking N blocked waiters until all of them are
+// running, as happens when a dispatch is fanned out across workers.
+//
+// Arguments: [waiter_count, use_set]
+void BM_NotificationFanOut(benchmark::State& state) {
+  FanOutWaiters waiters(static_cast<int>(state.range(0)), state.range(1) != 0);
+  for (auto _ : state) {
+    waiters.WaitUntilAllWaiting();
+    auto start_time = std::chrono::high_resolution_clock::now();
+    waiters.WakeAll();
+    waiters.WaitUntilAllWoken();
+    auto end_time = std::chrono::high_resolution_clock::now();
+    state.SetIterationTime(
+        std::chrono::duration<double>(end_time - start_time).count());
+  }
+}
+BENCHMARK(BM_NotificationFanOut)
+    ->ArgNames({"waiters", "set"})
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({4, 0})
+    ->Args({4, 1})
+    ->Args({16, 0})
+    ->Args({16, 1})
+    ->Args({32, 0})
+    ->Args({32, 1})
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace
@@ -16,6 +16,7 @@
 
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include "iree/testing/gtest.h"
 
@@ -184,4 +185,76 @@ TEST(SlimMutexTest, ExclusiveAccessTryLock) {
 
 // Tested implicitly in threading_test.cc.
 
+//==============================================================================
+// iree_notification_set_t
+//==============================================================================
+
+TEST(NotificationSetTest, Lifetime) {
+  iree_notification_set_t set;
+  iree_notification_set_initialize(&set);
+  iree_notification_set_post(&set, 0x5);
+  iree_notification_set_deinitialize(&set);
+}
+
+// Posts before the commit must not be lost or the member would sleep forever.
+TEST(NotificationSetTest, PostBeforeCommit) {
+  iree_notification_set_t set;
+  iree_notification_set_initialize(&set);
+  iree_wait_token_t wait_token = iree_notification_set_prepare_wait(&set, 3);
+  iree_notification_set_post(&set, 1ull << 3);
+  iree_notification_set_commit_wait(&set, 3, wait_token);
+  iree_notification_set_deinitialize(&set);
+}
+
+TEST(NotificationSetTest, CancelWait) {
+  iree_notification_set_t set;
+  iree_notification_set_initialize(&set);
+  iree_notification_set_prepare_wait(&set, 63);
+  iree_notification_set_cancel_wait(&set, 63);
+  iree_notification_set_deinitialize(&set);
+}
+
+// Wakes a subset of the waiting members with a single post and ensures the
+// others keep waiting until they are posted themselves. Members 0 and 32 alias
+// in the futex bitset and may wake spuriously but must not return.
+TEST(NotificationSetTest, WakeSubset) {
+  static constexpr int kMemberCount = 64;
+  iree_notification_set_t set;
+  iree_notification_set_initialize(&set);
+  iree_atomic_int32_t ready_count = IREE_ATOMIC_VAR_INIT(0);
+  iree_atomic_int64_t woken_mask = IREE_ATOMIC_VAR_INIT(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kMemberCount; ++i) {
+    threads.emplace_back([&, i]() {
+      iree_wait_token_t wait_token =
+          iree_notification_set_prepare_wait(&set, i);
+      iree_atomic_fetch_add_int32(&ready_count, 1, iree_memory_order_seq_cst);
+      iree_notification_set_commit_wait(&set, i, wait_token);
+      iree_atomic_fetch_or_int64(&woken_mask, 1ll << i,
+                                 iree_memory_order_seq_cst);
+    });
+  }
+  while (iree_atomic_load_int32(&ready_count, iree_memory_order_seq_cst) !=
+         kMemberCount) {
+    std::this_thread::yield();
+  }
+
+  const uint64_t first_mask = 0x00000000FFFFFFFFull;
+  iree_notification_set_post(&set, first_mask);
+  while ((uint64_t)iree_atomic_load_int64(&woken_mask,
+                                          iree_memory_order_seq_cst) !=
+         first_mask) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(first_mask, (uint64_t)iree_atomic_load_int64(
+                            &woken_mask, iree_memory_order_seq_cst));
+
+  iree_notification_set_post(&set, ~first_mask);
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(UINT64_MAX, (uint64_t)iree_atomic_load_int64(
+                            &woken_mask, iree_memory_order_seq_cst));
+  iree_notification_set_deinitialize(&set);
+}
+
 }  // namespace
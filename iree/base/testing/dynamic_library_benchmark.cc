@@ -0,0 +1,97 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/internal/dynamic_library.h"
+#include "iree/base/internal/file_io.h"
+#include "iree/base/logging.h"
+#include "iree/base/testing/dynamic_library_test_library_embed.h"
+
+namespace {
+
+// Looks up and calls the test library export to ensure the library is usable.
+void CheckLibrary(iree_dynamic_library_t* library) {
+  int (*fn_ptr)(int) = NULL;
+  IREE_CHECK_OK(iree_dynamic_library_lookup_symbol(library, "times_two",
+                                                   (void**)&fn_ptr));
+  IREE_CHECK_EQ(246, fn_ptr(123));
+}
+
+// Measures the time taken to load |library_count| libraries embedded in memory
+// as happens when a module containing many executables is loaded at startup.
+//
+// Arguments: [library_count]
+void BM_LoadFromMemory(benchmark::State& state) {
+  const auto* file_toc = iree::dynamic_library_test_library_create();
+  std::vector<iree_dynamic_library_t*> libraries(state.range(0));
+  for (auto _ : state) {
+    for (auto& library : libraries) {
+      IREE_CHECK_OK(iree_dynamic_library_load_from_memory(
+          iree_make_cstring_view("benchmark"),
+          iree_make_const_byte_span(file_toc->data, file_toc->size),
+          IREE_DYNAMIC_LIBRARY_FLAG_NONE, iree_allocator_system(), &library));
+      CheckLibrary(library);
+    }
+    for (auto* library : libraries) iree_dynamic_library_release(library);
+  }
+  state.SetItemsProcessed(state.iterations() * libraries.size());
+}
+BENCHMARK(BM_LoadFromMemory)
+    ->ArgName("libraries")
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+
+// Measures the same as BM_LoadFromMemory but by writing each library to a temp
+// file and loading it from there. This is what loading from memory has to fall
+// back to when in-memory files are not supported by the platform.
+//
+// Arguments: [library_count]
+void BM_LoadFromTempFile(benchmark::State& state) {
+  const char* tmpdir = getenv("TEST_TMPDIR");
+  if (!tmpdir) tmpdir = getenv("TMPDIR");
+  if (!tmpdir) tmpdir = "/tmp";
+  const auto* file_toc = iree::dynamic_library_test_library_create();
+  std::vector<iree_dynamic_library_t*> libraries(state.range(0));
+  for (auto _ : state) {
+    for (size_t i = 0; i < libraries.size(); ++i) {
+      std::string temp_path = std::string(tmpdir) + "/iree_dylib_benchmark_" +
+                              std::to_string(i) + ".so";
+      IREE_CHECK_OK(iree::file_io::SetFileContents(
+          temp_path.c_str(),
+          iree_make_const_byte_span(file_toc->data, file_toc->size)));
+      IREE_CHECK_OK(iree_dynamic_library_load_from_file(
+          temp_path.c_str(), IREE_DYNAMIC_LIBRARY_FLAG_NONE,
+          iree_allocator_system(), &libraries[i]));
+      remove(temp_path.c_str());
+      CheckLibrary(libraries[i]);
+    }
+    for (auto* library : libraries) iree_dynamic_library_release(library);
+  }
+  state.SetItemsProcessed(state.iterations() * libraries.size());
+}
+BENCHMARK(BM_LoadFromTempFile)
+    ->ArgName("libraries")
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
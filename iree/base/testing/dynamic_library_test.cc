@@ -103,6 +103,61 @@ TEST_F(DynamicLibraryTest, LoadLibraryTwice) {
   iree_dynamic_library_release(library2);
 }
 
+TEST_F(DynamicLibraryTest, LoadLibraryFromMemory) {
+  const auto* file_toc = dynamic_library_test_library_create();
+  iree_dynamic_library_t* library = NULL;
+  IREE_ASSERT_OK(iree_dynamic_library_load_from_memory(
+      iree_make_cstring_view("test"),
+      iree_make_const_byte_span(file_toc->data, file_toc->size),
+      IREE_DYNAMIC_LIBRARY_FLAG_NONE, iree_allocator_system(), &library));
+
+  int (*fn_ptr)(int);
+  IREE_ASSERT_OK(iree_dynamic_library_lookup_symbol(library, "times_two",
+                                                    (void**)&fn_ptr));
+  ASSERT_NE(nullptr, fn_ptr);
+  EXPECT_EQ(246, fn_ptr(123));
+
+  iree_dynamic_library_release(library);
+}
+
+TEST_F(DynamicLibraryTest, LoadLibraryFromMemoryMany) {
+  // Keep all libraries live at the same time to ensure each gets its own
+  // backing file and loads succeed even when the same bytes are loaded.
+  const auto* file_toc = dynamic_library_test_library_create();
+  iree_dynamic_library_t* libraries[8] = {NULL};
+  for (size_t i = 0; i < IREE_ARRAYSIZE(libraries); ++i) {
+    IREE_ASSERT_OK(iree_dynamic_library_load_from_memory(
+        iree_make_cstring_view("test"),
+        iree_make_const_byte_span(file_toc->data, file_toc->size),
+        IREE_DYNAMIC_LIBRARY_FLAG_NONE, iree_allocator_system(),
+        &libraries[i]));
+  }
+  for (size_t i = 0; i < IREE_ARRAYSIZE(libraries); ++i) {
+    int (*fn_ptr)(int);
+    IREE_ASSERT_OK(iree_dynamic_library_lookup_symbol(
+        libraries[i], "times_two", (void**)&fn_ptr));
+    EXPECT_EQ(246, fn_ptr(123));
+  }
+  for (size_t i = 0; i < IREE_ARRAYSIZE(libraries); ++i) {
+    iree_dynamic_library_release(libraries[i]);
+  }
+}
+
+TEST_F(DynamicLibraryTest, LoadLibraryFromMemoryInvalid) {
+  // Bytes that are not a shared object must surface the loader error instead
+  // of being treated as an unavailable platform feature.
+  static const uint8_t kGarbage[64] = {0x7F, 'N', 'O', 'P', 'E'};
+  iree_dynamic_library_t* library = NULL;
+  iree_status_t status = iree_dynamic_library_load_from_memory(
+      iree_make_cstring_view("garbage"),
+      iree_make_const_byte_span(kGarbage, sizeof(kGarbage)),
+      IREE_DYNAMIC_LIBRARY_FLAG_NONE, iree_allocator_system(), &library);
+  EXPECT_FALSE(iree_status_is_ok(status));
+  EXPECT_FALSE(iree_status_is_unavailable(status));
+  iree_status_ignore(status);
+  EXPECT_EQ(nullptr, library);
+}
+
 TEST_F(DynamicLibraryTest, GetSymbolSuccess) {
   iree_dynamic_library_t* library = NULL;
   IREE_ASSERT_OK(iree_dynamic_library_load_from_file(
@@ -180,6 +180,16 @@ void iree_thread_request_affinity(iree_thread_t* thread,
 // This has no effect if the thread is not suspended.
 void iree_thread_resume(iree_thread_t* thread);
 
+// Returns the CPU time in nanoseconds consumed by the calling thread since it
+// started. Only differences between two queries on the same thread are
+// meaningful. Returns 0 on platforms that do not track per-thread CPU time.
+iree_duration_t iree_thread_current_cpu_time(void);
+
+// Yields the remainder of the calling thread's time slice to other threads
+// ready to run. Spin-waits should yield so that the thread they are waiting on
+// can make progress when cores are oversubscribed.
+void iree_thread_yield(void);
+
 //==============================================================================
 // iree_fpu_state_*
 //==============================================================================
@@ -21,6 +21,7 @@
 #include <mach/mach.h>
 #include <mach/thread_act.h>
 #include <pthread.h>
+#include <sched.h>
 #include <string.h>
 
 #include "iree/base/internal/atomics.h"
@@ -255,4 +256,19 @@ void iree_thread_resume(iree_thread_t* thread) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+iree_duration_t iree_thread_current_cpu_time(void) {
+  // NOTE: pthread_mach_thread_np does not add a port reference (unlike
+  // mach_thread_self) so there's nothing to deallocate.
+  thread_basic_info_data_t info;
+  mach_msg_type_number_t info_count = THREAD_BASIC_INFO_COUNT;
+  if (thread_info(pthread_mach_thread_np(pthread_self()), THREAD_BASIC_INFO,
+                  (thread_info_t)&info, &info_count) != KERN_SUCCESS) {
+    return 0;
+  }
+  return (info.user_time.seconds + info.system_time.seconds) * 1000000000ll +
+         (info.user_time.microseconds + info.system_time.microseconds) * 1000ll;
+}
+
+void iree_thread_yield(void) { sched_yield(); }
+
 #endif  // IREE_PLATFORM_APPLE
@@ -333,4 +333,12 @@ void iree_thread_resume(iree_thread_t* thread) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+iree_duration_t iree_thread_current_cpu_time(void) {
+  struct timespec cpu_time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time) != 0) return 0;
+  return cpu_time.tv_sec * 1000000000ll + cpu_time.tv_nsec;
+}
+
+void iree_thread_yield(void) { sched_yield(); }
+
 #endif  // IREE_PLATFORM_*
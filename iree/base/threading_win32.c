@@ -324,4 +324,21 @@ void iree_thread_resume(iree_thread_t* thread) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+iree_duration_t iree_thread_current_cpu_time(void) {
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time,
+                      &kernel_time, &user_time)) {
+    return 0;
+  }
+  ULARGE_INTEGER kernel_ticks, user_ticks;
+  kernel_ticks.LowPart = kernel_time.dwLowDateTime;
+  kernel_ticks.HighPart = kernel_time.dwHighDateTime;
+  user_ticks.LowPart = user_time.dwLowDateTime;
+  user_ticks.HighPart = user_time.dwHighDateTime;
+  // FILETIME is in units of 100ns.
+  return (iree_duration_t)(kernel_ticks.QuadPart + user_ticks.QuadPart) * 100;
+}
+
+void iree_thread_yield(void) { SwitchToThread(); }
+
 #endif  // IREE_PLATFORM_WINDOWS
@@ -132,12 +132,16 @@ class HALDispatchABI {
     };
   }
 
+  // |bindingAlignment| is the minimum byte alignment of all binding base
+  // pointers that the runtime guarantees; 1 makes no assumptions.
   explicit HALDispatchABI(LLVM::LLVMFuncOp &funcOp,
-                          LLVMTypeConverter *typeConverter)
+                          LLVMTypeConverter *typeConverter,
+                          int64_t bindingAlignment = 1)
       : funcOp(funcOp),
         typeConverter(typeConverter),
         dispatchStateType(
-            getDispatchStateType(funcOp.getContext(), typeConverter)) {}
+            getDispatchStateType(funcOp.getContext(), typeConverter)),
+        bindingAlignment(bindingAlignment) {}
 
   // Loads the workgroup_id[dim] value (XYZ) and casts it to |resultType|.
   Value loadWorkgroupID(Location loc, int32_t dim, Type resultType,
@@ -229,6 +233,12 @@ class HALDispatchABI {
     // Load the base buffer pointer in the appropriate type (f32*, etc).
     Value basePtrValue = loadBindingPtr(loc, ordinal, builder);
 
+    // Tell LLVM the base pointer is aligned so that it can use aligned vector
+    // loads/stores and skip peeling loops to reach alignment.
+    if (bindingAlignment > 1) {
+      assumeAligned(loc, basePtrValue, bindingAlignment, builder);
+    }
+
     // Adjust by baseOffset (if needed).
     if (baseOffsetValue) {
       basePtrValue = builder.createOrFold<LLVM::GEPOp>(
@@ -277,6 +287,25 @@ class HALDispatchABI {
         builder.createOrFold<ConstantIndexOp>(loc, value));
   }
 
+  // Emits an llvm.assume that |ptrValue| is aligned to |alignment| bytes.
+  // Equivalent to:
+  //   __builtin_assume(((uintptr_t)ptr & (alignment - 1)) == 0);
+  void assumeAligned(Location loc, Value ptrValue, int64_t alignment,
+                     OpBuilder &builder) {
+    auto intPtrType = typeConverter->convertType(builder.getIndexType());
+    auto ptrIntValue =
+        builder.create<LLVM::PtrToIntOp>(loc, intPtrType, ptrValue);
+    auto maskValue = builder.create<LLVM::ConstantOp>(
+        loc, intPtrType, builder.getIntegerAttr(intPtrType, alignment - 1));
+    auto maskedValue =
+        builder.create<LLVM::AndOp>(loc, ptrIntValue, maskValue);
+    auto zeroValue = builder.create<LLVM::ConstantOp>(
+        loc, intPtrType, builder.getIntegerAttr(intPtrType, 0));
+    auto isAlignedValue = builder.create<LLVM::ICmpOp>(
+        loc, LLVM::ICmpPredicate::eq, maskedValue, zeroValue);
+    builder.create<LLVM::AssumeOp>(loc, isAlignedValue);
+  }
+
   Value castValueToType(Location loc, Value value, Type resultType,
                         OpBuilder &builder) {
     // NOTE: we should handle more cases here (and proper sign extension).
@@ -287,6 +316,7 @@ class HALDispatchABI {
   LLVM::LLVMFuncOp funcOp;
   LLVMTypeConverter *typeConverter;
   LLVM::LLVMStructType dispatchStateType;
+  int64_t bindingAlignment;
 };
 
 /// Converts Standard MLIR FuncOps to LLVMFuncOps matching the IREE HAL ABI.
@@ -492,17 +522,19 @@ class ConvertHALInterfaceLoadConstant : public ConvertToLLVMPattern {
 class ConvertHALInterfaceBindingSubspanOp : public ConvertToLLVMPattern {
  public:
   explicit ConvertHALInterfaceBindingSubspanOp(MLIRContext *context,
-                                               LLVMTypeConverter &converter)
+                                               LLVMTypeConverter &converter,
+                                               int64_t bindingAlignment)
       : ConvertToLLVMPattern(
             IREE::HAL::InterfaceBindingSubspanOp::getOperationName(), context,
-            converter) {}
+            converter),
+        bindingAlignment(bindingAlignment) {}
 
   LogicalResult matchAndRewrite(
       Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const override {
     auto llvmFuncOp = op->getParentOfType<LLVM::LLVMFuncOp>();
     if (!llvmFuncOp) return failure();
-    HALDispatchABI abi(llvmFuncOp, getTypeConverter());
+    HALDispatchABI abi(llvmFuncOp, getTypeConverter(), bindingAlignment);
     auto interfaceBindingOp =
         cast<IREE::HAL::InterfaceBindingSubspanOp>(op).queryBindingOp();
     IREE::HAL::InterfaceBindingSubspanOpAdaptor newOperands(operands);
@@ -513,6 +545,9 @@ class ConvertHALInterfaceBindingSubspanOp : public ConvertToLLVMPattern {
     rewriter.replaceOp(op, {memRefDesc});
     return success();
   }
+
+ private:
+  int64_t bindingAlignment;
 };
 
 /// DEPRECATED: delete this as soon as linalg on buffers and iree.placeholder
@@ -520,16 +555,18 @@ class ConvertHALInterfaceBindingSubspanOp : public ConvertToLLVMPattern {
 class ConvertLegacyPlaceholderOp : public ConvertToLLVMPattern {
  public:
   explicit ConvertLegacyPlaceholderOp(MLIRContext *context,
-                                      LLVMTypeConverter &converter)
+                                      LLVMTypeConverter &converter,
+                                      int64_t bindingAlignment)
       : ConvertToLLVMPattern(IREE::PlaceholderOp::getOperationName(), context,
-                             converter) {}
+                             converter),
+        bindingAlignment(bindingAlignment) {}
 
   LogicalResult matchAndRewrite(
       Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const override {
     auto llvmFuncOp = op->getParentOfType<LLVM::LLVMFuncOp>();
     if (!llvmFuncOp) return failure();
-    HALDispatchABI abi(llvmFuncOp, getTypeConverter());
+    HALDispatchABI abi(llvmFuncOp, getTypeConverter(), bindingAlignment);
     auto interfaceBindingOp = cast<IREE::HAL::InterfaceBindingOp>(
         SymbolTable::lookupNearestSymbolFrom(
             op, op->getAttrOfType<SymbolRefAttr>("binding")));
@@ -540,6 +577,9 @@ class ConvertLegacyPlaceholderOp : public ConvertToLLVMPattern {
     rewriter.replaceOp(op, {memRefDesc});
     return success();
   }
+
+ private:
+  int64_t bindingAlignment;
 };
 
 class RemoveHALInterfaceOpPattern : public ConvertToLLVMPattern {
@@ -702,13 +742,14 @@ void ConvertToLLVMPass::runOnOperation() {
     ConvertHALInterfaceWorkgroupSizeOp,
     ConvertHALInterfaceWorkgroupCountOp,
     ConvertHALInterfaceLoadConstant,
-    ConvertHALInterfaceBindingSubspanOp,
-    ConvertLegacyPlaceholderOp,
     RemoveHALInterfaceOpPattern,
     ConvertTieShapePattern,
     RemoveMakeRankedShape
   >(&getContext(), converter);
   // clang-format on
+  patterns.insert<ConvertHALInterfaceBindingSubspanOp,
+                  ConvertLegacyPlaceholderOp>(&getContext(), converter,
+                                              options_.bindingAlignment);
 
   LLVMConversionTarget target(getContext());
   // IREE::HAL::InterfaceOp will be removed after successful conversion of the
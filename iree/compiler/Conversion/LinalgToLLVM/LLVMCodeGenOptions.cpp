@@ -36,11 +36,21 @@ static llvm::cl::opt<bool> unfusedFMA(
     llvm::cl::desc("Enable rewriting llvm.fma to its unfused version."),
     llvm::cl::init(false));
 
+static llvm::cl::opt<int64_t> bindingAlignment(
+    "iree-codegen-llvm-binding-alignment",
+    llvm::cl::desc("Minimum byte alignment of buffer bindings assumed by "
+                   "generated code; 1 (the default) makes no assumption. Only "
+                   "raise this when every buffer bound to a dispatch, "
+                   "including wrapped host memory, is known to be aligned as "
+                   "the runtime does not check it. Must be a power of two."),
+    llvm::cl::init(1));
+
 LLVMCodegenOptions getLLVMCodegenOptionsFromClOptions() {
   LLVMCodegenOptions options;
   options.usingLinalgOnTensors = clEnableLLVMLinalgOnTensors;
   options.useConvImg2Col = convImg2ColConversion;
   options.unfuseFMAOps = unfusedFMA;
+  options.bindingAlignment = bindingAlignment;
   return options;
 }
 
@@ -15,6 +15,8 @@
 #ifndef IREE_COMPILER_CONVERSION_LINALGTOLLVM_LLVMCODEGENOPTIONS_H_
 #define IREE_COMPILER_CONVERSION_LINALGTOLLVM_LLVMCODEGENOPTIONS_H_
 
+#include <cstdint>
+
 #include "llvm/ADT/SmallVector.h"
 
 namespace mlir {
@@ -27,6 +29,10 @@ struct LLVMCodegenOptions {
   // Target specific options.
   bool unfuseFMAOps = false;
   bool useVectorToAarch64 = false;
+  // Minimum byte alignment of binding base pointers that generated code may
+  // assume or 1 to assume nothing. Bindings are not checked at runtime so this
+  // must only be raised when all bound buffers are known to be aligned.
+  int64_t bindingAlignment = 1;
 };
 
 // Returns LLVM CodeGen options from command-line options.
@@ -1,4 +1,5 @@
-// RUN: iree-opt -allow-unregistered-dialect -iree-codegen-convert-to-llvm -split-input-file %s | IreeFileCheck %s
+// RUN: iree-opt -allow-unregistered-dialect -iree-codegen-convert-to-llvm -iree-codegen-llvm-binding-alignment=16 -split-input-file %s | IreeFileCheck %s
+// RUN: iree-opt -allow-unregistered-dialect -iree-codegen-convert-to-llvm -split-input-file %s | IreeFileCheck %s -check-prefix=NOALIGN
 
 // CHECK-LABEL: llvm.func internal @binding_ptrs
 func @binding_ptrs() {
@@ -9,6 +10,12 @@ func @binding_ptrs() {
   // CHECK: %[[C1:.+]] = llvm.mlir.constant(1 : index) : i64
   // CHECK: %[[ARRAY_PTR:.+]] = llvm.getelementptr %[[BINDING_PTRS]][%[[C1]]] : (!llvm.ptr<ptr<i8>>, i64) -> !llvm.ptr<ptr<i8>>
   // CHECK: %[[BASE_PTR_I8:.+]] = llvm.load %[[ARRAY_PTR]] : !llvm.ptr<ptr<i8>>
+  // CHECK: %[[BASE_PTR_INT:.+]] = llvm.ptrtoint %[[BASE_PTR_I8]] : !llvm.ptr<i8> to i64
+  // CHECK: %[[ALIGN_MASK:.+]] = llvm.mlir.constant(15 : i64) : i64
+  // CHECK: %[[MASKED:.+]] = llvm.and %[[BASE_PTR_INT]], %[[ALIGN_MASK]] : i64
+  // CHECK: %[[ZERO:.+]] = llvm.mlir.constant(0 : i64) : i64
+  // CHECK: %[[IS_ALIGNED:.+]] = llvm.icmp "eq" %[[MASKED]], %[[ZERO]] : i64
+  // CHECK: llvm.intr.assume{{.*}}%[[IS_ALIGNED]]
   // CHECK: %[[BUFFER_I8:.+]] = llvm.getelementptr %[[BASE_PTR_I8]][%[[C72]]] : (!llvm.ptr<i8>, i64) -> !llvm.ptr<i8>
   // CHECK: %[[BUFFER_F32:.+]] = llvm.bitcast %[[BUFFER_I8]] : !llvm.ptr<i8> to !llvm.ptr<f32>
   // CHECK: %[[DESC_A:.+]] = llvm.mlir.undef : !llvm.struct<(ptr<f32>, ptr<f32>, i64, array<1 x i64>, array<1 x i64>)>
@@ -39,7 +46,7 @@ func @tie_shape() {
   // CHECK: %[[DYN_MEMREF:.+]] = llvm.insertvalue %[[C0]], %[[DYN_MEMREF_T3]][2] : !llvm.struct<(ptr<f32>, ptr<f32>, i64, array<2 x i64>, array<2 x i64>)>
   %memref = hal.interface.binding.subspan @io::@ret0[%c72] : memref<?x2xf32>
   // ...
-  //  CHECK: %[[CDIM0_I32:.+]] = llvm.load %16 : !llvm.ptr<i32>
+  //  CHECK: %[[CDIM0_I32:.+]] = llvm.load %{{.+}} : !llvm.ptr<i32>
   //  CHECK: %[[CDIM0:.+]] = llvm.zext %[[CDIM0_I32]] : i32 to i64
   %dim = hal.interface.load.constant offset = 0 : index
   %shape = shapex.make_ranked_shape %dim : (index) -> !shapex.ranked_shape<[?,2]>
@@ -61,3 +68,17 @@ hal.interface @io attributes {push_constants = 2 : index, sym_visibility = "priv
   hal.interface.binding @arg0, set=0, binding=0, type="StorageBuffer", access="Read"
   hal.interface.binding @ret0, set=0, binding=1, type="StorageBuffer", access="Write"
 }
+
+// -----
+
+// NOALIGN-LABEL: llvm.func internal @binding_ptrs_unaligned
+func @binding_ptrs_unaligned() {
+  %c0 = constant 0 : index
+  // NOALIGN-NOT: llvm.intr.assume
+  %memref = hal.interface.binding.subspan @io::@arg0[%c0] : memref<4xf32>
+  "test.sink"(%memref) : (memref<4xf32>) -> ()
+  return
+}
+hal.interface @io attributes {sym_visibility = "private"} {
+  hal.interface.binding @arg0, set=0, binding=0, type="StorageBuffer", access="Read"
+}
@@ -9,6 +9,15 @@ func @command_buffer_create(%arg0: !hal.device) {
 
 // -----
 
+// CHECK-LABEL: @command_buffer_create_reusable
+func @command_buffer_create_reusable(%arg0: !hal.device) {
+  // CHECK: %ref = vm.call @hal.command_buffer.create(%arg0, %c2, %c3) : (!vm.ref<!hal.device>, i32, i32) -> !vm.ref<!hal.command_buffer>
+  %cmd = hal.command_buffer.create device(%arg0 : !hal.device) mode("Reusable") categories("Transfer|Dispatch") : !hal.command_buffer
+  return
+}
+
+// -----
+
 // CHECK-LABEL: @command_buffer_begin_end
 func @command_buffer_begin_end(%arg0: !hal.command_buffer) {
   // CHECK: vm.call @hal.command_buffer.begin(%arg0) : (!vm.ref<!hal.command_buffer>) -> ()
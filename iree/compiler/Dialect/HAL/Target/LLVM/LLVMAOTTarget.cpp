@@ -14,6 +14,7 @@
 
 #include "iree/compiler/Dialect/HAL/Target/LLVM/LLVMAOTTarget.h"
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "iree/compiler/Conversion/Common/Attributes.h"
@@ -82,6 +83,27 @@ class LLVMAOTTargetBackend final : public TargetBackend {
     }
   }
 
+  BufferConstraintsAttr queryBufferConstraints(MLIRContext *context) override {
+    // When --iree-codegen-llvm-binding-alignment is raised generated code
+    // assumes binding base pointers are aligned. Binding pointers are offsets
+    // into buffers so offsets must keep that alignment. Buffer allocations
+    // themselves are aligned by the runtime heap allocator
+    // (IREE_HAL_HEAP_BUFFER_ALIGNMENT).
+    auto defaultConstraints = makeDefaultBufferConstraints(context);
+    auto codeGenOptions = getLLVMCodegenOptionsFromClOptions();
+    uint64_t minBufferOffsetAlignment = std::max<uint64_t>(
+        defaultConstraints.min_buffer_offset_alignment().getZExtValue(),
+        codeGenOptions.bindingAlignment);
+    Builder b(context);
+    return BufferConstraintsAttr::get(
+        b.getIndexAttr(
+            defaultConstraints.max_allocation_size().getZExtValue()),
+        b.getIndexAttr(minBufferOffsetAlignment),
+        b.getIndexAttr(defaultConstraints.max_buffer_range().getZExtValue()),
+        b.getIndexAttr(
+            defaultConstraints.min_buffer_range_alignment().getZExtValue()));
+  }
+
   void buildTranslationPassPipeline(OpPassManager &passManager) override {
     auto codeGenOptions = getLLVMCodegenOptionsFromClOptions();
     // Set target specific options.
@@ -0,0 +1,368 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <memory>
+
+#include "iree/compiler/Dialect/HAL/IR/HALDialect.h"
+#include "iree/compiler/Dialect/HAL/IR/HALOps.h"
+#include "iree/compiler/Dialect/HAL/Target/TargetBackend.h"
+#include "iree/compiler/Dialect/HAL/Target/TargetRegistry.h"
+#include "iree/compiler/Dialect/HAL/Transforms/Passes.h"
+#include "iree/compiler/Dialect/HAL/Utils/TypeUtils.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/Dialect/StandardOps/IR/Ops.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-hal-pack-transient-allocations"
+
+namespace mlir {
+namespace iree_compiler {
+namespace IREE {
+namespace HAL {
+
+namespace {
+
+// Position of a top-level op within a command buffer recording.
+// Epochs are delimited by execution barriers: commands in the same epoch may
+// execute concurrently while commands in different epochs are ordered.
+struct CommandRange {
+  // Index of the begin/end recording region in the block.
+  int recording = -1;
+  // Inclusive range of epochs covered by the op (ops containing barriers, such
+  // as hal.device.switch, may span multiple epochs).
+  int64_t firstEpoch = 0;
+  int64_t lastEpoch = 0;
+};
+
+// A constant-sized allocation that is only referenced by commands recorded
+// into a single command buffer.
+struct TransientAllocation {
+  AllocatorAllocateOp allocateOp;
+  uint64_t size = 0;
+  int64_t firstEpoch = 0;
+  int64_t lastEpoch = 0;
+  // Assigned offset within the packed slab.
+  uint64_t offset = 0;
+
+  bool overlapsLifetime(const TransientAllocation &other) const {
+    return firstEpoch <= other.lastEpoch && other.firstEpoch <= lastEpoch;
+  }
+};
+
+// Transient allocations that are compatible for packing into one slab.
+struct TransientGroup {
+  int recording;
+  Value allocator;
+  MemoryTypeBitfield memoryTypes;
+  BufferUsageBitfield bufferUsage;
+  SmallVector<TransientAllocation, 8> allocations;
+};
+
+}  // namespace
+
+// Returns true if |value| is only used by commands recorded into a command
+// buffer, either directly or through hal.device.switch region captures.
+// Commands do not extend the lifetime of the buffers they reference beyond
+// the execution of the command buffer.
+static bool isOnlyUsedByCommands(Value value) {
+  for (auto &use : value.getUses()) {
+    auto *user = use.getOwner();
+    if (isa<CommandBufferPushDescriptorSetOp, CommandBufferCopyBufferOp,
+            CommandBufferFillBufferOp>(user)) {
+      continue;
+    }
+    auto switchOp = dyn_cast<DeviceSwitchOp>(user);
+    if (!switchOp || use.getOperandNumber() == 0) return false;
+
+    // Each condition region captures its own contiguous range of args.
+    unsigned argIndex = use.getOperandNumber() - 1;
+    bool found = false;
+    for (auto &region : switchOp.condition_regions()) {
+      unsigned numArgs = region.getNumArguments();
+      if (argIndex < numArgs) {
+        if (!isOnlyUsedByCommands(region.getArgument(argIndex))) return false;
+        found = true;
+        break;
+      }
+      argIndex -= numArgs;
+    }
+    if (!found) return false;
+  }
+  return true;
+}
+
+// Computes the recording and epoch range of each top-level op in |block| that
+// lies between a hal.command_buffer.begin and hal.command_buffer.end.
+// Returns failure if recordings are interleaved such that epochs cannot be
+// attributed to a single command buffer.
+static LogicalResult computeCommandRanges(
+    Block &block, DenseMap<Operation *, CommandRange> &commandRanges) {
+  int recording = -1;
+  int recordingCount = 0;
+  int64_t epoch = 0;
+  for (auto &op : block) {
+    if (isa<CommandBufferBeginOp>(op)) {
+      if (recording != -1) return failure();
+      recording = recordingCount++;
+      epoch = 0;
+      continue;
+    } else if (isa<CommandBufferEndOp>(op)) {
+      recording = -1;
+      continue;
+    } else if (recording == -1) {
+      continue;
+    }
+    int64_t barrierCount = 0;
+    op.walk([&](CommandBufferExecutionBarrierOp) { ++barrierCount; });
+    CommandRange range;
+    range.recording = recording;
+    range.firstEpoch = epoch;
+    range.lastEpoch = epoch + barrierCount;
+    commandRanges[&op] = range;
+    epoch += barrierCount;
+  }
+  return success();
+}
+
+// Assigns offsets to each allocation such that allocations with overlapping
+// lifetimes do not alias. Allocations are placed largest-first at the lowest
+// aligned offset that fits. Returns the total slab size.
+static uint64_t packAllocations(
+    MutableArrayRef<TransientAllocation> allocations, uint64_t alignment) {
+  SmallVector<TransientAllocation *, 8> sortedAllocations;
+  for (auto &allocation : allocations) {
+    sortedAllocations.push_back(&allocation);
+  }
+  std::stable_sort(sortedAllocations.begin(), sortedAllocations.end(),
+                   [](TransientAllocation *lhs, TransientAllocation *rhs) {
+                     return lhs->size > rhs->size;
+                   });
+
+  uint64_t slabSize = 0;
+  SmallVector<TransientAllocation *, 8> placedAllocations;
+  for (auto *allocation : sortedAllocations) {
+    SmallVector<TransientAllocation *, 8> liveAllocations;
+    for (auto *placed : placedAllocations) {
+      if (placed->overlapsLifetime(*allocation)) {
+        liveAllocations.push_back(placed);
+      }
+    }
+    llvm::sort(liveAllocations,
+               [](TransientAllocation *lhs, TransientAllocation *rhs) {
+                 return lhs->offset < rhs->offset;
+               });
+    uint64_t offset = 0;
+    for (auto *live : liveAllocations) {
+      if (offset + allocation->size <= live->offset) break;
+      offset = std::max(offset, align(live->offset + live->size, alignment));
+    }
+    allocation->offset = offset;
+    placedAllocations.push_back(allocation);
+    slabSize = std::max(slabSize, offset + allocation->size);
+  }
+  return align(slabSize, alignment);
+}
+
+class PackTransientAllocationsPass
+    : public PassWrapper<PackTransientAllocationsPass, OperationPass<FuncOp>> {
+ public:
+  explicit PackTransientAllocationsPass(TargetOptions targetOptions)
+      : targetOptions_(targetOptions) {}
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<mlir::StandardOpsDialect>();
+    registry.insert<IREE::HAL::HALDialect>();
+  }
+
+  void runOnOperation() override {
+    auto funcOp = getOperation();
+    auto bufferConstraints =
+        computeConservativeBufferConstraints(targetOptions_, &getContext());
+    if (!bufferConstraints) {
+      bufferConstraints =
+          TargetBackend::makeDefaultBufferConstraints(&getContext());
+    }
+    for (auto &block : funcOp.getBlocks()) {
+      packBlock(block, bufferConstraints);
+    }
+  }
+
+ private:
+  // Returns a set of buffer constraints that all target backends support.
+  // NOTE: transients are allocated per device and could use only the
+  // constraints of the device the stream targets.
+  BufferConstraintsAttr computeConservativeBufferConstraints(
+      const TargetOptions &targetOptions, MLIRContext *context) {
+    auto targetBackends = matchTargetBackends(targetOptions.targets);
+    BufferConstraintsAttr attr = {};
+    for (auto &targetBackend : targetBackends) {
+      if (attr) {
+        attr = intersectBufferConstraints(
+            attr, targetBackend->queryBufferConstraints(context));
+      } else {
+        attr = targetBackend->queryBufferConstraints(context);
+      }
+    }
+    return attr;
+  }
+
+  // Gathers the transient allocations in |block| grouped by the command buffer
+  // recording that uses them.
+  SmallVector<TransientGroup, 4> gatherTransientGroups(Block &block) {
+    DenseMap<Operation *, CommandRange> commandRanges;
+    if (failed(computeCommandRanges(block, commandRanges))) return {};
+
+    SmallVector<TransientGroup, 4> groups;
+    for (auto allocateOp : block.getOps<AllocatorAllocateOp>()) {
+      // Dynamically-sized allocations remain independent.
+      APInt sizeValue;
+      if (!matchPattern(allocateOp.result_size(), m_ConstantInt(&sizeValue)) ||
+          sizeValue.isNullValue()) {
+        continue;
+      }
+      if (!isOnlyUsedByCommands(allocateOp.result())) continue;
+
+      // All commands must be recorded into the same command buffer.
+      TransientAllocation allocation;
+      allocation.allocateOp = allocateOp;
+      allocation.size = sizeValue.getZExtValue();
+      int recording = -1;
+      bool isTransient = true;
+      for (auto *user : allocateOp.result().getUsers()) {
+        auto it = commandRanges.find(block.findAncestorOpInBlock(*user));
+        if (it == commandRanges.end() ||
+            (recording != -1 && it->second.recording != recording)) {
+          isTransient = false;
+          break;
+        }
+        if (recording == -1) {
+          recording = it->second.recording;
+          allocation.firstEpoch = it->second.firstEpoch;
+          allocation.lastEpoch = it->second.lastEpoch;
+        } else {
+          allocation.firstEpoch =
+              std::min(allocation.firstEpoch, it->second.firstEpoch);
+          allocation.lastEpoch =
+              std::max(allocation.lastEpoch, it->second.lastEpoch);
+        }
+      }
+      if (!isTransient || recording == -1) continue;
+
+      auto groupIt = llvm::find_if(groups, [&](const TransientGroup &group) {
+        return group.recording == recording &&
+               group.allocator == allocateOp.allocator() &&
+               group.memoryTypes == allocateOp.memory_types() &&
+               group.bufferUsage == allocateOp.buffer_usage();
+      });
+      if (groupIt == groups.end()) {
+        groups.push_back(TransientGroup{recording, allocateOp.allocator(),
+                                        allocateOp.memory_types(),
+                                        allocateOp.buffer_usage(),
+                                        {}});
+        groupIt = std::prev(groups.end());
+      }
+      groupIt->allocations.push_back(allocation);
+    }
+    return groups;
+  }
+
+  void packBlock(Block &block, BufferConstraintsAttr bufferConstraints) {
+    uint64_t alignment =
+        bufferConstraints.min_buffer_offset_alignment().getZExtValue();
+    uint64_t maxAllocationSize =
+        bufferConstraints.max_allocation_size().getZExtValue();
+
+    for (auto &group : gatherTransientGroups(block)) {
+      if (group.allocations.size() < 2) continue;
+
+      uint64_t naiveSize = 0;
+      for (auto &allocation : group.allocations) {
+        naiveSize += align(allocation.size, alignment);
+      }
+      uint64_t slabSize = packAllocations(group.allocations, alignment);
+      if (slabSize > maxAllocationSize) continue;
+
+      LLVM_DEBUG(llvm::dbgs()
+                 << "packed " << group.allocations.size()
+                 << " transient allocations of " << naiveSize
+                 << " bytes into a " << slabSize << " byte slab\n");
+      naiveTransientBytes += naiveSize;
+      packedTransientBytes += slabSize;
+      packedAllocations += group.allocations.size();
+
+      // Allocate the slab in place of the first transient; all sizes are
+      // constant and the allocator dominates every allocation in the group.
+      auto firstAllocateOp = group.allocations.front().allocateOp;
+      SmallVector<Location, 8> locs;
+      for (auto &allocation : group.allocations) {
+        locs.push_back(allocation.allocateOp.getLoc());
+      }
+      OpBuilder builder(firstAllocateOp);
+      auto slabLoc = builder.getFusedLoc(locs);
+      auto slabSizeValue =
+          builder.createOrFold<mlir::ConstantIndexOp>(slabLoc, slabSize);
+      auto slabBuffer = builder.create<AllocatorAllocateOp>(
+          slabLoc, BufferType::get(builder.getContext()), group.allocator,
+          group.memoryTypes, group.bufferUsage, slabSizeValue);
+
+      // Replace each transient with a subspan of the slab.
+      for (auto &allocation : group.allocations) {
+        auto allocateOp = allocation.allocateOp;
+        builder.setInsertionPoint(allocateOp);
+        auto offsetValue = builder.createOrFold<mlir::ConstantIndexOp>(
+            allocateOp.getLoc(), allocation.offset);
+        auto subspanOp = builder.create<BufferSubspanOp>(
+            allocateOp.getLoc(), allocateOp.getType(), slabBuffer.result(),
+            offsetValue, allocateOp.result_size());
+        allocateOp.replaceAllUsesWith(subspanOp.result());
+        allocateOp.erase();
+      }
+    }
+  }
+
+  TargetOptions targetOptions_;
+
+  Statistic packedAllocations{
+      this, "packed allocation(s)",
+      "Number of transient allocations packed into slabs"};
+  Statistic naiveTransientBytes{
+      this, "naive transient byte(s)",
+      "Total size of packed transients if allocated individually"};
+  Statistic packedTransientBytes{
+      this, "packed transient byte(s)",
+      "Total size of the slabs the transients were packed into"};
+};
+
+std::unique_ptr<OperationPass<FuncOp>> createPackTransientAllocationsPass(
+    TargetOptions targetOptions) {
+  return std::make_unique<PackTransientAllocationsPass>(targetOptions);
+}
+
+static PassRegistration<PackTransientAllocationsPass> pass(
+    "iree-hal-pack-transient-allocations",
+    "Packs transient allocations used within a command buffer into a single "
+    "slab with lifetime-aliased offsets.",
+    [] {
+      auto options = getTargetOptionsFromFlags();
+      return std::make_unique<PackTransientAllocationsPass>(options);
+    });
+
+}  // namespace HAL
+}  // namespace IREE
+}  // namespace iree_compiler
+}  // namespace mlir
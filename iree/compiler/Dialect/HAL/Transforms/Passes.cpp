@@ -86,6 +86,11 @@ void buildHALTransformPassPipeline(OpPassManager &passManager,
   passManager.addNestedPass<FuncOp>(createCanonicalizerPass());
   passManager.addNestedPass<FuncOp>(createCSEPass());
 
+  // Pack the transient buffers of each stream into a single allocation now
+  // that the allocation sizes have been folded to constants where possible.
+  passManager.addNestedPass<FuncOp>(
+      createPackTransientAllocationsPass(targetOptions));
+
   // For each exported function, processes the reflection metadata and
   // generates public ABI wrappers for various calling conventions.
   // Phase ordering note: This operates on functions whose signatures have
@@ -128,6 +128,12 @@ createMaterializeConstantPoolBuffersPass();
 std::unique_ptr<OperationPass<ModuleOp>> createMaterializeResourceCachesPass(
     TargetOptions executableOptions);
 
+// Packs transient allocations that are only used within a single command
+// buffer into one slab per recording. Allocations whose lifetimes (measured in
+// execution barriers) do not overlap alias the same slab range.
+std::unique_ptr<OperationPass<FuncOp>> createPackTransientAllocationsPass(
+    TargetOptions targetOptions);
+
 // Eliminates redundant 'load's of variables within functions with no 'store'.
 // TODO(#1124): replace with memory side effects once supported upstream.
 std::unique_ptr<OperationPass<FuncOp>> createCSEVariableLoadsPass();
@@ -158,6 +164,7 @@ inline void registerHALPasses() {
   createPackConstantPoolStoragePass();
   createMaterializeConstantPoolBuffersPass();
   createMaterializeResourceCachesPass(executableOptions);
+  createPackTransientAllocationsPass(executableOptions);
 }
 
 }  // namespace HAL
@@ -0,0 +1,118 @@
+// RUN: iree-opt -split-input-file -iree-hal-pack-transient-allocations %s | IreeFileCheck %s
+
+// Transients whose lifetimes do not overlap across execution barriers alias
+// the same range of the slab.
+
+// CHECK-LABEL: @packTransients
+//  CHECK-SAME: (%[[DEVICE:.+]]: !hal.device, %[[ALLOCATOR:.+]]: !hal.allocator,
+//  CHECK-SAME:  %[[LAYOUT:.+]]: !hal.executable_layout, %[[INPUT:.+]]: !hal.buffer)
+func @packTransients(%device: !hal.device, %allocator: !hal.allocator,
+                     %layout: !hal.executable_layout, %input: !hal.buffer) -> !hal.buffer {
+  %c0 = constant 0 : index
+  %c1 = constant 1 : index
+  %c512 = constant 512 : index
+  // CHECK-DAG: %[[SLAB_SIZE:.+]] = constant 1024 : index
+  //     CHECK: %[[SLAB:.+]] = hal.allocator.allocate<%[[ALLOCATOR]] : !hal.allocator>
+  // CHECK-SAME:   type("DeviceVisible|DeviceLocal")
+  // CHECK-SAME:   usage("Transfer|Dispatch")
+  // CHECK-SAME:   : !hal.buffer{%[[SLAB_SIZE]]}
+  // CHECK-DAG: %[[OFFSET_A:.+]] = constant 0 : index
+  //     CHECK: %[[TMP_A:.+]] = hal.buffer.subspan<%[[SLAB]] : !hal.buffer>[%[[OFFSET_A]], %c512]
+  %tmp_a = hal.allocator.allocate<%allocator : !hal.allocator>
+      type(DeviceLocal) usage("Transfer|Dispatch") : !hal.buffer{%c512}
+  // CHECK-DAG: %[[OFFSET_B:.+]] = constant 512 : index
+  //     CHECK: %[[TMP_B:.+]] = hal.buffer.subspan<%[[SLAB]] : !hal.buffer>[%[[OFFSET_B]], %c512]
+  %tmp_b = hal.allocator.allocate<%allocator : !hal.allocator>
+      type(DeviceLocal) usage("Transfer|Dispatch") : !hal.buffer{%c512}
+  // CHECK-DAG: %[[OFFSET_C:.+]] = constant 0 : index
+  //     CHECK: %[[TMP_C:.+]] = hal.buffer.subspan<%[[SLAB]] : !hal.buffer>[%[[OFFSET_C]], %c512]
+  %tmp_c = hal.allocator.allocate<%allocator : !hal.allocator>
+      type(DeviceLocal) usage("Transfer|Dispatch") : !hal.buffer{%c512}
+  // Outputs escape the command buffer and are not packed.
+  // CHECK: %[[OUTPUT:.+]] = hal.allocator.allocate<%[[ALLOCATOR]] : !hal.allocator>
+  %output = hal.allocator.allocate<%allocator : !hal.allocator>
+      type("HostVisible|DeviceLocal") usage(All) : !hal.buffer{%c512}
+  // CHECK-NOT: hal.allocator.allocate
+  %cmd = hal.command_buffer.create device(%device : !hal.device)
+                                     mode(OneShot)
+                               categories("Transfer|Dispatch") : !hal.command_buffer
+  hal.command_buffer.begin<%cmd : !hal.command_buffer>
+  // CHECK: hal.command_buffer.push_descriptor_set
+  // CHECK-NEXT: %c0 = (%[[INPUT]] : !hal.buffer)[%c0, %c512],
+  // CHECK-NEXT: %c1 = (%[[TMP_A]] : !hal.buffer)[%c0, %c512]
+  hal.command_buffer.push_descriptor_set<%cmd : !hal.command_buffer>
+      layout(%layout : !hal.executable_layout)[%c0]
+      bindings([
+        %c0 = (%input : !hal.buffer)[%c0, %c512],
+        %c1 = (%tmp_a : !hal.buffer)[%c0, %c512]
+      ])
+  hal.command_buffer.execution_barrier<%cmd : !hal.command_buffer>
+      source("CommandRetire|Dispatch")
+      target("CommandIssue|Dispatch")
+      flags("None")
+  // CHECK: hal.command_buffer.push_descriptor_set
+  // CHECK-NEXT: %c0 = (%[[TMP_A]] : !hal.buffer)[%c0, %c512],
+  // CHECK-NEXT: %c1 = (%[[TMP_B]] : !hal.buffer)[%c0, %c512]
+  hal.command_buffer.push_descriptor_set<%cmd : !hal.command_buffer>
+      layout(%layout : !hal.executable_layout)[%c0]
+      bindings([
+        %c0 = (%tmp_a : !hal.buffer)[%c0, %c512],
+        %c1 = (%tmp_b : !hal.buffer)[%c0, %c512]
+      ])
+  hal.command_buffer.execution_barrier<%cmd : !hal.command_buffer>
+      source("CommandRetire|Dispatch")
+      target("CommandIssue|Dispatch")
+      flags("None")
+  // CHECK: hal.command_buffer.copy_buffer
+  // CHECK-SAME: source(%[[TMP_B]] : !hal.buffer)[%c0]
+  // CHECK-SAME: target(%[[TMP_C]] : !hal.buffer)[%c0]
+  hal.command_buffer.copy_buffer<%cmd : !hal.command_buffer>
+      source(%tmp_b : !hal.buffer)[%c0]
+      target(%tmp_c : !hal.buffer)[%c0]
+      length(%c512)
+  hal.command_buffer.execution_barrier<%cmd : !hal.command_buffer>
+      source("CommandRetire|Dispatch")
+      target("CommandIssue|Dispatch")
+      flags("None")
+  // CHECK: hal.command_buffer.copy_buffer
+  // CHECK-SAME: source(%[[TMP_C]] : !hal.buffer)[%c0]
+  // CHECK-SAME: target(%[[OUTPUT]] : !hal.buffer)[%c0]
+  hal.command_buffer.copy_buffer<%cmd : !hal.command_buffer>
+      source(%tmp_c : !hal.buffer)[%c0]
+      target(%output : !hal.buffer)[%c0]
+      length(%c512)
+  hal.command_buffer.end<%cmd : !hal.command_buffer>
+  hal.ex.submit_and_wait %device, %cmd
+  return %output : !hal.buffer
+}
+
+// -----
+
+// Dynamically-sized transients and transients used outside of the command
+// buffer keep their own allocations.
+
+// CHECK-LABEL: @skipUnpackableTransients
+func @skipUnpackableTransients(%device: !hal.device, %allocator: !hal.allocator,
+                               %size: index) -> !hal.buffer {
+  %c0 = constant 0 : index
+  %c512 = constant 512 : index
+  // CHECK: %[[DYNAMIC:.+]] = hal.allocator.allocate{{.+}} : !hal.buffer{%arg2}
+  %dynamic = hal.allocator.allocate<%allocator : !hal.allocator>
+      type(DeviceLocal) usage("Transfer|Dispatch") : !hal.buffer{%size}
+  // CHECK: %[[ESCAPING:.+]] = hal.allocator.allocate{{.+}} : !hal.buffer{%c512}
+  %escaping = hal.allocator.allocate<%allocator : !hal.allocator>
+      type(DeviceLocal) usage("Transfer|Dispatch") : !hal.buffer{%c512}
+  // CHECK-NOT: hal.buffer.subspan
+  %cmd = hal.command_buffer.create device(%device : !hal.device)
+                                     mode(OneShot)
+                               categories("Transfer|Dispatch") : !hal.command_buffer
+  hal.command_buffer.begin<%cmd : !hal.command_buffer>
+  hal.command_buffer.copy_buffer<%cmd : !hal.command_buffer>
+      source(%dynamic : !hal.buffer)[%c0]
+      target(%escaping : !hal.buffer)[%c0]
+      length(%c512)
+  hal.command_buffer.end<%cmd : !hal.command_buffer>
+  hal.ex.submit_and_wait %device, %cmd
+  // CHECK: return %[[ESCAPING]]
+  return %escaping : !hal.buffer
+}
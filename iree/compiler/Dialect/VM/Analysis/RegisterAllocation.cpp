@@ -527,9 +527,35 @@ RegisterAllocation::remapSuccessorRegisters(Operation *op, int successorIndex) {
              srcDstRegs.size() &&
          "lost an edge during feedback arc set computation");
 
+  // Refs can be moved into the target registers when the source value is not
+  // used again in the target block and is only read once by the remapping.
+  // Otherwise the source register would keep a reference to a dead value
+  // until the register is overwritten or the frame is popped.
+  llvm::SmallDenseSet<Register, 8> moveRegs;
+  auto liveIns = liveness_.getBlockLiveIns(targetBlock);
+  for (auto value : *operands) {
+    if (!value.getType().isa<IREE::VM::RefType>() ||
+        llvm::is_contained(liveIns, value) ||
+        llvm::count(*operands, value) != 1) {
+      continue;
+    }
+    moveRegs.insert(mapToRegister(value));
+  }
+  auto setMoveBits = [&](SmallVector<std::pair<Register, Register>, 8> edges) {
+    for (auto &edge : edges) {
+      if (edge.first.isRef() &&
+          (moveRegs.count(edge.first) ||
+           edge.first.ordinal() > maxRefRegisterOrdinal_)) {
+        // Either the last use of the source value or a scratch register.
+        edge.first.setMove(true);
+      }
+    }
+    return edges;
+  };
+
   // If there's no cycles we can simply use the sorted DAG produced.
   if (feedbackArcSet.feedbackEdges.empty()) {
-    return feedbackArcSet.acyclicEdges;
+    return setMoveBits(std::move(feedbackArcSet.acyclicEdges));
   }
 
   // The tail registers in each bank is reserved for swapping, when required.
@@ -565,7 +591,7 @@ RegisterAllocation::remapSuccessorRegisters(Operation *op, int successorIndex) {
     }
   }
 
-  return feedbackArcSet.acyclicEdges;
+  return setMoveBits(std::move(feedbackArcSet.acyclicEdges));
 }
 
 }  // namespace iree_compiler
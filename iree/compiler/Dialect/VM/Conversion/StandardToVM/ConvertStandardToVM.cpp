@@ -160,13 +160,16 @@ class ConstantOpConversion : public OpConversionPattern<ConstantOp> {
   LogicalResult matchAndRewrite(
       ConstantOp srcOp, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const override {
+    // TODO(#2878): use getTypeConverter() when we pass it upon creation.
+    IREE::VM::TypeConverter typeConverter(
+        IREE::VM::getTargetOptionsFromFlags());
+    if (auto floatAttr = srcOp.getValue().dyn_cast<FloatAttr>()) {
+      return rewriteFloatConstant(srcOp, floatAttr, typeConverter, rewriter);
+    }
     auto integerAttr = srcOp.getValue().dyn_cast<IntegerAttr>();
     if (!integerAttr) {
       return srcOp.emitRemark() << "unsupported const type for dialect";
     }
-    // TODO(#2878): use getTypeConverter() when we pass it upon creation.
-    IREE::VM::TypeConverter typeConverter(
-        IREE::VM::getTargetOptionsFromFlags());
     auto targetType = typeConverter.convertType(srcOp.getType());
     switch (targetType.getIntOrFloatBitWidth()) {
       case 1:
@@ -192,6 +195,41 @@ class ConstantOpConversion : public OpConversionPattern<ConstantOp> {
     }
     return success();
   }
+
+ private:
+  LogicalResult rewriteFloatConstant(
+      ConstantOp srcOp, FloatAttr floatAttr,
+      IREE::VM::TypeConverter &typeConverter,
+      ConversionPatternRewriter &rewriter) const {
+    auto targetType = typeConverter.convertType(srcOp.getType());
+    if (!targetType) {
+      return srcOp.emitRemark() << "unsupported const float type for dialect";
+    }
+    // Only +0.0 can use the zero ops; -0.0 must keep its sign bit.
+    bool isZero = floatAttr.getValue().isPosZero();
+    switch (targetType.getIntOrFloatBitWidth()) {
+      case 32:
+        if (isZero) {
+          rewriter.replaceOpWithNewOp<IREE::VM::ConstF32ZeroOp>(srcOp);
+        } else {
+          rewriter.replaceOpWithNewOp<IREE::VM::ConstF32Op>(
+              srcOp, static_cast<float>(floatAttr.getValueAsDouble()));
+        }
+        break;
+      case 64:
+        if (isZero) {
+          rewriter.replaceOpWithNewOp<IREE::VM::ConstF64ZeroOp>(srcOp);
+        } else {
+          rewriter.replaceOpWithNewOp<IREE::VM::ConstF64Op>(
+              srcOp, floatAttr.getValueAsDouble());
+        }
+        break;
+      default:
+        return srcOp.emitRemark()
+               << "unsupported const float bit width for dialect";
+    }
+    return success();
+  }
 };
 
 class CmpIOpConversion : public OpConversionPattern<CmpIOp> {
@@ -249,6 +287,116 @@ class CmpIOpConversion : public OpConversionPattern<CmpIOp> {
   }
 };
 
+// Converts cmpf ops with |kBits|-wide operands. The VM only has ordered
+// comparisons so unordered predicates are lowered to the negation of the
+// inverse ordered comparison (ult == !oge, etc).
+template <unsigned kBits, typename CmpEQOp, typename CmpNEOp, typename CmpLTOp,
+          typename CmpLTEOp, typename CmpGTOp, typename CmpGTEOp>
+class CmpFOpConversion : public OpConversionPattern<CmpFOp> {
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult matchAndRewrite(
+      CmpFOp srcOp, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    CmpFOp::Adaptor srcAdapter(operands);
+    auto operandType = srcAdapter.lhs().getType();
+    if (!operandType.isa<FloatType>() ||
+        operandType.getIntOrFloatBitWidth() != kBits) {
+      return failure();
+    }
+    auto loc = srcOp.getLoc();
+    auto returnType = rewriter.getIntegerType(32);
+    Value lhs = srcAdapter.lhs();
+    Value rhs = srcAdapter.rhs();
+    Value result;
+    switch (srcOp.getPredicate()) {
+      case CmpFPredicate::AlwaysFalse:
+        rewriter.replaceOpWithNewOp<IREE::VM::ConstI32ZeroOp>(srcOp);
+        return success();
+      case CmpFPredicate::AlwaysTrue:
+        rewriter.replaceOpWithNewOp<IREE::VM::ConstI32Op>(srcOp, 1);
+        return success();
+      case CmpFPredicate::OEQ:
+        result = rewriter.create<CmpEQOp>(loc, returnType, lhs, rhs);
+        break;
+      case CmpFPredicate::ONE:
+        result = rewriter.create<CmpNEOp>(loc, returnType, lhs, rhs);
+        break;
+      case CmpFPredicate::OLT:
+        result = rewriter.create<CmpLTOp>(loc, returnType, lhs, rhs);
+        break;
+      case CmpFPredicate::OLE:
+        result = rewriter.create<CmpLTEOp>(loc, returnType, lhs, rhs);
+        break;
+      case CmpFPredicate::OGT:
+        result = rewriter.create<CmpGTOp>(loc, returnType, lhs, rhs);
+        break;
+      case CmpFPredicate::OGE:
+        result = rewriter.create<CmpGTEOp>(loc, returnType, lhs, rhs);
+        break;
+      case CmpFPredicate::ORD:
+        result = createOrdered(loc, returnType, lhs, rhs, rewriter);
+        break;
+      case CmpFPredicate::UEQ:
+        result = createNot(
+            loc, rewriter.create<CmpNEOp>(loc, returnType, lhs, rhs),
+            rewriter);
+        break;
+      case CmpFPredicate::UNE:
+        result = createNot(
+            loc, rewriter.create<CmpEQOp>(loc, returnType, lhs, rhs),
+            rewriter);
+        break;
+      case CmpFPredicate::ULT:
+        result = createNot(
+            loc, rewriter.create<CmpGTEOp>(loc, returnType, lhs, rhs),
+            rewriter);
+        break;
+      case CmpFPredicate::ULE:
+        result = createNot(
+            loc, rewriter.create<CmpGTOp>(loc, returnType, lhs, rhs),
+            rewriter);
+        break;
+      case CmpFPredicate::UGT:
+        result = createNot(
+            loc, rewriter.create<CmpLTEOp>(loc, returnType, lhs, rhs),
+            rewriter);
+        break;
+      case CmpFPredicate::UGE:
+        result = createNot(
+            loc, rewriter.create<CmpLTOp>(loc, returnType, lhs, rhs),
+            rewriter);
+        break;
+      case CmpFPredicate::UNO:
+        result = createNot(
+            loc, createOrdered(loc, returnType, lhs, rhs, rewriter), rewriter);
+        break;
+      default:
+        return failure();
+    }
+    rewriter.replaceOp(srcOp, result);
+    return success();
+  }
+
+ private:
+  // Returns 1 if neither |lhs| nor |rhs| is NaN.
+  static Value createOrdered(Location loc, Type returnType, Value lhs,
+                             Value rhs, ConversionPatternRewriter &rewriter) {
+    auto lhsOrdered = rewriter.create<CmpEQOp>(loc, returnType, lhs, lhs);
+    auto rhsOrdered = rewriter.create<CmpEQOp>(loc, returnType, rhs, rhs);
+    return rewriter.create<IREE::VM::AndI32Op>(loc, returnType, lhsOrdered,
+                                               rhsOrdered);
+  }
+
+  // Returns the logical negation of the i32 boolean |value|.
+  static Value createNot(Location loc, Value value,
+                         ConversionPatternRewriter &rewriter) {
+    auto one = rewriter.create<IREE::VM::ConstI32Op>(loc, 1);
+    return rewriter.create<IREE::VM::XorI32Op>(loc, value.getType(), value,
+                                               one);
+  }
+};
+
 template <typename SrcOpTy, typename DstOpTy>
 class BinaryArithmeticOpConversion : public OpConversionPattern<SrcOpTy> {
   using OpConversionPattern<SrcOpTy>::OpConversionPattern;
@@ -264,6 +412,50 @@ class BinaryArithmeticOpConversion : public OpConversionPattern<SrcOpTy> {
   }
 };
 
+template <typename SrcOpTy, typename DstF32OpTy, typename DstF64OpTy>
+class FloatBinaryArithmeticOpConversion : public OpConversionPattern<SrcOpTy> {
+  using OpConversionPattern<SrcOpTy>::OpConversionPattern;
+
+  LogicalResult matchAndRewrite(
+      SrcOpTy srcOp, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    typename SrcOpTy::Adaptor srcAdapter(operands);
+    auto type = srcAdapter.lhs().getType();
+    if (type.isF32()) {
+      rewriter.replaceOpWithNewOp<DstF32OpTy>(srcOp, type, srcAdapter.lhs(),
+                                              srcAdapter.rhs());
+    } else if (type.isF64()) {
+      rewriter.replaceOpWithNewOp<DstF64OpTy>(srcOp, type, srcAdapter.lhs(),
+                                              srcAdapter.rhs());
+    } else {
+      return failure();
+    }
+    return success();
+  }
+};
+
+template <typename SrcOpTy, typename DstF32OpTy, typename DstF64OpTy>
+class FloatUnaryArithmeticOpConversion : public OpConversionPattern<SrcOpTy> {
+  using OpConversionPattern<SrcOpTy>::OpConversionPattern;
+
+  LogicalResult matchAndRewrite(
+      SrcOpTy srcOp, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    typename SrcOpTy::Adaptor srcAdapter(operands);
+    auto type = srcAdapter.operand().getType();
+    if (type.isF32()) {
+      rewriter.replaceOpWithNewOp<DstF32OpTy>(srcOp, type,
+                                              srcAdapter.operand());
+    } else if (type.isF64()) {
+      rewriter.replaceOpWithNewOp<DstF64OpTy>(srcOp, type,
+                                              srcAdapter.operand());
+    } else {
+      return failure();
+    }
+    return success();
+  }
+};
+
 template <typename SrcOpTy, typename DstOpTy, unsigned kBits = 32>
 class ShiftArithmeticOpConversion : public OpConversionPattern<SrcOpTy> {
   using OpConversionPattern<SrcOpTy>::OpConversionPattern;
@@ -302,6 +494,106 @@ class CastingOpConversion : public OpConversionPattern<StdOp> {
   }
 };
 
+class SIToFPOpConversion : public OpConversionPattern<SIToFPOp> {
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult matchAndRewrite(
+      SIToFPOp srcOp, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    SIToFPOp::Adaptor srcAdaptor(operands);
+    if (!srcAdaptor.in().getType().isInteger(32)) {
+      return failure();
+    }
+    auto resultType = getTypeConverter()->convertType(srcOp.getType());
+    if (!resultType) {
+      return failure();
+    } else if (resultType.isF32()) {
+      rewriter.replaceOpWithNewOp<IREE::VM::CastSI32F32Op>(srcOp, resultType,
+                                                           srcAdaptor.in());
+    } else if (resultType.isF64()) {
+      rewriter.replaceOpWithNewOp<IREE::VM::CastSI32F64Op>(srcOp, resultType,
+                                                           srcAdaptor.in());
+    } else {
+      return failure();
+    }
+    return success();
+  }
+};
+
+class FPToSIOpConversion : public OpConversionPattern<FPToSIOp> {
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult matchAndRewrite(
+      FPToSIOp srcOp, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    FPToSIOp::Adaptor srcAdaptor(operands);
+    // Narrower results would need their own saturation bounds.
+    if (!srcOp.getType().isInteger(32)) {
+      return failure();
+    }
+    auto operandType = srcAdaptor.in().getType();
+    auto resultType = rewriter.getIntegerType(32);
+    if (operandType.isF32()) {
+      rewriter.replaceOpWithNewOp<IREE::VM::CastF32SI32Op>(srcOp, resultType,
+                                                           srcAdaptor.in());
+    } else if (operandType.isF64()) {
+      rewriter.replaceOpWithNewOp<IREE::VM::CastF64SI32Op>(srcOp, resultType,
+                                                           srcAdaptor.in());
+    } else {
+      return failure();
+    }
+    return success();
+  }
+};
+
+class FPExtOpConversion : public OpConversionPattern<FPExtOp> {
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult matchAndRewrite(
+      FPExtOp srcOp, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    FPExtOp::Adaptor srcAdaptor(operands);
+    auto operandType = srcAdaptor.in().getType();
+    auto resultType = getTypeConverter()->convertType(srcOp.getType());
+    if (!resultType) {
+      return failure();
+    } else if (resultType == operandType) {
+      // f64 was truncated to f32 and there is nothing to extend.
+      rewriter.replaceOp(srcOp, srcAdaptor.in());
+    } else if (operandType.isF32() && resultType.isF64()) {
+      rewriter.replaceOpWithNewOp<IREE::VM::ExtF32F64Op>(srcOp, resultType,
+                                                         srcAdaptor.in());
+    } else {
+      return failure();
+    }
+    return success();
+  }
+};
+
+class FPTruncOpConversion : public OpConversionPattern<FPTruncOp> {
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult matchAndRewrite(
+      FPTruncOp srcOp, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    FPTruncOp::Adaptor srcAdaptor(operands);
+    auto operandType = srcAdaptor.in().getType();
+    auto resultType = getTypeConverter()->convertType(srcOp.getType());
+    if (!resultType) {
+      return failure();
+    } else if (resultType == operandType) {
+      // f64 was already truncated to f32 by the type conversion.
+      rewriter.replaceOp(srcOp, srcAdaptor.in());
+    } else if (operandType.isF64() && resultType.isF32()) {
+      rewriter.replaceOpWithNewOp<IREE::VM::TruncF64F32Op>(srcOp, resultType,
+                                                           srcAdaptor.in());
+    } else {
+      return failure();
+    }
+    return success();
+  }
+};
+
 class SelectI32OpConversion : public OpConversionPattern<SelectOp> {
   using OpConversionPattern::OpConversionPattern;
   LogicalResult matchAndRewrite(
@@ -316,7 +608,8 @@ class SelectI32OpConversion : public OpConversionPattern<SelectOp> {
     // (Otherwise, the dialect converter may report the error as a failure to
     // legalize the select op depending on order of resolution).
     auto actualType = srcAdaptor.true_value().getType();
-    if (actualType != requiredType && actualType.isa<IndexType>()) {
+    if (actualType != requiredType &&
+        (actualType.isa<IndexType>() || actualType.isa<FloatType>())) {
       return failure();
     }
 
@@ -327,6 +620,28 @@ class SelectI32OpConversion : public OpConversionPattern<SelectOp> {
   }
 };
 
+class SelectFloatOpConversion : public OpConversionPattern<SelectOp> {
+  using OpConversionPattern::OpConversionPattern;
+  LogicalResult matchAndRewrite(
+      SelectOp srcOp, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    SelectOp::Adaptor srcAdaptor(operands);
+    auto type = srcAdaptor.true_value().getType();
+    if (type.isF32()) {
+      rewriter.replaceOpWithNewOp<IREE::VM::SelectF32Op>(
+          srcOp, type, srcAdaptor.condition(), srcAdaptor.true_value(),
+          srcAdaptor.false_value());
+    } else if (type.isF64()) {
+      rewriter.replaceOpWithNewOp<IREE::VM::SelectF64Op>(
+          srcOp, type, srcAdaptor.condition(), srcAdaptor.true_value(),
+          srcAdaptor.false_value());
+    } else {
+      return failure();
+    }
+    return success();
+  }
+};
+
 class BranchOpConversion : public OpConversionPattern<BranchOp> {
   using OpConversionPattern::OpConversionPattern;
 
@@ -386,8 +701,8 @@ void populateStandardToVMPatterns(MLIRContext *context,
   patterns.insert<BranchOpConversion, CallOpConversion, CmpIOpConversion,
                   CondBranchOpConversion, ModuleOpConversion, FuncOpConversion,
                   ReturnOpConversion, CastingOpConversion<IndexCastOp>,
-                  CastingOpConversion<TruncateIOp>, SelectI32OpConversion>(
-      typeConverter, context);
+                  CastingOpConversion<TruncateIOp>, SelectI32OpConversion,
+                  SelectFloatOpConversion>(typeConverter, context);
   // TODO(#2878): pass typeConverter here.
   patterns.insert<ConstantOpConversion>(context);
 
@@ -409,6 +724,35 @@ void populateStandardToVMPatterns(MLIRContext *context,
   // TODO(laurenzo): The standard dialect is missing shr ops. Add once in place.
   patterns.insert<ShiftArithmeticOpConversion<ShiftLeftOp, IREE::VM::ShlI32Op>>(
       typeConverter, context);
+
+  // Floating-point ops (ExtF32/ExtF64)
+  patterns.insert<
+      FloatBinaryArithmeticOpConversion<AddFOp, IREE::VM::AddF32Op,
+                                        IREE::VM::AddF64Op>,
+      FloatBinaryArithmeticOpConversion<SubFOp, IREE::VM::SubF32Op,
+                                        IREE::VM::SubF64Op>,
+      FloatBinaryArithmeticOpConversion<MulFOp, IREE::VM::MulF32Op,
+                                        IREE::VM::MulF64Op>,
+      FloatBinaryArithmeticOpConversion<DivFOp, IREE::VM::DivF32Op,
+                                        IREE::VM::DivF64Op>,
+      FloatBinaryArithmeticOpConversion<RemFOp, IREE::VM::RemF32Op,
+                                        IREE::VM::RemF64Op>,
+      FloatUnaryArithmeticOpConversion<AbsFOp, IREE::VM::AbsF32Op,
+                                       IREE::VM::AbsF64Op>,
+      FloatUnaryArithmeticOpConversion<NegFOp, IREE::VM::NegF32Op,
+                                       IREE::VM::NegF64Op>,
+      FloatUnaryArithmeticOpConversion<CeilFOp, IREE::VM::CeilF32Op,
+                                       IREE::VM::CeilF64Op>,
+      FloatUnaryArithmeticOpConversion<FloorFOp, IREE::VM::FloorF32Op,
+                                       IREE::VM::FloorF64Op>,
+      CmpFOpConversion<32, IREE::VM::CmpEQF32OOp, IREE::VM::CmpNEF32OOp,
+                       IREE::VM::CmpLTF32OOp, IREE::VM::CmpLTEF32OOp,
+                       IREE::VM::CmpGTF32OOp, IREE::VM::CmpGTEF32OOp>,
+      CmpFOpConversion<64, IREE::VM::CmpEQF64OOp, IREE::VM::CmpNEF64OOp,
+                       IREE::VM::CmpLTF64OOp, IREE::VM::CmpLTEF64OOp,
+                       IREE::VM::CmpGTF64OOp, IREE::VM::CmpGTEF64OOp>,
+      SIToFPOpConversion, FPToSIOpConversion, FPExtOpConversion,
+      FPTruncOpConversion>(typeConverter, context);
 }
 
 }  // namespace iree_compiler
@@ -0,0 +1,150 @@
+// RUN: iree-opt -split-input-file -pass-pipeline='test-iree-convert-std-to-vm' -iree-vm-target-extensions=f64 %s | IreeFileCheck %s
+
+// -----
+// CHECK-LABEL: @t001_addf
+module @t001_addf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (f64) {
+    // CHECK: vm.add.f64 %[[ARG0]], %[[ARG1]] : f64
+    %0 = addf %arg0, %arg1 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t002_subf
+module @t002_subf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (f64) {
+    // CHECK: vm.sub.f64 %[[ARG0]], %[[ARG1]] : f64
+    %0 = subf %arg0, %arg1 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t003_mulf
+module @t003_mulf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (f64) {
+    // CHECK: vm.mul.f64 %[[ARG0]], %[[ARG1]] : f64
+    %0 = mulf %arg0, %arg1 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t004_divf
+module @t004_divf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (f64) {
+    // CHECK: vm.div.f64 %[[ARG0]], %[[ARG1]] : f64
+    %0 = divf %arg0, %arg1 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t005_remf
+module @t005_remf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (f64) {
+    // CHECK: vm.rem.f64 %[[ARG0]], %[[ARG1]] : f64
+    %0 = remf %arg0, %arg1 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t006_absf
+module @t006_absf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64) -> (f64) {
+    // CHECK: vm.abs.f64 %[[ARG0]] : f64
+    %0 = absf %arg0 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t007_negf
+module @t007_negf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64) -> (f64) {
+    // CHECK: vm.neg.f64 %[[ARG0]] : f64
+    %0 = negf %arg0 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t008_ceilf
+module @t008_ceilf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64) -> (f64) {
+    // CHECK: vm.ceil.f64 %[[ARG0]] : f64
+    %0 = ceilf %arg0 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t009_floorf
+module @t009_floorf {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64) -> (f64) {
+    // CHECK: vm.floor.f64 %[[ARG0]] : f64
+    %0 = floorf %arg0 : f64
+    return %0 : f64
+  }
+}
+
+}
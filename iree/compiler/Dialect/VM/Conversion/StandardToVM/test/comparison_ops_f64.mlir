@@ -0,0 +1,285 @@
+// RUN: iree-opt -split-input-file -pass-pipeline='test-iree-convert-std-to-vm' -iree-vm-target-extensions=f64 %s | IreeFileCheck %s
+
+// -----
+// CHECK-LABEL: @t001_cmp_oeq
+module @t001_cmp_oeq {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: vm.cmp.eq.f64.o %[[ARG0]], %[[ARG1]] : f64
+    %1 = cmpf oeq, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t002_cmp_one
+module @t002_cmp_one {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: vm.cmp.ne.f64.o %[[ARG0]], %[[ARG1]] : f64
+    %1 = cmpf one, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t003_cmp_olt
+module @t003_cmp_olt {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: vm.cmp.lt.f64.o %[[ARG0]], %[[ARG1]] : f64
+    %1 = cmpf olt, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t004_cmp_ole
+module @t004_cmp_ole {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: vm.cmp.lte.f64.o %[[ARG0]], %[[ARG1]] : f64
+    %1 = cmpf ole, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t005_cmp_ogt
+module @t005_cmp_ogt {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: vm.cmp.gt.f64.o %[[ARG0]], %[[ARG1]] : f64
+    %1 = cmpf ogt, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t006_cmp_oge
+module @t006_cmp_oge {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: vm.cmp.gte.f64.o %[[ARG0]], %[[ARG1]] : f64
+    %1 = cmpf oge, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t007_cmp_ueq
+module @t007_cmp_ueq {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: %[[CMP:.+]] = vm.cmp.ne.f64.o %[[ARG0]], %[[ARG1]] : f64
+    // CHECK: %[[ONE:.+]] = vm.const.i32 1 : i32
+    // CHECK: vm.xor.i32 %[[CMP]], %[[ONE]] : i32
+    %1 = cmpf ueq, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t008_cmp_une
+module @t008_cmp_une {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: %[[CMP:.+]] = vm.cmp.eq.f64.o %[[ARG0]], %[[ARG1]] : f64
+    // CHECK: %[[ONE:.+]] = vm.const.i32 1 : i32
+    // CHECK: vm.xor.i32 %[[CMP]], %[[ONE]] : i32
+    %1 = cmpf une, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t009_cmp_ult
+module @t009_cmp_ult {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: %[[CMP:.+]] = vm.cmp.gte.f64.o %[[ARG0]], %[[ARG1]] : f64
+    // CHECK: %[[ONE:.+]] = vm.const.i32 1 : i32
+    // CHECK: vm.xor.i32 %[[CMP]], %[[ONE]] : i32
+    %1 = cmpf ult, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t010_cmp_ule
+module @t010_cmp_ule {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: %[[CMP:.+]] = vm.cmp.gt.f64.o %[[ARG0]], %[[ARG1]] : f64
+    // CHECK: %[[ONE:.+]] = vm.const.i32 1 : i32
+    // CHECK: vm.xor.i32 %[[CMP]], %[[ONE]] : i32
+    %1 = cmpf ule, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t011_cmp_ugt
+module @t011_cmp_ugt {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: %[[CMP:.+]] = vm.cmp.lte.f64.o %[[ARG0]], %[[ARG1]] : f64
+    // CHECK: %[[ONE:.+]] = vm.const.i32 1 : i32
+    // CHECK: vm.xor.i32 %[[CMP]], %[[ONE]] : i32
+    %1 = cmpf ugt, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t012_cmp_uge
+module @t012_cmp_uge {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: %[[CMP:.+]] = vm.cmp.lt.f64.o %[[ARG0]], %[[ARG1]] : f64
+    // CHECK: %[[ONE:.+]] = vm.const.i32 1 : i32
+    // CHECK: vm.xor.i32 %[[CMP]], %[[ONE]] : i32
+    %1 = cmpf uge, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t013_cmp_ord
+module @t013_cmp_ord {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: %[[LHS:.+]] = vm.cmp.eq.f64.o %[[ARG0]], %[[ARG0]] : f64
+    // CHECK: %[[RHS:.+]] = vm.cmp.eq.f64.o %[[ARG1]], %[[ARG1]] : f64
+    // CHECK: vm.and.i32 %[[LHS]], %[[RHS]] : i32
+    %1 = cmpf ord, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t014_cmp_uno
+module @t014_cmp_uno {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: %[[LHS:.+]] = vm.cmp.eq.f64.o %[[ARG0]], %[[ARG0]] : f64
+    // CHECK: %[[RHS:.+]] = vm.cmp.eq.f64.o %[[ARG1]], %[[ARG1]] : f64
+    // CHECK: %[[ORD:.+]] = vm.and.i32 %[[LHS]], %[[RHS]] : i32
+    // CHECK: %[[ONE:.+]] = vm.const.i32 1 : i32
+    // CHECK: vm.xor.i32 %[[ORD]], %[[ONE]] : i32
+    %1 = cmpf uno, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t015_cmp_false
+module @t015_cmp_false {
+
+module {
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: vm.const.i32.zero : i32
+    %1 = cmpf false, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t016_cmp_true
+module @t016_cmp_true {
+
+module {
+  func @my_fn(%arg0: f64, %arg1: f64) -> (i1) {
+    // CHECK: vm.const.i32 1 : i32
+    %1 = cmpf true, %arg0, %arg1 : f64
+    return %1 : i1
+  }
+}
+
+}
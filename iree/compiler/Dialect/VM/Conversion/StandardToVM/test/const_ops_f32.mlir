@@ -0,0 +1,57 @@
+// RUN: iree-opt -split-input-file -pass-pipeline='test-iree-convert-std-to-vm' -iree-vm-target-extensions=f32 %s | IreeFileCheck %s
+
+// -----
+// CHECK-LABEL: @t001_const.f32.nonzero
+module @t001_const.f32.nonzero {
+
+module {
+  func @non_zero() -> (f32) {
+    // CHECK: vm.const.f32 1.500000e+00 : f32
+    %1 = constant 1.5 : f32
+    return %1 : f32
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t002_const.f32.zero
+module @t002_const.f32.zero {
+
+module {
+  func @zero() -> (f32) {
+    // CHECK: vm.const.f32.zero : f32
+    %1 = constant 0.0 : f32
+    return %1 : f32
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t003_const.f32.negative_zero
+module @t003_const.f32.negative_zero {
+
+module {
+  func @negative_zero() -> (f32) {
+    // CHECK: vm.const.f32 -0.000000e+00 : f32
+    %1 = constant -0.0 : f32
+    return %1 : f32
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t004_const.f64.truncated
+module @t004_const.f64.truncated {
+
+module {
+  func @truncated() -> (f64) {
+    // CHECK: vm.const.f32 1.500000e+00 : f32
+    %1 = constant 1.5 : f64
+    return %1 : f64
+  }
+}
+
+}
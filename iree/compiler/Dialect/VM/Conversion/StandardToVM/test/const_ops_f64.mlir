@@ -0,0 +1,43 @@
+// RUN: iree-opt -split-input-file -pass-pipeline='test-iree-convert-std-to-vm' -iree-vm-target-extensions=f64 %s | IreeFileCheck %s
+
+// -----
+// CHECK-LABEL: @t001_const.f64.nonzero
+module @t001_const.f64.nonzero {
+
+module {
+  func @non_zero() -> (f64) {
+    // CHECK: vm.const.f64 1.500000e+00 : f64
+    %1 = constant 1.5 : f64
+    return %1 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t002_const.f64.zero
+module @t002_const.f64.zero {
+
+module {
+  func @zero() -> (f64) {
+    // CHECK: vm.const.f64.zero : f64
+    %1 = constant 0.0 : f64
+    return %1 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t003_const.f64.negative_zero
+module @t003_const.f64.negative_zero {
+
+module {
+  func @negative_zero() -> (f64) {
+    // CHECK: vm.const.f64 -0.000000e+00 : f64
+    %1 = constant -0.0 : f64
+    return %1 : f64
+  }
+}
+
+}
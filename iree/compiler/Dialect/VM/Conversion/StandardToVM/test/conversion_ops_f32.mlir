@@ -0,0 +1,68 @@
+// RUN: iree-opt -split-input-file -pass-pipeline='test-iree-convert-std-to-vm' -iree-vm-target-extensions=f32 %s | IreeFileCheck %s
+
+// -----
+// CHECK-LABEL: @t001_sitofp
+module @t001_sitofp {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: i32) -> (f32) {
+    // CHECK: vm.cast.si32.f32 %[[ARG0]] : i32 -> f32
+    %0 = sitofp %arg0 : i32 to f32
+    return %0 : f32
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t002_fptosi
+module @t002_fptosi {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f32) -> (i32) {
+    // CHECK: vm.cast.f32.si32 %[[ARG0]] : f32 -> i32
+    %0 = fptosi %arg0 : f32 to i32
+    return %0 : i32
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t003_select
+module @t003_select {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[COND:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%cond: i1, %arg0: f32, %arg1: f32) -> (f32) {
+    // CHECK: vm.select.f32 %[[COND]], %[[ARG0]], %[[ARG1]] : f32
+    %0 = select %cond, %arg0, %arg1 : f32
+    return %0 : f32
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t004_fptrunc_truncated
+module @t004_fptrunc_truncated {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64) -> (f32) {
+    // CHECK-NOT: vm.trunc.f64.f32
+    // CHECK: vm.return %[[ARG0]] : f32
+    %0 = fptrunc %arg0 : f64 to f32
+    return %0 : f32
+  }
+}
+
+}
@@ -0,0 +1,83 @@
+// RUN: iree-opt -split-input-file -pass-pipeline='test-iree-convert-std-to-vm' -iree-vm-target-extensions=f64 %s | IreeFileCheck %s
+
+// -----
+// CHECK-LABEL: @t001_sitofp
+module @t001_sitofp {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: i32) -> (f64) {
+    // CHECK: vm.cast.si32.f64 %[[ARG0]] : i32 -> f64
+    %0 = sitofp %arg0 : i32 to f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t002_fptosi
+module @t002_fptosi {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64) -> (i32) {
+    // CHECK: vm.cast.f64.si32 %[[ARG0]] : f64 -> i32
+    %0 = fptosi %arg0 : f64 to i32
+    return %0 : i32
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t003_select
+module @t003_select {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[COND:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  // CHECK-SAME: %[[ARG1:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%cond: i1, %arg0: f64, %arg1: f64) -> (f64) {
+    // CHECK: vm.select.f64 %[[COND]], %[[ARG0]], %[[ARG1]] : f64
+    %0 = select %cond, %arg0, %arg1 : f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t004_fpext
+module @t004_fpext {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f32) -> (f64) {
+    // CHECK: vm.ext.f32.f64 %[[ARG0]] : f32 -> f64
+    %0 = fpext %arg0 : f32 to f64
+    return %0 : f64
+  }
+}
+
+}
+
+// -----
+// CHECK-LABEL: @t005_fptrunc
+module @t005_fptrunc {
+
+module {
+  // CHECK: func @my_fn
+  // CHECK-SAME: %[[ARG0:[a-zA-Z0-9$._-]+]]
+  func @my_fn(%arg0: f64) -> (f32) {
+    // CHECK: vm.trunc.f64.f32 %[[ARG0]] : f64 -> f32
+    %0 = fptrunc %arg0 : f64 to f32
+    return %0 : f32
+  }
+}
+
+}
@@ -26,6 +26,10 @@ namespace VM {
 enum class OpcodeExtension {
   // Adds ops for manipulating i64 types.
   kI64,
+  // Adds ops for manipulating f32 types.
+  kF32,
+  // Adds ops for manipulating f64 types.
+  kF64,
 };
 
 // Controls VM translation targets.
@@ -39,6 +43,16 @@ struct TargetOptions {
   // Whether to truncate i64 types to i32 when the i64 extension is not
   // enabled.
   bool truncateUnsupportedIntegers = true;
+
+  // Whether the f32 extension is enabled in the target VM.
+  bool f32Extension = false;
+
+  // Whether the f64 extension is enabled in the target VM.
+  bool f64Extension = false;
+
+  // Whether to truncate f64 types to f32 when the f64 extension is not
+  // enabled and the f32 extension is.
+  bool truncateUnsupportedFloats = true;
 };
 
 // Returns a TargetOptions struct initialized with the
@@ -111,7 +111,7 @@ class ConstZeroOpConversion : public OpRewritePattern<ConstZeroOpTy> {
   LogicalResult matchAndRewrite(ConstZeroOpTy constZeroOp,
                                 PatternRewriter &rewriter) const final {
     auto type = constZeroOp.getType();
-    IntegerAttr value = rewriter.getIntegerAttr(type, 0);
+    Attribute value = rewriter.getZeroAttr(type);
 
     rewriter.replaceOpWithNewOp<emitc::ConstOp>(constZeroOp, type, value);
     return success();
@@ -280,6 +280,14 @@ void populateVMToCPatterns(MLIRContext *context,
   patterns.insert<CallOpConversion<IREE::VM::CmpNZI32Op>>(context,
                                                           "vm_cmp_nz_i32");
 
+  // ExtI64: Globals
+  patterns.insert<
+      GlobalLoadOpConversion<IREE::VM::GlobalLoadI64Op, IREE::VM::GlobalI64Op>>(
+      context, "vm_global_load_i64");
+  patterns.insert<GlobalStoreOpConversion<IREE::VM::GlobalStoreI64Op,
+                                          IREE::VM::GlobalI64Op>>(
+      context, "vm_global_store_i64");
+
   // ExtI64: Constants
   patterns.insert<ConstOpConversion<IREE::VM::ConstI64Op>>(context);
   patterns.insert<ConstZeroOpConversion<IREE::VM::ConstI64ZeroOp>>(context);
@@ -330,6 +338,96 @@ void populateVMToCPatterns(MLIRContext *context,
                                                            "vm_cmp_lt_i64u");
   patterns.insert<CallOpConversion<IREE::VM::CmpNZI64Op>>(context,
                                                           "vm_cmp_nz_i64");
+
+  // ExtF32: Constants
+  patterns.insert<ConstOpConversion<IREE::VM::ConstF32Op>>(context);
+  patterns.insert<ConstZeroOpConversion<IREE::VM::ConstF32ZeroOp>>(context);
+
+  // ExtF32: Conditional assignment ops
+  patterns.insert<CallOpConversion<IREE::VM::SelectF32Op>>(context,
+                                                           "vm_select_f32");
+
+  // ExtF32: Native floating-point arithmetic ops
+  patterns.insert<CallOpConversion<IREE::VM::AddF32Op>>(context, "vm_add_f32");
+  patterns.insert<CallOpConversion<IREE::VM::SubF32Op>>(context, "vm_sub_f32");
+  patterns.insert<CallOpConversion<IREE::VM::MulF32Op>>(context, "vm_mul_f32");
+  patterns.insert<CallOpConversion<IREE::VM::DivF32Op>>(context, "vm_div_f32");
+  patterns.insert<CallOpConversion<IREE::VM::RemF32Op>>(context, "vm_rem_f32");
+  patterns.insert<CallOpConversion<IREE::VM::AbsF32Op>>(context, "vm_abs_f32");
+  patterns.insert<CallOpConversion<IREE::VM::NegF32Op>>(context, "vm_neg_f32");
+  patterns.insert<CallOpConversion<IREE::VM::CeilF32Op>>(context,
+                                                         "vm_ceil_f32");
+  patterns.insert<CallOpConversion<IREE::VM::FloorF32Op>>(context,
+                                                          "vm_floor_f32");
+
+  // ExtF32: Casting and type conversion/emulation ops
+  patterns.insert<CallOpConversion<IREE::VM::CastSI32F32Op>>(context,
+                                                             "vm_cast_si32f32");
+  patterns.insert<CallOpConversion<IREE::VM::CastUI32F32Op>>(context,
+                                                             "vm_cast_ui32f32");
+  patterns.insert<CallOpConversion<IREE::VM::CastF32SI32Op>>(context,
+                                                             "vm_cast_f32si32");
+  patterns.insert<CallOpConversion<IREE::VM::CastF32UI32Op>>(context,
+                                                             "vm_cast_f32ui32");
+
+  // ExtF32: Comparison ops
+  patterns.insert<CallOpConversion<IREE::VM::CmpEQF32OOp>>(context,
+                                                           "vm_cmp_eq_f32o");
+  patterns.insert<CallOpConversion<IREE::VM::CmpNEF32OOp>>(context,
+                                                           "vm_cmp_ne_f32o");
+  patterns.insert<CallOpConversion<IREE::VM::CmpLTF32OOp>>(context,
+                                                           "vm_cmp_lt_f32o");
+  patterns.insert<CallOpConversion<IREE::VM::CmpLTEF32OOp>>(context,
+                                                            "vm_cmp_lte_f32o");
+  patterns.insert<CallOpConversion<IREE::VM::CmpNZF32Op>>(context,
+                                                          "vm_cmp_nz_f32");
+
+  // ExtF64: Constants
+  patterns.insert<ConstOpConversion<IREE::VM::ConstF64Op>>(context);
+  patterns.insert<ConstZeroOpConversion<IREE::VM::ConstF64ZeroOp>>(context);
+
+  // ExtF64: Conditional assignment ops
+  patterns.insert<CallOpConversion<IREE::VM::SelectF64Op>>(context,
+                                                           "vm_select_f64");
+
+  // ExtF64: Native floating-point arithmetic ops
+  patterns.insert<CallOpConversion<IREE::VM::AddF64Op>>(context, "vm_add_f64");
+  patterns.insert<CallOpConversion<IREE::VM::SubF64Op>>(context, "vm_sub_f64");
+  patterns.insert<CallOpConversion<IREE::VM::MulF64Op>>(context, "vm_mul_f64");
+  patterns.insert<CallOpConversion<IREE::VM::DivF64Op>>(context, "vm_div_f64");
+  patterns.insert<CallOpConversion<IREE::VM::RemF64Op>>(context, "vm_rem_f64");
+  patterns.insert<CallOpConversion<IREE::VM::AbsF64Op>>(context, "vm_abs_f64");
+  patterns.insert<CallOpConversion<IREE::VM::NegF64Op>>(context, "vm_neg_f64");
+  patterns.insert<CallOpConversion<IREE::VM::CeilF64Op>>(context,
+                                                         "vm_ceil_f64");
+  patterns.insert<CallOpConversion<IREE::VM::FloorF64Op>>(context,
+                                                          "vm_floor_f64");
+
+  // ExtF64: Casting and type conversion/emulation ops
+  patterns.insert<CallOpConversion<IREE::VM::CastSI32F64Op>>(context,
+                                                             "vm_cast_si32f64");
+  patterns.insert<CallOpConversion<IREE::VM::CastUI32F64Op>>(context,
+                                                             "vm_cast_ui32f64");
+  patterns.insert<CallOpConversion<IREE::VM::CastF64SI32Op>>(context,
+                                                             "vm_cast_f64si32");
+  patterns.insert<CallOpConversion<IREE::VM::CastF64UI32Op>>(context,
+                                                             "vm_cast_f64ui32");
+  patterns.insert<CallOpConversion<IREE::VM::TruncF64F32Op>>(context,
+                                                             "vm_trunc_f64f32");
+  patterns.insert<CallOpConversion<IREE::VM::ExtF32F64Op>>(context,
+                                                           "vm_ext_f32f64");
+
+  // ExtF64: Comparison ops
+  patterns.insert<CallOpConversion<IREE::VM::CmpEQF64OOp>>(context,
+                                                           "vm_cmp_eq_f64o");
+  patterns.insert<CallOpConversion<IREE::VM::CmpNEF64OOp>>(context,
+                                                           "vm_cmp_ne_f64o");
+  patterns.insert<CallOpConversion<IREE::VM::CmpLTF64OOp>>(context,
+                                                           "vm_cmp_lt_f64o");
+  patterns.insert<CallOpConversion<IREE::VM::CmpLTEF64OOp>>(context,
+                                                            "vm_cmp_lte_f64o");
+  patterns.insert<CallOpConversion<IREE::VM::CmpNZF64Op>>(context,
+                                                          "vm_cmp_nz_f64");
 }
 
 namespace IREE {
@@ -360,7 +458,9 @@ class ConvertVMToEmitCPass
     target.addLegalOp<IREE::VM::ModuleTerminatorOp>();
     target.addLegalOp<IREE::VM::FuncOp>();
     target.addLegalOp<IREE::VM::GlobalI32Op>();
+    target.addLegalOp<IREE::VM::GlobalI64Op>();
     target.addLegalOp<IREE::VM::ExportOp>();
+    target.addLegalOp<IREE::VM::ImportOp>();
 
     // Control flow ops
     target.addLegalOp<IREE::VM::BranchOp>();
@@ -16,6 +16,7 @@
 
 #include "iree/compiler/Dialect/VM/IR/VMDialect.h"
 #include "iree/compiler/Dialect/VM/IR/VMOps.h"
+#include "llvm/ADT/APSInt.h"
 #include "llvm/ADT/StringExtras.h"
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/Builders.h"
@@ -316,6 +317,40 @@ void ConstI64Op::getCanonicalizationPatterns(OwningRewritePatternList &results,
   results.insert<FoldZeroConstInteger<ConstI64Op, ConstI64ZeroOp>>(context);
 }
 
+namespace {
+
+template <typename GeneralOp, typename ZeroOp>
+struct FoldZeroConstFloat final : public OpRewritePattern<GeneralOp> {
+  using OpRewritePattern<GeneralOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(GeneralOp constOp,
+                                PatternRewriter &rewriter) const override {
+    // Only +0.0 can be replaced as the zero ops have no sign.
+    auto floatAttr = constOp.value().template dyn_cast<FloatAttr>();
+    if (floatAttr && floatAttr.getValue().isPosZero()) {
+      rewriter.replaceOpWithNewOp<ZeroOp>(constOp);
+      return success();
+    }
+    return failure();
+  }
+};
+
+}  // namespace
+
+OpFoldResult ConstF32Op::fold(ArrayRef<Attribute> operands) { return value(); }
+
+void ConstF32Op::getCanonicalizationPatterns(OwningRewritePatternList &results,
+                                             MLIRContext *context) {
+  results.insert<FoldZeroConstFloat<ConstF32Op, ConstF32ZeroOp>>(context);
+}
+
+OpFoldResult ConstF64Op::fold(ArrayRef<Attribute> operands) { return value(); }
+
+void ConstF64Op::getCanonicalizationPatterns(OwningRewritePatternList &results,
+                                             MLIRContext *context) {
+  results.insert<FoldZeroConstFloat<ConstF64Op, ConstF64ZeroOp>>(context);
+}
+
 OpFoldResult ConstI32ZeroOp::fold(ArrayRef<Attribute> operands) {
   return IntegerAttr::get(getResult().getType(), 0);
 }
@@ -324,6 +359,14 @@ OpFoldResult ConstI64ZeroOp::fold(ArrayRef<Attribute> operands) {
   return IntegerAttr::get(getResult().getType(), 0);
 }
 
+OpFoldResult ConstF32ZeroOp::fold(ArrayRef<Attribute> operands) {
+  return FloatAttr::get(getResult().getType(), 0.0);
+}
+
+OpFoldResult ConstF64ZeroOp::fold(ArrayRef<Attribute> operands) {
+  return FloatAttr::get(getResult().getType(), 0.0);
+}
+
 OpFoldResult ConstRefZeroOp::fold(ArrayRef<Attribute> operands) {
   // TODO(b/144027097): relace unit attr with a proper null ref attr.
   return UnitAttr::get(getContext());
@@ -360,6 +403,14 @@ OpFoldResult SelectI64Op::fold(ArrayRef<Attribute> operands) {
   return foldSelectOp(*this);
 }
 
+OpFoldResult SelectF32Op::fold(ArrayRef<Attribute> operands) {
+  return foldSelectOp(*this);
+}
+
+OpFoldResult SelectF64Op::fold(ArrayRef<Attribute> operands) {
+  return foldSelectOp(*this);
+}
+
 OpFoldResult SelectRefOp::fold(ArrayRef<Attribute> operands) {
   return foldSelectOp(*this);
 }
@@ -748,6 +799,155 @@ OpFoldResult XorI64Op::fold(ArrayRef<Attribute> operands) {
   return foldXorOp(*this, operands);
 }
 
+//===----------------------------------------------------------------------===//
+// Native floating-point arithmetic
+//===----------------------------------------------------------------------===//
+// Folding here must preserve IEEE semantics: identities such as x + 0 = x or
+// x * 0 = 0 do not hold for -0.0, NaN, or infinities and are not applied.
+
+/// Returns true if |value| is a constant exactly equal to |expected|.
+/// Note that this is a bitwise comparison such that -0.0 != +0.0.
+static bool isConstantFloatValue(Value value, double expected) {
+  Attribute attr;
+  if (!matchPattern(value, m_Constant(&attr))) return false;
+  auto floatAttr = attr.dyn_cast<FloatAttr>();
+  return floatAttr && floatAttr.getValue().isExactlyValue(expected);
+}
+
+OpFoldResult AddF32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldBinaryOp<FloatAttr>(
+      operands, [](const APFloat &a, const APFloat &b) { return a + b; });
+}
+
+OpFoldResult AddF64Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldBinaryOp<FloatAttr>(
+      operands, [](const APFloat &a, const APFloat &b) { return a + b; });
+}
+
+template <typename T>
+static OpFoldResult foldSubFloatOp(T op, ArrayRef<Attribute> operands) {
+  if (isConstantFloatValue(op.rhs(), 0.0)) {
+    // x - 0 = x
+    return op.lhs();
+  }
+  return constFoldBinaryOp<FloatAttr>(
+      operands, [](const APFloat &a, const APFloat &b) { return a - b; });
+}
+
+OpFoldResult SubF32Op::fold(ArrayRef<Attribute> operands) {
+  return foldSubFloatOp(*this, operands);
+}
+
+OpFoldResult SubF64Op::fold(ArrayRef<Attribute> operands) {
+  return foldSubFloatOp(*this, operands);
+}
+
+template <typename T>
+static OpFoldResult foldMulFloatOp(T op, ArrayRef<Attribute> operands) {
+  if (isConstantFloatValue(op.rhs(), 1.0)) {
+    // x * 1 = x or 1 * y = y (commutative)
+    return op.lhs();
+  }
+  return constFoldBinaryOp<FloatAttr>(
+      operands, [](const APFloat &a, const APFloat &b) { return a * b; });
+}
+
+OpFoldResult MulF32Op::fold(ArrayRef<Attribute> operands) {
+  return foldMulFloatOp(*this, operands);
+}
+
+OpFoldResult MulF64Op::fold(ArrayRef<Attribute> operands) {
+  return foldMulFloatOp(*this, operands);
+}
+
+template <typename T>
+static OpFoldResult foldDivFloatOp(T op, ArrayRef<Attribute> operands) {
+  if (isConstantFloatValue(op.rhs(), 1.0)) {
+    // x / 1 = x
+    return op.lhs();
+  }
+  return constFoldBinaryOp<FloatAttr>(
+      operands, [](const APFloat &a, const APFloat &b) { return a / b; });
+}
+
+OpFoldResult DivF32Op::fold(ArrayRef<Attribute> operands) {
+  return foldDivFloatOp(*this, operands);
+}
+
+OpFoldResult DivF64Op::fold(ArrayRef<Attribute> operands) {
+  return foldDivFloatOp(*this, operands);
+}
+
+template <typename T>
+static OpFoldResult foldRemFloatOp(T op, ArrayRef<Attribute> operands) {
+  return constFoldBinaryOp<FloatAttr>(
+      operands, [](const APFloat &a, const APFloat &b) {
+        // fmod semantics to match the runtime.
+        APFloat result = a;
+        result.mod(b);
+        return result;
+      });
+}
+
+OpFoldResult RemF32Op::fold(ArrayRef<Attribute> operands) {
+  return foldRemFloatOp(*this, operands);
+}
+
+OpFoldResult RemF64Op::fold(ArrayRef<Attribute> operands) {
+  return foldRemFloatOp(*this, operands);
+}
+
+OpFoldResult AbsF32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldUnaryOp<FloatAttr>(operands,
+                                     [](const APFloat &a) { return abs(a); });
+}
+
+OpFoldResult AbsF64Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldUnaryOp<FloatAttr>(operands,
+                                     [](const APFloat &a) { return abs(a); });
+}
+
+OpFoldResult NegF32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldUnaryOp<FloatAttr>(operands,
+                                     [](const APFloat &a) { return neg(a); });
+}
+
+OpFoldResult NegF64Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldUnaryOp<FloatAttr>(operands,
+                                     [](const APFloat &a) { return neg(a); });
+}
+
+/// Rounds |a| to an integral value in the given rounding |mode|.
+static APFloat roundToIntegral(const APFloat &a, APFloat::roundingMode mode) {
+  APFloat result = a;
+  result.roundToIntegral(mode);
+  return result;
+}
+
+OpFoldResult CeilF32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldUnaryOp<FloatAttr>(operands, [](const APFloat &a) {
+    return roundToIntegral(a, APFloat::rmTowardPositive);
+  });
+}
+
+OpFoldResult CeilF64Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldUnaryOp<FloatAttr>(operands, [](const APFloat &a) {
+    return roundToIntegral(a, APFloat::rmTowardPositive);
+  });
+}
+
+OpFoldResult FloorF32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldUnaryOp<FloatAttr>(operands, [](const APFloat &a) {
+    return roundToIntegral(a, APFloat::rmTowardNegative);
+  });
+}
+
+OpFoldResult FloorF64Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldUnaryOp<FloatAttr>(operands, [](const APFloat &a) {
+    return roundToIntegral(a, APFloat::rmTowardNegative);
+  });
+}
+
 //===----------------------------------------------------------------------===//
 // Native bitwise shifts and rotates
 //===----------------------------------------------------------------------===//
@@ -978,6 +1178,87 @@ void ExtI16I64UOp::getCanonicalizationPatterns(
       ExtI16I64UOp, ExtI16I32UOp, 32, ExtI32I64UOp>>(context);
 }
 
+/// Folds an integer to floating-point cast of a constant operand.
+static Attribute constFoldIntToFloatOp(Type resultType,
+                                       ArrayRef<Attribute> operands,
+                                       bool isSigned) {
+  auto operand = operands[0].dyn_cast_or_null<IntegerAttr>();
+  if (!operand) return {};
+  APFloat result(resultType.cast<FloatType>().getFloatSemantics());
+  result.convertFromAPInt(operand.getValue(), isSigned,
+                          APFloat::rmNearestTiesToEven);
+  return FloatAttr::get(resultType, result);
+}
+
+/// Folds a floating-point to 32-bit integer cast of a constant operand.
+/// APFloat saturates values that are not representable the same way the
+/// runtime does: NaN becomes 0 and out of range values clamp to the limits.
+static Attribute constFoldFloatToIntOp(Type resultType,
+                                       ArrayRef<Attribute> operands,
+                                       bool isSigned) {
+  auto operand = operands[0].dyn_cast_or_null<FloatAttr>();
+  if (!operand) return {};
+  APSInt result(32, /*isUnsigned=*/!isSigned);
+  bool isExact = false;
+  (void)operand.getValue().convertToInteger(result, APFloat::rmTowardZero,
+                                            &isExact);
+  return IntegerAttr::get(resultType, result);
+}
+
+OpFoldResult CastSI32F32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldIntToFloatOp(getType(), operands, /*isSigned=*/true);
+}
+
+OpFoldResult CastSI32F64Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldIntToFloatOp(getType(), operands, /*isSigned=*/true);
+}
+
+OpFoldResult CastUI32F32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldIntToFloatOp(getType(), operands, /*isSigned=*/false);
+}
+
+OpFoldResult CastUI32F64Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldIntToFloatOp(getType(), operands, /*isSigned=*/false);
+}
+
+OpFoldResult CastF32SI32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatToIntOp(getType(), operands, /*isSigned=*/true);
+}
+
+OpFoldResult CastF64SI32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatToIntOp(getType(), operands, /*isSigned=*/true);
+}
+
+OpFoldResult CastF32UI32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatToIntOp(getType(), operands, /*isSigned=*/false);
+}
+
+OpFoldResult CastF64UI32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatToIntOp(getType(), operands, /*isSigned=*/false);
+}
+
+OpFoldResult TruncF64F32Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldConversionOp<FloatAttr>(
+      getType(), operands, [&](const APFloat &a) {
+        APFloat result = a;
+        bool losesInfo = false;
+        result.convert(APFloat::IEEEsingle(), APFloat::rmNearestTiesToEven,
+                       &losesInfo);
+        return result;
+      });
+}
+
+OpFoldResult ExtF32F64Op::fold(ArrayRef<Attribute> operands) {
+  return constFoldConversionOp<FloatAttr>(
+      getType(), operands, [&](const APFloat &a) {
+        APFloat result = a;
+        bool losesInfo = false;
+        result.convert(APFloat::IEEEdouble(), APFloat::rmNearestTiesToEven,
+                       &losesInfo);
+        return result;
+      });
+}
+
 //===----------------------------------------------------------------------===//
 // Native reduction (horizontal) arithmetic
 //===----------------------------------------------------------------------===//
@@ -1388,6 +1669,144 @@ OpFoldResult CmpNZI64Op::fold(ArrayRef<Attribute> operands) {
       operands, [&](const APInt &a) { return APInt(64, a.getBoolValue()); });
 }
 
+/// Folds a floating-point comparison of two constant operands to an i32
+/// boolean result.
+static Attribute constFoldFloatCmpOp(
+    Type resultType, ArrayRef<Attribute> operands,
+    llvm::function_ref<bool(APFloat::cmpResult)> predicate) {
+  auto lhs = operands[0].dyn_cast_or_null<FloatAttr>();
+  auto rhs = operands[1].dyn_cast_or_null<FloatAttr>();
+  if (!lhs || !rhs) return {};
+  return IntegerAttr::get(resultType,
+                          predicate(lhs.getValue().compare(rhs.getValue())));
+}
+
+// NOTE: x == x does not fold to true as NaN != NaN.
+
+OpFoldResult CmpEQF32OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpEqual;
+  });
+}
+
+OpFoldResult CmpEQF64OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpEqual;
+  });
+}
+
+OpFoldResult CmpNEF32OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpLessThan || r == APFloat::cmpGreaterThan;
+  });
+}
+
+OpFoldResult CmpNEF64OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpLessThan || r == APFloat::cmpGreaterThan;
+  });
+}
+
+OpFoldResult CmpLTF32OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpLessThan;
+  });
+}
+
+OpFoldResult CmpLTF64OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpLessThan;
+  });
+}
+
+OpFoldResult CmpLTEF32OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpLessThan || r == APFloat::cmpEqual;
+  });
+}
+
+OpFoldResult CmpLTEF64OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpLessThan || r == APFloat::cmpEqual;
+  });
+}
+
+OpFoldResult CmpGTF32OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpGreaterThan;
+  });
+}
+
+OpFoldResult CmpGTF64OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpGreaterThan;
+  });
+}
+
+void CmpGTF32OOp::getCanonicalizationPatterns(OwningRewritePatternList &results,
+                                              MLIRContext *context) {
+  results.insert<RewritePseudoCmpGTToLT<CmpGTF32OOp, CmpLTF32OOp>>(context);
+}
+
+void CmpGTF64OOp::getCanonicalizationPatterns(OwningRewritePatternList &results,
+                                              MLIRContext *context) {
+  results.insert<RewritePseudoCmpGTToLT<CmpGTF64OOp, CmpLTF64OOp>>(context);
+}
+
+OpFoldResult CmpGTEF32OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpGreaterThan || r == APFloat::cmpEqual;
+  });
+}
+
+OpFoldResult CmpGTEF64OOp::fold(ArrayRef<Attribute> operands) {
+  return constFoldFloatCmpOp(getType(), operands, [](APFloat::cmpResult r) {
+    return r == APFloat::cmpGreaterThan || r == APFloat::cmpEqual;
+  });
+}
+
+namespace {
+
+/// Rewrites a vm.cmp.gte.*.o pseudo op to a vm.cmp.lte.*.o op.
+/// Unlike the integer variant this cannot use !(lhs < rhs) as the inverse of an
+/// ordered comparison is unordered.
+template <typename T, typename U>
+struct RewritePseudoCmpGTEToLTE : public OpRewritePattern<T> {
+  using OpRewritePattern<T>::OpRewritePattern;
+  LogicalResult matchAndRewrite(T op,
+                                PatternRewriter &rewriter) const override {
+    // rhs <= lhs
+    rewriter.replaceOpWithNewOp<U>(op, op.getType(), op.rhs(), op.lhs());
+    return success();
+  }
+};
+
+}  // namespace
+
+void CmpGTEF32OOp::getCanonicalizationPatterns(
+    OwningRewritePatternList &results, MLIRContext *context) {
+  results.insert<RewritePseudoCmpGTEToLTE<CmpGTEF32OOp, CmpLTEF32OOp>>(
+      context);
+}
+
+void CmpGTEF64OOp::getCanonicalizationPatterns(
+    OwningRewritePatternList &results, MLIRContext *context) {
+  results.insert<RewritePseudoCmpGTEToLTE<CmpGTEF64OOp, CmpLTEF64OOp>>(
+      context);
+}
+
+OpFoldResult CmpNZF32Op::fold(ArrayRef<Attribute> operands) {
+  auto operand = operands[0].dyn_cast_or_null<FloatAttr>();
+  if (!operand) return {};
+  return IntegerAttr::get(getType(), !operand.getValue().isZero());
+}
+
+OpFoldResult CmpNZF64Op::fold(ArrayRef<Attribute> operands) {
+  auto operand = operands[0].dyn_cast_or_null<FloatAttr>();
+  if (!operand) return {};
+  return IntegerAttr::get(getType(), !operand.getValue().isZero());
+}
+
 OpFoldResult CmpEQRefOp::fold(ArrayRef<Attribute> operands) {
   if (lhs() == rhs()) {
     // x == x = true
@@ -1768,7 +2187,7 @@ namespace {
 
 /// Rewrites a check op to a cmp and a cond_fail.
 template <typename CheckOp, typename CmpI32Op, typename CmpI64Op,
-          typename CmpRefOp>
+          typename CmpF32Op, typename CmpF64Op, typename CmpRefOp>
 struct RewriteCheckToCondFail : public OpRewritePattern<CheckOp> {
   using OpRewritePattern<CheckOp>::OpRewritePattern;
   LogicalResult matchAndRewrite(CheckOp op,
@@ -1788,6 +2207,14 @@ struct RewriteCheckToCondFail : public OpRewritePattern<CheckOp> {
       condValue = rewriter.template createOrFold<CmpI32Op>(
           op.getLoc(), ArrayRef<Type>{condType},
           op.getOperation()->getOperands());
+    } else if (operandType.isF32()) {
+      condValue = rewriter.template createOrFold<CmpF32Op>(
+          op.getLoc(), ArrayRef<Type>{condType},
+          op.getOperation()->getOperands());
+    } else if (operandType.isF64()) {
+      condValue = rewriter.template createOrFold<CmpF64Op>(
+          op.getLoc(), ArrayRef<Type>{condType},
+          op.getOperation()->getOperands());
     } else {
       return failure();
     }
@@ -1806,22 +2233,22 @@ struct RewriteCheckToCondFail : public OpRewritePattern<CheckOp> {
 
 void CheckEQOp::getCanonicalizationPatterns(OwningRewritePatternList &results,
                                             MLIRContext *context) {
-  results.insert<
-      RewriteCheckToCondFail<CheckEQOp, CmpEQI32Op, CmpEQI64Op, CmpEQRefOp>>(
+  results.insert<RewriteCheckToCondFail<CheckEQOp, CmpEQI32Op, CmpEQI64Op,
+                                        CmpEQF32OOp, CmpEQF64OOp, CmpEQRefOp>>(
       context);
 }
 
 void CheckNEOp::getCanonicalizationPatterns(OwningRewritePatternList &results,
                                             MLIRContext *context) {
-  results.insert<
-      RewriteCheckToCondFail<CheckNEOp, CmpNEI32Op, CmpNEI64Op, CmpNERefOp>>(
+  results.insert<RewriteCheckToCondFail<CheckNEOp, CmpNEI32Op, CmpNEI64Op,
+                                        CmpNEF32OOp, CmpNEF64OOp, CmpNERefOp>>(
       context);
 }
 
 void CheckNZOp::getCanonicalizationPatterns(OwningRewritePatternList &results,
                                             MLIRContext *context) {
-  results.insert<
-      RewriteCheckToCondFail<CheckNZOp, CmpNZI32Op, CmpNZI64Op, CmpNZRefOp>>(
+  results.insert<RewriteCheckToCondFail<CheckNZOp, CmpNZI32Op, CmpNZI64Op,
+                                        CmpNZF32Op, CmpNZF64Op, CmpNZRefOp>>(
       context);
 }
 
@@ -422,3 +422,40 @@ vm.module @shr_i32_u_folds {
     vm.return %0 : i32
   }
 }
+
+// -----
+
+// CHECK-LABEL: @add_f32_folds
+vm.module @add_f32_folds {
+  // CHECK-LABEL: @add_f32_const
+  vm.func @add_f32_const() -> f32 {
+    // CHECK: %[[C:.+]] = vm.const.f32 3.750000e+00 : f32
+    // CHECK-NEXT: vm.return %[[C]] : f32
+    %c1 = vm.const.f32 1.5 : f32
+    %c2 = vm.const.f32 2.25 : f32
+    %0 = vm.add.f32 %c1, %c2 : f32
+    vm.return %0 : f32
+  }
+
+  // Adding +0.0 changes -0.0 to +0.0 and must not fold away.
+  // CHECK-LABEL: @add_f32_x_0
+  vm.func @add_f32_x_0(%arg0 : f32) -> f32 {
+    // CHECK: vm.add.f32
+    %zero = vm.const.f32.zero : f32
+    %0 = vm.add.f32 %arg0, %zero : f32
+    vm.return %0 : f32
+  }
+}
+
+// -----
+
+// CHECK-LABEL: @mul_f64_folds
+vm.module @mul_f64_folds {
+  // CHECK-LABEL: @mul_f64_x_1
+  vm.func @mul_f64_x_1(%arg0 : f64) -> f64 {
+    // CHECK: vm.return %arg0 : f64
+    %c1 = vm.const.f64 1.0 : f64
+    %0 = vm.mul.f64 %arg0, %c1 : f64
+    vm.return %0 : f64
+  }
+}
@@ -120,3 +120,36 @@ vm.module @my_module {
     vm.return %0 : i32
   }
 }
+
+// -----
+
+// CHECK-LABEL: @add_f32
+vm.module @my_module {
+  vm.func @add_f32(%arg0 : f32, %arg1 : f32) -> f32 {
+    // CHECK: %0 = vm.add.f32 %arg0, %arg1 : f32
+    %0 = vm.add.f32 %arg0, %arg1 : f32
+    vm.return %0 : f32
+  }
+}
+
+// -----
+
+// CHECK-LABEL: @rem_f64
+vm.module @my_module {
+  vm.func @rem_f64(%arg0 : f64, %arg1 : f64) -> f64 {
+    // CHECK: %0 = vm.rem.f64 %arg0, %arg1 : f64
+    %0 = vm.rem.f64 %arg0, %arg1 : f64
+    vm.return %0 : f64
+  }
+}
+
+// -----
+
+// CHECK-LABEL: @floor_f32
+vm.module @my_module {
+  vm.func @floor_f32(%arg0 : f32) -> f32 {
+    // CHECK: %0 = vm.floor.f32 %arg0 : f32
+    %0 = vm.floor.f32 %arg0 : f32
+    vm.return %0 : f32
+  }
+}
@@ -450,3 +450,27 @@ vm.module @cmp_nz_ref_folds {
     vm.return %ne : i32
   }
 }
+
+// -----
+
+// CHECK-LABEL: @cmp_gt_f32_folds
+vm.module @cmp_gt_f32_folds {
+  // CHECK-LABEL: @swap_lt
+  vm.func @swap_lt(%arg0 : f32, %arg1 : f32) -> i32 {
+    // CHECK: %[[R:.+]] = vm.cmp.lt.f32.o %arg1, %arg0 : f32
+    // CHECK-NEXT: vm.return %[[R]] : i32
+    %0 = vm.cmp.gt.f32.o %arg0, %arg1 : f32
+    vm.return %0 : i32
+  }
+
+  // Ordered comparisons against NaN are always false.
+  // CHECK-LABEL: @const_nan
+  vm.func @const_nan() -> i32 {
+    // CHECK: %zero = vm.const.i32.zero : i32
+    // CHECK-NEXT: vm.return %zero : i32
+    %nan = vm.const.f32 0x7FC00000 : f32
+    %c1 = vm.const.f32 1.0 : f32
+    %0 = vm.cmp.gt.f32.o %nan, %c1 : f32
+    vm.return %0 : i32
+  }
+}
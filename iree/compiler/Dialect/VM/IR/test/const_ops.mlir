@@ -55,3 +55,36 @@ vm.module @my_module {
     vm.return %0 : !vm.ref<!iree.byte_buffer>
   }
 }
+
+// -----
+
+vm.module @my_module {
+  // CHECK-LABEL: @const_f32_zero
+  vm.func @const_f32_zero() -> f32 {
+    // CHECK: %zero = vm.const.f32.zero : f32
+    %zero = vm.const.f32.zero : f32
+    vm.return %zero : f32
+  }
+}
+
+// -----
+
+vm.module @my_module {
+  // CHECK-LABEL: @const_f32
+  vm.func @const_f32() -> f32 {
+    // CHECK: = vm.const.f32 1.500000e+00 : f32
+    %c = vm.const.f32 1.5 : f32
+    vm.return %c : f32
+  }
+}
+
+// -----
+
+vm.module @my_module {
+  // CHECK-LABEL: @const_f64
+  vm.func @const_f64() -> f64 {
+    // CHECK: = vm.const.f64 -2.500000e-01 : f64
+    %c = vm.const.f64 -0.25 : f64
+    vm.return %c : f64
+  }
+}
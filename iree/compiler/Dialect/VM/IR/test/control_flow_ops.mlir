@@ -224,3 +224,26 @@ vm.module @my_module {
     vm.return
   }
 }
+
+// -----
+
+// CHECK-LABEL: @discard_refs
+vm.module @my_module {
+  vm.func @discard_refs(%arg0 : !vm.ref<?>, %arg1 : !vm.list<i32>) {
+    // CHECK: vm.discard.refs %arg0, %arg1 : !vm.ref<?>, !vm.list<i32>
+    vm.discard.refs %arg0, %arg1 : !vm.ref<?>, !vm.list<i32>
+    vm.return
+  }
+}
+
+// -----
+
+// CHECK-LABEL: @cond_br_cmp
+vm.module @my_module {
+  vm.func @cond_br_cmp(%arg0 : i32, %arg1 : i32) -> i32 {
+    // CHECK: vm.cond_br.cmp.lt.i32.s %arg0, %arg1, ^bb1(%arg0 : i32), ^bb1(%arg1 : i32)
+    vm.cond_br.cmp.lt.i32.s %arg0, %arg1, ^bb1(%arg0 : i32), ^bb1(%arg1 : i32)
+  ^bb1(%0 : i32):
+    vm.return %0 : i32
+  }
+}
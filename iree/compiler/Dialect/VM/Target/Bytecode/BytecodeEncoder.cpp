@@ -14,6 +14,8 @@
 
 #include "iree/compiler/Dialect/VM/Target/Bytecode/BytecodeEncoder.h"
 
+#include <algorithm>
+
 #include "iree/compiler/Dialect/IREE/IR/IREETypes.h"
 #include "iree/compiler/Dialect/VM/Analysis/RegisterAllocation.h"
 #include "iree/compiler/Dialect/VM/IR/VMDialect.h"
@@ -115,6 +117,22 @@ class V0BytecodeEncoder : public BytecodeEncoder {
     }
   }
 
+  LogicalResult encodeFloatAttr(FloatAttr value) override {
+    auto attr = value.cast<FloatAttr>();
+    unsigned int bitWidth = attr.getType().getIntOrFloatBitWidth();
+    uint64_t limitedValue =
+        attr.getValue().bitcastToAPInt().extractBitsAsZExtValue(bitWidth, 0);
+    switch (bitWidth) {
+      case 32:
+        return writeUint32(static_cast<uint32_t>(limitedValue));
+      case 64:
+        return writeUint64(static_cast<uint64_t>(limitedValue));
+      default:
+        return currentOp_->emitOpError()
+               << "attribute of bitwidth " << bitWidth << " not supported";
+    }
+  }
+
   LogicalResult encodeIntArrayAttr(DenseIntElementsAttr value) override {
     if (value.getNumElements() > UINT16_MAX ||
         failed(writeUint16(value.getNumElements()))) {
@@ -155,6 +173,17 @@ class V0BytecodeEncoder : public BytecodeEncoder {
     // this list is small :)
     auto srcDstRegs = registerAllocation_->remapSuccessorRegisters(
         currentOp_, successorIndex);
+
+    // The runtime expects all i32 remappings to precede the ref remappings so
+    // that it can process each bank without checking the register type. The
+    // banks are disjoint and the relative order within each is preserved so
+    // this does not introduce any swapping hazards.
+    std::stable_partition(
+        srcDstRegs.begin(), srcDstRegs.end(),
+        [](const std::pair<Register, Register> &srcDstReg) {
+          return !srcDstReg.first.isRef();
+        });
+
     (void)writeUint16(srcDstRegs.size());
     for (auto srcDstReg : srcDstRegs) {
       if (failed(writeUint16(srcDstReg.first.encode())) ||
@@ -175,11 +204,22 @@ class V0BytecodeEncoder : public BytecodeEncoder {
 
   LogicalResult encodeOperands(Operation::operand_range values) override {
     (void)writeUint16(std::distance(values.begin(), values.end()));
+    if (isInternalCall(currentOp_)) {
+      // Internal call arguments are assigned to callee registers in order per
+      // bank and the runtime expects all i32 registers to precede all ref
+      // registers so that it can marshal each bank in its own loop.
+      for (bool refs : {false, true}) {
+        for (auto it : llvm::enumerate(values)) {
+          if (it.value().getType().isa<IREE::VM::RefType>() != refs) continue;
+          if (failed(encodeOperand(it.value(), it.index()))) {
+            return failure();
+          }
+        }
+      }
+      return success();
+    }
     for (auto it : llvm::enumerate(values)) {
-      uint16_t reg = registerAllocation_
-                         ->mapUseToRegister(it.value(), currentOp_, it.index())
-                         .encode();
-      if (failed(writeUint16(reg))) {
+      if (failed(encodeOperand(it.value(), it.index()))) {
         return failure();
       }
     }
@@ -211,6 +251,15 @@ class V0BytecodeEncoder : public BytecodeEncoder {
   }
 
  private:
+  // Returns true if |op| is a call to a function defined within the module.
+  // Imports marshal their arguments positionally and must not be reordered.
+  static bool isInternalCall(Operation *op) {
+    auto callOp = dyn_cast<IREE::VM::CallOp>(op);
+    if (!callOp) return false;
+    return isa_and_nonnull<IREE::VM::FuncOp>(
+        SymbolTable::lookupNearestSymbolFrom(op, callOp.calleeAttr()));
+  }
+
   // TODO(benvanik): replace this with something not using an ever-expanding
   // vector. I'm sure LLVM has something.
 
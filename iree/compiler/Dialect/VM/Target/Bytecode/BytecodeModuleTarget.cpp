@@ -150,6 +150,15 @@ static LogicalResult canonicalizeModule(BytecodeTargetOptions targetOptions,
 
   modulePasses.addPass(createDropCompilerHintsPass());
 
+  // Fuse common op sequences into bytecode-only superinstructions. This runs
+  // after all other transformations as the fused ops are opaque to them.
+  modulePasses.addPass(IREE::VM::createFormSuperinstructionsPass());
+
+  // Release refs at their last use so that resources are returned as early as
+  // possible. This must run after all other transformations as it depends on
+  // the final value liveness.
+  modulePasses.addPass(IREE::VM::createDiscardRefsPass());
+
   // Mark up the module with ordinals for each top-level op (func, etc).
   // This will make it easier to correlate the MLIR textual output to the
   // binary output.
@@ -348,10 +357,14 @@ static LogicalResult buildFlatBufferModule(BytecodeTargetOptions targetOptions,
     if (!encodedFunction) {
       return funcOp.value().emitError() << "failed to encode function bytecode";
     }
+    uint16_t functionFlags = 0;
+    if (funcOp.value()->hasAttr("vm.no_live_refs_at_return")) {
+      functionFlags |= iree_vm_FunctionFlags_NoLiveRefsAtReturn;
+    }
     iree_vm_FunctionDescriptor_assign(
         &functionDescriptors[funcOp.index()], totalBytecodeLength,
         encodedFunction->bytecodeData.size(), encodedFunction->i32RegisterCount,
-        encodedFunction->refRegisterCount);
+        encodedFunction->refRegisterCount, functionFlags);
     totalBytecodeLength += encodedFunction->bytecodeData.size();
     bytecodeDataParts[funcOp.index()] =
         std::move(encodedFunction->bytecodeData);
@@ -474,6 +487,8 @@ static LogicalResult buildFlatBufferModule(BytecodeTargetOptions targetOptions,
   iree_vm_BytecodeModuleDef_function_descriptors_add(fbb,
                                                      functionDescriptorsRef);
   iree_vm_BytecodeModuleDef_bytecode_data_add(fbb, bytecodeDataRef);
+  // Must match IREE_VM_BYTECODE_MODULE_LATEST_VERSION in the runtime.
+  iree_vm_BytecodeModuleDef_version_add(fbb, iree_vm_BytecodeVersion_V2);
   iree_vm_BytecodeModuleDef_end_as_root(fbb);
   return success();
 }
@@ -21,6 +21,7 @@ vm.module @simple_module {
   // CHECK-NEXT:   "bytecode_length": 5
   // CHECK-NEXT:   "i32_register_count": 1
   // CHECK-NEXT:   "ref_register_count": 0
+  // CHECK-NEXT:   "flags":
   // CHECK-NEXT: }
   //      CHECK: "bytecode_data": [
   // CHECK-NEXT:   84,
@@ -29,4 +30,5 @@ vm.module @simple_module {
   // CHECK-NEXT:   0,
   // CHECK-NEXT:   0
   // CHECK-NEXT: ]
+  //      CHECK: "version": 2
 }
@@ -14,12 +14,14 @@
 
 #include "iree/compiler/Dialect/VM/Target/C/CModuleTarget.h"
 
+#include "emitc/Dialect/EmitC/EmitCDialect.h"
 #include "emitc/Target/Cpp.h"
 #include "iree/compiler/Dialect/IREE/IR/IREEOps.h"
 #include "iree/compiler/Dialect/IREE/Transforms/Passes.h"
 #include "iree/compiler/Dialect/VM/Conversion/VMToEmitC/ConvertVMToEmitC.h"
 #include "iree/compiler/Dialect/VM/Target/CallingConventionUtils.h"
 #include "iree/compiler/Dialect/VM/Transforms/Passes.h"
+#include "llvm/ADT/SmallSet.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/Passes.h"
 
@@ -69,6 +71,8 @@ static LogicalResult printStructDefinitions(IREE::VM::ModuleOp &moduleOp,
          << moduleOp.ordinal_counts().getValue().global_bytes() << "];\n";
   output << "iree_vm_ref_t refs["
          << moduleOp.ordinal_counts().getValue().global_refs() << "];\n";
+  output << "iree_vm_function_t imports["
+         << moduleOp.ordinal_counts().getValue().import_funcs() << "];\n";
   output << "};\n";
 
   output << "typedef struct " << moduleName << "_s " << moduleName << "_t;\n";
@@ -80,16 +84,6 @@ static LogicalResult printStructDefinitions(IREE::VM::ModuleOp &moduleOp,
   return success();
 }
 
-static LogicalResult printShim(IREE::VM::FuncOp &funcOp,
-                               llvm::raw_ostream &output) {
-  auto callingConvention = makeCallingConventionString(funcOp);
-  if (!callingConvention) {
-    return funcOp.emitError("Couldn't create calling convention string");
-  }
-  output << "call_" << callingConvention.getValue() << "_shim";
-  return success();
-}
-
 static LogicalResult printFuncOpArguments(IREE::VM::FuncOp &funcOp,
                                           mlir::emitc::CppEmitter &emitter) {
   return mlir::emitc::interleaveCommaWithError(
@@ -142,7 +136,29 @@ static LogicalResult initializeGlobals(IREE::VM::ModuleOp moduleOp,
     }
   }
 
-  // TODO(simon-camp): Support vm.global.i64 and vm.global.ref
+  for (auto globalOp : moduleOp.getOps<IREE::VM::GlobalI64Op>()) {
+    Optional<Attribute> initialValue = globalOp.initial_value();
+    Optional<StringRef> initializer = globalOp.initializer();
+    if (initialValue.hasValue()) {
+      emitter.ostream() << "vm_global_store_i64(state->rwdata, "
+                        << globalOp.ordinal() << ", ";
+      if (failed(emitter.emitAttribute(initialValue.getValue()))) {
+        return globalOp.emitError() << "Unable to emit initial_value";
+      }
+      emitter.ostream() << ");\n";
+    } else if (initializer.hasValue()) {
+      return globalOp.emitError()
+             << "Initializers for globals not supported yet";
+    }
+  }
+
+  // Ref globals would need their loads, stores and the refs they leave in
+  // locals released, which the C target does not track yet.
+  auto globalRefOps = moduleOp.getOps<IREE::VM::GlobalRefOp>();
+  if (!globalRefOps.empty()) {
+    return (*globalRefOps.begin()).emitError()
+           << "Ref globals are not supported by the C target yet";
+  }
 
   return success();
 }
@@ -168,9 +184,246 @@ static LogicalResult translateBranchOp(IREE::VM::BranchOp branchOp,
   return success();
 }
 
+// Returns the size in bytes of |type| when marshaled through the calling
+// convention ABI buffers or None if the type is not supported yet.
+static Optional<size_t> getCallingConventionSize(Type type) {
+  if (auto integerType = type.dyn_cast<IntegerType>()) {
+    if (integerType.getWidth() == 32) return 4;
+    if (integerType.getWidth() == 64) return 8;
+  } else if (auto floatType = type.dyn_cast<FloatType>()) {
+    if (floatType.getWidth() == 32) return 4;
+    if (floatType.getWidth() == 64) return 8;
+  }
+  return llvm::None;
+}
+
+// Calls into an internal function directly by its implementation symbol.
+static LogicalResult translateInternalCallOpToC(
+    IREE::VM::CallOp callOp, IREE::VM::ModuleOp moduleOp,
+    IREE::VM::FuncOp funcOp, mlir::emitc::CppEmitter &emitter) {
+  llvm::raw_ostream &output = emitter.ostream();
+
+  SmallVector<std::string, 4> argNames;
+  for (Value operand : callOp.getOperands()) {
+    argNames.push_back(emitter.getOrCreateName(operand).str());
+  }
+  for (Value result : callOp.getResults()) {
+    argNames.push_back("&" + emitter.getOrCreateName(result).str());
+  }
+  argNames.push_back("stack");
+  argNames.push_back("state");
+
+  output << "IREE_RETURN_IF_ERROR("
+         << buildFunctionName(moduleOp, funcOp, /*implSuffix=*/true) << "("
+         << llvm::join(argNames, ", ") << "));\n";
+  return success();
+}
+
+// Returns true if values of |type| can be passed to imports. Refs are passed
+// as borrowed iree_vm_ref_t values the same way the bytecode interpreter
+// passes them so the callee must retain them if it needs to keep them.
+static bool isSupportedImportArgumentType(Type type) {
+  if (getCallingConventionSize(type)) return true;
+  if (auto opaqueType = type.dyn_cast<emitc::OpaqueType>()) {
+    return opaqueType.getValue() == "iree_vm_ref_t";
+  }
+  return false;
+}
+
+// Calls into an imported function through the module interface. Arguments and
+// results are marshaled through ABI buffers packed the same way as the
+// bytecode interpreter does for its import calls: each variadic segment is
+// prefixed with its i32 element count. |segmentSizes| holds -1 for each
+// non-variadic argument and is empty if the call has no variadic segments.
+static LogicalResult translateImportCallOpToC(
+    Operation *callOp, IREE::VM::ImportOp importOp, ValueRange operands,
+    ArrayRef<int64_t> segmentSizes, ArrayRef<Type> segmentTypes,
+    ValueRange results, mlir::emitc::CppEmitter &emitter) {
+  llvm::raw_ostream &output = emitter.ostream();
+
+  if (importOp.isVariadic() && segmentSizes.empty()) {
+    return callOp->emitOpError()
+           << "variadic imports must be called with vm.call.variadic";
+  }
+
+  // Each argument is either a single value or a span count followed by the
+  // flattened span elements.
+  struct PackedArgument {
+    Optional<Value> value;
+    size_t spanCountIndex;
+  };
+  SmallVector<PackedArgument, 8> packedArguments;
+  SmallVector<int64_t, 4> spanCounts;
+  auto operandIt = operands.begin();
+  auto packOperands = [&](size_t count) -> LogicalResult {
+    for (size_t i = 0; i < count; ++i) {
+      if (operandIt == operands.end()) {
+        return callOp->emitOpError() << "segment sizes exceed operand count";
+      }
+      Value operand = *operandIt++;
+      if (!isSupportedImportArgumentType(operand.getType())) {
+        return callOp->emitOpError()
+               << "unsupported import argument type " << operand.getType();
+      }
+      packedArguments.push_back({operand, 0});
+    }
+    return success();
+  };
+  if (segmentSizes.empty()) {
+    if (failed(packOperands(operands.size()))) return failure();
+  } else {
+    for (auto segment : llvm::zip(segmentSizes, segmentTypes)) {
+      int64_t segmentSize = std::get<0>(segment);
+      if (segmentSize < 0) {
+        if (failed(packOperands(1))) return failure();
+        continue;
+      }
+      // Tuple segments are flattened into their element values.
+      size_t valuesPerElement = 1;
+      if (auto tupleType = std::get<1>(segment).dyn_cast<TupleType>()) {
+        valuesPerElement = tupleType.size();
+      }
+      packedArguments.push_back({llvm::None, spanCounts.size()});
+      spanCounts.push_back(segmentSize);
+      if (failed(packOperands(segmentSize * valuesPerElement))) {
+        return failure();
+      }
+    }
+  }
+  if (operandIt != operands.end()) {
+    return callOp->emitOpError() << "operands not covered by segment sizes";
+  }
+
+  SmallVector<std::pair<Value, size_t>, 4> resultOffsets;
+  size_t resultBufferSize = 0;
+  for (Value result : results) {
+    // Ref results transfer ownership to the caller and the C target does not
+    // track the lifetime of local refs yet.
+    auto size = getCallingConventionSize(result.getType());
+    if (!size) {
+      return callOp->emitOpError()
+             << "unsupported import result type " << result.getType();
+    }
+    resultOffsets.push_back({result, resultBufferSize});
+    resultBufferSize += size.getValue();
+  }
+
+  // Refs have a target-dependent size so the argument buffer is sized and
+  // filled using sizeof of the packed values.
+  auto getArgumentSizeExpr = [&](const PackedArgument &argument) {
+    if (!argument.value) return std::string("sizeof(int32_t)");
+    return "sizeof(" + emitter.getOrCreateName(*argument.value).str() + ")";
+  };
+
+  output << "{\n";
+  if (!packedArguments.empty()) {
+    SmallVector<std::string, 8> argumentSizes;
+    for (auto &argument : packedArguments) {
+      argumentSizes.push_back(getArgumentSizeExpr(argument));
+    }
+    output << "uint8_t import_args[" << llvm::join(argumentSizes, " + ")
+           << "];\n";
+  }
+  if (resultBufferSize > 0) {
+    output << "uint8_t import_results[" << resultBufferSize << "];\n";
+  }
+  if (!spanCounts.empty()) {
+    SmallVector<std::string, 4> spanCountValues;
+    for (int64_t spanCount : spanCounts) {
+      spanCountValues.push_back(std::to_string(spanCount));
+    }
+    output << "const int32_t import_span_counts[" << spanCounts.size()
+           << "] = {" << llvm::join(spanCountValues, ", ") << "};\n";
+  }
+  if (!packedArguments.empty()) {
+    output << "uint8_t* import_args_ptr = import_args;\n";
+  }
+  for (auto &argument : packedArguments) {
+    std::string source =
+        argument.value
+            ? emitter.getOrCreateName(*argument.value).str()
+            : "import_span_counts[" +
+                  std::to_string(argument.spanCountIndex) + "]";
+    std::string size = getArgumentSizeExpr(argument);
+    output << "memcpy(import_args_ptr, &" << source << ", " << size << ");\n"
+           << "import_args_ptr += " << size << ";\n";
+  }
+  output << "iree_vm_function_call_t call;\n"
+         << "memset(&call, 0, sizeof(call));\n"
+         << "call.function = state->imports["
+         << importOp.ordinal().getValue().getZExtValue() << "];\n";
+  output << "call.arguments = ";
+  if (packedArguments.empty()) {
+    output << "iree_make_byte_span(NULL, 0);\n";
+  } else {
+    output << "iree_make_byte_span(import_args, sizeof(import_args));\n";
+  }
+  output << "call.results = ";
+  if (resultBufferSize == 0) {
+    output << "iree_make_byte_span(NULL, 0);\n";
+  } else {
+    output << "iree_make_byte_span(import_results, sizeof(import_results));\n";
+  }
+  // C modules cannot suspend themselves so imports that yield are waited on
+  // in place and resumed until they complete.
+  output << "iree_vm_execution_result_t result;\n"
+         << "memset(&result, 0, sizeof(result));\n"
+         << "iree_status_t import_status = call.function.module->begin_call("
+            "call.function.module->self, stack, &call, &result);\n"
+         << "while (iree_status_is_ok(import_status) && "
+            "iree_all_bits_set(result.flags, "
+            "IREE_VM_EXECUTION_RESULT_FLAG_YIELDED)) {\n"
+         << "import_status = iree_vm_wait_request_await(&result.wait, "
+            "IREE_TIME_INFINITE_FUTURE);\n"
+         << "iree_vm_wait_request_reset(&result.wait);\n"
+         << "if (iree_status_is_ok(import_status)) {\n"
+         << "import_status = call.function.module->resume_call("
+            "call.function.module->self, stack, &call, &result);\n"
+         << "}\n"
+         << "}\n"
+         << "IREE_RETURN_IF_ERROR(import_status);\n";
+  for (auto &resultOffset : resultOffsets) {
+    StringRef name = emitter.getOrCreateName(resultOffset.first);
+    output << "memcpy(&" << name << ", import_results + "
+           << resultOffset.second << ", sizeof(" << name << "));\n";
+  }
+  output << "}\n";
+  return success();
+}
+
 static LogicalResult translateCallOpToC(IREE::VM::CallOp callOp,
                                         mlir::emitc::CppEmitter &emitter) {
-  return success();
+  auto moduleOp = callOp->getParentOfType<IREE::VM::ModuleOp>();
+  Operation *calleeOp = moduleOp.lookupSymbol(callOp.callee());
+  if (auto funcOp = dyn_cast_or_null<IREE::VM::FuncOp>(calleeOp)) {
+    return translateInternalCallOpToC(callOp, moduleOp, funcOp, emitter);
+  }
+  if (auto importOp = dyn_cast_or_null<IREE::VM::ImportOp>(calleeOp)) {
+    return translateImportCallOpToC(callOp, importOp, callOp.getOperands(),
+                                    /*segmentSizes=*/{}, /*segmentTypes=*/{},
+                                    callOp.getResults(), emitter);
+  }
+  return callOp.emitOpError() << "unable to find callee";
+}
+
+static LogicalResult translateCallVariadicOpToC(
+    IREE::VM::CallVariadicOp callOp, mlir::emitc::CppEmitter &emitter) {
+  auto moduleOp = callOp->getParentOfType<IREE::VM::ModuleOp>();
+  auto importOp = moduleOp.lookupSymbol<IREE::VM::ImportOp>(callOp.callee());
+  if (!importOp) {
+    return callOp.emitOpError() << "variadic callee must be an import";
+  }
+  SmallVector<int64_t, 4> segmentSizes;
+  for (APInt segmentSize : callOp.segment_sizes()) {
+    segmentSizes.push_back(segmentSize.getSExtValue());
+  }
+  SmallVector<Type, 4> segmentTypes;
+  for (Attribute segmentType : callOp.segment_types()) {
+    segmentTypes.push_back(segmentType.cast<TypeAttr>().getValue());
+  }
+  return translateImportCallOpToC(callOp, importOp, callOp.getOperands(),
+                                  segmentSizes, segmentTypes,
+                                  callOp.getResults(), emitter);
 }
 
 static LogicalResult translateCondBranchOp(IREE::VM::CondBranchOp condBranchOp,
@@ -252,12 +505,19 @@ static LogicalResult translateOpToC(Operation &op,
     return translateBranchOp(branchOp, emitter);
   if (auto callOp = dyn_cast<IREE::VM::CallOp>(op))
     return translateCallOpToC(callOp, emitter);
+  if (auto callOp = dyn_cast<IREE::VM::CallVariadicOp>(op))
+    return translateCallVariadicOpToC(callOp, emitter);
   if (auto condBranchOp = dyn_cast<IREE::VM::CondBranchOp>(op))
     return translateCondBranchOp(condBranchOp, emitter);
   if (auto failOp = dyn_cast<IREE::VM::FailOp>(op))
     return translateFailOp(failOp, emitter);
   if (auto returnOp = dyn_cast<IREE::VM::ReturnOp>(op))
     return translateReturnOpToC(returnOp, emitter, resultNames);
+  // Lists are ref-counted objects and the C target does not release the refs
+  // held in locals yet.
+  if (op.getName().getStringRef().startswith("vm.list.")) {
+    return op.emitOpError() << "list ops are not supported by the C target yet";
+  }
   // Fall back to generic emitc printer
   if (succeeded(emitter.emitOperation(op, /*trailingSemicolon=*/true))) {
     return success();
@@ -303,7 +563,8 @@ static LogicalResult translateFunctionToC(IREE::VM::ModuleOp &moduleOp,
 
   // TODO(simon-camp): We can't represent structs in emitc (yet maybe), so the
   // struct argument name here must not be changed.
-  output << moduleName << "_state_t* state) {\n";
+  output << "iree_vm_stack_t* stack, " << moduleName
+         << "_state_t* state) {\n";
 
   // We forward declare all result variables.
   for (auto &op : funcOp.getOps()) {
@@ -352,6 +613,89 @@ static LogicalResult translateFunctionToC(IREE::VM::ModuleOp &moduleOp,
   return success();
 }
 
+// Prints a shim matching iree_vm_native_function_shim_t that unpacks the
+// arguments of |funcOp| from the call buffers, calls its wrapper and packs the
+// results.
+static LogicalResult printExportShim(IREE::VM::ModuleOp &moduleOp,
+                                     IREE::VM::FuncOp &funcOp,
+                                     mlir::emitc::CppEmitter &emitter) {
+  llvm::raw_ostream &output = emitter.ostream();
+  std::string moduleName = moduleOp.getName().str();
+  std::string functionName =
+      buildFunctionName(moduleOp, funcOp, /*implSuffix=*/false);
+
+  // Declares a local for each of |types| and records its offset within the
+  // packed ABI buffer. |bufferSize| is set to the total size of the buffer.
+  using PackedLocal = std::pair<std::string, size_t>;
+  auto declareLocals = [&](ArrayRef<Type> types, StringRef prefix,
+                           SmallVectorImpl<PackedLocal> &locals,
+                           size_t &bufferSize) -> LogicalResult {
+    bufferSize = 0;
+    for (auto type : llvm::enumerate(types)) {
+      auto size = getCallingConventionSize(type.value());
+      if (!size) {
+        return funcOp.emitError() << "Unsupported type " << type.value()
+                                  << " in exported function";
+      }
+      std::string name = prefix.str() + std::to_string(type.index());
+      if (failed(emitter.emitType(type.value()))) return failure();
+      output << " " << name << ";\n";
+      locals.push_back({name, bufferSize});
+      bufferSize += size.getValue();
+    }
+    return success();
+  };
+
+  auto funcType = funcOp.getType();
+  output << "static iree_status_t " << functionName
+         << "_shim(iree_vm_stack_t* stack, const iree_vm_function_call_t* "
+            "call, iree_vm_native_function_target_t target_fn, void* module, "
+            "void* module_state, iree_vm_execution_result_t* out_result) {\n";
+  SmallVector<PackedLocal, 4> args;
+  SmallVector<PackedLocal, 4> results;
+  size_t argumentsSize = 0;
+  size_t resultsSize = 0;
+  if (failed(declareLocals(funcType.getInputs(), "arg", args,
+                           argumentsSize)) ||
+      failed(declareLocals(funcType.getResults(), "res", results,
+                           resultsSize))) {
+    return failure();
+  }
+  if (argumentsSize > 0) {
+    output << "if (call->arguments.data_length < " << argumentsSize
+           << ") {\n"
+           << "return iree_make_status(IREE_STATUS_INVALID_ARGUMENT, "
+              "\"argument buffer too small\");\n"
+           << "}\n";
+  }
+  if (resultsSize > 0) {
+    output << "if (call->results.data_length < " << resultsSize << ") {\n"
+           << "return iree_make_status(IREE_STATUS_INVALID_ARGUMENT, "
+              "\"result buffer too small\");\n"
+           << "}\n";
+  }
+  for (auto &arg : args) {
+    output << "memcpy(&" << arg.first << ", call->arguments.data + "
+           << arg.second << ", sizeof(" << arg.first << "));\n";
+  }
+
+  SmallVector<std::string, 8> callArgs = {
+      "stack", "(" + moduleName + "_t*)module",
+      "(" + moduleName + "_state_t*)module_state"};
+  for (auto &arg : args) callArgs.push_back(arg.first);
+  for (auto &result : results) callArgs.push_back("&" + result.first);
+  output << "IREE_RETURN_IF_ERROR(" << functionName << "("
+         << llvm::join(callArgs, ", ") << "));\n";
+
+  for (auto &result : results) {
+    output << "memcpy(call->results.data + " << result.second << ", &"
+           << result.first << ", sizeof(" << result.first << "));\n";
+  }
+  output << "return iree_ok_status();\n"
+         << "}\n";
+  return success();
+}
+
 static LogicalResult buildModuleDescriptors(IREE::VM::ModuleOp &moduleOp,
                                             mlir::emitc::CppEmitter &emitter) {
   SymbolTable symbolTable(moduleOp);
@@ -411,7 +755,29 @@ static LogicalResult buildModuleDescriptors(IREE::VM::ModuleOp &moduleOp,
     if (funcOp.getNumArguments() + funcOp.getNumResults() > 0) {
       output << ", ";
     }
-    output << "state);\n}\n";
+    output << "stack, state);\n}\n";
+  }
+
+  // Sort export ops. The exports and the function table are both indexed by
+  // export ordinal.
+  SmallVector<IREE::VM::ExportOp, 4> exportOps(
+      moduleOp.getOps<IREE::VM::ExportOp>());
+  llvm::sort(exportOps, [](auto &lhs, auto &rhs) {
+    return lhs.export_name().compare(rhs.export_name()) < 0;
+  });
+
+  // Export shims. Each exported function gets its own shim unpacking the ABI
+  // buffers into typed locals so floating-point values are passed as such.
+  llvm::SmallSet<StringRef, 4> shimmedFuncs;
+  for (auto exportOp : exportOps) {
+    auto funcOp = symbolTable.lookup<IREE::VM::FuncOp>(exportOp.function_ref());
+    if (!funcOp) {
+      return exportOp.emitError("Couldn't find referenced FuncOp");
+    }
+    if (!shimmedFuncs.insert(funcOp.getName()).second) continue;
+    if (failed(printExportShim(moduleOp, funcOp, emitter))) {
+      return failure();
+    }
   }
 
   auto printCStringView = [](std::string s) -> std::string {
@@ -423,13 +789,6 @@ static LogicalResult buildModuleDescriptors(IREE::VM::ModuleOp &moduleOp,
   output << "static const iree_vm_native_export_descriptor_t " << exportName
          << "[] = {\n";
 
-  // sort export ops
-  SmallVector<IREE::VM::ExportOp, 4> exportOps(
-      moduleOp.getOps<IREE::VM::ExportOp>());
-  llvm::sort(exportOps, [](auto &lhs, auto &rhs) {
-    return lhs.export_name().compare(rhs.export_name()) < 0;
-  });
-
   for (auto exportOp : exportOps) {
     auto funcOp = symbolTable.lookup<IREE::VM::FuncOp>(exportOp.function_ref());
     if (!funcOp) {
@@ -440,7 +799,6 @@ static LogicalResult buildModuleDescriptors(IREE::VM::ModuleOp &moduleOp,
       return exportOp.emitError(
           "Couldn't create calling convention string for referenced FuncOp");
     }
-
     // TODO(simon-camp): support function-level reflection attributes
     output << "{" << printCStringView(exportOp.export_name().str()) << ", "
            << printCStringView(callingConvention.getValue()) << ", 0, NULL},\n";
@@ -453,11 +811,13 @@ static LogicalResult buildModuleDescriptors(IREE::VM::ModuleOp &moduleOp,
   output << "static const iree_vm_native_import_descriptor_t " << importName
          << "[] = {\n";
 
-  // sort import ops
+  // Imports are resolved by ordinal into the state import table so they must
+  // be emitted in ordinal order.
   SmallVector<IREE::VM::ImportOp, 4> importOps(
       moduleOp.getOps<IREE::VM::ImportOp>());
   llvm::sort(importOps, [](auto &lhs, auto &rhs) {
-    return lhs.getName().compare(rhs.getName()) < 0;
+    return lhs.ordinal().getValue().getZExtValue() <
+           rhs.ordinal().getValue().getZExtValue();
   });
 
   for (auto importOp : importOps) {
@@ -471,23 +831,12 @@ static LogicalResult buildModuleDescriptors(IREE::VM::ModuleOp &moduleOp,
   output << "static const iree_vm_native_function_ptr_t " << functionName
          << "[] = {\n";
 
-  // sort func ops
-  SmallVector<IREE::VM::FuncOp, 4> funcOps(moduleOp.getOps<IREE::VM::FuncOp>());
-  llvm::sort(funcOps, [&moduleOp](auto &lhs, auto &rhs) {
-    std::string lhsStr =
-        buildFunctionName(moduleOp, lhs, /*implSufffix=*/false);
-    std::string rhsStr =
-        buildFunctionName(moduleOp, rhs, /*implSufffix=*/false);
-    return lhsStr.compare(rhsStr) < 0;
-  });
-  for (auto funcOp : funcOps) {
-    output << "{"
-           << "(iree_vm_native_function_shim_t)";
-
-    if (failed(printShim(funcOp, output))) {
-      return funcOp.emitError("Couldn't create calling convention string");
-    }
-    output << ", "
+  // Native modules index the function table by export ordinal so the table
+  // must match the sorted export table 1:1.
+  for (auto exportOp : exportOps) {
+    auto funcOp = symbolTable.lookup<IREE::VM::FuncOp>(exportOp.function_ref());
+    output << "{" << buildFunctionName(moduleOp, funcOp, /*implSufffix=*/false)
+           << "_shim, "
            << "(iree_vm_native_function_target_t)"
            << buildFunctionName(moduleOp, funcOp, /*implSufffix=*/false)
            << "},\n";
@@ -542,8 +891,17 @@ static LogicalResult buildModuleDescriptors(IREE::VM::ModuleOp &moduleOp,
          << "iree_allocator_free(state->allocator, state);\n"
          << "}\n";
 
-  // resolve_imports
-  // TODO(simon-camp):
+  // resolve_import
+  output << "static iree_status_t " << moduleName
+         << "_resolve_import(void* self, iree_vm_module_state_t* "
+            "module_state, iree_host_size_t ordinal, const "
+            "iree_vm_function_t* function, const "
+            "iree_vm_function_signature_t* signature) {\n"
+         << moduleName << "_state_t* state = (" << moduleName
+         << "_state_t*)module_state;\n"
+         << "state->imports[ordinal] = *function;\n"
+         << "return iree_ok_status();\n"
+         << "}\n";
 
   // create
   output << "static iree_status_t " << moduleName << "_create("
@@ -555,7 +913,8 @@ static LogicalResult buildModuleDescriptors(IREE::VM::ModuleOp &moduleOp,
          << "interface.destroy = NULL;\n"
          << "interface.alloc_state = " << moduleName << "_alloc_state;\n"
          << "interface.free_state = " << moduleName << "_free_state;\n"
-         << "interface.resolve_import = NULL;\n"
+         << "interface.resolve_import = " << moduleName
+         << "_resolve_import;\n"
          << "return iree_vm_native_module_create(&interface, "
             "&"
          << descriptorName << ", allocator, out_module);\n"
@@ -654,7 +1013,6 @@ LogicalResult translateModuleToC(IREE::VM::ModuleOp moduleOp,
 
   printInclude("iree/vm/api.h");
   printInclude("iree/vm/ops.h");
-  printInclude("iree/vm/shims.h");
   output << "\n";
 
   printModuleComment(moduleOp, output);
@@ -0,0 +1,91 @@
+// RUN: iree-translate -iree-vm-ir-to-c-module -iree-vm-c-module-optimize=false %s | IreeFileCheck %s
+
+vm.module @call_ops {
+  // CHECK-LABEL: struct call_ops_state_s {
+  // CHECK: iree_vm_function_t imports[3];
+
+  vm.import @other_module.add(%arg0 : i32, %arg1 : i32) -> i32
+  vm.import @other_module.sum(%arg0 : i32, %arg1 : i32 ...) -> i32
+  vm.import @other_module.consume(%arg0 : !vm.ref<?>)
+
+  vm.func @internal_func(%arg0 : i32) -> i32 {
+    vm.return %arg0 : i32
+  }
+
+  // CHECK-LABEL: iree_status_t call_ops_call_internal_impl(
+  vm.func @call_internal(%arg0 : i32) -> i32 {
+    // CHECK: IREE_RETURN_IF_ERROR(call_ops_internal_func_impl([[ARG:[^ ]*]], &[[RESULT:[^ ]*]], stack, state));
+    %0 = vm.call @internal_func(%arg0) : (i32) -> i32
+    vm.return %0 : i32
+  }
+
+  // CHECK-LABEL: iree_status_t call_ops_call_import_impl(
+  vm.func @call_import(%arg0 : i32, %arg1 : i32) -> i32 {
+    // CHECK: uint8_t import_args[sizeof([[ARG0:[^ ]*]]) + sizeof([[ARG1:[^ ]*]])];
+    // CHECK-NEXT: uint8_t import_results[4];
+    // CHECK-NEXT: uint8_t* import_args_ptr = import_args;
+    // CHECK-NEXT: memcpy(import_args_ptr, &[[ARG0]], sizeof([[ARG0]]));
+    // CHECK-NEXT: import_args_ptr += sizeof([[ARG0]]);
+    // CHECK-NEXT: memcpy(import_args_ptr, &[[ARG1]], sizeof([[ARG1]]));
+    // CHECK-NEXT: import_args_ptr += sizeof([[ARG1]]);
+    // CHECK: call.function = state->imports[0];
+    // CHECK: iree_status_t import_status = call.function.module->begin_call(call.function.module->self, stack, &call, &result);
+    // CHECK-NEXT: while (iree_status_is_ok(import_status) && iree_all_bits_set(result.flags, IREE_VM_EXECUTION_RESULT_FLAG_YIELDED)) {
+    // CHECK-NEXT: import_status = iree_vm_wait_request_await(&result.wait, IREE_TIME_INFINITE_FUTURE);
+    // CHECK-NEXT: iree_vm_wait_request_reset(&result.wait);
+    // CHECK-NEXT: if (iree_status_is_ok(import_status)) {
+    // CHECK-NEXT: import_status = call.function.module->resume_call(call.function.module->self, stack, &call, &result);
+    // CHECK-NEXT: }
+    // CHECK-NEXT: }
+    // CHECK-NEXT: IREE_RETURN_IF_ERROR(import_status);
+    // CHECK-NEXT: memcpy(&[[RESULT:[^ ]*]], import_results + 0, sizeof([[RESULT]]));
+    %0 = vm.call @other_module.add(%arg0, %arg1) : (i32, i32) -> i32
+    vm.return %0 : i32
+  }
+
+  // CHECK-LABEL: iree_status_t call_ops_call_import_variadic_impl(
+  vm.func @call_import_variadic(%arg0 : i32, %arg1 : i32) -> i32 {
+    // CHECK: uint8_t import_args[sizeof([[ARG0:[^ ]*]]) + sizeof(int32_t) + sizeof([[ARG0]]) + sizeof([[ARG1:[^ ]*]])];
+    // CHECK-NEXT: uint8_t import_results[4];
+    // CHECK-NEXT: const int32_t import_span_counts[1] = {2};
+    // CHECK-NEXT: uint8_t* import_args_ptr = import_args;
+    // CHECK-NEXT: memcpy(import_args_ptr, &[[ARG0]], sizeof([[ARG0]]));
+    // CHECK-NEXT: import_args_ptr += sizeof([[ARG0]]);
+    // CHECK-NEXT: memcpy(import_args_ptr, &import_span_counts[0], sizeof(int32_t));
+    // CHECK-NEXT: import_args_ptr += sizeof(int32_t);
+    // CHECK-NEXT: memcpy(import_args_ptr, &[[ARG0]], sizeof([[ARG0]]));
+    // CHECK-NEXT: import_args_ptr += sizeof([[ARG0]]);
+    // CHECK-NEXT: memcpy(import_args_ptr, &[[ARG1]], sizeof([[ARG1]]));
+    // CHECK-NEXT: import_args_ptr += sizeof([[ARG1]]);
+    // CHECK: call.function = state->imports[1];
+    %0 = vm.call.variadic @other_module.sum(%arg0, [%arg0, %arg1]) : (i32, i32 ...) -> i32
+    vm.return %0 : i32
+  }
+
+  // Refs are passed borrowed so they are copied into the buffer as-is.
+  // CHECK-LABEL: iree_status_t call_ops_call_import_ref_impl(
+  vm.func @call_import_ref() {
+    // CHECK: uint8_t import_args[sizeof([[REF:[^ ]*]])];
+    // CHECK-NEXT: uint8_t* import_args_ptr = import_args;
+    // CHECK-NEXT: memcpy(import_args_ptr, &[[REF]], sizeof([[REF]]));
+    // CHECK: call.function = state->imports[2];
+    // CHECK: call.results = iree_make_byte_span(NULL, 0);
+    %ref = vm.const.ref.zero : !vm.ref<?>
+    vm.call @other_module.consume(%ref) : (!vm.ref<?>) -> ()
+    vm.return
+  }
+
+  vm.export @call_internal
+  vm.export @call_import
+
+  // The function table is indexed by export ordinal and must follow the
+  // sorted export names.
+  // CHECK-LABEL: static const iree_vm_native_function_ptr_t call_ops_funcs_[] = {
+  // CHECK-NEXT: {call_ops_call_import_shim, (iree_vm_native_function_target_t)call_ops_call_import},
+  // CHECK-NEXT: {call_ops_call_internal_shim, (iree_vm_native_function_target_t)call_ops_call_internal},
+  // CHECK-NEXT: };
+
+  // CHECK-LABEL: static iree_status_t call_ops_resolve_import(
+  // CHECK: state->imports[ordinal] = *function;
+  // CHECK: interface.resolve_import = call_ops_resolve_import;
+}
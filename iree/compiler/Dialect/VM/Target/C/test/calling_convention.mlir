@@ -2,19 +2,19 @@
 
 // CHECK: #include "iree/vm/ops.h"
 vm.module @calling_convention_test {
-  // CHECK: iree_status_t calling_convention_test_no_in_no_return_impl(calling_convention_test_state_t* state) {
+  // CHECK: iree_status_t calling_convention_test_no_in_no_return_impl(iree_vm_stack_t* stack, calling_convention_test_state_t* state) {
   vm.func @no_in_no_return() -> () {
     // CHECK-NEXT: return iree_ok_status();
     vm.return
   }
 
-  // CHECK: iree_status_t calling_convention_test_i32_in_no_return_impl(int32_t v1, calling_convention_test_state_t* state) {
+  // CHECK: iree_status_t calling_convention_test_i32_in_no_return_impl(int32_t v1, iree_vm_stack_t* stack, calling_convention_test_state_t* state) {
   vm.func @i32_in_no_return(%arg0 : i32) -> () {
     // CHECK-NEXT: return iree_ok_status();
     vm.return
   }
 
-  // CHECK: iree_status_t calling_convention_test_no_in_i32_return_impl(int32_t *out0, calling_convention_test_state_t* state) {
+  // CHECK: iree_status_t calling_convention_test_no_in_i32_return_impl(int32_t *out0, iree_vm_stack_t* stack, calling_convention_test_state_t* state) {
   vm.func @no_in_i32_return() -> (i32) {
     // CHECK-NEXT: int32_t v1;
     // CHECK-NEXT: v1 = 32;
@@ -24,7 +24,7 @@ vm.module @calling_convention_test {
     vm.return %0 : i32
   }
 
-  // CHECK: iree_status_t calling_convention_test_i32_in_i32_return_impl(int32_t v1, int32_t *out0, calling_convention_test_state_t* state) {
+  // CHECK: iree_status_t calling_convention_test_i32_in_i32_return_impl(int32_t v1, int32_t *out0, iree_vm_stack_t* stack, calling_convention_test_state_t* state) {
   vm.func @i32_in_i32_return(%arg0 : i32) -> (i32) {
     // CHECK-NEXT: int32_t v2;
     // CHECK-NEXT: v2 = 32;
@@ -33,4 +33,22 @@ vm.module @calling_convention_test {
     // CHECK-NEXT: return iree_ok_status();
     vm.return %0 : i32
   }
+
+  // Exports get their own shim unpacking the arguments into typed locals so
+  // floating-point values are not passed through integer registers.
+  vm.export @f32_in_f32_return
+  vm.func @f32_in_f32_return(%arg0 : f32) -> (f32) {
+    vm.return %arg0 : f32
+  }
+
+  // CHECK-LABEL: static iree_status_t calling_convention_test_f32_in_f32_return_shim(
+  // CHECK-NEXT: float arg0;
+  // CHECK-NEXT: float res0;
+  // CHECK-NEXT: if (call->arguments.data_length < 4) {
+  // CHECK: if (call->results.data_length < 4) {
+  // CHECK: memcpy(&arg0, call->arguments.data + 0, sizeof(arg0));
+  // CHECK-NEXT: IREE_RETURN_IF_ERROR(calling_convention_test_f32_in_f32_return(stack, (calling_convention_test_t*)module, (calling_convention_test_state_t*)module_state, arg0, &res0));
+  // CHECK-NEXT: memcpy(call->results.data + 0, &res0, sizeof(res0));
+  // CHECK-NEXT: return iree_ok_status();
+  // CHECK: {calling_convention_test_f32_in_f32_return_shim, (iree_vm_native_function_target_t)calling_convention_test_f32_in_f32_return},
 }
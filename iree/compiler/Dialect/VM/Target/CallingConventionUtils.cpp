@@ -30,6 +30,7 @@ namespace VM {
 //
 // Examples:
 //  i32              -> i
+//  f32              -> i (bitwise)
 //  !vm.ref<...>     -> r
 //  tuple<i32, i64>  -> iI
 LogicalResult encodeCallingConventionType(Operation *op, Type type,
@@ -47,6 +48,19 @@ LogicalResult encodeCallingConventionType(Operation *op, Type type,
         s.push_back('I');
         return success();
     }
+  } else if (auto floatType = type.dyn_cast<FloatType>()) {
+    // Floats are marshaled bitwise through the integer slots of the same width.
+    switch (floatType.getWidth()) {
+      case 32:
+        s.push_back('i');
+        return success();
+      case 64:
+        s.push_back('I');
+        return success();
+      default:
+        return op->emitError()
+               << "unsupported external calling convention type " << type;
+    }
   } else if (auto tupleType = type.dyn_cast<TupleType>()) {
     // Flatten tuple (so tuple<i32, i64> -> `...iI...`).
     SmallVector<Type, 4> flattenedTypes;
@@ -0,0 +1,208 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/compiler/Dialect/VM/Analysis/ValueLiveness.h"
+#include "iree/compiler/Dialect/VM/IR/VMOps.h"
+#include "iree/compiler/Dialect/VM/Transforms/Passes.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include "mlir/IR/Attributes.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Interfaces/ControlFlowInterfaces.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Pass/PassRegistry.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+
+namespace mlir {
+namespace iree_compiler {
+namespace IREE {
+namespace VM {
+
+// Returns true if |op| releases ref operands that are marked as move (their
+// last use) itself. The register encoder sets the move bit on last uses and
+// these ops either transfer ownership of or drop the ref when it is set.
+// All other ops only borrow their ref operands and require an explicit discard.
+static bool consumesMovedRefs(Operation *op, SymbolTable &symbolTable) {
+  if (op->hasTrait<OpTrait::IsTerminator>()) {
+    // Branches remap with moves and returns move into the caller.
+    return true;
+  } else if (auto callOp = dyn_cast<CallOp>(op)) {
+    // Internal calls move arguments into the callee frame while imports only
+    // borrow them for the duration of the call.
+    return isa_and_nonnull<FuncOp>(symbolTable.lookup(callOp.callee()));
+  }
+  return isa<DiscardRefsOp, GlobalStoreRefOp, GlobalStoreIndirectRefOp,
+             SelectRefOp, TraceOp, PrintOp>(op);
+}
+
+static bool isRefValue(Value value) {
+  return value.getType().isa<IREE::VM::RefType>();
+}
+
+// Inserts vm.discard.refs ops such that ref registers are released as soon as
+// the value they hold is dead instead of when the function returns.
+//
+// Values are released after their last use within a block (unless the use
+// itself consumes the value) and at the entry of successor blocks where the
+// value is no longer live. Functions for which every ref is guaranteed to be
+// released or moved out on all paths to a vm.return are marked with the
+// `vm.no_live_refs_at_return` attribute so that the runtime can skip the
+// register sweep when the frame is popped.
+class DiscardRefsPass
+    : public PassWrapper<DiscardRefsPass, OperationPass<ModuleOp>> {
+ public:
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<IREE::VM::VMDialect>();
+  }
+
+  void runOnOperation() override {
+    SymbolTable symbolTable(getOperation());
+    for (auto funcOp : getOperation().getOps<FuncOp>()) {
+      if (failed(discardRefsInFunc(funcOp, symbolTable))) {
+        return signalPassFailure();
+      }
+    }
+  }
+
+ private:
+  LogicalResult discardRefsInFunc(FuncOp funcOp, SymbolTable &symbolTable) {
+    if (funcOp.empty()) return success();
+
+    ValueLiveness liveness;
+    if (failed(liveness.recalculate(funcOp))) {
+      return funcOp.emitError() << "failed to calculate value liveness";
+    }
+    DominanceInfo domInfo(funcOp);
+
+    // Gather all discards prior to mutating the IR as the liveness information
+    // is invalidated by the insertions.
+    bool allReleased = true;
+    SmallVector<std::pair<Block *, SmallVector<Value, 4>>, 4> blockDiscards;
+    SmallVector<std::pair<Operation *, SmallVector<Value, 4>>, 16> opDiscards;
+    for (auto &block : funcOp.getBlocks()) {
+      llvm::SetVector<Value> entryValues;
+
+      // Block arguments that are never used.
+      for (auto arg : block.getArguments()) {
+        if (isRefValue(arg) && arg.use_empty()) entryValues.insert(arg);
+      }
+
+      // Values that were live out of a predecessor but are dead on entry to
+      // this block. These are only released here if they dominate the block;
+      // otherwise the register is left for the frame cleanup.
+      auto liveIns = liveness.getBlockLiveIns(&block);
+      llvm::SmallPtrSet<Value, 8> liveInSet(liveIns.begin(), liveIns.end());
+      for (auto it = block.pred_begin(); it != block.pred_end(); ++it) {
+        auto *predTerminator = (*it)->getTerminator();
+        llvm::SmallPtrSet<Value, 8> passedValues;
+        auto branchOp = dyn_cast<BranchOpInterface>(predTerminator);
+        for (unsigned i = 0; i < predTerminator->getNumSuccessors(); ++i) {
+          if (predTerminator->getSuccessor(i) != &block || !branchOp) continue;
+          auto operands = branchOp.getSuccessorOperands(i);
+          if (!operands.hasValue()) continue;
+          for (auto operand : operands.getValue()) {
+            if (!passedValues.insert(operand).second && isRefValue(operand) &&
+                !liveInSet.count(operand)) {
+              // Refs passed more than once are retained by each remapping and
+              // the source register may keep the value alive.
+              allReleased = false;
+            }
+          }
+        }
+        llvm::SetVector<Value> predLiveOuts;
+        for (auto *successor : predTerminator->getSuccessors()) {
+          for (auto value : liveness.getBlockLiveIns(successor)) {
+            predLiveOuts.insert(value);
+          }
+        }
+        for (auto operand : predTerminator->getOperands()) {
+          predLiveOuts.insert(operand);
+        }
+        for (auto value : predLiveOuts) {
+          if (!isRefValue(value) || liveInSet.count(value) ||
+              passedValues.count(value)) {
+            continue;
+          }
+          if (domInfo.properlyDominates(value, &block.front())) {
+            entryValues.insert(value);
+          } else {
+            allReleased = false;
+          }
+        }
+      }
+      if (!entryValues.empty()) {
+        blockDiscards.push_back(
+            {&block, SmallVector<Value, 4>(entryValues.begin(),
+                                           entryValues.end())});
+      }
+
+      for (auto &op : block.without_terminator()) {
+        llvm::SetVector<Value> deadValues;
+        if (!consumesMovedRefs(&op, symbolTable)) {
+          for (auto operand : op.getOperands()) {
+            if (isRefValue(operand) && liveness.isLastValueUse(operand, &op)) {
+              deadValues.insert(operand);
+            }
+          }
+        }
+        for (auto result : op.getResults()) {
+          if (isRefValue(result) && result.use_empty()) {
+            deadValues.insert(result);
+          }
+        }
+        if (!deadValues.empty()) {
+          opDiscards.push_back(
+              {&op, SmallVector<Value, 4>(deadValues.begin(),
+                                          deadValues.end())});
+        }
+      }
+    }
+
+    for (auto &blockDiscard : blockDiscards) {
+      auto builder = OpBuilder::atBlockBegin(blockDiscard.first);
+      builder.create<DiscardRefsOp>(funcOp.getLoc(), blockDiscard.second);
+    }
+    for (auto &opDiscard : opDiscards) {
+      OpBuilder builder(opDiscard.first->getContext());
+      builder.setInsertionPointAfter(opDiscard.first);
+      builder.create<DiscardRefsOp>(opDiscard.first->getLoc(),
+                                    opDiscard.second);
+    }
+
+    if (allReleased) {
+      funcOp->setAttr("vm.no_live_refs_at_return",
+                      UnitAttr::get(funcOp.getContext()));
+    } else {
+      funcOp->removeAttr("vm.no_live_refs_at_return");
+    }
+    return success();
+  }
+};
+
+std::unique_ptr<OperationPass<ModuleOp>> createDiscardRefsPass() {
+  return std::make_unique<DiscardRefsPass>();
+}
+
+static PassRegistration<DiscardRefsPass> pass(
+    "iree-vm-discard-refs",
+    "Releases ref values at their last use with vm.discard.refs.");
+
+}  // namespace VM
+}  // namespace IREE
+}  // namespace iree_compiler
+}  // namespace mlir
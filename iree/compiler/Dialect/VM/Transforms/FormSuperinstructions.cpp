@@ -0,0 +1,90 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/compiler/Dialect/VM/IR/VMOps.h"
+#include "iree/compiler/Dialect/VM/Transforms/Passes.h"
+#include "llvm/ADT/SmallVector.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Pass/PassRegistry.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+
+namespace mlir {
+namespace iree_compiler {
+namespace IREE {
+namespace VM {
+
+// Replaces |condBranchOp| with a fused FusedOpT if its condition is produced by
+// a CmpOpT that has no other uses.
+template <typename CmpOpT, typename FusedOpT>
+static bool tryFuseCompareBranch(CondBranchOp condBranchOp) {
+  auto cmpOp = condBranchOp.getCondition().getDefiningOp<CmpOpT>();
+  if (!cmpOp || !cmpOp.getResult().hasOneUse()) return false;
+  OpBuilder builder(condBranchOp);
+  builder.create<FusedOpT>(
+      builder.getFusedLoc({cmpOp.getLoc(), condBranchOp.getLoc()}),
+      cmpOp.lhs(), cmpOp.rhs(), condBranchOp.getTrueDest(),
+      condBranchOp.getTrueOperands(), condBranchOp.getFalseDest(),
+      condBranchOp.getFalseOperands());
+  condBranchOp.erase();
+  cmpOp.erase();
+  return true;
+}
+
+// vm.cmp.*.i32 + vm.cond_br -> vm.cond_br.cmp.*.i32
+static void fuseCompareBranch(CondBranchOp condBranchOp) {
+  if (tryFuseCompareBranch<CmpEQI32Op, CondBranchCmpEQI32Op>(condBranchOp)) {
+    return;
+  } else if (tryFuseCompareBranch<CmpNEI32Op, CondBranchCmpNEI32Op>(
+                 condBranchOp)) {
+    return;
+  } else if (tryFuseCompareBranch<CmpLTI32SOp, CondBranchCmpLTI32SOp>(
+                 condBranchOp)) {
+    return;
+  }
+  tryFuseCompareBranch<CmpLTI32UOp, CondBranchCmpLTI32UOp>(condBranchOp);
+}
+
+// Fuses common op sequences into superinstructions that perform the same work
+// with a single dispatch. These ops only exist in the bytecode and are formed
+// late in serialization such that other passes and targets need not know
+// about them.
+class FormSuperinstructionsPass
+    : public PassWrapper<FormSuperinstructionsPass, OperationPass<ModuleOp>> {
+ public:
+  void runOnOperation() override {
+    SmallVector<CondBranchOp, 8> condBranchOps;
+    getOperation().walk([&](CondBranchOp condBranchOp) {
+      condBranchOps.push_back(condBranchOp);
+    });
+    for (auto condBranchOp : condBranchOps) {
+      fuseCompareBranch(condBranchOp);
+    }
+  }
+};
+
+std::unique_ptr<OperationPass<ModuleOp>> createFormSuperinstructionsPass() {
+  return std::make_unique<FormSuperinstructionsPass>();
+}
+
+static PassRegistration<FormSuperinstructionsPass> pass(
+    "iree-vm-form-superinstructions",
+    "Fuses common op sequences into single bytecode superinstructions.");
+
+}  // namespace VM
+}  // namespace IREE
+}  // namespace iree_compiler
+}  // namespace mlir
@@ -90,6 +90,16 @@ createOrdinalAllocationPass();
 // number of live registers at the cost of additional storage requirements.
 std::unique_ptr<OperationPass<IREE::VM::ModuleOp>> createSinkDefiningOpsPass();
 
+// Fuses common op sequences (such as a comparison feeding a conditional branch)
+// into superinstructions that execute with a single bytecode dispatch.
+std::unique_ptr<OperationPass<IREE::VM::ModuleOp>>
+createFormSuperinstructionsPass();
+
+// Inserts vm.discard.refs ops to release ref values at their last use and marks
+// functions that have no live refs when they return.
+// This must run after all other optimizations as it depends on final liveness.
+std::unique_ptr<OperationPass<IREE::VM::ModuleOp>> createDiscardRefsPass();
+
 //===----------------------------------------------------------------------===//
 // Test passes
 //===----------------------------------------------------------------------===//
@@ -109,6 +119,8 @@ inline void registerVMPasses() {
   createGlobalInitializationPass();
   createOrdinalAllocationPass();
   createSinkDefiningOpsPass();
+  createDiscardRefsPass();
+  createFormSuperinstructionsPass();
 }
 
 inline void registerVMTestPasses() {
@@ -0,0 +1,99 @@
+// RUN: iree-opt -split-input-file -iree-vm-discard-refs %s | IreeFileCheck %s
+
+vm.module @module {
+  // CHECK-LABEL: @last_use_in_block
+  // CHECK-SAME: attributes {vm.no_live_refs_at_return}
+  vm.func @last_use_in_block(%arg0 : i32) -> i32 {
+    // CHECK: %list = vm.list.alloc
+    %list = vm.list.alloc %arg0 : (i32) -> !vm.list<i32>
+    // CHECK-NEXT: vm.list.reserve %list
+    vm.list.reserve %list, %arg0 : (!vm.list<i32>, i32)
+    // CHECK-NEXT: %[[SIZE:.+]] = vm.list.size %list
+    // CHECK-NEXT: vm.discard.refs %list : !vm.list<i32>
+    %0 = vm.list.size %list : (!vm.list<i32>) -> i32
+    // CHECK-NEXT: vm.return %[[SIZE]]
+    vm.return %0 : i32
+  }
+}
+
+// -----
+
+vm.module @module {
+  // CHECK-LABEL: @unused_values
+  // CHECK-SAME: attributes {vm.no_live_refs_at_return}
+  vm.func @unused_values(%arg0 : !vm.ref<?>, %arg1 : i32) {
+    // CHECK-NEXT: vm.discard.refs %arg0 : !vm.ref<?>
+    // CHECK-NEXT: %list = vm.list.alloc
+    // CHECK-NEXT: vm.discard.refs %list : !vm.list<i32>
+    %list = vm.list.alloc %arg1 : (i32) -> !vm.list<i32>
+    // CHECK-NEXT: vm.return
+    vm.return
+  }
+}
+
+// -----
+
+vm.module @module {
+  vm.import @import_fn(%arg0 : !vm.ref<?>) -> i32
+  vm.func @internal_fn(%arg0 : !vm.ref<?>) -> i32 {
+    %c1 = vm.const.i32 1 : i32
+    vm.return %c1 : i32
+  }
+
+  // Imports only borrow their arguments while internal calls move them.
+  // CHECK-LABEL: @calls
+  vm.func @calls(%arg0 : !vm.ref<?>, %arg1 : !vm.ref<?>) -> i32 {
+    // CHECK-NEXT: %[[R0:.+]] = vm.call @import_fn(%arg0)
+    // CHECK-NEXT: vm.discard.refs %arg0 : !vm.ref<?>
+    %0 = vm.call @import_fn(%arg0) : (!vm.ref<?>) -> i32
+    // CHECK-NEXT: %[[R1:.+]] = vm.call @internal_fn(%arg1)
+    // CHECK-NOT: vm.discard.refs
+    %1 = vm.call @internal_fn(%arg1) : (!vm.ref<?>) -> i32
+    // CHECK: vm.add.i32 %[[R0]], %[[R1]]
+    %2 = vm.add.i32 %0, %1 : i32
+    vm.return %2 : i32
+  }
+}
+
+// -----
+
+vm.module @module {
+  // Values live out of the entry block but dead on one path are released on
+  // entry to the successor that no longer needs them.
+  // CHECK-LABEL: @dead_on_branch
+  // CHECK-SAME: attributes {vm.no_live_refs_at_return}
+  vm.func @dead_on_branch(%arg0 : i32, %arg1 : !vm.ref<?>) -> !vm.ref<?> {
+    // CHECK: vm.cond_br %arg0, ^bb1, ^bb2
+    vm.cond_br %arg0, ^bb1, ^bb2
+  ^bb1:
+    // CHECK: ^bb1:
+    // CHECK-NEXT: vm.return %arg1 : !vm.ref<?>
+    vm.return %arg1 : !vm.ref<?>
+  ^bb2:
+    // CHECK: ^bb2:
+    // CHECK-NEXT: vm.discard.refs %arg1 : !vm.ref<?>
+    // CHECK-NEXT: vm.const.ref.zero
+    %null = vm.const.ref.zero : !vm.ref<?>
+    vm.return %null : !vm.ref<?>
+  }
+}
+
+// -----
+
+vm.module @module {
+  // Values defined in a block that does not dominate the successor they die in
+  // are left for the frame cleanup.
+  // CHECK-LABEL: @non_dominating
+  // CHECK-NOT: vm.no_live_refs_at_return
+  vm.func @non_dominating(%arg0 : i32, %arg1 : i32) -> i32 {
+    vm.cond_br %arg0, ^bb1, ^bb3
+  ^bb1:
+    %list = vm.list.alloc %arg0 : (i32) -> !vm.list<i32>
+    vm.cond_br %arg1, ^bb2, ^bb3
+  ^bb2:
+    %size = vm.list.size %list : (!vm.list<i32>) -> i32
+    vm.return %size : i32
+  ^bb3:
+    vm.return %arg0 : i32
+  }
+}
@@ -0,0 +1,58 @@
+// RUN: iree-opt -split-input-file -iree-vm-form-superinstructions %s | IreeFileCheck %s
+
+vm.module @module {
+  // CHECK-LABEL: @loop
+  vm.func @loop(%count : i32) -> i32 {
+    %c1 = vm.const.i32 1 : i32
+    %i0 = vm.const.i32.zero : i32
+    vm.br ^loop(%i0 : i32)
+  ^loop(%i : i32):
+    %in = vm.add.i32 %i, %c1 : i32
+    // CHECK-NOT: vm.cmp.lt.i32.s
+    // CHECK: vm.cond_br.cmp.lt.i32.s %[[IN:.+]], %arg0, ^bb1(%[[IN]] : i32), ^bb2(%[[IN]] : i32)
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in : i32), ^loop_exit(%in : i32)
+  ^loop_exit(%ie : i32):
+    vm.return %ie : i32
+  }
+}
+
+// -----
+
+vm.module @module {
+  // CHECK-LABEL: @predicates
+  vm.func @predicates(%arg0 : i32, %arg1 : i32) -> i32 {
+    // CHECK: vm.cond_br.cmp.eq.i32 %arg0, %arg1, ^bb1, ^bb4
+    %eq = vm.cmp.eq.i32 %arg0, %arg1 : i32
+    vm.cond_br %eq, ^bb1, ^bb4
+  ^bb1:
+    // CHECK: vm.cond_br.cmp.ne.i32 %arg0, %arg1, ^bb2, ^bb4
+    %ne = vm.cmp.ne.i32 %arg0, %arg1 : i32
+    vm.cond_br %ne, ^bb2, ^bb4
+  ^bb2:
+    // CHECK: vm.cond_br.cmp.lt.i32.u %arg0, %arg1, ^bb3, ^bb4
+    %lt = vm.cmp.lt.i32.u %arg0, %arg1 : i32
+    vm.cond_br %lt, ^bb3, ^bb4
+  ^bb3:
+    vm.return %arg0 : i32
+  ^bb4:
+    vm.return %arg1 : i32
+  }
+}
+
+// -----
+
+vm.module @module {
+  // Comparisons with other uses must be preserved.
+  // CHECK-LABEL: @multiple_uses
+  vm.func @multiple_uses(%arg0 : i32, %arg1 : i32) -> i32 {
+    // CHECK: %[[CMP:.+]] = vm.cmp.eq.i32 %arg0, %arg1
+    %eq = vm.cmp.eq.i32 %arg0, %arg1 : i32
+    // CHECK-NEXT: vm.cond_br %[[CMP]], ^bb1, ^bb2
+    vm.cond_br %eq, ^bb1, ^bb2
+  ^bb1:
+    vm.return %eq : i32
+  ^bb2:
+    vm.return %arg1 : i32
+  }
+}
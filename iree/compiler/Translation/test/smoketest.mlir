@@ -17,6 +17,7 @@ func @func(%arg0 : i32) -> i32 attributes { iree.module.export } {
 // CHECK-NEXT:   "bytecode_length": 5
 // CHECK-NEXT:   "i32_register_count": 1
 // CHECK-NEXT:   "ref_register_count": 0
+// CHECK-NEXT:   "flags":
 // CHECK-NEXT: }
 // CHECK: "bytecode_data": [
 // CHECK-NEXT:   84,
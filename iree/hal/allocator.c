@@ -28,6 +28,13 @@ iree_hal_allocator_host_allocator(const iree_hal_allocator_t* allocator) {
   return _VTABLE_DISPATCH(allocator, host_allocator)(allocator);
 }
 
+IREE_API_EXPORT iree_device_size_t IREE_API_CALL
+iree_hal_allocator_query_buffer_alignment(
+    const iree_hal_allocator_t* allocator) {
+  IREE_ASSERT_ARGUMENT(allocator);
+  return _VTABLE_DISPATCH(allocator, query_buffer_alignment)(allocator);
+}
+
 IREE_API_EXPORT iree_hal_buffer_compatibility_t
 iree_hal_allocator_query_buffer_compatibility(
     iree_hal_allocator_t* allocator, iree_hal_memory_type_t memory_type,
@@ -89,6 +89,14 @@ iree_hal_allocator_query_buffer_compatibility(
     iree_hal_buffer_usage_t allowed_usage,
     iree_hal_buffer_usage_t intended_usage, iree_device_size_t allocation_size);
 
+// Returns the minimum alignment in bytes of the contents of buffers allocated
+// from the allocator. Buffers created with iree_hal_allocator_wrap_buffer
+// are only as aligned as the memory provided by the caller; callers wrapping
+// memory that may be used in dispatches should check it against this value.
+IREE_API_EXPORT iree_device_size_t IREE_API_CALL
+iree_hal_allocator_query_buffer_alignment(
+    const iree_hal_allocator_t* allocator);
+
 // Allocates a buffer from the allocator.
 // Fails if the memory type requested for the given usage cannot be serviced.
 // Callers can use iree_hal_allocator_can_allocate to decide their memory use
@@ -126,15 +134,136 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_hal_allocator_wrap_buffer(
 // iree_hal_heap_allocator_t
 //===----------------------------------------------------------------------===//
 
+// Default minimum alignment in bytes of heap buffer contents.
+// 64 bytes covers a cache line and the widest (AVX-512) vector loads.
+#if !defined(IREE_HAL_HEAP_BUFFER_ALIGNMENT)
+#define IREE_HAL_HEAP_BUFFER_ALIGNMENT 64
+#endif  // !IREE_HAL_HEAP_BUFFER_ALIGNMENT
+
+// Options controlling an iree_hal_heap_allocator_t.
+// Must be initialized with iree_hal_heap_allocator_options_initialize prior to
+// use.
+typedef struct {
+  // Minimum alignment in bytes of all buffer contents.
+  // Must be a power of two.
+  iree_host_size_t min_alignment;
+
+  // Alignment in bytes of buffers that are at least this large, or 0 to align
+  // all buffers to |min_alignment|. Use the page size (4096) or transparent
+  // huge page size (2MB) to allow the system to back large tensors with fewer
+  // pages. Must be a power of two >= min_alignment.
+  iree_host_size_t large_alignment;
+} iree_hal_heap_allocator_options_t;
+
+// Initializes |out_options| to default values.
+IREE_API_EXPORT void IREE_API_CALL iree_hal_heap_allocator_options_initialize(
+    iree_hal_heap_allocator_options_t* out_options);
+
 // Creates a host-local heap allocator that can be used when buffers are
 // required that will not interact with a real hardware device (such as those
 // used in file IO or tests). Buffers allocated with this will not be compatible
 // with real device allocators and will likely incur a copy (or failure) if
 // used.
+//
+// Buffer contents are aligned to IREE_HAL_HEAP_BUFFER_ALIGNMENT. Wrapped host
+// memory keeps whatever alignment the caller provides.
 IREE_API_EXPORT iree_status_t IREE_API_CALL iree_hal_allocator_create_heap(
     iree_string_view_t identifier, iree_allocator_t host_allocator,
     iree_hal_allocator_t** out_allocator);
 
+// Creates a host-local heap allocator as with iree_hal_allocator_create_heap
+// with buffer contents aligned as specified in |options|.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_hal_allocator_create_heap_with_options(
+    iree_string_view_t identifier,
+    const iree_hal_heap_allocator_options_t* options,
+    iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator);
+
+//===----------------------------------------------------------------------===//
+// iree_hal_pooling_allocator_t
+//===----------------------------------------------------------------------===//
+
+enum iree_hal_pooling_allocator_flags_e {
+  IREE_HAL_POOLING_ALLOCATOR_FLAG_NONE = 0u,
+
+  // Backs pooled blocks of at least 2MB with anonymous memory mappings that
+  // request huge pages from the system (MAP_HUGETLB, falling back to
+  // madvise(MADV_HUGEPAGE)) and wraps them with the base allocator. This
+  // reduces TLB pressure and the number of page faults taken when large
+  // buffers are first touched. The base allocator must support wrapping host
+  // memory. Only available on Linux/Android.
+  IREE_HAL_POOLING_ALLOCATOR_FLAG_HUGE_PAGES = 1u << 0,
+};
+typedef uint32_t iree_hal_pooling_allocator_flags_t;
+
+// Options controlling an iree_hal_pooling_allocator_t.
+// Must be initialized with iree_hal_pooling_allocator_options_initialize prior
+// to use.
+typedef struct {
+  iree_hal_pooling_allocator_flags_t flags;
+
+  // Smallest block size in bytes. Smaller allocations are rounded up to this.
+  // Must be a power of two >= 64.
+  iree_host_size_t min_block_size;
+
+  // Largest block size in bytes. Larger allocations are made directly from
+  // the base allocator and are not pooled. Must be a power of two >=
+  // min_block_size.
+  iree_host_size_t max_block_size;
+
+  // Maximum total size of the blocks retained for reuse, or 0 for unlimited.
+  // Blocks released while the pool is at capacity are freed immediately.
+  iree_host_size_t max_cached_size;
+} iree_hal_pooling_allocator_options_t;
+
+// Initializes |out_options| to default values.
+IREE_API_EXPORT void IREE_API_CALL
+iree_hal_pooling_allocator_options_initialize(
+    iree_hal_pooling_allocator_options_t* out_options);
+
+// Statistics of an iree_hal_pooling_allocator_t.
+typedef struct {
+  // Total size of pooled blocks currently held by users.
+  iree_host_size_t bytes_in_use;
+  // Peak value of bytes_in_use.
+  iree_host_size_t bytes_in_use_high_water_mark;
+  // Total size of blocks retained for reuse.
+  iree_host_size_t bytes_cached;
+  // Total number of buffers allocated through the pool.
+  uint64_t allocation_count;
+  // Number of allocations served from a retained block.
+  uint64_t reuse_count;
+  // Number of allocations made from the base allocator, including those too
+  // large to pool.
+  uint64_t base_allocation_count;
+} iree_hal_pooling_allocator_statistics_t;
+
+// Creates an allocator that pools buffers from |base_allocator|.
+// Allocations are rounded up to size classes spaced at quarter steps between
+// powers of two and the blocks backing released buffers are retained and
+// reused for later allocations of the same size class. In steady state - such
+// as repeated invocations of the same program - no allocations are made from
+// the base allocator.
+//
+// The contents of buffers allocated from the pool are undefined and callers
+// must not assume they are zeroed. All buffers must be released prior to the
+// base allocator being destroyed.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_hal_allocator_create_pooling(
+    iree_hal_allocator_t* base_allocator,
+    const iree_hal_pooling_allocator_options_t* options,
+    iree_hal_allocator_t** out_allocator);
+
+// Frees all blocks retained for reuse by the pooling |allocator|.
+// Buffers that are in use are unaffected.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_hal_pooling_allocator_trim(iree_hal_allocator_t* allocator);
+
+// Queries the current statistics of the pooling |allocator|.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_hal_pooling_allocator_query_statistics(
+    iree_hal_allocator_t* allocator,
+    iree_hal_pooling_allocator_statistics_t* out_statistics);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_allocator_t implementation details
 //===----------------------------------------------------------------------===//
@@ -148,6 +277,9 @@ typedef struct {
   iree_allocator_t(IREE_API_PTR* host_allocator)(
       const iree_hal_allocator_t* allocator);
 
+  iree_device_size_t(IREE_API_PTR* query_buffer_alignment)(
+      const iree_hal_allocator_t* allocator);
+
   iree_hal_buffer_compatibility_t(IREE_API_PTR* query_buffer_compatibility)(
       iree_hal_allocator_t* allocator, iree_hal_memory_type_t memory_type,
       iree_hal_buffer_usage_t allowed_usage,
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string.h>
+
 #include "iree/base/tracing.h"
 #include "iree/hal/allocator.h"
 #include "iree/hal/detail.h"
@@ -19,15 +21,67 @@
 typedef struct iree_hal_heap_allocator_s {
   iree_hal_resource_t resource;
   iree_allocator_t host_allocator;
+  iree_hal_heap_allocator_options_t options;
   iree_string_view_t identifier;
 } iree_hal_heap_allocator_t;
 
+// Stored immediately prior to the aligned contents of each heap buffer so that
+// the original host allocation can be recovered when the buffer is freed.
+typedef struct {
+  iree_allocator_t host_allocator;
+  void* base_ptr;
+} iree_hal_heap_allocation_header_t;
+
 static const iree_hal_allocator_vtable_t iree_hal_heap_allocator_vtable;
 
+IREE_API_EXPORT void IREE_API_CALL iree_hal_heap_allocator_options_initialize(
+    iree_hal_heap_allocator_options_t* out_options) {
+  IREE_ASSERT_ARGUMENT(out_options);
+  memset(out_options, 0, sizeof(*out_options));
+  out_options->min_alignment = IREE_HAL_HEAP_BUFFER_ALIGNMENT;
+  out_options->large_alignment = 0;
+}
+
+static bool iree_hal_heap_is_power_of_two(iree_host_size_t value) {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+static iree_status_t iree_hal_heap_allocator_options_verify(
+    const iree_hal_heap_allocator_options_t* options) {
+  if (!iree_hal_heap_is_power_of_two(options->min_alignment)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "min_alignment must be a power of two (got %zu)",
+                            options->min_alignment);
+  }
+  if (options->large_alignment != 0 &&
+      (!iree_hal_heap_is_power_of_two(options->large_alignment) ||
+       options->large_alignment < options->min_alignment)) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "large_alignment must be a power of two >= min_alignment (got %zu)",
+        options->large_alignment);
+  }
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT iree_status_t IREE_API_CALL iree_hal_allocator_create_heap(
     iree_string_view_t identifier, iree_allocator_t host_allocator,
     iree_hal_allocator_t** out_allocator) {
+  iree_hal_heap_allocator_options_t options;
+  iree_hal_heap_allocator_options_initialize(&options);
+  return iree_hal_allocator_create_heap_with_options(
+      identifier, &options, host_allocator, out_allocator);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_hal_allocator_create_heap_with_options(
+    iree_string_view_t identifier,
+    const iree_hal_heap_allocator_options_t* options,
+    iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator) {
+  IREE_ASSERT_ARGUMENT(options);
   IREE_ASSERT_ARGUMENT(out_allocator);
+  *out_allocator = NULL;
+  IREE_RETURN_IF_ERROR(iree_hal_heap_allocator_options_verify(options));
   IREE_TRACE_ZONE_BEGIN(z0);
 
   iree_hal_heap_allocator_t* allocator = NULL;
@@ -38,6 +92,7 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_hal_allocator_create_heap(
     iree_hal_resource_initialize(&iree_hal_heap_allocator_vtable,
                                  &allocator->resource);
     allocator->host_allocator = host_allocator;
+    allocator->options = *options;
     iree_string_view_append_to_buffer(
         identifier, &allocator->identifier,
         (char*)allocator + total_size - identifier.size);
@@ -45,7 +100,7 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_hal_allocator_create_heap(
   }
 
   IREE_TRACE_ZONE_END(z0);
-  return iree_ok_status();
+  return status;
 }
 
 static void iree_hal_heap_allocator_destroy(
@@ -67,6 +122,13 @@ static iree_allocator_t iree_hal_heap_allocator_host_allocator(
   return allocator->host_allocator;
 }
 
+static iree_device_size_t iree_hal_heap_allocator_query_buffer_alignment(
+    const iree_hal_allocator_t* base_allocator) {
+  iree_hal_heap_allocator_t* allocator =
+      (iree_hal_heap_allocator_t*)base_allocator;
+  return allocator->options.min_alignment;
+}
+
 static iree_hal_buffer_compatibility_t
 iree_hal_heap_allocator_query_buffer_compatibility(
     iree_hal_allocator_t* base_allocator, iree_hal_memory_type_t memory_type,
@@ -116,6 +178,44 @@ static iree_status_t iree_hal_heap_allocator_make_compatible(
   return iree_ok_status();
 }
 
+// Frees heap buffer contents allocated by
+// iree_hal_heap_allocator_allocate_aligned. Used as the data allocator of
+// heap buffers so that the buffer need not know about the over-allocation.
+static void iree_hal_heap_allocator_free_aligned(void* self, void* ptr) {
+  iree_hal_heap_allocation_header_t header;
+  memcpy(&header, (uint8_t*)ptr - sizeof(header), sizeof(header));
+  iree_allocator_free(header.host_allocator, header.base_ptr);
+}
+
+// Allocates |allocation_size| bytes from the host allocator aligned to
+// |alignment| by over-allocating and storing the original pointer in a header
+// immediately preceding the returned pointer.
+static iree_status_t iree_hal_heap_allocator_allocate_aligned(
+    iree_allocator_t host_allocator, iree_host_size_t alignment,
+    iree_host_size_t allocation_size, void** out_ptr) {
+  *out_ptr = NULL;
+  const iree_host_size_t overhead =
+      sizeof(iree_hal_heap_allocation_header_t) + alignment - 1;
+  if (allocation_size > IREE_MAX_HOST_SIZE - overhead) {
+    return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                            "allocation size %zu overflows with alignment %zu",
+                            allocation_size, alignment);
+  }
+  void* base_ptr = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      host_allocator, allocation_size + overhead, &base_ptr));
+  uintptr_t aligned_ptr = iree_math_align(
+      (uintptr_t)base_ptr + sizeof(iree_hal_heap_allocation_header_t),
+      alignment);
+  iree_hal_heap_allocation_header_t header = {
+      .host_allocator = host_allocator,
+      .base_ptr = base_ptr,
+  };
+  memcpy((uint8_t*)aligned_ptr - sizeof(header), &header, sizeof(header));
+  *out_ptr = (void*)aligned_ptr;
+  return iree_ok_status();
+}
+
 static iree_status_t iree_hal_heap_allocator_allocate_buffer(
     iree_hal_allocator_t* base_allocator, iree_hal_memory_type_t memory_type,
     iree_hal_buffer_usage_t allowed_usage, iree_host_size_t allocation_size,
@@ -128,17 +228,31 @@ static iree_status_t iree_hal_heap_allocator_allocate_buffer(
   IREE_RETURN_IF_ERROR(iree_hal_heap_allocator_make_compatible(
       &memory_type, &allowed_access, &allowed_usage));
 
+  // Large buffers get the (likely page-sized) large alignment so that they
+  // can be backed by fewer pages.
+  iree_host_size_t alignment = allocator->options.min_alignment;
+  if (allocator->options.large_alignment &&
+      allocation_size >= allocator->options.large_alignment) {
+    alignment = allocator->options.large_alignment;
+  }
+
   iree_byte_span_t data = iree_make_byte_span(NULL, allocation_size);
+  iree_allocator_t data_allocator = {
+      .self = NULL,
+      .alloc = NULL,
+      .free = iree_hal_heap_allocator_free_aligned,
+  };
   if (allocation_size > 0) {
     // Zero-length buffers are valid but we don't want to try to malloc them.
-    IREE_RETURN_IF_ERROR(iree_allocator_malloc(
-        allocator->host_allocator, allocation_size, (void**)&data.data));
+    IREE_RETURN_IF_ERROR(iree_hal_heap_allocator_allocate_aligned(
+        allocator->host_allocator, alignment, allocation_size,
+        (void**)&data.data));
   }
   iree_status_t status = iree_hal_heap_buffer_wrap(
       base_allocator, memory_type, allowed_access, allowed_usage,
-      allocation_size, data, allocator->host_allocator, out_buffer);
+      allocation_size, data, data_allocator, out_buffer);
   if (!iree_status_is_ok(status)) {
-    iree_allocator_free(allocator->host_allocator, data.data);
+    iree_allocator_free(data_allocator, data.data);
   }
   return status;
 }
@@ -160,6 +274,7 @@ static iree_status_t iree_hal_heap_allocator_wrap_buffer(
 static const iree_hal_allocator_vtable_t iree_hal_heap_allocator_vtable = {
     .destroy = iree_hal_heap_allocator_destroy,
     .host_allocator = iree_hal_heap_allocator_host_allocator,
+    .query_buffer_alignment = iree_hal_heap_allocator_query_buffer_alignment,
     .query_buffer_compatibility =
         iree_hal_heap_allocator_query_buffer_compatibility,
     .allocate_buffer = iree_hal_heap_allocator_allocate_buffer,
@@ -0,0 +1,132 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+
+#include "iree/hal/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+class HeapAllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    iree_hal_heap_allocator_options_initialize(&options_);
+  }
+
+  void TearDown() override { iree_hal_allocator_release(allocator_); }
+
+  iree_status_t CreateHeapWithOptions() {
+    return iree_hal_allocator_create_heap_with_options(
+        iree_make_cstring_view("heap"), &options_, iree_allocator_system(),
+        &allocator_);
+  }
+
+  void CreateHeap() { IREE_ASSERT_OK(CreateHeapWithOptions()); }
+
+  // Allocates a buffer of |size| bytes, fills it, and returns the address of
+  // its contents.
+  uintptr_t AllocateAndFill(iree_host_size_t size) {
+    iree_hal_buffer_t* buffer = nullptr;
+    IREE_CHECK_OK(iree_hal_allocator_allocate_buffer(
+        allocator_,
+        IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+        IREE_HAL_BUFFER_USAGE_ALL, size, &buffer));
+    iree_hal_buffer_mapping_t mapping;
+    IREE_CHECK_OK(iree_hal_buffer_map_range(
+        buffer, IREE_HAL_MEMORY_ACCESS_DISCARD_WRITE, 0, size, &mapping));
+    std::memset(mapping.contents.data, 0xCD, mapping.contents.data_length);
+    uintptr_t address = reinterpret_cast<uintptr_t>(mapping.contents.data);
+    iree_hal_buffer_unmap_range(&mapping);
+    iree_hal_buffer_release(buffer);
+    return address;
+  }
+
+  iree_hal_heap_allocator_options_t options_;
+  iree_hal_allocator_t* allocator_ = nullptr;
+};
+
+TEST_F(HeapAllocatorTest, InvalidOptions) {
+  options_.min_alignment = 48;
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(CreateHeapWithOptions()));
+  options_.min_alignment = 64;
+  options_.large_alignment = 32;
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(CreateHeapWithOptions()));
+}
+
+TEST_F(HeapAllocatorTest, DefaultAlignment) {
+  CreateHeap();
+  EXPECT_EQ(IREE_HAL_HEAP_BUFFER_ALIGNMENT,
+            iree_hal_allocator_query_buffer_alignment(allocator_));
+  for (iree_host_size_t size : {1, 3, 64, 1000, 4096}) {
+    EXPECT_EQ(0, AllocateAndFill(size) % IREE_HAL_HEAP_BUFFER_ALIGNMENT);
+  }
+}
+
+TEST_F(HeapAllocatorTest, MinAlignment) {
+  options_.min_alignment = 256;
+  CreateHeap();
+  EXPECT_EQ(256, iree_hal_allocator_query_buffer_alignment(allocator_));
+  for (iree_host_size_t size : {1, 17, 256, 5000}) {
+    EXPECT_EQ(0, AllocateAndFill(size) % 256);
+  }
+}
+
+TEST_F(HeapAllocatorTest, LargeAlignment) {
+  options_.large_alignment = 4096;
+  CreateHeap();
+  // Only the minimum alignment is guaranteed for all buffers.
+  EXPECT_EQ(IREE_HAL_HEAP_BUFFER_ALIGNMENT,
+            iree_hal_allocator_query_buffer_alignment(allocator_));
+  EXPECT_EQ(0, AllocateAndFill(100) % IREE_HAL_HEAP_BUFFER_ALIGNMENT);
+  EXPECT_EQ(0, AllocateAndFill(4096) % 4096);
+  EXPECT_EQ(0, AllocateAndFill(3 * 4096 + 1) % 4096);
+}
+
+// Wrapping does not require (or add) any alignment beyond what the caller
+// provides; the wrapped memory is used in place.
+TEST_F(HeapAllocatorTest, WrapUnalignedBuffer) {
+  CreateHeap();
+  alignas(16) uint8_t storage[64] = {0};
+  iree_hal_buffer_t* buffer = nullptr;
+  IREE_ASSERT_OK(iree_hal_allocator_wrap_buffer(
+      allocator_, IREE_HAL_MEMORY_TYPE_HOST_LOCAL, IREE_HAL_MEMORY_ACCESS_ALL,
+      IREE_HAL_BUFFER_USAGE_ALL,
+      iree_make_byte_span(storage + 4, sizeof(storage) - 4),
+      iree_allocator_null(), &buffer));
+  iree_hal_buffer_mapping_t mapping;
+  IREE_ASSERT_OK(iree_hal_buffer_map_range(buffer, IREE_HAL_MEMORY_ACCESS_READ,
+                                           0, IREE_WHOLE_BUFFER, &mapping));
+  EXPECT_EQ(storage + 4, mapping.contents.data);
+  iree_hal_buffer_unmap_range(&mapping);
+  iree_hal_buffer_release(buffer);
+}
+
+TEST_F(HeapAllocatorTest, PoolingPreservesAlignment) {
+  options_.min_alignment = 128;
+  CreateHeap();
+  iree_hal_pooling_allocator_options_t pool_options;
+  iree_hal_pooling_allocator_options_initialize(&pool_options);
+  iree_hal_allocator_t* pool = nullptr;
+  IREE_ASSERT_OK(
+      iree_hal_allocator_create_pooling(allocator_, &pool_options, &pool));
+  EXPECT_EQ(128, iree_hal_allocator_query_buffer_alignment(pool));
+  iree_hal_allocator_release(pool);
+}
+
+}  // namespace
@@ -0,0 +1,570 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/base/internal/math.h"
+#include "iree/base/synchronization.h"
+#include "iree/base/target_platform.h"
+#include "iree/base/tracing.h"
+#include "iree/hal/allocator.h"
+#include "iree/hal/detail.h"
+
+#if defined(IREE_PLATFORM_LINUX) || defined(IREE_PLATFORM_ANDROID)
+#include <errno.h>
+#include <sys/mman.h>
+#define IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP 1
+#endif  // IREE_PLATFORM_LINUX || IREE_PLATFORM_ANDROID
+
+// Size of the huge pages requested when the HUGE_PAGES flag is set.
+// Smaller blocks are allocated from the base allocator.
+#define IREE_HAL_POOLING_ALLOCATOR_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// Number of size classes between each power of two.
+#define IREE_HAL_POOLING_ALLOCATOR_CLASSES_PER_POW2_LOG2 2
+#define IREE_HAL_POOLING_ALLOCATOR_CLASSES_PER_POW2 \
+  (1 << IREE_HAL_POOLING_ALLOCATOR_CLASSES_PER_POW2_LOG2)
+
+typedef struct iree_hal_pooled_buffer_s iree_hal_pooled_buffer_t;
+
+typedef struct iree_hal_pooling_allocator_s {
+  iree_hal_resource_t resource;
+  iree_hal_allocator_t* base_allocator;
+  iree_hal_pooling_allocator_options_t options;
+  int min_block_size_log2;
+
+  // Guards all fields below. Buffers may be released from any thread.
+  iree_slim_mutex_t mutex;
+  iree_hal_pooling_allocator_statistics_t statistics;
+
+  // Singly-linked lists of buffers available for reuse, one per size class.
+  iree_host_size_t size_class_count;
+  iree_hal_pooled_buffer_t* free_lists[];
+} iree_hal_pooling_allocator_t;
+
+// A buffer allocated from the pool. The buffer and the block that backs it are
+// retained together in the free list of their size class while not in use so
+// that reuse requires no allocations at all.
+struct iree_hal_pooled_buffer_s {
+  iree_hal_buffer_t base;
+
+  // Next buffer in the free list of the size class. Only valid while cached.
+  iree_hal_pooled_buffer_t* next;
+  iree_host_size_t size_class;
+  iree_host_size_t block_size;
+
+  // Buffer allocated from the base allocator of block_size bytes.
+  iree_hal_buffer_t* block;
+
+  // Memory mapping backing |block| if it was allocated with huge pages.
+  void* mapping;
+  iree_host_size_t mapping_length;
+};
+
+static const iree_hal_allocator_vtable_t iree_hal_pooling_allocator_vtable;
+static const iree_hal_buffer_vtable_t iree_hal_pooled_buffer_vtable;
+
+static iree_hal_pooling_allocator_t* iree_hal_pooling_allocator_cast(
+    iree_hal_allocator_t* base_value) {
+  IREE_HAL_ASSERT_TYPE(base_value, &iree_hal_pooling_allocator_vtable);
+  return (iree_hal_pooling_allocator_t*)base_value;
+}
+
+IREE_API_EXPORT void IREE_API_CALL
+iree_hal_pooling_allocator_options_initialize(
+    iree_hal_pooling_allocator_options_t* out_options) {
+  out_options->flags = IREE_HAL_POOLING_ALLOCATOR_FLAG_NONE;
+  out_options->min_block_size = 256;
+  out_options->max_block_size = 256 * 1024 * 1024;
+  out_options->max_cached_size = 0;
+}
+
+static bool iree_hal_pooling_allocator_is_pow2(iree_host_size_t value) {
+  return value && (value & (value - 1)) == 0;
+}
+
+static iree_status_t iree_hal_pooling_allocator_check_options(
+    const iree_hal_pooling_allocator_options_t* options) {
+  if (options->min_block_size < 64 ||
+      !iree_hal_pooling_allocator_is_pow2(options->min_block_size)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "min block size must be a power of two >= 64");
+  }
+  if (options->max_block_size < options->min_block_size ||
+      !iree_hal_pooling_allocator_is_pow2(options->max_block_size)) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "max block size must be a power of two >= min block size");
+  }
+#if !defined(IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP)
+  if (iree_all_bits_set(options->flags,
+                        IREE_HAL_POOLING_ALLOCATOR_FLAG_HUGE_PAGES)) {
+    return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                            "huge pages not supported on this platform");
+  }
+#endif  // !IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_hal_allocator_create_pooling(
+    iree_hal_allocator_t* base_allocator,
+    const iree_hal_pooling_allocator_options_t* options,
+    iree_hal_allocator_t** out_allocator) {
+  IREE_ASSERT_ARGUMENT(base_allocator);
+  IREE_ASSERT_ARGUMENT(options);
+  IREE_ASSERT_ARGUMENT(out_allocator);
+  *out_allocator = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_hal_pooling_allocator_check_options(options));
+
+  int min_block_size_log2 =
+      iree_math_count_trailing_zeros_u64(options->min_block_size);
+  int max_block_size_log2 =
+      iree_math_count_trailing_zeros_u64(options->max_block_size);
+  iree_host_size_t size_class_count =
+      (max_block_size_log2 - min_block_size_log2) *
+          IREE_HAL_POOLING_ALLOCATOR_CLASSES_PER_POW2 +
+      1;
+
+  iree_hal_pooling_allocator_t* allocator = NULL;
+  iree_host_size_t total_size =
+      sizeof(*allocator) + size_class_count * sizeof(allocator->free_lists[0]);
+  iree_status_t status = iree_allocator_malloc(
+      iree_hal_allocator_host_allocator(base_allocator), total_size,
+      (void**)&allocator);
+  if (iree_status_is_ok(status)) {
+    iree_hal_resource_initialize(&iree_hal_pooling_allocator_vtable,
+                                 &allocator->resource);
+    allocator->base_allocator = base_allocator;
+    iree_hal_allocator_retain(base_allocator);
+    allocator->options = *options;
+    allocator->min_block_size_log2 = min_block_size_log2;
+    iree_slim_mutex_initialize(&allocator->mutex);
+    memset(&allocator->statistics, 0, sizeof(allocator->statistics));
+    allocator->size_class_count = size_class_count;
+    memset(allocator->free_lists, 0,
+           size_class_count * sizeof(allocator->free_lists[0]));
+    *out_allocator = (iree_hal_allocator_t*)allocator;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Returns the size class that |allocation_size| falls into and the size of the
+// blocks in that class. Classes are spaced at quarter steps between powers of
+// two starting at the minimum block size so that at most 25% of a block is
+// unused by the allocation it backs.
+static iree_host_size_t iree_hal_pooling_allocator_select_size_class(
+    const iree_hal_pooling_allocator_t* allocator,
+    iree_host_size_t allocation_size, iree_host_size_t* out_block_size) {
+  if (allocation_size <= allocator->options.min_block_size) {
+    *out_block_size = allocator->options.min_block_size;
+    return 0;
+  }
+  // 2^pow2 < allocation_size <= 2^(pow2 + 1)
+  int pow2 = 63 - iree_math_count_leading_zeros_u64(allocation_size - 1);
+  int step_log2 = pow2 - IREE_HAL_POOLING_ALLOCATOR_CLASSES_PER_POW2_LOG2;
+  iree_host_size_t step = (iree_host_size_t)1 << step_log2;
+  iree_host_size_t block_size = (allocation_size + step - 1) & ~(step - 1);
+  *out_block_size = block_size;
+  return (pow2 - allocator->min_block_size_log2 - 1) *
+             IREE_HAL_POOLING_ALLOCATOR_CLASSES_PER_POW2 +
+         (block_size >> step_log2);
+}
+
+#if defined(IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP)
+static iree_status_t iree_hal_pooling_allocator_map_huge_pages(
+    iree_host_size_t byte_length, void** out_mapping,
+    iree_host_size_t* out_mapping_length) {
+  iree_host_size_t mapping_length =
+      (byte_length + IREE_HAL_POOLING_ALLOCATOR_HUGE_PAGE_SIZE - 1) &
+      ~((iree_host_size_t)IREE_HAL_POOLING_ALLOCATOR_HUGE_PAGE_SIZE - 1);
+  void* mapping = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+  // Explicit huge pages are only available if the system has reserved them
+  // (vm.nr_hugepages) and the mapping fails otherwise.
+  mapping = mmap(NULL, mapping_length, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif  // MAP_HUGETLB
+  if (mapping == MAP_FAILED) {
+    mapping = mmap(NULL, mapping_length, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+      return iree_make_status(iree_status_code_from_errno(errno),
+                              "failed to map %zu bytes", mapping_length);
+    }
+#if defined(MADV_HUGEPAGE)
+    // Advisory only: transparent huge pages may be disabled.
+    madvise(mapping, mapping_length, MADV_HUGEPAGE);
+#endif  // MADV_HUGEPAGE
+  }
+  *out_mapping = mapping;
+  *out_mapping_length = mapping_length;
+  return iree_ok_status();
+}
+#endif  // IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP
+
+static void iree_hal_pooled_buffer_free(iree_hal_pooling_allocator_t* allocator,
+                                        iree_hal_pooled_buffer_t* buffer) {
+  iree_hal_buffer_release(buffer->block);
+#if defined(IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP)
+  if (buffer->mapping) munmap(buffer->mapping, buffer->mapping_length);
+#endif  // IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP
+  iree_allocator_free(
+      iree_hal_allocator_host_allocator(allocator->base_allocator), buffer);
+}
+
+// Allocates a new buffer and its backing block from the base allocator.
+static iree_status_t iree_hal_pooled_buffer_allocate(
+    iree_hal_pooling_allocator_t* allocator, iree_hal_memory_type_t memory_type,
+    iree_hal_buffer_usage_t allowed_usage, iree_host_size_t size_class,
+    iree_host_size_t block_size, iree_hal_pooled_buffer_t** out_buffer) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE(z0, (int64_t)block_size);
+
+  iree_hal_pooled_buffer_t* buffer = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(
+              iree_hal_allocator_host_allocator(allocator->base_allocator),
+              sizeof(*buffer), (void**)&buffer));
+  buffer->next = NULL;
+  buffer->size_class = size_class;
+  buffer->block_size = block_size;
+  buffer->block = NULL;
+  buffer->mapping = NULL;
+  buffer->mapping_length = 0;
+
+  iree_status_t status = iree_ok_status();
+#if defined(IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP)
+  if (iree_all_bits_set(allocator->options.flags,
+                        IREE_HAL_POOLING_ALLOCATOR_FLAG_HUGE_PAGES) &&
+      block_size >= IREE_HAL_POOLING_ALLOCATOR_HUGE_PAGE_SIZE) {
+    status = iree_hal_pooling_allocator_map_huge_pages(
+        block_size, &buffer->mapping, &buffer->mapping_length);
+    if (iree_status_is_ok(status)) {
+      status = iree_hal_allocator_wrap_buffer(
+          allocator->base_allocator, memory_type, IREE_HAL_MEMORY_ACCESS_ALL,
+          allowed_usage, iree_make_byte_span(buffer->mapping, block_size),
+          iree_allocator_null(), &buffer->block);
+    }
+  }
+#endif  // IREE_HAL_POOLING_ALLOCATOR_HAVE_MMAP
+  if (iree_status_is_ok(status) && !buffer->block) {
+    status = iree_hal_allocator_allocate_buffer(allocator->base_allocator,
+                                                memory_type, allowed_usage,
+                                                block_size, &buffer->block);
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_buffer = buffer;
+  } else {
+    iree_hal_pooled_buffer_free(allocator, buffer);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Frees all buffers in the NULL-terminated |list|.
+static void iree_hal_pooled_buffer_free_list(
+    iree_hal_pooling_allocator_t* allocator, iree_hal_pooled_buffer_t* list) {
+  while (list) {
+    iree_hal_pooled_buffer_t* next = list->next;
+    iree_hal_pooled_buffer_free(allocator, list);
+    list = next;
+  }
+}
+
+// Removes all buffers from the free lists and returns them as a single list.
+static iree_hal_pooled_buffer_t* iree_hal_pooling_allocator_take_all_cached(
+    iree_hal_pooling_allocator_t* allocator) {
+  iree_hal_pooled_buffer_t* list = NULL;
+  iree_slim_mutex_lock(&allocator->mutex);
+  for (iree_host_size_t i = 0; i < allocator->size_class_count; ++i) {
+    while (allocator->free_lists[i]) {
+      iree_hal_pooled_buffer_t* buffer = allocator->free_lists[i];
+      allocator->free_lists[i] = buffer->next;
+      buffer->next = list;
+      list = buffer;
+    }
+  }
+  allocator->statistics.bytes_cached = 0;
+  iree_slim_mutex_unlock(&allocator->mutex);
+  return list;
+}
+
+static void iree_hal_pooling_allocator_destroy(
+    iree_hal_allocator_t* base_allocator) {
+  iree_hal_pooling_allocator_t* allocator =
+      iree_hal_pooling_allocator_cast(base_allocator);
+  iree_hal_allocator_t* base = allocator->base_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // All buffers retain the pool so by now they have all been returned.
+  iree_hal_pooled_buffer_free_list(
+      allocator, iree_hal_pooling_allocator_take_all_cached(allocator));
+  iree_slim_mutex_deinitialize(&allocator->mutex);
+  iree_allocator_free(iree_hal_allocator_host_allocator(base), allocator);
+  iree_hal_allocator_release(base);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_hal_pooling_allocator_trim(iree_hal_allocator_t* base_allocator) {
+  IREE_ASSERT_ARGUMENT(base_allocator);
+  if (!iree_hal_resource_is(base_allocator,
+                            &iree_hal_pooling_allocator_vtable)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "allocator is not a pooling allocator");
+  }
+  iree_hal_pooling_allocator_t* allocator =
+      iree_hal_pooling_allocator_cast(base_allocator);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_pooled_buffer_free_list(
+      allocator, iree_hal_pooling_allocator_take_all_cached(allocator));
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_hal_pooling_allocator_query_statistics(
+    iree_hal_allocator_t* base_allocator,
+    iree_hal_pooling_allocator_statistics_t* out_statistics) {
+  IREE_ASSERT_ARGUMENT(base_allocator);
+  IREE_ASSERT_ARGUMENT(out_statistics);
+  if (!iree_hal_resource_is(base_allocator,
+                            &iree_hal_pooling_allocator_vtable)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "allocator is not a pooling allocator");
+  }
+  iree_hal_pooling_allocator_t* allocator =
+      iree_hal_pooling_allocator_cast(base_allocator);
+  iree_slim_mutex_lock(&allocator->mutex);
+  *out_statistics = allocator->statistics;
+  iree_slim_mutex_unlock(&allocator->mutex);
+  return iree_ok_status();
+}
+
+static iree_allocator_t iree_hal_pooling_allocator_host_allocator(
+    const iree_hal_allocator_t* base_allocator) {
+  const iree_hal_pooling_allocator_t* allocator =
+      (const iree_hal_pooling_allocator_t*)base_allocator;
+  return iree_hal_allocator_host_allocator(allocator->base_allocator);
+}
+
+static iree_device_size_t iree_hal_pooling_allocator_query_buffer_alignment(
+    const iree_hal_allocator_t* base_allocator) {
+  const iree_hal_pooling_allocator_t* allocator =
+      (const iree_hal_pooling_allocator_t*)base_allocator;
+  return iree_hal_allocator_query_buffer_alignment(allocator->base_allocator);
+}
+
+static iree_hal_buffer_compatibility_t
+iree_hal_pooling_allocator_query_buffer_compatibility(
+    iree_hal_allocator_t* base_allocator, iree_hal_memory_type_t memory_type,
+    iree_hal_buffer_usage_t allowed_usage,
+    iree_hal_buffer_usage_t intended_usage,
+    iree_device_size_t allocation_size) {
+  iree_hal_pooling_allocator_t* allocator =
+      iree_hal_pooling_allocator_cast(base_allocator);
+  return iree_hal_allocator_query_buffer_compatibility(
+      allocator->base_allocator, memory_type, allowed_usage, intended_usage,
+      allocation_size);
+}
+
+// Updates statistics for a buffer of |block_size| being allocated.
+// Must be called with the mutex held.
+static void iree_hal_pooling_allocator_note_allocation(
+    iree_hal_pooling_allocator_t* allocator, iree_host_size_t block_size) {
+  iree_hal_pooling_allocator_statistics_t* statistics = &allocator->statistics;
+  ++statistics->allocation_count;
+  statistics->bytes_in_use += block_size;
+  statistics->bytes_in_use_high_water_mark = iree_max(
+      statistics->bytes_in_use_high_water_mark, statistics->bytes_in_use);
+}
+
+static iree_status_t iree_hal_pooling_allocator_allocate_buffer(
+    iree_hal_allocator_t* base_allocator, iree_hal_memory_type_t memory_type,
+    iree_hal_buffer_usage_t allowed_usage, iree_host_size_t allocation_size,
+    iree_hal_buffer_t** out_buffer) {
+  iree_hal_pooling_allocator_t* allocator =
+      iree_hal_pooling_allocator_cast(base_allocator);
+
+  // Buffers too large to pool (and zero-length buffers, which have no storage)
+  // come directly from the base allocator.
+  if (allocation_size == 0 ||
+      allocation_size > allocator->options.max_block_size) {
+    IREE_RETURN_IF_ERROR(iree_hal_allocator_allocate_buffer(
+        allocator->base_allocator, memory_type, allowed_usage, allocation_size,
+        out_buffer));
+    iree_slim_mutex_lock(&allocator->mutex);
+    ++allocator->statistics.allocation_count;
+    ++allocator->statistics.base_allocation_count;
+    iree_slim_mutex_unlock(&allocator->mutex);
+    return iree_ok_status();
+  }
+
+  iree_host_size_t block_size = 0;
+  iree_host_size_t size_class = iree_hal_pooling_allocator_select_size_class(
+      allocator, allocation_size, &block_size);
+
+  // Take the first cached buffer in the size class that satisfies the request.
+  // Blocks are usually all allocated with the same types and usage so this
+  // rarely needs to look past the head of the list.
+  iree_hal_pooled_buffer_t* buffer = NULL;
+  iree_slim_mutex_lock(&allocator->mutex);
+  for (iree_hal_pooled_buffer_t** link = &allocator->free_lists[size_class];
+       *link; link = &(*link)->next) {
+    iree_hal_buffer_t* block = (*link)->block;
+    if (iree_all_bits_set(iree_hal_buffer_memory_type(block), memory_type) &&
+        iree_all_bits_set(iree_hal_buffer_allowed_usage(block),
+                          allowed_usage)) {
+      buffer = *link;
+      *link = buffer->next;
+      allocator->statistics.bytes_cached -= block_size;
+      ++allocator->statistics.reuse_count;
+      iree_hal_pooling_allocator_note_allocation(allocator, block_size);
+      break;
+    }
+  }
+  iree_slim_mutex_unlock(&allocator->mutex);
+
+  if (!buffer) {
+    IREE_RETURN_IF_ERROR(iree_hal_pooled_buffer_allocate(
+        allocator, memory_type, allowed_usage, size_class, block_size,
+        &buffer));
+    iree_slim_mutex_lock(&allocator->mutex);
+    ++allocator->statistics.base_allocation_count;
+    iree_hal_pooling_allocator_note_allocation(allocator, block_size);
+    iree_slim_mutex_unlock(&allocator->mutex);
+  }
+
+  iree_hal_buffer_t* block = buffer->block;
+  iree_hal_resource_initialize(&iree_hal_pooled_buffer_vtable,
+                               &buffer->base.resource);
+  buffer->base.allocator = base_allocator;
+  buffer->base.allocated_buffer = &buffer->base;
+  buffer->base.allocation_size = allocation_size;
+  buffer->base.byte_offset = 0;
+  buffer->base.byte_length = allocation_size;
+  buffer->base.memory_type = iree_hal_buffer_memory_type(block);
+  buffer->base.allowed_access = iree_hal_buffer_allowed_access(block);
+  buffer->base.allowed_usage = iree_hal_buffer_allowed_usage(block);
+  buffer->next = NULL;
+
+  // Buffers in use keep the pool alive so they have somewhere to return to.
+  iree_hal_allocator_retain(base_allocator);
+
+  *out_buffer = &buffer->base;
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_pooling_allocator_wrap_buffer(
+    iree_hal_allocator_t* base_allocator, iree_hal_memory_type_t memory_type,
+    iree_hal_memory_access_t allowed_access,
+    iree_hal_buffer_usage_t allowed_usage, iree_byte_span_t data,
+    iree_allocator_t data_allocator, iree_hal_buffer_t** out_buffer) {
+  iree_hal_pooling_allocator_t* allocator =
+      iree_hal_pooling_allocator_cast(base_allocator);
+  return iree_hal_allocator_wrap_buffer(allocator->base_allocator, memory_type,
+                                        allowed_access, allowed_usage, data,
+                                        data_allocator, out_buffer);
+}
+
+static const iree_hal_allocator_vtable_t iree_hal_pooling_allocator_vtable = {
+    .destroy = iree_hal_pooling_allocator_destroy,
+    .host_allocator = iree_hal_pooling_allocator_host_allocator,
+    .query_buffer_alignment = iree_hal_pooling_allocator_query_buffer_alignment,
+    .query_buffer_compatibility =
+        iree_hal_pooling_allocator_query_buffer_compatibility,
+    .allocate_buffer = iree_hal_pooling_allocator_allocate_buffer,
+    .wrap_buffer = iree_hal_pooling_allocator_wrap_buffer,
+};
+
+//===----------------------------------------------------------------------===//
+// iree_hal_pooled_buffer_t
+//===----------------------------------------------------------------------===//
+
+static void iree_hal_pooled_buffer_destroy(iree_hal_buffer_t* base_buffer) {
+  iree_hal_pooled_buffer_t* buffer = (iree_hal_pooled_buffer_t*)base_buffer;
+  iree_hal_pooling_allocator_t* allocator =
+      iree_hal_pooling_allocator_cast(iree_hal_buffer_allocator(base_buffer));
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  bool cached = false;
+  iree_slim_mutex_lock(&allocator->mutex);
+  allocator->statistics.bytes_in_use -= buffer->block_size;
+  if (!allocator->options.max_cached_size ||
+      allocator->statistics.bytes_cached + buffer->block_size <=
+          allocator->options.max_cached_size) {
+    buffer->next = allocator->free_lists[buffer->size_class];
+    allocator->free_lists[buffer->size_class] = buffer;
+    allocator->statistics.bytes_cached += buffer->block_size;
+    cached = true;
+  }
+  iree_slim_mutex_unlock(&allocator->mutex);
+  if (!cached) iree_hal_pooled_buffer_free(allocator, buffer);
+
+  // May destroy the pool (and with it this buffer) if this was the last user.
+  iree_hal_allocator_release((iree_hal_allocator_t*)allocator);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+static iree_status_t iree_hal_pooled_buffer_map_range(
+    iree_hal_buffer_t* base_buffer, iree_hal_mapping_mode_t mapping_mode,
+    iree_hal_memory_access_t memory_access,
+    iree_device_size_t local_byte_offset, iree_device_size_t local_byte_length,
+    void** out_data_ptr) {
+  iree_hal_pooled_buffer_t* buffer = (iree_hal_pooled_buffer_t*)base_buffer;
+  return IREE_HAL_VTABLE_DISPATCH(buffer->block, iree_hal_buffer, map_range)(
+      buffer->block, mapping_mode, memory_access, local_byte_offset,
+      local_byte_length, out_data_ptr);
+}
+
+static void iree_hal_pooled_buffer_unmap_range(
+    iree_hal_buffer_t* base_buffer, iree_device_size_t local_byte_offset,
+    iree_device_size_t local_byte_length, void* data_ptr) {
+  iree_hal_pooled_buffer_t* buffer = (iree_hal_pooled_buffer_t*)base_buffer;
+  IREE_HAL_VTABLE_DISPATCH(buffer->block, iree_hal_buffer, unmap_range)
+  (buffer->block, local_byte_offset, local_byte_length, data_ptr);
+}
+
+static iree_status_t iree_hal_pooled_buffer_invalidate_range(
+    iree_hal_buffer_t* base_buffer, iree_device_size_t local_byte_offset,
+    iree_device_size_t local_byte_length) {
+  iree_hal_pooled_buffer_t* buffer = (iree_hal_pooled_buffer_t*)base_buffer;
+  return IREE_HAL_VTABLE_DISPATCH(buffer->block, iree_hal_buffer,
+                                  invalidate_range)(
+      buffer->block, local_byte_offset, local_byte_length);
+}
+
+static iree_status_t iree_hal_pooled_buffer_flush_range(
+    iree_hal_buffer_t* base_buffer, iree_device_size_t local_byte_offset,
+    iree_device_size_t local_byte_length) {
+  iree_hal_pooled_buffer_t* buffer = (iree_hal_pooled_buffer_t*)base_buffer;
+  return IREE_HAL_VTABLE_DISPATCH(buffer->block, iree_hal_buffer, flush_range)(
+      buffer->block, local_byte_offset, local_byte_length);
+}
+
+static const iree_hal_buffer_vtable_t iree_hal_pooled_buffer_vtable = {
+    .destroy = iree_hal_pooled_buffer_destroy,
+    .map_range = iree_hal_pooled_buffer_map_range,
+    .unmap_range = iree_hal_pooled_buffer_unmap_range,
+    .invalidate_range = iree_hal_pooled_buffer_invalidate_range,
+    .flush_range = iree_hal_pooled_buffer_flush_range,
+};
@@ -0,0 +1,106 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Simulates the buffer allocation pattern of repeated inferences: each
+// iteration allocates a set of outputs and transients, touches every page of
+// them, and releases them all. The host_allocations counter reports the number
+// of host heap allocations made per inference.
+
+#include <atomic>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/hal/api.h"
+
+namespace {
+
+// Sizes of the buffers allocated in each inference.
+static const iree_host_size_t kBufferSizes[] = {
+    4 * 1024, 64 * 1024,  1000 * 1000,     4 * 1024 * 1024,
+    3 * 1024, 300 * 1000, 4 * 1024 * 1024, 16 * 1024,
+};
+
+// System allocator that counts allocations.
+static std::atomic<int64_t> host_allocation_count{0};
+static iree_status_t CountingAllocate(void* self, iree_allocation_mode_t mode,
+                                      iree_host_size_t byte_length,
+                                      void** out_ptr) {
+  ++host_allocation_count;
+  return iree_allocator_system_allocate(self, mode, byte_length, out_ptr);
+}
+static iree_allocator_t CountingAllocator() {
+  return {nullptr, CountingAllocate, iree_allocator_system_free};
+}
+
+static void RunInferences(benchmark::State& state,
+                          iree_hal_allocator_t* allocator) {
+  std::vector<iree_hal_buffer_t*> buffers(IREE_ARRAYSIZE(kBufferSizes));
+  int64_t start_count = 0;
+  int64_t iteration_count = 0;
+  for (auto _ : state) {
+    // Ignore the first iteration as it warms the pool.
+    if (iteration_count++ == 1) start_count = host_allocation_count;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      IREE_CHECK_OK(iree_hal_allocator_allocate_buffer(
+          allocator,
+          IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+          IREE_HAL_BUFFER_USAGE_ALL, kBufferSizes[i], &buffers[i]));
+      iree_hal_buffer_mapping_t mapping;
+      IREE_CHECK_OK(iree_hal_buffer_map_range(
+          buffers[i], IREE_HAL_MEMORY_ACCESS_WRITE, 0, IREE_WHOLE_BUFFER,
+          &mapping));
+      for (iree_host_size_t j = 0; j < mapping.contents.data_length;
+           j += 4096) {
+        mapping.contents.data[j] = (uint8_t)j;
+      }
+      iree_hal_buffer_unmap_range(&mapping);
+    }
+    for (auto* buffer : buffers) iree_hal_buffer_release(buffer);
+  }
+  state.counters["host_allocations"] = benchmark::Counter(
+      static_cast<double>(host_allocation_count - start_count),
+      benchmark::Counter::kAvgIterations);
+}
+
+// Baseline: every buffer is allocated from the heap.
+static void BM_HeapAllocator(benchmark::State& state) {
+  iree_hal_allocator_t* heap_allocator = nullptr;
+  IREE_CHECK_OK(iree_hal_allocator_create_heap(
+      iree_make_cstring_view("heap"), CountingAllocator(), &heap_allocator));
+  RunInferences(state, heap_allocator);
+  iree_hal_allocator_release(heap_allocator);
+}
+BENCHMARK(BM_HeapAllocator);
+
+static void BM_PoolingAllocator(benchmark::State& state) {
+  iree_hal_allocator_t* heap_allocator = nullptr;
+  IREE_CHECK_OK(iree_hal_allocator_create_heap(
+      iree_make_cstring_view("heap"), CountingAllocator(), &heap_allocator));
+  iree_hal_pooling_allocator_options_t options;
+  iree_hal_pooling_allocator_options_initialize(&options);
+  if (state.range(0)) {
+    options.flags |= IREE_HAL_POOLING_ALLOCATOR_FLAG_HUGE_PAGES;
+  }
+  iree_hal_allocator_t* allocator = nullptr;
+  IREE_CHECK_OK(
+      iree_hal_allocator_create_pooling(heap_allocator, &options, &allocator));
+  RunInferences(state, allocator);
+  iree_hal_allocator_release(allocator);
+  iree_hal_allocator_release(heap_allocator);
+}
+BENCHMARK(BM_PoolingAllocator)->ArgName("huge_pages")->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,223 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <vector>
+
+#include "iree/hal/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+class PoolingAllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    IREE_ASSERT_OK(iree_hal_allocator_create_heap(
+        iree_make_cstring_view("heap"), iree_allocator_system(),
+        &heap_allocator_));
+    iree_hal_pooling_allocator_options_initialize(&options_);
+    options_.max_block_size = 1024 * 1024;
+  }
+
+  void TearDown() override {
+    iree_hal_allocator_release(allocator_);
+    iree_hal_allocator_release(heap_allocator_);
+  }
+
+  void CreatePool() {
+    IREE_ASSERT_OK(iree_hal_allocator_create_pooling(heap_allocator_,
+                                                     &options_, &allocator_));
+  }
+
+  iree_hal_buffer_t* Allocate(iree_host_size_t size) {
+    iree_hal_buffer_t* buffer = nullptr;
+    IREE_CHECK_OK(iree_hal_allocator_allocate_buffer(
+        allocator_,
+        IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+        IREE_HAL_BUFFER_USAGE_ALL, size, &buffer));
+    return buffer;
+  }
+
+  iree_hal_pooling_allocator_statistics_t QueryStatistics() {
+    iree_hal_pooling_allocator_statistics_t statistics;
+    IREE_CHECK_OK(
+        iree_hal_pooling_allocator_query_statistics(allocator_, &statistics));
+    return statistics;
+  }
+
+  iree_hal_allocator_t* heap_allocator_ = nullptr;
+  iree_hal_pooling_allocator_options_t options_;
+  iree_hal_allocator_t* allocator_ = nullptr;
+};
+
+TEST_F(PoolingAllocatorTest, InvalidOptions) {
+  options_.min_block_size = 100;
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(iree_hal_allocator_create_pooling(
+                heap_allocator_, &options_, &allocator_)));
+  options_.min_block_size = 256;
+  options_.max_block_size = 128;
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(iree_hal_allocator_create_pooling(
+                heap_allocator_, &options_, &allocator_)));
+}
+
+TEST_F(PoolingAllocatorTest, NotAPool) {
+  iree_hal_pooling_allocator_statistics_t statistics;
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(
+                iree_hal_pooling_allocator_query_statistics(heap_allocator_,
+                                                            &statistics)));
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(
+                iree_hal_pooling_allocator_trim(heap_allocator_)));
+}
+
+// Tests that released buffers are reused by allocations of the same size class.
+TEST_F(PoolingAllocatorTest, Reuse) {
+  CreatePool();
+  iree_hal_buffer_t* buffer = Allocate(1000);
+  EXPECT_EQ(1000, iree_hal_buffer_byte_length(buffer));
+  EXPECT_EQ(allocator_, iree_hal_buffer_allocator(buffer));
+  uint32_t pattern = 0xCAFEF00Du;
+  IREE_ASSERT_OK(iree_hal_buffer_write_data(buffer, 996, &pattern, 4));
+  iree_hal_buffer_release(buffer);
+
+  auto statistics = QueryStatistics();
+  EXPECT_EQ(1, statistics.base_allocation_count);
+  EXPECT_EQ(0, statistics.bytes_in_use);
+  EXPECT_EQ(1024, statistics.bytes_cached);
+
+  // 1000 and 1001 bytes both round up to 1024.
+  buffer = Allocate(1001);
+  EXPECT_EQ(1001, iree_hal_buffer_byte_length(buffer));
+  statistics = QueryStatistics();
+  EXPECT_EQ(2, statistics.allocation_count);
+  EXPECT_EQ(1, statistics.reuse_count);
+  EXPECT_EQ(1, statistics.base_allocation_count);
+  EXPECT_EQ(1024, statistics.bytes_in_use);
+  EXPECT_EQ(0, statistics.bytes_cached);
+  iree_hal_buffer_release(buffer);
+}
+
+// Tests the quarter-step size classes.
+TEST_F(PoolingAllocatorTest, SizeClasses) {
+  CreatePool();
+  const iree_host_size_t kSizes[] = {1, 256, 257, 320, 321, 512, 513, 4096};
+  const iree_host_size_t kBlockSizes[] = {256, 256, 320, 320,
+                                          384, 512, 640, 4096};
+  for (size_t i = 0; i < IREE_ARRAYSIZE(kSizes); ++i) {
+    iree_hal_buffer_t* buffer = Allocate(kSizes[i]);
+    EXPECT_EQ(kBlockSizes[i], QueryStatistics().bytes_in_use) << kSizes[i];
+    iree_hal_buffer_release(buffer);
+  }
+}
+
+// Tests that buffers larger than the max block size are not pooled.
+TEST_F(PoolingAllocatorTest, LargeAllocationsNotPooled) {
+  CreatePool();
+  iree_hal_buffer_t* buffer = Allocate(options_.max_block_size + 1);
+  EXPECT_EQ(heap_allocator_, iree_hal_buffer_allocator(buffer));
+  iree_hal_buffer_release(buffer);
+  auto statistics = QueryStatistics();
+  EXPECT_EQ(1, statistics.base_allocation_count);
+  EXPECT_EQ(0, statistics.bytes_cached);
+}
+
+TEST_F(PoolingAllocatorTest, HighWaterMarkAndTrim) {
+  CreatePool();
+  std::vector<iree_hal_buffer_t*> buffers;
+  for (int i = 0; i < 4; ++i) buffers.push_back(Allocate(4096));
+  for (auto* buffer : buffers) iree_hal_buffer_release(buffer);
+  auto statistics = QueryStatistics();
+  EXPECT_EQ(4 * 4096, statistics.bytes_in_use_high_water_mark);
+  EXPECT_EQ(0, statistics.bytes_in_use);
+  EXPECT_EQ(4 * 4096, statistics.bytes_cached);
+
+  IREE_ASSERT_OK(iree_hal_pooling_allocator_trim(allocator_));
+  EXPECT_EQ(0, QueryStatistics().bytes_cached);
+  iree_hal_buffer_release(Allocate(4096));
+  EXPECT_EQ(5, QueryStatistics().base_allocation_count);
+}
+
+TEST_F(PoolingAllocatorTest, MaxCachedSize) {
+  options_.max_cached_size = 8192;
+  CreatePool();
+  std::vector<iree_hal_buffer_t*> buffers;
+  for (int i = 0; i < 4; ++i) buffers.push_back(Allocate(4096));
+  for (auto* buffer : buffers) iree_hal_buffer_release(buffer);
+  EXPECT_EQ(8192, QueryStatistics().bytes_cached);
+}
+
+// Tests that blocks backed by huge page mappings can be used and are recycled
+// like any other block. Skipped on platforms without mmap support.
+TEST_F(PoolingAllocatorTest, HugePages) {
+  options_.flags |= IREE_HAL_POOLING_ALLOCATOR_FLAG_HUGE_PAGES;
+  options_.max_block_size = 4 * 1024 * 1024;
+  iree_status_t status = iree_hal_allocator_create_pooling(
+      heap_allocator_, &options_, &allocator_);
+  if (iree_status_is_unavailable(status)) {
+    iree_status_ignore(status);
+    GTEST_SKIP() << "huge pages not supported on this platform";
+  }
+  IREE_ASSERT_OK(status);
+
+  const iree_host_size_t size = 2 * 1024 * 1024 + 4096;
+  iree_hal_buffer_t* buffer = Allocate(size);
+  iree_hal_buffer_mapping_t mapping;
+  IREE_ASSERT_OK(iree_hal_buffer_map_range(
+      buffer, IREE_HAL_MEMORY_ACCESS_DISCARD_WRITE, 0, size, &mapping));
+  // Blocks from the mapping start on a page boundary; heap blocks would only
+  // guarantee the heap buffer alignment.
+  uintptr_t address = reinterpret_cast<uintptr_t>(mapping.contents.data);
+  EXPECT_EQ(0, address % 4096);
+  for (iree_host_size_t i = 0; i < size; ++i) {
+    mapping.contents.data[i] = static_cast<uint8_t>(i * 7);
+  }
+  iree_hal_buffer_unmap_range(&mapping);
+  std::vector<uint8_t> contents(size);
+  IREE_ASSERT_OK(iree_hal_buffer_read_data(buffer, 0, contents.data(), size));
+  for (iree_host_size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(static_cast<uint8_t>(i * 7), contents[i]) << "at " << i;
+  }
+  iree_hal_buffer_release(buffer);
+
+  // The mapping is cached and reused instead of being unmapped.
+  buffer = Allocate(size);
+  IREE_ASSERT_OK(iree_hal_buffer_map_range(
+      buffer, IREE_HAL_MEMORY_ACCESS_READ, 0, size, &mapping));
+  EXPECT_EQ(address, reinterpret_cast<uintptr_t>(mapping.contents.data));
+  iree_hal_buffer_unmap_range(&mapping);
+  iree_hal_buffer_release(buffer);
+  auto statistics = QueryStatistics();
+  EXPECT_EQ(1, statistics.base_allocation_count);
+  EXPECT_EQ(1, statistics.reuse_count);
+}
+
+// Tests that buffers outstanding when the pool is released keep it alive.
+TEST_F(PoolingAllocatorTest, BufferOutlivesPool) {
+  CreatePool();
+  iree_hal_buffer_t* buffer = Allocate(4096);
+  iree_hal_buffer_t* subspan = nullptr;
+  IREE_ASSERT_OK(iree_hal_buffer_subspan(buffer, 1024, 1024, &subspan));
+  iree_hal_buffer_release(buffer);
+  iree_hal_allocator_release(allocator_);
+  allocator_ = nullptr;
+  uint8_t value = 5;
+  IREE_EXPECT_OK(iree_hal_buffer_write_data(subspan, 1023, &value, 1));
+  iree_hal_buffer_release(subspan);
+}
+
+}  // namespace
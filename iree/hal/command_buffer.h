@@ -43,7 +43,13 @@ enum iree_hal_command_buffer_mode_e {
   // when it's known that command buffers will not be reused.
   IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT = 1u << 0,
 
-  // TODO(benvanik): IREE_HAL_COMMAND_BUFFER_MODE_REUSABLE = 1u << 1,
+  // Command buffer may be submitted multiple times after being recorded once.
+  // Implementations may retain their recorded state across submissions such
+  // that resubmitting has little overhead. Submissions must not overlap: the
+  // command buffer may only be submitted again once all prior submissions of
+  // it have completed.
+  IREE_HAL_COMMAND_BUFFER_MODE_REUSABLE = 1u << 1,
+
   // TODO(benvanik): IREE_HAL_COMMAND_BUFFER_MODE_PRIMARY = 1u << 2,
   // TODO(benvanik): IREE_HAL_COMMAND_BUFFER_MODE_SECONDARY = 1u << 3,
 };
@@ -171,6 +177,7 @@ typedef struct {
 // TODO(benvanik): replace with tables for iree_string_builder_*.
 #define iree_hal_command_buffer_mode_string(...) "TODO"
 //    {IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT, "ONE_SHOT"},
+//    {IREE_HAL_COMMAND_BUFFER_MODE_REUSABLE, "REUSABLE"},
 #define iree_hal_command_category_string(...) "TODO"
 //    {IREE_HAL_COMMAND_CATEGORY_TRANSFER, "TRANSFER"},
 //    {IREE_HAL_COMMAND_CATEGORY_DISPATCH, "DISPATCH"},
@@ -69,6 +69,12 @@ static iree_allocator_t iree_hal_cuda_allocator_host_allocator(
   return allocator->context->host_allocator;
 }
 
+static iree_device_size_t iree_hal_cuda_allocator_query_buffer_alignment(
+    const iree_hal_allocator_t* base_allocator) {
+  // cuMemAlloc guarantees 256-byte alignment and cuMemHostAlloc returns pages.
+  return 256;
+}
+
 static iree_hal_buffer_compatibility_t
 iree_hal_cuda_allocator_query_buffer_compatibility(
     iree_hal_allocator_t* base_allocator, iree_hal_memory_type_t memory_type,
@@ -168,6 +174,7 @@ static iree_status_t iree_hal_cuda_allocator_wrap_buffer(
 const iree_hal_allocator_vtable_t iree_hal_cuda_allocator_vtable = {
     .destroy = iree_hal_cuda_allocator_destroy,
     .host_allocator = iree_hal_cuda_allocator_host_allocator,
+    .query_buffer_alignment = iree_hal_cuda_allocator_query_buffer_alignment,
     .query_buffer_compatibility =
         iree_hal_cuda_allocator_query_buffer_compatibility,
     .allocate_buffer = iree_hal_cuda_allocator_allocate_buffer,
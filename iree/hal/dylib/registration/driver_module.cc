@@ -17,6 +17,7 @@
 #include <inttypes.h>
 
 #include "absl/flags/flag.h"
+#include "iree/base/internal/numa.h"
 #include "iree/hal/local/loaders/legacy_library_loader.h"
 #include "iree/hal/local/task_driver.h"
 
@@ -31,9 +32,24 @@ ABSL_FLAG(int, dylib_worker_count, 0,
           "Specified number of workers to use or 0 for automatic.");
 ABSL_FLAG(int, dylib_max_worker_count, 16,
           "Maximum number of task system workers to use.");
+ABSL_FLAG(bool, dylib_executor_per_numa_node, false,
+          "Creates one executor and device per NUMA node with device memory "
+          "placed on the node. Worker counts and limits apply per node.");
+ABSL_FLAG(bool, dylib_pool_buffers, false,
+          "Pools device buffers for reuse across invocations instead of "
+          "allocating them from the heap each time.");
+ABSL_FLAG(int, dylib_buffer_alignment, IREE_HAL_HEAP_BUFFER_ALIGNMENT,
+          "Minimum alignment in bytes of device buffer contents.");
+ABSL_FLAG(int, dylib_large_buffer_alignment, 0,
+          "Alignment in bytes of device buffers at least this large (such as "
+          "4096 or 2097152 for huge pages) or 0 to use "
+          "--dylib_buffer_alignment for all buffers.");
 
 #define IREE_HAL_DYLIB_DRIVER_ID 0x58444C4Cu  // XDLL
 
+// Maximum number of NUMA nodes that will get their own executor.
+#define IREE_HAL_DYLIB_MAX_NUMA_NODE_COUNT 16
+
 static iree_status_t iree_hal_dylib_driver_factory_enumerate(
     void* self, const iree_hal_driver_info_t** out_driver_infos,
     iree_host_size_t* out_driver_info_count) {
@@ -50,6 +66,72 @@ static iree_status_t iree_hal_dylib_driver_factory_enumerate(
   return iree_ok_status();
 }
 
+// Creates a driver with one executor (and device) per NUMA node that has
+// processors attached. Memory-only nodes and nodes whose processors are all
+// unavailable to us (such as excluded by a cpuset) produce empty topologies
+// and are skipped.
+static iree_status_t iree_hal_dylib_driver_create_per_numa_node(
+    const iree_hal_task_device_params_t* default_params,
+    iree_allocator_t allocator, iree_hal_driver_t** out_driver) {
+  iree_numa_node_id_t node_ids[IREE_HAL_DYLIB_MAX_NUMA_NODE_COUNT];
+  iree_host_size_t node_count =
+      iree_numa_query_cpu_nodes(IREE_ARRAYSIZE(node_ids), node_ids);
+  if (node_count > IREE_ARRAYSIZE(node_ids)) {
+    return iree_make_status(
+        IREE_STATUS_OUT_OF_RANGE,
+        "system has %zu NUMA nodes with processors but at most %d are "
+        "supported with --dylib_executor_per_numa_node",
+        node_count, IREE_HAL_DYLIB_MAX_NUMA_NODE_COUNT);
+  }
+
+  // An explicit worker count replaces the automatic limit on each node.
+  int worker_count = absl::GetFlag(FLAGS_dylib_worker_count);
+  iree_host_size_t max_group_count =
+      worker_count > 0 ? worker_count
+                       : absl::GetFlag(FLAGS_dylib_max_worker_count);
+
+  iree_hal_executable_loader_t* dylib_loader = NULL;
+  iree_status_t status =
+      iree_hal_legacy_library_loader_create(allocator, &dylib_loader);
+  iree_hal_executable_loader_t* loaders[1] = {dylib_loader};
+
+  iree_task_executor_t* executors[IREE_HAL_DYLIB_MAX_NUMA_NODE_COUNT] = {NULL};
+  iree_numa_node_id_t executor_node_ids[IREE_HAL_DYLIB_MAX_NUMA_NODE_COUNT];
+  iree_host_size_t executor_count = 0;
+  for (iree_host_size_t i = 0; i < node_count && iree_status_is_ok(status);
+       ++i) {
+    iree_task_topology_t topology;
+    iree_task_topology_initialize_from_unique_l2_cache_groups_on_numa_node(
+        node_ids[i], max_group_count, &topology);
+    if (iree_task_topology_group_count(&topology) > 0) {
+      status = iree_task_executor_create(IREE_TASK_SCHEDULING_MODE_RESERVED,
+                                         &topology, allocator,
+                                         &executors[executor_count]);
+      if (iree_status_is_ok(status)) {
+        executor_node_ids[executor_count++] = node_ids[i];
+      }
+    }
+    iree_task_topology_deinitialize(&topology);
+  }
+
+  if (iree_status_is_ok(status) && !executor_count) {
+    status = iree_make_status(IREE_STATUS_UNAVAILABLE,
+                              "no NUMA node has usable processors");
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_task_driver_create_per_numa_node(
+        iree_make_cstring_view("dylib"), default_params, executor_count,
+        executors, executor_node_ids, IREE_ARRAYSIZE(loaders), loaders,
+        allocator, out_driver);
+  }
+
+  for (iree_host_size_t i = 0; i < executor_count; ++i) {
+    iree_task_executor_release(executors[i]);
+  }
+  iree_hal_executable_loader_release(dylib_loader);
+  return status;
+}
+
 static iree_status_t iree_hal_dylib_driver_factory_try_create(
     void* self, iree_hal_driver_id_t driver_id, iree_allocator_t allocator,
     iree_hal_driver_t** out_driver) {
@@ -62,6 +144,16 @@ static iree_status_t iree_hal_dylib_driver_factory_try_create(
 
   iree_hal_task_device_params_t default_params;
   iree_hal_task_device_params_initialize(&default_params);
+  default_params.pool_buffers = absl::GetFlag(FLAGS_dylib_pool_buffers);
+  default_params.heap_options.min_alignment =
+      absl::GetFlag(FLAGS_dylib_buffer_alignment);
+  default_params.heap_options.large_alignment =
+      absl::GetFlag(FLAGS_dylib_large_buffer_alignment);
+
+  if (absl::GetFlag(FLAGS_dylib_executor_per_numa_node)) {
+    return iree_hal_dylib_driver_create_per_numa_node(&default_params,
+                                                      allocator, out_driver);
+  }
 
   iree_task_topology_t topology;
   iree_task_topology_initialize(&topology);
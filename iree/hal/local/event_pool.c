@@ -51,6 +51,7 @@ iree_status_t iree_hal_local_event_pool_allocate(
       z0,
       iree_allocator_malloc(host_allocator, total_size, (void**)&event_pool));
   event_pool->host_allocator = host_allocator;
+  iree_slim_mutex_initialize(&event_pool->mutex);
   event_pool->available_capacity = available_capacity;
   event_pool->available_count = 0;
 
@@ -58,8 +59,9 @@ iree_status_t iree_hal_local_event_pool_allocate(
   for (iree_host_size_t i = 0; i < available_capacity; ++i) {
     status = iree_event_initialize(
         /*initial_state=*/false,
-        &event_pool->available_list[event_pool->available_count++]);
+        &event_pool->available_list[event_pool->available_count]);
     if (!iree_status_is_ok(status)) break;
+    ++event_pool->available_count;
   }
 
   if (iree_status_is_ok(status)) {
@@ -141,18 +143,21 @@ void iree_hal_local_event_pool_release(iree_hal_local_event_pool_t* event_pool,
   // the ones that won't fit.
   iree_host_size_t remaining_count = event_count;
 
+  // Reset the events so that they are ready to be acquired again. This may
+  // require a syscall per event so we do it before taking the lock; events
+  // that don't fit in the pool are rare enough that resetting them anyway is
+  // cheaper than holding the lock across the resets.
+  for (iree_host_size_t i = 0; i < event_count; ++i) {
+    iree_event_reset(&events[i]);
+  }
+
   // Try first to release to the pool.
-  // Note that we reset the events we add back to the pool so that they are
-  // ready to be acquired again.
   iree_slim_mutex_lock(&event_pool->mutex);
   iree_host_size_t to_pool_count =
       iree_min(event_pool->available_capacity - event_pool->available_count,
                event_count);
   if (to_pool_count > 0) {
     iree_host_size_t pool_base_index = event_pool->available_count;
-    for (iree_host_size_t i = 0; i < to_pool_count; ++i) {
-      iree_event_reset(&events[i]);
-    }
     memcpy(&event_pool->available_list[pool_base_index], events,
            to_pool_count * sizeof(iree_event_t));
     event_pool->available_count += to_pool_count;
@@ -160,8 +165,7 @@ void iree_hal_local_event_pool_release(iree_hal_local_event_pool_t* event_pool,
   }
   iree_slim_mutex_unlock(&event_pool->mutex);
 
-  // Deallocate the rest of the events. We don't bother resetting them as we are
-  // getting rid of them.
+  // Deallocate the rest of the events.
   if (remaining_count > 0) {
     IREE_TRACE_ZONE_BEGIN(z0);
     for (iree_host_size_t i = 0; i < remaining_count; ++i) {
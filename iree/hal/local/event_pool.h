@@ -41,11 +41,15 @@ void iree_hal_local_event_pool_free(iree_hal_local_event_pool_t* event_pool);
 // The returned events will be unsignaled and ready for use. Callers may set and
 // reset the events as much as they want prior to releasing them back to the
 // pool with iree_hal_local_event_pool_release.
+//
+// Callers needing multiple events should acquire them all in a single call:
+// the pool lock is taken only once per call regardless of |event_count|.
 iree_status_t iree_hal_local_event_pool_acquire(
     iree_hal_local_event_pool_t* event_pool, iree_host_size_t event_count,
     iree_event_t* out_events);
 
-// Releases one or more events back to the block pool.
+// Releases one or more events back to the event pool.
+// As with acquisition, batches of events should be released in a single call.
 void iree_hal_local_event_pool_release(iree_hal_local_event_pool_t* event_pool,
                                        iree_host_size_t event_count,
                                        iree_event_t* events);
@@ -23,6 +23,147 @@
 #include "iree/task/submission.h"
 #include "iree/task/task.h"
 
+//===----------------------------------------------------------------------===//
+// Command DAG tracking
+//===----------------------------------------------------------------------===//
+
+// A range of bytes within an allocated buffer accessed by a command.
+// Ranges are always expressed relative to the allocated buffer so that accesses
+// made through different subspans of the same allocation can be compared.
+typedef struct {
+  iree_hal_buffer_t* allocated_buffer;
+  iree_device_size_t offset;
+  iree_device_size_t length;
+  iree_hal_memory_access_t access;
+} iree_hal_task_buffer_access_t;
+
+// Resolves the given |buffer| range to its range in the allocated buffer.
+static iree_hal_task_buffer_access_t iree_hal_task_buffer_access_make(
+    iree_hal_buffer_t* buffer, iree_device_size_t offset,
+    iree_device_size_t length, iree_hal_memory_access_t access) {
+  iree_hal_task_buffer_access_t result;
+  result.allocated_buffer = iree_hal_buffer_allocated_buffer(buffer);
+  result.offset = iree_hal_buffer_byte_offset(buffer) + offset;
+  result.length = length == IREE_WHOLE_BUFFER
+                      ? iree_hal_buffer_byte_length(buffer) - offset
+                      : length;
+  result.access = access;
+  return result;
+}
+
+// Returns true if |access| may modify the contents of the range.
+static bool iree_hal_task_buffer_access_is_write(
+    const iree_hal_task_buffer_access_t* access) {
+  return (access->access &
+          (IREE_HAL_MEMORY_ACCESS_WRITE | IREE_HAL_MEMORY_ACCESS_DISCARD)) != 0;
+}
+
+// Returns true if |a| and |b| touch the same bytes and at least one of them
+// writes; in that case the two commands must not execute concurrently.
+static bool iree_hal_task_buffer_access_conflicts(
+    const iree_hal_task_buffer_access_t* a,
+    const iree_hal_task_buffer_access_t* b) {
+  if (a->allocated_buffer != b->allocated_buffer) return false;
+  if (!iree_hal_task_buffer_access_is_write(a) &&
+      !iree_hal_task_buffer_access_is_write(b)) {
+    return false;  // read-read
+  }
+  return a->offset < b->offset + b->length && b->offset < a->offset + a->length;
+}
+
+// Returns true if |a| writes every byte touched by |b| in the same buffer.
+static bool iree_hal_task_buffer_access_overwrites(
+    const iree_hal_task_buffer_access_t* a,
+    const iree_hal_task_buffer_access_t* b) {
+  return a->allocated_buffer == b->allocated_buffer &&
+         iree_hal_task_buffer_access_is_write(a) && a->offset <= b->offset &&
+         b->offset + b->length <= a->offset + a->length;
+}
+
+typedef struct iree_hal_task_cmd_node_s iree_hal_task_cmd_node_t;
+
+// An edge in the command DAG pointing at a node that must complete before the
+// node owning the edge may begin execution.
+typedef struct iree_hal_task_cmd_edge_s {
+  struct iree_hal_task_cmd_edge_s* next;
+  iree_hal_task_cmd_node_t* node;
+} iree_hal_task_cmd_edge_t;
+
+// A recorded command in the DAG. Nodes are allocated from the command buffer
+// arena and live until the command buffer is reset.
+struct iree_hal_task_cmd_node_s {
+  // Previously recorded node, if any; nodes are linked in reverse recording
+  // order such that walking the list visits successors before predecessors.
+  iree_hal_task_cmd_node_t* prev;
+
+  // Task that executes the command.
+  iree_task_t* task;
+
+  // Synchronization scope the command was recorded in. Incremented each time
+  // a barrier or event is recorded.
+  uint32_t epoch;
+
+  // Scratch value used while recording to mark nodes that are already known to
+  // be ordered before the node being emitted.
+  uint32_t visit_marker;
+
+  // Nodes that must complete prior to this one executing.
+  iree_hal_task_cmd_edge_t* predecessors;
+  iree_host_size_t predecessor_count;
+
+  // Tasks of the nodes that depend on this one. Populated on end.
+  iree_host_size_t successor_count;
+  iree_task_t** successor_tasks;
+
+  // Barrier used to fan out to all successors when there are more than one.
+  // Each task can only have a single completion task and so we need the
+  // additional barrier to notify multiple successors. Allocated on end and
+  // initialized each time the command buffer is issued.
+  iree_task_barrier_t* fanout_barrier;
+
+  // All buffer ranges accessed by the command.
+  iree_host_size_t access_count;
+  iree_hal_task_buffer_access_t accesses[];
+};
+
+// An access recorded against a tracked buffer by a node.
+typedef struct iree_hal_task_cmd_access_s {
+  struct iree_hal_task_cmd_access_s* next;
+  iree_hal_task_cmd_node_t* node;
+  // Range accessed; points into the accesses of |node|.
+  const iree_hal_task_buffer_access_t* range;
+  // Epoch of a later node that is ordered after this access and overwrites
+  // its entire range or 0 if none has. Once that epoch is visible any new
+  // command conflicting with this access also conflicts with (and is ordered
+  // after) the overwriting node and the access can be dropped.
+  uint32_t superseded_epoch;
+} iree_hal_task_cmd_access_t;
+
+// Accesses recorded against a single allocated buffer.
+// Reads only need to be ordered after writes and so are tracked separately
+// such that recording many readers of the same buffer stays linear.
+typedef struct iree_hal_task_buffer_tracker_s {
+  struct iree_hal_task_buffer_tracker_s* next;
+  iree_hal_buffer_t* allocated_buffer;
+  // Accesses that may write, most recent first.
+  iree_hal_task_cmd_access_t* writes;
+  // Read-only accesses, most recent first.
+  iree_hal_task_cmd_access_t* reads;
+} iree_hal_task_buffer_tracker_t;
+
+// Number of hash buckets used to look up buffer trackers. Must be a power of
+// two.
+#define IREE_HAL_TASK_BUFFER_TRACKER_BUCKET_COUNT 64
+
+// Tracks the scope in which an event was signaled within the command buffer.
+typedef struct iree_hal_task_cmd_event_s {
+  struct iree_hal_task_cmd_event_s* next;
+  iree_hal_event_t* event;
+  // Epoch of the commands recorded after the signal or 0 if the event has been
+  // reset since it was last signaled.
+  uint32_t signal_epoch;
+} iree_hal_task_cmd_event_t;
+
 //===----------------------------------------------------------------------===//
 // iree_hal_task_command_buffer_t
 //===----------------------------------------------------------------------===//
@@ -35,6 +176,15 @@
 // additional allocations required during recording or execution. That means our
 // command buffer here is essentially just a builder for the task system types
 // and manager of the lifetime of the tasks.
+//
+// Barriers and events do not force a join-fork across all commands. Instead
+// each command records the buffer ranges it accesses and when recorded gets an
+// edge from each earlier command that it conflicts with (read-after-write,
+// write-after-read, or write-after-write) and that is ordered before it by a
+// barrier or event. Commands with no hazards between them are free to execute
+// concurrently even if separated by barriers. On the CPU all memory is coherent
+// and the only way for commands to observe each other is through the memory
+// they access so this preserves the semantics of the recorded barriers.
 typedef struct {
   iree_hal_resource_t resource;
 
@@ -47,36 +197,40 @@ typedef struct {
   // Arena used for all allocations; references the shared device block pool.
   iree_arena_allocator_t arena;
 
-  // One or more tasks at the root of the command buffer task DAG.
-  // These tasks are all able to execute concurrently and will be the initial
-  // ready task set in the submission.
-  iree_task_list_t root_tasks;
-
-  // One or more tasks at the leaves of the DAG.
-  // Only once all these tasks have completed execution will the command buffer
-  // be considered completed as a whole.
+  // The most recently recorded command node, if any. All nodes can be walked
+  // by following the prev pointers. Nodes with no predecessors are the roots of
+  // the DAG and will be the initial ready task set in the submission. Nodes
+  // with no successors are the leaves of the DAG and only once they have all
+  // completed will the command buffer be considered completed as a whole.
   //
-  // An empty list indicates that root_tasks are also the leaves.
-  iree_task_list_t leaf_tasks;
+  // The nodes and their tasks are retained after issue so that reusable
+  // command buffers can reset and issue them again.
+  iree_hal_task_cmd_node_t* last_node;
+
+  // True if the command buffer has been issued since it was last recorded.
+  bool is_issued;
 
   // TODO(benvanik): move this out of the struct and allocate from the arena -
   // we only need this during recording and it's ~4KB of waste otherwise.
   // State tracked within the command buffer during recording only.
   struct {
-    // The last global barrier that was inserted, if any.
-    // The barrier is allocated and inserted into the DAG when requested but the
-    // actual barrier dependency list is only allocated and set on flushes.
-    // This lets us allocate the appropriately sized barrier task list from the
-    // arena even though when the barrier is recorded we don't yet know what
-    // other tasks we'll be emitting as we walk the command stream.
-    iree_task_barrier_t* open_barrier;
+    // Current synchronization scope; incremented by each barrier and event.
+    uint32_t epoch;
 
-    // The number of tasks in the open barrier (|open_tasks|), used to quickly
-    // allocate storage for the task list without needing to walk the list.
-    iree_host_size_t open_task_count;
+    // Commands recorded in epochs prior to this are ordered before any new
+    // commands recorded (if they conflict).
+    uint32_t visible_epoch;
 
-    // All execution tasks emitted that must execute after |open_barrier|.
-    iree_task_list_t open_tasks;
+    // Incremented for each command recorded and used to mark visited nodes.
+    uint32_t visit_marker;
+
+    // Events signaled in the command buffer and the epoch they were signaled.
+    iree_hal_task_cmd_event_t* events;
+
+    // Accesses recorded so far bucketed by allocated buffer. New commands
+    // only need to check the accesses of the buffers they touch.
+    iree_hal_task_buffer_tracker_t*
+        buffer_trackers[IREE_HAL_TASK_BUFFER_TRACKER_BUCKET_COUNT];
 
     // A flattened list of all available descriptor set bindings.
     // As descriptor sets are pushed/bound the bindings will be updated to
@@ -89,6 +243,11 @@ typedef struct {
         binding_lengths[IREE_HAL_LOCAL_MAX_DESCRIPTOR_SET_COUNT *
                         IREE_HAL_LOCAL_MAX_DESCRIPTOR_BINDING_COUNT];
 
+    // Buffer ranges of each binding used to track dispatch hazards.
+    iree_hal_task_buffer_access_t
+        binding_accesses[IREE_HAL_LOCAL_MAX_DESCRIPTOR_SET_COUNT *
+                         IREE_HAL_LOCAL_MAX_DESCRIPTOR_BINDING_COUNT];
+
     // All available push constants updated each time push_constants is called.
     // Reset only with the command buffer and otherwise will maintain its values
     // during recording to allow for partial push_constants updates.
@@ -115,18 +274,15 @@ iree_status_t iree_hal_task_command_buffer_create(
   IREE_ASSERT_ARGUMENT(device);
   IREE_ASSERT_ARGUMENT(out_command_buffer);
   *out_command_buffer = NULL;
-  if (mode != IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT) {
-    // If we want reuse we'd need to support duplicating the task DAG after
-    // recording or have some kind of copy-on-submit behavior that does so if
-    // a command buffer is submitted for execution twice. Allowing for the same
-    // command buffer to be enqueued multiple times would be fine so long as
-    // execution doesn't overlap (`cmdbuf|cmdbuf` vs
-    // `cmdbuf -> semaphore -> cmdbuf`) though we'd still need to be careful
-    // that we did the enqueuing and reset of the task structures at the right
-    // times. Definitely something that'll be useful in the future... but not
-    // today :)
-    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
-                            "only one-shot command buffer usage is supported");
+  if (mode != IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT &&
+      mode != IREE_HAL_COMMAND_BUFFER_MODE_REUSABLE) {
+    // Reusable command buffers can be enqueued multiple times so long as
+    // execution doesn't overlap (`cmdbuf -> semaphore -> cmdbuf` vs
+    // `cmdbuf|cmdbuf`). Supporting overlapping execution would require
+    // duplicating the task DAG on submit.
+    return iree_make_status(
+        IREE_STATUS_UNIMPLEMENTED,
+        "only one-shot or reusable command buffer usage is supported");
   }
 
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -144,8 +300,8 @@ iree_status_t iree_hal_task_command_buffer_create(
     command_buffer->allowed_categories = command_categories;
     command_buffer->queue_affinity = queue_affinity;
     iree_arena_initialize(block_pool, &command_buffer->arena);
-    iree_task_list_initialize(&command_buffer->root_tasks);
-    iree_task_list_initialize(&command_buffer->leaf_tasks);
+    command_buffer->last_node = NULL;
+    command_buffer->is_issued = false;
     memset(&command_buffer->state, 0, sizeof(command_buffer->state));
     *out_command_buffer = (iree_hal_command_buffer_t*)command_buffer;
   }
@@ -157,8 +313,8 @@ iree_status_t iree_hal_task_command_buffer_create(
 static void iree_hal_task_command_buffer_reset(
     iree_hal_task_command_buffer_t* command_buffer) {
   memset(&command_buffer->state, 0, sizeof(command_buffer->state));
-  iree_task_list_discard(&command_buffer->leaf_tasks);
-  iree_task_list_discard(&command_buffer->root_tasks);
+  command_buffer->last_node = NULL;
+  command_buffer->is_issued = false;
   iree_arena_reset(&command_buffer->arena);
 }
 
@@ -188,7 +344,7 @@ iree_hal_task_command_buffer_allowed_categories(
 // iree_hal_task_command_buffer_t recording
 //===----------------------------------------------------------------------===//
 
-static iree_status_t iree_hal_task_command_buffer_flush_tasks(
+static iree_status_t iree_hal_task_command_buffer_prepare_dag(
     iree_hal_task_command_buffer_t* command_buffer);
 
 static iree_status_t iree_hal_task_command_buffer_begin(
@@ -204,134 +360,261 @@ static iree_status_t iree_hal_task_command_buffer_end(
   iree_hal_task_command_buffer_t* command_buffer =
       iree_hal_task_command_buffer_cast(base_command_buffer);
 
-  // Flush any open barriers.
-  IREE_RETURN_IF_ERROR(
-      iree_hal_task_command_buffer_flush_tasks(command_buffer));
-
-  // Move the tasks from the leaf list (tail) to the root list (head) if this
-  // was the first set of tasks recorded.
-  if (iree_task_list_is_empty(&command_buffer->root_tasks) &&
-      !iree_task_list_is_empty(&command_buffer->leaf_tasks)) {
-    iree_task_list_move(&command_buffer->leaf_tasks,
-                        &command_buffer->root_tasks);
-  }
-
-  return iree_ok_status();
+  // Now that we know all of the edges we can allocate the DAG storage.
+  return iree_hal_task_command_buffer_prepare_dag(command_buffer);
 }
 
-// Flushes all open tasks to the previous barrier and prepares for more
-// recording. The root tasks are also populated here when required as this is
-// the one place where we can see both halves of the most recent synchronization
-// event: those tasks recorded prior (if any) and the task that marks the set of
-// tasks that will be recorded after (if any).
-static iree_status_t iree_hal_task_command_buffer_flush_tasks(
+// Gathers the successors of each recorded node based on the edges tracked
+// during recording and allocates the fan-out barriers required for nodes with
+// multiple successors. The tasks are not linked together until issue so that
+// the DAG can be issued multiple times without any additional allocations.
+static iree_status_t iree_hal_task_command_buffer_prepare_dag(
     iree_hal_task_command_buffer_t* command_buffer) {
-  iree_task_barrier_t* open_barrier = command_buffer->state.open_barrier;
-  if (open_barrier != NULL) {
-    // There is an open barrier we need to fixup the fork out to all of the open
-    // tasks that were recorded after it.
-    iree_task_t* task_head =
-        iree_task_list_front(&command_buffer->state.open_tasks);
-    iree_host_size_t dependent_task_count =
-        command_buffer->state.open_task_count;
-    if (dependent_task_count == 1) {
-      // Special-case: only one open task so we can avoid the additional barrier
-      // overhead by reusing the completion task.
-      iree_task_set_completion_task(&open_barrier->header, task_head);
-    } else if (dependent_task_count > 1) {
-      // Allocate the list of tasks we'll stash back on the previous barrier.
-      // Since we couldn't know at the time how many tasks would end up in the
-      // barrier we had to defer it until now.
-      iree_task_t** dependent_tasks = NULL;
-      IREE_RETURN_IF_ERROR(iree_arena_allocate(
-          &command_buffer->arena, dependent_task_count * sizeof(iree_task_t*),
-          (void**)&dependent_tasks));
-      iree_task_t* task = task_head;
-      for (iree_host_size_t i = 0; i < dependent_task_count; ++i) {
-        dependent_tasks[i] = task;
-        task = task->next_task;
-      }
-      iree_task_barrier_set_dependent_tasks(open_barrier, dependent_task_count,
-                                            dependent_tasks);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Count successors so we can allocate their storage.
+  for (iree_hal_task_cmd_node_t* node = command_buffer->last_node; node;
+       node = node->prev) {
+    for (iree_hal_task_cmd_edge_t* edge = node->predecessors; edge;
+         edge = edge->next) {
+      ++edge->node->successor_count;
     }
   }
-  command_buffer->state.open_barrier = NULL;
-
-  // Move the open tasks to the tail as they represent the first half of the
-  // *next* barrier that will be inserted.
-  if (command_buffer->state.open_task_count > 0) {
-    iree_task_list_move(&command_buffer->state.open_tasks,
-                        &command_buffer->leaf_tasks);
-    command_buffer->state.open_task_count = 0;
+  for (iree_hal_task_cmd_node_t* node = command_buffer->last_node; node;
+       node = node->prev) {
+    if (node->successor_count == 0) continue;
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, iree_arena_allocate(&command_buffer->arena,
+                                node->successor_count * sizeof(iree_task_t*),
+                                (void**)&node->successor_tasks));
+    if (node->successor_count > 1) {
+      IREE_RETURN_AND_END_ZONE_IF_ERROR(
+          z0, iree_arena_allocate(&command_buffer->arena,
+                                  sizeof(*node->fanout_barrier),
+                                  (void**)&node->fanout_barrier));
+    }
+    // Reset so that we can use it as the fill cursor below.
+    node->successor_count = 0;
+  }
+
+  // Gather the successors of each node.
+  for (iree_hal_task_cmd_node_t* node = command_buffer->last_node; node;
+       node = node->prev) {
+    for (iree_hal_task_cmd_edge_t* edge = node->predecessors; edge;
+         edge = edge->next) {
+      iree_hal_task_cmd_node_t* predecessor = edge->node;
+      predecessor->successor_tasks[predecessor->successor_count++] =
+          node->task;
+    }
   }
 
+  IREE_TRACE_ZONE_END(z0);
   return iree_ok_status();
 }
 
-// Emits a global barrier, splitting execution into all prior recorded tasks
-// and all subsequent recorded tasks. This is currently the critical piece that
-// limits our concurrency: changing to fine-grained barriers (via barrier
-// buffers or events) will allow more work to overlap at the cost of more brain
-// to build out the proper task graph.
-static iree_status_t iree_hal_task_command_buffer_emit_global_barrier(
-    iree_hal_task_command_buffer_t* command_buffer) {
-  // Flush open tasks to the previous barrier. This resets our state such that
-  // we can assign the new open barrier and start recording tasks for it.
-  // Previous tasks will be moved into the leaf_tasks list.
-  IREE_RETURN_IF_ERROR(
-      iree_hal_task_command_buffer_flush_tasks(command_buffer));
-
-  // Allocate the new open barrier.
-  // As we are recording forward we can't yet assign the dependent tasks (the
-  // second half of the synchronization domain) and instead are just inserting
-  // it so we can setup the join from previous tasks (the first half of the
-  // synchronization domain).
-  iree_task_barrier_t* barrier = NULL;
+// Allocates a DAG node for |task| with storage for |access_count| buffer
+// accesses. The caller must populate the accesses and then emit the node with
+// iree_hal_task_command_buffer_emit_execution_node.
+static iree_status_t iree_hal_task_command_buffer_allocate_node(
+    iree_hal_task_command_buffer_t* command_buffer, iree_task_t* task,
+    iree_host_size_t access_count, iree_hal_task_cmd_node_t** out_node) {
+  iree_hal_task_cmd_node_t* node = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(
+      &command_buffer->arena,
+      sizeof(*node) + access_count * sizeof(node->accesses[0]),
+      (void**)&node));
+  memset(node, 0, sizeof(*node));
+  node->task = task;
+  node->access_count = access_count;
+  *out_node = node;
+  return iree_ok_status();
+}
+
+// Returns the tracker for |allocated_buffer| or NULL if no command recorded so
+// far has accessed it. Trackers are created when |create| is set.
+static iree_status_t iree_hal_task_command_buffer_lookup_tracker(
+    iree_hal_task_command_buffer_t* command_buffer,
+    iree_hal_buffer_t* allocated_buffer, bool create,
+    iree_hal_task_buffer_tracker_t** out_tracker) {
+  uintptr_t key = (uintptr_t)allocated_buffer;
+  iree_host_size_t bucket = (key ^ (key >> 6) ^ (key >> 12)) &
+                            (IREE_HAL_TASK_BUFFER_TRACKER_BUCKET_COUNT - 1);
+  iree_hal_task_buffer_tracker_t** head =
+      &command_buffer->state.buffer_trackers[bucket];
+  for (iree_hal_task_buffer_tracker_t* tracker = *head; tracker;
+       tracker = tracker->next) {
+    if (tracker->allocated_buffer == allocated_buffer) {
+      *out_tracker = tracker;
+      return iree_ok_status();
+    }
+  }
+  *out_tracker = NULL;
+  if (!create) return iree_ok_status();
+  iree_hal_task_buffer_tracker_t* tracker = NULL;
   IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
-                                           sizeof(*barrier), (void**)&barrier));
-  iree_task_barrier_initialize_empty(command_buffer->scope, barrier);
+                                           sizeof(*tracker), (void**)&tracker));
+  memset(tracker, 0, sizeof(*tracker));
+  tracker->allocated_buffer = allocated_buffer;
+  tracker->next = *head;
+  *head = tracker;
+  *out_tracker = tracker;
+  return iree_ok_status();
+}
 
-  // If there were previous tasks then join them to the barrier.
-  for (iree_task_t* task = iree_task_list_front(&command_buffer->leaf_tasks);
-       task != NULL; task = task->next_task) {
-    iree_task_set_completion_task(task, &barrier->header);
+// Returns true if |entry| is no longer needed for commands ordered after
+// |visible_epoch|.
+static bool iree_hal_task_cmd_access_is_superseded(
+    const iree_hal_task_cmd_access_t* entry, uint32_t visible_epoch) {
+  return entry->superseded_epoch && entry->superseded_epoch < visible_epoch;
+}
+
+// Marks the predecessors of each node in |list| that |range| must be ordered
+// after with |marker|. Edges to those predecessors are implied.
+static void iree_hal_task_cmd_access_list_mark_implied(
+    const iree_hal_task_cmd_access_t* list,
+    const iree_hal_task_buffer_access_t* range, uint32_t visible_epoch,
+    uint32_t marker) {
+  for (const iree_hal_task_cmd_access_t* entry = list; entry;
+       entry = entry->next) {
+    if (entry->node->epoch >= visible_epoch ||
+        iree_hal_task_cmd_access_is_superseded(entry, visible_epoch) ||
+        !iree_hal_task_buffer_access_conflicts(entry->range, range)) {
+      continue;
+    }
+    for (iree_hal_task_cmd_edge_t* edge = entry->node->predecessors; edge;
+         edge = edge->next) {
+      edge->node->visit_marker = marker;
+    }
   }
+}
 
-  // Move the tasks from the leaf list (tail) to the root list (head) if this
-  // was the first set of tasks recorded.
-  if (iree_task_list_is_empty(&command_buffer->root_tasks) &&
-      !iree_task_list_is_empty(&command_buffer->leaf_tasks)) {
-    iree_task_list_move(&command_buffer->leaf_tasks,
-                        &command_buffer->root_tasks);
+// Adds an edge to |node| from each node in |*list| that |range| must be
+// ordered after unless already added or implied. Accesses superseded by
+// visible writes are dropped from the list as they are encountered.
+static iree_status_t iree_hal_task_cmd_access_list_add_edges(
+    iree_hal_task_command_buffer_t* command_buffer,
+    iree_hal_task_cmd_access_t** list,
+    const iree_hal_task_buffer_access_t* range, uint32_t visible_epoch,
+    uint32_t implied_marker, uint32_t edge_marker,
+    iree_hal_task_cmd_node_t* node) {
+  for (iree_hal_task_cmd_access_t** it = list; *it;) {
+    iree_hal_task_cmd_access_t* entry = *it;
+    if (iree_hal_task_cmd_access_is_superseded(entry, visible_epoch)) {
+      *it = entry->next;
+      continue;
+    }
+    it = &entry->next;
+    iree_hal_task_cmd_node_t* other = entry->node;
+    if (other->epoch >= visible_epoch ||
+        !iree_hal_task_buffer_access_conflicts(entry->range, range)) {
+      continue;
+    }
+    if (other->visit_marker != implied_marker &&
+        other->visit_marker != edge_marker) {
+      iree_hal_task_cmd_edge_t* edge = NULL;
+      IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
+                                               sizeof(*edge), (void**)&edge));
+      edge->next = node->predecessors;
+      edge->node = other;
+      node->predecessors = edge;
+      ++node->predecessor_count;
+      other->visit_marker = edge_marker;
+    }
+    if (!entry->superseded_epoch &&
+        iree_hal_task_buffer_access_overwrites(range, entry->range)) {
+      entry->superseded_epoch = node->epoch;
+    }
   }
+  return iree_ok_status();
+}
 
-  // Reset the tail of the command buffer to the barrier. This leaves us in a
-  // consistent state if the recording ends immediate after this (the barrier
-  // will be the last task).
-  iree_task_list_initialize(&command_buffer->leaf_tasks);
-  iree_task_list_push_back(&command_buffer->leaf_tasks, &barrier->header);
+// Emits the given execution |node| into the current synchronization scope.
+// An edge is added from every earlier command that conflicts with the node and
+// is ordered before it by a barrier or event. Only the accesses recorded for
+// the buffers the node touches are checked: reads against prior writes and
+// writes against prior reads and writes. Accesses entirely overwritten by a
+// later visible write are dropped as any conflict with them is also a conflict
+// with the write, which keeps the per-buffer lists to roughly the last writer
+// and the readers since.
+//
+// Edges that are implied by the edges of the other nodes we depend on are
+// elided to keep the DAG (and the number of fan-out barriers) small.
+static iree_status_t iree_hal_task_command_buffer_emit_execution_node(
+    iree_hal_task_command_buffer_t* command_buffer,
+    iree_hal_task_cmd_node_t* node) {
+  node->epoch = command_buffer->state.epoch;
+
+  const uint32_t visible_epoch = command_buffer->state.visible_epoch;
+  const uint32_t implied_marker = ++command_buffer->state.visit_marker;
+  const uint32_t edge_marker = ++command_buffer->state.visit_marker;
+  if (visible_epoch > 0) {
+    for (iree_host_size_t i = 0; i < node->access_count; ++i) {
+      const iree_hal_task_buffer_access_t* range = &node->accesses[i];
+      iree_hal_task_buffer_tracker_t* tracker = NULL;
+      IREE_RETURN_IF_ERROR(iree_hal_task_command_buffer_lookup_tracker(
+          command_buffer, range->allocated_buffer, /*create=*/false,
+          &tracker));
+      if (!tracker) continue;
+      iree_hal_task_cmd_access_list_mark_implied(tracker->writes, range,
+                                                 visible_epoch, implied_marker);
+      if (iree_hal_task_buffer_access_is_write(range)) {
+        iree_hal_task_cmd_access_list_mark_implied(
+            tracker->reads, range, visible_epoch, implied_marker);
+      }
+    }
+    for (iree_host_size_t i = 0; i < node->access_count; ++i) {
+      const iree_hal_task_buffer_access_t* range = &node->accesses[i];
+      iree_hal_task_buffer_tracker_t* tracker = NULL;
+      IREE_RETURN_IF_ERROR(iree_hal_task_command_buffer_lookup_tracker(
+          command_buffer, range->allocated_buffer, /*create=*/false,
+          &tracker));
+      if (!tracker) continue;
+      IREE_RETURN_IF_ERROR(iree_hal_task_cmd_access_list_add_edges(
+          command_buffer, &tracker->writes, range, visible_epoch,
+          implied_marker, edge_marker, node));
+      if (iree_hal_task_buffer_access_is_write(range)) {
+        IREE_RETURN_IF_ERROR(iree_hal_task_cmd_access_list_add_edges(
+            command_buffer, &tracker->reads, range, visible_epoch,
+            implied_marker, edge_marker, node));
+      }
+    }
+  }
 
-  // NOTE: all new tasks emitted will be executed after this barrier.
-  command_buffer->state.open_barrier = barrier;
-  command_buffer->state.open_task_count = 0;
+  // Record the accesses of the node for commands that follow.
+  for (iree_host_size_t i = 0; i < node->access_count; ++i) {
+    const iree_hal_task_buffer_access_t* range = &node->accesses[i];
+    iree_hal_task_buffer_tracker_t* tracker = NULL;
+    IREE_RETURN_IF_ERROR(iree_hal_task_command_buffer_lookup_tracker(
+        command_buffer, range->allocated_buffer, /*create=*/true, &tracker));
+    iree_hal_task_cmd_access_t* entry = NULL;
+    IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
+                                             sizeof(*entry), (void**)&entry));
+    entry->node = node;
+    entry->range = range;
+    entry->superseded_epoch = 0;
+    iree_hal_task_cmd_access_t** list =
+        iree_hal_task_buffer_access_is_write(range) ? &tracker->writes
+                                                    : &tracker->reads;
+    entry->next = *list;
+    *list = entry;
+  }
 
+  node->prev = command_buffer->last_node;
+  command_buffer->last_node = node;
   return iree_ok_status();
 }
 
-// Emits a the given execution |task| into the current open synchronization
-// scope (after state.open_barrier and before the next barrier).
+// Emits the given execution |task| accessing the given buffer ranges.
 static iree_status_t iree_hal_task_command_buffer_emit_execution_task(
-    iree_hal_task_command_buffer_t* command_buffer, iree_task_t* task) {
-  if (command_buffer->state.open_barrier == NULL) {
-    // If there is no open barrier then we are at the head and going right into
-    // the task DAG.
-    iree_task_list_push_back(&command_buffer->leaf_tasks, task);
-  } else {
-    // Append to the open task list that will be flushed to the open barrier.
-    iree_task_list_push_back(&command_buffer->state.open_tasks, task);
-    ++command_buffer->state.open_task_count;
-  }
-  return iree_ok_status();
+    iree_hal_task_command_buffer_t* command_buffer, iree_task_t* task,
+    iree_host_size_t access_count,
+    const iree_hal_task_buffer_access_t* accesses) {
+  iree_hal_task_cmd_node_t* node = NULL;
+  IREE_RETURN_IF_ERROR(iree_hal_task_command_buffer_allocate_node(
+      command_buffer, task, access_count, &node));
+  memcpy(node->accesses, accesses, access_count * sizeof(*accesses));
+  return iree_hal_task_command_buffer_emit_execution_node(command_buffer,
+                                                          node);
 }
 
 //===----------------------------------------------------------------------===//
@@ -346,38 +629,127 @@ iree_status_t iree_hal_task_command_buffer_issue(
       iree_hal_task_command_buffer_cast(base_command_buffer);
 
   // If the command buffer is empty (valid!) then we are a no-op.
-  bool has_root_tasks = !iree_task_list_is_empty(&command_buffer->root_tasks);
-  if (!has_root_tasks) {
+  if (!command_buffer->last_node) {
     return iree_ok_status();
   }
 
-  bool has_leaf_tasks = !iree_task_list_is_empty(&command_buffer->leaf_tasks);
-  if (has_leaf_tasks) {
-    // Chain the retire task onto the leaf tasks as their completion indicates
-    // that all commands have completed.
-    for (iree_task_t* task = command_buffer->leaf_tasks.head; task != NULL;
-         task = task->next_task) {
-      iree_task_set_completion_task(task, retire_task);
+  if (command_buffer->is_issued) {
+    if (!iree_all_bits_set(command_buffer->mode,
+                           IREE_HAL_COMMAND_BUFFER_MODE_REUSABLE)) {
+      return iree_make_status(
+          IREE_STATUS_FAILED_PRECONDITION,
+          "one-shot command buffers may only be issued once");
     }
-  } else {
-    // If we have no leaf tasks it means that this is a single layer DAG and
-    // after the root tasks complete the entire command buffer has completed.
-    for (iree_task_t* task = command_buffer->root_tasks.head; task != NULL;
-         task = task->next_task) {
-      iree_task_set_completion_task(task, retire_task);
+
+    // Reset all tasks from the prior issue. Users are required to ensure that
+    // the prior execution has completed before issuing again.
+    for (iree_hal_task_cmd_node_t* node = command_buffer->last_node; node;
+         node = node->prev) {
+      iree_task_reset(node->task);
+    }
+  }
+  command_buffer->is_issued = true;
+
+  // Link all tasks together: nodes with a single successor complete directly
+  // into it and avoid the barrier overhead while those with multiple get a
+  // barrier that fans out to all of them. The leaf tasks are chained to the
+  // retire task as their completion indicates that all commands have
+  // completed.
+  //
+  // Nodes are walked in reverse recording order and pushing to the front of
+  // the root list keeps the roots in recording order.
+  iree_task_list_t root_tasks;
+  iree_task_list_initialize(&root_tasks);
+  for (iree_hal_task_cmd_node_t* node = command_buffer->last_node; node;
+       node = node->prev) {
+    if (node->successor_count == 0) {
+      iree_task_set_completion_task(node->task, retire_task);
+    } else if (node->successor_count == 1) {
+      iree_task_set_completion_task(node->task, node->successor_tasks[0]);
+    } else {
+      iree_task_barrier_initialize(command_buffer->scope,
+                                   node->successor_count,
+                                   node->successor_tasks, node->fanout_barrier);
+      iree_task_set_completion_task(node->task, &node->fanout_barrier->header);
+    }
+    if (node->predecessor_count == 0) {
+      iree_task_list_push_front(&root_tasks, node->task);
     }
   }
 
   // Enqueue all root tasks that are ready to run immediately.
-  // After this all of the command buffer tasks are owned by the submission and
-  // we need to ensure the command buffer doesn't try to discard them.
-  iree_task_submission_enqueue_list(pending_submission,
-                                    &command_buffer->root_tasks);
-  iree_task_list_initialize(&command_buffer->leaf_tasks);
+  // After this all of the command buffer tasks are owned by the submission
+  // until they have retired.
+  iree_task_submission_enqueue_list(pending_submission, &root_tasks);
 
   return iree_ok_status();
 }
 
+void iree_hal_task_command_buffer_query_dispatch_statistics(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_task_dispatch_statistics_t* out_statistics) {
+  iree_hal_task_command_buffer_t* command_buffer =
+      iree_hal_task_command_buffer_cast(base_command_buffer);
+  memset(out_statistics, 0, sizeof(*out_statistics));
+  for (iree_hal_task_cmd_node_t* node = command_buffer->last_node; node;
+       node = node->prev) {
+    if (node->task->type != IREE_TASK_TYPE_DISPATCH) continue;
+    iree_task_dispatch_statistics_merge(
+        &((iree_task_dispatch_t*)node->task)->statistics, out_statistics);
+  }
+}
+
+// Returns the recording order index of |node| given that |last_index| is the
+// index of the most recently recorded node |last_node|.
+static iree_host_size_t iree_hal_task_cmd_node_index(
+    const iree_hal_task_cmd_node_t* last_node, iree_host_size_t last_index,
+    const iree_hal_task_cmd_node_t* node) {
+  for (; last_node != node; last_node = last_node->prev) --last_index;
+  return last_index;
+}
+
+iree_status_t iree_hal_task_command_buffer_query_dependencies(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_host_size_t dependency_capacity,
+    iree_hal_task_command_dependency_t* out_dependencies,
+    iree_host_size_t* out_dependency_count) {
+  iree_hal_task_command_buffer_t* command_buffer =
+      iree_hal_task_command_buffer_cast(base_command_buffer);
+  IREE_ASSERT_ARGUMENT(out_dependency_count);
+  *out_dependency_count = 0;
+
+  iree_host_size_t node_count = 0;
+  iree_host_size_t dependency_count = 0;
+  for (iree_hal_task_cmd_node_t* node = command_buffer->last_node; node;
+       node = node->prev) {
+    ++node_count;
+    dependency_count += node->predecessor_count;
+  }
+  *out_dependency_count = dependency_count;
+  if (dependency_capacity < dependency_count) {
+    // Not an error; just a size query.
+    return iree_status_from_code(IREE_STATUS_OUT_OF_RANGE);
+  }
+
+  // Predecessors are always recorded before the node depending on them and
+  // so their indices are found by walking back from the node.
+  iree_host_size_t index = node_count;
+  iree_host_size_t dependency_index = dependency_count;
+  for (iree_hal_task_cmd_node_t* node = command_buffer->last_node; node;
+       node = node->prev) {
+    --index;
+    for (iree_hal_task_cmd_edge_t* edge = node->predecessors; edge;
+         edge = edge->next) {
+      iree_hal_task_command_dependency_t* dependency =
+          &out_dependencies[--dependency_index];
+      dependency->predecessor =
+          iree_hal_task_cmd_node_index(node, index, edge->node);
+      dependency->successor = index;
+    }
+  }
+  return iree_ok_status();
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_command_buffer_execution_barrier
 //===----------------------------------------------------------------------===//
@@ -394,19 +766,53 @@ static iree_status_t iree_hal_task_command_buffer_execution_barrier(
   iree_hal_task_command_buffer_t* command_buffer =
       iree_hal_task_command_buffer_cast(base_command_buffer);
 
-  // TODO(benvanik): actual DAG construction. Right now we are just doing simple
-  // global barriers each time and forcing a join-fork point.
-  return iree_hal_task_command_buffer_emit_global_barrier(command_buffer);
+  // All commands recorded from here on are ordered after all prior commands
+  // they conflict with. The memory and buffer barriers are not needed as we
+  // track the precise ranges accessed by each command.
+  ++command_buffer->state.epoch;
+  command_buffer->state.visible_epoch = command_buffer->state.epoch;
+  return iree_ok_status();
 }
 
 //===----------------------------------------------------------------------===//
 // iree_hal_command_buffer_signal_event
 //===----------------------------------------------------------------------===//
+// NOTE: events are only tracked within a command buffer. Waits on events that
+// were not signaled in the same command buffer are treated as barriers.
+// TODO(#4518): track event state across command buffers on the queue.
+
+// Returns the tracking entry for |event| or NULL if it has not been signaled
+// in the command buffer.
+static iree_hal_task_cmd_event_t* iree_hal_task_command_buffer_find_event(
+    iree_hal_task_command_buffer_t* command_buffer,
+    const iree_hal_event_t* event) {
+  for (iree_hal_task_cmd_event_t* entry = command_buffer->state.events; entry;
+       entry = entry->next) {
+    if (entry->event == event) return entry;
+  }
+  return NULL;
+}
 
 static iree_status_t iree_hal_task_command_buffer_signal_event(
     iree_hal_command_buffer_t* base_command_buffer, iree_hal_event_t* event,
     iree_hal_execution_stage_t source_stage_mask) {
-  // TODO(#4518): implement events. For now we just insert global barriers.
+  iree_hal_task_command_buffer_t* command_buffer =
+      iree_hal_task_command_buffer_cast(base_command_buffer);
+
+  iree_hal_task_cmd_event_t* entry =
+      iree_hal_task_command_buffer_find_event(command_buffer, event);
+  if (!entry) {
+    IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
+                                             sizeof(*entry), (void**)&entry));
+    entry->next = command_buffer->state.events;
+    entry->event = event;
+    command_buffer->state.events = entry;
+  }
+
+  // Start a new scope so that waits only order commands recorded prior to the
+  // signal.
+  ++command_buffer->state.epoch;
+  entry->signal_epoch = command_buffer->state.epoch;
   return iree_ok_status();
 }
 
@@ -417,7 +823,11 @@ static iree_status_t iree_hal_task_command_buffer_signal_event(
 static iree_status_t iree_hal_task_command_buffer_reset_event(
     iree_hal_command_buffer_t* base_command_buffer, iree_hal_event_t* event,
     iree_hal_execution_stage_t source_stage_mask) {
-  // TODO(#4518): implement events. For now we just insert global barriers.
+  iree_hal_task_command_buffer_t* command_buffer =
+      iree_hal_task_command_buffer_cast(base_command_buffer);
+  iree_hal_task_cmd_event_t* entry =
+      iree_hal_task_command_buffer_find_event(command_buffer, event);
+  if (entry) entry->signal_epoch = 0;
   return iree_ok_status();
 }
 
@@ -436,8 +846,21 @@ static iree_status_t iree_hal_task_command_buffer_wait_events(
     const iree_hal_buffer_barrier_t* buffer_barriers) {
   iree_hal_task_command_buffer_t* command_buffer =
       iree_hal_task_command_buffer_cast(base_command_buffer);
-  // TODO(#4518): implement events. For now we just insert global barriers.
-  return iree_hal_task_command_buffer_emit_global_barrier(command_buffer);
+
+  // Commands recorded prior to any of the event signals are now visible.
+  // Events we don't know about are conservatively treated as barriers.
+  ++command_buffer->state.epoch;
+  uint32_t visible_epoch = command_buffer->state.visible_epoch;
+  for (iree_host_size_t i = 0; i < event_count; ++i) {
+    iree_hal_task_cmd_event_t* entry =
+        iree_hal_task_command_buffer_find_event(command_buffer, events[i]);
+    uint32_t signal_epoch = entry && entry->signal_epoch
+                                ? entry->signal_epoch
+                                : command_buffer->state.epoch;
+    visible_epoch = iree_max(visible_epoch, signal_epoch);
+  }
+  command_buffer->state.visible_epoch = visible_epoch;
+  return iree_ok_status();
 }
 
 //===----------------------------------------------------------------------===//
@@ -500,8 +923,10 @@ static iree_status_t iree_hal_task_command_buffer_fill_buffer(
   memcpy(cmd->pattern, pattern, pattern_length);
   cmd->pattern_length = pattern_length;
 
-  return iree_hal_task_command_buffer_emit_execution_task(command_buffer,
-                                                          &cmd->task.header);
+  iree_hal_task_buffer_access_t access = iree_hal_task_buffer_access_make(
+      target_buffer, target_offset, length, IREE_HAL_MEMORY_ACCESS_WRITE);
+  return iree_hal_task_command_buffer_emit_execution_task(
+      command_buffer, &cmd->task.header, 1, &access);
 }
 
 //===----------------------------------------------------------------------===//
@@ -553,8 +978,10 @@ static iree_status_t iree_hal_task_command_buffer_update_buffer(
   memcpy(cmd->source_buffer, (const uint8_t*)source_buffer + source_offset,
          cmd->length);
 
-  return iree_hal_task_command_buffer_emit_execution_task(command_buffer,
-                                                          &cmd->task.header);
+  iree_hal_task_buffer_access_t access = iree_hal_task_buffer_access_make(
+      target_buffer, target_offset, length, IREE_HAL_MEMORY_ACCESS_WRITE);
+  return iree_hal_task_command_buffer_emit_execution_task(
+      command_buffer, &cmd->task.header, 1, &access);
 }
 
 //===----------------------------------------------------------------------===//
@@ -608,8 +1035,14 @@ static iree_status_t iree_hal_task_command_buffer_copy_buffer(
   cmd->target_offset = target_offset;
   cmd->length = length;
 
-  return iree_hal_task_command_buffer_emit_execution_task(command_buffer,
-                                                          &cmd->task.header);
+  iree_hal_task_buffer_access_t accesses[2] = {
+      iree_hal_task_buffer_access_make(source_buffer, source_offset, length,
+                                       IREE_HAL_MEMORY_ACCESS_READ),
+      iree_hal_task_buffer_access_make(target_buffer, target_offset, length,
+                                       IREE_HAL_MEMORY_ACCESS_WRITE),
+  };
+  return iree_hal_task_command_buffer_emit_execution_task(
+      command_buffer, &cmd->task.header, IREE_ARRAYSIZE(accesses), accesses);
 }
 
 //===----------------------------------------------------------------------===//
@@ -672,14 +1105,20 @@ static iree_status_t iree_hal_task_command_buffer_push_descriptor_set(
     iree_host_size_t binding_ordinal = binding_base + bindings[i].binding;
 
     // TODO(benvanik): track mapping so we can properly map/unmap/flush/etc.
+    iree_hal_memory_access_t access =
+        local_set_layout->bindings[binding_ordinal].access;
     iree_hal_buffer_mapping_t buffer_mapping;
     IREE_RETURN_IF_ERROR(iree_hal_buffer_map_range(
-        bindings[i].buffer, local_set_layout->bindings[binding_ordinal].access,
-        bindings[i].offset, bindings[i].length, &buffer_mapping));
+        bindings[i].buffer, access, bindings[i].offset, bindings[i].length,
+        &buffer_mapping));
     command_buffer->state.bindings[binding_ordinal] =
         buffer_mapping.contents.data;
     command_buffer->state.binding_lengths[binding_ordinal] =
         buffer_mapping.contents.data_length;
+    command_buffer->state.binding_accesses[binding_ordinal] =
+        iree_hal_task_buffer_access_make(bindings[i].buffer, bindings[i].offset,
+                                         buffer_mapping.contents.data_length,
+                                         access);
   }
 
   return iree_ok_status();
@@ -730,6 +1169,7 @@ static iree_status_t iree_hal_task_command_buffer_build_dispatch(
     iree_hal_command_buffer_t* base_command_buffer,
     iree_hal_executable_t* executable, int32_t entry_point,
     uint32_t workgroup_x, uint32_t workgroup_y, uint32_t workgroup_z,
+    iree_hal_buffer_t* workgroups_buffer, iree_device_size_t workgroups_offset,
     iree_hal_cmd_dispatch_t** out_cmd) {
   iree_hal_task_command_buffer_t* command_buffer =
       iree_hal_task_command_buffer_cast(base_command_buffer);
@@ -762,6 +1202,13 @@ static iree_status_t iree_hal_task_command_buffer_build_dispatch(
                                     iree_hal_cmd_dispatch_tile, (uintptr_t)cmd),
                                 workgroup_size, workgroup_count, &cmd->task);
 
+  // Each binding (and the indirect workgroup count, if any) is an access that
+  // we need to track in order to order the dispatch against other commands.
+  iree_hal_task_cmd_node_t* node = NULL;
+  IREE_RETURN_IF_ERROR(iree_hal_task_command_buffer_allocate_node(
+      command_buffer, &cmd->task.header,
+      used_binding_count + (workgroups_buffer ? 1 : 0), &node));
+
   iree_hal_executable_dispatch_state_v0_t* state = &cmd->state;
   memcpy(&state->workgroup_size, workgroup_size, sizeof(iree_hal_vec3_t));
   memcpy(&state->workgroup_count, workgroup_count, sizeof(iree_hal_vec3_t));
@@ -796,6 +1243,7 @@ static iree_status_t iree_hal_task_command_buffer_build_dispatch(
     used_binding_mask = iree_shr(used_binding_mask, mask_offset + 1);
     binding_ptrs[i] = command_buffer->state.bindings[binding_ordinal];
     binding_lengths[i] = command_buffer->state.binding_lengths[binding_ordinal];
+    node->accesses[i] = command_buffer->state.binding_accesses[binding_ordinal];
     if (!binding_ptrs[i]) {
       return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
                               "(flat) binding %d is NULL", binding_ordinal);
@@ -804,9 +1252,15 @@ static iree_status_t iree_hal_task_command_buffer_build_dispatch(
   state->binding_ptrs = binding_ptrs;
   state->binding_lengths = binding_lengths;
 
+  if (workgroups_buffer) {
+    node->accesses[used_binding_count] = iree_hal_task_buffer_access_make(
+        workgroups_buffer, workgroups_offset, 3 * sizeof(uint32_t),
+        IREE_HAL_MEMORY_ACCESS_READ);
+  }
+
   *out_cmd = cmd;
-  return iree_hal_task_command_buffer_emit_execution_task(command_buffer,
-                                                          &cmd->task.header);
+  return iree_hal_task_command_buffer_emit_execution_node(command_buffer,
+                                                          node);
 }
 
 static iree_status_t iree_hal_task_command_buffer_dispatch(
@@ -816,7 +1270,7 @@ static iree_status_t iree_hal_task_command_buffer_dispatch(
   iree_hal_cmd_dispatch_t* cmd = NULL;
   return iree_hal_task_command_buffer_build_dispatch(
       base_command_buffer, executable, entry_point, workgroup_x, workgroup_y,
-      workgroup_z, &cmd);
+      workgroup_z, /*workgroups_buffer=*/NULL, /*workgroups_offset=*/0, &cmd);
 }
 
 static iree_status_t iree_hal_task_command_buffer_dispatch_indirect(
@@ -832,7 +1286,8 @@ static iree_status_t iree_hal_task_command_buffer_dispatch_indirect(
 
   iree_hal_cmd_dispatch_t* cmd = NULL;
   IREE_RETURN_IF_ERROR(iree_hal_task_command_buffer_build_dispatch(
-      base_command_buffer, executable, entry_point, 0, 0, 0, &cmd));
+      base_command_buffer, executable, entry_point, 0, 0, 0, workgroups_buffer,
+      workgroups_offset, &cmd));
   cmd->task.workgroup_count.ptr = (const uint32_t*)buffer_mapping.contents.data;
   cmd->task.header.flags |= IREE_TASK_FLAG_DISPATCH_INDIRECT;
   return iree_ok_status();
@@ -49,11 +49,44 @@ iree_status_t iree_hal_task_command_buffer_create(
 //
 // |pending_submission| will receive the ready list of commands and must be
 // submitted to the executor (or discarded on failure) by the caller.
+//
+// Command buffers created with IREE_HAL_COMMAND_BUFFER_MODE_REUSABLE may be
+// issued multiple times so long as the prior issue has retired; one-shot
+// command buffers will fail with IREE_STATUS_FAILED_PRECONDITION if issued
+// again.
 iree_status_t iree_hal_task_command_buffer_issue(
     iree_hal_command_buffer_t* command_buffer,
     iree_hal_task_queue_state_t* queue_state, iree_task_t* retire_task,
     iree_arena_allocator_t* arena, iree_task_submission_t* pending_submission);
 
+// Returns the statistics of all dispatches in |command_buffer| aggregated
+// from its most recent issue. Only valid once the issue has retired; reusable
+// command buffers reset their statistics each time they are issued.
+void iree_hal_task_command_buffer_query_dispatch_statistics(
+    iree_hal_command_buffer_t* command_buffer,
+    iree_task_dispatch_statistics_t* out_statistics);
+
+// A dependency between two commands recorded in a task command buffer.
+// Commands are identified by their index in recording order counting only the
+// commands that execute work (fills, updates, copies, and dispatches).
+typedef struct {
+  iree_host_size_t predecessor;
+  iree_host_size_t successor;
+} iree_hal_task_command_dependency_t;
+
+// Returns the dependencies between the commands recorded in |command_buffer|
+// in |out_dependencies| and their count in |out_dependency_count|. Only the
+// edges of the task DAG are returned and orderings implied by a chain of edges
+// are omitted. |dependency_capacity| indicates the number of dependencies
+// available in the |out_dependencies| buffer. If there is not enough capacity
+// to store all of the dependencies IREE_STATUS_OUT_OF_RANGE is returned.
+// Intended for tests and tooling; only valid once recording has ended.
+iree_status_t iree_hal_task_command_buffer_query_dependencies(
+    iree_hal_command_buffer_t* command_buffer,
+    iree_host_size_t dependency_capacity,
+    iree_hal_task_command_dependency_t* out_dependencies,
+    iree_host_size_t* out_dependency_count);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
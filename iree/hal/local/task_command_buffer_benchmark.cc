@@ -0,0 +1,195 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/hal/api.h"
+#include "iree/hal/local/task_device.h"
+#include "iree/task/executor.h"
+#include "iree/task/topology.h"
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Device fixture utilities
+//===----------------------------------------------------------------------===//
+
+// Creates a task device with no executable loaders backed by an executor with
+// |worker_count| workers. Aborts the benchmark on failure.
+iree_hal_device_t* CreateDevice(iree_host_size_t worker_count) {
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(worker_count, &topology);
+  iree_task_executor_t* executor = NULL;
+  IREE_CHECK_OK(iree_task_executor_create(IREE_TASK_SCHEDULING_MODE_RESERVED,
+                                          &topology, iree_allocator_system(),
+                                          &executor));
+  iree_task_topology_deinitialize(&topology);
+
+  iree_hal_task_device_params_t params;
+  iree_hal_task_device_params_initialize(&params);
+  iree_hal_device_t* device = NULL;
+  IREE_CHECK_OK(iree_hal_task_device_create(
+      iree_make_cstring_view("benchmark"), &params, executor,
+      /*loader_count=*/0, /*loaders=*/NULL, iree_allocator_system(), &device));
+  iree_task_executor_release(executor);
+  return device;
+}
+
+iree_hal_buffer_t* AllocateBuffer(iree_hal_device_t* device,
+                                  iree_host_size_t size) {
+  iree_hal_buffer_t* buffer = NULL;
+  IREE_CHECK_OK(iree_hal_allocator_allocate_buffer(
+      iree_hal_device_allocator(device),
+      IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+      IREE_HAL_BUFFER_USAGE_ALL, size, &buffer));
+  return buffer;
+}
+
+// Submits |command_buffer| to the device and waits for it to complete.
+void SubmitAndWait(iree_hal_device_t* device,
+                   iree_hal_command_buffer_t* command_buffer,
+                   iree_hal_semaphore_t* semaphore, uint64_t signal_value) {
+  iree_hal_submission_batch_t batch;
+  memset(&batch, 0, sizeof(batch));
+  batch.command_buffer_count = 1;
+  batch.command_buffers = &command_buffer;
+  batch.signal_semaphores.count = 1;
+  batch.signal_semaphores.semaphores = &semaphore;
+  batch.signal_semaphores.payload_values = &signal_value;
+  IREE_CHECK_OK(iree_hal_device_queue_submit(
+      device, IREE_HAL_COMMAND_CATEGORY_ANY, /*queue_affinity=*/0,
+      /*batch_count=*/1, &batch));
+  IREE_CHECK_OK(iree_hal_semaphore_wait_with_deadline(
+      semaphore, signal_value, IREE_TIME_INFINITE_FUTURE));
+}
+
+//===----------------------------------------------------------------------===//
+// Parallel branches
+//===----------------------------------------------------------------------===//
+
+// Size of the smallest branch copy; branch N copies (N + 1) times this.
+static const iree_host_size_t kBaseCopySize = 256 * 1024;
+
+// Records |step_count| steps of |branch_count| independent branches separated
+// by execution barriers as a compiler would emit for a model with parallel
+// branches. Each branch ping-pongs copies between its own pair of buffers and
+// the branches have different amounts of work such that global barriers would
+// force every step to wait for the slowest branch.
+void RecordParallelBranches(iree_hal_command_buffer_t* command_buffer,
+                            const std::vector<iree_hal_buffer_t*>& buffers,
+                            int branch_count, int step_count) {
+  IREE_CHECK_OK(iree_hal_command_buffer_begin(command_buffer));
+  for (int b = 0; b < branch_count; ++b) {
+    uint8_t pattern = (uint8_t)(b + 1);
+    IREE_CHECK_OK(iree_hal_command_buffer_fill_buffer(
+        command_buffer, buffers[b * 2 + 0], 0, IREE_WHOLE_BUFFER, &pattern,
+        sizeof(pattern)));
+  }
+  for (int step = 0; step < step_count; ++step) {
+    IREE_CHECK_OK(iree_hal_command_buffer_execution_barrier(
+        command_buffer, IREE_HAL_EXECUTION_STAGE_TRANSFER,
+        IREE_HAL_EXECUTION_STAGE_TRANSFER, 0, 0, NULL, 0, NULL));
+    for (int b = 0; b < branch_count; ++b) {
+      iree_hal_buffer_t* source_buffer = buffers[b * 2 + (step % 2)];
+      iree_hal_buffer_t* target_buffer = buffers[b * 2 + ((step + 1) % 2)];
+      IREE_CHECK_OK(iree_hal_command_buffer_copy_buffer(
+          command_buffer, source_buffer, 0, target_buffer, 0,
+          IREE_WHOLE_BUFFER));
+    }
+  }
+  IREE_CHECK_OK(iree_hal_command_buffer_end(command_buffer));
+}
+
+// Measures the time taken to record and execute a command buffer containing
+// |branch_count| parallel branches. With a single branch this is a fully
+// serialized chain and acts as a baseline. When |reusable| is set the command
+// buffer is recorded once and then submitted each iteration.
+//
+// Arguments: [branch_count, step_count, reusable]
+void BM_ParallelBranches(benchmark::State& state) {
+  int branch_count = (int)state.range(0);
+  int step_count = (int)state.range(1);
+  bool reusable = state.range(2) != 0;
+  iree_hal_device_t* device = CreateDevice(/*worker_count=*/4);
+
+  std::vector<iree_hal_buffer_t*> buffers(branch_count * 2);
+  for (int b = 0; b < branch_count; ++b) {
+    buffers[b * 2 + 0] = AllocateBuffer(device, (b + 1) * kBaseCopySize);
+    buffers[b * 2 + 1] = AllocateBuffer(device, (b + 1) * kBaseCopySize);
+  }
+
+  iree_hal_semaphore_t* semaphore = NULL;
+  IREE_CHECK_OK(iree_hal_semaphore_create(device, 0ull, &semaphore));
+  uint64_t signal_value = 0;
+
+  iree_hal_command_buffer_t* reusable_command_buffer = NULL;
+  if (reusable) {
+    IREE_CHECK_OK(iree_hal_command_buffer_create(
+        device, IREE_HAL_COMMAND_BUFFER_MODE_REUSABLE,
+        IREE_HAL_COMMAND_CATEGORY_ANY, /*queue_affinity=*/0,
+        &reusable_command_buffer));
+    RecordParallelBranches(reusable_command_buffer, buffers, branch_count,
+                           step_count);
+  }
+
+  int64_t bytes_copied = 0;
+  for (auto _ : state) {
+    if (reusable) {
+      SubmitAndWait(device, reusable_command_buffer, semaphore, ++signal_value);
+    } else {
+      iree_hal_command_buffer_t* command_buffer = NULL;
+      IREE_CHECK_OK(iree_hal_command_buffer_create(
+          device, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
+          IREE_HAL_COMMAND_CATEGORY_ANY, /*queue_affinity=*/0,
+          &command_buffer));
+      RecordParallelBranches(command_buffer, buffers, branch_count, step_count);
+      SubmitAndWait(device, command_buffer, semaphore, ++signal_value);
+      iree_hal_command_buffer_release(command_buffer);
+    }
+    for (int b = 0; b < branch_count; ++b) {
+      bytes_copied += (int64_t)(b + 1) * kBaseCopySize * step_count;
+    }
+  }
+  state.SetBytesProcessed(bytes_copied);
+
+  // Ensure the fills were ordered before the copies in each branch.
+  for (int b = 0; b < branch_count; ++b) {
+    uint8_t value = 0;
+    IREE_CHECK_OK(iree_hal_buffer_read_data(buffers[b * 2 + (step_count % 2)],
+                                            (b + 1) * kBaseCopySize - 1, &value,
+                                            sizeof(value)));
+    IREE_CHECK_EQ(b + 1, value);
+  }
+
+  iree_hal_command_buffer_release(reusable_command_buffer);
+  iree_hal_semaphore_release(semaphore);
+  for (auto* buffer : buffers) iree_hal_buffer_release(buffer);
+  iree_hal_device_release(device);
+}
+BENCHMARK(BM_ParallelBranches)
+    ->ArgNames({"branches", "steps", "reusable"})
+    ->Args({1, 8, 0})
+    ->Args({4, 8, 0})
+    ->Args({8, 8, 0})
+    ->Args({1, 8, 1})
+    ->Args({4, 8, 1})
+    ->Args({8, 8, 1})
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
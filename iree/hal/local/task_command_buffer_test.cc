@@ -0,0 +1,531 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/hal/local/task_command_buffer.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/hal/api.h"
+#include "iree/hal/local/task_device.h"
+#include "iree/task/executor.h"
+#include "iree/task/topology.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+using Dependencies = std::vector<std::pair<size_t, size_t>>;
+
+class TaskCommandBufferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    iree_task_topology_t topology;
+    iree_task_topology_initialize_from_group_count(1, &topology);
+    iree_task_executor_t* executor = NULL;
+    IREE_ASSERT_OK(iree_task_executor_create(
+        IREE_TASK_SCHEDULING_MODE_RESERVED, &topology, iree_allocator_system(),
+        &executor));
+    iree_task_topology_deinitialize(&topology);
+
+    iree_hal_task_device_params_t params;
+    iree_hal_task_device_params_initialize(&params);
+    IREE_ASSERT_OK(iree_hal_task_device_create(
+        iree_make_cstring_view("test"), &params, executor,
+        /*loader_count=*/0, /*loaders=*/NULL, iree_allocator_system(),
+        &device_));
+    iree_task_executor_release(executor);
+
+    IREE_ASSERT_OK(iree_hal_command_buffer_create(
+        device_, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
+        IREE_HAL_COMMAND_CATEGORY_ANY, IREE_HAL_QUEUE_AFFINITY_ANY,
+        &command_buffer_));
+    IREE_ASSERT_OK(iree_hal_command_buffer_begin(command_buffer_));
+  }
+
+  void TearDown() override {
+    iree_hal_command_buffer_release(command_buffer_);
+    for (auto* event : events_) iree_hal_event_release(event);
+    for (auto* buffer : buffers_) iree_hal_buffer_release(buffer);
+    iree_hal_device_release(device_);
+  }
+
+  iree_hal_buffer_t* CreateBuffer(iree_device_size_t length) {
+    iree_hal_buffer_t* buffer = NULL;
+    IREE_CHECK_OK(iree_hal_allocator_allocate_buffer(
+        iree_hal_device_allocator(device_),
+        IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+        IREE_HAL_BUFFER_USAGE_ALL, length, &buffer));
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  iree_hal_buffer_t* CreateSubspan(iree_hal_buffer_t* buffer,
+                                   iree_device_size_t offset,
+                                   iree_device_size_t length) {
+    iree_hal_buffer_t* subspan = NULL;
+    IREE_CHECK_OK(iree_hal_buffer_subspan(buffer, offset, length, &subspan));
+    buffers_.push_back(subspan);
+    return subspan;
+  }
+
+  iree_hal_event_t* CreateEvent() {
+    iree_hal_event_t* event = NULL;
+    IREE_CHECK_OK(iree_hal_event_create(device_, &event));
+    events_.push_back(event);
+    return event;
+  }
+
+  void Fill(iree_hal_buffer_t* buffer, iree_device_size_t offset,
+            iree_device_size_t length) {
+    uint8_t pattern = 0xCD;
+    IREE_ASSERT_OK(iree_hal_command_buffer_fill_buffer(
+        command_buffer_, buffer, offset, length, &pattern, sizeof(pattern)));
+  }
+  void Fill(iree_hal_buffer_t* buffer) { Fill(buffer, 0, IREE_WHOLE_BUFFER); }
+
+  void Copy(iree_hal_buffer_t* source_buffer, iree_device_size_t source_offset,
+            iree_hal_buffer_t* target_buffer, iree_device_size_t target_offset,
+            iree_device_size_t length) {
+    IREE_ASSERT_OK(iree_hal_command_buffer_copy_buffer(
+        command_buffer_, source_buffer, source_offset, target_buffer,
+        target_offset, length));
+  }
+  void Copy(iree_hal_buffer_t* source_buffer,
+            iree_hal_buffer_t* target_buffer) {
+    Copy(source_buffer, 0, target_buffer, 0,
+         iree_hal_buffer_byte_length(source_buffer));
+  }
+
+  void Barrier() {
+    IREE_ASSERT_OK(iree_hal_command_buffer_execution_barrier(
+        command_buffer_, IREE_HAL_EXECUTION_STAGE_TRANSFER,
+        IREE_HAL_EXECUTION_STAGE_TRANSFER, IREE_HAL_EXECUTION_BARRIER_FLAG_NONE,
+        0, NULL, 0, NULL));
+  }
+
+  void SignalEvent(iree_hal_event_t* event) {
+    IREE_ASSERT_OK(iree_hal_command_buffer_signal_event(
+        command_buffer_, event, IREE_HAL_EXECUTION_STAGE_TRANSFER));
+  }
+
+  void ResetEvent(iree_hal_event_t* event) {
+    IREE_ASSERT_OK(iree_hal_command_buffer_reset_event(
+        command_buffer_, event, IREE_HAL_EXECUTION_STAGE_TRANSFER));
+  }
+
+  void WaitEvents(std::vector<const iree_hal_event_t*> events) {
+    IREE_ASSERT_OK(iree_hal_command_buffer_wait_events(
+        command_buffer_, events.size(), events.data(),
+        IREE_HAL_EXECUTION_STAGE_TRANSFER, IREE_HAL_EXECUTION_STAGE_TRANSFER, 0,
+        NULL, 0, NULL));
+  }
+
+  // Ends recording and returns the (predecessor, successor) command index
+  // pairs of the task DAG in sorted order.
+  Dependencies EndAndQueryDependencies() {
+    IREE_CHECK_OK(iree_hal_command_buffer_end(command_buffer_));
+    iree_host_size_t count = 0;
+    iree_status_t status = iree_hal_task_command_buffer_query_dependencies(
+        command_buffer_, 0, NULL, &count);
+    IREE_CHECK_EQ(count > 0 ? IREE_STATUS_OUT_OF_RANGE : IREE_STATUS_OK,
+                  iree_status_consume_code(status));
+    std::vector<iree_hal_task_command_dependency_t> storage(count);
+    IREE_CHECK_OK(iree_hal_task_command_buffer_query_dependencies(
+        command_buffer_, storage.size(), storage.data(), &count));
+    Dependencies dependencies;
+    for (const auto& dependency : storage) {
+      dependencies.emplace_back(dependency.predecessor, dependency.successor);
+    }
+    std::sort(dependencies.begin(), dependencies.end());
+    return dependencies;
+  }
+
+  iree_hal_device_t* device_ = NULL;
+  iree_hal_command_buffer_t* command_buffer_ = NULL;
+  std::vector<iree_hal_buffer_t*> buffers_;
+  std::vector<iree_hal_event_t*> events_;
+};
+
+TEST_F(TaskCommandBufferTest, Empty) {
+  EXPECT_EQ(Dependencies{}, EndAndQueryDependencies());
+}
+
+// Commands recorded without a barrier between them are not ordered even when
+// they conflict.
+TEST_F(TaskCommandBufferTest, NoBarrier) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  Fill(a);     // 0
+  Copy(a, b);  // 1: RAW on a
+  Fill(b);     // 2: WAW on b
+  Fill(a);     // 3: WAR on a
+  EXPECT_EQ(Dependencies{}, EndAndQueryDependencies());
+}
+
+TEST_F(TaskCommandBufferTest, ReadAfterWrite) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  Fill(a);  // 0
+  Barrier();
+  Copy(a, b);  // 1
+  EXPECT_EQ((Dependencies{{0, 1}}), EndAndQueryDependencies());
+}
+
+TEST_F(TaskCommandBufferTest, WriteAfterRead) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  Copy(a, b);  // 0
+  Barrier();
+  Fill(a);  // 1
+  EXPECT_EQ((Dependencies{{0, 1}}), EndAndQueryDependencies());
+}
+
+TEST_F(TaskCommandBufferTest, WriteAfterWrite) {
+  auto* a = CreateBuffer(256);
+  Fill(a);  // 0
+  Barrier();
+  Fill(a);  // 1
+  EXPECT_EQ((Dependencies{{0, 1}}), EndAndQueryDependencies());
+}
+
+// Barriers only order commands that touch the same bytes with a write.
+TEST_F(TaskCommandBufferTest, NoHazardAcrossBarrier) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  auto* c = CreateBuffer(256);
+  Copy(a, b);       // 0
+  Fill(c, 0, 128);  // 1
+  Barrier();
+  Copy(a, c);         // 2: RAR on a, WAW on c
+  Fill(b, 128, 128);  // 3: WAW on b with 0
+  Fill(c, 128, 128);  // 4: WAW on c with 2 only in the same scope
+  EXPECT_EQ((Dependencies{{0, 3}, {1, 2}}), EndAndQueryDependencies());
+}
+
+TEST_F(TaskCommandBufferTest, DisjointRanges) {
+  auto* a = CreateBuffer(256);
+  Fill(a, 0, 128);  // 0
+  Barrier();
+  Fill(a, 128, 128);  // 1
+  EXPECT_EQ(Dependencies{}, EndAndQueryDependencies());
+}
+
+// Accesses through different subspans are compared by their range in the
+// allocated buffer.
+TEST_F(TaskCommandBufferTest, OverlappingSubspans) {
+  auto* a = CreateBuffer(256);
+  auto* lo = CreateSubspan(a, 0, 128);
+  auto* mid = CreateSubspan(a, 64, 128);
+  auto* hi = CreateSubspan(a, 128, 128);
+  Fill(lo);  // 0: [0, 128)
+  Barrier();
+  Fill(mid, 64, 64);  // 1: [128, 192)
+  Fill(mid, 0, 64);   // 2: [64, 128)
+  Barrier();
+  Copy(hi, 0, lo, 0, 64);  // 3: reads [128, 192), writes [0, 64)
+  EXPECT_EQ((Dependencies{{0, 2}, {0, 3}, {1, 3}}), EndAndQueryDependencies());
+}
+
+// Waiting on an event orders commands recorded before the signal with those
+// recorded after the wait but not those recorded between the two.
+TEST_F(TaskCommandBufferTest, Events) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  auto* c = CreateBuffer(256);
+  auto* d = CreateBuffer(256);
+  auto* event = CreateEvent();
+  Fill(a);  // 0
+  SignalEvent(event);
+  Fill(b);  // 1
+  WaitEvents({event});
+  Copy(a, c);  // 2
+  Copy(b, d);  // 3
+  EXPECT_EQ((Dependencies{{0, 2}}), EndAndQueryDependencies());
+}
+
+// Waiting on multiple events makes visible everything recorded before the
+// latest of the signals.
+TEST_F(TaskCommandBufferTest, MultipleEvents) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  auto* c = CreateBuffer(256);
+  auto* event0 = CreateEvent();
+  auto* event1 = CreateEvent();
+  Fill(a);  // 0
+  SignalEvent(event0);
+  Fill(b);  // 1
+  SignalEvent(event1);
+  Fill(c);  // 2
+  WaitEvents({event1, event0});
+  Fill(a);  // 3
+  Fill(b);  // 4
+  Fill(c);  // 5
+  EXPECT_EQ((Dependencies{{0, 3}, {1, 4}}), EndAndQueryDependencies());
+}
+
+// Waits on events that were reset or never signaled in the command buffer are
+// treated as barriers.
+TEST_F(TaskCommandBufferTest, UnsignaledEventsAreBarriers) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  auto* reset_event = CreateEvent();
+  auto* unknown_event = CreateEvent();
+  Fill(a);  // 0
+  SignalEvent(reset_event);
+  ResetEvent(reset_event);
+  Fill(b);  // 1
+  WaitEvents({reset_event});
+  Copy(b, a);  // 2
+  WaitEvents({unknown_event});
+  Fill(b);  // 3
+  EXPECT_EQ((Dependencies{{0, 2}, {1, 2}, {2, 3}}), EndAndQueryDependencies());
+}
+
+// Edges implied by a chain of other edges are omitted.
+TEST_F(TaskCommandBufferTest, TransitiveEdgesElided) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  Fill(a);  // 0
+  Barrier();
+  Copy(a, b);  // 1
+  Barrier();
+  Copy(b, a);  // 2: WAW with 0 is implied through 1
+  EXPECT_EQ((Dependencies{{0, 1}, {1, 2}}), EndAndQueryDependencies());
+}
+
+// A visible write covering an earlier access replaces it: later commands only
+// need to be ordered after the write.
+TEST_F(TaskCommandBufferTest, SupersededAccesses) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  Fill(a, 0, 128);  // 0
+  Barrier();
+  Fill(a);  // 1: overwrites 0
+  Barrier();
+  Copy(a, b);  // 2
+  Barrier();
+  Fill(a, 0, 64);  // 3
+  EXPECT_EQ((Dependencies{{0, 1}, {1, 2}, {2, 3}}), EndAndQueryDependencies());
+}
+
+// Writes that only partially cover an earlier access do not replace it.
+TEST_F(TaskCommandBufferTest, PartialOverwriteNotSuperseded) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  Fill(a);  // 0
+  Barrier();
+  Fill(a, 0, 128);  // 1
+  Barrier();
+  Copy(a, 128, b, 0, 128);  // 2: only reads bytes written by 0
+  EXPECT_EQ((Dependencies{{0, 1}, {0, 2}}), EndAndQueryDependencies());
+}
+
+// Writes that are not ordered after an access do not replace it.
+TEST_F(TaskCommandBufferTest, UnorderedOverwriteNotSuperseded) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  Fill(a, 0, 128);  // 0
+  Fill(a);          // 1
+  Barrier();
+  Copy(a, b);  // 2
+  EXPECT_EQ((Dependencies{{0, 2}, {1, 2}}), EndAndQueryDependencies());
+}
+
+// A superseding write only replaces the access once the write itself is
+// visible; until then commands must still be ordered after the access.
+TEST_F(TaskCommandBufferTest, SupersedingWriteNotYetVisible) {
+  auto* a = CreateBuffer(256);
+  auto* b = CreateBuffer(256);
+  auto* event = CreateEvent();
+  Fill(a);  // 0
+  Barrier();
+  SignalEvent(event);
+  Fill(a);  // 1: overwrites 0 after the signal
+  WaitEvents({event});
+  Copy(a, b);  // 2
+  EXPECT_EQ((Dependencies{{0, 1}, {0, 2}}), EndAndQueryDependencies());
+}
+
+// Records random command buffers and compares the resulting DAG against a
+// brute-force model of the recorded barriers and events: every conflicting
+// pair of commands ordered by a barrier or event must be connected by a path
+// in the DAG and every edge in the DAG must order such a pair.
+TEST_F(TaskCommandBufferTest, RandomAgainstModel) {
+  constexpr int kIterationCount = 2000;
+  constexpr int kAllocationCount = 4;
+  constexpr iree_device_size_t kAllocationSize = 4096;
+  constexpr iree_device_size_t kSubspanSize = 2048;
+  constexpr int kEventCount = 3;
+
+  struct Access {
+    int allocation;
+    iree_device_size_t offset;
+    iree_device_size_t length;
+    bool is_write;
+  };
+  auto conflicts = [](const std::vector<Access>& lhs,
+                      const std::vector<Access>& rhs) {
+    for (const auto& a : lhs) {
+      for (const auto& b : rhs) {
+        if (a.allocation == b.allocation && (a.is_write || b.is_write) &&
+            a.offset < b.offset + b.length && b.offset < a.offset + a.length) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  std::mt19937 rng(42);
+  auto uniform = [&](int n) {
+    return std::uniform_int_distribution<int>(0, n - 1)(rng);
+  };
+
+  iree_hal_event_t* events[kEventCount];
+  for (int i = 0; i < kEventCount; ++i) events[i] = CreateEvent();
+
+  for (int iteration = 0; iteration < kIterationCount; ++iteration) {
+    SCOPED_TRACE(iteration);
+    iree_hal_command_buffer_release(command_buffer_);
+    command_buffer_ = NULL;
+    IREE_ASSERT_OK(iree_hal_command_buffer_create(
+        device_, IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT,
+        IREE_HAL_COMMAND_CATEGORY_ANY, IREE_HAL_QUEUE_AFFINITY_ANY,
+        &command_buffer_));
+    IREE_ASSERT_OK(iree_hal_command_buffer_begin(command_buffer_));
+
+    iree_hal_buffer_t* allocations[kAllocationCount];
+    iree_hal_buffer_t* subspans[kAllocationCount];
+    iree_device_size_t subspan_offsets[kAllocationCount];
+    for (int i = 0; i < kAllocationCount; ++i) {
+      allocations[i] = CreateBuffer(kAllocationSize);
+      subspan_offsets[i] = 1024 * (i % 3);
+      subspans[i] =
+          CreateSubspan(allocations[i], subspan_offsets[i], kSubspanSize);
+    }
+
+    // Model state: commands with an index less than |visible_count| are
+    // ordered before any command recorded next. Events hold the command count
+    // at the time they were signaled or -1 if not signaled.
+    std::vector<std::vector<Access>> commands;
+    std::vector<size_t> visible_counts;
+    size_t visible_count = 0;
+    int signal_counts[kEventCount] = {-1, -1, -1};
+
+    int op_count = 1 + uniform(80);
+    for (int op = 0; op < op_count; ++op) {
+      switch (uniform(8)) {
+        case 0:
+          Barrier();
+          visible_count = commands.size();
+          break;
+        case 1: {
+          int event = uniform(kEventCount);
+          SignalEvent(events[event]);
+          signal_counts[event] = static_cast<int>(commands.size());
+          break;
+        }
+        case 2: {
+          int event0 = uniform(kEventCount);
+          int event1 = uniform(kEventCount);
+          WaitEvents({events[event0], events[event1]});
+          for (int event : {event0, event1}) {
+            size_t signal_count =
+                signal_counts[event] >= 0
+                    ? static_cast<size_t>(signal_counts[event])
+                    : commands.size();
+            visible_count = std::max(visible_count, signal_count);
+          }
+          break;
+        }
+        case 3: {
+          int event = uniform(kEventCount);
+          ResetEvent(events[event]);
+          signal_counts[event] = -1;
+          break;
+        }
+        default:
+          break;
+      }
+
+      int target = uniform(kAllocationCount);
+      bool use_subspan = uniform(2) != 0;
+      iree_device_size_t limit = use_subspan ? kSubspanSize : kAllocationSize;
+      iree_device_size_t length = 1 + uniform(1024);
+      iree_device_size_t offset = uniform(static_cast<int>(limit - length));
+      iree_hal_buffer_t* target_buffer =
+          use_subspan ? subspans[target] : allocations[target];
+      iree_device_size_t target_offset =
+          (use_subspan ? subspan_offsets[target] : 0) + offset;
+      std::vector<Access> accesses;
+      if (uniform(3) == 0) {
+        Fill(target_buffer, offset, length);
+      } else {
+        int source = (target + 1 + uniform(kAllocationCount - 1)) %
+                     kAllocationCount;
+        iree_device_size_t source_offset =
+            uniform(static_cast<int>(kAllocationSize - length));
+        Copy(allocations[source], source_offset, target_buffer, offset,
+             length);
+        accesses.push_back({source, source_offset, length, false});
+      }
+      accesses.push_back({target, target_offset, length, true});
+      commands.push_back(std::move(accesses));
+      visible_counts.push_back(visible_count);
+    }
+    if (HasFatalFailure()) return;
+
+    Dependencies dependencies = EndAndQueryDependencies();
+
+    // No edges beyond those required by the model.
+    for (const auto& dependency : dependencies) {
+      size_t i = dependency.first;
+      size_t j = dependency.second;
+      ASSERT_LT(i, j);
+      ASSERT_LT(j, commands.size());
+      EXPECT_TRUE(i < visible_counts[j] && conflicts(commands[i], commands[j]))
+          << "unneeded edge " << i << " -> " << j;
+    }
+
+    // All required orderings are reachable through the edges.
+    std::vector<std::vector<bool>> reachable(
+        commands.size(), std::vector<bool>(commands.size(), false));
+    for (const auto& dependency : dependencies) {
+      size_t i = dependency.first;
+      size_t j = dependency.second;
+      reachable[j][i] = true;
+      for (size_t k = 0; k < i; ++k) {
+        if (reachable[i][k]) reachable[j][k] = true;
+      }
+    }
+    for (size_t j = 0; j < commands.size(); ++j) {
+      for (size_t i = 0; i < j; ++i) {
+        if (i < visible_counts[j] && conflicts(commands[i], commands[j])) {
+          EXPECT_TRUE(reachable[j][i]) << "missing path " << i << " -> " << j;
+        }
+      }
+    }
+    if (HasFailure()) return;
+
+    for (auto* buffer : buffers_) iree_hal_buffer_release(buffer);
+    buffers_.clear();
+  }
+}
+
+}  // namespace
@@ -67,6 +67,9 @@ void iree_hal_task_device_params_initialize(
     iree_hal_task_device_params_t* out_params) {
   out_params->arena_block_size = 32 * 1024;
   out_params->queue_count = 8;
+  out_params->numa_node = IREE_NUMA_NODE_ANY;
+  out_params->pool_buffers = false;
+  iree_hal_heap_allocator_options_initialize(&out_params->heap_options);
 }
 
 static iree_status_t iree_hal_task_device_check_params(
@@ -139,8 +142,24 @@ iree_status_t iree_hal_task_device_create(
   }
 
   if (iree_status_is_ok(status)) {
-    status = iree_hal_allocator_create_heap(identifier, host_allocator,
-                                            &device->device_allocator);
+    // Device buffers are placed on the requested node while all other
+    // bookkeeping continues to use the host allocator.
+    iree_allocator_t buffer_allocator =
+        params->numa_node == IREE_NUMA_NODE_ANY
+            ? host_allocator
+            : iree_numa_node_allocator(params->numa_node);
+    status = iree_hal_allocator_create_heap_with_options(
+        identifier, &params->heap_options, buffer_allocator,
+        &device->device_allocator);
+  }
+
+  if (iree_status_is_ok(status) && params->pool_buffers) {
+    iree_hal_pooling_allocator_options_t pool_options;
+    iree_hal_pooling_allocator_options_initialize(&pool_options);
+    iree_hal_allocator_t* heap_allocator = device->device_allocator;
+    status = iree_hal_allocator_create_pooling(heap_allocator, &pool_options,
+                                               &device->device_allocator);
+    iree_hal_allocator_release(heap_allocator);
   }
 
   if (iree_status_is_ok(status)) {
@@ -158,6 +177,29 @@ iree_status_t iree_hal_task_device_create(
   return status;
 }
 
+bool iree_hal_task_device_isa(iree_hal_device_t* device) {
+  return iree_hal_resource_is(device, &iree_hal_task_device_vtable);
+}
+
+iree_status_t iree_hal_task_device_consume_dispatch_statistics(
+    iree_hal_device_t* base_device,
+    iree_task_dispatch_statistics_t* out_statistics) {
+  IREE_ASSERT_ARGUMENT(base_device);
+  IREE_ASSERT_ARGUMENT(out_statistics);
+  memset(out_statistics, 0, sizeof(*out_statistics));
+  if (!iree_hal_task_device_isa(base_device)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "device is not a task device");
+  }
+  iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
+  for (iree_host_size_t i = 0; i < device->queue_count; ++i) {
+    iree_task_dispatch_statistics_t queue_statistics =
+        iree_task_scope_consume_statistics(&device->queues[i].scope);
+    iree_task_dispatch_statistics_merge(&queue_statistics, out_statistics);
+  }
+  return iree_ok_status();
+}
+
 static void iree_hal_task_device_destroy(iree_hal_device_t* base_device) {
   iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
   iree_allocator_t host_allocator = iree_hal_device_host_allocator(base_device);
@@ -16,6 +16,7 @@
 #define IREE_HAL_LOCAL_TASK_DEVICE_H_
 
 #include "iree/base/api.h"
+#include "iree/base/internal/numa.h"
 #include "iree/hal/api.h"
 #include "iree/hal/local/executable_loader.h"
 #include "iree/task/executor.h"
@@ -36,6 +37,21 @@ typedef struct {
   // Larger sizes will lower overhead and ensure the heap isn't hit for
   // transient allocations while also increasing memory consumption.
   iree_host_size_t arena_block_size;
+
+  // NUMA node that device buffer allocations are placed on or
+  // IREE_NUMA_NODE_ANY to leave placement to the system (usually the node of
+  // the thread that first touches the memory). Devices should be paired with
+  // an executor whose workers are on the same node.
+  iree_numa_node_id_t numa_node;
+
+  // Pools device buffers such that steady-state execution (repeatedly invoking
+  // the same functions) does not allocate from the host heap. Released buffers
+  // are retained for reuse until the device is destroyed.
+  bool pool_buffers;
+
+  // Alignment of device buffer contents. Executables may assume their
+  // bindings are aligned to at least |heap_options.min_alignment|.
+  iree_hal_heap_allocator_options_t heap_options;
 } iree_hal_task_device_params_t;
 
 // Initializes |out_params| to default values.
@@ -51,6 +67,20 @@ iree_status_t iree_hal_task_device_create(
     iree_hal_executable_loader_t** loaders, iree_allocator_t host_allocator,
     iree_hal_device_t** out_device);
 
+// Returns true if |device| is an iree/task/-based device created with
+// iree_hal_task_device_create.
+bool iree_hal_task_device_isa(iree_hal_device_t* device);
+
+// Returns the statistics of all dispatches that have retired on any queue of
+// |device| since the last query and resets them. Callers wanting per-submission
+// statistics can wait for the submission to complete and then query.
+// Statistics may experience tearing if queried while dispatches are in-flight.
+//
+// Returns IREE_STATUS_INVALID_ARGUMENT if |device| is not a task device.
+iree_status_t iree_hal_task_device_consume_dispatch_statistics(
+    iree_hal_device_t* device,
+    iree_task_dispatch_statistics_t* out_statistics);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
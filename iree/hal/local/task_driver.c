@@ -14,10 +14,16 @@
 
 #include "iree/hal/local/task_driver.h"
 
+#include <inttypes.h>
+#include <stdio.h>
+
 #include "iree/base/tracing.h"
 
 #define IREE_HAL_TASK_DEVICE_ID_DEFAULT 0
 
+// Maximum length of a per-node device name ("node" + uint32_t).
+#define IREE_HAL_TASK_DEVICE_NAME_MAX_LENGTH 16
+
 typedef struct {
   iree_hal_resource_t resource;
   iree_allocator_t host_allocator;
@@ -25,7 +31,13 @@ typedef struct {
   iree_string_view_t identifier;
   iree_hal_task_device_params_t default_params;
 
-  iree_task_executor_t* executor;
+  // True if each executor is placed on the NUMA node in |node_ids| matching
+  // its index and devices should allocate from that node.
+  bool per_numa_node;
+
+  iree_host_size_t executor_count;
+  iree_task_executor_t** executors;
+  iree_numa_node_id_t* node_ids;
 
   iree_host_size_t loader_count;
   iree_hal_executable_loader_t* loaders[];
@@ -39,13 +51,15 @@ static iree_hal_task_driver_t* iree_hal_task_driver_cast(
   return (iree_hal_task_driver_t*)base_value;
 }
 
-iree_status_t iree_hal_task_driver_create(
+static iree_status_t iree_hal_task_driver_create_internal(
     iree_string_view_t identifier,
-    const iree_hal_task_device_params_t* default_params,
-    iree_task_executor_t* executor, iree_host_size_t loader_count,
+    const iree_hal_task_device_params_t* default_params, bool per_numa_node,
+    iree_host_size_t executor_count, iree_task_executor_t** executors,
+    const iree_numa_node_id_t* node_ids, iree_host_size_t loader_count,
     iree_hal_executable_loader_t** loaders, iree_allocator_t host_allocator,
     iree_hal_driver_t** out_driver) {
   IREE_ASSERT_ARGUMENT(default_params);
+  IREE_ASSERT_ARGUMENT(executor_count && executors && node_ids);
   IREE_ASSERT_ARGUMENT(!loader_count || loaders);
   IREE_ASSERT_ARGUMENT(out_driver);
   *out_driver = NULL;
@@ -54,6 +68,8 @@ iree_status_t iree_hal_task_driver_create(
   iree_hal_task_driver_t* driver = NULL;
   iree_host_size_t total_size = sizeof(*driver) +
                                 loader_count * sizeof(*driver->loaders) +
+                                executor_count * sizeof(*driver->executors) +
+                                executor_count * sizeof(*driver->node_ids) +
                                 identifier.size;
   iree_status_t status =
       iree_allocator_malloc(host_allocator, total_size, (void**)&driver);
@@ -68,8 +84,18 @@ iree_status_t iree_hal_task_driver_create(
     memcpy(&driver->default_params, default_params,
            sizeof(driver->default_params));
 
-    driver->executor = executor;
-    iree_task_executor_retain(driver->executor);
+    driver->per_numa_node = per_numa_node;
+    driver->executor_count = executor_count;
+    driver->executors =
+        (iree_task_executor_t**)((uint8_t*)driver + sizeof(*driver) +
+                                 loader_count * sizeof(*driver->loaders));
+    driver->node_ids =
+        (iree_numa_node_id_t*)(driver->executors + executor_count);
+    for (iree_host_size_t i = 0; i < driver->executor_count; ++i) {
+      driver->executors[i] = executors[i];
+      iree_task_executor_retain(driver->executors[i]);
+      driver->node_ids[i] = node_ids[i];
+    }
 
     driver->loader_count = loader_count;
     for (iree_host_size_t i = 0; i < driver->loader_count; ++i) {
@@ -87,6 +113,35 @@ iree_status_t iree_hal_task_driver_create(
   return status;
 }
 
+iree_status_t iree_hal_task_driver_create(
+    iree_string_view_t identifier,
+    const iree_hal_task_device_params_t* default_params,
+    iree_task_executor_t* executor, iree_host_size_t loader_count,
+    iree_hal_executable_loader_t** loaders, iree_allocator_t host_allocator,
+    iree_hal_driver_t** out_driver) {
+  IREE_ASSERT_ARGUMENT(executor);
+  const iree_numa_node_id_t node_id = default_params->numa_node;
+  return iree_hal_task_driver_create_internal(
+      identifier, default_params, /*per_numa_node=*/false, 1, &executor,
+      &node_id, loader_count, loaders, host_allocator, out_driver);
+}
+
+iree_status_t iree_hal_task_driver_create_per_numa_node(
+    iree_string_view_t identifier,
+    const iree_hal_task_device_params_t* default_params,
+    iree_host_size_t executor_count, iree_task_executor_t** executors,
+    const iree_numa_node_id_t* node_ids, iree_host_size_t loader_count,
+    iree_hal_executable_loader_t** loaders, iree_allocator_t host_allocator,
+    iree_hal_driver_t** out_driver) {
+  if (!executor_count) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "at least one executor is required");
+  }
+  return iree_hal_task_driver_create_internal(
+      identifier, default_params, /*per_numa_node=*/true, executor_count,
+      executors, node_ids, loader_count, loaders, host_allocator, out_driver);
+}
+
 static void iree_hal_task_driver_destroy(iree_hal_driver_t* base_driver) {
   iree_hal_task_driver_t* driver = iree_hal_task_driver_cast(base_driver);
   iree_allocator_t host_allocator = driver->host_allocator;
@@ -95,7 +150,9 @@ static void iree_hal_task_driver_destroy(iree_hal_driver_t* base_driver) {
   for (iree_host_size_t i = 0; i < driver->loader_count; ++i) {
     iree_hal_executable_loader_release(driver->loaders[i]);
   }
-  iree_task_executor_release(driver->executor);
+  for (iree_host_size_t i = 0; i < driver->executor_count; ++i) {
+    iree_task_executor_release(driver->executors[i]);
+  }
   iree_allocator_free(host_allocator, driver);
 
   IREE_TRACE_ZONE_END(z0);
@@ -105,24 +162,62 @@ static iree_status_t iree_hal_task_driver_query_available_devices(
     iree_hal_driver_t* base_driver, iree_allocator_t allocator,
     iree_hal_device_info_t** out_device_infos,
     iree_host_size_t* out_device_info_count) {
-  static const iree_hal_device_info_t device_infos[1] = {
-      {
-          .device_id = IREE_HAL_TASK_DEVICE_ID_DEFAULT,
-          .name = iree_string_view_literal("default"),
-      },
-  };
-  *out_device_info_count = IREE_ARRAYSIZE(device_infos);
-  return iree_allocator_clone(
-      allocator, iree_make_const_byte_span(device_infos, sizeof(device_infos)),
-      (void**)out_device_infos);
+  iree_hal_task_driver_t* driver = iree_hal_task_driver_cast(base_driver);
+  if (!driver->per_numa_node) {
+    static const iree_hal_device_info_t device_infos[1] = {
+        {
+            .device_id = IREE_HAL_TASK_DEVICE_ID_DEFAULT,
+            .name = iree_string_view_literal("default"),
+        },
+    };
+    *out_device_info_count = IREE_ARRAYSIZE(device_infos);
+    return iree_allocator_clone(
+        allocator,
+        iree_make_const_byte_span(device_infos, sizeof(device_infos)),
+        (void**)out_device_infos);
+  }
+
+  // One device per node with the names stored after the infos so that the
+  // caller can free everything with a single call.
+  iree_hal_device_info_t* device_infos = NULL;
+  iree_host_size_t total_size =
+      driver->executor_count *
+      (sizeof(*device_infos) + IREE_HAL_TASK_DEVICE_NAME_MAX_LENGTH);
+  IREE_RETURN_IF_ERROR(
+      iree_allocator_malloc(allocator, total_size, (void**)&device_infos));
+  char* name_buffer = (char*)(device_infos + driver->executor_count);
+  for (iree_host_size_t i = 0; i < driver->executor_count; ++i) {
+    char* name = name_buffer + i * IREE_HAL_TASK_DEVICE_NAME_MAX_LENGTH;
+    int name_length = snprintf(name, IREE_HAL_TASK_DEVICE_NAME_MAX_LENGTH,
+                               "node%u", (uint32_t)driver->node_ids[i]);
+    device_infos[i].device_id = i;
+    device_infos[i].name = iree_make_string_view(name, name_length);
+  }
+  *out_device_info_count = driver->executor_count;
+  *out_device_infos = device_infos;
+  return iree_ok_status();
 }
 
 static iree_status_t iree_hal_task_driver_create_device(
     iree_hal_driver_t* base_driver, iree_hal_device_id_t device_id,
     iree_allocator_t allocator, iree_hal_device_t** out_device) {
   iree_hal_task_driver_t* driver = iree_hal_task_driver_cast(base_driver);
+  if (!driver->per_numa_node) {
+    return iree_hal_task_device_create(
+        driver->identifier, &driver->default_params, driver->executors[0],
+        driver->loader_count, driver->loaders, allocator, out_device);
+  }
+
+  // The default device ID maps to the first node.
+  if (device_id >= driver->executor_count) {
+    return iree_make_status(IREE_STATUS_NOT_FOUND,
+                            "no device with ID %" PRIu64 " (%zu nodes)",
+                            (uint64_t)device_id, driver->executor_count);
+  }
+  iree_hal_task_device_params_t params = driver->default_params;
+  params.numa_node = driver->node_ids[device_id];
   return iree_hal_task_device_create(
-      driver->identifier, &driver->default_params, driver->executor,
+      driver->identifier, &params, driver->executors[device_id],
       driver->loader_count, driver->loaders, allocator, out_device);
 }
 
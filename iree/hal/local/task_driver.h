@@ -35,6 +35,23 @@ iree_status_t iree_hal_task_driver_create(
     iree_hal_executable_loader_t** loaders, iree_allocator_t host_allocator,
     iree_hal_driver_t** out_driver);
 
+// Creates a new iree/task/-based local CPU driver that exposes one device per
+// NUMA node. |executors| contains one executor per node, such as created from
+// topologies initialized with
+// iree_task_topology_initialize_from_unique_l2_cache_groups_on_numa_node, and
+// |node_ids| the node each executor is placed on. Nodes need not be contiguous
+// (see iree_numa_query_cpu_nodes) and device IDs are indices into the arrays
+// while device names carry the node ID ("node2"). Devices allocate their
+// buffers from the memory attached to the node such that each executor and
+// allocator pair only touches local memory. The default device is index 0.
+iree_status_t iree_hal_task_driver_create_per_numa_node(
+    iree_string_view_t identifier,
+    const iree_hal_task_device_params_t* default_params,
+    iree_host_size_t executor_count, iree_task_executor_t** executors,
+    const iree_numa_node_id_t* node_ids, iree_host_size_t loader_count,
+    iree_hal_executable_loader_t** loaders,
+    iree_allocator_t host_allocator, iree_hal_driver_t** out_driver);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
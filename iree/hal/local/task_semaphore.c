@@ -18,6 +18,7 @@
 
 #include "iree/base/internal/wait_handle.h"
 #include "iree/base/synchronization.h"
+#include "iree/base/threading.h"
 #include "iree/base/tracing.h"
 
 // Sentinel used the semaphore has failed and an error status is set.
@@ -87,6 +88,7 @@ static void iree_hal_task_timepoint_list_erase(
     iree_hal_task_timepoint_list_t* list,
     iree_hal_task_timepoint_t* timepoint) {
   if (timepoint->prev != NULL) timepoint->prev->next = timepoint->next;
+  if (timepoint->next != NULL) timepoint->next->prev = timepoint->prev;
   if (timepoint == list->head) list->head = timepoint->next;
   if (timepoint == list->tail) list->tail = timepoint->prev;
   timepoint->prev = NULL;
@@ -317,6 +319,36 @@ static iree_status_t iree_hal_task_semaphore_acquire_timepoint(
   return iree_ok_status();
 }
 
+// Returns true if |semaphore| has reached |minimum_value| (or failed).
+static bool iree_hal_task_semaphore_has_reached(
+    iree_hal_task_semaphore_t* semaphore, uint64_t minimum_value) {
+  iree_slim_mutex_lock(&semaphore->mutex);
+  bool has_reached = semaphore->current_value >= minimum_value;
+  iree_slim_mutex_unlock(&semaphore->mutex);
+  return has_reached;
+}
+
+// Cancels a timepoint acquired by iree_hal_task_semaphore_acquire_timepoint
+// that may not have been reached. Upon return the semaphore will no longer
+// reference the timepoint and its event can be released.
+static void iree_hal_task_semaphore_cancel_timepoint(
+    iree_hal_task_semaphore_t* semaphore,
+    iree_hal_task_timepoint_t* timepoint) {
+  iree_slim_mutex_lock(&semaphore->mutex);
+  bool has_reached = semaphore->current_value >= timepoint->payload_value;
+  if (!has_reached) {
+    iree_hal_task_timepoint_list_erase(&semaphore->timepoint_list, timepoint);
+  }
+  iree_slim_mutex_unlock(&semaphore->mutex);
+  if (has_reached) {
+    // The timepoint was taken by a signal/fail that may still be notifying it
+    // outside of the lock; wait for the notification so that the event isn't
+    // set after it has been returned to the pool.
+    IREE_IGNORE_ERROR(
+        iree_wait_one(&timepoint->event, IREE_TIME_INFINITE_FUTURE));
+  }
+}
+
 typedef struct {
   iree_task_wait_t task;
   iree_hal_task_semaphore_t* semaphore;
@@ -382,23 +414,34 @@ static iree_status_t iree_hal_task_semaphore_wait_with_deadline(
   iree_hal_task_semaphore_t* semaphore =
       iree_hal_task_semaphore_cast(base_semaphore);
 
-  iree_slim_mutex_lock(&semaphore->mutex);
-
-  if (semaphore->current_value >= value) {
+  if (iree_hal_task_semaphore_has_reached(semaphore, value)) {
     // Fast path: already satisfied.
-    iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_ok_status();
   } else if (deadline_ns == IREE_TIME_INFINITE_PAST) {
     // Not satisfied but a poll, so can avoid the expensive wait handle work.
-    iree_slim_mutex_unlock(&semaphore->mutex);
     return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
   }
 
+  // Spin for a short while in case the signal is imminent; this avoids the
+  // event round-trip through the kernel when waiting on short dispatches.
+  iree_time_t spin_deadline_ns = iree_min(
+      deadline_ns, iree_time_now() + IREE_HAL_TASK_SEMAPHORE_SPIN_DURATION_NS);
+  while (iree_time_now() < spin_deadline_ns) {
+    if (iree_hal_task_semaphore_has_reached(semaphore, value)) {
+      return iree_ok_status();
+    }
+    iree_thread_yield();
+  }
+
   // Slow path: acquire a timepoint while we hold the lock.
+  iree_slim_mutex_lock(&semaphore->mutex);
+  if (semaphore->current_value >= value) {
+    iree_slim_mutex_unlock(&semaphore->mutex);
+    return iree_ok_status();
+  }
   iree_hal_task_timepoint_t timepoint;
   iree_status_t status =
       iree_hal_task_semaphore_acquire_timepoint(semaphore, value, &timepoint);
-
   iree_slim_mutex_unlock(&semaphore->mutex);
   if (IREE_UNLIKELY(!iree_status_is_ok(status))) return status;
 
@@ -407,9 +450,7 @@ static iree_status_t iree_hal_task_semaphore_wait_with_deadline(
   // the deadline is reached before satisfied then we have to clean it up.
   status = iree_wait_one(&timepoint.event, deadline_ns);
   if (!iree_status_is_ok(status)) {
-    iree_slim_mutex_lock(&semaphore->mutex);
-    iree_hal_task_timepoint_list_erase(&semaphore->timepoint_list, &timepoint);
-    iree_slim_mutex_unlock(&semaphore->mutex);
+    iree_hal_task_semaphore_cancel_timepoint(semaphore, &timepoint);
   }
   iree_hal_local_event_pool_release(semaphore->event_pool, 1, &timepoint.event);
   return status;
@@ -422,6 +463,36 @@ static iree_status_t iree_hal_task_semaphore_wait_with_timeout(
       base_semaphore, value, iree_relative_timeout_to_deadline_ns(timeout_ns));
 }
 
+// Polls the semaphores at |pending_indices| in |semaphore_list| and returns
+// true if the wait is satisfied based on |wait_mode|. In
+// IREE_HAL_WAIT_MODE_ALL reached semaphores are removed from |pending_indices|
+// so that they aren't polled again.
+static bool iree_hal_task_semaphore_list_poll(
+    iree_hal_wait_mode_t wait_mode,
+    const iree_hal_semaphore_list_t* semaphore_list,
+    iree_host_size_t* pending_indices, iree_host_size_t* pending_count) {
+  iree_host_size_t new_pending_count = 0;
+  for (iree_host_size_t i = 0; i < *pending_count; ++i) {
+    iree_host_size_t index = pending_indices[i];
+    iree_hal_task_semaphore_t* semaphore =
+        iree_hal_task_semaphore_cast(semaphore_list->semaphores[index]);
+    if (iree_hal_task_semaphore_has_reached(
+            semaphore, semaphore_list->payload_values[index])) {
+      if (wait_mode == IREE_HAL_WAIT_MODE_ANY) return true;
+    } else {
+      pending_indices[new_pending_count++] = index;
+    }
+  }
+  *pending_count = new_pending_count;
+  return new_pending_count == 0;
+}
+
+// A timepoint reserved on a semaphore by a multi-wait.
+typedef struct {
+  iree_hal_task_semaphore_t* semaphore;
+  iree_hal_task_timepoint_t timepoint;
+} iree_hal_task_semaphore_multi_wait_entry_t;
+
 iree_status_t iree_hal_task_semaphore_multi_wait(
     iree_hal_wait_mode_t wait_mode,
     const iree_hal_semaphore_list_t* semaphore_list, iree_time_t deadline_ns,
@@ -439,62 +510,117 @@ iree_status_t iree_hal_task_semaphore_multi_wait(
 
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Avoid heap allocations by using the device block pool for the wait set.
+  // Avoid heap allocations by using the device block pool for the wait state.
   iree_arena_allocator_t arena;
   iree_arena_initialize(block_pool, &arena);
-  iree_wait_set_t* wait_set = NULL;
-  iree_status_t status = iree_wait_set_allocate(
-      semaphore_list->count, iree_arena_allocator(&arena), &wait_set);
-
-  // Acquire a wait handle for each semaphore timepoint we are to wait on.
-  // TODO(benvanik): flip this API around so we can batch request events from
-  // the event pool. We should be acquiring all required time points in one
-  // call.
-  iree_host_size_t timepoint_count = 0;
-  iree_hal_task_timepoint_t* timepoints = NULL;
-  iree_host_size_t total_timepoint_size =
-      semaphore_list->count * sizeof(timepoints[0]);
-  status =
-      iree_arena_allocate(&arena, total_timepoint_size, (void**)&timepoints);
+
+  // Track which semaphores have not yet been reached so that we only acquire
+  // timepoints for those.
+  iree_host_size_t pending_count = semaphore_list->count;
+  iree_host_size_t* pending_indices = NULL;
+  iree_status_t status = iree_arena_allocate(
+      &arena, pending_count * sizeof(pending_indices[0]),
+      (void**)&pending_indices);
+  bool is_satisfied = false;
   if (iree_status_is_ok(status)) {
-    memset(timepoints, 0, total_timepoint_size);
-    for (iree_host_size_t i = 0; i < semaphore_list->count; ++i) {
+    for (iree_host_size_t i = 0; i < pending_count; ++i) {
+      pending_indices[i] = i;
+    }
+    is_satisfied = iree_hal_task_semaphore_list_poll(
+        wait_mode, semaphore_list, pending_indices, &pending_count);
+  }
+
+  // Spin for a short while in case the signals are imminent; this avoids the
+  // event round-trip through the kernel when waiting on short dispatches.
+  if (iree_status_is_ok(status) && !is_satisfied &&
+      deadline_ns != IREE_TIME_INFINITE_PAST) {
+    iree_time_t spin_deadline_ns =
+        iree_min(deadline_ns,
+                 iree_time_now() + IREE_HAL_TASK_SEMAPHORE_SPIN_DURATION_NS);
+    while (!is_satisfied && iree_time_now() < spin_deadline_ns) {
+      iree_thread_yield();
+      is_satisfied = iree_hal_task_semaphore_list_poll(
+          wait_mode, semaphore_list, pending_indices, &pending_count);
+    }
+  }
+  if (iree_status_is_ok(status) && !is_satisfied &&
+      deadline_ns == IREE_TIME_INFINITE_PAST) {
+    // Not satisfied but a poll, so can avoid the expensive wait handle work.
+    status = iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+  }
+
+  // Slow path: acquire all of the events we need from the pool in one batch
+  // and reserve a timepoint on each semaphore still pending.
+  iree_event_t* events = NULL;
+  iree_hal_task_semaphore_multi_wait_entry_t* entries = NULL;
+  iree_host_size_t entry_count = 0;
+  iree_wait_set_t* wait_set = NULL;
+  bool has_events = false;
+  if (iree_status_is_ok(status) && !is_satisfied) {
+    status = iree_arena_allocate(&arena, pending_count * sizeof(events[0]),
+                                 (void**)&events);
+    if (iree_status_is_ok(status)) {
+      status = iree_arena_allocate(
+          &arena, pending_count * sizeof(entries[0]), (void**)&entries);
+    }
+    if (iree_status_is_ok(status)) {
+      status = iree_wait_set_allocate(
+          pending_count, iree_arena_allocator(&arena), &wait_set);
+    }
+    if (iree_status_is_ok(status)) {
+      status = iree_hal_local_event_pool_acquire(event_pool, pending_count,
+                                                 events);
+      has_events = iree_status_is_ok(status);
+    }
+    for (iree_host_size_t i = 0;
+         iree_status_is_ok(status) && !is_satisfied && i < pending_count;
+         ++i) {
+      iree_host_size_t index = pending_indices[i];
       iree_hal_task_semaphore_t* semaphore =
-          iree_hal_task_semaphore_cast(semaphore_list->semaphores[i]);
+          iree_hal_task_semaphore_cast(semaphore_list->semaphores[index]);
+      uint64_t payload_value = semaphore_list->payload_values[index];
       iree_slim_mutex_lock(&semaphore->mutex);
-      if (semaphore->current_value >= semaphore_list->payload_values[i]) {
-        // Fast path: already satisfied.
+      if (semaphore->current_value >= payload_value) {
+        // Reached since we last polled.
+        is_satisfied = wait_mode == IREE_HAL_WAIT_MODE_ANY;
       } else {
-        // Slow path: get a native wait handle for the timepoint.
-        iree_hal_task_timepoint_t* timepoint = &timepoints[timepoint_count++];
-        status = iree_hal_task_semaphore_acquire_timepoint(
-            semaphore, semaphore_list->payload_values[i], timepoint);
-        if (iree_status_is_ok(status)) {
-          status = iree_wait_set_insert(wait_set, timepoint->event);
-        }
+        iree_hal_task_semaphore_multi_wait_entry_t* entry =
+            &entries[entry_count++];
+        memset(entry, 0, sizeof(*entry));
+        entry->semaphore = semaphore;
+        entry->timepoint.payload_value = payload_value;
+        entry->timepoint.event = events[i];
+        iree_hal_task_timepoint_list_append(&semaphore->timepoint_list,
+                                            &entry->timepoint);
+        status = iree_wait_set_insert(wait_set, entry->timepoint.event);
       }
       iree_slim_mutex_unlock(&semaphore->mutex);
-      if (!iree_status_is_ok(status)) break;
     }
   }
 
   // Perform the wait.
-  if (iree_status_is_ok(status)) {
+  bool all_timepoints_reached = false;
+  if (iree_status_is_ok(status) && !is_satisfied && entry_count > 0) {
     if (wait_mode == IREE_HAL_WAIT_MODE_ANY) {
       status = iree_wait_any(wait_set, deadline_ns, /*out_wake_handle=*/NULL);
     } else {
       status = iree_wait_all(wait_set, deadline_ns);
+      all_timepoints_reached = iree_status_is_ok(status);
     }
   }
 
-  if (timepoints != NULL) {
-    // TODO(benvanik): if we flip the API to multi-acquire events from the pool
-    // above then we can multi-release here too.
-    for (iree_host_size_t i = 0; i < timepoint_count; ++i) {
-      iree_hal_local_event_pool_release(event_pool, 1, &timepoints[i].event);
+  // Scrub any timepoints that may still be referenced by their semaphores
+  // before the events are returned to the pool in one batch.
+  if (!all_timepoints_reached) {
+    for (iree_host_size_t i = 0; i < entry_count; ++i) {
+      iree_hal_task_semaphore_cancel_timepoint(entries[i].semaphore,
+                                               &entries[i].timepoint);
     }
   }
-  iree_wait_set_free(wait_set);
+  if (has_events) {
+    iree_hal_local_event_pool_release(event_pool, pending_count, events);
+  }
+  if (wait_set != NULL) iree_wait_set_free(wait_set);
   iree_arena_deinitialize(&arena);
 
   IREE_TRACE_ZONE_END(z0);
@@ -26,6 +26,14 @@
 extern "C" {
 #endif  // __cplusplus
 
+// Duration in nanoseconds that host waits poll semaphores before blocking on
+// wait handles. Spinning avoids the kernel round-trip when the signal is
+// imminent (such as when waiting on short dispatches) at the cost of burning
+// the waiting thread's core. Set to 0 to always block immediately.
+#if !defined(IREE_HAL_TASK_SEMAPHORE_SPIN_DURATION_NS)
+#define IREE_HAL_TASK_SEMAPHORE_SPIN_DURATION_NS 10000
+#endif  // !IREE_HAL_TASK_SEMAPHORE_SPIN_DURATION_NS
+
 // Creates a semaphore that integrates with the task system to allow for
 // pipelined wait and signal operations.
 iree_status_t iree_hal_task_semaphore_create(
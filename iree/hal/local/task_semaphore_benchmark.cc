@@ -0,0 +1,152 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures host waits on task semaphores as performed when waiting on many
+// submissions at once.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/hal/api.h"
+#include "iree/hal/local/task_device.h"
+#include "iree/task/executor.h"
+#include "iree/task/topology.h"
+
+namespace {
+
+// Creates a task device with no executable loaders. Semaphores don't use the
+// executor so a single worker is enough.
+iree_hal_device_t* CreateDevice() {
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(1, &topology);
+  iree_task_executor_t* executor = NULL;
+  IREE_CHECK_OK(iree_task_executor_create(IREE_TASK_SCHEDULING_MODE_RESERVED,
+                                          &topology, iree_allocator_system(),
+                                          &executor));
+  iree_task_topology_deinitialize(&topology);
+
+  iree_hal_task_device_params_t params;
+  iree_hal_task_device_params_initialize(&params);
+  iree_hal_device_t* device = NULL;
+  IREE_CHECK_OK(iree_hal_task_device_create(
+      iree_make_cstring_view("benchmark"), &params, executor,
+      /*loader_count=*/0, /*loaders=*/NULL, iree_allocator_system(), &device));
+  iree_task_executor_release(executor);
+  return device;
+}
+
+std::vector<iree_hal_semaphore_t*> CreateSemaphores(iree_hal_device_t* device,
+                                                    int count) {
+  std::vector<iree_hal_semaphore_t*> semaphores(count);
+  for (auto& semaphore : semaphores) {
+    IREE_CHECK_OK(iree_hal_semaphore_create(device, 0ull, &semaphore));
+  }
+  return semaphores;
+}
+
+// Measures the cost of waiting on semaphores that have already been signaled.
+//
+// Arguments: [semaphore_count]
+void BM_WaitSignaled(benchmark::State& state) {
+  int semaphore_count = (int)state.range(0);
+  iree_hal_device_t* device = CreateDevice();
+  auto semaphores = CreateSemaphores(device, semaphore_count);
+  std::vector<uint64_t> payload_values(semaphore_count, 1ull);
+  for (auto* semaphore : semaphores) {
+    IREE_CHECK_OK(iree_hal_semaphore_signal(semaphore, 1ull));
+  }
+  iree_hal_semaphore_list_t semaphore_list = {
+      (iree_host_size_t)semaphore_count, semaphores.data(),
+      payload_values.data()};
+
+  for (auto _ : state) {
+    IREE_CHECK_OK(iree_hal_device_wait_semaphores_with_deadline(
+        device, IREE_HAL_WAIT_MODE_ALL, &semaphore_list,
+        IREE_TIME_INFINITE_FUTURE));
+  }
+
+  for (auto* semaphore : semaphores) iree_hal_semaphore_release(semaphore);
+  iree_hal_device_release(device);
+}
+BENCHMARK(BM_WaitSignaled)->ArgNames({"semaphores"})->Arg(1)->Arg(8)->Arg(64);
+
+// Measures the latency from a wait being requested to the waiter waking when
+// the semaphores are signaled from another thread. Each iteration the waiter
+// signals a request semaphore and then blocks on |semaphore_count| semaphores
+// that the signaling thread signals in response. In ANY mode only the last
+// semaphore is signaled.
+//
+// Arguments: [semaphore_count, wait_any]
+void BM_WaitWake(benchmark::State& state) {
+  int semaphore_count = (int)state.range(0);
+  bool wait_any = state.range(1) != 0;
+  iree_hal_device_t* device = CreateDevice();
+  auto semaphores = CreateSemaphores(device, semaphore_count);
+  std::vector<uint64_t> payload_values(semaphore_count, 0ull);
+  iree_hal_semaphore_list_t semaphore_list = {
+      (iree_host_size_t)semaphore_count, semaphores.data(),
+      payload_values.data()};
+  iree_hal_semaphore_t* request_semaphore = NULL;
+  IREE_CHECK_OK(iree_hal_semaphore_create(device, 0ull, &request_semaphore));
+
+  std::atomic<bool> stop{false};
+  std::thread signaler([&]() {
+    for (uint64_t value = 1;; ++value) {
+      IREE_CHECK_OK(iree_hal_semaphore_wait_with_deadline(
+          request_semaphore, value, IREE_TIME_INFINITE_FUTURE));
+      if (stop.load()) break;
+      if (wait_any) {
+        IREE_CHECK_OK(iree_hal_semaphore_signal(semaphores.back(), value));
+      } else {
+        for (auto* semaphore : semaphores) {
+          IREE_CHECK_OK(iree_hal_semaphore_signal(semaphore, value));
+        }
+      }
+    }
+  });
+
+  uint64_t value = 0;
+  for (auto _ : state) {
+    ++value;
+    for (auto& payload_value : payload_values) payload_value = value;
+    IREE_CHECK_OK(iree_hal_semaphore_signal(request_semaphore, value));
+    IREE_CHECK_OK(iree_hal_device_wait_semaphores_with_deadline(
+        device,
+        wait_any ? IREE_HAL_WAIT_MODE_ANY : IREE_HAL_WAIT_MODE_ALL,
+        &semaphore_list, IREE_TIME_INFINITE_FUTURE));
+  }
+
+  stop.store(true);
+  IREE_CHECK_OK(iree_hal_semaphore_signal(request_semaphore, value + 1));
+  signaler.join();
+
+  iree_hal_semaphore_release(request_semaphore);
+  for (auto* semaphore : semaphores) iree_hal_semaphore_release(semaphore);
+  iree_hal_device_release(device);
+}
+BENCHMARK(BM_WaitWake)
+    ->ArgNames({"semaphores", "any"})
+    ->Args({1, 0})
+    ->Args({8, 0})
+    ->Args({64, 0})
+    ->Args({8, 1})
+    ->Args({64, 1})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
@@ -0,0 +1,216 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/hal/api.h"
+#include "iree/hal/local/task_device.h"
+#include "iree/task/executor.h"
+#include "iree/task/topology.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+// Long enough for a waiter thread to get past the spin and block on its
+// timepoint event.
+constexpr std::chrono::milliseconds kBlockDelay(20);
+
+class TaskSemaphoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    iree_task_topology_t topology;
+    iree_task_topology_initialize_from_group_count(1, &topology);
+    iree_task_executor_t* executor = NULL;
+    IREE_ASSERT_OK(iree_task_executor_create(
+        IREE_TASK_SCHEDULING_MODE_RESERVED, &topology, iree_allocator_system(),
+        &executor));
+    iree_task_topology_deinitialize(&topology);
+
+    iree_hal_task_device_params_t params;
+    iree_hal_task_device_params_initialize(&params);
+    IREE_ASSERT_OK(iree_hal_task_device_create(
+        iree_make_cstring_view("test"), &params, executor,
+        /*loader_count=*/0, /*loaders=*/NULL, iree_allocator_system(),
+        &device_));
+    iree_task_executor_release(executor);
+  }
+
+  void TearDown() override {
+    for (auto* semaphore : semaphores_) iree_hal_semaphore_release(semaphore);
+    iree_hal_device_release(device_);
+  }
+
+  iree_hal_semaphore_t* CreateSemaphore() {
+    iree_hal_semaphore_t* semaphore = NULL;
+    IREE_CHECK_OK(iree_hal_semaphore_create(device_, 0ull, &semaphore));
+    semaphores_.push_back(semaphore);
+    return semaphore;
+  }
+
+  iree_status_t WaitSemaphores(iree_hal_wait_mode_t wait_mode,
+                               std::vector<iree_hal_semaphore_t*> semaphores,
+                               uint64_t payload_value,
+                               iree_time_t deadline_ns) {
+    std::vector<uint64_t> payload_values(semaphores.size(), payload_value);
+    iree_hal_semaphore_list_t semaphore_list = {
+        semaphores.size(), semaphores.data(), payload_values.data()};
+    return iree_hal_device_wait_semaphores_with_deadline(
+        device_, wait_mode, &semaphore_list, deadline_ns);
+  }
+
+  uint64_t Query(iree_hal_semaphore_t* semaphore) {
+    uint64_t value = 0;
+    iree_status_ignore(iree_hal_semaphore_query(semaphore, &value));
+    return value;
+  }
+
+  iree_hal_device_t* device_ = NULL;
+  std::vector<iree_hal_semaphore_t*> semaphores_;
+};
+
+// A multi-wait that times out must remove its timepoints from the semaphores
+// before returning their events to the pool; the signal that follows would
+// otherwise set events now owned by other waiters.
+TEST_F(TaskSemaphoreTest, TimedOutMultiWaitThenSignal) {
+  auto* a = CreateSemaphore();
+  auto* b = CreateSemaphore();
+  EXPECT_EQ(IREE_STATUS_DEADLINE_EXCEEDED,
+            iree_status_consume_code(WaitSemaphores(
+                IREE_HAL_WAIT_MODE_ALL, {a, b}, 1ull,
+                iree_relative_timeout_to_deadline_ns(1000000))));
+
+  // A wait on unrelated semaphores reuses the pooled events and wait state.
+  // Signaling the first semaphores must not wake it.
+  auto* c = CreateSemaphore();
+  auto* d = CreateSemaphore();
+  std::thread first_signaler([&]() {
+    std::this_thread::sleep_for(kBlockDelay);
+    IREE_CHECK_OK(iree_hal_semaphore_signal(a, 1ull));
+    IREE_CHECK_OK(iree_hal_semaphore_signal(b, 1ull));
+  });
+  EXPECT_EQ(IREE_STATUS_DEADLINE_EXCEEDED,
+            iree_status_consume_code(WaitSemaphores(
+                IREE_HAL_WAIT_MODE_ALL, {c, d}, 1ull,
+                iree_relative_timeout_to_deadline_ns(100000000))));
+  first_signaler.join();
+  IREE_EXPECT_OK(WaitSemaphores(IREE_HAL_WAIT_MODE_ALL, {a, b}, 1ull,
+                                IREE_TIME_INFINITE_FUTURE));
+
+  // The recycled events must still work for a subsequent blocking wait.
+  std::thread second_signaler([&]() {
+    std::this_thread::sleep_for(kBlockDelay);
+    IREE_CHECK_OK(iree_hal_semaphore_signal(a, 2ull));
+    IREE_CHECK_OK(iree_hal_semaphore_signal(b, 2ull));
+  });
+  IREE_EXPECT_OK(WaitSemaphores(IREE_HAL_WAIT_MODE_ALL, {a, b}, 2ull,
+                                IREE_TIME_INFINITE_FUTURE));
+  second_signaler.join();
+}
+
+// An ANY wait satisfied by one semaphore leaves timepoints on the others that
+// must be cancelled before they are later signaled or failed.
+TEST_F(TaskSemaphoreTest, WaitAnyThenSignalOthers) {
+  auto* a = CreateSemaphore();
+  auto* b = CreateSemaphore();
+  auto* c = CreateSemaphore();
+  std::thread signaler([&]() {
+    std::this_thread::sleep_for(kBlockDelay);
+    IREE_CHECK_OK(iree_hal_semaphore_signal(b, 1ull));
+  });
+  IREE_EXPECT_OK(WaitSemaphores(IREE_HAL_WAIT_MODE_ANY, {a, b, c}, 1ull,
+                                IREE_TIME_INFINITE_FUTURE));
+  signaler.join();
+
+  IREE_ASSERT_OK(iree_hal_semaphore_signal(a, 1ull));
+  iree_hal_semaphore_fail(c, iree_status_from_code(IREE_STATUS_CANCELLED));
+  EXPECT_EQ(1ull, Query(a));
+  uint64_t value = 0;
+  EXPECT_EQ(IREE_STATUS_CANCELLED,
+            iree_status_consume_code(iree_hal_semaphore_query(c, &value)));
+
+  // The pool events used by the ANY wait must not have been left set.
+  auto* d = CreateSemaphore();
+  EXPECT_EQ(IREE_STATUS_DEADLINE_EXCEEDED,
+            iree_status_consume_code(WaitSemaphores(
+                IREE_HAL_WAIT_MODE_ANY, {b, d}, 2ull,
+                iree_relative_timeout_to_deadline_ns(1000000))));
+}
+
+// An ANY wait that times out must cancel the timepoints on all semaphores.
+TEST_F(TaskSemaphoreTest, TimedOutWaitAnyThenFail) {
+  auto* a = CreateSemaphore();
+  auto* b = CreateSemaphore();
+  EXPECT_EQ(IREE_STATUS_DEADLINE_EXCEEDED,
+            iree_status_consume_code(WaitSemaphores(
+                IREE_HAL_WAIT_MODE_ANY, {a, b}, 1ull,
+                iree_relative_timeout_to_deadline_ns(1000000))));
+
+  // Failing and signaling the first semaphores must not wake an unrelated
+  // wait that reuses the pooled events and wait state.
+  auto* c = CreateSemaphore();
+  auto* d = CreateSemaphore();
+  std::thread signaler([&]() {
+    std::this_thread::sleep_for(kBlockDelay);
+    iree_hal_semaphore_fail(a, iree_status_from_code(IREE_STATUS_CANCELLED));
+    IREE_CHECK_OK(iree_hal_semaphore_signal(b, 1ull));
+  });
+  EXPECT_EQ(IREE_STATUS_DEADLINE_EXCEEDED,
+            iree_status_consume_code(WaitSemaphores(
+                IREE_HAL_WAIT_MODE_ANY, {c, d}, 1ull,
+                iree_relative_timeout_to_deadline_ns(100000000))));
+  signaler.join();
+  EXPECT_EQ(1ull, Query(b));
+}
+
+// Waiters append timepoints to the semaphore list in order; waiters in the
+// middle and at the end timing out must erase their timepoints without leaving
+// their neighbors linked to them. Waiters added afterward must still be found
+// by the signal.
+TEST_F(TaskSemaphoreTest, EraseMiddleTimepoint) {
+  auto* semaphore = CreateSemaphore();
+  auto wait_for_timeout = [&](uint64_t value, iree_duration_t timeout_ns) {
+    iree_status_t status = iree_hal_semaphore_wait_with_deadline(
+        semaphore, value, iree_relative_timeout_to_deadline_ns(timeout_ns));
+    IREE_CHECK(iree_status_is_deadline_exceeded(status));
+    iree_status_ignore(status);
+  };
+  std::thread first([&]() {
+    IREE_CHECK_OK(iree_hal_semaphore_wait_with_deadline(
+        semaphore, 1ull, IREE_TIME_INFINITE_FUTURE));
+  });
+  std::this_thread::sleep_for(kBlockDelay);
+  std::thread middle(wait_for_timeout, 2ull, 50000000);
+  std::this_thread::sleep_for(kBlockDelay);
+  std::thread last(wait_for_timeout, 3ull, 100000000);
+  middle.join();
+  last.join();
+
+  iree_status_t late_status = iree_ok_status();
+  std::thread late([&]() {
+    late_status = iree_hal_semaphore_wait_with_deadline(
+        semaphore, 1ull, iree_relative_timeout_to_deadline_ns(2000000000));
+  });
+  std::this_thread::sleep_for(kBlockDelay);
+  IREE_ASSERT_OK(iree_hal_semaphore_signal(semaphore, 1ull));
+  first.join();
+  late.join();
+  IREE_EXPECT_OK(late_status);
+}
+
+}  // namespace
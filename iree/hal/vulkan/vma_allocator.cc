@@ -125,6 +125,13 @@ static iree_allocator_t iree_hal_vulkan_vma_allocator_host_allocator(
   return allocator->host_allocator;
 }
 
+static iree_device_size_t iree_hal_vulkan_vma_allocator_query_buffer_alignment(
+    const iree_hal_allocator_t* base_allocator) {
+  // VMA places allocations at the alignment required by each buffer's
+  // VkMemoryRequirements, which has no minimum we can promise up front.
+  return 1;
+}
+
 static iree_hal_buffer_compatibility_t
 iree_hal_vulkan_vma_allocator_query_buffer_compatibility(
     iree_hal_allocator_t* base_allocator, iree_hal_memory_type_t memory_type,
@@ -280,6 +287,8 @@ static iree_status_t iree_hal_vulkan_vma_allocator_wrap_buffer(
 const iree_hal_allocator_vtable_t iree_hal_vulkan_vma_allocator_vtable = {
     /*.destroy=*/iree_hal_vulkan_vma_allocator_destroy,
     /*.host_allocator=*/iree_hal_vulkan_vma_allocator_host_allocator,
+    /*.query_buffer_alignment=*/
+    iree_hal_vulkan_vma_allocator_query_buffer_alignment,
     /*.query_buffer_compatibility = */
     iree_hal_vulkan_vma_allocator_query_buffer_compatibility,
     /*.allocate_buffer=*/iree_hal_vulkan_vma_allocator_allocate_buffer,
@@ -165,6 +165,39 @@ iree_hal_module_alloc_state(void* self, iree_allocator_t host_allocator,
   return iree_ok_status();
 }
 
+// Forked states share the executable cache of the parent such that
+// executables prepared by the parent context remain cached for all forks.
+static iree_status_t IREE_API_PTR
+iree_hal_module_fork_state(void* self,
+                           iree_vm_module_state_t* parent_module_state,
+                           iree_allocator_t host_allocator,
+                           iree_vm_module_state_t** out_module_state) {
+  iree_hal_module_state_t* parent_state =
+      (iree_hal_module_state_t*)parent_module_state;
+  iree_hal_module_state_t* state = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_allocator_malloc(host_allocator, sizeof(*state), (void**)&state));
+  memset(state, 0, sizeof(*state));
+  state->host_allocator = host_allocator;
+  state->shared_device = parent_state->shared_device;
+  iree_hal_device_retain(state->shared_device);
+  state->executable_cache = parent_state->executable_cache;
+  iree_hal_executable_cache_retain(state->executable_cache);
+
+  iree_status_t status = iree_vm_list_create(
+      /*element_type=*/NULL, /*initial_capacity=*/512, state->host_allocator,
+      &state->deferred_releases);
+  if (!iree_status_is_ok(status)) {
+    iree_hal_executable_cache_release(state->executable_cache);
+    iree_hal_device_release(state->shared_device);
+    iree_allocator_free(host_allocator, state);
+    return status;
+  }
+
+  *out_module_state = (iree_vm_module_state_t*)state;
+  return iree_ok_status();
+}
+
 static void IREE_API_PTR
 iree_hal_module_free_state(void* self, iree_vm_module_state_t* module_state) {
   iree_hal_module_state_t* state = (iree_hal_module_state_t*)module_state;
@@ -875,14 +908,38 @@ IREE_VM_ABI_EXPORT(iree_hal_module_semaphore_fail, ri, v) {
   return iree_ok_status();
 }
 
+// Waits on the semaphore referenced by |request| reaching the request value.
+static iree_status_t iree_hal_module_semaphore_wait_request(
+    const iree_vm_wait_request_t* request, iree_time_t deadline_ns) {
+  return iree_hal_semaphore_wait_with_deadline(
+      (iree_hal_semaphore_t*)request->object.ptr, request->value, deadline_ns);
+}
+
 IREE_VM_ABI_EXPORT(iree_hal_module_semaphore_await, ri, i) {
   iree_hal_semaphore_t* semaphore = NULL;
   IREE_RETURN_IF_ERROR(iree_hal_semaphore_check_deref(args->r0, &semaphore));
   uint64_t new_value = (uint32_t)args->i1;
 
-  // TODO(benvanik): coroutine magic.
-  iree_status_t status = iree_hal_semaphore_wait_with_deadline(
-      semaphore, new_value, IREE_TIME_INFINITE_FUTURE);
+  // Fast path for semaphores that have already been signaled. Failed
+  // semaphores fall through so the wait reports the failure.
+  uint64_t current_value = 0;
+  iree_status_t status = iree_hal_semaphore_query(semaphore, &current_value);
+  if (iree_status_is_ok(status) && current_value >= new_value) {
+    rets->i0 = 0;
+    return iree_ok_status();
+  }
+  iree_status_ignore(status);
+
+  // Hand the wait to the stack: asynchronous invocations yield back to their
+  // owner and re-run this call once the semaphore is reached, while
+  // synchronous ones block here.
+  iree_vm_wait_request_t request;
+  request.object = iree_hal_semaphore_retain_ref(semaphore);
+  request.value = new_value;
+  request.wait_fn = iree_hal_module_semaphore_wait_request;
+  bool yielded = false;
+  status = iree_vm_stack_wait(stack, &request, &yielded);
+  if (yielded) return iree_ok_status();
   if (iree_status_is_ok(status)) {
     rets->i0 = 0;
   } else if (iree_status_is_deadline_exceeded(status)) {
@@ -952,6 +1009,7 @@ iree_hal_module_create(iree_hal_device_t* device, iree_allocator_t allocator,
       .destroy = iree_hal_module_destroy,
       .alloc_state = iree_hal_module_alloc_state,
       .free_state = iree_hal_module_free_state,
+      .fork_state = iree_hal_module_fork_state,
   };
 
   // Allocate shared module state.
@@ -0,0 +1,161 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/modules/hal/hal_module.h"
+
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/hal/api.h"
+#include "iree/hal/local/task_device.h"
+#include "iree/task/executor.h"
+#include "iree/task/topology.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+#include "iree/vm/api.h"
+#include "iree/vm/ref_cc.h"
+
+namespace iree {
+namespace {
+
+class HALModuleTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    IREE_CHECK_OK(iree_hal_module_register_types());
+  }
+
+  void SetUp() override {
+    iree_task_topology_t topology;
+    iree_task_topology_initialize_from_group_count(1, &topology);
+    iree_task_executor_t* executor = nullptr;
+    IREE_CHECK_OK(iree_task_executor_create(
+        IREE_TASK_SCHEDULING_MODE_RESERVED, &topology, iree_allocator_system(),
+        &executor));
+    iree_task_topology_deinitialize(&topology);
+    iree_hal_task_device_params_t params;
+    iree_hal_task_device_params_initialize(&params);
+    IREE_CHECK_OK(iree_hal_task_device_create(
+        iree_make_cstring_view("test"), &params, executor,
+        /*loader_count=*/0, /*loaders=*/nullptr, iree_allocator_system(),
+        &device_));
+    iree_task_executor_release(executor);
+
+    IREE_CHECK_OK(iree_vm_instance_create(iree_allocator_system(), &instance_));
+    iree_vm_module_t* hal_module = nullptr;
+    IREE_CHECK_OK(
+        iree_hal_module_create(device_, iree_allocator_system(), &hal_module));
+    IREE_CHECK_OK(iree_vm_context_create_with_modules(
+        instance_, &hal_module, 1, iree_allocator_system(), &context_));
+    iree_vm_module_release(hal_module);
+    iree_vm_context_freeze(context_);
+  }
+
+  void TearDown() override {
+    iree_vm_context_release(context_);
+    iree_vm_instance_release(instance_);
+    iree_hal_device_release(device_);
+  }
+
+  // Invokes the HAL module export |function_name| in |context|.
+  vm::ref<iree_vm_list_t> Invoke(iree_vm_context_t* context,
+                                 const char* function_name,
+                                 iree_vm_list_t* inputs = nullptr) {
+    iree_vm_function_t function;
+    IREE_CHECK_OK(iree_vm_context_resolve_function(
+        context, iree_make_cstring_view(function_name), &function));
+    vm::ref<iree_vm_list_t> outputs;
+    IREE_CHECK_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                      iree_allocator_system(), &outputs));
+    IREE_CHECK_OK(iree_vm_invoke(context, function, /*policy=*/nullptr,
+                                 inputs, outputs.get(),
+                                 iree_allocator_system()));
+    return outputs;
+  }
+
+  iree_hal_device_t* SharedDevice(iree_vm_context_t* context) {
+    auto outputs = Invoke(context, "hal.ex.shared_device");
+    return static_cast<iree_hal_device_t*>(iree_vm_list_get_ref_deref(
+        outputs.get(), 0, iree_hal_device_get_descriptor()));
+  }
+
+  iree_vm_context_t* Fork() {
+    iree_vm_context_t* fork = nullptr;
+    IREE_CHECK_OK(
+        iree_vm_context_fork(context_, iree_allocator_system(), &fork));
+    return fork;
+  }
+
+  iree_hal_device_t* device() const { return device_; }
+  iree_vm_context_t* context() const { return context_; }
+
+  // Releases the fixture context early to check that forks outlive it.
+  void ReleaseContext() {
+    iree_vm_context_release(context_);
+    context_ = nullptr;
+  }
+
+ private:
+  iree_hal_device_t* device_ = nullptr;
+  iree_vm_instance_t* instance_ = nullptr;
+  iree_vm_context_t* context_ = nullptr;
+};
+
+// Tests that forked contexts use the device of the parent context.
+TEST_F(HALModuleTest, ForkSharesDevice) {
+  iree_vm_context_t* fork_a = Fork();
+  iree_vm_context_t* fork_b = Fork();
+  EXPECT_EQ(device(), SharedDevice(context()));
+  EXPECT_EQ(device(), SharedDevice(fork_a));
+  EXPECT_EQ(device(), SharedDevice(fork_b));
+  iree_vm_context_release(fork_a);
+  iree_vm_context_release(fork_b);
+}
+
+// Tests that a fork can record and submit work after its parent is released.
+TEST_F(HALModuleTest, ForkOutlivesParent) {
+  iree_vm_context_t* fork = Fork();
+  ReleaseContext();
+
+  iree_vm_ref_t device_ref = iree_hal_device_retain_ref(SharedDevice(fork));
+  vm::ref<iree_vm_list_t> inputs;
+  IREE_ASSERT_OK(iree_vm_list_create(/*element_type=*/nullptr, 3,
+                                     iree_allocator_system(), &inputs));
+  IREE_ASSERT_OK(iree_vm_list_push_ref_retain(inputs.get(), &device_ref));
+  auto mode = iree_vm_value_make_i32(IREE_HAL_COMMAND_BUFFER_MODE_ONE_SHOT);
+  IREE_ASSERT_OK(iree_vm_list_push_value(inputs.get(), &mode));
+  auto categories = iree_vm_value_make_i32(IREE_HAL_COMMAND_CATEGORY_ANY);
+  IREE_ASSERT_OK(iree_vm_list_push_value(inputs.get(), &categories));
+  auto outputs = Invoke(fork, "hal.command_buffer.create", inputs.get());
+  iree_vm_ref_t command_buffer_ref = {0};
+  IREE_ASSERT_OK(
+      iree_vm_list_get_ref_retain(outputs.get(), 0, &command_buffer_ref));
+
+  IREE_ASSERT_OK(iree_vm_list_resize(inputs.get(), 0));
+  IREE_ASSERT_OK(
+      iree_vm_list_push_ref_retain(inputs.get(), &command_buffer_ref));
+  Invoke(fork, "hal.command_buffer.begin", inputs.get());
+  Invoke(fork, "hal.command_buffer.end", inputs.get());
+
+  IREE_ASSERT_OK(iree_vm_list_resize(inputs.get(), 0));
+  IREE_ASSERT_OK(iree_vm_list_push_ref_retain(inputs.get(), &device_ref));
+  IREE_ASSERT_OK(
+      iree_vm_list_push_ref_retain(inputs.get(), &command_buffer_ref));
+  Invoke(fork, "hal.ex.submit_and_wait", inputs.get());
+
+  iree_vm_ref_release(&command_buffer_ref);
+  iree_vm_ref_release(&device_ref);
+  iree_vm_context_release(fork);
+}
+
+}  // namespace
+}  // namespace iree
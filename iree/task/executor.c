@@ -20,6 +20,7 @@
 #include "iree/task/task_impl.h"
 
 static void iree_task_executor_destroy(iree_task_executor_t* executor);
+static int iree_task_executor_wait_thread_main(iree_task_executor_t* executor);
 
 iree_status_t iree_task_executor_create(
     iree_task_scheduling_mode_t scheduling_mode,
@@ -59,6 +60,7 @@ iree_status_t iree_task_executor_create(
   iree_atomic_task_slist_initialize(&executor->incoming_waiting_slist);
   iree_slim_mutex_initialize(&executor->coordinator_mutex);
   iree_slim_mutex_initialize(&executor->wait_mutex);
+  iree_notification_set_initialize(&executor->worker_wake_notifications);
 
   // Simple PRNG used to generate seeds for the per-worker PRNGs used to
   // distribute work. This isn't strong (and doesn't need to be); it's just
@@ -76,10 +78,12 @@ iree_status_t iree_task_executor_create(
 
   // Wait set used to batch syscalls for polling/waiting on wait handles.
   // This is currently limited to a relatively small max to make bad behavior
-  // clearer with nice RESOURCE_EXHAUSTED errors.
+  // clearer with nice RESOURCE_EXHAUSTED errors. We always reserve one slot
+  // for the wake event used by the dedicated wait thread (if enabled).
   if (iree_status_is_ok(status)) {
-    status = iree_wait_set_allocate(IREE_TASK_EXECUTOR_MAX_OUTSTANDING_WAITS,
-                                    allocator, &executor->wait_set);
+    status =
+        iree_wait_set_allocate(IREE_TASK_EXECUTOR_MAX_OUTSTANDING_WAITS + 1,
+                               allocator, &executor->wait_set);
   }
 
   // Pool used for all dispatch->slice fanout tasks. These only live within the
@@ -134,6 +138,28 @@ iree_status_t iree_task_executor_create(
                                         iree_memory_order_relaxed);
   }
 
+  // Bring up the dedicated wait thread, if requested. It starts with only the
+  // wake event in the wait set and will block until waiting tasks are posted.
+  if (iree_status_is_ok(status) &&
+      (executor->scheduling_mode &
+       IREE_TASK_SCHEDULING_MODE_DEDICATED_WAIT_THREAD)) {
+    status = iree_event_initialize(/*initial_state=*/false,
+                                   &executor->wait_thread_wake_event);
+    if (iree_status_is_ok(status)) {
+      status = iree_wait_set_insert(executor->wait_set,
+                                    executor->wait_thread_wake_event);
+    }
+    if (iree_status_is_ok(status)) {
+      iree_thread_create_params_t thread_params;
+      memset(&thread_params, 0, sizeof(thread_params));
+      thread_params.name = iree_make_cstring_view("iree-task-wait");
+      thread_params.priority_class = IREE_THREAD_PRIORITY_CLASS_NORMAL;
+      status = iree_thread_create(
+          (iree_thread_entry_t)iree_task_executor_wait_thread_main, executor,
+          thread_params, executor->allocator, &executor->wait_thread);
+    }
+  }
+
   if (!iree_status_is_ok(status)) {
     // NOTE: destroy will ensure that any workers we have initialized are
     // properly cleaned up.
@@ -151,7 +177,18 @@ static void iree_task_executor_destroy(iree_task_executor_t* executor) {
   if (!executor) return;
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // First ask all workers to exit. We do this prior to waiting on them to exit
+  // Stop the wait thread first as it may be coordinating and posting work to
+  // the workers. Releasing the thread joins with it.
+  if (executor->wait_thread) {
+    iree_atomic_store_int32(&executor->wait_thread_exit_requested, 1,
+                            iree_memory_order_release);
+    iree_event_set(&executor->wait_thread_wake_event);
+    iree_thread_release(executor->wait_thread);
+    executor->wait_thread = NULL;
+  }
+  iree_event_deinitialize(&executor->wait_thread_wake_event);
+
+  // Ask all workers to exit. We do this prior to waiting on them to exit
   // so that we parallelize the shutdown logic (which may flush pending tasks).
   for (iree_host_size_t i = 0; i < executor->worker_count; ++i) {
     iree_task_worker_t* worker = &executor->workers[i];
@@ -166,6 +203,7 @@ static void iree_task_executor_destroy(iree_task_executor_t* executor) {
     iree_task_worker_deinitialize(worker);
   }
 
+  iree_notification_set_deinitialize(&executor->worker_wake_notifications);
   iree_wait_set_free(executor->wait_set);
   iree_slim_mutex_deinitialize(&executor->wait_mutex);
   iree_slim_mutex_deinitialize(&executor->coordinator_mutex);
@@ -216,6 +254,69 @@ static void iree_task_executor_relay_to_worker(
   iree_task_post_batch_enqueue(post_batch, worker_index, task);
 }
 
+// Schedules a single ready |task| by routing it to workers, retiring it, or
+// moving it to the waiting list.
+//
+// Only called during coordination and expects the coordinator lock to be held.
+static void iree_task_executor_schedule_ready_task(
+    iree_task_executor_t* executor, iree_task_t* task,
+    iree_task_submission_t* pending_submission,
+    iree_task_post_batch_t* post_batch) {
+  switch (task->type) {
+    case IREE_TASK_TYPE_NOP:
+      // Doesn't do anything; just retire and continue on to any dependents.
+      iree_task_nop_retire((iree_task_nop_t*)task, pending_submission);
+      break;
+    case IREE_TASK_TYPE_CALL:
+    case IREE_TASK_TYPE_DISPATCH_SLICE: {
+      // Generic routing to workers for tasks that should always run there.
+      iree_task_executor_relay_to_worker(executor, post_batch, task);
+      break;
+    }
+    case IREE_TASK_TYPE_BARRIER: {
+      // Retire the barrier to (possibly) ready up all dependent tasks.
+      // This acts as a fan-out in cases where the dependent task count >1.
+      iree_task_barrier_retire((iree_task_barrier_t*)task, pending_submission);
+      break;
+    }
+    case IREE_TASK_TYPE_FENCE: {
+      // Scope fence hit; notifies the scope so that anyone waiting on the
+      // fence can be notified without us having to do so explicitly.
+      iree_task_fence_retire((iree_task_fence_t*)task, pending_submission);
+      break;
+    }
+    case IREE_TASK_TYPE_WAIT: {
+      // Waits may need to be moved into the wait list (not completed) or
+      // retired (after the wait condition is met).
+      if (task->flags & IREE_TASK_FLAG_WAIT_COMPLETED) {
+        iree_task_wait_retire((iree_task_wait_t*)task, pending_submission);
+      } else {
+        iree_task_submission_enqueue(pending_submission, task);
+      }
+      break;
+    }
+    case IREE_TASK_TYPE_DISPATCH: {
+      // Dispatches may need to be issued (fanning out the tiles to workers)
+      // or retired (after all tiles have completed).
+      if (task->flags & IREE_TASK_FLAG_DISPATCH_RETIRE) {
+        iree_task_dispatch_retire((iree_task_dispatch_t*)task,
+                                  pending_submission);
+      } else {
+        if (task->flags & IREE_TASK_FLAG_DISPATCH_SLICED) {
+          iree_task_dispatch_issue_sliced((iree_task_dispatch_t*)task,
+                                          &executor->dispatch_task_pool,
+                                          pending_submission, post_batch);
+        } else {
+          iree_task_dispatch_issue_sharded((iree_task_dispatch_t*)task,
+                                           &executor->dispatch_task_pool,
+                                           pending_submission, post_batch);
+        }
+      }
+      break;
+    }
+  }
+}
+
 // Schedules all ready tasks in the |pending_submission| list.
 // Task may enqueue zero or more new tasks (or newly-ready/waiting tasks) to
 // |pending_submission| or queue work for posting to workers via the
@@ -232,66 +333,48 @@ void iree_task_executor_schedule_ready_tasks(
     iree_task_post_batch_t* post_batch) {
   if (iree_task_list_is_empty(&pending_submission->ready_list)) return;
   IREE_TRACE_ZONE_BEGIN(z0);
-  iree_task_t* task = NULL;
-  while ((task = iree_task_list_pop_front(&pending_submission->ready_list))) {
-    switch (task->type) {
-      case IREE_TASK_TYPE_NOP:
-        // Doesn't do anything; just retire and continue on to any dependents.
-        iree_task_nop_retire((iree_task_nop_t*)task, pending_submission);
-        break;
-      case IREE_TASK_TYPE_CALL:
-      case IREE_TASK_TYPE_DISPATCH_SLICE: {
-        // Generic routing to workers for tasks that should always run there.
-        iree_task_executor_relay_to_worker(executor, post_batch, task);
-        break;
-      }
-      case IREE_TASK_TYPE_BARRIER: {
-        // Retire the barrier to (possibly) ready up all dependent tasks.
-        // This acts as a fan-out in cases where the dependent task count >1.
-        iree_task_barrier_retire((iree_task_barrier_t*)task,
-                                 pending_submission);
-        break;
-      }
-      case IREE_TASK_TYPE_FENCE: {
-        // Scope fence hit; notifies the scope so that anyone waiting on the
-        // fence can be notified without us having to do so explicitly.
-        iree_task_fence_retire((iree_task_fence_t*)task, pending_submission);
-        break;
-      }
-      case IREE_TASK_TYPE_WAIT: {
-        // Waits may need to be moved into the wait list (not completed) or
-        // retired (after the wait condition is met).
-        if (task->flags & IREE_TASK_FLAG_WAIT_COMPLETED) {
-          iree_task_wait_retire((iree_task_wait_t*)task, pending_submission);
-        } else {
-          iree_task_submission_enqueue(pending_submission, task);
-        }
-        break;
-      }
-      case IREE_TASK_TYPE_DISPATCH: {
-        // Dispatches may need to be issued (fanning out the tiles to workers)
-        // or retired (after all tiles have completed).
-        if (task->flags & IREE_TASK_FLAG_DISPATCH_RETIRE) {
-          iree_task_dispatch_retire((iree_task_dispatch_t*)task,
-                                    pending_submission);
-        } else {
-          if (task->flags & IREE_TASK_FLAG_DISPATCH_SLICED) {
-            iree_task_dispatch_issue_sliced((iree_task_dispatch_t*)task,
-                                            &executor->dispatch_task_pool,
-                                            pending_submission, post_batch);
-          } else {
-            iree_task_dispatch_issue_sharded((iree_task_dispatch_t*)task,
-                                             &executor->dispatch_task_pool,
-                                             pending_submission, post_batch);
-          }
-        }
-        break;
+
+  // Tasks from higher priority scopes are scheduled first so that their work
+  // is posted ahead of lower priority work and sharded dispatches get first
+  // pick of the idle workers. Scheduling may ready additional tasks (such as
+  // when barriers retire) and we loop until no more are ready.
+  iree_task_list_t priority_lists[IREE_TASK_SCOPE_PRIORITY_COUNT];
+  while (!iree_task_list_is_empty(&pending_submission->ready_list)) {
+    for (int i = 0; i < IREE_TASK_SCOPE_PRIORITY_COUNT; ++i) {
+      iree_task_list_initialize(&priority_lists[i]);
+    }
+    iree_task_t* task = NULL;
+    while ((task = iree_task_list_pop_front(&pending_submission->ready_list))) {
+      iree_task_list_push_back(&priority_lists[iree_task_priority(task)], task);
+    }
+    for (int i = IREE_TASK_SCOPE_PRIORITY_COUNT - 1; i >= 0; --i) {
+      while ((task = iree_task_list_pop_front(&priority_lists[i]))) {
+        iree_task_executor_schedule_ready_task(executor, task,
+                                               pending_submission, post_batch);
       }
     }
   }
+
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Moves all tasks in |waiting_list| into the incoming waiting list.
+// If the executor has a dedicated wait thread it will be woken to add the new
+// tasks to its wait set; otherwise the tasks will be picked up by the next
+// coordinator.
+//
+// May be called from any thread.
+static void iree_task_executor_post_waiting_list(
+    iree_task_executor_t* executor, iree_task_list_t* waiting_list) {
+  if (iree_task_list_is_empty(waiting_list)) return;
+  iree_atomic_task_slist_concat(&executor->incoming_waiting_slist,
+                                waiting_list->head, waiting_list->tail);
+  memset(waiting_list, 0, sizeof(*waiting_list));
+  if (executor->wait_thread) {
+    iree_event_set(&executor->wait_thread_wake_event);
+  }
+}
+
 void iree_task_executor_merge_submission(iree_task_executor_t* executor,
                                          iree_task_submission_t* submission) {
   // Concatenate all of the incoming tasks into the submission list.
@@ -301,9 +384,7 @@ void iree_task_executor_merge_submission(iree_task_executor_t* executor,
   iree_atomic_task_slist_concat(&executor->incoming_ready_slist,
                                 submission->ready_list.head,
                                 submission->ready_list.tail);
-  iree_atomic_task_slist_concat(&executor->incoming_waiting_slist,
-                                submission->waiting_list.head,
-                                submission->waiting_list.tail);
+  iree_task_executor_post_waiting_list(executor, &submission->waiting_list);
 
   // NOTE: after concatenating the intrusive next_task pointers may immediately
   // be modified by other threads. We can no longer assume anything about the
@@ -337,7 +418,8 @@ void iree_task_executor_flush(iree_task_executor_t* executor) {
 // The handle of each task will be inserted into the wait_set (where it may be
 // a duplicate).
 //
-// Only called during coordination and expects the coordinator lock to be held.
+// Only called during coordination and expects the coordinator lock to be held
+// or from the dedicated wait thread (which owns the lists).
 static void iree_task_executor_merge_wait_list(
     iree_task_executor_t* executor, iree_task_list_t* incoming_waiting_list) {
   if (iree_task_list_is_empty(incoming_waiting_list)) return;
@@ -367,7 +449,8 @@ static void iree_task_executor_merge_wait_list(
 // Any dependent tasks will be enqueued in the |pending_submission| for issuing.
 // If multiple tasks were waiting on the same wait handle all will be readied.
 //
-// Only called during coordination and expects the coordinator lock to be held.
+// Only called during coordination and expects the coordinator lock to be held
+// or from the dedicated wait thread (which owns the lists).
 // The wait lock must be held as the wait_set is modified.
 static void iree_task_executor_wake_waiting_task(
     iree_task_executor_t* executor, iree_wait_handle_t wake_handle,
@@ -559,11 +642,16 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
     // breadth-first traversal of task graphs even if they originate from
     // various places and have no relation - hopefully leading to better average
     // latency.
+    //
+    // When there is a dedicated wait thread it owns the incoming waiting list
+    // and we leave it alone.
     iree_task_submission_t pending_submission;
     iree_task_submission_initialize_from_lifo_slist(
         &executor->incoming_ready_slist, &pending_submission);
-    iree_task_list_append_from_fifo_slist(&pending_submission.waiting_list,
-                                          &executor->incoming_waiting_slist);
+    if (!executor->wait_thread) {
+      iree_task_list_append_from_fifo_slist(&pending_submission.waiting_list,
+                                            &executor->incoming_waiting_slist);
+    }
 
     // Scratch coordinator submission batch used during scheduling to batch up
     // all tasks that will be posted to each worker. We could stash this on the
@@ -584,7 +672,12 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
     // If any waits have resolved then they'll be moved to the ready list here
     // and then get processed FIFO with the tasks that were ready in the
     // request.
-    iree_task_executor_poll_waiting_tasks(executor, &pending_submission);
+    //
+    // A dedicated wait thread (if present) does this for us as soon as the
+    // handles resolve so there's no need to issue the syscalls here.
+    if (!executor->wait_thread) {
+      iree_task_executor_poll_waiting_tasks(executor, &pending_submission);
+    }
 
     // Schedule all ready tasks in this batch. Some may complete inline (such
     // as ready barriers with all their dependencies resolved) while others may
@@ -592,14 +685,20 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
     iree_task_executor_schedule_ready_tasks(executor, &pending_submission,
                                             post_batch);
 
-    // Merge any newly waiting tasks into the global wait list.
-    iree_task_executor_merge_wait_list(executor,
-                                       &pending_submission.waiting_list);
+    // Merge any newly waiting tasks into the global wait list or hand them off
+    // to the dedicated wait thread.
+    if (executor->wait_thread) {
+      iree_task_executor_post_waiting_list(executor,
+                                           &pending_submission.waiting_list);
+    } else {
+      iree_task_executor_merge_wait_list(executor,
+                                         &pending_submission.waiting_list);
+    }
 
     // Post all new work to workers; they may wake and begin executing
     // immediately. Returns whether this worker has new tasks for it to work on.
     bool did_post = iree_task_post_batch_submit(post_batch);
-    if (!did_post && wait_on_idle) {
+    if (!did_post && wait_on_idle && !executor->wait_thread) {
       // No work was found; wait on one or more of our wait handles.
       // This will block the calling thread but that's fine as they were going
       // to wait anyway and were just speculatively seeing if there was work
@@ -624,6 +723,98 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Returns true if |wake_handle| is the dedicated wait thread wake event.
+static bool iree_task_executor_is_wait_thread_wake_handle(
+    iree_task_executor_t* executor, iree_wait_handle_t wake_handle) {
+  return iree_wait_primitive_compare_identical(
+      &wake_handle, &executor->wait_thread_wake_event);
+}
+
+// Drains the incoming waiting list into the wait set and then blocks until
+// one or more wait handles resolve. All resolved wait tasks are added to
+// |pending_submission|. Returns early without resolving any tasks if the wake
+// event is set to indicate that new waiting tasks have arrived.
+//
+// Only called from the dedicated wait thread.
+static void iree_task_executor_wait_thread_pump_once(
+    iree_task_executor_t* executor,
+    iree_task_submission_t* pending_submission) {
+  // Reset the wake event prior to draining the incoming list; any waiting
+  // tasks posted after this point will set the event again and we'll pick
+  // them up on the next pump.
+  iree_event_reset(&executor->wait_thread_wake_event);
+
+  iree_task_list_t incoming_waiting_list;
+  iree_task_list_initialize(&incoming_waiting_list);
+  iree_task_list_append_from_fifo_slist(&incoming_waiting_list,
+                                        &executor->incoming_waiting_slist);
+  iree_task_executor_merge_wait_list(executor, &incoming_waiting_list);
+
+  iree_slim_mutex_lock(&executor->wait_mutex);
+
+  // Block until at least one handle resolves. The wake event is always in the
+  // set so we'll return to pick up new waiting tasks as they arrive.
+  iree_time_t deadline_ns = IREE_TIME_INFINITE_FUTURE;
+  do {
+    iree_wait_handle_t wake_handle;
+    iree_status_t status =
+        iree_wait_any(executor->wait_set, deadline_ns, &wake_handle);
+    if (iree_status_is_ok(status)) {
+      if (iree_task_executor_is_wait_thread_wake_handle(executor,
+                                                        wake_handle)) {
+        // New waiting tasks (or an exit request); stop polling so that we can
+        // add them to the wait set without leaving resolved tasks behind.
+        break;
+      }
+      iree_task_executor_wake_waiting_task(executor, wake_handle,
+                                           pending_submission);
+      // Now that we know at least one handle resolved poll the rest; it's
+      // common for several to resolve around the same time.
+      deadline_ns = IREE_TIME_INFINITE_PAST;
+    } else if (iree_status_is_deadline_exceeded(status)) {
+      // Nothing else resolved during the poll.
+      iree_status_ignore(status);
+      break;
+    } else {
+      // TODO(#4026): propagate failure to all scopes involved.
+      IREE_ASSERT_TRUE(iree_status_is_ok(status));
+      iree_status_ignore(status);
+      break;
+    }
+  } while (!iree_task_list_is_empty(&executor->waiting_list));
+
+  iree_slim_mutex_unlock(&executor->wait_mutex);
+}
+
+// Thread entry point for the dedicated wait thread.
+// Alternates between waiting on the wait set and coordinating to schedule the
+// newly-ready tasks onto workers. Only returns when the executor is destroyed.
+static int iree_task_executor_wait_thread_main(iree_task_executor_t* executor) {
+  IREE_TRACE_ZONE_BEGIN(thread_zone);
+
+  while (!iree_atomic_load_int32(&executor->wait_thread_exit_requested,
+                                 iree_memory_order_acquire)) {
+    iree_task_submission_t pending_submission;
+    iree_task_submission_initialize(&pending_submission);
+
+    IREE_TRACE_ZONE_BEGIN_NAMED(z_wait, "iree_task_executor_wait_thread_wait");
+    iree_task_executor_wait_thread_pump_once(executor, &pending_submission);
+    IREE_TRACE_ZONE_END(z_wait);
+
+    // Move the tasks that were readied by the wait directly into the incoming
+    // ready list and coordinate to get them over to the workers immediately.
+    // We can't leave this to the workers as they may all be idle.
+    if (!iree_task_submission_is_empty(&pending_submission)) {
+      iree_task_executor_merge_submission(executor, &pending_submission);
+      iree_task_executor_coordinate(executor, /*current_worker=*/NULL,
+                                    /*wait_on_idle=*/false);
+    }
+  }
+
+  IREE_TRACE_ZONE_END(thread_zone);
+  return 0;
+}
+
 static iree_task_t* iree_task_executor_try_steal_task_from_affinity_set(
     iree_task_executor_t* executor, iree_task_affinity_set_t victim_mask,
     uint32_t max_theft_attempts, int rotation_offset,
@@ -677,7 +868,9 @@ static iree_task_t* iree_task_executor_try_steal_task_from_affinity_set(
 // We do a scan through ideal victims indicated by the
 // |constructive_sharing_mask|; these are the workers most likely to have some
 // cache benefits to taking their work as they share some level of the cache
-// hierarchy and should be better to steal from than any random worker.
+// hierarchy and should be better to steal from than any random worker. No
+// workers outside of the |work_stealing_mask| are considered; by default this
+// keeps theft within a NUMA node.
 //
 // To prevent biasing any particular victim we use a fast prng function to
 // select where in the set of potential victims defined by the topology
@@ -687,13 +880,15 @@ static iree_task_t* iree_task_executor_try_steal_task_from_affinity_set(
 iree_task_t* iree_task_executor_try_steal_task(
     iree_task_executor_t* executor,
     iree_task_affinity_set_t constructive_sharing_mask,
-    uint32_t max_theft_attempts, iree_prng_minilcg128_state_t* theft_prng,
+    iree_task_affinity_set_t work_stealing_mask, uint32_t max_theft_attempts,
+    iree_prng_minilcg128_state_t* theft_prng,
     iree_task_queue_t* local_task_queue) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
   // Limit the workers we will steal from to the ones that are currently live
   // and not idle.
   iree_task_affinity_set_t victim_mask =
+      work_stealing_mask &
       iree_atomic_task_affinity_set_load(&executor->worker_live_mask,
                                          iree_memory_order_relaxed) &
       ~iree_atomic_task_affinity_set_load(&executor->worker_idle_mask,
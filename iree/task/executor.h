@@ -257,6 +257,13 @@ extern "C" {
 // from potentially bad system behavior dramatically improve: there aren't many
 // opportunities for contention in this system but one can guarantee zero
 // contention by simply not sharing the resources!
+//
+// On NUMA systems
+// iree_task_topology_initialize_from_unique_l2_cache_groups_on_numa_node can be
+// used to create one executor per node. Topologies derived from the machine
+// also restrict work stealing to workers on the same node so that even a
+// single executor spanning nodes avoids migrating tasks (and the memory they
+// touch) across the interconnect.
 
 // A bitfield specifying the scheduling mode used for configuring how (or if)
 // work is balanced across queues.
@@ -273,6 +280,10 @@ enum iree_task_scheduling_mode_e {
   // any queue such that we are keeping as many workers active as possible to
   // reach peak utilization or artificially limiting which tasks we allow
   // through to keep certain CPU cores asleep unless absolutely required.
+  //
+  // Latency vs. throughput across producers sharing an executor is controlled
+  // per-scope with iree_task_scope_set_priority; ready tasks are scheduled in
+  // weighted-fair order across priorities regardless of scheduling mode.
   IREE_TASK_SCHEDULING_MODE_RESERVED = 0u,
 
   // Creates all workers suspended and waits until work is first scheduled to
@@ -292,12 +303,17 @@ enum iree_task_scheduling_mode_e {
   // begin processing simultaneously immediately after the submission is made.
   IREE_TASK_SCHEDULING_MODE_DEFER_WORKER_STARTUP = 1u << 0,
 
-  // TODO(#4027): implement IREE_TASK_SCHEDULING_MODE_DEDICATED_WAIT_THREAD.
   // Creates a dedicated thread performing waits on root wait handles.
   // On workloads with many short-duration waits this will reduce total latency
   // as the waits are aggressively processed and dependent tasks are scheduled.
   // It also keeps any wait-related syscalls off the worker threads that would
   // otherwise need to perform the syscalls during coordination.
+  //
+  // The wait thread exclusively owns the executor wait set: coordinators hand
+  // off any unresolved wait tasks to it and it moves the tasks into the
+  // incoming ready list as soon as their handles resolve, running coordination
+  // itself to get the dependent tasks posted to workers. Coordinators never
+  // poll or block on wait handles in this mode.
   IREE_TASK_SCHEDULING_MODE_DEDICATED_WAIT_THREAD = 1u << 1,
 };
 typedef uint32_t iree_task_scheduling_mode_t;
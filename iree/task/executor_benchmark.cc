@@ -0,0 +1,358 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/internal/wait_handle.h"
+#include "iree/base/logging.h"
+#include "iree/task/executor.h"
+#include "iree/task/scope.h"
+#include "iree/task/submission.h"
+#include "iree/task/task.h"
+#include "iree/task/topology.h"
+
+namespace {
+
+//==============================================================================
+// Executor fixture utilities
+//==============================================================================
+
+// Creates an executor with |worker_count| workers and the given
+// |scheduling_mode|. Aborts the benchmark on failure.
+iree_task_executor_t* CreateExecutor(
+    iree_task_scheduling_mode_t scheduling_mode,
+    iree_host_size_t worker_count) {
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(worker_count, &topology);
+  iree_task_executor_t* executor = NULL;
+  IREE_CHECK_OK(iree_task_executor_create(scheduling_mode, &topology,
+                                          iree_allocator_system(), &executor));
+  iree_task_topology_deinitialize(&topology);
+  return executor;
+}
+
+// Submits the DAG rooted at |head_task| with |tail_task| signaling a fence on
+// |scope| when it completes.
+void SubmitTasks(iree_task_executor_t* executor, iree_task_scope_t* scope,
+                 iree_task_t* head_task, iree_task_t* tail_task) {
+  iree_task_fence_t* fence = NULL;
+  IREE_CHECK_OK(iree_task_executor_acquire_fence(executor, scope, &fence));
+  iree_task_set_completion_task(tail_task, &fence->header);
+  iree_task_submission_t submission;
+  iree_task_submission_initialize(&submission);
+  iree_task_submission_enqueue(&submission, head_task);
+  iree_task_executor_submit(executor, &submission);
+  iree_task_executor_flush(executor);
+}
+
+//==============================================================================
+// Wait-to-dispatch latency
+//==============================================================================
+
+// Records the time at which the call task began executing.
+iree_status_t RecordCallTime(uintptr_t user_context, iree_task_t* task,
+                             iree_task_submission_t* pending_submission) {
+  reinterpret_cast<std::atomic<iree_time_t>*>(user_context)
+      ->store(iree_time_now(), std::memory_order_release);
+  return iree_ok_status();
+}
+
+// Measures the latency from an external wait handle being signaled to the
+// task depending on it starting execution on a worker. This is the critical
+// path for host<->device synchronization where a wait is resolved and the
+// next batch of work needs to get going as soon as possible.
+//
+// The executor is given time to settle into its waiting state prior to the
+// signal so that we are measuring wake latency and not submission overhead.
+// Without a dedicated wait thread nothing may be blocked on the wait set when
+// all workers are idle and the waits are only noticed during coordination, so
+// the signaling thread flushes after signaling as a user would have to.
+//
+// Arguments: [scheduling_mode]
+void BM_WaitToDispatchLatency(benchmark::State& state) {
+  iree_task_scheduling_mode_t scheduling_mode =
+      (iree_task_scheduling_mode_t)state.range(0);
+  iree_task_executor_t* executor =
+      CreateExecutor(scheduling_mode, /*worker_count=*/4);
+  iree_task_scope_t scope;
+  iree_task_scope_initialize(iree_make_cstring_view("benchmark"), &scope);
+
+  iree_event_t event;
+  IREE_CHECK_OK(iree_event_initialize(/*initial_state=*/false, &event));
+
+  std::atomic<iree_time_t> call_time_ns = {0};
+  for (auto _ : state) {
+    iree_event_reset(&event);
+
+    iree_task_wait_t wait_task;
+    iree_task_wait_initialize(&scope, event, &wait_task);
+    iree_task_call_t call_task;
+    iree_task_call_initialize(
+        &scope,
+        iree_task_make_call_closure(RecordCallTime,
+                                    reinterpret_cast<uintptr_t>(&call_time_ns)),
+        &call_task);
+    iree_task_set_completion_task(&wait_task.header, &call_task.header);
+    SubmitTasks(executor, &scope, &wait_task.header, &call_task.header);
+
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+    iree_time_t signal_time_ns = iree_time_now();
+    iree_event_set(&event);
+    iree_task_executor_flush(executor);
+    IREE_CHECK_OK(iree_task_scope_wait_idle(&scope, IREE_TIME_INFINITE_FUTURE));
+
+    iree_time_t latency_ns =
+        call_time_ns.load(std::memory_order_acquire) - signal_time_ns;
+    state.SetIterationTime(latency_ns / 1e9);
+  }
+
+  iree_event_deinitialize(&event);
+  iree_task_scope_deinitialize(&scope);
+  iree_task_executor_release(executor);
+}
+BENCHMARK(BM_WaitToDispatchLatency)
+    ->ArgName("mode")
+    ->Arg(IREE_TASK_SCHEDULING_MODE_RESERVED)
+    ->Arg(IREE_TASK_SCHEDULING_MODE_DEDICATED_WAIT_THREAD)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+//==============================================================================
+// Dispatch tail latency
+//==============================================================================
+
+// Duration of a regular tile in the dispatch latency benchmarks.
+static const iree_duration_t kTileDurationNs = 2000;
+
+// How many times longer heavy tiles take than regular tiles.
+static const iree_duration_t kHeavyTileMultiplier = 8;
+
+// Spins on a tile for kTileDurationNs, or kHeavyTileMultiplier times that for
+// every Nth tile where N is the heavy tile stride passed as |user_context|.
+// Spinning (vs sleeping) keeps the worker busy as real tiles would.
+iree_status_t SpinTile(uintptr_t user_context,
+                       const iree_task_tile_context_t* tile_context,
+                       iree_task_submission_t* pending_submission) {
+  uint32_t heavy_tile_stride = (uint32_t)user_context;
+  iree_duration_t duration_ns = kTileDurationNs;
+  if (heavy_tile_stride && tile_context->workgroup_xyz[0] % heavy_tile_stride ==
+                               heavy_tile_stride - 1) {
+    duration_ns *= kHeavyTileMultiplier;
+  }
+  iree_time_t end_time_ns = iree_time_now() + duration_ns;
+  while (iree_time_now() < end_time_ns) {
+  }
+  return iree_ok_status();
+}
+
+// Returns the |percentile| (0-1) value from the sorted |values| list.
+double Percentile(const std::vector<double>& sorted_values, double percentile) {
+  if (sorted_values.empty()) return 0.0;
+  size_t index = (size_t)(percentile * (sorted_values.size() - 1) + 0.5);
+  return sorted_values[index];
+}
+
+// Measures the time taken from submitting a sharded dispatch to all of its
+// tiles completing. The p50/p99 counters show the tail latency, which is
+// dominated by how well the last tiles of the grid are spread across workers:
+// a worker that reserved a batch of tiles (especially heavy ones) right at the
+// end of the grid keeps the dispatch from completing while other workers idle.
+//
+// Arguments: [worker_count, tile_count, heavy_tile_stride (0 = balanced)]
+void BM_DispatchTailLatency(benchmark::State& state) {
+  iree_host_size_t worker_count = (iree_host_size_t)state.range(0);
+  const uint32_t workgroup_size[3] = {1, 1, 1};
+  const uint32_t workgroup_count[3] = {(uint32_t)state.range(1), 1, 1};
+  uintptr_t heavy_tile_stride = (uintptr_t)state.range(2);
+  iree_task_executor_t* executor =
+      CreateExecutor(IREE_TASK_SCHEDULING_MODE_RESERVED, worker_count);
+  iree_task_scope_t scope;
+  iree_task_scope_initialize(iree_make_cstring_view("benchmark"), &scope);
+
+  std::vector<double> latencies_us;
+  for (auto _ : state) {
+    iree_task_dispatch_t dispatch_task;
+    iree_task_dispatch_initialize(
+        &scope, iree_task_make_dispatch_closure(SpinTile, heavy_tile_stride),
+        workgroup_size, workgroup_count, &dispatch_task);
+
+    iree_time_t start_time_ns = iree_time_now();
+    SubmitTasks(executor, &scope, &dispatch_task.header,
+                &dispatch_task.header);
+    IREE_CHECK_OK(iree_task_scope_wait_idle(&scope, IREE_TIME_INFINITE_FUTURE));
+    iree_time_t latency_ns = iree_time_now() - start_time_ns;
+
+    state.SetIterationTime(latency_ns / 1e9);
+    latencies_us.push_back(latency_ns / 1e3);
+  }
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  state.counters["p50_us"] = Percentile(latencies_us, 0.50);
+  state.counters["p99_us"] = Percentile(latencies_us, 0.99);
+  iree_task_dispatch_statistics_t statistics =
+      iree_task_scope_consume_statistics(&scope);
+  state.counters["stolen_shards"] = benchmark::Counter(
+      iree_atomic_load_int32(&statistics.stolen_shard_count,
+                             iree_memory_order_relaxed),
+      benchmark::Counter::kAvgIterations);
+
+  iree_task_scope_deinitialize(&scope);
+  iree_task_executor_release(executor);
+}
+BENCHMARK(BM_DispatchTailLatency)
+    ->ArgNames({"workers", "tiles", "heavy_stride"})
+    ->Args({64, 1024, 0})
+    ->Args({64, 1024, 16})
+    ->Args({64, 4096, 0})
+    ->Args({64, 4096, 16})
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+//==============================================================================
+// Mixed-priority latency
+//==============================================================================
+
+// Number of tasks in each batch of background load.
+static const int kBackgroundBatchSize = 64;
+
+// Duration of each background task.
+static const iree_duration_t kBackgroundTaskDurationNs = 50000;
+
+// Spins for kBackgroundTaskDurationNs to simulate a chunk of bulk work.
+iree_status_t SpinCall(uintptr_t user_context, iree_task_t* task,
+                       iree_task_submission_t* pending_submission) {
+  iree_time_t end_time_ns = iree_time_now() + kBackgroundTaskDurationNs;
+  while (iree_time_now() < end_time_ns) {
+  }
+  return iree_ok_status();
+}
+
+// Keeps all workers of an executor busy with batches of background tasks from
+// a scope of the given priority until destroyed.
+class BackgroundLoad {
+ public:
+  BackgroundLoad(iree_task_executor_t* executor,
+                 iree_task_scope_priority_t priority)
+      : executor_(executor) {
+    iree_task_scope_initialize(iree_make_cstring_view("background"), &scope_);
+    iree_task_scope_set_priority(&scope_, priority);
+    thread_ = std::thread([this]() { Run(); });
+  }
+
+  ~BackgroundLoad() {
+    stop_.store(true);
+    thread_.join();
+    iree_task_scope_deinitialize(&scope_);
+  }
+
+ private:
+  void Run() {
+    std::vector<iree_task_call_t> call_tasks(kBackgroundBatchSize);
+    std::vector<iree_task_t*> call_task_ptrs(kBackgroundBatchSize);
+    while (!stop_.load()) {
+      // Fan out from a barrier to all of the calls and join them on a fence.
+      iree_task_fence_t* fence = NULL;
+      IREE_CHECK_OK(
+          iree_task_executor_acquire_fence(executor_, &scope_, &fence));
+      for (int i = 0; i < kBackgroundBatchSize; ++i) {
+        iree_task_call_initialize(
+            &scope_, iree_task_make_call_closure(SpinCall, 0), &call_tasks[i]);
+        iree_task_set_completion_task(&call_tasks[i].header, &fence->header);
+        call_task_ptrs[i] = &call_tasks[i].header;
+      }
+      iree_task_barrier_t barrier_task;
+      iree_task_barrier_initialize(&scope_, call_task_ptrs.size(),
+                                   call_task_ptrs.data(), &barrier_task);
+      iree_task_submission_t submission;
+      iree_task_submission_initialize(&submission);
+      iree_task_submission_enqueue(&submission, &barrier_task.header);
+      iree_task_executor_submit(executor_, &submission);
+      iree_task_executor_flush(executor_);
+      IREE_CHECK_OK(
+          iree_task_scope_wait_idle(&scope_, IREE_TIME_INFINITE_FUTURE));
+    }
+  }
+
+  iree_task_executor_t* executor_;
+  iree_task_scope_t scope_;
+  std::atomic<bool> stop_ = {false};
+  std::thread thread_;
+};
+
+// Measures the latency of small dispatches submitted from a foreground scope
+// while the executor is saturated with work from a background scope. When
+// prioritized the foreground scope is interactive and the background scope is
+// background priority such that workers pick up the foreground tiles as soon
+// as their current background task completes instead of after all of the
+// background tasks queued ahead of them.
+//
+// Arguments: [prioritized]
+void BM_MixedPriorityLatency(benchmark::State& state) {
+  bool prioritized = state.range(0) != 0;
+  iree_task_executor_t* executor =
+      CreateExecutor(IREE_TASK_SCHEDULING_MODE_RESERVED, /*worker_count=*/4);
+  iree_task_scope_t scope;
+  iree_task_scope_initialize(iree_make_cstring_view("foreground"), &scope);
+  iree_task_scope_set_priority(&scope,
+                               prioritized
+                                   ? IREE_TASK_SCOPE_PRIORITY_INTERACTIVE
+                                   : IREE_TASK_SCOPE_PRIORITY_NORMAL);
+
+  const uint32_t workgroup_size[3] = {1, 1, 1};
+  const uint32_t workgroup_count[3] = {16, 1, 1};
+  std::vector<double> latencies_us;
+  {
+    BackgroundLoad background_load(
+        executor, prioritized ? IREE_TASK_SCOPE_PRIORITY_BACKGROUND
+                              : IREE_TASK_SCOPE_PRIORITY_NORMAL);
+    for (auto _ : state) {
+      iree_task_dispatch_t dispatch_task;
+      iree_task_dispatch_initialize(
+          &scope, iree_task_make_dispatch_closure(SpinTile, 0), workgroup_size,
+          workgroup_count, &dispatch_task);
+
+      iree_time_t start_time_ns = iree_time_now();
+      SubmitTasks(executor, &scope, &dispatch_task.header,
+                  &dispatch_task.header);
+      IREE_CHECK_OK(
+          iree_task_scope_wait_idle(&scope, IREE_TIME_INFINITE_FUTURE));
+      iree_time_t latency_ns = iree_time_now() - start_time_ns;
+
+      state.SetIterationTime(latency_ns / 1e9);
+      latencies_us.push_back(latency_ns / 1e3);
+    }
+  }
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  state.counters["p50_us"] = Percentile(latencies_us, 0.50);
+  state.counters["p99_us"] = Percentile(latencies_us, 0.99);
+
+  iree_task_scope_deinitialize(&scope);
+  iree_task_executor_release(executor);
+}
+BENCHMARK(BM_MixedPriorityLatency)
+    ->ArgName("prioritized")
+    ->Arg(0)
+    ->Arg(1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
@@ -18,6 +18,7 @@
 #include "iree/base/internal/math.h"
 #include "iree/base/internal/prng.h"
 #include "iree/base/synchronization.h"
+#include "iree/base/threading.h"
 #include "iree/base/tracing.h"
 #include "iree/task/affinity_set.h"
 #include "iree/task/executor.h"
@@ -86,6 +87,18 @@ struct iree_task_executor_s {
   // keeping the waiting_list and wait_set in sync.
   iree_wait_set_t* wait_set;
 
+  // Dedicated thread performing all waits when the executor was created with
+  // IREE_TASK_SCHEDULING_MODE_DEDICATED_WAIT_THREAD; NULL otherwise.
+  // When present the wait thread is the sole owner of waiting_list and wait_set
+  // and coordinators route all waiting tasks to it via incoming_waiting_slist.
+  iree_thread_t* wait_thread;
+  // Event that is always present in the wait_set (using the one handle we
+  // reserve for internal use) and is set to interrupt the wait thread when new
+  // waiting tasks arrive or the executor is shutting down.
+  iree_event_t wait_thread_wake_event;
+  // Set to 1 when the wait thread should exit.
+  iree_atomic_int32_t wait_thread_exit_requested;
+
   // A bitset indicating which workers are live and usable; all attempts to
   // push work onto a particular worker should check first with this mask. This
   // may change over time either automatically or by user request ("don't use
@@ -102,6 +115,11 @@ struct iree_task_executor_s {
   // on already woken workers.
   iree_atomic_task_affinity_set_t worker_idle_mask;
 
+  // Notifications signaled when workers should wake (if they are idle). Each
+  // worker is the member matching its worker index such that a batch of posts
+  // can wake all of the workers receiving tasks at once.
+  iree_notification_set_t worker_wake_notifications;
+
   // Specifies how many workers threads there are.
   // For now this number is fixed per executor however if we wanted to enable
   // live join/leave behavior we could change this to a registration mechanism.
@@ -138,9 +156,11 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
 // Tries to steal an entire task from a sibling worker (based on topology).
 // Returns a task that is available (has not yet begun processing at all).
 // May steal multiple tasks and add them to the |local_task_queue|.
+// Only workers in |work_stealing_mask| will be considered as victims.
 iree_task_t* iree_task_executor_try_steal_task(
     iree_task_executor_t* executor,
     iree_task_affinity_set_t constructive_sharing_mask,
+    iree_task_affinity_set_t work_stealing_mask,
     uint32_t max_theft_attempts, iree_prng_minilcg128_state_t* theft_prng,
     iree_task_queue_t* local_task_queue);
 
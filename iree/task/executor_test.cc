@@ -97,8 +97,6 @@ TEST(ExecutorTest, Any) {
             IREE_TRACE_SCOPE0("tile0");
             EXPECT_EQ(0, user_context);
             simulate_work(tile_context);
-            iree_atomic_fetch_add_int32(&tile_context->statistics->reserved, 1,
-                                        iree_memory_order_relaxed);
             return iree_ok_status();
           },
           0),
@@ -117,8 +115,6 @@ TEST(ExecutorTest, Any) {
             IREE_TRACE_SCOPE0("tile1");
             EXPECT_EQ(0, user_context);
             simulate_work(tile_context);
-            iree_atomic_fetch_add_int32(&tile_context->statistics->reserved, 1,
-                                        iree_memory_order_relaxed);
             return iree_ok_status();
           },
           0),
@@ -174,6 +170,13 @@ TEST(ExecutorTest, Any) {
 
   IREE_CHECK_OK(iree_task_scope_wait_idle(&scope_a, IREE_TIME_INFINITE_FUTURE));
 
+  // All tiles from both dispatches should have been tallied into the scope.
+  iree_task_dispatch_statistics_t statistics =
+      iree_task_scope_consume_statistics(&scope_a);
+  EXPECT_EQ(32 * 4 * 2 + 16 * 2 * 1,
+            iree_atomic_load_int64(&statistics.tile_count,
+                                   iree_memory_order_relaxed));
+
   iree_task_scope_deinitialize(&scope_a);
   iree_task_executor_release(executor);
 }
@@ -123,29 +123,13 @@ static void iree_task_post_batch_wake_workers(
     }
   }
 
-  // TODO(#4016): use a FUTEX_WAKE_BITSET here to wake all of the workers that
-  // have pending work in a single syscall (vs. popcnt(worker_pending_mask)
-  // syscalls). This will reduce wake latency for workers later in the set;
-  // for example today worker[31] will wait until workers[0-30] have had their
-  // syscalls performed before it's even requested to wake. This also loses
-  // information the kernel could use to avoid core migration as it knows when N
-  // threads will be needed simultaneously and can hopefully perform any needed
-  // migrations prior to beginning execution.
-  int wake_count = iree_task_affinity_set_count_ones(wake_mask);
-  int worker_index = 0;
-  for (int i = 0; i < wake_count; ++i) {
-    int offset = iree_task_affinity_set_count_trailing_zeros(wake_mask);
-    int wake_index = worker_index + offset;
-    worker_index += offset + 1;
-    wake_mask = iree_shr(wake_mask, offset + 1);
-
-    // Wake workers if they are waiting - workers are the only thing that can
-    // wait on this notification so this should almost always be either free (an
-    // atomic load) if a particular worker isn't waiting or it's required to
-    // actually wake it and we can't avoid it.
-    iree_task_worker_t* worker = &executor->workers[wake_index];
-    iree_notification_post(&worker->wake_notification, 1);
-  }
+  // Wake all of the workers that have pending work with a single post. On
+  // platforms supporting it this is a single FUTEX_WAKE_BITSET syscall (vs.
+  // popcnt(wake_mask) syscalls) so that the last worker in the set isn't
+  // waiting on the wakes of all the ones before it and the kernel knows that N
+  // threads will be needed simultaneously. Workers that aren't waiting don't
+  // need a syscall at all.
+  iree_notification_set_post(&executor->worker_wake_notifications, wake_mask);
 
   IREE_TRACE_ZONE_END(z0);
 }
@@ -16,36 +16,115 @@
 
 #include <assert.h>
 
+#include "iree/task/tuning.h"
+
+// Virtual time advanced by each priority level when one of its tasks is
+// popped. Lower strides (higher weights) get selected more frequently.
+static const uint32_t
+    iree_task_queue_priority_strides[IREE_TASK_SCOPE_PRIORITY_COUNT] = {
+        IREE_TASK_PRIORITY_STRIDE / IREE_TASK_PRIORITY_WEIGHT_BACKGROUND,
+        IREE_TASK_PRIORITY_STRIDE / IREE_TASK_PRIORITY_WEIGHT_NORMAL,
+        IREE_TASK_PRIORITY_STRIDE / IREE_TASK_PRIORITY_WEIGHT_INTERACTIVE,
+};
+
 void iree_task_queue_initialize(iree_task_queue_t* out_queue) {
   memset(out_queue, 0, sizeof(*out_queue));
   iree_slim_mutex_initialize(&out_queue->mutex);
-  iree_task_list_initialize(&out_queue->list);
+  for (int i = 0; i < IREE_TASK_SCOPE_PRIORITY_COUNT; ++i) {
+    iree_task_list_initialize(&out_queue->lists[i]);
+  }
 }
 
 void iree_task_queue_deinitialize(iree_task_queue_t* queue) {
-  iree_task_list_discard(&queue->list);
+  for (int i = 0; i < IREE_TASK_SCOPE_PRIORITY_COUNT; ++i) {
+    iree_task_list_discard(&queue->lists[i]);
+  }
   iree_slim_mutex_deinitialize(&queue->mutex);
 }
 
+static bool iree_task_queue_is_empty_locked(iree_task_queue_t* queue) {
+  for (int i = 0; i < IREE_TASK_SCOPE_PRIORITY_COUNT; ++i) {
+    if (!iree_task_list_is_empty(&queue->lists[i])) return false;
+  }
+  return true;
+}
+
 bool iree_task_queue_is_empty(iree_task_queue_t* queue) {
   iree_slim_mutex_lock(&queue->mutex);
-  bool is_empty = iree_task_list_is_empty(&queue->list);
+  bool is_empty = iree_task_queue_is_empty_locked(queue);
   iree_slim_mutex_unlock(&queue->mutex);
   return is_empty;
 }
 
+// Selects the next task to run from the per-priority lists with stride
+// scheduling and pops it from its list.
+static iree_task_t* iree_task_queue_pop_front_locked(iree_task_queue_t* queue) {
+  // Select the priority whose next task would finish earliest in virtual time.
+  // Walk from the highest priority down so that ties favor higher priorities.
+  int selected = -1;
+  uint32_t selected_finish_time = 0;
+  for (int i = IREE_TASK_SCOPE_PRIORITY_COUNT - 1; i >= 0; --i) {
+    if (iree_task_list_is_empty(&queue->lists[i])) continue;
+    uint32_t finish_time =
+        queue->virtual_times[i] + iree_task_queue_priority_strides[i];
+    if (selected < 0 || (int32_t)(finish_time - selected_finish_time) < 0) {
+      selected = i;
+      selected_finish_time = finish_time;
+    }
+  }
+  if (selected < 0) return NULL;
+
+  // Priorities that have no tasks catch up to the selected virtual time so that
+  // when tasks arrive they only receive their fair share from then on instead
+  // of a burst of exclusive execution to make up for the time they were idle.
+  const uint32_t selected_time = queue->virtual_times[selected];
+  for (int i = 0; i < IREE_TASK_SCOPE_PRIORITY_COUNT; ++i) {
+    if (iree_task_list_is_empty(&queue->lists[i]) &&
+        (int32_t)(queue->virtual_times[i] - selected_time) < 0) {
+      queue->virtual_times[i] = selected_time;
+    }
+  }
+  queue->virtual_times[selected] += iree_task_queue_priority_strides[selected];
+
+  return iree_task_list_pop_front(&queue->lists[selected]);
+}
+
+// Moves all tasks from the FIFO |list| into the per-priority FIFO |out_lists|.
+static void iree_task_queue_split_by_priority(
+    iree_task_list_t* list,
+    iree_task_list_t out_lists[IREE_TASK_SCOPE_PRIORITY_COUNT]) {
+  for (int i = 0; i < IREE_TASK_SCOPE_PRIORITY_COUNT; ++i) {
+    iree_task_list_initialize(&out_lists[i]);
+  }
+  iree_task_t* task = NULL;
+  while ((task = iree_task_list_pop_front(list))) {
+    iree_task_list_push_back(&out_lists[iree_task_priority(task)], task);
+  }
+}
+
+// Appends the per-priority |lists| to the queue.
+static void iree_task_queue_append_locked(
+    iree_task_queue_t* queue,
+    iree_task_list_t lists[IREE_TASK_SCOPE_PRIORITY_COUNT]) {
+  for (int i = 0; i < IREE_TASK_SCOPE_PRIORITY_COUNT; ++i) {
+    iree_task_list_append(&queue->lists[i], &lists[i]);
+  }
+}
+
 void iree_task_queue_push_front(iree_task_queue_t* queue, iree_task_t* task) {
   iree_slim_mutex_lock(&queue->mutex);
-  iree_task_list_push_front(&queue->list, task);
+  iree_task_list_push_front(&queue->lists[iree_task_priority(task)], task);
   iree_slim_mutex_unlock(&queue->mutex);
 }
 
 void iree_task_queue_append_from_lifo_list_unsafe(iree_task_queue_t* queue,
                                                   iree_task_list_t* list) {
-  // NOTE: reversing the list outside of the lock.
+  // NOTE: reversing and splitting the list outside of the lock.
   iree_task_list_reverse(list);
+  iree_task_list_t priority_lists[IREE_TASK_SCOPE_PRIORITY_COUNT];
+  iree_task_queue_split_by_priority(list, priority_lists);
   iree_slim_mutex_lock(&queue->mutex);
-  iree_task_list_append(&queue->list, list);
+  iree_task_queue_append_locked(queue, priority_lists);
   iree_slim_mutex_unlock(&queue->mutex);
 }
 
@@ -58,11 +137,13 @@ iree_task_t* iree_task_queue_flush_from_lifo_slist(
   bool did_flush = iree_atomic_task_slist_flush(
       source_slist, IREE_ATOMIC_SLIST_FLUSH_ORDER_APPROXIMATE_FIFO,
       &suffix.head, &suffix.tail);
+  iree_task_list_t priority_lists[IREE_TASK_SCOPE_PRIORITY_COUNT];
+  iree_task_queue_split_by_priority(&suffix, priority_lists);
 
   // Append the tasks and pop off the front for return.
   iree_slim_mutex_lock(&queue->mutex);
-  if (did_flush) iree_task_list_append(&queue->list, &suffix);
-  iree_task_t* next_task = iree_task_list_pop_front(&queue->list);
+  if (did_flush) iree_task_queue_append_locked(queue, priority_lists);
+  iree_task_t* next_task = iree_task_queue_pop_front_locked(queue);
   iree_slim_mutex_unlock(&queue->mutex);
 
   return next_task;
@@ -70,7 +151,7 @@ iree_task_t* iree_task_queue_flush_from_lifo_slist(
 
 iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue) {
   iree_slim_mutex_lock(&queue->mutex);
-  iree_task_t* next_task = iree_task_list_pop_front(&queue->list);
+  iree_task_t* next_task = iree_task_queue_pop_front_locked(queue);
   iree_slim_mutex_unlock(&queue->mutex);
   return next_task;
 }
@@ -78,19 +159,32 @@ iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue) {
 iree_task_t* iree_task_queue_try_steal(iree_task_queue_t* source_queue,
                                        iree_task_queue_t* target_queue,
                                        iree_host_size_t max_tasks) {
-  // First attempt to steal up to max_tasks from the source queue.
+  // First attempt to steal up to max_tasks from the highest priority list in
+  // the source queue that has any tasks.
   iree_task_list_t stolen_tasks;
   iree_task_list_initialize(&stolen_tasks);
   iree_slim_mutex_lock(&source_queue->mutex);
-  iree_task_list_split(&source_queue->list, max_tasks, &stolen_tasks);
+  for (int i = IREE_TASK_SCOPE_PRIORITY_COUNT - 1; i >= 0; --i) {
+    if (iree_task_list_is_empty(&source_queue->lists[i])) continue;
+    iree_task_list_split(&source_queue->lists[i], max_tasks, &stolen_tasks);
+    break;
+  }
   iree_slim_mutex_unlock(&source_queue->mutex);
 
+  // Mark the tasks as stolen so that we can attribute them in statistics.
+  for (iree_task_t* task = stolen_tasks.head; task != NULL;
+       task = task->next_task) {
+    task->flags |= IREE_TASK_FLAG_STOLEN;
+  }
+
   // Add any stolen tasks to the target queue and pop off the head for return.
   iree_task_t* next_task = NULL;
   if (!iree_task_list_is_empty(&stolen_tasks)) {
+    iree_task_scope_priority_t priority =
+        iree_task_priority(iree_task_list_front(&stolen_tasks));
     iree_slim_mutex_lock(&target_queue->mutex);
-    iree_task_list_append(&target_queue->list, &stolen_tasks);
-    next_task = iree_task_list_pop_front(&target_queue->list);
+    iree_task_list_append(&target_queue->lists[priority], &stolen_tasks);
+    next_task = iree_task_queue_pop_front_locked(target_queue);
     iree_slim_mutex_unlock(&target_queue->mutex);
   }
   return next_task;
@@ -18,6 +18,7 @@
 #include "iree/base/api.h"
 #include "iree/base/synchronization.h"
 #include "iree/task/list.h"
+#include "iree/task/scope.h"
 #include "iree/task/task.h"
 
 #ifdef __cplusplus
@@ -108,12 +109,25 @@ extern "C" {
 // list we can't easily just walk backward and we don't want to be introducing
 // cache line contention as thieves start touching the same tasks as the worker
 // is while processing.
+//
+// Tasks are kept in one FIFO list per scope priority. Pops select between the
+// non-empty lists with stride scheduling: each priority level has a virtual
+// time that advances inversely proportional to its weight each time a task is
+// popped from it and the level whose next task would finish earliest in
+// virtual time wins (ties go to the higher priority). This gives
+// weighted-fair sharing of the worker among priorities with O(1)
+// bookkeeping. When only a single priority is in use (the common case) this
+// behaves exactly like a single FIFO list.
 typedef struct {
   // Must be held when manipulating the queue. >90% accesses are by the owner.
   iree_slim_mutex_t mutex;
 
-  // FIFO task list.
-  iree_task_list_t list IREE_GUARDED_BY(mutex);
+  // FIFO task lists indexed by iree_task_scope_priority_t.
+  iree_task_list_t lists[IREE_TASK_SCOPE_PRIORITY_COUNT] IREE_GUARDED_BY(mutex);
+
+  // Virtual time of each priority level used for weighted-fair selection.
+  // Wraps and must be compared with wrap-aware arithmetic.
+  uint32_t virtual_times[IREE_TASK_SCOPE_PRIORITY_COUNT] IREE_GUARDED_BY(mutex);
 } iree_task_queue_t;
 
 // Initializes a work-stealing task queue in-place.
@@ -150,6 +164,8 @@ iree_task_t* iree_task_queue_flush_from_lifo_slist(
     iree_task_queue_t* queue, iree_atomic_task_slist_t* source_slist);
 
 // Pops a task from the front of the queue if any are available.
+// When tasks of multiple priorities are queued the task is selected from the
+// priorities in weighted-fair order.
 //
 // Must only be called from the owning worker's thread.
 iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue);
@@ -157,7 +173,9 @@ iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue);
 // Tries to steal up to |max_tasks| from the back of the queue.
 // Returns NULL if no tasks are available and otherwise up to |max_tasks| tasks
 // that were at the tail of the |source_queue| will be moved to the
-// |target_queue| and the first of the stolen tasks is returned.
+// |target_queue| and the first of the stolen tasks is returned. Tasks are
+// stolen from the highest priority with any queued so that thieves help finish
+// latency-sensitive work first.
 //
 // It's expected this is not called from the queue's owning worker, though it's
 // valid to do so.
@@ -14,6 +14,11 @@
 
 #include "iree/task/queue.h"
 
+#include <cstring>
+#include <vector>
+
+#include "iree/task/scope.h"
+#include "iree/task/tuning.h"
 #include "iree/testing/gtest.h"
 #include "iree/testing/status_matchers.h"
 
@@ -182,6 +187,92 @@ TEST(QueueTest, FlushSlistOrdered) {
   iree_task_queue_deinitialize(&queue);
 }
 
+TEST(QueueTest, PriorityOrdered) {
+  iree_task_scope_t background_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("background"),
+                             &background_scope);
+  iree_task_scope_set_priority(&background_scope,
+                               IREE_TASK_SCOPE_PRIORITY_BACKGROUND);
+  iree_task_scope_t interactive_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("interactive"),
+                             &interactive_scope);
+  iree_task_scope_set_priority(&interactive_scope,
+                               IREE_TASK_SCOPE_PRIORITY_INTERACTIVE);
+
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+
+  // Make a lifo list: c<-b<-a with the interactive task last.
+  iree_task_list_t list = {0};
+  iree_task_t task_a = {0};
+  task_a.scope = &background_scope;
+  iree_task_list_push_front(&list, &task_a);
+  iree_task_t task_b = {0};
+  iree_task_list_push_front(&list, &task_b);
+  iree_task_t task_c = {0};
+  task_c.scope = &interactive_scope;
+  iree_task_list_push_front(&list, &task_c);
+  iree_task_queue_append_from_lifo_list_unsafe(&queue, &list);
+
+  // Higher priorities should be popped first.
+  EXPECT_EQ(&task_c, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(&task_b, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(&task_a, iree_task_queue_pop_front(&queue));
+  EXPECT_TRUE(iree_task_queue_is_empty(&queue));
+
+  iree_task_queue_deinitialize(&queue);
+  iree_task_scope_deinitialize(&interactive_scope);
+  iree_task_scope_deinitialize(&background_scope);
+}
+
+TEST(QueueTest, PriorityWeightedFair) {
+  iree_task_scope_t background_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("background"),
+                             &background_scope);
+  iree_task_scope_set_priority(&background_scope,
+                               IREE_TASK_SCOPE_PRIORITY_BACKGROUND);
+  iree_task_scope_t interactive_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("interactive"),
+                             &interactive_scope);
+  iree_task_scope_set_priority(&interactive_scope,
+                               IREE_TASK_SCOPE_PRIORITY_INTERACTIVE);
+
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+
+  // Queue up enough tasks of each priority that both remain non-empty.
+  static const int kTaskCount = 64;
+  std::vector<iree_task_t> background_tasks(kTaskCount);
+  std::vector<iree_task_t> interactive_tasks(kTaskCount);
+  for (int i = 0; i < kTaskCount; ++i) {
+    memset(&background_tasks[i], 0, sizeof(iree_task_t));
+    background_tasks[i].scope = &background_scope;
+    iree_task_queue_push_front(&queue, &background_tasks[i]);
+    memset(&interactive_tasks[i], 0, sizeof(iree_task_t));
+    interactive_tasks[i].scope = &interactive_scope;
+    iree_task_queue_push_front(&queue, &interactive_tasks[i]);
+  }
+
+  // Background tasks should still make progress in proportion to the weights.
+  static const int kPopCount = 34;
+  int background_count = 0;
+  for (int i = 0; i < kPopCount; ++i) {
+    iree_task_t* task = iree_task_queue_pop_front(&queue);
+    ASSERT_NE(nullptr, task);
+    if (task->scope == &background_scope) ++background_count;
+  }
+  EXPECT_EQ(kPopCount * IREE_TASK_PRIORITY_WEIGHT_BACKGROUND /
+                (IREE_TASK_PRIORITY_WEIGHT_BACKGROUND +
+                 IREE_TASK_PRIORITY_WEIGHT_INTERACTIVE),
+            background_count);
+
+  while (iree_task_queue_pop_front(&queue)) {
+  }
+  iree_task_queue_deinitialize(&queue);
+  iree_task_scope_deinitialize(&interactive_scope);
+  iree_task_scope_deinitialize(&background_scope);
+}
+
 TEST(QueueTest, TryStealEmpty) {
   iree_task_queue_t source_queue;
   iree_task_queue_initialize(&source_queue);
@@ -26,6 +26,7 @@ void iree_task_scope_initialize(iree_string_view_t name,
       iree_min(name.size, IREE_ARRAYSIZE(out_scope->name) - 1);
   memcpy(out_scope->name, name.data, name_length);
   out_scope->name[name_length] = 0;
+  out_scope->priority = IREE_TASK_SCOPE_PRIORITY_NORMAL;
 
   // TODO(benvanik): pick trace colors based on name hash.
   IREE_TRACE(out_scope->task_trace_color = 0xFFFF0000u);
@@ -64,10 +65,44 @@ iree_string_view_t iree_task_scope_name(iree_task_scope_t* scope) {
   return iree_make_cstring_view(scope->name);
 }
 
+void iree_task_scope_set_priority(iree_task_scope_t* scope,
+                                  iree_task_scope_priority_t priority) {
+  IREE_ASSERT_LT(priority, IREE_TASK_SCOPE_PRIORITY_COUNT);
+  scope->priority = priority;
+}
+
 iree_task_dispatch_statistics_t iree_task_scope_consume_statistics(
     iree_task_scope_t* scope) {
-  iree_task_dispatch_statistics_t result = scope->dispatch_statistics;
-  memset(&scope->dispatch_statistics, 0, sizeof(scope->dispatch_statistics));
+  // Exchange each field individually so that dispatches retiring concurrently
+  // have their statistics land in either this result or the next one.
+  iree_task_dispatch_statistics_t* statistics = &scope->dispatch_statistics;
+  iree_task_dispatch_statistics_t result;
+  memset(&result, 0, sizeof(result));
+  iree_atomic_store_int64(
+      &result.tile_count,
+      iree_atomic_exchange_int64(&statistics->tile_count, 0,
+                                 iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+  iree_atomic_store_int32(
+      &result.shard_count,
+      iree_atomic_exchange_int32(&statistics->shard_count, 0,
+                                 iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+  iree_atomic_store_int32(
+      &result.stolen_shard_count,
+      iree_atomic_exchange_int32(&statistics->stolen_shard_count, 0,
+                                 iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+  iree_atomic_store_int64(
+      &result.worker_wall_time_ns,
+      iree_atomic_exchange_int64(&statistics->worker_wall_time_ns, 0,
+                                 iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+  iree_atomic_store_int64(
+      &result.worker_cpu_time_ns,
+      iree_atomic_exchange_int64(&statistics->worker_cpu_time_ns, 0,
+                                 iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
   return result;
 }
 
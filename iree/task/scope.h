@@ -25,6 +25,25 @@
 extern "C" {
 #endif  // __cplusplus
 
+// Scheduling priority of all tasks within a scope.
+// Workers pick their next task from the ready tasks of each priority using
+// weighted-fair scheduling: higher priorities receive a larger share of the
+// execution slots (see IREE_TASK_PRIORITY_WEIGHT_*) while lower priorities are
+// still guaranteed to make progress. Priorities only take effect at task
+// boundaries; tasks that have already begun executing are never preempted.
+enum iree_task_scope_priority_e {
+  // Bulk/throughput-oriented work that can tolerate latency.
+  IREE_TASK_SCOPE_PRIORITY_BACKGROUND = 0u,
+  // Default priority of all scopes.
+  IREE_TASK_SCOPE_PRIORITY_NORMAL = 1u,
+  // Latency-sensitive work such as user-facing requests.
+  IREE_TASK_SCOPE_PRIORITY_INTERACTIVE = 2u,
+};
+typedef uint8_t iree_task_scope_priority_t;
+
+// Total number of priority levels in iree_task_scope_priority_t.
+#define IREE_TASK_SCOPE_PRIORITY_COUNT 3
+
 // A loose way of grouping tasks within the task system.
 // Each scope represents a unique collection of tasks that have some related
 // properties - most often their producer - that need to carry along some
@@ -51,6 +70,9 @@ typedef struct iree_task_scope_s {
   // Name used for logging and tracing.
   char name[16];
 
+  // Scheduling priority of tasks in the scope.
+  iree_task_scope_priority_t priority;
+
   // Base color used for tasks in this scope.
   // The color will be modulated based on task type.
   IREE_TRACE(uint32_t task_trace_color;)
@@ -103,6 +125,19 @@ void iree_task_scope_deinitialize(iree_task_scope_t* scope);
 // string.
 iree_string_view_t iree_task_scope_name(iree_task_scope_t* scope);
 
+// Sets the scheduling |priority| of all tasks in the scope.
+// Must only be called while the scope is idle; tasks already submitted may be
+// scheduled with either the old or new priority.
+void iree_task_scope_set_priority(iree_task_scope_t* scope,
+                                  iree_task_scope_priority_t priority);
+
+// Returns the scheduling priority of |task| based on its scope.
+// Tasks without a scope are scheduled with IREE_TASK_SCOPE_PRIORITY_NORMAL.
+static inline iree_task_scope_priority_t iree_task_priority(
+    const iree_task_t* task) {
+  return task->scope ? task->scope->priority : IREE_TASK_SCOPE_PRIORITY_NORMAL;
+}
+
 // Returns and resets the statistics for the scope.
 // Statistics may experience tearing (non-atomic update across fields) if this
 // is performed while tasks are in-flight.
@@ -17,6 +17,7 @@
 #include <stdio.h>
 
 #include "iree/base/internal/debugging.h"
+#include "iree/base/threading.h"
 #include "iree/task/task_impl.h"
 
 //==============================================================================
@@ -32,6 +33,21 @@ void iree_task_initialize(iree_task_type_t type, iree_task_scope_t* scope,
   out_task->type = type;
 }
 
+void iree_task_reset(iree_task_t* task) {
+  task->next_task = NULL;
+  task->completion_task = NULL;
+  iree_atomic_store_int32(&task->pending_dependency_count, 0,
+                          iree_memory_order_relaxed);
+
+  // Only retain the flags that describe how the task was configured.
+  task->flags &=
+      IREE_TASK_FLAG_DISPATCH_INDIRECT | IREE_TASK_FLAG_DISPATCH_SLICED;
+  if (task->type == IREE_TASK_TYPE_DISPATCH) {
+    iree_task_dispatch_t* dispatch_task = (iree_task_dispatch_t*)task;
+    memset(&dispatch_task->statistics, 0, sizeof(dispatch_task->statistics));
+  }
+}
+
 void iree_task_set_cleanup_fn(iree_task_t* task,
                               iree_task_cleanup_fn_t cleanup_fn) {
   task->cleanup_fn = cleanup_fn;
@@ -352,7 +368,59 @@ static uint32_t iree_task_tile_to_color(
 void iree_task_dispatch_statistics_merge(
     const iree_task_dispatch_statistics_t* source,
     iree_task_dispatch_statistics_t* target) {
-  // TODO(benvanik): statistics.
+  // NOTE: the source may be concurrently updated (such as when merging a scope
+  // that is still executing) so we load each field atomically. The atomic load
+  // APIs take non-const pointers.
+  iree_task_dispatch_statistics_t* mutable_source =
+      (iree_task_dispatch_statistics_t*)source;
+  iree_atomic_fetch_add_int64(
+      &target->tile_count,
+      iree_atomic_load_int64(&mutable_source->tile_count,
+                             iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+  iree_atomic_fetch_add_int32(
+      &target->shard_count,
+      iree_atomic_load_int32(&mutable_source->shard_count,
+                             iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+  iree_atomic_fetch_add_int32(
+      &target->stolen_shard_count,
+      iree_atomic_load_int32(&mutable_source->stolen_shard_count,
+                             iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+  iree_atomic_fetch_add_int64(
+      &target->worker_wall_time_ns,
+      iree_atomic_load_int64(&mutable_source->worker_wall_time_ns,
+                             iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+  iree_atomic_fetch_add_int64(
+      &target->worker_cpu_time_ns,
+      iree_atomic_load_int64(&mutable_source->worker_cpu_time_ns,
+                             iree_memory_order_relaxed),
+      iree_memory_order_relaxed);
+}
+
+// Records the time spent executing |tile_count| tiles of a slice or shard
+// into its local |statistics| prior to merging them into the dispatch.
+static void iree_task_dispatch_statistics_record_shard(
+    const iree_task_t* task, uint32_t tile_count, iree_time_t start_time_ns,
+    iree_duration_t start_cpu_time_ns,
+    iree_task_dispatch_statistics_t* statistics) {
+  iree_atomic_fetch_add_int64(&statistics->tile_count, tile_count,
+                              iree_memory_order_relaxed);
+  iree_atomic_fetch_add_int32(&statistics->shard_count, 1,
+                              iree_memory_order_relaxed);
+  if (task->flags & IREE_TASK_FLAG_STOLEN) {
+    iree_atomic_fetch_add_int32(&statistics->stolen_shard_count, 1,
+                                iree_memory_order_relaxed);
+  }
+  iree_atomic_fetch_add_int64(&statistics->worker_wall_time_ns,
+                              iree_time_now() - start_time_ns,
+                              iree_memory_order_relaxed);
+  iree_atomic_fetch_add_int64(
+      &statistics->worker_cpu_time_ns,
+      iree_thread_current_cpu_time() - start_cpu_time_ns,
+      iree_memory_order_relaxed);
 }
 
 //==============================================================================
@@ -555,14 +623,17 @@ void iree_task_dispatch_issue_sharded(
   // Compute how many tiles we want each shard to reserve at a time from the
   // larger grid. A higher number reduces overhead and improves locality while
   // a lower number reduces maximum worst-case latency (coarser work stealing).
+  // Shards will shrink their reservations from this maximum as the grid is
+  // exhausted; see iree_task_dispatch_shard_reserve_tiles.
   if (shared_state->tile_count <
       worker_count * IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION) {
     // Grid is small - allow it to be eagerly sliced up.
-    shared_state->tiles_per_reservation = 1;
+    shared_state->max_tiles_per_reservation = 1;
   } else {
-    shared_state->tiles_per_reservation =
+    shared_state->max_tiles_per_reservation =
         IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION;
   }
+  shared_state->shard_count = (uint32_t)shard_count;
 
   // Randomize starting worker.
   iree_host_size_t worker_offset = iree_task_post_batch_select_worker(
@@ -679,6 +750,8 @@ iree_status_t iree_task_dispatch_slice_execute(
          sizeof(tile_context.workgroup_count));
   tile_context.shared_memory = task->shared_memory;
   tile_context.statistics = &task->slice_statistics;
+  const iree_time_t start_time_ns = iree_time_now();
+  const iree_duration_t start_cpu_time_ns = iree_thread_current_cpu_time();
 
   const uint32_t base_x = task->workgroup_base[0];
   const uint32_t base_y = task->workgroup_base[1];
@@ -719,6 +792,10 @@ iree_status_t iree_task_dispatch_slice_execute(
   }
 
   // Push aggregate statistics up to the dispatch.
+  iree_task_dispatch_statistics_record_shard(
+      &task->header,
+      (range_x - base_x + 1) * (range_y - base_y + 1) * (range_z - base_z + 1),
+      start_time_ns, start_cpu_time_ns, &task->slice_statistics);
   if (task->dispatch_statistics) {
     iree_task_dispatch_statistics_merge(&task->slice_statistics,
                                         task->dispatch_statistics);
@@ -759,6 +836,38 @@ iree_task_dispatch_shard_t* iree_task_dispatch_shard_allocate(
   return shard_task;
 }
 
+// Reserves the next range of tiles from the grid, returning the first tile
+// index and storing the exclusive end in |out_tile_end|. When the returned base
+// is >= the tile count the grid has been exhausted.
+//
+// Reservations are sized relative to the number of tiles remaining such that
+// they shrink toward 1 at the end of the grid (guided self-scheduling). The
+// remaining count is sampled before the reservation is made and may be stale by
+// the time the reservation lands; that only affects the size of the
+// reservation and not the correctness as each tile is still handed out exactly
+// once by the atomic add.
+static uint32_t iree_task_dispatch_shard_reserve_tiles(
+    iree_task_dispatch_shard_state_t* shared_state, uint32_t* out_tile_end) {
+  const uint32_t tile_count = shared_state->tile_count;
+  uint32_t tiles_per_reservation = shared_state->max_tiles_per_reservation;
+  if (tiles_per_reservation > 1) {
+    uint32_t tile_index = (uint32_t)iree_atomic_load_int32(
+        &shared_state->tile_index, iree_memory_order_relaxed);
+    uint32_t remaining_tiles =
+        tile_index < tile_count ? tile_count - tile_index : 0;
+    uint32_t guided_tiles =
+        remaining_tiles / (shared_state->shard_count *
+                           IREE_TASK_DISPATCH_GUIDED_RESERVATION_FACTOR);
+    tiles_per_reservation =
+        iree_max(1u, iree_min(tiles_per_reservation, guided_tiles));
+  }
+  uint32_t tile_base = (uint32_t)iree_atomic_fetch_add_int32(
+      &shared_state->tile_index, tiles_per_reservation,
+      iree_memory_order_relaxed);
+  *out_tile_end = iree_min(tile_base + tiles_per_reservation, tile_count);
+  return tile_base;
+}
+
 iree_status_t iree_task_dispatch_shard_execute(
     iree_task_dispatch_shard_t* task,
     iree_task_submission_t* pending_submission) {
@@ -783,20 +892,19 @@ iree_status_t iree_task_dispatch_shard_execute(
   iree_task_dispatch_statistics_t shard_statistics;
   memset(&shard_statistics, 0, sizeof(shard_statistics));
   tile_context.statistics = &shard_statistics;
+  const iree_time_t start_time_ns = iree_time_now();
+  const iree_duration_t start_cpu_time_ns = iree_thread_current_cpu_time();
+  uint32_t executed_tile_count = 0;
 
   // Loop over all tiles until they are all processed.
+  // NOTE: we only reserve the next range once the current one has completed;
+  // reserving ahead would leave tiles stranded on this shard while it is busy
+  // and other shards are idle at the tail of the grid.
   const uint32_t tile_count = shared_state->tile_count;
-  const uint32_t tiles_per_reservation = shared_state->tiles_per_reservation;
-  uint32_t tile_base = iree_atomic_fetch_add_int32(&shared_state->tile_index,
-                                                   tiles_per_reservation,
-                                                   iree_memory_order_relaxed);
+  uint32_t tile_range = 0;
+  uint32_t tile_base =
+      iree_task_dispatch_shard_reserve_tiles(shared_state, &tile_range);
   while (tile_base < tile_count) {
-    const uint32_t next_tile_base = iree_atomic_fetch_add_int32(
-        &shared_state->tile_index, tiles_per_reservation,
-        iree_memory_order_relaxed);
-
-    const uint32_t tile_range =
-        iree_min(tile_base + tiles_per_reservation, tile_count);
     for (uint32_t tile_index = tile_base; tile_index < tile_range;
          ++tile_index) {
       // TODO(benvanik): faster math here, especially knowing we pull off N
@@ -832,10 +940,15 @@ iree_status_t iree_task_dispatch_shard_execute(
       }
     }
 
-    tile_base = next_tile_base;
+    executed_tile_count += tile_range - tile_base;
+    tile_base =
+        iree_task_dispatch_shard_reserve_tiles(shared_state, &tile_range);
   }
 
   // Push aggregate statistics up to the dispatch.
+  iree_task_dispatch_statistics_record_shard(&task->header, executed_tile_count,
+                                             start_time_ns, start_cpu_time_ns,
+                                             &shard_statistics);
   iree_task_dispatch_statistics_merge(&shard_statistics,
                                       &dispatch_task->statistics);
 
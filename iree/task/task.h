@@ -116,6 +116,10 @@ enum iree_task_flags_e {
   // behavior but without an additional task as dispatches are still required
   // to store information for slices.
   IREE_TASK_FLAG_DISPATCH_RETIRE = 1u << 3,
+
+  // The task was stolen from the worker it was originally posted to.
+  // Used to attribute dispatch statistics and cleared when the task is reset.
+  IREE_TASK_FLAG_STOLEN = 1u << 4,
 };
 typedef uint16_t iree_task_flags_t;
 
@@ -188,6 +192,14 @@ static_assert(offsetof(iree_task_t, next_task) == 0,
 void iree_task_initialize(iree_task_type_t type, iree_task_scope_t* scope,
                           iree_task_t* out_task);
 
+// Resets the execution state of a |task| that has previously completed such
+// that it can be submitted again. The task type, scope, cleanup function, and
+// any data in the wrapping task type are retained while the dependency tracking
+// state and any flags set during execution are cleared. Callers must ensure
+// the task is not in use and must re-establish all dependency edges prior to
+// enqueuing the task again.
+void iree_task_reset(iree_task_t* task);
+
 // Sets the optional function called when the task completes (whether successful
 // or not).
 void iree_task_set_cleanup_fn(iree_task_t* task,
@@ -390,9 +402,31 @@ void iree_task_wait_initialize(iree_task_scope_t* scope,
 // If we find ourselves with a lot of hardware-specific counters (vs more
 // generic ones like 'l2 cache misses' or 'ipc') then we can sprinkle in some
 // #ifdefs.
+//
+// All counters are updated with relaxed atomics: slices and shards accumulate
+// into a local copy while they run and merge once when they complete such that
+// the shared dispatch counters are only touched once per slice/shard.
 typedef struct {
-  // TODO(benvanik): statistics counters.
-  iree_atomic_int32_t reserved;
+  // Total number of tiles (workgroups) executed.
+  iree_atomic_int64_t tile_count;
+
+  // Total number of slices or shards executed. Dividing tile_count by this
+  // gives the average number of tiles each worker processed per dispatch and is
+  // a good indicator of how well tiles were sized.
+  iree_atomic_int32_t shard_count;
+
+  // Number of slices or shards that were stolen from the worker they were
+  // originally scheduled on. High counts indicate poor initial distribution.
+  iree_atomic_int32_t stolen_shard_count;
+
+  // Total wall time in nanoseconds spent by workers executing tiles.
+  iree_atomic_int64_t worker_wall_time_ns;
+
+  // Total CPU time in nanoseconds consumed by workers executing tiles. When
+  // significantly lower than worker_wall_time_ns the workers were preempted
+  // or otherwise descheduled while running. Always 0 on platforms without
+  // per-thread CPU time accounting.
+  iree_atomic_int64_t worker_cpu_time_ns;
 } iree_task_dispatch_statistics_t;
 
 // Merges statistics from |source| to |target| atomically per-field.
@@ -456,8 +490,13 @@ typedef iree_alignas(iree_max_align_t) struct {
 
   // Maximum number of tiles to fetch per tile reservation from the grid.
   // Bounded by IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION and a
-  // reasonable number chosen based on the tile and shard counts.
-  uint32_t tiles_per_reservation;
+  // reasonable number chosen based on the tile and shard counts. Reservations
+  // shrink from this toward 1 as the grid is exhausted.
+  uint32_t max_tiles_per_reservation;
+
+  // Total number of shards processing the dispatch. Used to size reservations
+  // such that the remaining tiles are spread across all shards.
+  uint32_t shard_count;
 
   // Total workgroup count for the task. Can be used in conjunction with the
   // per-invocation workgroup_xyz and workgroup_size to compute offsets/indices.
@@ -31,11 +31,11 @@ class GridCoverage {
     }
   }
 
-  bool Verify() {
+  bool Verify(int32_t expected_count = 1) {
     fflush(stdout);
     for (iree_host_size_t i = 0; i < workgroup_count_; ++i) {
       if (iree_atomic_load_int32(&storage_[i], iree_memory_order_seq_cst) !=
-          1) {
+          expected_count) {
         return false;
       }
     }
@@ -80,6 +80,49 @@ class TaskDispatchTest : public TaskTest {
     task.header.flags |= dispatch_flags;
     IREE_ASSERT_OK(SubmitTasksAndWaitIdle(&task.header, &task.header));
     EXPECT_TRUE(coverage.Verify());
+    VerifyStatistics(workgroup_count);
+  }
+
+  // Verifies the statistics aggregated into the scope account for all tiles
+  // of the |workgroup_count| grid and then resets them.
+  void VerifyStatistics(const uint32_t workgroup_count[3]) {
+    iree_task_dispatch_statistics_t statistics =
+        iree_task_scope_consume_statistics(&scope_);
+    int64_t tile_count = iree_atomic_load_int64(&statistics.tile_count,
+                                                iree_memory_order_relaxed);
+    int32_t shard_count = iree_atomic_load_int32(&statistics.shard_count,
+                                                 iree_memory_order_relaxed);
+    int32_t stolen_shard_count = iree_atomic_load_int32(
+        &statistics.stolen_shard_count, iree_memory_order_relaxed);
+    EXPECT_EQ((int64_t)workgroup_count[0] * workgroup_count[1] *
+                  workgroup_count[2],
+              tile_count);
+    if (tile_count > 0) EXPECT_GE(shard_count, 1);
+    EXPECT_LE(stolen_shard_count, shard_count);
+    EXPECT_GE(iree_atomic_load_int64(&statistics.worker_wall_time_ns,
+                                     iree_memory_order_relaxed),
+              0);
+  }
+
+  // Issues the same dispatch task multiple times by resetting it after each
+  // execution completes; each invocation should be made exactly once per issue.
+  void DispatchAndVerifyGridReissued(const uint32_t workgroup_size[3],
+                                     const uint32_t workgroup_count[3],
+                                     uint32_t dispatch_flags,
+                                     int32_t issue_count) {
+    GridCoverage coverage(workgroup_count);
+    iree_task_dispatch_t task;
+    iree_task_dispatch_initialize(&scope_,
+                                  iree_task_make_dispatch_closure(
+                                      GridCoverage::Tile, (uintptr_t)&coverage),
+                                  workgroup_size, workgroup_count, &task);
+    task.header.flags |= dispatch_flags;
+    for (int32_t i = 0; i < issue_count; ++i) {
+      iree_task_reset(&task.header);
+      IREE_ASSERT_OK(SubmitTasksAndWaitIdle(&task.header, &task.header));
+      VerifyStatistics(workgroup_count);
+    }
+    EXPECT_TRUE(coverage.Verify(issue_count));
   }
 };
 
@@ -135,6 +178,21 @@ TEST_F(TaskDispatchTest, Issue345Sliced) {
                         IREE_TASK_FLAG_DISPATCH_SLICED);
 }
 
+TEST_F(TaskDispatchTest, Reissue345Sharded) {
+  const uint32_t kWorkgroupSize[3] = {1, 1, 1};
+  const uint32_t kWorkgroupCount[3] = {3, 4, 5};
+  DispatchAndVerifyGridReissued(kWorkgroupSize, kWorkgroupCount, 0,
+                                /*issue_count=*/3);
+}
+
+TEST_F(TaskDispatchTest, Reissue345Sliced) {
+  const uint32_t kWorkgroupSize[3] = {1, 1, 1};
+  const uint32_t kWorkgroupCount[3] = {3, 4, 5};
+  DispatchAndVerifyGridReissued(kWorkgroupSize, kWorkgroupCount,
+                                IREE_TASK_FLAG_DISPATCH_SLICED,
+                                /*issue_count=*/3);
+}
+
 TEST_F(TaskDispatchTest, IssueIndirect) {
   static const uint32_t kWorkgroupSize[3] = {1, 1, 1};
   static const uint32_t kWorkgroupCount[3] = {3, 4, 5};
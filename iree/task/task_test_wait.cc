@@ -59,6 +59,84 @@ TEST_F(TaskWaitTest, DISABLED_IssueUnsignaled) {
   iree_event_deinitialize(&event);
 }
 
+class TaskWaitDedicatedThreadTest : public TaskTest {
+ protected:
+  iree_task_scheduling_mode_t scheduling_mode() const override {
+    return IREE_TASK_SCHEDULING_MODE_DEDICATED_WAIT_THREAD;
+  }
+};
+
+TEST_F(TaskWaitDedicatedThreadTest, IssueSignaled) {
+  iree_event_t event;
+  iree_event_initialize(/*initial_state=*/true, &event);
+
+  iree_task_wait_t task;
+  iree_task_wait_initialize(&scope_, event, &task);
+
+  IREE_ASSERT_OK(SubmitTasksAndWaitIdle(&task.header, &task.header));
+
+  iree_event_deinitialize(&event);
+}
+
+TEST_F(TaskWaitDedicatedThreadTest, IssueUnsignaled) {
+  iree_event_t event;
+  iree_event_initialize(/*initial_state=*/false, &event);
+
+  iree_task_wait_t task;
+  iree_task_wait_initialize(&scope_, event, &task);
+
+  // Spin up a thread that will signal the event after we start waiting on it.
+  std::atomic<bool> has_signaled = {false};
+  std::thread signal_thread([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(has_signaled);
+    has_signaled = true;
+    iree_event_set(&event);
+  });
+
+  EXPECT_FALSE(has_signaled);
+  IREE_ASSERT_OK(SubmitTasksAndWaitIdle(&task.header, &task.header));
+  EXPECT_TRUE(has_signaled);
+
+  signal_thread.join();
+  iree_event_deinitialize(&event);
+}
+
+// Tests that a dependent call scheduled after the wait runs once the wait
+// resolves even if all workers are idle (the wait thread must coordinate).
+TEST_F(TaskWaitDedicatedThreadTest, WaitThenCall) {
+  iree_event_t event;
+  iree_event_initialize(/*initial_state=*/false, &event);
+
+  iree_task_wait_t wait_task;
+  iree_task_wait_initialize(&scope_, event, &wait_task);
+
+  std::atomic<int> call_count = {0};
+  iree_task_call_t call_task;
+  iree_task_call_initialize(
+      &scope_,
+      iree_task_make_call_closure(
+          [](uintptr_t user_context, iree_task_t* task,
+             iree_task_submission_t* pending_submission) {
+            ++*reinterpret_cast<std::atomic<int>*>(user_context);
+            return iree_ok_status();
+          },
+          reinterpret_cast<uintptr_t>(&call_count)),
+      &call_task);
+  iree_task_set_completion_task(&wait_task.header, &call_task.header);
+
+  std::thread signal_thread([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    iree_event_set(&event);
+  });
+
+  IREE_ASSERT_OK(SubmitTasksAndWaitIdle(&wait_task.header, &call_task.header));
+  EXPECT_EQ(1, call_count);
+
+  signal_thread.join();
+  iree_event_deinitialize(&event);
+}
+
 // TODO(benvanik): multi-waits: join wait a/b/c to task d.
 // TODO(benvanik): multi-waits: co-issue wait a/b/c to task d/e/f.
 
@@ -29,11 +29,17 @@
 
 class TaskTest : public ::testing::Test {
  protected:
+  // Scheduling mode used when creating the executor. Test fixtures can
+  // override this to run the same tests against different executor modes.
+  virtual iree_task_scheduling_mode_t scheduling_mode() const {
+    return IREE_TASK_SCHEDULING_MODE_RESERVED;
+  }
+
   virtual void SetUp() {
     iree_task_topology_t topology;
     iree_task_topology_initialize_from_group_count(8, &topology);
-    IREE_ASSERT_OK(iree_task_executor_create(IREE_TASK_SCHEDULING_MODE_RESERVED,
-                                             &topology, iree_allocator_system(),
+    IREE_ASSERT_OK(iree_task_executor_create(scheduling_mode(), &topology,
+                                             iree_allocator_system(),
                                              &executor_));
     iree_task_topology_deinitialize(&topology);
 
@@ -31,6 +31,8 @@ void iree_task_topology_group_initialize(
            group_index);
   iree_thread_affinity_set_any(&out_group->ideal_thread_affinity);
   out_group->constructive_sharing_mask = IREE_TASK_TOPOLOGY_GROUP_MASK_ALL;
+  out_group->numa_node = 0;
+  out_group->work_stealing_mask = IREE_TASK_TOPOLOGY_GROUP_MASK_ALL;
 }
 
 void iree_task_topology_initialize(iree_task_topology_t* out_topology) {
@@ -183,6 +185,17 @@ static void iree_task_topology_set_affinity_from_processor(
 #endif  // cpuinfo-like platform field
 }
 
+// Returns the NUMA node the cpuinfo |processor| is attached to.
+static iree_numa_node_id_t iree_task_topology_numa_node_for_processor(
+    const struct cpuinfo_processor* processor) {
+#if defined(__linux__)
+  return iree_numa_node_for_processor(processor->linux_id);
+#else
+  // TODO(#4654): query NUMA nodes on other platforms.
+  return 0;
+#endif  // __linux__
+}
+
 // Returns a bitset with all *processors* that share the same |cache|.
 static uint64_t iree_task_topology_calculate_cache_bits(
     const struct cpuinfo_cache* cache) {
@@ -228,12 +241,14 @@ static void iree_task_topology_group_initialize_from_core(
       cpuinfo_get_processor(processor_i);
   iree_task_topology_set_affinity_from_processor(
       processor, &out_group->ideal_thread_affinity);
+  out_group->numa_node = iree_task_topology_numa_node_for_processor(processor);
 }
 
 // Fixes constructive_sharing_mask values such that they represent other chosen
 // topology groups instead of processor indices. We do this so that code using
 // the topology groups doesn't need to know anything about which physical
-// processor IDs a particular group is mapped to.
+// processor IDs a particular group is mapped to. work_stealing_mask values are
+// populated with the other groups on the same NUMA node.
 static void iree_task_topology_fixup_constructive_sharing_masks(
     iree_task_topology_t* topology) {
   // O(n^2), but n is always <= 64 (and often <= 8).
@@ -246,6 +261,7 @@ static void iree_task_topology_fixup_constructive_sharing_masks(
             cpuinfo_get_processor(group->processor_index));
 
     iree_task_topology_group_mask_t group_mask = 0;
+    iree_task_topology_group_mask_t numa_mask = 0;
     for (iree_host_size_t j = 0; j < topology->group_count; ++j) {
       if (i == j) continue;
       const iree_task_topology_group_t* other_group = &topology->groups[j];
@@ -253,9 +269,13 @@ static void iree_task_topology_fixup_constructive_sharing_masks(
       if (constructive_sharing_mask & group_processor_bits) {
         group_mask |= 1ull << other_group->group_index;
       }
+      if (other_group->numa_node == group->numa_node) {
+        numa_mask |= 1ull << other_group->group_index;
+      }
     }
 
     group->constructive_sharing_mask = group_mask;
+    group->work_stealing_mask = numa_mask;
   }
 }
 
@@ -344,20 +364,39 @@ void iree_task_topology_initialize_from_physical_cores_with_filter(
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Matches only cores attached to the NUMA node specified in |user_data|.
+static bool iree_task_topology_core_filter_numa_node(
+    const struct cpuinfo_core* core, uintptr_t user_data) {
+  return iree_task_topology_numa_node_for_processor(cpuinfo_get_processor(
+             core->processor_start)) == (iree_numa_node_id_t)user_data;
+}
+
 void iree_task_topology_initialize_from_unique_l2_cache_groups(
     iree_host_size_t max_group_count, iree_task_topology_t* out_topology) {
+  iree_task_topology_initialize_from_unique_l2_cache_groups_on_numa_node(
+      IREE_NUMA_NODE_ANY, max_group_count, out_topology);
+}
+
+void iree_task_topology_initialize_from_unique_l2_cache_groups_on_numa_node(
+    iree_numa_node_id_t numa_node, iree_host_size_t max_group_count,
+    iree_task_topology_t* out_topology) {
+  max_group_count =
+      iree_min(max_group_count, IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
   if (!iree_task_topology_is_cpuinfo_available() ||
       !cpuinfo_get_l2_caches_count()) {
-    iree_task_topology_initialize_from_physical_cores(max_group_count,
-                                                      out_topology);
+    if (numa_node == IREE_NUMA_NODE_ANY) {
+      iree_task_topology_initialize_from_physical_cores(max_group_count,
+                                                        out_topology);
+    } else {
+      iree_task_topology_initialize_from_physical_cores_with_filter(
+          iree_task_topology_core_filter_numa_node, numa_node,
+          max_group_count, out_topology);
+    }
     return;
   }
 
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  iree_host_size_t cache_count = cpuinfo_get_l2_caches_count();
-  cache_count = iree_min(cache_count, max_group_count);
-
   iree_task_topology_initialize(out_topology);
 
   // TODO(benvanik): iree_task_topology_rotate_from_base_core to offset all of
@@ -368,15 +407,20 @@ void iree_task_topology_initialize_from_unique_l2_cache_groups(
   // TODO(benvanik): if our group_count <= cache_count/2 then distribute better;
   // we could use l3 cache in addition to ensure we are selecting cores that do
   // (or do not) share.
-  out_topology->group_count = cache_count;
-  for (uint32_t cache_i = 0, group_i = 0; group_i < out_topology->group_count;
+  for (uint32_t cache_i = 0; cache_i < cpuinfo_get_l2_caches_count() &&
+                             out_topology->group_count < max_group_count;
        ++cache_i) {
     const struct cpuinfo_cache* cache = cpuinfo_get_l2_cache(cache_i);
-    const struct cpuinfo_core* core =
-        cpuinfo_get_processor(cache->processor_start)->core;
+    const struct cpuinfo_processor* processor =
+        cpuinfo_get_processor(cache->processor_start);
+    if (numa_node != IREE_NUMA_NODE_ANY &&
+        iree_task_topology_numa_node_for_processor(processor) != numa_node) {
+      continue;
+    }
     iree_task_topology_group_initialize_from_core(
-        group_i, core, &out_topology->groups[group_i]);
-    ++group_i;
+        out_topology->group_count, processor->core,
+        &out_topology->groups[out_topology->group_count]);
+    ++out_topology->group_count;
   }
 
   iree_task_topology_fixup_constructive_sharing_masks(out_topology);
@@ -18,6 +18,7 @@
 #include <limits.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/numa.h"
 #include "iree/base/threading.h"
 #include "iree/task/tuning.h"
 
@@ -60,6 +61,15 @@ typedef struct {
   // workers in a group all share an L2 cache then the groups indicated here may
   // all share the same L3 cache.
   iree_task_topology_group_mask_t constructive_sharing_mask;
+
+  // NUMA node the processors of this group are attached to.
+  iree_numa_node_id_t numa_node;
+
+  // A bitmask of other group indices that workers of this group may steal
+  // tasks from. Topologies derived from the machine limit this to groups on
+  // the same NUMA node so that stolen work does not pull its memory across
+  // the interconnect.
+  iree_task_topology_group_mask_t work_stealing_mask;
 } iree_task_topology_group_t;
 
 // Initializes |out_group| with a |group_index| derived name.
@@ -169,6 +179,18 @@ void iree_task_topology_initialize_from_physical_cores_with_filter(
 void iree_task_topology_initialize_from_unique_l2_cache_groups(
     iree_host_size_t max_group_count, iree_task_topology_t* out_topology);
 
+// Initializes a topology with one group for each unique L2 cache group on the
+// NUMA node |numa_node|. This can be used to create one executor per node
+// such that workers, and the memory they touch, stay local to the node.
+// IREE_NUMA_NODE_ANY behaves the same as
+// iree_task_topology_initialize_from_unique_l2_cache_groups.
+//
+// If NUMA information is not available all processors are assumed to be on
+// node 0.
+void iree_task_topology_initialize_from_unique_l2_cache_groups_on_numa_node(
+    iree_numa_node_id_t numa_node, iree_host_size_t max_group_count,
+    iree_task_topology_t* out_topology);
+
 // TODO(#4654): more helpers and better defaults for the platforms we support.
 // Users can always make their own but just using these is the common path.
 // Ideas:
@@ -151,4 +151,21 @@ TEST(TopologyTest, FromPhysicalCores) {
   iree_task_topology_deinitialize(&topology);
 }
 
+TEST(TopologyTest, FromUniqueL2CacheGroupsOnNUMANode) {
+  static constexpr iree_host_size_t kMaxGroupCount = 4;
+  iree_task_topology_t topology;
+  iree_task_topology_initialize(&topology);
+  // Node 0 always exists (even if the system has no NUMA support).
+  iree_task_topology_initialize_from_unique_l2_cache_groups_on_numa_node(
+      /*numa_node=*/0, kMaxGroupCount, &topology);
+  EnsureTopologyValid(kMaxGroupCount, &topology);
+  for (iree_host_size_t i = 0; i < iree_task_topology_group_count(&topology);
+       ++i) {
+    const iree_task_topology_group_t* group =
+        iree_task_topology_get_group(&topology, i);
+    EXPECT_EQ(0, group->numa_node);
+  }
+  iree_task_topology_deinitialize(&topology);
+}
+
 }  // namespace
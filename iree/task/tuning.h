@@ -118,6 +118,32 @@ extern "C" {
 // memory).
 #define IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION (8)
 
+// Controls how quickly shard tile reservations shrink toward the end of a grid.
+// Each reservation takes the remaining tile count divided by the shard count
+// and this factor (guided self-scheduling), clamped to
+// [1, IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION].
+//
+// Large reservations early on keep the atomic traffic and cache thrashing low
+// while the single-tile reservations at the tail ensure that no worker is left
+// holding a batch of tiles while others sit idle. This is most important when
+// tiles are imbalanced (ragged edges, a core slowed by its SMT sibling, etc).
+// Higher values shrink reservations sooner.
+#define IREE_TASK_DISPATCH_GUIDED_RESERVATION_FACTOR (2)
+
+// Relative share of worker execution slots given to ready tasks of each scope
+// priority when tasks of multiple priorities are queued on the same worker.
+// For example with the defaults a worker that has both interactive and
+// background tasks queued will run 16 interactive tasks for every background
+// task. Weights must be non-zero and no larger than
+// IREE_TASK_PRIORITY_STRIDE.
+#define IREE_TASK_PRIORITY_WEIGHT_BACKGROUND (1)
+#define IREE_TASK_PRIORITY_WEIGHT_NORMAL (4)
+#define IREE_TASK_PRIORITY_WEIGHT_INTERACTIVE (16)
+
+// Virtual time advanced by a priority level each time one of its tasks is
+// selected, divided by its weight. Must be divisible by all weights.
+#define IREE_TASK_PRIORITY_STRIDE (1 << 16)
+
 // Whether to enable per-tile colors for each tile tracing zone based on the
 // tile grid xyz. Not cheap and can be disabled to reduce tracing overhead.
 // TODO(#4017): make per-tile color tracing fast enough to always have on.
@@ -28,10 +28,12 @@ iree_status_t iree_task_worker_initialize(
   IREE_TRACE_ZONE_BEGIN(z0);
 
   out_worker->executor = executor;
+  out_worker->worker_index = worker_index;
   out_worker->worker_bit = iree_task_affinity_for_worker(worker_index);
   out_worker->ideal_thread_affinity = topology_group->ideal_thread_affinity;
   out_worker->constructive_sharing_mask =
       topology_group->constructive_sharing_mask;
+  out_worker->work_stealing_mask = topology_group->work_stealing_mask;
   out_worker->max_theft_attempts =
       executor->worker_count / IREE_TASK_EXECUTOR_MAX_THEFT_ATTEMPTS_DIVISOR;
   iree_prng_minilcg128_initialize(iree_prng_splitmix64_next(seed_prng),
@@ -49,7 +51,6 @@ iree_status_t iree_task_worker_initialize(
   iree_atomic_store_int32(&out_worker->state, initial_state,
                           iree_memory_order_seq_cst);
 
-  iree_notification_initialize(&out_worker->wake_notification);
   iree_notification_initialize(&out_worker->state_notification);
   iree_atomic_task_slist_initialize(&out_worker->mailbox_slist);
   iree_task_queue_initialize(&out_worker->local_task_queue);
@@ -94,12 +95,10 @@ void iree_task_worker_deinitialize(iree_task_worker_t* worker) {
   iree_thread_release(worker->thread);
 
   // Release unfinished tasks by flushing the mailbox (which if we're here can't
-  // get anything more posted to it) and then discarding everything we still
-  // have a reference to.
+  // get anything more posted to it). Everything still in the local queue is
+  // discarded when it is deinitialized below.
   iree_atomic_task_slist_discard(&worker->mailbox_slist);
-  iree_task_list_discard(&worker->local_task_queue.list);
 
-  iree_notification_deinitialize(&worker->wake_notification);
   iree_notification_deinitialize(&worker->state_notification);
   iree_atomic_task_slist_deinitialize(&worker->mailbox_slist);
   iree_task_queue_deinitialize(&worker->local_task_queue);
@@ -133,7 +132,8 @@ void iree_task_worker_request_exit(iree_task_worker_t* worker) {
   }
 
   // Kick the worker in case it is waiting for work.
-  iree_notification_post(&worker->wake_notification, 1);
+  iree_notification_set_post(&worker->executor->worker_wake_notifications,
+                             worker->worker_bit);
 
   IREE_TRACE_ZONE_END(z0);
 }
@@ -158,7 +158,10 @@ iree_task_t* iree_task_worker_try_steal_task(iree_task_worker_t* worker,
 
   // If we still didn't steal any tasks then let's try the slist instead.
   task = iree_atomic_task_slist_pop(&worker->mailbox_slist);
-  if (task) return task;
+  if (task) {
+    task->flags |= IREE_TASK_FLAG_STOLEN;
+    return task;
+  }
 
   return NULL;
 }
@@ -211,24 +214,21 @@ static bool iree_task_worker_pump_once(
     iree_task_worker_t* worker, iree_task_submission_t* pending_submission) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Check the local work queue for any work we know we should start
-  // processing immediately. Other workers may try to steal some of this work
+  // Move any incoming work that has been posted to the mailbox into our local
+  // work list and pop off the next task to process. We do this each time
+  // (instead of only when the local list runs dry) so that newly posted tasks
+  // from higher priority scopes can be selected ahead of lower priority tasks
+  // that were already queued. Other workers may try to steal some of this work
   // if we take too long.
-  iree_task_t* task = iree_task_queue_pop_front(&worker->local_task_queue);
-
-  // Check the mailbox to see if we have incoming work that has been posted.
-  // We try to greedily move it to our local work list so that we can work
-  // with the full thread-local pending task list.
-  if (!task) {
-    // NOTE: there's a potential for theft pessimization if the queue runs too
-    // low and there's nothing there when a thief goes to grab some tasks. A
-    // standout there would indicate that we weren't scheduling very well in the
-    // first place (large uneven workloads for various workers, bad distribution
-    // in the face of heterogenous multi-core architectures where some workers
-    // complete tasks faster than others, etc).
-    task = iree_task_queue_flush_from_lifo_slist(&worker->local_task_queue,
-                                                 &worker->mailbox_slist);
-  }
+  //
+  // NOTE: there's a potential for theft pessimization if the queue runs too
+  // low and there's nothing there when a thief goes to grab some tasks. A
+  // standout there would indicate that we weren't scheduling very well in the
+  // first place (large uneven workloads for various workers, bad distribution
+  // in the face of heterogenous multi-core architectures where some workers
+  // complete tasks faster than others, etc).
+  iree_task_t* task = iree_task_queue_flush_from_lifo_slist(
+      &worker->local_task_queue, &worker->mailbox_slist);
 
   // If we ran out of work assigned to this specific worker try to steal some
   // from other workers that we hopefully share some of the cache hierarchy
@@ -237,8 +237,8 @@ static bool iree_task_worker_pump_once(
   if (!task) {
     task = iree_task_executor_try_steal_task(
         worker->executor, worker->constructive_sharing_mask,
-        worker->max_theft_attempts, &worker->theft_prng,
-        &worker->local_task_queue);
+        worker->work_stealing_mask, worker->max_theft_attempts,
+        &worker->theft_prng, &worker->local_task_queue);
   }
 
   // No tasks to run; let the caller know we want to wait for more.
@@ -278,8 +278,8 @@ static void iree_task_worker_pump_until_exit(iree_task_worker_t* worker) {
     // checked a particular source we use an interruptable wait token that
     // will prevent the wait from happening if anyone touches the data
     // structures we use.
-    iree_wait_token_t wait_token =
-        iree_notification_prepare_wait(&worker->wake_notification);
+    iree_wait_token_t wait_token = iree_notification_set_prepare_wait(
+        &worker->executor->worker_wake_notifications, worker->worker_index);
     iree_atomic_task_affinity_set_fetch_and(&worker->executor->worker_idle_mask,
                                             ~worker->worker_bit,
                                             iree_memory_order_seq_cst);
@@ -288,7 +288,8 @@ static void iree_task_worker_pump_until_exit(iree_task_worker_t* worker) {
     if (iree_atomic_load_int32(&worker->state, iree_memory_order_seq_cst) ==
         IREE_TASK_WORKER_STATE_EXITING) {
       // Thread exit requested - cancel pumping.
-      iree_notification_cancel_wait(&worker->wake_notification);
+      iree_notification_set_cancel_wait(
+          &worker->executor->worker_wake_notifications, worker->worker_index);
       // TODO(benvanik): complete tasks before exiting?
       break;
     }
@@ -331,11 +332,14 @@ static void iree_task_worker_pump_until_exit(iree_task_worker_t* worker) {
     if (schedule_dirty ||
         !iree_task_queue_is_empty(&worker->local_task_queue)) {
       // Have more work to do; loop around to try another pump.
-      iree_notification_cancel_wait(&worker->wake_notification);
+      iree_notification_set_cancel_wait(
+          &worker->executor->worker_wake_notifications, worker->worker_index);
     } else {
       IREE_TRACE_ZONE_BEGIN_NAMED(z_wait,
                                   "iree_task_worker_main_pump_wake_wait");
-      iree_notification_commit_wait(&worker->wake_notification, wait_token);
+      iree_notification_set_commit_wait(
+          &worker->executor->worker_wake_notifications, worker->worker_index,
+          wait_token);
       IREE_TRACE_ZONE_END(z_wait);
     }
 
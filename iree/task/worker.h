@@ -70,15 +70,13 @@ typedef struct iree_task_worker_s {
   iree_atomic_task_slist_t mailbox_slist;
 
   // Current state of the worker (iree_task_worker_state_t).
-  // LAYOUT: frequent access; next to wake_notification as they are always
-  //         accessed together.
+  // LAYOUT: frequent access.
   iree_atomic_int32_t state;
 
-  // Notification signaled when the worker should wake (if it is idle).
-  // LAYOUT: next to state for similar access patterns; when posting other
-  //         threads will touch mailbox_slist and then send a wake
-  //         notification.
-  iree_notification_t wake_notification;
+  // Index of the worker in the executor. Used as the member of the executor
+  // worker_wake_notifications set signaled when the worker should wake (if it
+  // is idle).
+  iree_host_size_t worker_index;
 
   // Notification signaled when the worker changes any state.
   iree_notification_t state_notification;
@@ -100,6 +98,10 @@ typedef struct iree_task_worker_s {
   // all share the same L3 cache.
   iree_task_affinity_set_t constructive_sharing_mask;
 
+  // A bitmask of other group indices this worker may steal tasks from. Usually
+  // limited to the workers on the same NUMA node.
+  iree_task_affinity_set_t work_stealing_mask;
+
   // Maximum number of attempts to make when trying to steal tasks from other
   // workers. This could be 64 (try stealing from all workers) or just a handful
   // (try stealing from these 3 other cores that share your L3 cache).
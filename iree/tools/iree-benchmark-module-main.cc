@@ -17,11 +17,11 @@
 #include "absl/flags/usage.h"
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
-#include "iree/base/internal/file_io.h"
 #include "iree/base/internal/flags.h"
 #include "iree/base/status.h"
 #include "iree/base/tracing.h"
 #include "iree/hal/drivers/init.h"
+#include "iree/hal/local/task_device.h"
 #include "iree/modules/hal/hal_module.h"
 #include "iree/tools/utils/vm_util.h"
 #include "iree/vm/api.h"
@@ -64,15 +64,52 @@ ABSL_FLAG(std::string, function_inputs_file, "",
 namespace iree {
 namespace {
 
+// Reports the dispatch statistics gathered on |device| while running the
+// benchmark as per-invocation counters. Devices that don't track statistics are
+// ignored.
+static void ReportDispatchStatistics(iree_hal_device_t* device,
+                                     benchmark::State& state) {
+  if (!device || !iree_hal_task_device_isa(device)) return;
+  iree_task_dispatch_statistics_t statistics;
+  IREE_CHECK_OK(
+      iree_hal_task_device_consume_dispatch_statistics(device, &statistics));
+  auto add_counter = [&](const char* name, double value) {
+    state.counters[name] =
+        benchmark::Counter(value, benchmark::Counter::kAvgIterations);
+  };
+  add_counter("tiles", iree_atomic_load_int64(&statistics.tile_count,
+                                              iree_memory_order_relaxed));
+  add_counter("shards", iree_atomic_load_int32(&statistics.shard_count,
+                                               iree_memory_order_relaxed));
+  add_counter("stolen_shards",
+              iree_atomic_load_int32(&statistics.stolen_shard_count,
+                                     iree_memory_order_relaxed));
+  add_counter("worker_wall_ms",
+              iree_atomic_load_int64(&statistics.worker_wall_time_ns,
+                                     iree_memory_order_relaxed) /
+                  1e6);
+  add_counter("worker_cpu_ms",
+              iree_atomic_load_int64(&statistics.worker_cpu_time_ns,
+                                     iree_memory_order_relaxed) /
+                  1e6);
+}
+
 static void BenchmarkFunction(
     const std::string& benchmark_name, int batch_size,
-    iree_vm_context_t* context, iree_vm_function_t function,
-    iree_vm_list_t* inputs,
+    iree_hal_device_t* device, iree_vm_context_t* context,
+    iree_vm_function_t function, iree_vm_list_t* inputs,
     const std::vector<RawSignatureParser::Description>& output_descs,
     benchmark::State& state) {
   IREE_TRACE_SCOPE_DYNAMIC(benchmark_name.c_str());
   IREE_TRACE_FRAME_MARK();
 
+  // Drop any statistics from prior benchmarks or warmup.
+  if (device && iree_hal_task_device_isa(device)) {
+    iree_task_dispatch_statistics_t statistics;
+    IREE_CHECK_OK(
+        iree_hal_task_device_consume_dispatch_statistics(device, &statistics));
+  }
+
   // Benchmarking loop.
   while (state.KeepRunningBatch(batch_size)) {
     IREE_TRACE_SCOPE0("BenchmarkIteration");
@@ -84,20 +121,23 @@ static void BenchmarkFunction(
     IREE_CHECK_OK(iree_vm_invoke(context, function, /*policy=*/nullptr, inputs,
                                  outputs.get(), iree_allocator_system()));
   }
+
+  ReportDispatchStatistics(device, state);
 }
 
 void RegisterModuleBenchmarks(
-    const std::string& function_name, iree_vm_context_t* context,
-    iree_vm_function_t function, iree_vm_list_t* inputs,
+    const std::string& function_name, iree_hal_device_t* device,
+    iree_vm_context_t* context, iree_vm_function_t function,
+    iree_vm_list_t* inputs,
     const std::vector<RawSignatureParser::Description>& output_descs) {
   auto benchmark_name = "BM_" + function_name;
   int batch_size = absl::GetFlag(FLAGS_batch_size);
   benchmark::RegisterBenchmark(
       benchmark_name.c_str(),
-      [benchmark_name, batch_size, context, function, inputs,
+      [benchmark_name, batch_size, device, context, function, inputs,
        output_descs](benchmark::State& state) -> void {
-        BenchmarkFunction(benchmark_name, batch_size, context, function, inputs,
-                          output_descs, state);
+        BenchmarkFunction(benchmark_name, batch_size, device, context, function,
+                          inputs, output_descs, state);
       })
       // By default only the main thread is included in CPU time. Include all
       // the threads instead.
@@ -114,19 +154,6 @@ void RegisterModuleBenchmarks(
       ->Unit(benchmark::kMillisecond);
 }
 
-Status GetModuleContentsFromFlags(std::string* out_contents) {
-  IREE_TRACE_SCOPE0("GetModuleContentsFromFlags");
-  auto module_file = absl::GetFlag(FLAGS_module_file);
-  if (module_file == "-") {
-    *out_contents = std::string{std::istreambuf_iterator<char>(std::cin),
-                                std::istreambuf_iterator<char>()};
-  } else {
-    IREE_RETURN_IF_ERROR(
-        file_io::GetFileContents(module_file.c_str(), out_contents));
-  }
-  return OkStatus();
-}
-
 // TODO(hanchung): Consider to refactor this out and reuse in iree-run-module.
 // This class helps organize required resources for IREE. The order of
 // construction and destruction for resources matters. And the lifetime of
@@ -170,8 +197,6 @@ class IREEBenchmark {
     IREE_TRACE_SCOPE0("IREEBenchmark::Init");
     IREE_TRACE_FRAME_MARK_BEGIN_NAMED("init");
 
-    IREE_RETURN_IF_ERROR(GetModuleContentsFromFlags(&module_data_));
-
     IREE_RETURN_IF_ERROR(iree_hal_module_register_types());
     IREE_RETURN_IF_ERROR(
         iree_vm_instance_create(iree_allocator_system(), &instance_));
@@ -180,7 +205,8 @@ class IREEBenchmark {
     IREE_RETURN_IF_ERROR(
         iree::CreateDevice(absl::GetFlag(FLAGS_driver), &device_));
     IREE_RETURN_IF_ERROR(CreateHalModule(device_, &hal_module_));
-    IREE_RETURN_IF_ERROR(LoadBytecodeModule(module_data_, &input_module_));
+    IREE_RETURN_IF_ERROR(LoadBytecodeModuleFromFile(
+        absl::GetFlag(FLAGS_module_file), &input_module_));
 
     // Order matters. The input module will likely be dependent on the hal
     // module.
@@ -219,8 +245,8 @@ class IREEBenchmark {
     // Creates output signature.
     std::vector<RawSignatureParser::Description> output_descs;
     IREE_RETURN_IF_ERROR(ParseOutputSignature(function, &output_descs));
-    RegisterModuleBenchmarks(function_name, context_, function, inputs_.get(),
-                             output_descs);
+    RegisterModuleBenchmarks(function_name, device_, context_, function,
+                             inputs_.get(), output_descs);
     return iree::OkStatus();
   }
 
@@ -246,13 +272,13 @@ class IREEBenchmark {
       }
       std::vector<RawSignatureParser::Description> output_descs;
       IREE_RETURN_IF_ERROR(ParseOutputSignature(function, &output_descs));
-      iree::RegisterModuleBenchmarks(function_name, context_, function,
-                                     /*inputs=*/nullptr, output_descs);
+      iree::RegisterModuleBenchmarks(function_name, device_, context_,
+                                     function, /*inputs=*/nullptr,
+                                     output_descs);
     }
     return iree::OkStatus();
   }
 
-  std::string module_data_;
   iree_vm_instance_t* instance_ = nullptr;
   iree_hal_device_t* device_ = nullptr;
   iree_vm_module_t* hal_module_ = nullptr;
@@ -18,7 +18,6 @@
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 #include "iree/base/api.h"
-#include "iree/base/internal/file_io.h"
 #include "iree/base/internal/flags.h"
 #include "iree/base/status.h"
 #include "iree/base/target_platform.h"
@@ -91,17 +90,9 @@ Status Run(std::string module_file_path, int* out_exit_code) {
       iree_vm_instance_create(iree_allocator_system(), &instance),
       "creating instance");
 
-  std::string module_data;
-  if (module_file_path == "-") {
-    module_data = std::string{std::istreambuf_iterator<char>(std::cin),
-                              std::istreambuf_iterator<char>()};
-  } else {
-    IREE_RETURN_IF_ERROR(
-        file_io::GetFileContents(module_file_path.c_str(), &module_data));
-  }
-
   iree_vm_module_t* input_module = nullptr;
-  IREE_RETURN_IF_ERROR(LoadBytecodeModule(module_data, &input_module));
+  IREE_RETURN_IF_ERROR(
+      LoadBytecodeModuleFromFile(module_file_path, &input_module));
 
   iree_hal_device_t* device = nullptr;
   IREE_RETURN_IF_ERROR(CreateDevice(absl::GetFlag(FLAGS_driver), &device));
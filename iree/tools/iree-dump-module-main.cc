@@ -16,7 +16,7 @@
 #include <string>
 #include <utility>
 
-#include "iree/base/internal/file_io.h"
+#include "iree/base/internal/file_mapping.h"
 #include "iree/base/status.h"
 #include "iree/schemas/bytecode_module_def_json_printer.h"
 
@@ -31,17 +31,21 @@ extern "C" int main(int argc, char** argv) {
     std::cerr << "Syntax: iree-dump-module module.vmfb > module.json\n";
     return 1;
   }
-  std::string module_contents;
-  IREE_CHECK_OK(iree::file_io::GetFileContents(argv[1], &module_contents));
+  iree_file_mapping_t* mapping = nullptr;
+  IREE_CHECK_OK(
+      iree_file_mapping_open_read(argv[1], iree_allocator_system(), &mapping));
+  iree_const_byte_span_t module_contents = iree_file_mapping_contents(mapping);
 
   // Print direct to stdout.
   flatcc_json_printer_t printer;
   flatcc_json_printer_init(&printer, /*fp=*/nullptr);
   flatcc_json_printer_set_skip_default(&printer, true);
   bytecode_module_def_print_json(
-      &printer, reinterpret_cast<const char*>(module_contents.data()),
-      module_contents.size());
+      &printer, reinterpret_cast<const char*>(module_contents.data),
+      module_contents.data_length);
   flatcc_json_printer_clear(&printer);
 
+  iree_file_mapping_release(mapping);
+
   return 0;
 }
@@ -14,6 +14,7 @@
 
 #include "iree/tools/utils/vm_util.h"
 
+#include <iterator>
 #include <ostream>
 
 #include "absl/strings/numbers.h"
@@ -22,6 +23,7 @@
 #include "absl/strings/strip.h"
 #include "absl/types/span.h"
 #include "iree/base/internal/file_io.h"
+#include "iree/base/internal/file_mapping.h"
 #include "iree/base/signature_parser.h"
 #include "iree/base/status.h"
 #include "iree/hal/api.h"
@@ -290,4 +292,39 @@ Status LoadBytecodeModule(absl::string_view module_data,
       "deserializing module");
   return OkStatus();
 }
+
+Status LoadBytecodeModuleFromFile(const std::string& module_file,
+                                  iree_vm_module_t** out_module) {
+  if (module_file == "-") {
+    // stdin can't be mapped so we read it into memory owned by the module.
+    std::string module_data{std::istreambuf_iterator<char>(std::cin),
+                            std::istreambuf_iterator<char>()};
+    void* module_copy = nullptr;
+    IREE_RETURN_IF_ERROR(iree_allocator_clone(
+        iree_allocator_system(),
+        iree_make_const_byte_span(module_data.data(), module_data.size()),
+        &module_copy));
+    iree_status_t status = iree_vm_bytecode_module_create(
+        iree_make_const_byte_span(module_copy, module_data.size()),
+        iree_allocator_system(), iree_allocator_system(), out_module);
+    if (!iree_status_is_ok(status)) {
+      iree_allocator_free(iree_allocator_system(), module_copy);
+    }
+    IREE_RETURN_IF_ERROR(status, "deserializing module");
+    return OkStatus();
+  }
+
+  iree_file_mapping_t* mapping = nullptr;
+  IREE_RETURN_IF_ERROR(iree_file_mapping_open_read(
+      module_file.c_str(), iree_allocator_system(), &mapping));
+  iree_status_t status = iree_vm_bytecode_module_create(
+      iree_file_mapping_contents(mapping),
+      iree_file_mapping_deallocator(mapping), iree_allocator_system(),
+      out_module);
+  if (!iree_status_is_ok(status)) {
+    iree_file_mapping_release(mapping);
+  }
+  IREE_RETURN_IF_ERROR(status, "deserializing module");
+  return OkStatus();
+}
 }  // namespace iree
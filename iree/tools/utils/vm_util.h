@@ -97,6 +97,14 @@ Status CreateHalModule(iree_hal_device_t* device,
 Status LoadBytecodeModule(absl::string_view module_data,
                           iree_vm_module_t** out_module);
 
+// Loads a VM bytecode module from the file at |module_file|. The file is
+// memory mapped such that its contents are paged in on demand and shared with
+// other processes mapping the same file. If |module_file| is "-" the module is
+// instead read from stdin.
+// The returned |out_module| must be released by the caller.
+Status LoadBytecodeModuleFromFile(const std::string& module_file,
+                                  iree_vm_module_t** out_module);
+
 }  // namespace iree
 
 #endif  // IREE_TOOLS_UTILS_VM_UTIL_H_
@@ -31,21 +31,26 @@
 // This assumes that the remapping list is properly ordered such that there are
 // no swapping hazards (such as 0->1,1->0). The register allocator in the
 // compiler should ensure this is the case when it can occur.
+//
+// The compiler partitions the list such that all i32 pairs precede all ref
+// pairs (the banks are disjoint so this cannot introduce hazards). This lets
+// us run two tight loops instead of branching on the type of each pair.
 static void iree_vm_bytecode_dispatch_remap_branch_registers(
     const iree_vm_registers_t regs,
     const iree_vm_register_remap_list_t* IREE_RESTRICT remap_list) {
-  for (int i = 0; i < remap_list->size; ++i) {
-    // TODO(benvanik): change encoding to avoid this branching.
-    // Could write two arrays: one for prims and one for refs.
+  int i = 0;
+  for (; i < remap_list->size; ++i) {
     uint16_t src_reg = remap_list->pairs[i].src_reg;
+    if (src_reg & IREE_REF_REGISTER_TYPE_BIT) break;
     uint16_t dst_reg = remap_list->pairs[i].dst_reg;
-    if (src_reg & IREE_REF_REGISTER_TYPE_BIT) {
-      iree_vm_ref_retain_or_move(src_reg & IREE_REF_REGISTER_MOVE_BIT,
-                                 &regs.ref[src_reg & regs.ref_mask],
-                                 &regs.ref[dst_reg & regs.ref_mask]);
-    } else {
-      regs.i32[dst_reg & regs.i32_mask] = regs.i32[src_reg & regs.i32_mask];
-    }
+    regs.i32[dst_reg & regs.i32_mask] = regs.i32[src_reg & regs.i32_mask];
+  }
+  for (; i < remap_list->size; ++i) {
+    uint16_t src_reg = remap_list->pairs[i].src_reg;
+    uint16_t dst_reg = remap_list->pairs[i].dst_reg;
+    iree_vm_ref_retain_or_move(src_reg & IREE_REF_REGISTER_MOVE_BIT,
+                               &regs.ref[src_reg & regs.ref_mask],
+                               &regs.ref[dst_reg & regs.ref_mask]);
   }
 }
 
@@ -97,9 +102,17 @@ static iree_vm_registers_t iree_vm_bytecode_get_register_storage(
 // Releases any remaining refs held in the frame storage.
 static void IREE_API_CALL
 iree_vm_bytecode_stack_frame_cleanup(iree_vm_stack_frame_t* frame) {
+  // The compiler marks functions that discard or move out all of their refs
+  // prior to returning; only failures can leave refs behind in those.
+  const iree_vm_bytecode_frame_storage_t* stack_storage =
+      (iree_vm_bytecode_frame_storage_t*)iree_vm_stack_frame_storage(frame);
+  if (stack_storage->has_returned &&
+      (stack_storage->function_flags &
+       iree_vm_FunctionFlags_NoLiveRefsAtReturn)) {
+    return;
+  }
+
   iree_vm_registers_t regs = iree_vm_bytecode_get_register_storage(frame);
-  // TODO(benvanik): allow the VM to elide this when it's known that there are
-  // no more live registers.
   for (uint16_t i = 0; i <= regs.ref_mask; ++i) {
     iree_vm_ref_t* ref = &regs.ref[i];
     if (ref->ptr) iree_vm_ref_release(ref);
@@ -171,6 +184,9 @@ static iree_status_t iree_vm_bytecode_function_enter(
   stack_storage->ref_register_count = ref_register_count;
   stack_storage->i32_register_offset = header_size;
   stack_storage->ref_register_offset = header_size + i32_register_size;
+  stack_storage->entry_frame_depth = (*out_callee_frame)->depth;
+  stack_storage->function_flags = target_descriptor->flags;
+  stack_storage->has_returned = false;
   *out_callee_registers =
       iree_vm_bytecode_get_register_storage(*out_callee_frame);
 
@@ -228,6 +244,15 @@ static iree_status_t iree_vm_bytecode_external_enter(
   return iree_ok_status();
 }
 
+// Marks |frame| as having left through a successful vm.return such that the
+// frame cleanup may skip the ref register sweep if the function allows it.
+// Must only be called once all results have been marshaled out of the frame;
+// failures prior to this leave the flag unset and the sweep releases any refs.
+static void iree_vm_bytecode_mark_frame_returned(iree_vm_stack_frame_t* frame) {
+  ((iree_vm_bytecode_frame_storage_t*)iree_vm_stack_frame_storage(frame))
+      ->has_returned = true;
+}
+
 // Leaves an internal bytecode stack frame and returns to an external caller.
 // Registers will be marshaled from the |src_reg_list| to the |results| buffer.
 //
@@ -266,6 +291,10 @@ static iree_status_t iree_vm_bytecode_external_leave(
     }
   }
 
+  // Only now that all results have been marshaled can the frame cleanup trust
+  // the compiler-provided function flags.
+  iree_vm_bytecode_mark_frame_returned(callee_frame);
+
   // Leave and deallocate bytecode stack frame.
   return iree_vm_stack_function_leave(stack);
 }
@@ -284,6 +313,7 @@ static iree_status_t iree_vm_bytecode_internal_enter(
       (iree_vm_bytecode_frame_storage_t*)iree_vm_stack_frame_storage(
           iree_vm_stack_current_frame(stack));
   caller_storage->return_registers = dst_reg_list;
+  int32_t entry_frame_depth = caller_storage->entry_frame_depth;
 
   // NOTE: after this call the caller registers may be invalid and need to be
   // requeried.
@@ -293,33 +323,38 @@ static iree_status_t iree_vm_bytecode_internal_enter(
   function.ordinal = function_ordinal;
   IREE_RETURN_IF_ERROR(iree_vm_bytecode_function_enter(
       stack, function, out_callee_frame, out_callee_registers));
+  ((iree_vm_bytecode_frame_storage_t*)iree_vm_stack_frame_storage(
+       *out_callee_frame))
+      ->entry_frame_depth = entry_frame_depth;
 
   // Remaps argument/result registers from a source list in the caller/callee
   // frame to the 0-N ABI registers in the callee/caller frame.
   // This assumes that the destination stack frame registers are unused and ok
   // to overwrite directly. Each bank begins left-aligned at 0 and increments
   // per arg of its type.
+  //
+  // The compiler partitions internal call operand lists such that all i32
+  // registers precede all ref registers. As each bank is assigned in order the
+  // partitioning does not change the callee ABI and the i32 prefix can be
+  // copied without checking the type of each register.
   iree_vm_registers_t src_regs =
       iree_vm_bytecode_get_register_storage(iree_vm_stack_parent_frame(stack));
   iree_vm_registers_t* dst_regs = out_callee_registers;
-  int i32_reg_offset = 0;
-  int ref_reg_offset = 0;
-  for (int i = 0; i < src_reg_list->size; ++i) {
-    // TODO(benvanik): change encoding to avoid this branching.
-    // Could write two arrays: one for prims and one for refs.
+  int i = 0;
+  for (; i < src_reg_list->size; ++i) {
     uint16_t src_reg = src_reg_list->registers[i];
-    if (src_reg & IREE_REF_REGISTER_TYPE_BIT) {
-      uint16_t dst_reg = ref_reg_offset++;
-      memset(&dst_regs->ref[dst_reg & dst_regs->ref_mask], 0,
-             sizeof(iree_vm_ref_t));
-      iree_vm_ref_retain_or_move(src_reg & IREE_REF_REGISTER_MOVE_BIT,
-                                 &src_regs.ref[src_reg & src_regs.ref_mask],
-                                 &dst_regs->ref[dst_reg & dst_regs->ref_mask]);
-    } else {
-      uint16_t dst_reg = i32_reg_offset++;
-      dst_regs->i32[dst_reg & dst_regs->i32_mask] =
-          src_regs.i32[src_reg & src_regs.i32_mask];
-    }
+    if (src_reg & IREE_REF_REGISTER_TYPE_BIT) break;
+    dst_regs->i32[i & dst_regs->i32_mask] =
+        src_regs.i32[src_reg & src_regs.i32_mask];
+  }
+  for (int ref_reg_base = i; i < src_reg_list->size; ++i) {
+    uint16_t src_reg = src_reg_list->registers[i];
+    uint16_t dst_reg = (uint16_t)(i - ref_reg_base);
+    memset(&dst_regs->ref[dst_reg & dst_regs->ref_mask], 0,
+           sizeof(iree_vm_ref_t));
+    iree_vm_ref_retain_or_move(src_reg & IREE_REF_REGISTER_MOVE_BIT,
+                               &src_regs.ref[src_reg & src_regs.ref_mask],
+                               &dst_regs->ref[dst_reg & dst_regs->ref_mask]);
   }
 
   return iree_ok_status();
@@ -369,10 +404,35 @@ static iree_status_t iree_vm_bytecode_internal_leave(
   }
 
   // Leave and deallocate bytecode stack frame.
+  iree_vm_bytecode_mark_frame_returned(callee_frame);
   *out_caller_registers = caller_registers;
   return iree_vm_stack_function_leave(stack);
 }
 
+// Populates import call arguments for signatures classified at resolve time as
+// refs followed by i32s. |storage| need not be initialized.
+static void iree_vm_bytecode_populate_import_direct_arguments(
+    const iree_vm_bytecode_import_t* import,
+    const iree_vm_registers_t caller_registers,
+    const iree_vm_register_list_t* IREE_RESTRICT src_reg_list,
+    iree_byte_span_t storage) {
+  const uint16_t* IREE_RESTRICT src_regs = src_reg_list->registers;
+  // Refs are borrowed by the callee for the duration of the call and are not
+  // retained.
+  iree_vm_ref_t* IREE_RESTRICT ref_args = (iree_vm_ref_t*)storage.data;
+  for (uint8_t i = 0; i < import->argument_ref_count; ++i) {
+    ref_args[i] = caller_registers.ref[src_regs[i] & caller_registers.ref_mask];
+  }
+  src_regs += import->argument_ref_count;
+  uint8_t* IREE_RESTRICT i32_args =
+      (uint8_t*)&ref_args[import->argument_ref_count];
+  for (uint8_t i = 0; i < import->argument_i32_count; ++i) {
+    memcpy(i32_args + i * sizeof(int32_t),
+           &caller_registers.i32[src_regs[i] & caller_registers.i32_mask],
+           sizeof(int32_t));
+  }
+}
+
 // Populates an import call arguments
 static void iree_vm_bytecode_populate_import_cconv_arguments(
     iree_string_view_t cconv_arguments,
@@ -461,30 +521,63 @@ static void iree_vm_bytecode_populate_import_cconv_arguments(
 
 // Issues a populated import call and marshals the results into |dst_reg_list|.
 static iree_status_t iree_vm_bytecode_issue_import_call(
-    iree_vm_stack_t* stack, const iree_vm_function_call_t call,
-    iree_string_view_t cconv_results,
+    iree_vm_stack_t* stack, const iree_vm_bytecode_import_t* import,
+    const iree_vm_function_call_t call,
     const iree_vm_register_list_t* IREE_RESTRICT dst_reg_list,
     iree_vm_stack_frame_t** out_caller_frame,
     iree_vm_registers_t* out_caller_registers,
     iree_vm_execution_result_t* out_result) {
-  // Call external function.
-  iree_status_t call_status = call.function.module->begin_call(
-      call.function.module->self, stack, &call, out_result);
+  // Call external function. Native functions resolved to their shims are
+  // called directly.
+  iree_status_t call_status =
+      import->native_function.shim
+          ? iree_vm_native_module_call_direct(import->native_function, stack,
+                                              &call, out_result)
+          : call.function.module->begin_call(call.function.module->self,
+                                             stack, &call, out_result);
   if (IREE_UNLIKELY(!iree_status_is_ok(call_status))) {
     // TODO(benvanik): set execution result to failure/capture stack.
     return iree_status_annotate(call_status,
                                 iree_make_cstring_view("while calling import"));
   }
 
-  // NOTE: we don't support yielding within imported functions right now so it's
-  // safe to assume the stack is still valid here. If the called function can
-  // yield then we'll need to requery all pointers here.
+  // NOTE: the stack may have grown during the call so all pointers must be
+  // requeried.
   *out_caller_frame = iree_vm_stack_current_frame(stack);
   *out_caller_registers =
       iree_vm_bytecode_get_register_storage(*out_caller_frame);
 
+  // Imports that yield produce no results and will be called again when the
+  // caller resumes.
+  if (IREE_UNLIKELY(out_result->flags &
+                    IREE_VM_EXECUTION_RESULT_FLAG_YIELDED)) {
+    return iree_ok_status();
+  }
+
   // Marshal outputs from the ABI results buffer to registers.
   iree_vm_registers_t caller_registers = *out_caller_registers;
+  if (IREE_LIKELY(import->result_ref_count !=
+                  IREE_VM_BYTECODE_IMPORT_CCONV_GENERIC) &&
+      IREE_LIKELY(dst_reg_list->size ==
+                  import->result_ref_count + import->result_i32_count)) {
+    const uint16_t* IREE_RESTRICT dst_regs = dst_reg_list->registers;
+    iree_vm_ref_t* IREE_RESTRICT ref_results =
+        (iree_vm_ref_t*)call.results.data;
+    for (uint8_t i = 0; i < import->result_ref_count; ++i) {
+      iree_vm_ref_move(
+          &ref_results[i],
+          &caller_registers.ref[dst_regs[i] & caller_registers.ref_mask]);
+    }
+    dst_regs += import->result_ref_count;
+    const uint8_t* IREE_RESTRICT i32_results =
+        (const uint8_t*)&ref_results[import->result_ref_count];
+    for (uint8_t i = 0; i < import->result_i32_count; ++i) {
+      memcpy(&caller_registers.i32[dst_regs[i] & caller_registers.i32_mask],
+             i32_results + i * sizeof(int32_t), sizeof(int32_t));
+    }
+    return iree_ok_status();
+  }
+  iree_string_view_t cconv_results = import->results;
   uint8_t* IREE_RESTRICT p = call.results.data;
   for (iree_host_size_t i = 0; i < cconv_results.size && i < dst_reg_list->size;
        ++i) {
@@ -542,17 +635,23 @@ static iree_status_t iree_vm_bytecode_call_import(
   // Marshal inputs from registers to the ABI arguments buffer.
   call.arguments.data_length = import->argument_buffer_size;
   call.arguments.data = iree_alloca(call.arguments.data_length);
-  memset(call.arguments.data, 0, call.arguments.data_length);
-  iree_vm_bytecode_populate_import_cconv_arguments(
-      import->arguments, caller_registers,
-      /*segment_size_list=*/NULL, src_reg_list, call.arguments);
+  if (IREE_LIKELY(import->argument_ref_count !=
+                  IREE_VM_BYTECODE_IMPORT_CCONV_GENERIC)) {
+    iree_vm_bytecode_populate_import_direct_arguments(
+        import, caller_registers, src_reg_list, call.arguments);
+  } else {
+    memset(call.arguments.data, 0, call.arguments.data_length);
+    iree_vm_bytecode_populate_import_cconv_arguments(
+        import->arguments, caller_registers,
+        /*segment_size_list=*/NULL, src_reg_list, call.arguments);
+  }
 
   // Issue the call and handle results.
   call.results.data_length = import->result_buffer_size;
   call.results.data = iree_alloca(call.results.data_length);
   memset(call.results.data, 0, call.results.data_length);
-  return iree_vm_bytecode_issue_import_call(stack, call, import->results,
-                                            dst_reg_list, out_caller_frame,
+  return iree_vm_bytecode_issue_import_call(stack, import, call, dst_reg_list,
+                                            out_caller_frame,
                                             out_caller_registers, out_result);
 }
 
@@ -597,8 +696,8 @@ static iree_status_t iree_vm_bytecode_call_import_variadic(
   call.results.data_length = import->result_buffer_size;
   call.results.data = iree_alloca(call.results.data_length);
   memset(call.results.data, 0, call.results.data_length);
-  return iree_vm_bytecode_issue_import_call(stack, call, import->results,
-                                            dst_reg_list, out_caller_frame,
+  return iree_vm_bytecode_issue_import_call(stack, import, call, dst_reg_list,
+                                            out_caller_frame,
                                             out_caller_registers, out_result);
 }
 
@@ -606,25 +705,17 @@ static iree_status_t iree_vm_bytecode_call_import_variadic(
 // Main interpreter dispatch routine
 //===----------------------------------------------------------------------===//
 
-iree_status_t iree_vm_bytecode_dispatch(
+// Executes bytecode starting at the current pc of |current_frame| until either
+// the entry frame returns to the external caller or execution yields.
+static iree_status_t iree_vm_bytecode_execute(
     iree_vm_stack_t* stack, iree_vm_bytecode_module_t* module,
-    const iree_vm_function_call_t* call, iree_string_view_t cconv_arguments,
-    iree_string_view_t cconv_results, iree_vm_execution_result_t* out_result) {
-  memset(out_result, 0, sizeof(*out_result));
-
+    const iree_vm_function_call_t* call, iree_string_view_t cconv_results,
+    iree_vm_stack_frame_t* current_frame, iree_vm_registers_t regs,
+    iree_vm_execution_result_t* out_result) {
   // When required emit the dispatch tables here referencing the labels we are
   // defining below.
   DEFINE_DISPATCH_TABLES();
 
-  // Enter function (as this is the initial call).
-  // The callee's return will take care of storing the output registers when it
-  // actually does return, either immediately or in the future via a resume.
-  iree_vm_stack_frame_t* current_frame = NULL;
-  iree_vm_registers_t regs;
-  IREE_RETURN_IF_ERROR(
-      iree_vm_bytecode_external_enter(stack, call->function, cconv_arguments,
-                                      call->arguments, &current_frame, &regs));
-
   // Primary dispatch state. This is our 'native stack frame' and really
   // just enough to make dereferencing common addresses (like the current
   // offset) faster. You can think of this like CPU state (like PC).
@@ -639,7 +730,10 @@ iree_status_t iree_vm_bytecode_dispatch(
       module->function_descriptor_table[current_frame->function.ordinal]
           .bytecode_offset;
   iree_vm_source_offset_t pc = current_frame->pc;
-  const int32_t entry_frame_depth = current_frame->depth;
+  const int32_t entry_frame_depth =
+      ((const iree_vm_bytecode_frame_storage_t*)iree_vm_stack_frame_storage(
+           current_frame))
+          ->entry_frame_depth;
 
   BEGIN_DISPATCH_CORE() {
     //===------------------------------------------------------------------===//
@@ -1089,7 +1183,36 @@ iree_status_t iree_vm_bytecode_dispatch(
       }
     });
 
+#define DISPATCH_OP_CORE_COND_BRANCH_CMP_I32(op_name, op_func)          \
+  DISPATCH_OP(CORE, op_name, {                                          \
+    int32_t lhs = VM_DecOperandRegI32("lhs");                           \
+    int32_t rhs = VM_DecOperandRegI32("rhs");                           \
+    int32_t true_block_pc = VM_DecBranchTarget("true_dest");            \
+    const iree_vm_register_remap_list_t* true_remap_list =              \
+        VM_DecBranchOperands("true_operands");                          \
+    int32_t false_block_pc = VM_DecBranchTarget("false_dest");          \
+    const iree_vm_register_remap_list_t* false_remap_list =             \
+        VM_DecBranchOperands("false_operands");                         \
+    const iree_vm_register_remap_list_t* remap_list;                    \
+    if (op_func(lhs, rhs)) {                                            \
+      pc = true_block_pc;                                               \
+      remap_list = true_remap_list;                                     \
+    } else {                                                            \
+      pc = false_block_pc;                                              \
+      remap_list = false_remap_list;                                    \
+    }                                                                   \
+    iree_vm_bytecode_dispatch_remap_branch_registers(regs, remap_list); \
+  });
+
+    // Superinstructions fusing a comparison whose only use is a cond_br.
+    DISPATCH_OP_CORE_COND_BRANCH_CMP_I32(CondBranchCmpEQI32, vm_cmp_eq_i32);
+    DISPATCH_OP_CORE_COND_BRANCH_CMP_I32(CondBranchCmpNEI32, vm_cmp_ne_i32);
+    DISPATCH_OP_CORE_COND_BRANCH_CMP_I32(CondBranchCmpLTI32S, vm_cmp_lt_i32s);
+    DISPATCH_OP_CORE_COND_BRANCH_CMP_I32(CondBranchCmpLTI32U, vm_cmp_lt_i32u);
+
     DISPATCH_OP(CORE, Call, {
+      // Offset of the opcode so the call can be reissued after a yield.
+      const iree_vm_source_offset_t call_pc = pc - 1;
       int32_t function_ordinal = VM_DecFuncAttr("callee");
       const iree_vm_register_list_t* src_reg_list =
           VM_DecVariadicOperands("operands");
@@ -1105,6 +1228,11 @@ iree_status_t iree_vm_bytecode_dispatch(
         IREE_RETURN_IF_ERROR(iree_vm_bytecode_call_import(
             stack, module_state, function_ordinal, regs, src_reg_list,
             dst_reg_list, &current_frame, &regs, out_result));
+        if (IREE_UNLIKELY(out_result->flags &
+                          IREE_VM_EXECUTION_RESULT_FLAG_YIELDED)) {
+          current_frame->pc = call_pc;
+          return iree_ok_status();
+        }
       } else {
         // Switch execution to the target function and continue running in the
         // bytecode dispatcher.
@@ -1121,6 +1249,7 @@ iree_status_t iree_vm_bytecode_dispatch(
     DISPATCH_OP(CORE, CallVariadic, {
       // TODO(benvanik): dedupe with above or merge and always have the seg size
       // list be present (but empty) for non-variadic calls.
+      const iree_vm_source_offset_t call_pc = pc - 1;
       int32_t function_ordinal = VM_DecFuncAttr("callee");
       const iree_vm_register_list_t* segment_size_list =
           VM_DecVariadicOperands("segment_sizes");
@@ -1144,6 +1273,11 @@ iree_status_t iree_vm_bytecode_dispatch(
       IREE_RETURN_IF_ERROR(iree_vm_bytecode_call_import_variadic(
           stack, module_state, function_ordinal, regs, segment_size_list,
           src_reg_list, dst_reg_list, &current_frame, &regs, out_result));
+      if (IREE_UNLIKELY(out_result->flags &
+                        IREE_VM_EXECUTION_RESULT_FLAG_YIELDED)) {
+        current_frame->pc = call_pc;
+        return iree_ok_status();
+      }
     });
 
     DISPATCH_OP(CORE, Return, {
@@ -1170,6 +1304,16 @@ iree_status_t iree_vm_bytecode_dispatch(
       pc = current_frame->pc;
     });
 
+    DISPATCH_OP(CORE, DiscardRefs, {
+      // Releases refs at their last use as determined by the compiler. The
+      // registers may have already been moved out on some paths in which case
+      // they are null and the release is a no-op.
+      const iree_vm_register_list_t* reg_list = VM_DecVariadicOperands("refs");
+      for (uint16_t i = 0; i < reg_list->size; ++i) {
+        iree_vm_ref_release(&regs.ref[reg_list->registers[i] & regs.ref_mask]);
+      }
+    });
+
     DISPATCH_OP(CORE, Fail, {
       uint32_t status_code = VM_DecOperandRegI32("status");
       iree_string_view_t message;
@@ -1185,8 +1329,13 @@ iree_status_t iree_vm_bytecode_dispatch(
     //===------------------------------------------------------------------===//
 
     DISPATCH_OP(CORE, Yield, {
-      // TODO(benvanik): yield with execution results.
-      return iree_ok_status();
+      // Voluntary yields can be resumed immediately and are ignored when the
+      // caller cannot handle them.
+      if (iree_vm_stack_is_yield_enabled(stack)) {
+        current_frame->pc = pc;
+        out_result->flags |= IREE_VM_EXECUTION_RESULT_FLAG_YIELDED;
+        return iree_ok_status();
+      }
     });
 
     //===------------------------------------------------------------------===//
@@ -1454,14 +1603,259 @@ iree_status_t iree_vm_bytecode_dispatch(
     }
     END_DISPATCH_PREFIX();
 
-    DISPATCH_OP(CORE, PrefixExtF32,
-                { return iree_make_status(IREE_STATUS_UNIMPLEMENTED); });
+    BEGIN_DISPATCH_PREFIX(PrefixExtF32, EXT_F32) {
+#if IREE_VM_EXT_F32_ENABLE
+      //===----------------------------------------------------------------===//
+      // ExtF32: Constants
+      //===----------------------------------------------------------------===//
 
-    DISPATCH_OP(CORE, PrefixExtF64,
-                { return iree_make_status(IREE_STATUS_UNIMPLEMENTED); });
+      DISPATCH_OP(EXT_F32, ConstF32, {
+        float value = VM_DecFloatAttr32("value");
+        float* result = VM_DecResultRegF32("result");
+        *result = value;
+      });
+
+      DISPATCH_OP(EXT_F32, ConstF32Zero, {
+        float* result = VM_DecResultRegF32("result");
+        *result = 0;
+      });
+
+      //===----------------------------------------------------------------===//
+      // ExtF32: Conditional assignment
+      //===----------------------------------------------------------------===//
+
+      DISPATCH_OP(EXT_F32, SelectF32, {
+        int32_t condition = VM_DecOperandRegI32("condition");
+        float true_value = VM_DecOperandRegF32("true_value");
+        float false_value = VM_DecOperandRegF32("false_value");
+        float* result = VM_DecResultRegF32("result");
+        *result = vm_select_f32(condition, true_value, false_value);
+      });
+
+      //===----------------------------------------------------------------===//
+      // ExtF32: Native floating-point arithmetic
+      //===----------------------------------------------------------------===//
+
+      DISPATCH_OP_EXT_F32_BINARY_F32(AddF32, vm_add_f32);
+      DISPATCH_OP_EXT_F32_BINARY_F32(SubF32, vm_sub_f32);
+      DISPATCH_OP_EXT_F32_BINARY_F32(MulF32, vm_mul_f32);
+      DISPATCH_OP_EXT_F32_BINARY_F32(DivF32, vm_div_f32);
+      DISPATCH_OP_EXT_F32_BINARY_F32(RemF32, vm_rem_f32);
+      DISPATCH_OP_EXT_F32_UNARY_F32(AbsF32, vm_abs_f32);
+      DISPATCH_OP_EXT_F32_UNARY_F32(NegF32, vm_neg_f32);
+      DISPATCH_OP_EXT_F32_UNARY_F32(CeilF32, vm_ceil_f32);
+      DISPATCH_OP_EXT_F32_UNARY_F32(FloorF32, vm_floor_f32);
+
+      //===----------------------------------------------------------------===//
+      // ExtF32: Casting and type conversion/emulation
+      //===----------------------------------------------------------------===//
+
+      DISPATCH_OP(EXT_F32, CastSI32F32, {
+        int32_t operand = VM_DecOperandRegI32("operand");
+        float* result = VM_DecResultRegF32("result");
+        *result = vm_cast_si32f32(operand);
+      });
+      DISPATCH_OP(EXT_F32, CastUI32F32, {
+        int32_t operand = VM_DecOperandRegI32("operand");
+        float* result = VM_DecResultRegF32("result");
+        *result = vm_cast_ui32f32(operand);
+      });
+      DISPATCH_OP(EXT_F32, CastF32SI32, {
+        float operand = VM_DecOperandRegF32("operand");
+        int32_t* result = VM_DecResultRegI32("result");
+        *result = vm_cast_f32si32(operand);
+      });
+      DISPATCH_OP(EXT_F32, CastF32UI32, {
+        float operand = VM_DecOperandRegF32("operand");
+        int32_t* result = VM_DecResultRegI32("result");
+        *result = vm_cast_f32ui32(operand);
+      });
+
+      //===----------------------------------------------------------------===//
+      // ExtF32: Comparison ops
+      //===----------------------------------------------------------------===//
+
+#define DISPATCH_OP_EXT_F32_CMP_F32(op_name, op_func) \
+  DISPATCH_OP(EXT_F32, op_name, {                     \
+    float lhs = VM_DecOperandRegF32("lhs");           \
+    float rhs = VM_DecOperandRegF32("rhs");           \
+    int32_t* result = VM_DecResultRegI32("result");   \
+    *result = op_func(lhs, rhs);                      \
+  });
+
+      DISPATCH_OP_EXT_F32_CMP_F32(CmpEQF32O, vm_cmp_eq_f32o);
+      DISPATCH_OP_EXT_F32_CMP_F32(CmpNEF32O, vm_cmp_ne_f32o);
+      DISPATCH_OP_EXT_F32_CMP_F32(CmpLTF32O, vm_cmp_lt_f32o);
+      DISPATCH_OP_EXT_F32_CMP_F32(CmpLTEF32O, vm_cmp_lte_f32o);
+      DISPATCH_OP(EXT_F32, CmpNZF32, {
+        float operand = VM_DecOperandRegF32("operand");
+        int32_t* result = VM_DecResultRegI32("result");
+        *result = vm_cmp_nz_f32(operand);
+      });
+#else
+      return iree_make_status(IREE_STATUS_UNIMPLEMENTED);
+#endif  // IREE_VM_EXT_F32_ENABLE
+    }
+    END_DISPATCH_PREFIX();
+
+    BEGIN_DISPATCH_PREFIX(PrefixExtF64, EXT_F64) {
+#if IREE_VM_EXT_F64_ENABLE
+      //===----------------------------------------------------------------===//
+      // ExtF64: Constants
+      //===----------------------------------------------------------------===//
+
+      DISPATCH_OP(EXT_F64, ConstF64, {
+        double value = VM_DecFloatAttr64("value");
+        double* result = VM_DecResultRegF64("result");
+        *result = value;
+      });
+
+      DISPATCH_OP(EXT_F64, ConstF64Zero, {
+        double* result = VM_DecResultRegF64("result");
+        *result = 0;
+      });
+
+      //===----------------------------------------------------------------===//
+      // ExtF64: Conditional assignment
+      //===----------------------------------------------------------------===//
+
+      DISPATCH_OP(EXT_F64, SelectF64, {
+        int32_t condition = VM_DecOperandRegI32("condition");
+        double true_value = VM_DecOperandRegF64("true_value");
+        double false_value = VM_DecOperandRegF64("false_value");
+        double* result = VM_DecResultRegF64("result");
+        *result = vm_select_f64(condition, true_value, false_value);
+      });
+
+      //===----------------------------------------------------------------===//
+      // ExtF64: Native floating-point arithmetic
+      //===----------------------------------------------------------------===//
+
+      DISPATCH_OP_EXT_F64_BINARY_F64(AddF64, vm_add_f64);
+      DISPATCH_OP_EXT_F64_BINARY_F64(SubF64, vm_sub_f64);
+      DISPATCH_OP_EXT_F64_BINARY_F64(MulF64, vm_mul_f64);
+      DISPATCH_OP_EXT_F64_BINARY_F64(DivF64, vm_div_f64);
+      DISPATCH_OP_EXT_F64_BINARY_F64(RemF64, vm_rem_f64);
+      DISPATCH_OP_EXT_F64_UNARY_F64(AbsF64, vm_abs_f64);
+      DISPATCH_OP_EXT_F64_UNARY_F64(NegF64, vm_neg_f64);
+      DISPATCH_OP_EXT_F64_UNARY_F64(CeilF64, vm_ceil_f64);
+      DISPATCH_OP_EXT_F64_UNARY_F64(FloorF64, vm_floor_f64);
+
+      //===----------------------------------------------------------------===//
+      // ExtF64: Casting and type conversion/emulation
+      //===----------------------------------------------------------------===//
+
+      DISPATCH_OP(EXT_F64, CastSI32F64, {
+        int32_t operand = VM_DecOperandRegI32("operand");
+        double* result = VM_DecResultRegF64("result");
+        *result = vm_cast_si32f64(operand);
+      });
+      DISPATCH_OP(EXT_F64, CastUI32F64, {
+        int32_t operand = VM_DecOperandRegI32("operand");
+        double* result = VM_DecResultRegF64("result");
+        *result = vm_cast_ui32f64(operand);
+      });
+      DISPATCH_OP(EXT_F64, CastF64SI32, {
+        double operand = VM_DecOperandRegF64("operand");
+        int32_t* result = VM_DecResultRegI32("result");
+        *result = vm_cast_f64si32(operand);
+      });
+      DISPATCH_OP(EXT_F64, CastF64UI32, {
+        double operand = VM_DecOperandRegF64("operand");
+        int32_t* result = VM_DecResultRegI32("result");
+        *result = vm_cast_f64ui32(operand);
+      });
+      DISPATCH_OP(EXT_F64, TruncF64F32, {
+        double operand = VM_DecOperandRegF64("operand");
+        float* result = VM_DecResultRegF32("result");
+        *result = vm_trunc_f64f32(operand);
+      });
+      DISPATCH_OP(EXT_F64, ExtF32F64, {
+        float operand = VM_DecOperandRegF32("operand");
+        double* result = VM_DecResultRegF64("result");
+        *result = vm_ext_f32f64(operand);
+      });
+
+      //===----------------------------------------------------------------===//
+      // ExtF64: Comparison ops
+      //===----------------------------------------------------------------===//
+
+#define DISPATCH_OP_EXT_F64_CMP_F64(op_name, op_func) \
+  DISPATCH_OP(EXT_F64, op_name, {                     \
+    double lhs = VM_DecOperandRegF64("lhs");          \
+    double rhs = VM_DecOperandRegF64("rhs");          \
+    int32_t* result = VM_DecResultRegI32("result");   \
+    *result = op_func(lhs, rhs);                      \
+  });
+
+      DISPATCH_OP_EXT_F64_CMP_F64(CmpEQF64O, vm_cmp_eq_f64o);
+      DISPATCH_OP_EXT_F64_CMP_F64(CmpNEF64O, vm_cmp_ne_f64o);
+      DISPATCH_OP_EXT_F64_CMP_F64(CmpLTF64O, vm_cmp_lt_f64o);
+      DISPATCH_OP_EXT_F64_CMP_F64(CmpLTEF64O, vm_cmp_lte_f64o);
+      DISPATCH_OP(EXT_F64, CmpNZF64, {
+        double operand = VM_DecOperandRegF64("operand");
+        int32_t* result = VM_DecResultRegI32("result");
+        *result = vm_cmp_nz_f64(operand);
+      });
+#else
+      return iree_make_status(IREE_STATUS_UNIMPLEMENTED);
+#endif  // IREE_VM_EXT_F64_ENABLE
+    }
+    END_DISPATCH_PREFIX();
 
     // NOLINTNEXTLINE(misc-static-assert)
     DISPATCH_UNHANDLED_CORE();
   }
   END_DISPATCH_CORE();
 }
+
+iree_status_t iree_vm_bytecode_dispatch(
+    iree_vm_stack_t* stack, iree_vm_bytecode_module_t* module,
+    const iree_vm_function_call_t* call, iree_string_view_t cconv_arguments,
+    iree_string_view_t cconv_results, iree_vm_execution_result_t* out_result) {
+  memset(out_result, 0, sizeof(*out_result));
+
+  // Calls made while other frames are on the stack (imports from another
+  // module or native code calling back into the VM) cannot be resumed as the
+  // caller has no way to suspend itself, so they must run to completion.
+  bool suspend_yields = iree_vm_stack_current_frame(stack) != NULL &&
+                        iree_vm_stack_is_yield_enabled(stack);
+  if (suspend_yields) iree_vm_stack_set_yield_enabled(stack, false);
+
+  // Enter function (as this is the initial call).
+  // The callee's return will take care of storing the output registers when it
+  // actually does return, either immediately or in the future via a resume.
+  iree_vm_stack_frame_t* current_frame = NULL;
+  iree_vm_registers_t regs;
+  iree_status_t status =
+      iree_vm_bytecode_external_enter(stack, call->function, cconv_arguments,
+                                      call->arguments, &current_frame, &regs);
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_bytecode_execute(stack, module, call, cconv_results,
+                                      current_frame, regs, out_result);
+  }
+
+  if (suspend_yields) iree_vm_stack_set_yield_enabled(stack, true);
+  return status;
+}
+
+iree_status_t iree_vm_bytecode_dispatch_resume(
+    iree_vm_stack_t* stack, iree_vm_bytecode_module_t* module,
+    const iree_vm_function_call_t* call, iree_string_view_t cconv_results,
+    iree_vm_execution_result_t* out_result) {
+  memset(out_result, 0, sizeof(*out_result));
+
+  // Execution continues in whichever frame yielded; its pc points at the
+  // yielding instruction (or the one after it for vm.yield).
+  iree_vm_stack_frame_t* current_frame = iree_vm_stack_current_frame(stack);
+  if (IREE_UNLIKELY(!current_frame) ||
+      IREE_UNLIKELY(current_frame->function.module->self != module)) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "stack has no yielded call from this module");
+  }
+  iree_vm_registers_t regs =
+      iree_vm_bytecode_get_register_storage(current_frame);
+
+  return iree_vm_bytecode_execute(stack, module, call, cconv_results,
+                                  current_frame, regs, out_result);
+}
@@ -0,0 +1,161 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-opcode-class dispatch benchmarks for the bytecode interpreter.
+//
+// Each benchmark runs a loop with 16 ops of a single class per iteration and
+// reports the time per op (items are ops, not invocations). BM_LoopEmpty
+// reports the time per iteration of the loop overhead included in all others.
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/vm/api.h"
+#include "iree/vm/bytecode_dispatch_benchmark_module.h"
+#include "iree/vm/bytecode_module.h"
+
+namespace {
+
+// Number of ops of the benchmarked class in each loop iteration.
+static constexpr int64_t kOpsPerIteration = 16;
+
+// Benchmarks the given exported function running |count| loop iterations with
+// |ops_per_iteration| ops each.
+static iree_status_t RunLoop(benchmark::State& state,
+                             absl::string_view function_name, int32_t count,
+                             int64_t ops_per_iteration) {
+  iree_vm_instance_t* instance = NULL;
+  IREE_CHECK_OK(iree_vm_instance_create(iree_allocator_system(), &instance));
+
+  const auto* module_file_toc =
+      iree::vm::bytecode_dispatch_benchmark_module_create();
+  iree_vm_module_t* bytecode_module = nullptr;
+  IREE_CHECK_OK(iree_vm_bytecode_module_create(
+      iree_const_byte_span_t{
+          reinterpret_cast<const uint8_t*>(module_file_toc->data),
+          module_file_toc->size},
+      iree_allocator_null(), iree_allocator_system(), &bytecode_module));
+
+  iree_vm_context_t* context = NULL;
+  IREE_CHECK_OK(iree_vm_context_create_with_modules(
+      instance, &bytecode_module, 1, iree_allocator_system(), &context));
+
+  iree_vm_function_t function;
+  IREE_CHECK_OK(iree_vm_context_resolve_function(
+      context,
+      iree_make_string_view(function_name.data(), function_name.size()),
+      &function));
+
+  iree_vm_function_call_t call;
+  memset(&call, 0, sizeof(call));
+  call.function = function;
+  int32_t argument = 0;
+  int32_t result = 0;
+  call.arguments =
+      iree_make_byte_span(reinterpret_cast<uint8_t*>(&argument),
+                          sizeof(argument));
+  call.results = iree_make_byte_span(reinterpret_cast<uint8_t*>(&result),
+                                     sizeof(result));
+
+  IREE_VM_INLINE_STACK_INITIALIZE(
+      stack, iree_vm_context_state_resolver(context), iree_allocator_system());
+  while (state.KeepRunningBatch(count * ops_per_iteration)) {
+    argument = count;
+    iree_vm_execution_result_t execution_result;
+    IREE_CHECK_OK(bytecode_module->begin_call(bytecode_module->self, stack,
+                                              &call, &execution_result));
+    benchmark::DoNotOptimize(result);
+  }
+  iree_vm_stack_deinitialize(stack);
+
+  iree_vm_module_release(bytecode_module);
+  iree_vm_context_release(context);
+  iree_vm_instance_release(instance);
+
+  return iree_ok_status();
+}
+
+static void BM_LoopEmpty(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.loop_empty",
+                        static_cast<int32_t>(state.range(0)),
+                        /*ops_per_iteration=*/1));
+}
+BENCHMARK(BM_LoopEmpty)->Arg(10000);
+
+static void BM_ArithI32(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.arith_i32",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_ArithI32)->Arg(10000);
+
+static void BM_CmpI32(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.cmp_i32",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_CmpI32)->Arg(10000);
+
+static void BM_SelectI32(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.select_i32",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_SelectI32)->Arg(10000);
+
+static void BM_Branch(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.br",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_Branch)->Arg(10000);
+
+static void BM_BranchSwap(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.br_swap",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_BranchSwap)->Arg(10000);
+
+static void BM_CallInternal(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.call_internal",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_CallInternal)->Arg(10000);
+
+static void BM_CallInternalRef(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.call_internal_ref",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_CallInternalRef)->Arg(10000);
+
+static void BM_ListI32(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.list_i32",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_ListI32)->Arg(10000);
+
+static void BM_GlobalI32(benchmark::State& state) {
+  IREE_CHECK_OK(RunLoop(state, "bytecode_dispatch_benchmark.global_i32",
+                        static_cast<int32_t>(state.range(0)),
+                        kOpsPerIteration));
+}
+BENCHMARK(BM_GlobalI32)->Arg(10000);
+
+}  // namespace
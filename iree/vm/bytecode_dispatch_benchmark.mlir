@@ -0,0 +1,343 @@
+// Dispatch microbenchmarks for the bytecode interpreter.
+//
+// Each exported function runs a loop of %count iterations with 16 ops of a
+// single class in the body such that the per-op cost can be derived by
+// dividing the runtime by 16 * %count. The loop itself adds an add and a
+// fused compare-branch per iteration; @loop_empty measures just that.
+//
+// NOTE: this is compiled without canonicalization so that the op chains are
+// preserved as written.
+vm.module @bytecode_dispatch_benchmark {
+  // Measures the loop overhead shared by all of the benchmarks below.
+  vm.export @loop_empty
+  vm.func @loop_empty(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %acc : i32, i32), ^loop_exit(%acc : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  // i32 arithmetic with a dependency chain through all ops.
+  vm.export @arith_i32
+  vm.func @arith_i32(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    %a0 = vm.add.i32 %acc, %i : i32
+    %a1 = vm.mul.i32 %a0, %i : i32
+    %a2 = vm.xor.i32 %a1, %i : i32
+    %a3 = vm.sub.i32 %a2, %i : i32
+    %a4 = vm.add.i32 %a3, %i : i32
+    %a5 = vm.mul.i32 %a4, %i : i32
+    %a6 = vm.xor.i32 %a5, %i : i32
+    %a7 = vm.sub.i32 %a6, %i : i32
+    %a8 = vm.add.i32 %a7, %i : i32
+    %a9 = vm.mul.i32 %a8, %i : i32
+    %a10 = vm.xor.i32 %a9, %i : i32
+    %a11 = vm.sub.i32 %a10, %i : i32
+    %a12 = vm.add.i32 %a11, %i : i32
+    %a13 = vm.mul.i32 %a12, %i : i32
+    %a14 = vm.xor.i32 %a13, %i : i32
+    %a15 = vm.sub.i32 %a14, %i : i32
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %a15 : i32, i32), ^loop_exit(%a15 : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  // i32 comparisons that are not fused into branches.
+  vm.export @cmp_i32
+  vm.func @cmp_i32(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    %b0 = vm.cmp.eq.i32 %acc, %i : i32
+    %b1 = vm.cmp.ne.i32 %b0, %i : i32
+    %b2 = vm.cmp.lt.i32.s %b1, %i : i32
+    %b3 = vm.cmp.lt.i32.u %b2, %i : i32
+    %b4 = vm.cmp.eq.i32 %b3, %i : i32
+    %b5 = vm.cmp.ne.i32 %b4, %i : i32
+    %b6 = vm.cmp.lt.i32.s %b5, %i : i32
+    %b7 = vm.cmp.lt.i32.u %b6, %i : i32
+    %b8 = vm.cmp.eq.i32 %b7, %i : i32
+    %b9 = vm.cmp.ne.i32 %b8, %i : i32
+    %b10 = vm.cmp.lt.i32.s %b9, %i : i32
+    %b11 = vm.cmp.lt.i32.u %b10, %i : i32
+    %b12 = vm.cmp.eq.i32 %b11, %i : i32
+    %b13 = vm.cmp.ne.i32 %b12, %i : i32
+    %b14 = vm.cmp.lt.i32.s %b13, %i : i32
+    %b15 = vm.cmp.lt.i32.u %b14, %i : i32
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %b15 : i32, i32), ^loop_exit(%b15 : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  // i32 selects.
+  vm.export @select_i32
+  vm.func @select_i32(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    %s0 = vm.select.i32 %acc, %i, %count : i32
+    %s1 = vm.select.i32 %s0, %i, %count : i32
+    %s2 = vm.select.i32 %s1, %i, %count : i32
+    %s3 = vm.select.i32 %s2, %i, %count : i32
+    %s4 = vm.select.i32 %s3, %i, %count : i32
+    %s5 = vm.select.i32 %s4, %i, %count : i32
+    %s6 = vm.select.i32 %s5, %i, %count : i32
+    %s7 = vm.select.i32 %s6, %i, %count : i32
+    %s8 = vm.select.i32 %s7, %i, %count : i32
+    %s9 = vm.select.i32 %s8, %i, %count : i32
+    %s10 = vm.select.i32 %s9, %i, %count : i32
+    %s11 = vm.select.i32 %s10, %i, %count : i32
+    %s12 = vm.select.i32 %s11, %i, %count : i32
+    %s13 = vm.select.i32 %s12, %i, %count : i32
+    %s14 = vm.select.i32 %s13, %i, %count : i32
+    %s15 = vm.select.i32 %s14, %i, %count : i32
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %s15 : i32, i32), ^loop_exit(%s15 : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  // Unconditional branches that do not require register remapping.
+  vm.export @br
+  vm.func @br(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    vm.br ^bb0(%acc : i32)
+  ^bb0(%x0 : i32):
+    vm.br ^bb1(%x0 : i32)
+  ^bb1(%x1 : i32):
+    vm.br ^bb2(%x1 : i32)
+  ^bb2(%x2 : i32):
+    vm.br ^bb3(%x2 : i32)
+  ^bb3(%x3 : i32):
+    vm.br ^bb4(%x3 : i32)
+  ^bb4(%x4 : i32):
+    vm.br ^bb5(%x4 : i32)
+  ^bb5(%x5 : i32):
+    vm.br ^bb6(%x5 : i32)
+  ^bb6(%x6 : i32):
+    vm.br ^bb7(%x6 : i32)
+  ^bb7(%x7 : i32):
+    vm.br ^bb8(%x7 : i32)
+  ^bb8(%x8 : i32):
+    vm.br ^bb9(%x8 : i32)
+  ^bb9(%x9 : i32):
+    vm.br ^bb10(%x9 : i32)
+  ^bb10(%x10 : i32):
+    vm.br ^bb11(%x10 : i32)
+  ^bb11(%x11 : i32):
+    vm.br ^bb12(%x11 : i32)
+  ^bb12(%x12 : i32):
+    vm.br ^bb13(%x12 : i32)
+  ^bb13(%x13 : i32):
+    vm.br ^bb14(%x13 : i32)
+  ^bb14(%x14 : i32):
+    vm.br ^bb15(%x14 : i32)
+  ^bb15(%x15 : i32):
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %x15 : i32, i32), ^loop_exit(%x15 : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  // Unconditional branches that swap two registers and require a scratch
+  // register to remap.
+  vm.export @br_swap
+  vm.func @br_swap(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    vm.br ^bb0(%i, %acc : i32, i32)
+  ^bb0(%x0 : i32, %y0 : i32):
+    vm.br ^bb1(%y0, %x0 : i32, i32)
+  ^bb1(%x1 : i32, %y1 : i32):
+    vm.br ^bb2(%y1, %x1 : i32, i32)
+  ^bb2(%x2 : i32, %y2 : i32):
+    vm.br ^bb3(%y2, %x2 : i32, i32)
+  ^bb3(%x3 : i32, %y3 : i32):
+    vm.br ^bb4(%y3, %x3 : i32, i32)
+  ^bb4(%x4 : i32, %y4 : i32):
+    vm.br ^bb5(%y4, %x4 : i32, i32)
+  ^bb5(%x5 : i32, %y5 : i32):
+    vm.br ^bb6(%y5, %x5 : i32, i32)
+  ^bb6(%x6 : i32, %y6 : i32):
+    vm.br ^bb7(%y6, %x6 : i32, i32)
+  ^bb7(%x7 : i32, %y7 : i32):
+    vm.br ^bb8(%y7, %x7 : i32, i32)
+  ^bb8(%x8 : i32, %y8 : i32):
+    vm.br ^bb9(%y8, %x8 : i32, i32)
+  ^bb9(%x9 : i32, %y9 : i32):
+    vm.br ^bb10(%y9, %x9 : i32, i32)
+  ^bb10(%x10 : i32, %y10 : i32):
+    vm.br ^bb11(%y10, %x10 : i32, i32)
+  ^bb11(%x11 : i32, %y11 : i32):
+    vm.br ^bb12(%y11, %x11 : i32, i32)
+  ^bb12(%x12 : i32, %y12 : i32):
+    vm.br ^bb13(%y12, %x12 : i32, i32)
+  ^bb13(%x13 : i32, %y13 : i32):
+    vm.br ^bb14(%y13, %x13 : i32, i32)
+  ^bb14(%x14 : i32, %y14 : i32):
+    vm.br ^bb15(%y14, %x14 : i32, i32)
+  ^bb15(%x15 : i32, %y15 : i32):
+    %swapped = vm.xor.i32 %x15, %y15 : i32
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %swapped : i32, i32), ^loop_exit(%swapped : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  vm.func @internal_func(%arg0 : i32) -> i32 attributes {noinline} {
+    vm.return %arg0 : i32
+  }
+
+  // Internal calls with a single i32 argument.
+  vm.export @call_internal
+  vm.func @call_internal(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    %r0 = vm.call @internal_func(%acc) : (i32) -> i32
+    %r1 = vm.call @internal_func(%r0) : (i32) -> i32
+    %r2 = vm.call @internal_func(%r1) : (i32) -> i32
+    %r3 = vm.call @internal_func(%r2) : (i32) -> i32
+    %r4 = vm.call @internal_func(%r3) : (i32) -> i32
+    %r5 = vm.call @internal_func(%r4) : (i32) -> i32
+    %r6 = vm.call @internal_func(%r5) : (i32) -> i32
+    %r7 = vm.call @internal_func(%r6) : (i32) -> i32
+    %r8 = vm.call @internal_func(%r7) : (i32) -> i32
+    %r9 = vm.call @internal_func(%r8) : (i32) -> i32
+    %r10 = vm.call @internal_func(%r9) : (i32) -> i32
+    %r11 = vm.call @internal_func(%r10) : (i32) -> i32
+    %r12 = vm.call @internal_func(%r11) : (i32) -> i32
+    %r13 = vm.call @internal_func(%r12) : (i32) -> i32
+    %r14 = vm.call @internal_func(%r13) : (i32) -> i32
+    %r15 = vm.call @internal_func(%r14) : (i32) -> i32
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %r15 : i32, i32), ^loop_exit(%r15 : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  vm.func @internal_func_ref(%arg0 : !vm.list<i32>, %arg1 : i32) -> i32
+      attributes {noinline} {
+    vm.return %arg1 : i32
+  }
+
+  // Internal calls with mixed ref and i32 arguments.
+  vm.export @call_internal_ref
+  vm.func @call_internal_ref(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    %list = vm.list.alloc %c1 : (i32) -> !vm.list<i32>
+    vm.list.resize %list, %c1 : (!vm.list<i32>, i32)
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    %r0 = vm.call @internal_func_ref(%list, %acc) : (!vm.list<i32>, i32) -> i32
+    %r1 = vm.call @internal_func_ref(%list, %r0) : (!vm.list<i32>, i32) -> i32
+    %r2 = vm.call @internal_func_ref(%list, %r1) : (!vm.list<i32>, i32) -> i32
+    %r3 = vm.call @internal_func_ref(%list, %r2) : (!vm.list<i32>, i32) -> i32
+    %r4 = vm.call @internal_func_ref(%list, %r3) : (!vm.list<i32>, i32) -> i32
+    %r5 = vm.call @internal_func_ref(%list, %r4) : (!vm.list<i32>, i32) -> i32
+    %r6 = vm.call @internal_func_ref(%list, %r5) : (!vm.list<i32>, i32) -> i32
+    %r7 = vm.call @internal_func_ref(%list, %r6) : (!vm.list<i32>, i32) -> i32
+    %r8 = vm.call @internal_func_ref(%list, %r7) : (!vm.list<i32>, i32) -> i32
+    %r9 = vm.call @internal_func_ref(%list, %r8) : (!vm.list<i32>, i32) -> i32
+    %r10 = vm.call @internal_func_ref(%list, %r9) : (!vm.list<i32>, i32) -> i32
+    %r11 = vm.call @internal_func_ref(%list, %r10) : (!vm.list<i32>, i32) -> i32
+    %r12 = vm.call @internal_func_ref(%list, %r11) : (!vm.list<i32>, i32) -> i32
+    %r13 = vm.call @internal_func_ref(%list, %r12) : (!vm.list<i32>, i32) -> i32
+    %r14 = vm.call @internal_func_ref(%list, %r13) : (!vm.list<i32>, i32) -> i32
+    %r15 = vm.call @internal_func_ref(%list, %r14) : (!vm.list<i32>, i32) -> i32
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %r15 : i32, i32), ^loop_exit(%r15 : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  // Ref-taking list accessors (set/get pairs).
+  vm.export @list_i32
+  vm.func @list_i32(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    %list = vm.list.alloc %c1 : (i32) -> !vm.list<i32>
+    vm.list.resize %list, %c1 : (!vm.list<i32>, i32)
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    vm.list.set.i32 %list, %c0, %acc : (!vm.list<i32>, i32, i32)
+    %v0 = vm.list.get.i32 %list, %c0 : (!vm.list<i32>, i32) -> i32
+    vm.list.set.i32 %list, %c0, %v0 : (!vm.list<i32>, i32, i32)
+    %v1 = vm.list.get.i32 %list, %c0 : (!vm.list<i32>, i32) -> i32
+    vm.list.set.i32 %list, %c0, %v1 : (!vm.list<i32>, i32, i32)
+    %v2 = vm.list.get.i32 %list, %c0 : (!vm.list<i32>, i32) -> i32
+    vm.list.set.i32 %list, %c0, %v2 : (!vm.list<i32>, i32, i32)
+    %v3 = vm.list.get.i32 %list, %c0 : (!vm.list<i32>, i32) -> i32
+    vm.list.set.i32 %list, %c0, %v3 : (!vm.list<i32>, i32, i32)
+    %v4 = vm.list.get.i32 %list, %c0 : (!vm.list<i32>, i32) -> i32
+    vm.list.set.i32 %list, %c0, %v4 : (!vm.list<i32>, i32, i32)
+    %v5 = vm.list.get.i32 %list, %c0 : (!vm.list<i32>, i32) -> i32
+    vm.list.set.i32 %list, %c0, %v5 : (!vm.list<i32>, i32, i32)
+    %v6 = vm.list.get.i32 %list, %c0 : (!vm.list<i32>, i32) -> i32
+    vm.list.set.i32 %list, %c0, %v6 : (!vm.list<i32>, i32, i32)
+    %v7 = vm.list.get.i32 %list, %c0 : (!vm.list<i32>, i32) -> i32
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %v7 : i32, i32), ^loop_exit(%v7 : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
+  vm.global.i32 @counter mutable : i32
+
+  // Mutable global stores and loads (store/load pairs).
+  vm.export @global_i32
+  vm.func @global_i32(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %acc : i32):
+    vm.global.store.i32 %acc, @counter : i32
+    %g0 = vm.global.load.i32 @counter : i32
+    vm.global.store.i32 %g0, @counter : i32
+    %g1 = vm.global.load.i32 @counter : i32
+    vm.global.store.i32 %g1, @counter : i32
+    %g2 = vm.global.load.i32 @counter : i32
+    vm.global.store.i32 %g2, @counter : i32
+    %g3 = vm.global.load.i32 @counter : i32
+    vm.global.store.i32 %g3, @counter : i32
+    %g4 = vm.global.load.i32 @counter : i32
+    vm.global.store.i32 %g4, @counter : i32
+    %g5 = vm.global.load.i32 @counter : i32
+    vm.global.store.i32 %g5, @counter : i32
+    %g6 = vm.global.load.i32 @counter : i32
+    vm.global.store.i32 %g6, @counter : i32
+    %g7 = vm.global.load.i32 @counter : i32
+    %in = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %in, %count : i32
+    vm.cond_br %cmp, ^loop(%in, %g7 : i32, i32), ^loop_exit(%g7 : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+}
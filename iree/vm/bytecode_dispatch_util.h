@@ -25,8 +25,8 @@
 
 // TODO(benvanik): make a compiler setting.
 #define IREE_VM_EXT_I64_ENABLE 1
-#define IREE_VM_EXT_F32_ENABLE 0
-#define IREE_VM_EXT_F64_ENABLE 0
+#define IREE_VM_EXT_F32_ENABLE 1
+#define IREE_VM_EXT_F64_ENABLE 1
 
 //===----------------------------------------------------------------------===//
 // Shared data structures
@@ -102,6 +102,18 @@ typedef struct {
   // Relative byte offsets from the head of this struct.
   iree_host_size_t i32_register_offset;
   iree_host_size_t ref_register_offset;
+
+  // Depth of the frame entered from the external caller of the current
+  // dispatch. Returning from a frame at this depth returns to the caller.
+  // Stored per frame so that dispatch can be resumed after a yield.
+  int32_t entry_frame_depth;
+
+  // iree_vm_FunctionFlags_* bits from the function descriptor.
+  uint16_t function_flags;
+
+  // Set when the frame is left through a normal return. Frames unwound due to
+  // failures may still hold live refs regardless of the function flags.
+  bool has_returned;
 } iree_vm_bytecode_frame_storage_t;
 
 // Interleaved src-dst register sets for branch register remapping.
@@ -191,6 +203,25 @@ static const int kRegSize = sizeof(uint16_t);
       ((uint64_t)bytecode_data[pc + 7 + (i)] << 56)
 #endif  // IREE_ENDIANNESS_LITTLE
 
+// Floating-point values are encoded as the bits of their IEEE 754
+// representation and reinterpreted after the integer load.
+static inline float iree_vm_bytecode_f32_from_bits(uint32_t bits) {
+  union {
+    uint32_t bits;
+    float value;
+  } v = {bits};
+  return v.value;
+}
+static inline double iree_vm_bytecode_f64_from_bits(uint64_t bits) {
+  union {
+    uint64_t bits;
+    double value;
+  } v = {bits};
+  return v.value;
+}
+#define OP_F32(i) iree_vm_bytecode_f32_from_bits(OP_I32(i))
+#define OP_F64(i) iree_vm_bytecode_f64_from_bits(OP_I64(i))
+
 //===----------------------------------------------------------------------===//
 // Utilities matching the tablegen op encoding scheme
 //===----------------------------------------------------------------------===//
@@ -209,6 +240,12 @@ static const int kRegSize = sizeof(uint16_t);
 #define VM_DecConstI64(name) \
   OP_I64(0);                 \
   pc += 8;
+#define VM_DecConstF32(name) \
+  OP_F32(0);                 \
+  pc += 4;
+#define VM_DecConstF64(name) \
+  OP_F64(0);                 \
+  pc += 8;
 #define VM_DecOpcode(opcode) VM_DecConstI8(#opcode)
 #define VM_DecFuncAttr(name) VM_DecConstI32(name)
 #define VM_DecGlobalAttr(name) VM_DecConstI32(name)
@@ -219,6 +256,8 @@ static const int kRegSize = sizeof(uint16_t);
 #define VM_DecTypeOf(name) VM_DecType(name)
 #define VM_DecIntAttr32(name) VM_DecConstI32(name)
 #define VM_DecIntAttr64(name) VM_DecConstI64(name)
+#define VM_DecFloatAttr32(name) VM_DecConstF32(name)
+#define VM_DecFloatAttr64(name) VM_DecConstF64(name)
 #define VM_DecStrAttr(name, out_str)                     \
   (out_str)->size = (iree_host_size_t)OP_I16(0);         \
   (out_str)->data = (const char*)&bytecode_data[pc + 2]; \
@@ -235,6 +274,12 @@ static const int kRegSize = sizeof(uint16_t);
 #define VM_DecOperandRegI64(name)                           \
   *((int64_t*)&regs.i32[OP_I16(0) & (regs.i32_mask & ~1)]); \
   pc += kRegSize;
+#define VM_DecOperandRegF32(name)                  \
+  *((float*)&regs.i32[OP_I16(0) & regs.i32_mask]); \
+  pc += kRegSize;
+#define VM_DecOperandRegF64(name)                          \
+  *((double*)&regs.i32[OP_I16(0) & (regs.i32_mask & ~1)]); \
+  pc += kRegSize;
 #define VM_DecOperandRegRef(name, out_is_move)             \
   &regs.ref[OP_I16(0) & regs.ref_mask];                    \
   *(out_is_move) = OP_I16(0) & IREE_REF_REGISTER_MOVE_BIT; \
@@ -249,6 +294,12 @@ static const int kRegSize = sizeof(uint16_t);
 #define VM_DecResultRegI64(name)                           \
   ((int64_t*)&regs.i32[OP_I16(0) & (regs.i32_mask & ~1)]); \
   pc += kRegSize;
+#define VM_DecResultRegF32(name)                  \
+  ((float*)&regs.i32[OP_I16(0) & regs.i32_mask]); \
+  pc += kRegSize;
+#define VM_DecResultRegF64(name)                          \
+  ((double*)&regs.i32[OP_I16(0) & (regs.i32_mask & ~1)]); \
+  pc += kRegSize;
 #define VM_DecResultRegRef(name, out_is_move)              \
   &regs.ref[OP_I16(0) & regs.ref_mask];                    \
   *(out_is_move) = OP_I16(0) & IREE_REF_REGISTER_MOVE_BIT; \
@@ -298,10 +349,28 @@ static const int kRegSize = sizeof(uint16_t);
 #else
 #define DEFINE_DISPATCH_TABLE_EXT_I64()
 #endif  // IREE_VM_EXT_I64_ENABLE
+#if IREE_VM_EXT_F32_ENABLE
+#define DECLARE_DISPATCH_EXT_F32_OPC(ordinal, name) &&_dispatch_EXT_F32_##name,
+#define DEFINE_DISPATCH_TABLE_EXT_F32()                                       \
+  static const void* kDispatchTable_EXT_F32[256] = {IREE_VM_OP_EXT_F32_TABLE( \
+      DECLARE_DISPATCH_EXT_F32_OPC, DECLARE_DISPATCH_EXT_RSV)};
+#else
+#define DEFINE_DISPATCH_TABLE_EXT_F32()
+#endif  // IREE_VM_EXT_F32_ENABLE
+#if IREE_VM_EXT_F64_ENABLE
+#define DECLARE_DISPATCH_EXT_F64_OPC(ordinal, name) &&_dispatch_EXT_F64_##name,
+#define DEFINE_DISPATCH_TABLE_EXT_F64()                                       \
+  static const void* kDispatchTable_EXT_F64[256] = {IREE_VM_OP_EXT_F64_TABLE( \
+      DECLARE_DISPATCH_EXT_F64_OPC, DECLARE_DISPATCH_EXT_RSV)};
+#else
+#define DEFINE_DISPATCH_TABLE_EXT_F64()
+#endif  // IREE_VM_EXT_F64_ENABLE
 
-#define DEFINE_DISPATCH_TABLES() \
-  DEFINE_DISPATCH_TABLE_CORE();  \
-  DEFINE_DISPATCH_TABLE_EXT_I64();
+#define DEFINE_DISPATCH_TABLES()   \
+  DEFINE_DISPATCH_TABLE_CORE();    \
+  DEFINE_DISPATCH_TABLE_EXT_I64(); \
+  DEFINE_DISPATCH_TABLE_EXT_F32(); \
+  DEFINE_DISPATCH_TABLE_EXT_F64();
 
 #define DISPATCH_UNHANDLED_CORE()                                           \
   _dispatch_unhandled : {                                                   \
@@ -392,4 +461,34 @@ static const int kRegSize = sizeof(uint16_t);
     *result = op_func(lhs, rhs);                         \
   });
 
+#define DISPATCH_OP_EXT_F32_UNARY_F32(op_name, op_func) \
+  DISPATCH_OP(EXT_F32, op_name, {                       \
+    float operand = VM_DecOperandRegF32("operand");     \
+    float* result = VM_DecResultRegF32("result");       \
+    *result = op_func(operand);                         \
+  });
+
+#define DISPATCH_OP_EXT_F32_BINARY_F32(op_name, op_func) \
+  DISPATCH_OP(EXT_F32, op_name, {                        \
+    float lhs = VM_DecOperandRegF32("lhs");              \
+    float rhs = VM_DecOperandRegF32("rhs");              \
+    float* result = VM_DecResultRegF32("result");        \
+    *result = op_func(lhs, rhs);                         \
+  });
+
+#define DISPATCH_OP_EXT_F64_UNARY_F64(op_name, op_func) \
+  DISPATCH_OP(EXT_F64, op_name, {                       \
+    double operand = VM_DecOperandRegF64("operand");    \
+    double* result = VM_DecResultRegF64("result");      \
+    *result = op_func(operand);                         \
+  });
+
+#define DISPATCH_OP_EXT_F64_BINARY_F64(op_name, op_func) \
+  DISPATCH_OP(EXT_F64, op_name, {                        \
+    double lhs = VM_DecOperandRegF64("lhs");             \
+    double rhs = VM_DecOperandRegF64("rhs");             \
+    double* result = VM_DecResultRegF64("result");       \
+    *result = op_func(lhs, rhs);                         \
+  });
+
 #endif  // IREE_VM_BYTECODE_DISPATCH_UTIL_H_
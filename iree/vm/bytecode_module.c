@@ -121,6 +121,15 @@ static iree_status_t iree_vm_bytecode_module_flatbuffer_verify(
   iree_vm_BytecodeModuleDef_table_t module_def =
       iree_vm_BytecodeModuleDef_as_root(flatbuffer_data.data);
 
+  uint32_t version = iree_vm_BytecodeModuleDef_version(module_def);
+  if (version != IREE_VM_BYTECODE_MODULE_LATEST_VERSION) {
+    return iree_make_status(
+        IREE_STATUS_FAILED_PRECONDITION,
+        "module was compiled with bytecode version %u but the runtime "
+        "requires version %u; recompile the module",
+        version, (uint32_t)IREE_VM_BYTECODE_MODULE_LATEST_VERSION);
+  }
+
   flatbuffers_string_t name = iree_vm_BytecodeModuleDef_name(module_def);
   if (!flatbuffers_string_len(name)) {
     return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
@@ -505,8 +514,6 @@ static iree_host_size_t iree_vm_bytecode_module_layout_state(
     global_ref_count =
         iree_vm_ModuleStateDef_global_ref_count(module_state_def);
   }
-  iree_host_size_t rodata_ref_count = iree_vm_RodataSegmentDef_vec_len(
-      iree_vm_BytecodeModuleDef_rodata_segments(module_def));
   iree_host_size_t import_function_count = iree_vm_ImportFunctionDef_vec_len(
       iree_vm_BytecodeModuleDef_imported_functions(module_def));
 
@@ -526,12 +533,6 @@ static iree_host_size_t iree_vm_bytecode_module_layout_state(
   }
   offset += iree_align(global_ref_count * sizeof(iree_vm_ref_t), 16);
 
-  if (state) {
-    state->rodata_ref_count = rodata_ref_count;
-    state->rodata_ref_table = (iree_vm_ro_byte_buffer_t*)(base_ptr + offset);
-  }
-  offset += iree_align(rodata_ref_count * sizeof(iree_vm_ro_byte_buffer_t), 16);
-
   if (state) {
     state->import_count = import_function_count;
     state->import_table = (iree_vm_bytecode_import_t*)(base_ptr + offset);
@@ -566,18 +567,9 @@ static iree_status_t iree_vm_bytecode_module_alloc_state(
   // Perform layout to get the pointers into the storage for each nested table.
   iree_vm_bytecode_module_layout_state(module_def, state);
 
-  // Setup rodata segments to point directly at the flatbuffer memory.
-  iree_vm_RodataSegmentDef_vec_t rodata_segments =
-      iree_vm_BytecodeModuleDef_rodata_segments(module_def);
-  for (int i = 0; i < state->rodata_ref_count; ++i) {
-    iree_vm_RodataSegmentDef_table_t segment =
-        iree_vm_RodataSegmentDef_vec_at(rodata_segments, i);
-    iree_vm_ro_byte_buffer_t* ref = &state->rodata_ref_table[i];
-    iree_atomic_ref_count_init(&ref->ref_object.counter);
-    ref->data.data = iree_vm_RodataSegmentDef_data(segment);
-    ref->data.data_length =
-        flatbuffers_uint8_vec_len(iree_vm_RodataSegmentDef_data(segment));
-  }
+  // Rodata segments are immutable and shared with the module.
+  state->rodata_ref_count = module->rodata_ref_count;
+  state->rodata_ref_table = module->rodata_ref_table;
 
   *out_module_state = (iree_vm_module_state_t*)state;
   IREE_TRACE_ZONE_END(z0);
@@ -602,6 +594,68 @@ static void iree_vm_bytecode_module_free_state(
   IREE_TRACE_ZONE_END(z0);
 }
 
+static iree_status_t iree_vm_bytecode_module_fork_state(
+    void* self, iree_vm_module_state_t* parent_module_state,
+    iree_allocator_t allocator, iree_vm_module_state_t** out_module_state) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_bytecode_module_alloc_state(self, allocator,
+                                              out_module_state));
+  iree_vm_bytecode_module_state_t* parent_state =
+      (iree_vm_bytecode_module_state_t*)parent_module_state;
+  iree_vm_bytecode_module_state_t* state =
+      (iree_vm_bytecode_module_state_t*)*out_module_state;
+
+  // Globals are copied such that the fork starts from the initialized values.
+  // Ref globals (executables, constant buffers, etc) are shared by retaining.
+  memcpy(state->rwdata_storage.data, parent_state->rwdata_storage.data,
+         state->rwdata_storage.data_length);
+  for (iree_host_size_t i = 0; i < state->global_ref_count; ++i) {
+    iree_vm_ref_retain(&parent_state->global_ref_table[i],
+                       &state->global_ref_table[i]);
+  }
+
+  // The forked context has the same module list as the parent and imports
+  // would resolve to the same functions.
+  memcpy(state->import_table, parent_state->import_table,
+         state->import_count * sizeof(*state->import_table));
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+// Classifies |cconv_fragment| for direct marshaling if it is made up of only
+// refs followed by only i32s. Otherwise sets |out_ref_count| to
+// IREE_VM_BYTECODE_IMPORT_CCONV_GENERIC.
+static void iree_vm_bytecode_module_classify_cconv_fragment(
+    iree_string_view_t cconv_fragment, uint8_t* out_ref_count,
+    uint8_t* out_i32_count) {
+  *out_ref_count = IREE_VM_BYTECODE_IMPORT_CCONV_GENERIC;
+  *out_i32_count = 0;
+  iree_host_size_t ref_count = 0;
+  iree_host_size_t i32_count = 0;
+  for (iree_host_size_t i = 0; i < cconv_fragment.size; ++i) {
+    switch (cconv_fragment.data[i]) {
+      case IREE_VM_CCONV_TYPE_VOID:
+        break;
+      case IREE_VM_CCONV_TYPE_REF:
+        if (i32_count > 0) return;  // ref after an i32
+        ++ref_count;
+        break;
+      case IREE_VM_CCONV_TYPE_INT32:
+        ++i32_count;
+        break;
+      default:
+        return;  // i64/spans
+    }
+  }
+  if (ref_count >= IREE_VM_BYTECODE_IMPORT_CCONV_GENERIC || i32_count > 0xFF) {
+    return;
+  }
+  *out_ref_count = (uint8_t)ref_count;
+  *out_i32_count = (uint8_t)i32_count;
+}
+
 static iree_status_t iree_vm_bytecode_module_resolve_import(
     void* self, iree_vm_module_state_t* module_state, iree_host_size_t ordinal,
     const iree_vm_function_t* function,
@@ -643,32 +697,36 @@ static iree_status_t iree_vm_bytecode_module_resolve_import(
   import->argument_buffer_size = (uint16_t)argument_buffer_size;
   import->result_buffer_size = (uint16_t)result_buffer_size;
 
+  // Select the direct marshaling path for common signatures so that calls
+  // need not parse the cconv strings.
+  iree_vm_bytecode_module_classify_cconv_fragment(
+      import->arguments, &import->argument_ref_count,
+      &import->argument_i32_count);
+  iree_vm_bytecode_module_classify_cconv_fragment(
+      import->results, &import->result_ref_count, &import->result_i32_count);
+
+  // Native functions are called through their shims directly instead of
+  // dispatching through the module interface on each call.
+  iree_vm_native_module_lookup_function_ptr(function,
+                                            &import->native_function);
+
   return iree_ok_status();
 }
 
-static iree_status_t iree_vm_bytecode_module_begin_call(
-    void* self, iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
-    iree_vm_execution_result_t* out_result) {
-  // NOTE: any work here adds directly to the invocation time. Avoid doing too
-  // much work or touching too many unlikely-to-be-cached structures (such as
-  // walking the FlatBuffer, which may cause page faults).
-  IREE_TRACE_ZONE_BEGIN(z0);
-  IREE_ASSERT_ARGUMENT(out_result);
-  memset(out_result, 0, sizeof(iree_vm_execution_result_t));
-
+// Looks up the calling convention fragments of the function targeted by |call|.
+static iree_status_t iree_vm_bytecode_module_query_call_cconv(
+    iree_vm_bytecode_module_t* module, const iree_vm_function_call_t* call,
+    iree_string_view_t* out_cconv_arguments,
+    iree_string_view_t* out_cconv_results) {
   // Only internal functions store the information needed for execution. We
   // allow exports here as well to make things easier to call externally.
   iree_vm_function_t function = call->function;
   if (function.linkage != IREE_VM_FUNCTION_LINKAGE_INTERNAL) {
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
-        z0,
-        iree_vm_bytecode_module_get_function(
-            self, function.linkage, function.ordinal, &function, NULL, NULL));
+    IREE_RETURN_IF_ERROR(iree_vm_bytecode_module_get_function(
+        module, function.linkage, function.ordinal, &function, NULL, NULL));
   }
 
-  iree_vm_bytecode_module_t* module = (iree_vm_bytecode_module_t*)self;
   if (function.ordinal >= module->function_descriptor_count) {
-    IREE_TRACE_ZONE_END(z0);
     return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
                             "function ordinal out of range (0 < %u < %zu)",
                             function.ordinal,
@@ -699,11 +757,28 @@ static iree_status_t iree_vm_bytecode_module_begin_call(
   signature.calling_convention.data = calling_convention;
   signature.calling_convention.size =
       flatbuffers_string_len(calling_convention);
+  *out_cconv_arguments = iree_string_view_empty();
+  *out_cconv_results = iree_string_view_empty();
+  return iree_vm_function_call_get_cconv_fragments(
+      &signature, out_cconv_arguments, out_cconv_results);
+}
+
+static iree_status_t iree_vm_bytecode_module_begin_call(
+    void* self, iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_execution_result_t* out_result) {
+  // NOTE: any work here adds directly to the invocation time. Avoid doing too
+  // much work or touching too many unlikely-to-be-cached structures (such as
+  // walking the FlatBuffer, which may cause page faults).
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_ASSERT_ARGUMENT(out_result);
+  memset(out_result, 0, sizeof(iree_vm_execution_result_t));
+
+  iree_vm_bytecode_module_t* module = (iree_vm_bytecode_module_t*)self;
   iree_string_view_t cconv_arguments = iree_string_view_empty();
   iree_string_view_t cconv_results = iree_string_view_empty();
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_vm_function_call_get_cconv_fragments(
-              &signature, &cconv_arguments, &cconv_results));
+      z0, iree_vm_bytecode_module_query_call_cconv(
+              module, call, &cconv_arguments, &cconv_results));
 
   // Jump into the dispatch routine to execute bytecode until the function
   // either returns (synchronous) or yields (asynchronous).
@@ -713,6 +788,27 @@ static iree_status_t iree_vm_bytecode_module_begin_call(
   return status;
 }
 
+static iree_status_t iree_vm_bytecode_module_resume_call(
+    void* self, iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_execution_result_t* out_result) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_ASSERT_ARGUMENT(out_result);
+
+  // Results are only marshaled when the entry frame returns so we need the
+  // same calling convention as the original call.
+  iree_vm_bytecode_module_t* module = (iree_vm_bytecode_module_t*)self;
+  iree_string_view_t cconv_arguments = iree_string_view_empty();
+  iree_string_view_t cconv_results = iree_string_view_empty();
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_bytecode_module_query_call_cconv(
+              module, call, &cconv_arguments, &cconv_results));
+
+  iree_status_t status = iree_vm_bytecode_dispatch_resume(
+      stack, module, call, cconv_results, out_result);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_bytecode_module_create(
     iree_const_byte_span_t flatbuffer_data,
     iree_allocator_t flatbuffer_allocator, iree_allocator_t allocator,
@@ -742,14 +838,21 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_bytecode_module_create(
   }
 
   iree_vm_TypeDef_vec_t type_defs = iree_vm_BytecodeModuleDef_types(module_def);
-  size_t type_table_size =
-      iree_vm_TypeDef_vec_len(type_defs) * sizeof(iree_vm_type_def_t);
+  size_t type_table_size = iree_align(
+      iree_vm_TypeDef_vec_len(type_defs) * sizeof(iree_vm_type_def_t), 16);
+  iree_vm_RodataSegmentDef_vec_t rodata_segments =
+      iree_vm_BytecodeModuleDef_rodata_segments(module_def);
+  size_t rodata_ref_table_size =
+      iree_vm_RodataSegmentDef_vec_len(rodata_segments) *
+      sizeof(iree_vm_ro_byte_buffer_t);
+
+  iree_host_size_t total_size =
+      iree_align(sizeof(iree_vm_bytecode_module_t), 16) + type_table_size +
+      rodata_ref_table_size;
 
   iree_vm_bytecode_module_t* module = NULL;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_allocator_malloc(
-              allocator, sizeof(iree_vm_bytecode_module_t) + type_table_size,
-              (void**)&module));
+      z0, iree_allocator_malloc(allocator, total_size, (void**)&module));
   module->allocator = allocator;
 
   iree_vm_FunctionDescriptor_vec_t function_descriptors =
@@ -767,9 +870,24 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_bytecode_module_create(
   module->flatbuffer_allocator = flatbuffer_allocator;
   module->def = module_def;
 
+  uint8_t* table_ptr =
+      (uint8_t*)module + iree_align(sizeof(iree_vm_bytecode_module_t), 16);
   module->type_count = iree_vm_TypeDef_vec_len(type_defs);
-  module->type_table = (iree_vm_type_def_t*)((uint8_t*)module +
-                                             sizeof(iree_vm_bytecode_module_t));
+  module->type_table = (iree_vm_type_def_t*)table_ptr;
+  table_ptr += type_table_size;
+
+  // Setup rodata segments to point directly at the flatbuffer memory.
+  module->rodata_ref_count = iree_vm_RodataSegmentDef_vec_len(rodata_segments);
+  module->rodata_ref_table = (iree_vm_ro_byte_buffer_t*)table_ptr;
+  for (iree_host_size_t i = 0; i < module->rodata_ref_count; ++i) {
+    iree_vm_RodataSegmentDef_table_t segment =
+        iree_vm_RodataSegmentDef_vec_at(rodata_segments, i);
+    iree_vm_ro_byte_buffer_t* ref = &module->rodata_ref_table[i];
+    iree_atomic_ref_count_init(&ref->ref_object.counter);
+    ref->data.data = iree_vm_RodataSegmentDef_data(segment);
+    ref->data.data_length =
+        flatbuffers_uint8_vec_len(iree_vm_RodataSegmentDef_data(segment));
+  }
   iree_status_t resolve_status =
       iree_vm_bytecode_module_resolve_types(type_defs, module->type_table);
   if (!iree_status_is_ok(resolve_status)) {
@@ -786,8 +904,10 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_bytecode_module_create(
   module->interface.lookup_function = iree_vm_bytecode_module_lookup_function;
   module->interface.alloc_state = iree_vm_bytecode_module_alloc_state;
   module->interface.free_state = iree_vm_bytecode_module_free_state;
+  module->interface.fork_state = iree_vm_bytecode_module_fork_state;
   module->interface.resolve_import = iree_vm_bytecode_module_resolve_import;
   module->interface.begin_call = iree_vm_bytecode_module_begin_call;
+  module->interface.resume_call = iree_vm_bytecode_module_resume_call;
   module->interface.get_function_reflection_attr =
       iree_vm_bytecode_module_get_function_reflection_attr;
 
@@ -38,6 +38,10 @@ extern "C" {
 #define VMMAX(a, b) (((a) > (b)) ? (a) : (b))
 #define VMMIN(a, b) (((a) < (b)) ? (a) : (b))
 
+// The iree_vm_BytecodeVersion_* the runtime was built to load. Must match the
+// version written by the compiler in BytecodeModuleTarget.cpp.
+#define IREE_VM_BYTECODE_MODULE_LATEST_VERSION iree_vm_BytecodeVersion_V2
+
 // Maximum register count per bank.
 // This determines the bits required to reference registers in the VM bytecode.
 #define IREE_I32_REGISTER_COUNT 0x7FFF
@@ -76,8 +80,19 @@ typedef struct {
   // Type table mapping module type IDs to registered VM types.
   iree_host_size_t type_count;
   iree_vm_type_def_t* type_table;
+
+  // Initialized references to rodata segments shared by all module states.
+  // Each points directly at the FlatBuffer memory. Right now these don't do
+  // much, however we can perform lazy caching and on-the-fly decompression
+  // using this information.
+  iree_host_size_t rodata_ref_count;
+  iree_vm_ro_byte_buffer_t* rodata_ref_table;
 } iree_vm_bytecode_module_t;
 
+// Sentinel ref count of iree_vm_bytecode_import_t fragments that must be
+// marshaled by interpreting their cconv string.
+#define IREE_VM_BYTECODE_IMPORT_CCONV_GENERIC 0xFFu
+
 // A resolved and split import in the module state table.
 //
 // NOTE: a table of these are stored per module per context so ideally we'd
@@ -98,6 +113,21 @@ typedef struct {
   // don't support variadic values (yet).
   uint16_t argument_buffer_size;
   uint16_t result_buffer_size;
+
+  // Register counts for argument/result fragments that are made up of only
+  // refs followed by only i32s (such as `rriiii` for most HAL imports). Values
+  // of such fragments are copied directly between registers and the ABI
+  // buffers without interpreting the cconv strings. The ref count is
+  // IREE_VM_BYTECODE_IMPORT_CCONV_GENERIC if the fragment has any other shape.
+  uint8_t argument_ref_count;
+  uint8_t argument_i32_count;
+  uint8_t result_ref_count;
+  uint8_t result_i32_count;
+
+  // Shim and target of the function if it is implemented by a native module
+  // that can be called with iree_vm_native_module_call_direct. The shim is
+  // NULL if the call must go through the module begin_call interface.
+  iree_vm_native_function_ptr_t native_function;
 } iree_vm_bytecode_import_t;
 
 // Per-instance module state.
@@ -113,10 +143,8 @@ typedef struct {
   iree_host_size_t global_ref_count;
   iree_vm_ref_t* global_ref_table;
 
-  // TODO(benvanik): move to iree_vm_bytecode_module_t if always static.
-  // Initialized references to rodata segments.
-  // Right now these don't do much, however we can perform lazy caching and
-  // on-the-fly decompression using this information.
+  // Rodata segment references aliasing the module rodata_ref_table.
+  // Stored here to avoid an indirection through the module during dispatch.
   iree_host_size_t rodata_ref_count;
   iree_vm_ro_byte_buffer_t* rodata_ref_table;
 
@@ -138,6 +166,13 @@ iree_status_t iree_vm_bytecode_dispatch(iree_vm_stack_t* stack,
                                         iree_string_view_t cconv_results,
                                         iree_vm_execution_result_t* out_result);
 
+// Resumes execution of a call previously begun with iree_vm_bytecode_dispatch
+// that yielded. |call| and |cconv_results| must match the original call.
+iree_status_t iree_vm_bytecode_dispatch_resume(
+    iree_vm_stack_t* stack, iree_vm_bytecode_module_t* module,
+    const iree_vm_function_call_t* call, iree_string_view_t cconv_results,
+    iree_vm_execution_result_t* out_result);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
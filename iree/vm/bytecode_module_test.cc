@@ -18,10 +18,131 @@
 
 #include "iree/vm/bytecode_module.h"
 
+#include "iree/base/api.h"
 #include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+#include "iree/vm/api.h"
+#include "iree/vm/bytecode_module_test_module.h"
+#include "iree/vm/ref_cc.h"
 
 namespace {
 
 // TODO(benvanik): bytecode_module_test.cc for flatbuffer/module implementation.
 
+class VMBytecodeModuleTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    IREE_CHECK_OK(iree_vm_instance_create(iree_allocator_system(), &instance_));
+
+    const auto* module_file_toc =
+        iree::vm::bytecode_module_test_module_create();
+    iree_vm_module_t* module = nullptr;
+    IREE_CHECK_OK(iree_vm_bytecode_module_create(
+        iree_const_byte_span_t{
+            reinterpret_cast<const uint8_t*>(module_file_toc->data),
+            module_file_toc->size},
+        iree_allocator_null(), iree_allocator_system(), &module));
+    IREE_CHECK_OK(iree_vm_context_create_with_modules(
+        instance_, &module, 1, iree_allocator_system(), &context_));
+    iree_vm_module_release(module);
+  }
+
+  virtual void TearDown() {
+    iree_vm_context_release(context_);
+    iree_vm_instance_release(instance_);
+  }
+
+  // Invokes |function_name| in |context| with an optional i32 argument and
+  // returns the output list.
+  iree::vm::ref<iree_vm_list_t> Invoke(iree_vm_context_t* context,
+                                       const char* function_name,
+                                       const int32_t* arg0 = nullptr) {
+    iree_vm_function_t function;
+    IREE_CHECK_OK(iree_vm_context_resolve_function(
+        context, iree_make_cstring_view(function_name), &function));
+    iree::vm::ref<iree_vm_list_t> inputs;
+    IREE_CHECK_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                      iree_allocator_system(), &inputs));
+    if (arg0) {
+      auto arg0_value = iree_vm_value_make_i32(*arg0);
+      IREE_CHECK_OK(iree_vm_list_push_value(inputs.get(), &arg0_value));
+    }
+    iree::vm::ref<iree_vm_list_t> outputs;
+    IREE_CHECK_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                      iree_allocator_system(), &outputs));
+    IREE_CHECK_OK(iree_vm_invoke(context, function, /*policy=*/nullptr,
+                                 inputs.get(), outputs.get(),
+                                 iree_allocator_system()));
+    return outputs;
+  }
+
+  int32_t AddCounter(iree_vm_context_t* context, int32_t value) {
+    auto outputs = Invoke(context, "bytecode_module_test.add_counter", &value);
+    iree_vm_value_t result;
+    IREE_CHECK_OK(iree_vm_list_get_value(outputs.get(), 0, &result));
+    return result.i32;
+  }
+
+  // Returns the identity of the list held in the @list global.
+  void* GetList(iree_vm_context_t* context) {
+    auto outputs = Invoke(context, "bytecode_module_test.get_list");
+    iree_vm_ref_t list = {0};
+    IREE_CHECK_OK(iree_vm_list_get_ref_assign(outputs.get(), 0, &list));
+    return list.ptr;
+  }
+
+  iree_vm_context_t* Fork() {
+    iree_vm_context_t* fork = nullptr;
+    IREE_CHECK_OK(
+        iree_vm_context_fork(context_, iree_allocator_system(), &fork));
+    return fork;
+  }
+
+  iree_vm_context_t* context() const { return context_; }
+
+ private:
+  iree_vm_instance_t* instance_ = nullptr;
+  iree_vm_context_t* context_ = nullptr;
+};
+
+// Tests that forks start from the globals of the frozen parent and that stores
+// to globals in one context are not observed by the others.
+TEST_F(VMBytecodeModuleTest, ForkCopiesGlobals) {
+  EXPECT_EQ(10, AddCounter(context(), 10));
+  iree_vm_context_freeze(context());
+  iree_vm_context_t* fork_a = Fork();
+  iree_vm_context_t* fork_b = Fork();
+
+  EXPECT_EQ(15, AddCounter(fork_a, 5));
+  EXPECT_EQ(16, AddCounter(fork_a, 1));
+  EXPECT_EQ(11, AddCounter(fork_b, 1));
+  EXPECT_EQ(10, AddCounter(context(), 0));
+
+  // The fork keeps its globals after the parent is released.
+  iree_vm_context_release(fork_b);
+  EXPECT_EQ(16, AddCounter(fork_a, 0));
+  iree_vm_context_release(fork_a);
+}
+
+// Tests that ref globals are shared with forks instead of reinitialized and
+// that storing a new ref in one context does not change the others.
+TEST_F(VMBytecodeModuleTest, ForkRetainsRefGlobals) {
+  iree_vm_context_freeze(context());
+  void* parent_list = GetList(context());
+  ASSERT_NE(nullptr, parent_list);
+  iree_vm_context_t* fork_a = Fork();
+  iree_vm_context_t* fork_b = Fork();
+  EXPECT_EQ(parent_list, GetList(fork_a));
+  EXPECT_EQ(parent_list, GetList(fork_b));
+
+  Invoke(fork_a, "bytecode_module_test.reset_list");
+  void* fork_a_list = GetList(fork_a);
+  EXPECT_NE(parent_list, fork_a_list);
+  EXPECT_EQ(parent_list, GetList(fork_b));
+  EXPECT_EQ(parent_list, GetList(context()));
+
+  iree_vm_context_release(fork_a);
+  iree_vm_context_release(fork_b);
+}
+
 }  // namespace
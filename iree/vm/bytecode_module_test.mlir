@@ -0,0 +1,37 @@
+vm.module @bytecode_module_test {
+  // Mutated by @add_counter such that tests can check which contexts observe
+  // the stores.
+  vm.global.i32 @counter mutable 0 : i32
+
+  // A ref global allocated by the module initializer.
+  vm.global.ref @list mutable init(@list_init) : !vm.list<i32>
+  vm.func @list_init() -> !vm.list<i32> {
+    %c1 = vm.const.i32 1 : i32
+    %list = vm.list.alloc %c1 : (i32) -> !vm.list<i32>
+    vm.return %list : !vm.list<i32>
+  }
+
+  // Adds |%arg0| to @counter and returns the new value.
+  vm.export @add_counter
+  vm.func @add_counter(%arg0 : i32) -> i32 {
+    %counter = vm.global.load.i32 @counter : i32
+    %0 = vm.add.i32 %counter, %arg0 : i32
+    vm.global.store.i32 %0, @counter : i32
+    vm.return %0 : i32
+  }
+
+  vm.export @get_list
+  vm.func @get_list() -> !vm.list<i32> {
+    %list = vm.global.load.ref @list : !vm.list<i32>
+    vm.return %list : !vm.list<i32>
+  }
+
+  // Replaces @list with a newly allocated list.
+  vm.export @reset_list
+  vm.func @reset_list() {
+    %c1 = vm.const.i32 1 : i32
+    %list = vm.list.alloc %c1 : (i32) -> !vm.list<i32>
+    vm.global.store.ref %list, @list : !vm.list<i32>
+    vm.return
+  }
+}
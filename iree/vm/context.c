@@ -28,6 +28,7 @@ struct iree_vm_context {
   intptr_t context_id;
 
   bool is_static;
+  bool is_frozen;
   struct {
     iree_host_size_t count;
     iree_host_size_t capacity;
@@ -196,28 +197,18 @@ static void iree_vm_context_release_modules(iree_vm_context_t* context,
   IREE_TRACE_ZONE_END(z0);
 }
 
-IREE_API_EXPORT iree_status_t IREE_API_CALL
-iree_vm_context_create(iree_vm_instance_t* instance, iree_allocator_t allocator,
-                       iree_vm_context_t** out_context) {
-  return iree_vm_context_create_with_modules(instance, NULL, 0, allocator,
-                                             out_context);
-}
-
-IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_context_create_with_modules(
-    iree_vm_instance_t* instance, iree_vm_module_t** modules,
-    iree_host_size_t module_count, iree_allocator_t allocator,
-    iree_vm_context_t** out_context) {
-  IREE_TRACE_ZONE_BEGIN(z0);
-  IREE_ASSERT_ARGUMENT(instance);
-  IREE_ASSERT_ARGUMENT(out_context);
-  *out_context = NULL;
-
+// Allocates an empty context with inline storage for |module_count| modules.
+static iree_status_t iree_vm_context_allocate(iree_vm_instance_t* instance,
+                                              iree_host_size_t module_count,
+                                              iree_allocator_t allocator,
+                                              iree_vm_context_t** out_context) {
   iree_host_size_t context_size =
       sizeof(iree_vm_context_t) + sizeof(iree_vm_module_t*) * module_count +
       sizeof(iree_vm_module_state_t*) * module_count;
 
   iree_vm_context_t* context = NULL;
-  iree_allocator_malloc(allocator, context_size, (void**)&context);
+  IREE_RETURN_IF_ERROR(
+      iree_allocator_malloc(allocator, context_size, (void**)&context));
   iree_atomic_ref_count_init(&context->ref_count);
   context->instance = instance;
   iree_vm_instance_retain(context->instance);
@@ -236,6 +227,31 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_context_create_with_modules(
   context->list.capacity = module_count;
   context->is_static = module_count > 0;
 
+  *out_context = context;
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_context_create(iree_vm_instance_t* instance, iree_allocator_t allocator,
+                       iree_vm_context_t** out_context) {
+  return iree_vm_context_create_with_modules(instance, NULL, 0, allocator,
+                                             out_context);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_context_create_with_modules(
+    iree_vm_instance_t* instance, iree_vm_module_t** modules,
+    iree_host_size_t module_count, iree_allocator_t allocator,
+    iree_vm_context_t** out_context) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_ASSERT_ARGUMENT(instance);
+  IREE_ASSERT_ARGUMENT(out_context);
+  *out_context = NULL;
+
+  iree_vm_context_t* context = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_context_allocate(instance, module_count, allocator,
+                                   &context));
+
   iree_status_t register_status =
       iree_vm_context_register_modules(context, modules, module_count);
   if (!iree_status_is_ok(register_status)) {
@@ -328,6 +344,11 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_context_register_modules(
     }
   }
 
+  if (context->is_frozen) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "context is frozen and cannot register modules");
+  }
+
   IREE_TRACE_ZONE_BEGIN(z0);
 
   // Try growing both our storage lists first, if needed.
@@ -430,6 +451,97 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_context_register_modules(
   return status;
 }
 
+IREE_API_EXPORT void IREE_API_CALL
+iree_vm_context_freeze(iree_vm_context_t* context) {
+  IREE_ASSERT_ARGUMENT(context);
+  context->is_frozen = true;
+}
+
+IREE_API_EXPORT bool IREE_API_CALL
+iree_vm_context_is_frozen(const iree_vm_context_t* context) {
+  IREE_ASSERT_ARGUMENT(context);
+  return context->is_frozen;
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_context_fork(const iree_vm_context_t* parent_context,
+                     iree_allocator_t allocator,
+                     iree_vm_context_t** out_context) {
+  IREE_ASSERT_ARGUMENT(parent_context);
+  IREE_ASSERT_ARGUMENT(out_context);
+  *out_context = NULL;
+  if (!parent_context->is_frozen) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "contexts must be frozen before they are forked");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Allocated as static even if there are no modules so that the fork matches
+  // the frozen parent.
+  iree_host_size_t module_count = parent_context->list.count;
+  iree_vm_context_t* context = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_context_allocate(parent_context->instance, module_count,
+                                   allocator, &context));
+  context->is_static = true;
+  context->is_frozen = true;
+
+  // VM stack used to call into module __init methods of modules that cannot
+  // be forked.
+  IREE_VM_INLINE_STACK_INITIALIZE(
+      stack, iree_vm_context_state_resolver(context), context->allocator);
+
+  // Modules are processed in registration order as with
+  // iree_vm_context_register_modules so that any module that needs to be
+  // initialized from scratch can resolve imports against prior modules.
+  iree_status_t status = iree_ok_status();
+  iree_host_size_t i = 0;
+  for (i = 0; i < module_count; ++i) {
+    iree_vm_module_t* module = parent_context->list.modules[i];
+    context->list.modules[i] = module;
+    context->list.module_states[i] = NULL;
+    iree_vm_module_retain(module);
+
+    iree_vm_module_state_t* module_state = NULL;
+    if (module->fork_state) {
+      status = module->fork_state(module->self,
+                                  parent_context->list.module_states[i],
+                                  context->allocator, &module_state);
+      if (!iree_status_is_ok(status)) break;
+      context->list.module_states[i] = module_state;
+      ++context->list.count;
+      continue;
+    }
+
+    status =
+        module->alloc_state(module->self, context->allocator, &module_state);
+    if (!iree_status_is_ok(status)) break;
+    context->list.module_states[i] = module_state;
+    status =
+        iree_vm_context_resolve_module_imports(context, module, module_state);
+    if (!iree_status_is_ok(status)) break;
+    ++context->list.count;
+    status = iree_vm_context_run_function(stack, module,
+                                          iree_make_cstring_view("__init"));
+    if (!iree_status_is_ok(status)) break;
+  }
+
+  iree_vm_stack_deinitialize(stack);
+
+  if (!iree_status_is_ok(status)) {
+    // Release the module that failed along with all prior ones.
+    iree_vm_context_release_modules(context, 0, i);
+    context->list.count = 0;
+    iree_vm_context_release(context);
+    IREE_TRACE_ZONE_END(z0);
+    return status;
+  }
+
+  *out_context = context;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_context_resolve_function(
     const iree_vm_context_t* context, iree_string_view_t full_name,
     iree_vm_function_t* out_function) {
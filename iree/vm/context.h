@@ -85,6 +85,39 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_context_register_modules(
     iree_vm_context_t* context, iree_vm_module_t** modules,
     iree_host_size_t module_count);
 
+// Freezes |context| such that no additional modules can be registered and it
+// can be used as the parent of iree_vm_context_fork. Frozen contexts can still
+// be used to invoke functions though callers must not do so while forks are
+// being created from them.
+IREE_API_EXPORT void IREE_API_CALL
+iree_vm_context_freeze(iree_vm_context_t* context);
+
+// Returns true if |context| has been frozen with iree_vm_context_freeze.
+IREE_API_EXPORT bool IREE_API_CALL
+iree_vm_context_is_frozen(const iree_vm_context_t* context);
+
+// Creates a new context with the same modules as the frozen |parent_context|.
+// Modules that support forking (such as bytecode modules) share the
+// initialized state of the parent: globals are copied, ref globals such as
+// executables and constant buffers are retained instead of recreated, and
+// neither imports nor __init functions are run again. Other modules have
+// their state allocated and initialized as in iree_vm_context_create.
+//
+// Ref globals are retained and not deep-copied: the parent and all forks
+// reference the same objects. Storing a new ref into a global only affects the
+// context doing so but writes into the contents of a shared object (such as a
+// mutable buffer held in a global) are visible to all of them. Programs that
+// mutate such objects after initialization must not be forked.
+//
+// The fork does not depend on the parent after creation and either may be
+// released first. Multiple threads may fork from the same parent concurrently.
+// Contexts created in this way cannot have additional modules registered.
+// |out_context| must be released by the caller.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_context_fork(const iree_vm_context_t* parent_context,
+                     iree_allocator_t allocator,
+                     iree_vm_context_t** out_context);
+
 // Sets |out_function| to to an exported function with the fully-qualified name
 // of |full_name| or returns IREE_STATUS_NOT_FOUND. The function reference is
 // valid for the lifetime of |context|.
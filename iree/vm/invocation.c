@@ -15,6 +15,7 @@
 #include "iree/vm/invocation.h"
 
 #include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
 #include "iree/base/tracing.h"
 
 // Marshals caller arguments from the variant list to the ABI convention.
@@ -192,3 +193,454 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_invoke(
   IREE_TRACE_ZONE_END(z0);
   return status;
 }
+
+//===----------------------------------------------------------------------===//
+// iree_vm_invocation_t
+//===----------------------------------------------------------------------===//
+
+struct iree_vm_invocation {
+  iree_atomic_ref_count_t ref_count;
+  iree_allocator_t allocator;
+
+  // Context the invocation executes within; retained so that module state
+  // remains valid across yields.
+  iree_vm_context_t* context;
+  iree_vm_function_signature_t signature;
+  iree_string_view_t cconv_results;
+
+  // Stack holding the suspended frames while the invocation is pending.
+  // Released as soon as the invocation completes.
+  iree_vm_stack_t* stack;
+
+  // ABI call with argument and result storage allocated inline after the
+  // invocation.
+  iree_vm_function_call_t call;
+
+  // Condition the invocation last yielded on. Only valid while pending.
+  iree_vm_wait_request_t wait;
+
+  // IREE_STATUS_UNAVAILABLE while pending and otherwise the final status.
+  iree_status_t status;
+
+  // Results of the function, populated upon successful completion.
+  iree_vm_list_t* outputs;
+};
+
+static bool iree_vm_invocation_is_pending(
+    const iree_vm_invocation_t* invocation) {
+  return iree_status_code(invocation->status) == IREE_STATUS_UNAVAILABLE;
+}
+
+// Completes |invocation| with |status|, releasing all execution resources.
+static void iree_vm_invocation_complete(iree_vm_invocation_t* invocation,
+                                        iree_status_t status) {
+  if (!iree_status_is_ok(status)) {
+    iree_vm_function_call_release(&invocation->call, &invocation->signature);
+  }
+  iree_vm_wait_request_reset(&invocation->wait);
+  if (invocation->stack) {
+    iree_vm_stack_free(invocation->stack);
+    invocation->stack = NULL;
+  }
+  iree_status_ignore(invocation->status);
+  invocation->status = status;
+}
+
+// Begins or resumes execution of |invocation| until it yields or completes.
+static void iree_vm_invocation_run(iree_vm_invocation_t* invocation,
+                                   bool is_resume) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_vm_module_t* module = invocation->call.function.module;
+  iree_vm_execution_result_t result;
+  iree_status_t status =
+      is_resume ? module->resume_call(module->self, invocation->stack,
+                                      &invocation->call, &result)
+                : module->begin_call(module->self, invocation->stack,
+                                     &invocation->call, &result);
+  if (!iree_status_is_ok(status)) {
+    iree_vm_invocation_complete(invocation, status);
+    IREE_TRACE_ZONE_END(z0);
+    return;
+  }
+
+  if (result.flags & IREE_VM_EXECUTION_RESULT_FLAG_YIELDED) {
+    // Still pending; keep the stack around until the wait is satisfied.
+    invocation->wait = result.wait;
+    IREE_TRACE_ZONE_END(z0);
+    return;
+  }
+
+  // Completed; read back the outputs from the result buffer.
+  status = iree_vm_list_create(/*element_type=*/NULL,
+                               invocation->cconv_results.size,
+                               invocation->allocator, &invocation->outputs);
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_invoke_marshal_outputs(invocation->cconv_results,
+                                            invocation->call.results,
+                                            invocation->outputs);
+  }
+  iree_vm_invocation_complete(invocation, status);
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_invocation_create(
+    iree_vm_context_t* context, iree_vm_function_t function,
+    const iree_vm_invocation_policy_t* policy, const iree_vm_list_t* inputs,
+    iree_allocator_t allocator, iree_vm_invocation_t** out_invocation) {
+  IREE_ASSERT_ARGUMENT(context);
+  IREE_ASSERT_ARGUMENT(out_invocation);
+  *out_invocation = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_vm_function_signature_t signature =
+      iree_vm_function_signature(&function);
+  iree_string_view_t cconv_arguments = iree_string_view_empty();
+  iree_string_view_t cconv_results = iree_string_view_empty();
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_get_cconv_fragments(
+              &signature, &cconv_arguments, &cconv_results));
+  iree_host_size_t argument_size = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_compute_cconv_fragment_size(
+              cconv_arguments, /*segment_size_list=*/NULL, &argument_size));
+  iree_host_size_t result_size = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_compute_cconv_fragment_size(
+              cconv_results, /*segment_size_list=*/NULL, &result_size));
+
+  // Argument and result storage must outlive any yields so they are allocated
+  // along with the invocation instead of on the host stack.
+  iree_host_size_t header_size =
+      iree_math_align(sizeof(iree_vm_invocation_t), iree_max_align_t);
+  iree_host_size_t argument_storage_size =
+      iree_math_align(argument_size, iree_max_align_t);
+  iree_vm_invocation_t* invocation = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(
+              allocator, header_size + argument_storage_size + result_size,
+              (void**)&invocation));
+  memset(invocation, 0, header_size + argument_storage_size + result_size);
+  iree_atomic_ref_count_init(&invocation->ref_count);
+  invocation->allocator = allocator;
+  invocation->context = context;
+  iree_vm_context_retain(context);
+  invocation->signature = signature;
+  invocation->cconv_results = cconv_results;
+  invocation->call.function = function;
+  invocation->call.arguments =
+      iree_make_byte_span((uint8_t*)invocation + header_size, argument_size);
+  invocation->call.results = iree_make_byte_span(
+      (uint8_t*)invocation + header_size + argument_storage_size, result_size);
+  invocation->status = iree_status_from_code(IREE_STATUS_UNAVAILABLE);
+
+  iree_status_t status = iree_vm_invoke_marshal_inputs(
+      cconv_arguments, (iree_vm_list_t*)inputs, invocation->call.arguments);
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_stack_allocate(iree_vm_context_state_resolver(context),
+                                    allocator, &invocation->stack);
+  }
+  if (iree_status_is_ok(status)) {
+    iree_vm_stack_set_yield_enabled(invocation->stack, true);
+    iree_vm_invocation_run(invocation, /*is_resume=*/false);
+    *out_invocation = invocation;
+  } else {
+    iree_vm_invocation_complete(invocation, iree_ok_status());
+    iree_vm_function_call_release(&invocation->call, &signature);
+    iree_vm_invocation_release(invocation);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static void iree_vm_invocation_destroy(iree_vm_invocation_t* invocation) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  if (iree_vm_invocation_is_pending(invocation)) {
+    iree_vm_invocation_complete(
+        invocation, iree_status_from_code(IREE_STATUS_ABORTED));
+  }
+  iree_status_ignore(invocation->status);
+  iree_vm_list_release(invocation->outputs);
+  iree_vm_context_release(invocation->context);
+  iree_allocator_free(invocation->allocator, invocation);
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_invocation_retain(iree_vm_invocation_t* invocation) {
+  IREE_ASSERT_ARGUMENT(invocation);
+  iree_atomic_ref_count_inc(&invocation->ref_count);
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_invocation_release(iree_vm_invocation_t* invocation) {
+  if (invocation && iree_atomic_ref_count_dec(&invocation->ref_count) == 1) {
+    iree_vm_invocation_destroy(invocation);
+  }
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_invocation_query_status(iree_vm_invocation_t* invocation) {
+  IREE_ASSERT_ARGUMENT(invocation);
+  return iree_status_clone(invocation->status);
+}
+
+IREE_API_EXPORT const iree_vm_list_t* IREE_API_CALL
+iree_vm_invocation_output(iree_vm_invocation_t* invocation) {
+  IREE_ASSERT_ARGUMENT(invocation);
+  return iree_status_is_ok(invocation->status) ? invocation->outputs : NULL;
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_invocation_poll(iree_vm_invocation_t* invocation) {
+  IREE_ASSERT_ARGUMENT(invocation);
+  if (iree_vm_invocation_is_pending(invocation)) {
+    iree_status_t wait_status =
+        iree_vm_wait_request_await(&invocation->wait, IREE_TIME_INFINITE_PAST);
+    if (iree_status_is_ok(wait_status)) {
+      iree_vm_wait_request_reset(&invocation->wait);
+      iree_vm_invocation_run(invocation, /*is_resume=*/true);
+    } else if (iree_status_is_deadline_exceeded(wait_status)) {
+      iree_status_ignore(wait_status);
+    } else {
+      iree_vm_invocation_complete(invocation, wait_status);
+    }
+  }
+  return iree_vm_invocation_query_status(invocation);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_invocation_await(
+    iree_vm_invocation_t* invocation, iree_time_t deadline) {
+  IREE_ASSERT_ARGUMENT(invocation);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  while (iree_vm_invocation_is_pending(invocation)) {
+    iree_status_t wait_status =
+        iree_vm_wait_request_await(&invocation->wait, deadline);
+    if (iree_status_is_ok(wait_status)) {
+      iree_vm_wait_request_reset(&invocation->wait);
+      iree_vm_invocation_run(invocation, /*is_resume=*/true);
+    } else if (iree_status_is_deadline_exceeded(wait_status)) {
+      IREE_TRACE_ZONE_END(z0);
+      return wait_status;
+    } else {
+      iree_vm_invocation_complete(invocation, wait_status);
+    }
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return iree_vm_invocation_query_status(invocation);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_invocation_abort(iree_vm_invocation_t* invocation) {
+  IREE_ASSERT_ARGUMENT(invocation);
+  if (iree_vm_invocation_is_pending(invocation)) {
+    iree_vm_invocation_complete(
+        invocation, iree_status_from_code(IREE_STATUS_ABORTED));
+  }
+  return iree_ok_status();
+}
+
+//===----------------------------------------------------------------------===//
+// iree_vm_prepared_call_t
+//===----------------------------------------------------------------------===//
+
+struct iree_vm_prepared_call {
+  iree_atomic_ref_count_t ref_count;
+  iree_allocator_t allocator;
+
+  // Context the call executes within; retained so that the function and its
+  // signature remain valid.
+  iree_vm_context_t* context;
+  iree_string_view_t cconv_arguments;
+  iree_string_view_t cconv_results;
+
+  // Stack reused across invocations. Dropped after a failed invocation (as it
+  // may still contain frames) and reallocated on the next invocation.
+  iree_vm_stack_t* stack;
+
+  // ABI call with argument and result storage allocated inline after the
+  // prepared call. Both buffers contain only NULL refs between invocations.
+  iree_vm_function_call_t call;
+};
+
+// Releases any refs remaining in the ABI |storage| for |cconv_fragment| such as
+// arguments borrowed (not consumed) by native callees or results that were not
+// marshaled to an output list.
+static void iree_vm_prepared_call_release_refs(
+    iree_string_view_t cconv_fragment, iree_byte_span_t storage) {
+  uint8_t* p = storage.data;
+  for (iree_host_size_t i = 0; i < cconv_fragment.size; ++i) {
+    switch (cconv_fragment.data[i]) {
+      case IREE_VM_CCONV_TYPE_INT32:
+        p += sizeof(int32_t);
+        break;
+      case IREE_VM_CCONV_TYPE_INT64:
+        p += sizeof(int64_t);
+        break;
+      case IREE_VM_CCONV_TYPE_REF:
+        iree_vm_ref_release((iree_vm_ref_t*)p);
+        p += sizeof(iree_vm_ref_t);
+        break;
+    }
+  }
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_prepared_call_create(
+    iree_vm_context_t* context, iree_vm_function_t function,
+    const iree_vm_invocation_policy_t* policy, iree_allocator_t allocator,
+    iree_vm_prepared_call_t** out_prepared_call) {
+  IREE_ASSERT_ARGUMENT(context);
+  IREE_ASSERT_ARGUMENT(out_prepared_call);
+  *out_prepared_call = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_vm_function_signature_t signature =
+      iree_vm_function_signature(&function);
+  iree_string_view_t cconv_arguments = iree_string_view_empty();
+  iree_string_view_t cconv_results = iree_string_view_empty();
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_get_cconv_fragments(
+              &signature, &cconv_arguments, &cconv_results));
+  if (iree_vm_function_call_is_variadic_cconv(cconv_arguments)) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                            "variadic arguments are not supported");
+  }
+  iree_host_size_t argument_size = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_compute_cconv_fragment_size(
+              cconv_arguments, /*segment_size_list=*/NULL, &argument_size));
+  iree_host_size_t result_size = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_compute_cconv_fragment_size(
+              cconv_results, /*segment_size_list=*/NULL, &result_size));
+
+  iree_host_size_t header_size =
+      iree_math_align(sizeof(iree_vm_prepared_call_t), iree_max_align_t);
+  iree_host_size_t argument_storage_size =
+      iree_math_align(argument_size, iree_max_align_t);
+  iree_host_size_t total_size =
+      header_size + argument_storage_size + result_size;
+  iree_vm_prepared_call_t* prepared_call = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(allocator, total_size, (void**)&prepared_call));
+  memset(prepared_call, 0, total_size);
+  iree_atomic_ref_count_init(&prepared_call->ref_count);
+  prepared_call->allocator = allocator;
+  prepared_call->context = context;
+  iree_vm_context_retain(context);
+  prepared_call->cconv_arguments = cconv_arguments;
+  prepared_call->cconv_results = cconv_results;
+  prepared_call->call.function = function;
+  prepared_call->call.arguments =
+      iree_make_byte_span((uint8_t*)prepared_call + header_size, argument_size);
+  prepared_call->call.results = iree_make_byte_span(
+      (uint8_t*)prepared_call + header_size + argument_storage_size,
+      result_size);
+
+  iree_status_t status =
+      iree_vm_stack_allocate(iree_vm_context_state_resolver(context),
+                             allocator, &prepared_call->stack);
+  if (iree_status_is_ok(status)) {
+    *out_prepared_call = prepared_call;
+  } else {
+    iree_vm_prepared_call_release(prepared_call);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static void iree_vm_prepared_call_destroy(
+    iree_vm_prepared_call_t* prepared_call) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  if (prepared_call->stack) {
+    iree_vm_stack_free(prepared_call->stack);
+  }
+  iree_vm_context_release(prepared_call->context);
+  iree_allocator_free(prepared_call->allocator, prepared_call);
+  IREE_TRACE_ZONE_END(z0);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_prepared_call_retain(iree_vm_prepared_call_t* prepared_call) {
+  IREE_ASSERT_ARGUMENT(prepared_call);
+  iree_atomic_ref_count_inc(&prepared_call->ref_count);
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_prepared_call_release(iree_vm_prepared_call_t* prepared_call) {
+  if (prepared_call &&
+      iree_atomic_ref_count_dec(&prepared_call->ref_count) == 1) {
+    iree_vm_prepared_call_destroy(prepared_call);
+  }
+  return iree_ok_status();
+}
+
+// Invokes |prepared_call| once, leaving the ABI storage clear of refs.
+static iree_status_t iree_vm_prepared_call_invoke_one(
+    iree_vm_prepared_call_t* prepared_call, iree_vm_list_t* inputs,
+    iree_vm_list_t* outputs) {
+  if (IREE_UNLIKELY(!prepared_call->stack)) {
+    IREE_RETURN_IF_ERROR(iree_vm_stack_allocate(
+        iree_vm_context_state_resolver(prepared_call->context),
+        prepared_call->allocator, &prepared_call->stack));
+  }
+
+  iree_vm_function_call_t* call = &prepared_call->call;
+  iree_status_t status = iree_vm_invoke_marshal_inputs(
+      prepared_call->cconv_arguments, inputs, call->arguments);
+  if (iree_status_is_ok(status)) {
+    iree_vm_module_t* module = call->function.module;
+    iree_vm_execution_result_t result;
+    status = module->begin_call(module->self, prepared_call->stack, call,
+                                &result);
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_invoke_marshal_outputs(prepared_call->cconv_results,
+                                            call->results, outputs);
+  }
+
+  iree_vm_prepared_call_release_refs(prepared_call->cconv_arguments,
+                                     call->arguments);
+  iree_vm_prepared_call_release_refs(prepared_call->cconv_results,
+                                     call->results);
+  if (IREE_UNLIKELY(!iree_status_is_ok(status))) {
+    iree_vm_stack_free(prepared_call->stack);
+    prepared_call->stack = NULL;
+  }
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_prepared_call_invoke(
+    iree_vm_prepared_call_t* prepared_call, iree_vm_list_t* inputs,
+    iree_vm_list_t* outputs) {
+  IREE_ASSERT_ARGUMENT(prepared_call);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_status_t status =
+      iree_vm_prepared_call_invoke_one(prepared_call, inputs, outputs);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_prepared_call_invoke_batch(
+    iree_vm_prepared_call_t* prepared_call, iree_host_size_t count,
+    iree_vm_list_t* const* inputs, iree_vm_list_t* const* outputs) {
+  IREE_ASSERT_ARGUMENT(prepared_call);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < count; ++i) {
+    status = iree_vm_prepared_call_invoke_one(
+        prepared_call, inputs ? inputs[i] : NULL, outputs ? outputs[i] : NULL);
+    if (IREE_UNLIKELY(!iree_status_is_ok(status))) {
+      status = iree_status_annotate_f(status, "while invoking batch item %zu",
+                                      i);
+      break;
+    }
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
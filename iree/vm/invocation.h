@@ -28,6 +28,7 @@ extern "C" {
 
 typedef struct iree_vm_invocation iree_vm_invocation_t;
 typedef struct iree_vm_invocation_policy iree_vm_invocation_policy_t;
+typedef struct iree_vm_prepared_call iree_vm_prepared_call_t;
 
 // Synchronously invokes a function in the VM.
 //
@@ -47,7 +48,22 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_invoke(
     const iree_vm_invocation_policy_t* policy, iree_vm_list_t* inputs,
     iree_vm_list_t* outputs, iree_allocator_t allocator);
 
-// TODO(benvanik): document and implement.
+// Creates an asynchronous invocation of |function| and begins executing it on
+// the calling thread until it either completes or yields.
+//
+// Invocations own a VM stack that persists across yields: imports that need to
+// wait (such as on a HAL semaphore) return control to the caller instead of
+// blocking the thread. Pending invocations are continued with
+// iree_vm_invocation_poll or iree_vm_invocation_await on any thread, allowing
+// many in-flight invocations to share a small number of threads. Invocations
+// are not thread-safe and must only be polled/awaited by one thread at a time.
+//
+// |inputs| is used to pass values and objects into the target function and must
+// match the signature defined by the compiled function. List ownership remains
+// with the caller and the list is not referenced after this call returns.
+//
+// Errors during setup are returned directly while errors raised by the
+// function are reported by iree_vm_invocation_query_status.
 IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_invocation_create(
     iree_vm_context_t* context, iree_vm_function_t function,
     const iree_vm_invocation_policy_t* policy, const iree_vm_list_t* inputs,
@@ -80,7 +96,16 @@ iree_vm_invocation_query_status(iree_vm_invocation_t* invocation);
 IREE_API_EXPORT const iree_vm_list_t* IREE_API_CALL
 iree_vm_invocation_output(iree_vm_invocation_t* invocation);
 
+// Resumes the invocation if the condition it last yielded on has been
+// satisfied, running on the calling thread until it either completes or yields
+// again. Never blocks waiting for the condition.
+//
+// Returns iree_vm_invocation_query_status after any execution performed.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_invocation_poll(iree_vm_invocation_t* invocation);
+
 // Blocks the caller until the invocation completes (successfully or otherwise).
+// Execution of the invocation continues on the calling thread.
 //
 // Returns IREE_STATUS_DEADLINE_EXCEEDED if |deadline| elapses before the
 // invocation completes and otherwise returns iree_vm_invocation_query_status.
@@ -88,10 +113,54 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_invocation_await(
     iree_vm_invocation_t* invocation, iree_time_t deadline);
 
 // Attempts to abort the invocation if it is in-flight.
-// A no-op if the invocation has already completed.
+// A no-op if the invocation has already completed. Aborted invocations release
+// their stack and report IREE_STATUS_ABORTED.
 IREE_API_EXPORT iree_status_t IREE_API_CALL
 iree_vm_invocation_abort(iree_vm_invocation_t* invocation);
 
+//===----------------------------------------------------------------------===//
+// iree_vm_prepared_call_t
+//===----------------------------------------------------------------------===//
+
+// Prepares |function| for repeated synchronous invocation.
+//
+// The calling convention is parsed and the ABI argument/result storage and VM
+// stack are allocated once when the call is prepared and reused by every
+// invocation such that invoking the call performs no allocations of its own
+// in the steady state (the callee and the output lists may still allocate).
+//
+// Prepared calls are not thread-safe; callers invoking the same function from
+// multiple threads should prepare one call per thread.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_prepared_call_create(
+    iree_vm_context_t* context, iree_vm_function_t function,
+    const iree_vm_invocation_policy_t* policy, iree_allocator_t allocator,
+    iree_vm_prepared_call_t** out_prepared_call);
+
+// Retains the given |prepared_call| for the caller.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_prepared_call_retain(iree_vm_prepared_call_t* prepared_call);
+
+// Releases the given |prepared_call| from the caller.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_prepared_call_release(iree_vm_prepared_call_t* prepared_call);
+
+// Synchronously invokes the prepared function with the same semantics as
+// iree_vm_invoke.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_prepared_call_invoke(
+    iree_vm_prepared_call_t* prepared_call, iree_vm_list_t* inputs,
+    iree_vm_list_t* outputs);
+
+// Synchronously invokes the prepared function once for each of |count| input
+// sets in order. |inputs| and |outputs| are arrays of |count| lists that are
+// used as with iree_vm_invoke. Either array may be NULL to pass NULL lists to
+// all invocations of functions without arguments or results, respectively.
+//
+// Stops at and returns the first failure. Outputs of all prior invocations in
+// the batch remain valid.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_prepared_call_invoke_batch(
+    iree_vm_prepared_call_t* prepared_call, iree_host_size_t count,
+    iree_vm_list_t* const* inputs, iree_vm_list_t* const* outputs);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -0,0 +1,130 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the per-call overhead of the invocation APIs by calling a trivial
+// native (i32)->i32 function such that nearly all time is spent marshaling.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/vm/context.h"
+#include "iree/vm/instance.h"
+#include "iree/vm/invocation.h"
+#include "iree/vm/list.h"
+#include "iree/vm/native_module_test.h"
+
+namespace {
+
+class InvocationFixture {
+ public:
+  InvocationFixture() {
+    IREE_CHECK_OK(iree_vm_instance_create(iree_allocator_system(), &instance_));
+    iree_vm_module_t* module = nullptr;
+    IREE_CHECK_OK(module_a_create(iree_allocator_system(), &module));
+    IREE_CHECK_OK(iree_vm_context_create_with_modules(
+        instance_, &module, 1, iree_allocator_system(), &context_));
+    iree_vm_module_release(module);
+    IREE_CHECK_OK(iree_vm_context_resolve_function(
+        context_, iree_make_cstring_view("module_a.add_1"), &function_));
+  }
+
+  ~InvocationFixture() {
+    iree_vm_context_release(context_);
+    iree_vm_instance_release(instance_);
+  }
+
+  iree_vm_context_t* context() const { return context_; }
+  iree_vm_function_t function() const { return function_; }
+
+  // Creates an input list holding |value| and an empty output list.
+  static void CreateLists(int32_t value, iree_vm_list_t** out_inputs,
+                          iree_vm_list_t** out_outputs) {
+    IREE_CHECK_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                      iree_allocator_system(), out_inputs));
+    iree_vm_value_t arg0 = iree_vm_value_make_i32(value);
+    IREE_CHECK_OK(iree_vm_list_push_value(*out_inputs, &arg0));
+    IREE_CHECK_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                      iree_allocator_system(), out_outputs));
+  }
+
+ private:
+  iree_vm_instance_t* instance_ = nullptr;
+  iree_vm_context_t* context_ = nullptr;
+  iree_vm_function_t function_;
+};
+
+// Baseline: parses the signature and initializes a stack on every call.
+static void BM_Invoke(benchmark::State& state) {
+  InvocationFixture fixture;
+  iree_vm_list_t* inputs = nullptr;
+  iree_vm_list_t* outputs = nullptr;
+  InvocationFixture::CreateLists(42, &inputs, &outputs);
+  while (state.KeepRunning()) {
+    IREE_CHECK_OK(iree_vm_invoke(fixture.context(), fixture.function(),
+                                 /*policy=*/nullptr, inputs, outputs,
+                                 iree_allocator_system()));
+  }
+  iree_vm_list_release(inputs);
+  iree_vm_list_release(outputs);
+}
+BENCHMARK(BM_Invoke);
+
+static void BM_PreparedCallInvoke(benchmark::State& state) {
+  InvocationFixture fixture;
+  iree_vm_prepared_call_t* prepared_call = nullptr;
+  IREE_CHECK_OK(iree_vm_prepared_call_create(
+      fixture.context(), fixture.function(), /*policy=*/nullptr,
+      iree_allocator_system(), &prepared_call));
+  iree_vm_list_t* inputs = nullptr;
+  iree_vm_list_t* outputs = nullptr;
+  InvocationFixture::CreateLists(42, &inputs, &outputs);
+  while (state.KeepRunning()) {
+    IREE_CHECK_OK(
+        iree_vm_prepared_call_invoke(prepared_call, inputs, outputs));
+  }
+  iree_vm_list_release(inputs);
+  iree_vm_list_release(outputs);
+  iree_vm_prepared_call_release(prepared_call);
+}
+BENCHMARK(BM_PreparedCallInvoke);
+
+// Reports the time per item in the batch.
+static void BM_PreparedCallInvokeBatch(benchmark::State& state) {
+  InvocationFixture fixture;
+  iree_vm_prepared_call_t* prepared_call = nullptr;
+  IREE_CHECK_OK(iree_vm_prepared_call_create(
+      fixture.context(), fixture.function(), /*policy=*/nullptr,
+      iree_allocator_system(), &prepared_call));
+  const int64_t batch_size = state.range(0);
+  std::vector<iree_vm_list_t*> inputs(batch_size);
+  std::vector<iree_vm_list_t*> outputs(batch_size);
+  for (int64_t i = 0; i < batch_size; ++i) {
+    InvocationFixture::CreateLists(static_cast<int32_t>(i), &inputs[i],
+                                   &outputs[i]);
+  }
+  while (state.KeepRunningBatch(batch_size)) {
+    IREE_CHECK_OK(iree_vm_prepared_call_invoke_batch(
+        prepared_call, batch_size, inputs.data(), outputs.data()));
+  }
+  for (int64_t i = 0; i < batch_size; ++i) {
+    iree_vm_list_release(inputs[i]);
+    iree_vm_list_release(outputs[i]);
+  }
+  iree_vm_prepared_call_release(prepared_call);
+}
+BENCHMARK(BM_PreparedCallInvokeBatch)->Arg(1)->Arg(16)->Arg(256);
+
+}  // namespace
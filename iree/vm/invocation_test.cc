@@ -0,0 +1,516 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iree/vm/invocation.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+#include "iree/vm/bytecode_module.h"
+#include "iree/vm/context.h"
+#include "iree/vm/instance.h"
+#include "iree/vm/invocation_test_module.h"
+#include "iree/vm/list.h"
+#include "iree/vm/native_module.h"
+#include "iree/vm/stack.h"
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// async_module
+//===----------------------------------------------------------------------===//
+// Exports a function that waits on a process-wide gate before adding 1 to its
+// argument. The wait is issued through iree_vm_stack_wait so that the function
+// yields when called from an asynchronous invocation.
+
+static std::atomic<bool> gate_open = {false};
+static std::atomic<int> call_count = {0};
+
+static iree_status_t gate_wait(const iree_vm_wait_request_t* request,
+                               iree_time_t deadline_ns) {
+  while (!gate_open.load()) {
+    if (iree_time_now() >= deadline_ns) {
+      return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+    }
+    std::this_thread::yield();
+  }
+  return iree_ok_status();
+}
+
+// vm.import @async.wait_add_1(%arg0 : i32) -> i32
+static iree_status_t async_wait_add_1(iree_vm_stack_t* stack, void* module,
+                                      void* module_state, int32_t arg0,
+                                      int32_t* out_ret0) {
+  ++call_count;
+  if (!gate_open.load()) {
+    iree_vm_wait_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.wait_fn = gate_wait;
+    bool yielded = false;
+    IREE_RETURN_IF_ERROR(iree_vm_stack_wait(stack, &request, &yielded));
+    if (yielded) return iree_ok_status();
+  }
+  *out_ret0 = arg0 + 1;
+  return iree_ok_status();
+}
+
+// vm.import @async.nested_wait_add_1(%arg0 : i32) -> i32
+// Calls wait_add_1 from native code, which cannot be suspended.
+static iree_status_t async_nested_wait_add_1(iree_vm_stack_t* stack,
+                                             void* module, void* module_state,
+                                             int32_t arg0, int32_t* out_ret0) {
+  iree_vm_function_t function = iree_vm_stack_current_frame(stack)->function;
+  function.ordinal = 1;  // wait_add_1
+  iree_vm_function_call_t call;
+  memset(&call, 0, sizeof(call));
+  call.function = function;
+  call.arguments = iree_make_byte_span(&arg0, sizeof(arg0));
+  call.results = iree_make_byte_span(out_ret0, sizeof(*out_ret0));
+  iree_vm_execution_result_t result;
+  IREE_RETURN_IF_ERROR(function.module->begin_call(function.module->self,
+                                                   stack, &call, &result));
+  EXPECT_EQ(0, result.flags & IREE_VM_EXECUTION_RESULT_FLAG_YIELDED);
+  return iree_ok_status();
+}
+
+typedef iree_status_t (*call_i32_i32_t)(iree_vm_stack_t* stack,
+                                        void* module_ptr, void* module_state,
+                                        int32_t arg0, int32_t* out_ret0);
+
+static iree_status_t call_shim_i32_i32(iree_vm_stack_t* stack,
+                                       const iree_vm_function_call_t* call,
+                                       call_i32_i32_t target_fn, void* module,
+                                       void* module_state,
+                                       iree_vm_execution_result_t* out_result) {
+  const int32_t* arg0 = (const int32_t*)call->arguments.data;
+  int32_t* ret0 = (int32_t*)call->results.data;
+  return target_fn(stack, module, module_state, *arg0, ret0);
+}
+
+static const iree_vm_native_export_descriptor_t async_module_exports_[] = {
+    {iree_make_cstring_view("nested_wait_add_1"),
+     iree_make_cstring_view("0i_i"), 0, NULL},
+    {iree_make_cstring_view("wait_add_1"), iree_make_cstring_view("0i_i"), 0,
+     NULL},
+};
+static const iree_vm_native_function_ptr_t async_module_funcs_[] = {
+    {(iree_vm_native_function_shim_t)call_shim_i32_i32,
+     (iree_vm_native_function_target_t)async_nested_wait_add_1},
+    {(iree_vm_native_function_shim_t)call_shim_i32_i32,
+     (iree_vm_native_function_target_t)async_wait_add_1},
+};
+static_assert(IREE_ARRAYSIZE(async_module_funcs_) ==
+                  IREE_ARRAYSIZE(async_module_exports_),
+              "function pointer table must be 1:1 with exports");
+static const iree_vm_native_module_descriptor_t async_module_descriptor_ = {
+    iree_make_cstring_view("async"),
+    0,
+    NULL,
+    IREE_ARRAYSIZE(async_module_exports_),
+    async_module_exports_,
+    IREE_ARRAYSIZE(async_module_funcs_),
+    async_module_funcs_,
+    0,
+    NULL,
+};
+
+static iree_status_t async_module_create(iree_allocator_t allocator,
+                                         iree_vm_module_t** out_module) {
+  iree_vm_module_t interface;
+  IREE_RETURN_IF_ERROR(iree_vm_module_initialize(&interface, NULL));
+  return iree_vm_native_module_create(&interface, &async_module_descriptor_,
+                                      allocator, out_module);
+}
+
+class VMInvocationTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    gate_open = false;
+    call_count = 0;
+
+    IREE_CHECK_OK(iree_vm_instance_create(iree_allocator_system(), &instance_));
+    iree_vm_module_t* module = nullptr;
+    IREE_CHECK_OK(async_module_create(iree_allocator_system(), &module));
+    IREE_CHECK_OK(iree_vm_context_create_with_modules(
+        instance_, &module, 1, iree_allocator_system(), &context_));
+    iree_vm_module_release(module);
+    IREE_CHECK_OK(iree_vm_context_resolve_function(
+        context_, iree_make_cstring_view("async.wait_add_1"), &function_));
+
+    IREE_CHECK_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                      iree_allocator_system(), &inputs_));
+    iree_vm_value_t arg0 = iree_vm_value_make_i32(42);
+    IREE_CHECK_OK(iree_vm_list_push_value(inputs_, &arg0));
+  }
+
+  virtual void TearDown() {
+    iree_vm_list_release(inputs_);
+    iree_vm_context_release(context_);
+    iree_vm_instance_release(instance_);
+  }
+
+  iree_vm_invocation_t* CreateInvocation() {
+    iree_vm_invocation_t* invocation = nullptr;
+    IREE_CHECK_OK(iree_vm_invocation_create(context_, function_,
+                                            /*policy=*/nullptr, inputs_,
+                                            iree_allocator_system(),
+                                            &invocation));
+    return invocation;
+  }
+
+  static int32_t GetResult(iree_vm_invocation_t* invocation,
+                           iree_host_size_t i = 0) {
+    const iree_vm_list_t* outputs = iree_vm_invocation_output(invocation);
+    EXPECT_NE(nullptr, outputs);
+    if (!outputs) return -1;
+    iree_vm_value_t value;
+    IREE_CHECK_OK(iree_vm_list_get_value((iree_vm_list_t*)outputs, i, &value));
+    return value.i32;
+  }
+
+  iree_vm_instance_t* instance_ = nullptr;
+  iree_vm_context_t* context_ = nullptr;
+  iree_vm_function_t function_;
+  iree_vm_list_t* inputs_ = nullptr;
+};
+
+// Synchronous invocations have no way to resume and must block inline.
+TEST_F(VMInvocationTest, SyncInvokeBlocks) {
+  std::thread signaler([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    gate_open = true;
+  });
+  iree_vm_list_t* outputs = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                     iree_allocator_system(), &outputs));
+  IREE_EXPECT_OK(iree_vm_invoke(context_, function_, /*policy=*/nullptr,
+                                inputs_, outputs, iree_allocator_system()));
+  signaler.join();
+  iree_vm_value_t ret0;
+  IREE_ASSERT_OK(iree_vm_list_get_value(outputs, 0, &ret0));
+  EXPECT_EQ(43, ret0.i32);
+  EXPECT_EQ(1, call_count.load());
+  iree_vm_list_release(outputs);
+}
+
+TEST_F(VMInvocationTest, CompletesWithoutYielding) {
+  gate_open = true;
+  iree_vm_invocation_t* invocation = CreateInvocation();
+  IREE_EXPECT_OK(iree_vm_invocation_query_status(invocation));
+  EXPECT_EQ(43, GetResult(invocation));
+  EXPECT_EQ(1, call_count.load());
+  iree_vm_invocation_release(invocation);
+}
+
+TEST_F(VMInvocationTest, YieldAndPoll) {
+  iree_vm_invocation_t* invocation = CreateInvocation();
+  EXPECT_EQ(IREE_STATUS_UNAVAILABLE,
+            iree_status_consume_code(iree_vm_invocation_query_status(
+                invocation)));
+  EXPECT_EQ(nullptr, iree_vm_invocation_output(invocation));
+
+  // Polling while the wait is unsatisfied must not re-run the call.
+  EXPECT_EQ(IREE_STATUS_UNAVAILABLE,
+            iree_status_consume_code(iree_vm_invocation_poll(invocation)));
+  EXPECT_EQ(1, call_count.load());
+
+  gate_open = true;
+  IREE_EXPECT_OK(iree_vm_invocation_poll(invocation));
+  EXPECT_EQ(43, GetResult(invocation));
+  EXPECT_EQ(2, call_count.load());
+  iree_vm_invocation_release(invocation);
+}
+
+TEST_F(VMInvocationTest, AwaitDeadline) {
+  iree_vm_invocation_t* invocation = CreateInvocation();
+  EXPECT_EQ(IREE_STATUS_DEADLINE_EXCEEDED,
+            iree_status_consume_code(iree_vm_invocation_await(
+                invocation, iree_time_now() + 1000000)));
+  EXPECT_EQ(IREE_STATUS_UNAVAILABLE,
+            iree_status_consume_code(iree_vm_invocation_query_status(
+                invocation)));
+
+  std::thread signaler([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    gate_open = true;
+  });
+  IREE_EXPECT_OK(
+      iree_vm_invocation_await(invocation, IREE_TIME_INFINITE_FUTURE));
+  signaler.join();
+  EXPECT_EQ(43, GetResult(invocation));
+  iree_vm_invocation_release(invocation);
+}
+
+TEST_F(VMInvocationTest, Abort) {
+  iree_vm_invocation_t* invocation = CreateInvocation();
+  IREE_EXPECT_OK(iree_vm_invocation_abort(invocation));
+  EXPECT_EQ(IREE_STATUS_ABORTED,
+            iree_status_consume_code(iree_vm_invocation_query_status(
+                invocation)));
+  EXPECT_EQ(nullptr, iree_vm_invocation_output(invocation));
+
+  // Aborted invocations stay aborted even once the wait is satisfied.
+  gate_open = true;
+  EXPECT_EQ(IREE_STATUS_ABORTED,
+            iree_status_consume_code(iree_vm_invocation_poll(invocation)));
+  EXPECT_EQ(1, call_count.load());
+  iree_vm_invocation_release(invocation);
+}
+
+// Native callers cannot be suspended so waits in functions they call block.
+TEST_F(VMInvocationTest, NestedCallBlocks) {
+  iree_vm_function_t function;
+  IREE_ASSERT_OK(iree_vm_context_resolve_function(
+      context_, iree_make_cstring_view("async.nested_wait_add_1"), &function));
+  std::thread signaler([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    gate_open = true;
+  });
+  iree_vm_invocation_t* invocation = nullptr;
+  IREE_ASSERT_OK(iree_vm_invocation_create(context_, function,
+                                           /*policy=*/nullptr, inputs_,
+                                           iree_allocator_system(),
+                                           &invocation));
+  signaler.join();
+  IREE_EXPECT_OK(iree_vm_invocation_query_status(invocation));
+  EXPECT_EQ(43, GetResult(invocation));
+  EXPECT_EQ(1, call_count.load());
+  iree_vm_invocation_release(invocation);
+}
+
+// Releasing a pending invocation must tear down its suspended stack.
+TEST_F(VMInvocationTest, ReleasePending) {
+  iree_vm_invocation_t* invocation = CreateInvocation();
+  iree_vm_invocation_release(invocation);
+}
+
+// Many invocations can be in-flight at once and driven from one thread.
+TEST_F(VMInvocationTest, ManyPending) {
+  static const int kInvocationCount = 1000;
+  std::vector<iree_vm_invocation_t*> invocations;
+  for (int i = 0; i < kInvocationCount; ++i) {
+    invocations.push_back(CreateInvocation());
+  }
+  gate_open = true;
+  for (auto* invocation : invocations) {
+    IREE_EXPECT_OK(iree_vm_invocation_poll(invocation));
+    EXPECT_EQ(43, GetResult(invocation));
+    iree_vm_invocation_release(invocation);
+  }
+  EXPECT_EQ(2 * kInvocationCount, call_count.load());
+}
+
+// Prepared calls can be invoked repeatedly with new inputs.
+TEST_F(VMInvocationTest, PreparedCallReuse) {
+  gate_open = true;
+  iree_vm_prepared_call_t* prepared_call = nullptr;
+  IREE_ASSERT_OK(iree_vm_prepared_call_create(context_, function_,
+                                              /*policy=*/nullptr,
+                                              iree_allocator_system(),
+                                              &prepared_call));
+  iree_vm_list_t* outputs = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                     iree_allocator_system(), &outputs));
+  for (int32_t i = 0; i < 3; ++i) {
+    iree_vm_value_t arg0 = iree_vm_value_make_i32(i);
+    IREE_ASSERT_OK(iree_vm_list_set_value(inputs_, 0, &arg0));
+    IREE_ASSERT_OK(
+        iree_vm_prepared_call_invoke(prepared_call, inputs_, outputs));
+    iree_vm_value_t ret0;
+    IREE_ASSERT_OK(iree_vm_list_get_value(outputs, 0, &ret0));
+    EXPECT_EQ(i + 1, ret0.i32);
+  }
+  EXPECT_EQ(3, call_count.load());
+  iree_vm_list_release(outputs);
+  iree_vm_prepared_call_release(prepared_call);
+}
+
+// Batches invoke the function once per input set in order.
+TEST_F(VMInvocationTest, PreparedCallBatch) {
+  gate_open = true;
+  iree_vm_prepared_call_t* prepared_call = nullptr;
+  IREE_ASSERT_OK(iree_vm_prepared_call_create(context_, function_,
+                                              /*policy=*/nullptr,
+                                              iree_allocator_system(),
+                                              &prepared_call));
+  static const int kBatchSize = 4;
+  std::vector<iree_vm_list_t*> inputs(kBatchSize);
+  std::vector<iree_vm_list_t*> outputs(kBatchSize);
+  for (int i = 0; i < kBatchSize; ++i) {
+    IREE_ASSERT_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                       iree_allocator_system(), &inputs[i]));
+    iree_vm_value_t arg0 = iree_vm_value_make_i32(i * 10);
+    IREE_ASSERT_OK(iree_vm_list_push_value(inputs[i], &arg0));
+    IREE_ASSERT_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                       iree_allocator_system(), &outputs[i]));
+  }
+  IREE_ASSERT_OK(iree_vm_prepared_call_invoke_batch(
+      prepared_call, kBatchSize, inputs.data(), outputs.data()));
+  for (int i = 0; i < kBatchSize; ++i) {
+    iree_vm_value_t ret0;
+    IREE_ASSERT_OK(iree_vm_list_get_value(outputs[i], 0, &ret0));
+    EXPECT_EQ(i * 10 + 1, ret0.i32);
+    iree_vm_list_release(inputs[i]);
+    iree_vm_list_release(outputs[i]);
+  }
+  EXPECT_EQ(kBatchSize, call_count.load());
+  iree_vm_prepared_call_release(prepared_call);
+}
+
+// Failed invocations do not prevent the prepared call from being reused.
+TEST_F(VMInvocationTest, PreparedCallAfterFailure) {
+  gate_open = true;
+  iree_vm_prepared_call_t* prepared_call = nullptr;
+  IREE_ASSERT_OK(iree_vm_prepared_call_create(context_, function_,
+                                              /*policy=*/nullptr,
+                                              iree_allocator_system(),
+                                              &prepared_call));
+  iree_vm_list_t* outputs = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                     iree_allocator_system(), &outputs));
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(iree_vm_prepared_call_invoke(
+                prepared_call, /*inputs=*/nullptr, outputs)));
+  EXPECT_EQ(0, call_count.load());
+  IREE_ASSERT_OK(
+      iree_vm_prepared_call_invoke(prepared_call, inputs_, outputs));
+  iree_vm_value_t ret0;
+  IREE_ASSERT_OK(iree_vm_list_get_value(outputs, 0, &ret0));
+  EXPECT_EQ(43, ret0.i32);
+  iree_vm_list_release(outputs);
+  iree_vm_prepared_call_release(prepared_call);
+}
+
+//===----------------------------------------------------------------------===//
+// Bytecode yields
+//===----------------------------------------------------------------------===//
+// Calls into invocation_test.mlir, which yields with vm.yield and calls the
+// waiting async_module import from nested bytecode frames.
+
+class VMInvocationBytecodeTest : public VMInvocationTest {
+ protected:
+  virtual void SetUp() {
+    VMInvocationTest::SetUp();
+    iree_vm_context_release(context_);
+
+    const auto* module_file_toc = iree::vm::invocation_test_module_create();
+    iree_vm_module_t* modules[2] = {nullptr, nullptr};
+    IREE_CHECK_OK(async_module_create(iree_allocator_system(), &modules[0]));
+    IREE_CHECK_OK(iree_vm_bytecode_module_create(
+        iree_const_byte_span_t{
+            reinterpret_cast<const uint8_t*>(module_file_toc->data),
+            module_file_toc->size},
+        iree_allocator_null(), iree_allocator_system(), &modules[1]));
+    IREE_CHECK_OK(iree_vm_context_create_with_modules(
+        instance_, modules, IREE_ARRAYSIZE(modules), iree_allocator_system(),
+        &context_));
+    iree_vm_module_release(modules[0]);
+    iree_vm_module_release(modules[1]);
+  }
+
+  iree_vm_invocation_t* CreateInvocation(const char* function_name) {
+    iree_vm_function_t function;
+    IREE_CHECK_OK(iree_vm_context_resolve_function(
+        context_, iree_make_cstring_view(function_name), &function));
+    iree_vm_invocation_t* invocation = nullptr;
+    IREE_CHECK_OK(iree_vm_invocation_create(context_, function,
+                                            /*policy=*/nullptr, inputs_,
+                                            iree_allocator_system(),
+                                            &invocation));
+    return invocation;
+  }
+};
+
+// Synchronous invocations ignore voluntary yields.
+TEST_F(VMInvocationBytecodeTest, SyncInvokeIgnoresYield) {
+  iree_vm_function_t function;
+  IREE_ASSERT_OK(iree_vm_context_resolve_function(
+      context_, iree_make_cstring_view("invocation_test.yield_add_1"),
+      &function));
+  iree_vm_list_t* outputs = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(/*element_type=*/nullptr, 1,
+                                     iree_allocator_system(), &outputs));
+  IREE_EXPECT_OK(iree_vm_invoke(context_, function, /*policy=*/nullptr,
+                                inputs_, outputs, iree_allocator_system()));
+  iree_vm_value_t ret0;
+  IREE_ASSERT_OK(iree_vm_list_get_value(outputs, 0, &ret0));
+  EXPECT_EQ(43, ret0.i32);
+  iree_vm_list_release(outputs);
+}
+
+// vm.yield suspends the invocation and resuming continues after the yield.
+TEST_F(VMInvocationBytecodeTest, YieldOp) {
+  iree_vm_invocation_t* invocation =
+      CreateInvocation("invocation_test.yield_add_1");
+  EXPECT_EQ(IREE_STATUS_UNAVAILABLE,
+            iree_status_consume_code(iree_vm_invocation_query_status(
+                invocation)));
+  EXPECT_EQ(nullptr, iree_vm_invocation_output(invocation));
+  IREE_EXPECT_OK(iree_vm_invocation_poll(invocation));
+  EXPECT_EQ(43, GetResult(invocation));
+  iree_vm_invocation_release(invocation);
+}
+
+// An import that waits suspends all of the bytecode frames calling it. Resuming
+// reissues only the pending import call: the entry function does not run again
+// and the second import call sees the result of the first.
+TEST_F(VMInvocationBytecodeTest, ImportYieldResumesAtCall) {
+  iree_vm_invocation_t* invocation =
+      CreateInvocation("invocation_test.increment_and_wait_add_2");
+  EXPECT_EQ(IREE_STATUS_UNAVAILABLE,
+            iree_status_consume_code(iree_vm_invocation_query_status(
+                invocation)));
+  EXPECT_EQ(1, call_count.load());
+
+  EXPECT_EQ(IREE_STATUS_UNAVAILABLE,
+            iree_status_consume_code(iree_vm_invocation_poll(invocation)));
+  EXPECT_EQ(1, call_count.load());
+
+  gate_open = true;
+  IREE_EXPECT_OK(iree_vm_invocation_poll(invocation));
+  EXPECT_EQ(44, GetResult(invocation, 0));
+  EXPECT_EQ(1, GetResult(invocation, 1));  // entry_count
+  EXPECT_EQ(3, call_count.load());
+  iree_vm_invocation_release(invocation);
+}
+
+// Pending bytecode invocations can be awaited from another thread's signal.
+TEST_F(VMInvocationBytecodeTest, ImportYieldAwait) {
+  iree_vm_invocation_t* invocation =
+      CreateInvocation("invocation_test.increment_and_wait_add_2");
+  std::thread signaler([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    gate_open = true;
+  });
+  IREE_EXPECT_OK(
+      iree_vm_invocation_await(invocation, IREE_TIME_INFINITE_FUTURE));
+  signaler.join();
+  EXPECT_EQ(44, GetResult(invocation, 0));
+  EXPECT_EQ(1, GetResult(invocation, 1));
+  iree_vm_invocation_release(invocation);
+}
+
+// Releasing a pending invocation must tear down its suspended bytecode frames.
+TEST_F(VMInvocationBytecodeTest, ReleasePending) {
+  iree_vm_invocation_t* invocation =
+      CreateInvocation("invocation_test.increment_and_wait_add_2");
+  iree_vm_invocation_release(invocation);
+}
+
+}  // namespace
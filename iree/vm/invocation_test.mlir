@@ -0,0 +1,33 @@
+vm.module @invocation_test {
+  vm.import @async.wait_add_1(%arg0 : i32) -> i32
+
+  // Incremented each time @increment_and_wait_add_2 begins executing such that
+  // tests can tell that resuming continues execution instead of restarting.
+  vm.global.i32 @entry_count mutable 0 : i32
+
+  // Yields once before adding 1 to its argument.
+  vm.export @yield_add_1
+  vm.func @yield_add_1(%arg0 : i32) -> i32 {
+    vm.yield
+    %c1 = vm.const.i32 1 : i32
+    %0 = vm.add.i32 %arg0, %c1 : i32
+    vm.return %0 : i32
+  }
+
+  // Calls the waiting import twice from a nested frame such that a yield
+  // leaves multiple bytecode frames on the stack.
+  vm.func @wait_add_2(%arg0 : i32) -> i32 attributes {noinline} {
+    %0 = vm.call @async.wait_add_1(%arg0) : (i32) -> i32
+    %1 = vm.call @async.wait_add_1(%0) : (i32) -> i32
+    vm.return %1 : i32
+  }
+  vm.export @increment_and_wait_add_2
+  vm.func @increment_and_wait_add_2(%arg0 : i32) -> (i32, i32) {
+    %count = vm.global.load.i32 @entry_count : i32
+    %c1 = vm.const.i32 1 : i32
+    %new_count = vm.add.i32 %count, %c1 : i32
+    vm.global.store.i32 %new_count, @entry_count : i32
+    %0 = vm.call @wait_add_2(%arg0) : (i32) -> i32
+    vm.return %0, %new_count : i32, i32
+  }
+}
@@ -331,6 +331,25 @@ static void iree_vm_list_convert_value_type(
   }
 }
 
+// Loads a primitive value of |element_size| bytes from |element_ptr|.
+// All iree_vm_value_t union members begin at value_storage[0] and list storage
+// uses the native byte order so a memcpy of the element bytes produces the
+// same value as a typed load on both little- and big-endian targets. Unused
+// upper storage bytes are left as-is and must be zeroed by the caller.
+static inline void iree_vm_list_load_value(uintptr_t element_ptr,
+                                           iree_host_size_t element_size,
+                                           iree_vm_value_t* out_value) {
+  memcpy(out_value->value_storage, (const void*)element_ptr, element_size);
+}
+
+// Stores the first |element_size| bytes of |value| to |element_ptr|.
+// See iree_vm_list_load_value for why this is endian-agnostic.
+static inline void iree_vm_list_store_value(const iree_vm_value_t* value,
+                                            iree_host_size_t element_size,
+                                            uintptr_t element_ptr) {
+  memcpy((void*)element_ptr, value->value_storage, element_size);
+}
+
 IREE_API_EXPORT iree_status_t IREE_API_CALL
 iree_vm_list_get_value(const iree_vm_list_t* list, iree_host_size_t i,
                        iree_vm_value_t* out_value) {
@@ -343,21 +362,7 @@ iree_vm_list_get_value(const iree_vm_list_t* list, iree_host_size_t i,
   switch (list->storage_mode) {
     case IREE_VM_LIST_STORAGE_MODE_VALUE: {
       out_value->type = list->element_type.value_type;
-      // TODO(benvanik): #ifdef on LITTLE/BIG_ENDIAN and just memcpy.
-      switch (list->element_size) {
-        case 1:
-          out_value->i8 = *(int8_t*)element_ptr;
-          break;
-        case 2:
-          out_value->i16 = *(int16_t*)element_ptr;
-          break;
-        case 4:
-          out_value->i32 = *(int32_t*)element_ptr;
-          break;
-        case 8:
-          out_value->i64 = *(int64_t*)element_ptr;
-          break;
-      }
+      iree_vm_list_load_value(element_ptr, list->element_size, out_value);
       break;
     }
     case IREE_VM_LIST_STORAGE_MODE_VARIANT: {
@@ -390,21 +395,7 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_get_value_as(
   switch (list->storage_mode) {
     case IREE_VM_LIST_STORAGE_MODE_VALUE: {
       value.type = list->element_type.value_type;
-      // TODO(benvanik): #ifdef on LITTLE/BIG_ENDIAN and just memcpy.
-      switch (list->element_size) {
-        case 1:
-          value.i8 = *(int8_t*)element_ptr;
-          break;
-        case 2:
-          value.i16 = *(int16_t*)element_ptr;
-          break;
-        case 4:
-          value.i32 = *(int32_t*)element_ptr;
-          break;
-        case 8:
-          value.i64 = *(int64_t*)element_ptr;
-          break;
-      }
+      iree_vm_list_load_value(element_ptr, list->element_size, &value);
       break;
     }
     case IREE_VM_LIST_STORAGE_MODE_VARIANT: {
@@ -451,21 +442,8 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_set_value(
   uintptr_t element_ptr = (uintptr_t)list->storage + i * list->element_size;
   switch (list->storage_mode) {
     case IREE_VM_LIST_STORAGE_MODE_VALUE: {
-      // TODO(benvanik): #ifdef on LITTLE/BIG_ENDIAN and just memcpy.
-      switch (list->element_size) {
-        case 1:
-          *(int8_t*)element_ptr = converted_value.i8;
-          break;
-        case 2:
-          *(int16_t*)element_ptr = converted_value.i16;
-          break;
-        case 4:
-          *(int32_t*)element_ptr = converted_value.i32;
-          break;
-        case 8:
-          *(int64_t*)element_ptr = converted_value.i64;
-          break;
-      }
+      iree_vm_list_store_value(&converted_value, list->element_size,
+                               element_ptr);
       break;
     }
     case IREE_VM_LIST_STORAGE_MODE_VARIANT: {
@@ -652,6 +630,256 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_push_variant(
   return iree_vm_list_set_variant(list, i, value);
 }
 
+static iree_status_t iree_vm_list_check_range(const iree_vm_list_t* list,
+                                              iree_host_size_t i,
+                                              iree_host_size_t count) {
+  if (i > list->count || count > list->count - i) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "range [%zu, %zu) out of bounds (%zu)", i,
+                            i + count, list->count);
+  }
+  return iree_ok_status();
+}
+
+static iree_status_t iree_vm_list_check_value_type(
+    iree_vm_value_type_t value_type) {
+  if (value_type == IREE_VM_VALUE_TYPE_NONE ||
+      value_type > IREE_VM_VALUE_TYPE_MAX) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "invalid value type %d", (int)value_type);
+  }
+  return iree_ok_status();
+}
+
+// Returns true if |list| stores dense primitive values of |value_type|.
+static inline bool iree_vm_list_is_dense_value_type(
+    const iree_vm_list_t* list, iree_vm_value_type_t value_type) {
+  return list->storage_mode == IREE_VM_LIST_STORAGE_MODE_VALUE &&
+         list->element_type.value_type == value_type;
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_get_values(
+    const iree_vm_list_t* list, iree_host_size_t i, iree_host_size_t count,
+    iree_vm_value_type_t value_type, void* out_values) {
+  IREE_RETURN_IF_ERROR(iree_vm_list_check_value_type(value_type));
+  IREE_RETURN_IF_ERROR(iree_vm_list_check_range(list, i, count));
+  if (count == 0) return iree_ok_status();
+  iree_host_size_t value_size = kValueTypeSizes[value_type];
+  if (iree_vm_list_is_dense_value_type(list, value_type)) {
+    memcpy(out_values,
+           (const void*)((uintptr_t)list->storage + i * list->element_size),
+           count * value_size);
+    return iree_ok_status();
+  }
+  uintptr_t value_ptr = (uintptr_t)out_values;
+  for (iree_host_size_t j = 0; j < count; ++j) {
+    iree_vm_value_t value;
+    IREE_RETURN_IF_ERROR(
+        iree_vm_list_get_value_as(list, i + j, value_type, &value));
+    iree_vm_list_store_value(&value, value_size, value_ptr);
+    value_ptr += value_size;
+  }
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_push_values(
+    iree_vm_list_t* list, iree_vm_value_type_t value_type, const void* values,
+    iree_host_size_t count) {
+  IREE_RETURN_IF_ERROR(iree_vm_list_check_value_type(value_type));
+  if (list->storage_mode == IREE_VM_LIST_STORAGE_MODE_REF) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "list cannot store values");
+  }
+  if (count == 0) return iree_ok_status();
+  iree_host_size_t i = list->count;
+  IREE_RETURN_IF_ERROR(iree_vm_list_resize(list, i + count));
+  iree_host_size_t value_size = kValueTypeSizes[value_type];
+  if (iree_vm_list_is_dense_value_type(list, value_type)) {
+    memcpy((void*)((uintptr_t)list->storage + i * list->element_size), values,
+           count * value_size);
+    return iree_ok_status();
+  }
+  iree_status_t status = iree_ok_status();
+  uintptr_t value_ptr = (uintptr_t)values;
+  for (iree_host_size_t j = 0; j < count; ++j) {
+    iree_vm_value_t value;
+    value.type = value_type;
+    value.i64 = 0;
+    iree_vm_list_load_value(value_ptr, value_size, &value);
+    status = iree_vm_list_set_value(list, i + j, &value);
+    if (!iree_status_is_ok(status)) break;
+    value_ptr += value_size;
+  }
+  if (!iree_status_is_ok(status)) {
+    iree_vm_list_reset_range(list, i, count);
+    list->count = i;
+  }
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_list_fill_value(iree_vm_list_t* list, iree_host_size_t i,
+                        iree_host_size_t count, const iree_vm_value_t* value) {
+  IREE_RETURN_IF_ERROR(iree_vm_list_check_range(list, i, count));
+  switch (list->storage_mode) {
+    case IREE_VM_LIST_STORAGE_MODE_VALUE: {
+      iree_vm_value_t converted_value;
+      iree_vm_list_convert_value_type(value, list->element_type.value_type,
+                                      &converted_value);
+      uintptr_t element_ptr = (uintptr_t)list->storage + i * list->element_size;
+      if (list->element_size == 1) {
+        memset((void*)element_ptr, converted_value.value_storage[0], count);
+        break;
+      }
+      for (iree_host_size_t j = 0; j < count; ++j) {
+        iree_vm_list_store_value(&converted_value, list->element_size,
+                                 element_ptr);
+        element_ptr += list->element_size;
+      }
+      break;
+    }
+    case IREE_VM_LIST_STORAGE_MODE_VARIANT: {
+      for (iree_host_size_t j = 0; j < count; ++j) {
+        IREE_RETURN_IF_ERROR(iree_vm_list_set_value(list, i + j, value));
+      }
+      break;
+    }
+    default:
+      return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                              "list cannot store values");
+  }
+  return iree_ok_status();
+}
+
+// Copies a single element between lists of any storage mode using the same
+// retain and conversion rules as the per-element accessors.
+static iree_status_t iree_vm_list_copy_element(
+    const iree_vm_list_t* source_list, iree_host_size_t source_i,
+    iree_vm_list_t* target_list, iree_host_size_t target_i) {
+  uintptr_t element_ptr =
+      (uintptr_t)source_list->storage + source_i * source_list->element_size;
+  iree_vm_ref_t* source_ref = NULL;
+  switch (source_list->storage_mode) {
+    case IREE_VM_LIST_STORAGE_MODE_VALUE:
+      break;
+    case IREE_VM_LIST_STORAGE_MODE_REF:
+      source_ref = (iree_vm_ref_t*)element_ptr;
+      break;
+    case IREE_VM_LIST_STORAGE_MODE_VARIANT: {
+      iree_vm_variant_t* variant = (iree_vm_variant_t*)element_ptr;
+      if (iree_vm_type_def_is_ref(&variant->type)) {
+        source_ref = &variant->ref;
+      } else if (iree_vm_type_def_is_variant(&variant->type)) {
+        // Empty variants can only be represented in variant lists.
+        if (target_list->storage_mode != IREE_VM_LIST_STORAGE_MODE_VARIANT) {
+          return iree_make_status(
+              IREE_STATUS_FAILED_PRECONDITION,
+              "empty variant at index %zu cannot be stored in a typed list",
+              source_i);
+        }
+        iree_vm_list_reset_range(target_list, target_i, 1);
+        return iree_ok_status();
+      }
+      break;
+    }
+  }
+  if (source_ref) {
+    return iree_vm_list_set_ref(target_list, target_i, /*is_move=*/false,
+                                source_ref);
+  }
+  iree_vm_value_t value;
+  IREE_RETURN_IF_ERROR(iree_vm_list_get_value(source_list, source_i, &value));
+  return iree_vm_list_set_value(target_list, target_i, &value);
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_copy_range(
+    const iree_vm_list_t* source_list, iree_host_size_t source_i,
+    iree_vm_list_t* target_list, iree_host_size_t target_i,
+    iree_host_size_t count) {
+  IREE_RETURN_IF_ERROR(iree_vm_list_check_range(source_list, source_i, count));
+  IREE_RETURN_IF_ERROR(iree_vm_list_check_range(target_list, target_i, count));
+  if (count == 0 || (source_list == target_list && source_i == target_i)) {
+    return iree_ok_status();
+  }
+
+  // When copying within a single list walk backwards if the target range
+  // starts after the source range so that no source element is overwritten
+  // before it has been read.
+  bool reverse = source_list == target_list && target_i > source_i;
+
+  if (source_list->storage_mode == IREE_VM_LIST_STORAGE_MODE_VALUE &&
+      iree_vm_list_is_dense_value_type(target_list,
+                                       source_list->element_type.value_type)) {
+    memmove(
+        (void*)((uintptr_t)target_list->storage +
+                target_i * target_list->element_size),
+        (const void*)((uintptr_t)source_list->storage +
+                      source_i * source_list->element_size),
+        count * source_list->element_size);
+    return iree_ok_status();
+  } else if (source_list->storage_mode == IREE_VM_LIST_STORAGE_MODE_REF &&
+             target_list->storage_mode == IREE_VM_LIST_STORAGE_MODE_REF &&
+             source_list->element_type.ref_type ==
+                 target_list->element_type.ref_type) {
+    // All source elements were type checked when they were stored.
+    iree_vm_ref_t* source_refs = (iree_vm_ref_t*)source_list->storage;
+    iree_vm_ref_t* target_refs = (iree_vm_ref_t*)target_list->storage;
+    for (iree_host_size_t j = 0; j < count; ++j) {
+      iree_host_size_t k = reverse ? count - j - 1 : j;
+      iree_vm_ref_retain_or_move(/*is_move=*/0, &source_refs[source_i + k],
+                                 &target_refs[target_i + k]);
+    }
+    return iree_ok_status();
+  }
+
+  for (iree_host_size_t j = 0; j < count; ++j) {
+    iree_host_size_t k = reverse ? count - j - 1 : j;
+    IREE_RETURN_IF_ERROR(iree_vm_list_copy_element(source_list, source_i + k,
+                                                   target_list, target_i + k));
+  }
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_splice(
+    const iree_vm_list_t* source_list, iree_host_size_t source_i,
+    iree_vm_list_t* target_list, iree_host_size_t target_i,
+    iree_host_size_t count) {
+  if (source_list == target_list) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "cannot splice a list into itself");
+  }
+  IREE_RETURN_IF_ERROR(iree_vm_list_check_range(source_list, source_i, count));
+  if (target_i > target_list->count) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "index %zu out of bounds (%zu)", target_i,
+                            target_list->count);
+  }
+  if (count == 0) return iree_ok_status();
+
+  iree_host_size_t old_count = target_list->count;
+  IREE_RETURN_IF_ERROR(iree_vm_list_resize(target_list, old_count + count));
+
+  // Move the tail back to open a gap. Ownership of any refs moves along with
+  // the element bytes so the gap is cleared without releasing anything.
+  iree_host_size_t element_size = target_list->element_size;
+  uint8_t* gap_ptr = (uint8_t*)target_list->storage + target_i * element_size;
+  iree_host_size_t tail_length = (old_count - target_i) * element_size;
+  memmove(gap_ptr + count * element_size, gap_ptr, tail_length);
+  memset(gap_ptr, 0, count * element_size);
+
+  iree_status_t status = iree_vm_list_copy_range(source_list, source_i,
+                                                 target_list, target_i, count);
+  if (!iree_status_is_ok(status)) {
+    // Drop whatever was copied and close the gap again.
+    iree_vm_list_reset_range(target_list, target_i, count);
+    memmove(gap_ptr, gap_ptr + count * element_size, tail_length);
+    memset((uint8_t*)target_list->storage + old_count * element_size, 0,
+           count * element_size);
+    target_list->count = old_count;
+  }
+  return status;
+}
+
 iree_status_t iree_vm_list_register_types() {
   iree_vm_list_descriptor.destroy = iree_vm_list_destroy;
   iree_vm_list_descriptor.offsetof_counter =
@@ -189,6 +189,53 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_set_variant(
 IREE_API_EXPORT iree_status_t IREE_API_CALL
 iree_vm_list_push_variant(iree_vm_list_t* list, const iree_vm_variant_t* value);
 
+// Reads |count| primitive values starting at index |i| into the dense
+// |out_values| array of |value_type| elements. Values will be converted using
+// the value type semantics if |value_type| differs from the list storage type.
+// Lists storing |value_type| elements are copied with a single memcpy.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_get_values(
+    const iree_vm_list_t* list, iree_host_size_t i, iree_host_size_t count,
+    iree_vm_value_type_t value_type, void* out_values);
+
+// Pushes |count| primitive values from the dense |values| array of
+// |value_type| elements to the end of the list. Values will be converted using
+// the value type semantics if |value_type| differs from the list storage type.
+// Lists storing |value_type| elements are appended with a single memcpy.
+// On failure the list is left unchanged.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_push_values(
+    iree_vm_list_t* list, iree_vm_value_type_t value_type, const void* values,
+    iree_host_size_t count);
+
+// Sets the |count| elements starting at index |i| to |value|. The value is
+// converted to the list storage type once prior to filling.
+// Combine with iree_vm_list_resize to grow a list with a non-zero value.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_list_fill_value(iree_vm_list_t* list, iree_host_size_t i,
+                        iree_host_size_t count, const iree_vm_value_t* value);
+
+// Copies |count| elements from |source_list| starting at |source_i| over the
+// elements of |target_list| starting at |target_i|. Both ranges must already
+// exist. Refs are retained and values are converted as with the per-element
+// setters. The lists may be the same list and the ranges may overlap.
+//
+// Lists of the same primitive value type are copied with a single memmove and
+// ref lists of the same ref type skip the per-element type checks. On failure
+// the target range may have been partially updated.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_copy_range(
+    const iree_vm_list_t* source_list, iree_host_size_t source_i,
+    iree_vm_list_t* target_list, iree_host_size_t target_i,
+    iree_host_size_t count);
+
+// Inserts |count| elements from |source_list| starting at |source_i| into
+// |target_list| before index |target_i|, moving any existing elements at or
+// after |target_i| back to make room. |target_i| may equal the list size to
+// append the range. |source_list| must not be |target_list|.
+// On failure the target list is left unchanged.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_list_splice(
+    const iree_vm_list_t* source_list, iree_host_size_t source_i,
+    iree_vm_list_t* target_list, iree_host_size_t target_i,
+    iree_host_size_t count);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -0,0 +1,223 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares per-element list accessors against the bulk range APIs.
+// All benchmarks report the time per list element.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/vm/builtin_types.h"
+#include "iree/vm/list.h"
+
+namespace {
+
+static iree_vm_list_t* CreateList(iree_vm_type_def_t element_type,
+                                  iree_host_size_t size) {
+  IREE_CHECK_OK(iree_vm_register_builtin_types());
+  iree_vm_list_t* list = nullptr;
+  IREE_CHECK_OK(
+      iree_vm_list_create(&element_type, size, iree_allocator_system(), &list));
+  IREE_CHECK_OK(iree_vm_list_resize(list, size));
+  return list;
+}
+
+static iree_vm_list_t* CreateI32List(iree_host_size_t size) {
+  iree_vm_list_t* list = CreateList(
+      iree_vm_type_def_make_value_type(IREE_VM_VALUE_TYPE_I32), size);
+  iree_vm_value_t value = iree_vm_value_make_i32(1);
+  IREE_CHECK_OK(iree_vm_list_fill_value(list, 0, size, &value));
+  return list;
+}
+
+// Creates a list of |size| elements that all reference the same list object.
+static iree_vm_list_t* CreateRefList(iree_vm_type_def_t element_type,
+                                     iree_host_size_t size) {
+  iree_vm_list_t* list = CreateList(element_type, size);
+  iree_vm_list_t* element = CreateI32List(0);
+  iree_vm_ref_t element_ref = iree_vm_list_move_ref(element);
+  for (iree_host_size_t i = 0; i < size; ++i) {
+    IREE_CHECK_OK(iree_vm_list_set_ref_retain(list, i, &element_ref));
+  }
+  iree_vm_ref_release(&element_ref);
+  return list;
+}
+
+static void BM_ListPushValueI32(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_list_t* list = CreateI32List(0);
+  IREE_CHECK_OK(iree_vm_list_reserve(list, count));
+  while (state.KeepRunningBatch(count)) {
+    IREE_CHECK_OK(iree_vm_list_resize(list, 0));
+    for (iree_host_size_t i = 0; i < count; ++i) {
+      iree_vm_value_t value = iree_vm_value_make_i32((int32_t)i);
+      IREE_CHECK_OK(iree_vm_list_push_value(list, &value));
+    }
+  }
+  iree_vm_list_release(list);
+}
+BENCHMARK(BM_ListPushValueI32)->Arg(4096);
+
+static void BM_ListPushValuesI32(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_list_t* list = CreateI32List(0);
+  IREE_CHECK_OK(iree_vm_list_reserve(list, count));
+  std::vector<int32_t> values(count, 1);
+  while (state.KeepRunningBatch(count)) {
+    IREE_CHECK_OK(iree_vm_list_resize(list, 0));
+    IREE_CHECK_OK(iree_vm_list_push_values(list, IREE_VM_VALUE_TYPE_I32,
+                                           values.data(), count));
+  }
+  iree_vm_list_release(list);
+}
+BENCHMARK(BM_ListPushValuesI32)->Arg(4096);
+
+static void BM_ListGetValueI32(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_list_t* list = CreateI32List(count);
+  std::vector<int32_t> values(count);
+  while (state.KeepRunningBatch(count)) {
+    for (iree_host_size_t i = 0; i < count; ++i) {
+      iree_vm_value_t value;
+      IREE_CHECK_OK(iree_vm_list_get_value(list, i, &value));
+      values[i] = value.i32;
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  iree_vm_list_release(list);
+}
+BENCHMARK(BM_ListGetValueI32)->Arg(4096);
+
+static void BM_ListGetValuesI32(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_list_t* list = CreateI32List(count);
+  std::vector<int32_t> values(count);
+  while (state.KeepRunningBatch(count)) {
+    IREE_CHECK_OK(iree_vm_list_get_values(list, 0, count,
+                                          IREE_VM_VALUE_TYPE_I32,
+                                          values.data()));
+    benchmark::DoNotOptimize(values.data());
+  }
+  iree_vm_list_release(list);
+}
+BENCHMARK(BM_ListGetValuesI32)->Arg(4096);
+
+// Baseline: resize-and-fill by setting each element.
+static void BM_ListSetValueFillI32(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_list_t* list = CreateI32List(count);
+  while (state.KeepRunningBatch(count)) {
+    iree_vm_value_t value = iree_vm_value_make_i32(2);
+    for (iree_host_size_t i = 0; i < count; ++i) {
+      IREE_CHECK_OK(iree_vm_list_set_value(list, i, &value));
+    }
+  }
+  iree_vm_list_release(list);
+}
+BENCHMARK(BM_ListSetValueFillI32)->Arg(4096);
+
+static void BM_ListFillValueI32(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_list_t* list = CreateI32List(count);
+  while (state.KeepRunningBatch(count)) {
+    iree_vm_value_t value = iree_vm_value_make_i32(2);
+    IREE_CHECK_OK(iree_vm_list_fill_value(list, 0, count, &value));
+  }
+  iree_vm_list_release(list);
+}
+BENCHMARK(BM_ListFillValueI32)->Arg(4096);
+
+// Baseline: copies between i32 lists with per-element get/set.
+static void BM_ListCopyElementwiseI32(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_list_t* source_list = CreateI32List(count);
+  iree_vm_list_t* target_list = CreateI32List(count);
+  while (state.KeepRunningBatch(count)) {
+    for (iree_host_size_t i = 0; i < count; ++i) {
+      iree_vm_value_t value;
+      IREE_CHECK_OK(iree_vm_list_get_value(source_list, i, &value));
+      IREE_CHECK_OK(iree_vm_list_set_value(target_list, i, &value));
+    }
+  }
+  iree_vm_list_release(source_list);
+  iree_vm_list_release(target_list);
+}
+BENCHMARK(BM_ListCopyElementwiseI32)->Arg(4096);
+
+static void BM_ListCopyRangeI32(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_list_t* source_list = CreateI32List(count);
+  iree_vm_list_t* target_list = CreateI32List(count);
+  while (state.KeepRunningBatch(count)) {
+    IREE_CHECK_OK(
+        iree_vm_list_copy_range(source_list, 0, target_list, 0, count));
+  }
+  iree_vm_list_release(source_list);
+  iree_vm_list_release(target_list);
+}
+BENCHMARK(BM_ListCopyRangeI32)->Arg(4096);
+
+// Baseline: copies between ref lists with per-element get/set.
+static void BM_ListCopyElementwiseRef(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_type_def_t element_type =
+      iree_vm_type_def_make_ref_type(iree_vm_list_type_id());
+  iree_vm_list_t* source_list = CreateRefList(element_type, count);
+  iree_vm_list_t* target_list = CreateList(element_type, count);
+  while (state.KeepRunningBatch(count)) {
+    for (iree_host_size_t i = 0; i < count; ++i) {
+      iree_vm_ref_t ref = {0};
+      IREE_CHECK_OK(iree_vm_list_get_ref_assign(source_list, i, &ref));
+      IREE_CHECK_OK(iree_vm_list_set_ref_retain(target_list, i, &ref));
+    }
+  }
+  iree_vm_list_release(source_list);
+  iree_vm_list_release(target_list);
+}
+BENCHMARK(BM_ListCopyElementwiseRef)->Arg(4096);
+
+static void BM_ListCopyRangeRef(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_type_def_t element_type =
+      iree_vm_type_def_make_ref_type(iree_vm_list_type_id());
+  iree_vm_list_t* source_list = CreateRefList(element_type, count);
+  iree_vm_list_t* target_list = CreateList(element_type, count);
+  while (state.KeepRunningBatch(count)) {
+    IREE_CHECK_OK(
+        iree_vm_list_copy_range(source_list, 0, target_list, 0, count));
+  }
+  iree_vm_list_release(source_list);
+  iree_vm_list_release(target_list);
+}
+BENCHMARK(BM_ListCopyRangeRef)->Arg(4096);
+
+// Splices refs into the middle of a variant list and then truncates it back.
+static void BM_ListSpliceVariant(benchmark::State& state) {
+  const iree_host_size_t count = state.range(0);
+  iree_vm_type_def_t element_type = iree_vm_type_def_make_variant_type();
+  iree_vm_list_t* source_list = CreateRefList(element_type, count);
+  iree_vm_list_t* target_list = CreateList(element_type, 16);
+  while (state.KeepRunningBatch(count)) {
+    IREE_CHECK_OK(
+        iree_vm_list_splice(source_list, 0, target_list, 8, count));
+    IREE_CHECK_OK(iree_vm_list_resize(target_list, 16));
+  }
+  iree_vm_list_release(source_list);
+  iree_vm_list_release(target_list);
+}
+BENCHMARK(BM_ListSpliceVariant)->Arg(4096);
+
+}  // namespace
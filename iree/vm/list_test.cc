@@ -385,6 +385,278 @@ TEST_F(VMListTest, ResizeVariant) {
   iree_vm_list_release(list);
 }
 
+// Tests bulk value push/get with and without type conversion.
+TEST_F(VMListTest, PushGetValues) {
+  iree_vm_type_def_t element_type =
+      iree_vm_type_def_make_value_type(IREE_VM_VALUE_TYPE_I32);
+  iree_vm_list_t* list = nullptr;
+  IREE_ASSERT_OK(
+      iree_vm_list_create(&element_type, 0, iree_allocator_system(), &list));
+
+  int32_t i32_values[4] = {-1, 2, -3, 4};
+  IREE_ASSERT_OK(iree_vm_list_push_values(list, IREE_VM_VALUE_TYPE_I32,
+                                          i32_values, 4));
+  int8_t i8_values[2] = {-5, 6};
+  IREE_ASSERT_OK(
+      iree_vm_list_push_values(list, IREE_VM_VALUE_TYPE_I8, i8_values, 2));
+  EXPECT_EQ(6, iree_vm_list_size(list));
+
+  int32_t i32_results[6] = {0};
+  IREE_ASSERT_OK(iree_vm_list_get_values(list, 0, 6, IREE_VM_VALUE_TYPE_I32,
+                                         i32_results));
+  const int32_t expected_i32[6] = {-1, 2, -3, 4, -5, 6};
+  for (int i = 0; i < 6; ++i) EXPECT_EQ(expected_i32[i], i32_results[i]);
+
+  int64_t i64_results[3] = {0};
+  IREE_ASSERT_OK(iree_vm_list_get_values(list, 2, 3, IREE_VM_VALUE_TYPE_I64,
+                                         i64_results));
+  EXPECT_EQ(-3, i64_results[0]);
+  EXPECT_EQ(4, i64_results[1]);
+  EXPECT_EQ(-5, i64_results[2]);
+
+  EXPECT_EQ(IREE_STATUS_OUT_OF_RANGE,
+            iree_status_consume_code(iree_vm_list_get_values(
+                list, 4, 3, IREE_VM_VALUE_TYPE_I32, i32_results)));
+
+  iree_vm_list_release(list);
+}
+
+// Tests that bulk value pushes into ref lists fail and leave the list as-is.
+TEST_F(VMListTest, PushValuesRefFailure) {
+  iree_vm_type_def_t element_type =
+      iree_vm_type_def_make_ref_type(test_a_type_id());
+  iree_vm_list_t* list = nullptr;
+  IREE_ASSERT_OK(
+      iree_vm_list_create(&element_type, 0, iree_allocator_system(), &list));
+  int32_t values[2] = {1, 2};
+  EXPECT_EQ(IREE_STATUS_FAILED_PRECONDITION,
+            iree_status_consume_code(iree_vm_list_push_values(
+                list, IREE_VM_VALUE_TYPE_I32, values, 2)));
+  EXPECT_EQ(0, iree_vm_list_size(list));
+  iree_vm_list_release(list);
+}
+
+// Tests filling value and variant list ranges.
+TEST_F(VMListTest, FillValue) {
+  iree_vm_type_def_t element_type =
+      iree_vm_type_def_make_value_type(IREE_VM_VALUE_TYPE_I16);
+  iree_vm_list_t* list = nullptr;
+  IREE_ASSERT_OK(
+      iree_vm_list_create(&element_type, 0, iree_allocator_system(), &list));
+  IREE_ASSERT_OK(iree_vm_list_resize(list, 8));
+  iree_vm_value_t fill_value = iree_vm_value_make_i32(-7);
+  IREE_ASSERT_OK(iree_vm_list_fill_value(list, 2, 4, &fill_value));
+  for (iree_host_size_t i = 0; i < 8; ++i) {
+    iree_vm_value_t value;
+    IREE_ASSERT_OK(iree_vm_list_get_value(list, i, &value));
+    EXPECT_EQ(IREE_VM_VALUE_TYPE_I16, value.type);
+    EXPECT_EQ(i >= 2 && i < 6 ? -7 : 0, value.i16);
+  }
+  EXPECT_EQ(IREE_STATUS_OUT_OF_RANGE,
+            iree_status_consume_code(
+                iree_vm_list_fill_value(list, 6, 3, &fill_value)));
+  iree_vm_list_release(list);
+
+  iree_vm_type_def_t variant_type = iree_vm_type_def_make_variant_type();
+  IREE_ASSERT_OK(
+      iree_vm_list_create(&variant_type, 0, iree_allocator_system(), &list));
+  IREE_ASSERT_OK(iree_vm_list_resize(list, 3));
+  iree_vm_ref_t ref_a = MakeRef<A>(1.0f);
+  IREE_ASSERT_OK(iree_vm_list_set_ref_move(list, 1, &ref_a));
+  IREE_ASSERT_OK(iree_vm_list_fill_value(list, 0, 3, &fill_value));
+  for (iree_host_size_t i = 0; i < 3; ++i) {
+    iree_vm_value_t value;
+    IREE_ASSERT_OK(iree_vm_list_get_value(list, i, &value));
+    EXPECT_EQ(IREE_VM_VALUE_TYPE_I32, value.type);
+    EXPECT_EQ(-7, value.i32);
+  }
+  iree_vm_list_release(list);
+}
+
+// Tests copying value ranges between lists, within a list, and with
+// conversion between value types.
+TEST_F(VMListTest, CopyRangeValues) {
+  iree_vm_type_def_t i32_type =
+      iree_vm_type_def_make_value_type(IREE_VM_VALUE_TYPE_I32);
+  iree_vm_list_t* list = nullptr;
+  IREE_ASSERT_OK(
+      iree_vm_list_create(&i32_type, 0, iree_allocator_system(), &list));
+  int32_t values[6] = {0, 1, 2, 3, 4, 5};
+  IREE_ASSERT_OK(
+      iree_vm_list_push_values(list, IREE_VM_VALUE_TYPE_I32, values, 6));
+
+  // Overlapping forward and backward copies within the same list.
+  IREE_ASSERT_OK(iree_vm_list_copy_range(list, 0, list, 2, 4));
+  int32_t results[6] = {0};
+  IREE_ASSERT_OK(
+      iree_vm_list_get_values(list, 0, 6, IREE_VM_VALUE_TYPE_I32, results));
+  const int32_t expected_forward[6] = {0, 1, 0, 1, 2, 3};
+  for (int i = 0; i < 6; ++i) EXPECT_EQ(expected_forward[i], results[i]);
+  IREE_ASSERT_OK(iree_vm_list_copy_range(list, 2, list, 1, 4));
+  IREE_ASSERT_OK(
+      iree_vm_list_get_values(list, 0, 6, IREE_VM_VALUE_TYPE_I32, results));
+  const int32_t expected_backward[6] = {0, 0, 1, 2, 3, 3};
+  for (int i = 0; i < 6; ++i) EXPECT_EQ(expected_backward[i], results[i]);
+
+  // Converting copy into an i64 list and a variant list.
+  iree_vm_type_def_t i64_type =
+      iree_vm_type_def_make_value_type(IREE_VM_VALUE_TYPE_I64);
+  iree_vm_list_t* i64_list = nullptr;
+  IREE_ASSERT_OK(
+      iree_vm_list_create(&i64_type, 0, iree_allocator_system(), &i64_list));
+  IREE_ASSERT_OK(iree_vm_list_resize(i64_list, 3));
+  IREE_ASSERT_OK(iree_vm_list_copy_range(list, 3, i64_list, 0, 3));
+  iree_vm_type_def_t variant_type = iree_vm_type_def_make_variant_type();
+  iree_vm_list_t* variant_list = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(&variant_type, 0, iree_allocator_system(),
+                                     &variant_list));
+  IREE_ASSERT_OK(iree_vm_list_resize(variant_list, 3));
+  IREE_ASSERT_OK(iree_vm_list_copy_range(i64_list, 0, variant_list, 0, 3));
+  for (iree_host_size_t i = 0; i < 3; ++i) {
+    iree_vm_value_t value;
+    IREE_ASSERT_OK(iree_vm_list_get_value(variant_list, i, &value));
+    EXPECT_EQ(IREE_VM_VALUE_TYPE_I64, value.type);
+    EXPECT_EQ(expected_backward[3 + i], value.i64);
+  }
+
+  EXPECT_EQ(IREE_STATUS_OUT_OF_RANGE,
+            iree_status_consume_code(
+                iree_vm_list_copy_range(list, 4, i64_list, 0, 3)));
+
+  iree_vm_list_release(variant_list);
+  iree_vm_list_release(i64_list);
+  iree_vm_list_release(list);
+}
+
+// Tests copying ref ranges into ref and variant lists.
+TEST_F(VMListTest, CopyRangeRefs) {
+  iree_vm_type_def_t ref_type =
+      iree_vm_type_def_make_ref_type(test_a_type_id());
+  iree_vm_list_t* source_list = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(&ref_type, 0, iree_allocator_system(),
+                                     &source_list));
+  for (iree_host_size_t i = 0; i < 4; ++i) {
+    iree_vm_ref_t ref_a = MakeRef<A>(static_cast<float>(i));
+    IREE_ASSERT_OK(iree_vm_list_push_ref_move(source_list, &ref_a));
+  }
+
+  iree_vm_list_t* target_list = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(&ref_type, 0, iree_allocator_system(),
+                                     &target_list));
+  IREE_ASSERT_OK(iree_vm_list_resize(target_list, 4));
+  IREE_ASSERT_OK(iree_vm_list_copy_range(source_list, 0, target_list, 0, 4));
+  // Overlapping copy that overwrites retained refs within the list.
+  IREE_ASSERT_OK(iree_vm_list_copy_range(target_list, 1, target_list, 0, 3));
+  iree_vm_list_release(source_list);
+  for (iree_host_size_t i = 0; i < 4; ++i) {
+    auto* a = (A*)iree_vm_list_get_ref_deref(target_list, i,
+                                             test_a_get_descriptor());
+    ASSERT_NE(nullptr, a);
+    EXPECT_EQ(i < 3 ? i + 1 : 3, a->data());
+  }
+
+  // Refs of the wrong type are rejected.
+  iree_vm_type_def_t variant_type = iree_vm_type_def_make_variant_type();
+  iree_vm_list_t* variant_list = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(&variant_type, 0, iree_allocator_system(),
+                                     &variant_list));
+  iree_vm_ref_t ref_b = MakeRef<B>(5);
+  IREE_ASSERT_OK(iree_vm_list_push_ref_move(variant_list, &ref_b));
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(
+                iree_vm_list_copy_range(variant_list, 0, target_list, 0, 1)));
+
+  IREE_ASSERT_OK(iree_vm_list_resize(variant_list, 5));
+  IREE_ASSERT_OK(iree_vm_list_copy_range(target_list, 0, variant_list, 1, 4));
+  iree_vm_list_release(target_list);
+  for (iree_host_size_t i = 1; i < 5; ++i) {
+    auto* a = (A*)iree_vm_list_get_ref_deref(variant_list, i,
+                                             test_a_get_descriptor());
+    ASSERT_NE(nullptr, a);
+    EXPECT_EQ(i < 4 ? i : 3, a->data());
+  }
+  iree_vm_list_release(variant_list);
+}
+
+// Tests splicing ranges into the middle and end of lists.
+TEST_F(VMListTest, Splice) {
+  iree_vm_type_def_t variant_type = iree_vm_type_def_make_variant_type();
+  iree_vm_list_t* source_list = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(&variant_type, 0, iree_allocator_system(),
+                                     &source_list));
+  iree_vm_value_t value = iree_vm_value_make_i32(10);
+  IREE_ASSERT_OK(iree_vm_list_push_value(source_list, &value));
+  iree_vm_ref_t ref_a = MakeRef<A>(11.0f);
+  IREE_ASSERT_OK(iree_vm_list_push_ref_move(source_list, &ref_a));
+
+  iree_vm_list_t* target_list = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(&variant_type, 0, iree_allocator_system(),
+                                     &target_list));
+  for (int i = 0; i < 3; ++i) {
+    iree_vm_ref_t ref_a = MakeRef<A>(static_cast<float>(i));
+    IREE_ASSERT_OK(iree_vm_list_push_ref_move(target_list, &ref_a));
+  }
+
+  // [a0, a1, a2] -> [a0, 10, a11, a1, a2] -> [a0, 10, a11, a1, a2, 10, a11]
+  IREE_ASSERT_OK(iree_vm_list_splice(source_list, 0, target_list, 1, 2));
+  IREE_ASSERT_OK(iree_vm_list_splice(source_list, 0, target_list, 5, 2));
+  iree_vm_list_release(source_list);
+  ASSERT_EQ(7, iree_vm_list_size(target_list));
+  const float expected_refs[7] = {0.0f, 0.0f, 11.0f, 1.0f, 2.0f, 0.0f, 11.0f};
+  for (iree_host_size_t i = 0; i < 7; ++i) {
+    if (i == 1 || i == 5) {
+      IREE_ASSERT_OK(iree_vm_list_get_value(target_list, i, &value));
+      EXPECT_EQ(10, value.i32);
+      continue;
+    }
+    auto* a = (A*)iree_vm_list_get_ref_deref(target_list, i,
+                                             test_a_get_descriptor());
+    ASSERT_NE(nullptr, a);
+    EXPECT_EQ(expected_refs[i], a->data());
+  }
+
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(
+                iree_vm_list_splice(target_list, 0, target_list, 0, 1)));
+  iree_vm_list_release(target_list);
+}
+
+// Tests that a failed splice leaves the target list unchanged.
+TEST_F(VMListTest, SpliceFailure) {
+  iree_vm_type_def_t variant_type = iree_vm_type_def_make_variant_type();
+  iree_vm_list_t* source_list = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(&variant_type, 0, iree_allocator_system(),
+                                     &source_list));
+  iree_vm_ref_t ref_a = MakeRef<A>(1.0f);
+  IREE_ASSERT_OK(iree_vm_list_push_ref_move(source_list, &ref_a));
+  iree_vm_ref_t ref_b = MakeRef<B>(2);
+  IREE_ASSERT_OK(iree_vm_list_push_ref_move(source_list, &ref_b));
+
+  iree_vm_type_def_t ref_type =
+      iree_vm_type_def_make_ref_type(test_a_type_id());
+  iree_vm_list_t* target_list = nullptr;
+  IREE_ASSERT_OK(iree_vm_list_create(&ref_type, 0, iree_allocator_system(),
+                                     &target_list));
+  for (int i = 0; i < 2; ++i) {
+    iree_vm_ref_t ref_a = MakeRef<A>(static_cast<float>(i));
+    IREE_ASSERT_OK(iree_vm_list_push_ref_move(target_list, &ref_a));
+  }
+
+  EXPECT_EQ(IREE_STATUS_INVALID_ARGUMENT,
+            iree_status_consume_code(
+                iree_vm_list_splice(source_list, 0, target_list, 1, 2)));
+  ASSERT_EQ(2, iree_vm_list_size(target_list));
+  for (iree_host_size_t i = 0; i < 2; ++i) {
+    auto* a = (A*)iree_vm_list_get_ref_deref(target_list, i,
+                                             test_a_get_descriptor());
+    ASSERT_NE(nullptr, a);
+    EXPECT_EQ(i, a->data());
+  }
+
+  iree_vm_list_release(source_list);
+  iree_vm_list_release(target_list);
+}
+
 // TODO(benvanik): test value get/set.
 
 // TODO(benvanik): test value conversion.
@@ -111,6 +111,18 @@ iree_vm_function_call_compute_cconv_fragment_size(
   return iree_ok_status();
 }
 
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_wait_request_await(
+    const iree_vm_wait_request_t* request, iree_time_t deadline_ns) {
+  if (!request->wait_fn) return iree_ok_status();
+  return request->wait_fn(request, deadline_ns);
+}
+
+IREE_API_EXPORT void IREE_API_CALL
+iree_vm_wait_request_reset(iree_vm_wait_request_t* request) {
+  iree_vm_ref_release(&request->object);
+  memset(request, 0, sizeof(*request));
+}
+
 IREE_API_EXPORT void IREE_API_CALL
 iree_vm_function_call_release(iree_vm_function_call_t* call,
                               const iree_vm_function_signature_t* signature) {
@@ -20,6 +20,7 @@
 #include "iree/base/alignment.h"
 #include "iree/base/api.h"
 #include "iree/base/internal/atomics.h"
+#include "iree/vm/ref.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -252,14 +253,52 @@ IREE_API_EXPORT void IREE_API_CALL
 iree_vm_function_call_release(iree_vm_function_call_t* call,
                               const iree_vm_function_signature_t* signature);
 
-// Results of an iree_vm_module_execute request.
+typedef struct iree_vm_wait_request iree_vm_wait_request_t;
+
+// Waits until the condition described by |request| is satisfied or
+// |deadline_ns| elapses. Returns IREE_STATUS_DEADLINE_EXCEEDED if the deadline
+// elapses first. A deadline of IREE_TIME_INFINITE_PAST polls the condition.
+typedef iree_status_t(IREE_API_PTR* iree_vm_wait_fn_t)(
+    const iree_vm_wait_request_t* request, iree_time_t deadline_ns);
+
+// A condition a yielded call is waiting on before it can make progress.
+// Implementations populate this when they would otherwise block the thread so
+// that the caller can schedule other work until the condition is satisfied.
+struct iree_vm_wait_request {
+  // Optional object retained for the lifetime of the request (such as a HAL
+  // semaphore).
+  iree_vm_ref_t object;
+  // Object-specific payload such as a semaphore timepoint.
+  uint64_t value;
+  // Waits on the condition. NULL if the call yielded voluntarily and can be
+  // resumed immediately.
+  iree_vm_wait_fn_t wait_fn;
+};
+
+// Waits until |request| is satisfied or |deadline_ns| elapses.
+// Requests without a wait function are always satisfied.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_wait_request_await(
+    const iree_vm_wait_request_t* request, iree_time_t deadline_ns);
+
+// Releases the resources held by |request| and resets it.
+IREE_API_EXPORT void IREE_API_CALL
+iree_vm_wait_request_reset(iree_vm_wait_request_t* request);
+
+enum iree_vm_execution_result_flag_e {
+  IREE_VM_EXECUTION_RESULT_FLAG_NONE = 0,
+  // The call yielded before completing and must be continued with resume_call
+  // once the |wait| request of the result has been satisfied.
+  IREE_VM_EXECUTION_RESULT_FLAG_YIELDED = 1u << 0,
+};
+typedef uint32_t iree_vm_execution_result_flags_t;
+
+// Results of a begin_call/resume_call request.
 typedef struct {
-  // TODO(benvanik): yield information.
-  // Yield modes:
-  // - yield (yield instruction)
-  // - await (with 1+ wait handles)
-  // - break
-  int reserved;
+  iree_vm_execution_result_flags_t flags;
+  // Condition the yielded call is waiting on. Ownership transfers to the
+  // caller and it must be reset with iree_vm_wait_request_reset when no
+  // longer needed. Only valid if IREE_VM_EXECUTION_RESULT_FLAG_YIELDED is set.
+  iree_vm_wait_request_t wait;
 } iree_vm_execution_result_t;
 
 // Defines an interface that can be used to reflect and execute functions on a
@@ -307,6 +346,20 @@ typedef struct iree_vm_module {
   void(IREE_API_PTR* free_state)(void* self,
                                  iree_vm_module_state_t* module_state);
 
+  // Optional: allocates module state data that shares the immutable contents
+  // of |parent_module_state|, which was allocated by this module and has had
+  // its imports resolved and initializer run in a frozen parent context with
+  // the same module list. The returned state must be ready for use without
+  // resolving imports or running initializers again and must remain valid
+  // after the parent state has been freed. Refs held by the parent state may
+  // be retained instead of copied, in which case the objects they reference
+  // are shared with the fork.
+  // Modules that do not implement this are allocated and initialized from
+  // scratch in forked contexts.
+  iree_status_t(IREE_API_PTR* fork_state)(
+      void* self, iree_vm_module_state_t* parent_module_state,
+      iree_allocator_t allocator, iree_vm_module_state_t** out_module_state);
+
   // Resolves the import with the given ordinal to |function|.
   // The function is guaranteed to remain valid for the lifetime of the module
   // state.
@@ -317,14 +370,17 @@ typedef struct iree_vm_module {
 
   // Begins a function call with the given |call| arguments.
   // Execution may yield in the case of asynchronous code and require one or
-  // more calls to the resume method to complete.
+  // more calls to the resume method to complete. Yields are only possible on
+  // stacks that have them enabled (see iree_vm_stack_set_yield_enabled).
   iree_status_t(IREE_API_PTR* begin_call)(
       void* self, iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
       iree_vm_execution_result_t* out_result);
 
-  // Resumes execution of a previously-yielded call.
+  // Resumes execution of a previously-yielded call on |stack|.
+  // |call| must be the same call passed to begin_call and its argument and
+  // result storage must remain valid until the call completes.
   iree_status_t(IREE_API_PTR* resume_call)(
-      void* self, iree_vm_stack_t* stack,
+      void* self, iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
       iree_vm_execution_result_t* out_result);
 
   // TODO(benvanik): move this/refactor.
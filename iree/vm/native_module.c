@@ -265,6 +265,19 @@ static void IREE_API_PTR iree_vm_native_module_free_state(
   assert(!module_state);
 }
 
+static iree_status_t IREE_API_PTR iree_vm_native_module_fork_state(
+    void* self, iree_vm_module_state_t* parent_module_state,
+    iree_allocator_t allocator, iree_vm_module_state_t** out_module_state) {
+  iree_vm_native_module_t* module = (iree_vm_native_module_t*)self;
+  *out_module_state = NULL;
+  if (module->user_interface.fork_state) {
+    return module->user_interface.fork_state(
+        module->self, parent_module_state, allocator, out_module_state);
+  }
+  // Stateless modules have nothing to share.
+  return iree_ok_status();
+}
+
 static iree_status_t IREE_API_PTR iree_vm_native_module_resolve_import(
     void* self, iree_vm_module_state_t* module_state, iree_host_size_t ordinal,
     const iree_vm_function_t* function,
@@ -278,24 +291,12 @@ static iree_status_t IREE_API_PTR iree_vm_native_module_resolve_import(
                           "native module does not support imports");
 }
 
-static iree_status_t IREE_API_PTR iree_vm_native_module_begin_call(
-    void* self, iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+// Calls the native function |function_ptr| implementing call->function.
+static iree_status_t iree_vm_native_module_issue_call(
+    iree_vm_native_module_t* module,
+    const iree_vm_native_function_ptr_t function_ptr, iree_vm_stack_t* stack,
+    const iree_vm_function_call_t* call,
     iree_vm_execution_result_t* out_result) {
-  iree_vm_native_module_t* module = (iree_vm_native_module_t*)self;
-  if (IREE_UNLIKELY(call->function.linkage !=
-                    IREE_VM_FUNCTION_LINKAGE_EXPORT) ||
-      IREE_UNLIKELY(call->function.ordinal >=
-                    module->descriptor->export_count)) {
-    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
-                            "function ordinal out of bounds: 0 < %u < %zu",
-                            call->function.ordinal,
-                            module->descriptor->export_count);
-  }
-  if (module->user_interface.begin_call) {
-    return module->user_interface.begin_call(module->self, stack, call,
-                                             out_result);
-  }
-
   // NOTE: VM stack is currently unused. We could stash things here for the
   // debugger or use it for coroutine state.
   iree_host_size_t frame_size = 0;
@@ -306,11 +307,9 @@ static iree_status_t IREE_API_PTR iree_vm_native_module_begin_call(
       /*frame_cleanup_fn=*/NULL, &callee_frame));
 
   // Call the target function using the shim.
-  const iree_vm_native_function_ptr_t* function_ptr =
-      &module->descriptor->functions[call->function.ordinal];
   iree_vm_module_state_t* module_state = callee_frame->module_state;
-  iree_status_t status = function_ptr->shim(stack, call, function_ptr->target,
-                                            module, module_state, out_result);
+  iree_status_t status = function_ptr.shim(stack, call, function_ptr.target,
+                                           module, module_state, out_result);
   if (IREE_UNLIKELY(!iree_status_is_ok(status))) {
     iree_string_view_t module_name = iree_vm_native_module_name(module);
     iree_string_view_t function_name = iree_string_view_empty();
@@ -322,18 +321,78 @@ static iree_status_t IREE_API_PTR iree_vm_native_module_begin_call(
                                   (int)function_name.size, function_name.data);
   }
 
+  // Functions that wait on a stack with yields enabled leave the request on
+  // the stack for us to hand back to the caller.
+  if (iree_vm_stack_take_pending_wait(stack, &out_result->wait)) {
+    out_result->flags |= IREE_VM_EXECUTION_RESULT_FLAG_YIELDED;
+  }
+
   return iree_vm_stack_function_leave(stack);
 }
 
-static iree_status_t IREE_API_PTR
-iree_vm_native_module_resume_call(void* self, iree_vm_stack_t* stack,
-                                  iree_vm_execution_result_t* out_result) {
+static iree_status_t IREE_API_PTR iree_vm_native_module_begin_call(
+    void* self, iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_execution_result_t* out_result) {
+  iree_vm_native_module_t* module = (iree_vm_native_module_t*)self;
+  memset(out_result, 0, sizeof(*out_result));
+  if (IREE_UNLIKELY(call->function.linkage !=
+                    IREE_VM_FUNCTION_LINKAGE_EXPORT) ||
+      IREE_UNLIKELY(call->function.ordinal >=
+                    module->descriptor->export_count)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "function ordinal out of bounds: 0 < %u < %zu",
+                            call->function.ordinal,
+                            module->descriptor->export_count);
+  }
+  if (module->user_interface.begin_call) {
+    return module->user_interface.begin_call(module->self, stack, call,
+                                             out_result);
+  }
+  return iree_vm_native_module_issue_call(
+      module, module->descriptor->functions[call->function.ordinal], stack,
+      call, out_result);
+}
+
+IREE_API_EXPORT bool IREE_API_CALL iree_vm_native_module_lookup_function_ptr(
+    const iree_vm_function_t* function,
+    iree_vm_native_function_ptr_t* out_function_ptr) {
+  memset(out_function_ptr, 0, sizeof(*out_function_ptr));
+  if (!function->module ||
+      function->module->begin_call != iree_vm_native_module_begin_call) {
+    return false;  // not a native module
+  }
+  iree_vm_native_module_t* module =
+      (iree_vm_native_module_t*)function->module->self;
+  if (module->user_interface.begin_call ||
+      function->linkage != IREE_VM_FUNCTION_LINKAGE_EXPORT ||
+      function->ordinal >= module->descriptor->export_count) {
+    return false;
+  }
+  *out_function_ptr = module->descriptor->functions[function->ordinal];
+  return true;
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_native_module_call_direct(
+    iree_vm_native_function_ptr_t function_ptr, iree_vm_stack_t* stack,
+    const iree_vm_function_call_t* call,
+    iree_vm_execution_result_t* out_result) {
+  memset(out_result, 0, sizeof(*out_result));
+  return iree_vm_native_module_issue_call(
+      (iree_vm_native_module_t*)call->function.module->self, function_ptr,
+      stack, call, out_result);
+}
+
+static iree_status_t IREE_API_PTR iree_vm_native_module_resume_call(
+    void* self, iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_execution_result_t* out_result) {
   iree_vm_native_module_t* module = (iree_vm_native_module_t*)self;
   if (module->user_interface.resume_call) {
-    return module->user_interface.resume_call(module->self, stack, out_result);
+    return module->user_interface.resume_call(module->self, stack, call,
+                                              out_result);
   }
-  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
-                          "native module does not support resume");
+  // Native functions keep no state across yields and are called again with
+  // the same arguments once the wait they yielded on has been satisfied.
+  return iree_vm_native_module_begin_call(self, stack, call, out_result);
 }
 
 IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_native_module_create(
@@ -429,6 +488,12 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_native_module_initialize(
       iree_vm_native_module_lookup_function;
   module->base_interface.alloc_state = iree_vm_native_module_alloc_state;
   module->base_interface.free_state = iree_vm_native_module_free_state;
+  // Modules with user state can only be forked if they opt in; otherwise
+  // forked contexts allocate and initialize their state from scratch.
+  if (module->user_interface.fork_state ||
+      !module->user_interface.alloc_state) {
+    module->base_interface.fork_state = iree_vm_native_module_fork_state;
+  }
   module->base_interface.resolve_import = iree_vm_native_module_resolve_import;
   module->base_interface.begin_call = iree_vm_native_module_begin_call;
   module->base_interface.resume_call = iree_vm_native_module_resume_call;
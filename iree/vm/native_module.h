@@ -128,6 +128,24 @@ IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_native_module_initialize(
     const iree_vm_native_module_descriptor_t* module_descriptor,
     iree_allocator_t allocator, iree_vm_module_t* module);
 
+// Looks up the shim and target implementing |function| if it is an export of a
+// native module using the default begin_call implementation. Callers that
+// repeatedly call the function (such as bytecode modules calling their
+// imports) can resolve it once and then issue calls with
+// iree_vm_native_module_call_direct. Returns false if the function cannot be
+// called directly and must be called with begin_call.
+IREE_API_EXPORT bool IREE_API_CALL iree_vm_native_module_lookup_function_ptr(
+    const iree_vm_function_t* function,
+    iree_vm_native_function_ptr_t* out_function_ptr);
+
+// Calls |function_ptr| as returned by iree_vm_native_module_lookup_function_ptr
+// for call->function. Behaves the same as begin_call on the native module
+// without the function lookup and indirection through the module interface.
+IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_native_module_call_direct(
+    iree_vm_native_function_ptr_t function_ptr, iree_vm_stack_t* stack,
+    const iree_vm_function_call_t* call,
+    iree_vm_execution_result_t* out_result);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -12,16 +12,294 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <cstring>
+
+#include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
 #include "iree/base/api.h"
 #include "iree/base/logging.h"
+#include "iree/vm/api.h"
+#include "iree/vm/bytecode_module.h"
 #include "iree/vm/module.h"
 #include "iree/vm/native_module.h"
+#include "iree/vm/native_module_benchmark_module.h"
 #include "iree/vm/native_module_test.h"
 #include "iree/vm/stack.h"
 
 namespace {
 
-// TODO(benvanik): native module benchmarks.
+//===----------------------------------------------------------------------===//
+// native_import_module
+//===----------------------------------------------------------------------===//
+// Exports functions with signatures covering the shapes of common imports.
+// Arguments are read from the ABI buffer directly as packed by the caller.
+
+template <typename T>
+static T ReadArgument(const iree_vm_function_call_t* call,
+                      iree_host_size_t offset) {
+  T value;
+  std::memcpy(&value, call->arguments.data + offset, sizeof(value));
+  return value;
+}
+
+template <typename T>
+static void WriteResult(const iree_vm_function_call_t* call, T value) {
+  std::memcpy(call->results.data, &value, sizeof(value));
+}
+
+// vm.import @native_import_module.add_1(%arg0 : i32) -> i32
+static iree_status_t native_import_module_add_1(
+    iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_native_function_target_t target_fn, void* module,
+    void* module_state, iree_vm_execution_result_t* out_result) {
+  WriteResult<int32_t>(call, ReadArgument<int32_t>(call, 0) + 1);
+  return iree_ok_status();
+}
+
+// vm.import @native_import_module.sum_rii(%list, %a : i32, %b : i32) -> i32
+static iree_status_t native_import_module_sum_rii(
+    iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_native_function_target_t target_fn, void* module,
+    void* module_state, iree_vm_execution_result_t* out_result) {
+  const iree_host_size_t offset = sizeof(iree_vm_ref_t);
+  WriteResult<int32_t>(call, ReadArgument<int32_t>(call, offset) +
+                                 ReadArgument<int32_t>(call, offset + 4));
+  return iree_ok_status();
+}
+
+// vm.import @native_import_module.sum_iri(%a : i32, %list, %b : i32) -> i32
+static iree_status_t native_import_module_sum_iri(
+    iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_native_function_target_t target_fn, void* module,
+    void* module_state, iree_vm_execution_result_t* out_result) {
+  const iree_host_size_t offset = 4 + sizeof(iree_vm_ref_t);
+  WriteResult<int32_t>(call, ReadArgument<int32_t>(call, 0) +
+                                 ReadArgument<int32_t>(call, offset));
+  return iree_ok_status();
+}
+
+// vm.import @native_import_module.dispatch(%a, %b, %x, %y, %z, %w)
+static iree_status_t native_import_module_dispatch(
+    iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_native_function_target_t target_fn, void* module,
+    void* module_state, iree_vm_execution_result_t* out_result) {
+  const iree_host_size_t offset = 2 * sizeof(iree_vm_ref_t);
+  for (int i = 0; i < 4; ++i) {
+    benchmark::DoNotOptimize(ReadArgument<int32_t>(call, offset + i * 4));
+  }
+  return iree_ok_status();
+}
+
+// vm.import @native_import_module.retain(%list) -> !vm.list<i32>
+static iree_status_t native_import_module_retain(
+    iree_vm_stack_t* stack, const iree_vm_function_call_t* call,
+    iree_vm_native_function_target_t target_fn, void* module,
+    void* module_state, iree_vm_execution_result_t* out_result) {
+  iree_vm_ref_retain(reinterpret_cast<iree_vm_ref_t*>(call->arguments.data),
+                     reinterpret_cast<iree_vm_ref_t*>(call->results.data));
+  return iree_ok_status();
+}
+
+static const iree_vm_native_export_descriptor_t
+    native_import_module_exports_[] = {
+        {iree_make_cstring_view("add_1"), iree_make_cstring_view("0i_i"), 0,
+         NULL},
+        {iree_make_cstring_view("dispatch"),
+         iree_make_cstring_view("0rriiii_v"), 0, NULL},
+        {iree_make_cstring_view("retain"), iree_make_cstring_view("0r_r"), 0,
+         NULL},
+        {iree_make_cstring_view("sum_iri"), iree_make_cstring_view("0iri_i"),
+         0, NULL},
+        {iree_make_cstring_view("sum_rii"), iree_make_cstring_view("0rii_i"),
+         0, NULL},
+};
+static const iree_vm_native_function_ptr_t native_import_module_funcs_[] = {
+    {(iree_vm_native_function_shim_t)native_import_module_add_1, NULL},
+    {(iree_vm_native_function_shim_t)native_import_module_dispatch, NULL},
+    {(iree_vm_native_function_shim_t)native_import_module_retain, NULL},
+    {(iree_vm_native_function_shim_t)native_import_module_sum_iri, NULL},
+    {(iree_vm_native_function_shim_t)native_import_module_sum_rii, NULL},
+};
+static_assert(IREE_ARRAYSIZE(native_import_module_funcs_) ==
+                  IREE_ARRAYSIZE(native_import_module_exports_),
+              "function pointer table must be 1:1 with exports");
+static const iree_vm_native_module_descriptor_t
+    native_import_module_descriptor_ = {
+        iree_make_cstring_view("native_import_module"),
+        0,
+        NULL,
+        IREE_ARRAYSIZE(native_import_module_exports_),
+        native_import_module_exports_,
+        IREE_ARRAYSIZE(native_import_module_funcs_),
+        native_import_module_funcs_,
+        0,
+        NULL,
+};
+
+static iree_status_t native_import_module_create(
+    iree_allocator_t allocator, iree_vm_module_t** out_module) {
+  iree_vm_module_t interface;
+  IREE_RETURN_IF_ERROR(iree_vm_module_initialize(&interface, NULL));
+  return iree_vm_native_module_create(
+      &interface, &native_import_module_descriptor_, allocator, out_module);
+}
+
+//===----------------------------------------------------------------------===//
+// Benchmarks
+//===----------------------------------------------------------------------===//
+
+// Benchmarks calling a native function directly through the module interface
+// or, if |direct| is set, through its shim as bytecode modules do for imports.
+// This is the floor for the cost of any import call.
+static void RunNativeCalls(benchmark::State& state, bool direct) {
+  iree_vm_instance_t* instance = NULL;
+  IREE_CHECK_OK(iree_vm_instance_create(iree_allocator_system(), &instance));
+  iree_vm_module_t* module = NULL;
+  IREE_CHECK_OK(module_a_create(iree_allocator_system(), &module));
+  iree_vm_context_t* context = NULL;
+  IREE_CHECK_OK(iree_vm_context_create_with_modules(
+      instance, &module, 1, iree_allocator_system(), &context));
+
+  iree_vm_function_t function;
+  IREE_CHECK_OK(iree_vm_context_resolve_function(
+      context, iree_make_cstring_view("module_a.add_1"), &function));
+  iree_vm_native_function_ptr_t function_ptr;
+  IREE_CHECK(iree_vm_native_module_lookup_function_ptr(&function,
+                                                       &function_ptr));
+
+  iree_vm_function_call_t call;
+  memset(&call, 0, sizeof(call));
+  call.function = function;
+  int32_t argument = 0;
+  int32_t result = 0;
+  call.arguments = iree_make_byte_span(reinterpret_cast<uint8_t*>(&argument),
+                                       sizeof(argument));
+  call.results = iree_make_byte_span(reinterpret_cast<uint8_t*>(&result),
+                                     sizeof(result));
+
+  IREE_VM_INLINE_STACK_INITIALIZE(
+      stack, iree_vm_context_state_resolver(context), iree_allocator_system());
+  while (state.KeepRunning()) {
+    iree_vm_execution_result_t execution_result;
+    if (direct) {
+      IREE_CHECK_OK(iree_vm_native_module_call_direct(
+          function_ptr, stack, &call, &execution_result));
+    } else {
+      IREE_CHECK_OK(
+          module->begin_call(module->self, stack, &call, &execution_result));
+    }
+    argument = result;
+  }
+  iree_vm_stack_deinitialize(stack);
+
+  iree_vm_module_release(module);
+  iree_vm_context_release(context);
+  iree_vm_instance_release(instance);
+}
+
+static void BM_NativeCallI32(benchmark::State& state) {
+  RunNativeCalls(state, /*direct=*/false);
+}
+BENCHMARK(BM_NativeCallI32);
+
+static void BM_NativeCallDirectI32(benchmark::State& state) {
+  RunNativeCalls(state, /*direct=*/true);
+}
+BENCHMARK(BM_NativeCallDirectI32);
+
+// Benchmarks the given exported bytecode function that makes |call_count|
+// calls to native_import_module.
+static iree_status_t RunImportCalls(benchmark::State& state,
+                                    absl::string_view function_name,
+                                    int64_t call_count) {
+  iree_vm_instance_t* instance = NULL;
+  IREE_CHECK_OK(iree_vm_instance_create(iree_allocator_system(), &instance));
+
+  iree_vm_module_t* import_module = NULL;
+  IREE_CHECK_OK(
+      native_import_module_create(iree_allocator_system(), &import_module));
+
+  const auto* module_file_toc =
+      iree::vm::native_module_benchmark_module_create();
+  iree_vm_module_t* bytecode_module = nullptr;
+  IREE_CHECK_OK(iree_vm_bytecode_module_create(
+      iree_const_byte_span_t{
+          reinterpret_cast<const uint8_t*>(module_file_toc->data),
+          module_file_toc->size},
+      iree_allocator_null(), iree_allocator_system(), &bytecode_module));
+
+  std::array<iree_vm_module_t*, 2> modules = {import_module, bytecode_module};
+  iree_vm_context_t* context = NULL;
+  IREE_CHECK_OK(iree_vm_context_create_with_modules(
+      instance, modules.data(), modules.size(), iree_allocator_system(),
+      &context));
+
+  iree_vm_function_t function;
+  IREE_CHECK_OK(iree_vm_context_resolve_function(
+      context,
+      iree_make_string_view(function_name.data(), function_name.size()),
+      &function));
+
+  iree_vm_function_call_t call;
+  memset(&call, 0, sizeof(call));
+  call.function = function;
+  int32_t argument = 0;
+  int32_t result = 0;
+  call.arguments = iree_make_byte_span(reinterpret_cast<uint8_t*>(&argument),
+                                       sizeof(argument));
+  call.results = iree_make_byte_span(reinterpret_cast<uint8_t*>(&result),
+                                     sizeof(result));
+
+  IREE_VM_INLINE_STACK_INITIALIZE(
+      stack, iree_vm_context_state_resolver(context), iree_allocator_system());
+  while (state.KeepRunningBatch(call_count)) {
+    argument = 1;
+    iree_vm_execution_result_t execution_result;
+    IREE_CHECK_OK(bytecode_module->begin_call(bytecode_module->self, stack,
+                                              &call, &execution_result));
+    benchmark::DoNotOptimize(result);
+  }
+  iree_vm_stack_deinitialize(stack);
+
+  iree_vm_module_release(import_module);
+  iree_vm_module_release(bytecode_module);
+  iree_vm_context_release(context);
+  iree_vm_instance_release(instance);
+
+  return iree_ok_status();
+}
+
+static void BM_ImportCallI32(benchmark::State& state) {
+  IREE_CHECK_OK(RunImportCalls(state, "native_module_benchmark.call_i32",
+                               /*call_count=*/16));
+}
+BENCHMARK(BM_ImportCallI32);
+
+static void BM_ImportCallRefI32I32(benchmark::State& state) {
+  IREE_CHECK_OK(RunImportCalls(state, "native_module_benchmark.call_rii",
+                               /*call_count=*/16));
+}
+BENCHMARK(BM_ImportCallRefI32I32);
+
+// Same as BM_ImportCallRefI32I32 but with a signature that requires the
+// cconv-interpreting marshaling path.
+static void BM_ImportCallI32RefI32(benchmark::State& state) {
+  IREE_CHECK_OK(RunImportCalls(state, "native_module_benchmark.call_iri",
+                               /*call_count=*/16));
+}
+BENCHMARK(BM_ImportCallI32RefI32);
+
+static void BM_ImportCallDispatch(benchmark::State& state) {
+  IREE_CHECK_OK(RunImportCalls(state, "native_module_benchmark.call_dispatch",
+                               /*call_count=*/16));
+}
+BENCHMARK(BM_ImportCallDispatch);
+
+static void BM_ImportCallRetainRef(benchmark::State& state) {
+  IREE_CHECK_OK(RunImportCalls(state, "native_module_benchmark.call_retain",
+                               /*call_count=*/16));
+}
+BENCHMARK(BM_ImportCallRetainRef);
 
 }  // namespace
@@ -0,0 +1,128 @@
+// Calls from bytecode into native module imports of various signatures.
+// Each function makes 16 calls such that the per-call cost can be derived.
+vm.module @native_module_benchmark {
+  vm.import @native_import_module.add_1(%arg0 : i32) -> i32
+  vm.import @native_import_module.sum_rii(
+      %list : !vm.list<i32>, %a : i32, %b : i32) -> i32
+  vm.import @native_import_module.sum_iri(
+      %a : i32, %list : !vm.list<i32>, %b : i32) -> i32
+  vm.import @native_import_module.dispatch(
+      %a : !vm.list<i32>, %b : !vm.list<i32>,
+      %x : i32, %y : i32, %z : i32, %w : i32)
+  vm.import @native_import_module.retain(%list : !vm.list<i32>) -> !vm.list<i32>
+
+  // (i32) -> i32 calls.
+  vm.export @call_i32
+  vm.func @call_i32(%arg0 : i32) -> i32 {
+    %0 = vm.call @native_import_module.add_1(%arg0) : (i32) -> i32
+    %1 = vm.call @native_import_module.add_1(%0) : (i32) -> i32
+    %2 = vm.call @native_import_module.add_1(%1) : (i32) -> i32
+    %3 = vm.call @native_import_module.add_1(%2) : (i32) -> i32
+    %4 = vm.call @native_import_module.add_1(%3) : (i32) -> i32
+    %5 = vm.call @native_import_module.add_1(%4) : (i32) -> i32
+    %6 = vm.call @native_import_module.add_1(%5) : (i32) -> i32
+    %7 = vm.call @native_import_module.add_1(%6) : (i32) -> i32
+    %8 = vm.call @native_import_module.add_1(%7) : (i32) -> i32
+    %9 = vm.call @native_import_module.add_1(%8) : (i32) -> i32
+    %10 = vm.call @native_import_module.add_1(%9) : (i32) -> i32
+    %11 = vm.call @native_import_module.add_1(%10) : (i32) -> i32
+    %12 = vm.call @native_import_module.add_1(%11) : (i32) -> i32
+    %13 = vm.call @native_import_module.add_1(%12) : (i32) -> i32
+    %14 = vm.call @native_import_module.add_1(%13) : (i32) -> i32
+    %15 = vm.call @native_import_module.add_1(%14) : (i32) -> i32
+    vm.return %15 : i32
+  }
+
+  // (ref, i32, i32) -> i32 calls that take the direct marshaling path.
+  vm.export @call_rii
+  vm.func @call_rii(%arg0 : i32) -> i32 {
+    %list = vm.list.alloc %arg0 : (i32) -> !vm.list<i32>
+    %0 = vm.call @native_import_module.sum_rii(%list, %arg0, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %1 = vm.call @native_import_module.sum_rii(%list, %0, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %2 = vm.call @native_import_module.sum_rii(%list, %1, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %3 = vm.call @native_import_module.sum_rii(%list, %2, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %4 = vm.call @native_import_module.sum_rii(%list, %3, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %5 = vm.call @native_import_module.sum_rii(%list, %4, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %6 = vm.call @native_import_module.sum_rii(%list, %5, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %7 = vm.call @native_import_module.sum_rii(%list, %6, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %8 = vm.call @native_import_module.sum_rii(%list, %7, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %9 = vm.call @native_import_module.sum_rii(%list, %8, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %10 = vm.call @native_import_module.sum_rii(%list, %9, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %11 = vm.call @native_import_module.sum_rii(%list, %10, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %12 = vm.call @native_import_module.sum_rii(%list, %11, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %13 = vm.call @native_import_module.sum_rii(%list, %12, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %14 = vm.call @native_import_module.sum_rii(%list, %13, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    %15 = vm.call @native_import_module.sum_rii(%list, %14, %arg0) : (!vm.list<i32>, i32, i32) -> i32
+    vm.return %15 : i32
+  }
+
+  // (i32, ref, i32) -> i32 calls that must interpret the cconv string as
+  // refs are interleaved with i32s. Otherwise identical to @call_rii.
+  vm.export @call_iri
+  vm.func @call_iri(%arg0 : i32) -> i32 {
+    %list = vm.list.alloc %arg0 : (i32) -> !vm.list<i32>
+    %0 = vm.call @native_import_module.sum_iri(%arg0, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %1 = vm.call @native_import_module.sum_iri(%0, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %2 = vm.call @native_import_module.sum_iri(%1, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %3 = vm.call @native_import_module.sum_iri(%2, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %4 = vm.call @native_import_module.sum_iri(%3, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %5 = vm.call @native_import_module.sum_iri(%4, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %6 = vm.call @native_import_module.sum_iri(%5, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %7 = vm.call @native_import_module.sum_iri(%6, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %8 = vm.call @native_import_module.sum_iri(%7, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %9 = vm.call @native_import_module.sum_iri(%8, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %10 = vm.call @native_import_module.sum_iri(%9, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %11 = vm.call @native_import_module.sum_iri(%10, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %12 = vm.call @native_import_module.sum_iri(%11, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %13 = vm.call @native_import_module.sum_iri(%12, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %14 = vm.call @native_import_module.sum_iri(%13, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    %15 = vm.call @native_import_module.sum_iri(%14, %list, %arg0) : (i32, !vm.list<i32>, i32) -> i32
+    vm.return %15 : i32
+  }
+
+  // (ref, ref, i32, i32, i32, i32) -> () calls shaped like HAL dispatches.
+  vm.export @call_dispatch
+  vm.func @call_dispatch(%arg0 : i32) -> i32 {
+    %list = vm.list.alloc %arg0 : (i32) -> !vm.list<i32>
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.call @native_import_module.dispatch(%list, %list, %arg0, %arg0, %arg0, %arg0) : (!vm.list<i32>, !vm.list<i32>, i32, i32, i32, i32) -> ()
+    vm.return %arg0 : i32
+  }
+
+  // (ref) -> ref calls that retain their argument into the result.
+  vm.export @call_retain
+  vm.func @call_retain(%arg0 : i32) -> i32 {
+    %list = vm.list.alloc %arg0 : (i32) -> !vm.list<i32>
+    %l0 = vm.call @native_import_module.retain(%list) : (!vm.list<i32>) -> !vm.list<i32>
+    %l1 = vm.call @native_import_module.retain(%l0) : (!vm.list<i32>) -> !vm.list<i32>
+    %l2 = vm.call @native_import_module.retain(%l1) : (!vm.list<i32>) -> !vm.list<i32>
+    %l3 = vm.call @native_import_module.retain(%l2) : (!vm.list<i32>) -> !vm.list<i32>
+    %l4 = vm.call @native_import_module.retain(%l3) : (!vm.list<i32>) -> !vm.list<i32>
+    %l5 = vm.call @native_import_module.retain(%l4) : (!vm.list<i32>) -> !vm.list<i32>
+    %l6 = vm.call @native_import_module.retain(%l5) : (!vm.list<i32>) -> !vm.list<i32>
+    %l7 = vm.call @native_import_module.retain(%l6) : (!vm.list<i32>) -> !vm.list<i32>
+    %l8 = vm.call @native_import_module.retain(%l7) : (!vm.list<i32>) -> !vm.list<i32>
+    %l9 = vm.call @native_import_module.retain(%l8) : (!vm.list<i32>) -> !vm.list<i32>
+    %l10 = vm.call @native_import_module.retain(%l9) : (!vm.list<i32>) -> !vm.list<i32>
+    %l11 = vm.call @native_import_module.retain(%l10) : (!vm.list<i32>) -> !vm.list<i32>
+    %l12 = vm.call @native_import_module.retain(%l11) : (!vm.list<i32>) -> !vm.list<i32>
+    %l13 = vm.call @native_import_module.retain(%l12) : (!vm.list<i32>) -> !vm.list<i32>
+    %l14 = vm.call @native_import_module.retain(%l13) : (!vm.list<i32>) -> !vm.list<i32>
+    %l15 = vm.call @native_import_module.retain(%l14) : (!vm.list<i32>) -> !vm.list<i32>
+    vm.return %arg0 : i32
+  }
+}
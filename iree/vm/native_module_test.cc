@@ -21,7 +21,9 @@
 #include "iree/vm/instance.h"
 #include "iree/vm/invocation.h"
 #include "iree/vm/list.h"
+#include "iree/vm/native_module.h"
 #include "iree/vm/ref_cc.h"
+#include "iree/vm/stack.h"
 
 namespace iree {
 namespace {
@@ -61,12 +63,17 @@ class VMNativeModuleTest : public ::testing::Test {
 
   StatusOr<int32_t> RunFunction(iree_string_view_t function_name,
                                 int32_t arg0) {
+    return RunFunction(context_, function_name, arg0);
+  }
+
+  StatusOr<int32_t> RunFunction(iree_vm_context_t* context,
+                                iree_string_view_t function_name,
+                                int32_t arg0) {
     // Lookup the entry function. This can be cached in an application if
     // multiple calls will be made.
     iree_vm_function_t function;
     IREE_RETURN_IF_ERROR(
-        iree_vm_context_resolve_function(
-            context_, iree_make_cstring_view("module_b.entry"), &function),
+        iree_vm_context_resolve_function(context, function_name, &function),
         "unable to resolve entry point");
 
     // Setup I/O lists and pass in the argument. The result list will be
@@ -82,7 +89,7 @@ class VMNativeModuleTest : public ::testing::Test {
         /*element_type=*/nullptr, 1, iree_allocator_system(), &output_list));
 
     // Invoke the entry function to do our work. Runs synchronously.
-    IREE_RETURN_IF_ERROR(iree_vm_invoke(context_, function,
+    IREE_RETURN_IF_ERROR(iree_vm_invoke(context, function,
                                         /*policy=*/nullptr, input_list.get(),
                                         output_list.get(),
                                         iree_allocator_system()));
@@ -94,6 +101,15 @@ class VMNativeModuleTest : public ::testing::Test {
     return ret0_value.i32;
   }
 
+  iree_vm_instance_t* instance() const { return instance_; }
+  iree_vm_context_t* context() const { return context_; }
+
+  // Releases the fixture context early, e.g. to check that forks outlive it.
+  void ReleaseContext() {
+    iree_vm_context_release(context_);
+    context_ = nullptr;
+  }
+
  private:
   iree_vm_instance_t* instance_ = nullptr;
   iree_vm_context_t* context_ = nullptr;
@@ -111,5 +127,129 @@ TEST_F(VMNativeModuleTest, Example) {
   ASSERT_EQ(v2, 8);
 }
 
+// Tests that exports of native modules can be called through their shims
+// directly and behave the same as when called through begin_call.
+TEST_F(VMNativeModuleTest, CallDirect) {
+  iree_vm_function_t function;
+  IREE_ASSERT_OK(iree_vm_context_resolve_function(
+      context(), iree_make_cstring_view("module_b.entry"), &function));
+  iree_vm_native_function_ptr_t function_ptr;
+  ASSERT_TRUE(iree_vm_native_module_lookup_function_ptr(&function,
+                                                        &function_ptr));
+  EXPECT_NE(nullptr, function_ptr.shim);
+
+  IREE_VM_INLINE_STACK_INITIALIZE(stack,
+                                  iree_vm_context_state_resolver(context()),
+                                  iree_allocator_system());
+  int32_t arg0 = 1;
+  int32_t ret0 = 0;
+  iree_vm_function_call_t call;
+  call.function = function;
+  call.arguments = iree_make_byte_span(&arg0, sizeof(arg0));
+  call.results = iree_make_byte_span(&ret0, sizeof(ret0));
+  iree_vm_execution_result_t result;
+  IREE_ASSERT_OK(
+      iree_vm_native_module_call_direct(function_ptr, stack, &call, &result));
+  EXPECT_EQ(1, ret0);
+  arg0 = 2;
+  IREE_ASSERT_OK(
+      iree_vm_native_module_call_direct(function_ptr, stack, &call, &result));
+  EXPECT_EQ(4, ret0);
+  iree_vm_stack_deinitialize(stack);
+
+  // The state updated by the direct calls is shared with begin_call.
+  IREE_ASSERT_OK_AND_ASSIGN(
+      int32_t v0, RunFunction(iree_make_cstring_view("module_b.entry"), 3));
+  EXPECT_EQ(8, v0);
+
+  // Only exports can be called directly.
+  iree_vm_function_t invalid_function = function;
+  invalid_function.ordinal = 1000;
+  EXPECT_FALSE(iree_vm_native_module_lookup_function_ptr(&invalid_function,
+                                                         &function_ptr));
+  EXPECT_EQ(nullptr, function_ptr.shim);
+}
+
+// Tests that forked contexts start from the state of the frozen parent and
+// then diverge independently.
+TEST_F(VMNativeModuleTest, Fork) {
+  auto entry = iree_make_cstring_view("module_b.entry");
+  IREE_ASSERT_OK_AND_ASSIGN(int32_t v0, RunFunction(entry, 1));
+  ASSERT_EQ(v0, 1);
+  IREE_ASSERT_OK_AND_ASSIGN(int32_t v1, RunFunction(entry, 2));
+  ASSERT_EQ(v1, 4);
+
+  // Only frozen contexts can be forked.
+  iree_vm_context_t* fork = nullptr;
+  EXPECT_EQ(IREE_STATUS_FAILED_PRECONDITION,
+            iree_status_consume_code(iree_vm_context_fork(
+                context(), iree_allocator_system(), &fork)));
+  iree_vm_context_freeze(context());
+  EXPECT_TRUE(iree_vm_context_is_frozen(context()));
+  IREE_ASSERT_OK(
+      iree_vm_context_fork(context(), iree_allocator_system(), &fork));
+  EXPECT_TRUE(iree_vm_context_is_frozen(fork));
+  EXPECT_NE(iree_vm_context_id(context()), iree_vm_context_id(fork));
+
+  IREE_ASSERT_OK_AND_ASSIGN(int32_t f0, RunFunction(fork, entry, 3));
+  ASSERT_EQ(f0, 8);
+  IREE_ASSERT_OK_AND_ASSIGN(int32_t f1, RunFunction(fork, entry, 3));
+  ASSERT_EQ(f1, 12);
+
+  // The parent is unaffected by calls on the fork and vice versa.
+  IREE_ASSERT_OK_AND_ASSIGN(int32_t v2, RunFunction(entry, 3));
+  ASSERT_EQ(v2, 8);
+
+  // Forks outlive their parent.
+  ReleaseContext();
+  IREE_ASSERT_OK_AND_ASSIGN(int32_t f2, RunFunction(fork, entry, 3));
+  ASSERT_EQ(f2, 16);
+  iree_vm_context_release(fork);
+}
+
+// Tests that modules that do not support forking are initialized from scratch
+// in forked contexts.
+TEST_F(VMNativeModuleTest, ForkUnsupportedModule) {
+  iree_vm_module_t* module_a = nullptr;
+  IREE_ASSERT_OK(module_a_create(iree_allocator_system(), &module_a));
+  iree_vm_module_t* module_b = nullptr;
+  IREE_ASSERT_OK(module_b_create(iree_allocator_system(), &module_b));
+  module_b->fork_state = nullptr;
+  std::vector<iree_vm_module_t*> modules = {module_a, module_b};
+  iree_vm_context_t* parent = nullptr;
+  IREE_ASSERT_OK(iree_vm_context_create_with_modules(
+      instance(), modules.data(), modules.size(), iree_allocator_system(),
+      &parent));
+  iree_vm_module_release(module_a);
+  iree_vm_module_release(module_b);
+
+  auto entry = iree_make_cstring_view("module_b.entry");
+  IREE_ASSERT_OK_AND_ASSIGN(int32_t v0, RunFunction(parent, entry, 1));
+  ASSERT_EQ(v0, 1);
+  iree_vm_context_freeze(parent);
+  iree_vm_context_t* fork = nullptr;
+  IREE_ASSERT_OK(iree_vm_context_fork(parent, iree_allocator_system(), &fork));
+  IREE_ASSERT_OK_AND_ASSIGN(int32_t f0, RunFunction(fork, entry, 1));
+  ASSERT_EQ(f0, 1);
+
+  iree_vm_context_release(parent);
+  iree_vm_context_release(fork);
+}
+
+// Tests that frozen contexts reject new modules.
+TEST_F(VMNativeModuleTest, FreezeRejectsRegistration) {
+  iree_vm_context_t* context = nullptr;
+  IREE_ASSERT_OK(
+      iree_vm_context_create(instance(), iree_allocator_system(), &context));
+  iree_vm_context_freeze(context);
+  iree_vm_module_t* module_a = nullptr;
+  IREE_ASSERT_OK(module_a_create(iree_allocator_system(), &module_a));
+  EXPECT_EQ(IREE_STATUS_FAILED_PRECONDITION,
+            iree_status_consume_code(
+                iree_vm_context_register_modules(context, &module_a, 1)));
+  iree_vm_module_release(module_a);
+  iree_vm_context_release(context);
+}
+
 }  // namespace
 }  // namespace iree
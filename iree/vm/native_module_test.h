@@ -192,6 +192,23 @@ module_b_alloc_state(void* self, iree_allocator_t allocator,
   return iree_ok_status();
 }
 
+// Allocates per-context state for a context forked from a frozen parent.
+// Resolved imports are valid in the fork as it has the same module list and
+// the user state continues from where the parent left off.
+static iree_status_t IREE_API_PTR
+module_b_fork_state(void* self, iree_vm_module_state_t* parent_module_state,
+                    iree_allocator_t allocator,
+                    iree_vm_module_state_t** out_module_state) {
+  module_b_state_t* parent_state = (module_b_state_t*)parent_module_state;
+  module_b_state_t* state = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_allocator_malloc(allocator, sizeof(*state), (void**)&state));
+  memcpy(state, parent_state, sizeof(*state));
+  state->allocator = allocator;
+  *out_module_state = (iree_vm_module_state_t*)state;
+  return iree_ok_status();
+}
+
 // Frees the per-context state.
 static void IREE_API_PTR
 module_b_free_state(void* self, iree_vm_module_state_t* module_state) {
@@ -306,6 +323,7 @@ static iree_status_t module_b_create(iree_allocator_t allocator,
   interface.destroy = module_b_destroy;
   interface.alloc_state = module_b_alloc_state;
   interface.free_state = module_b_free_state;
+  interface.fork_state = module_b_fork_state;
   interface.resolve_import = module_b_resolve_import;
   return iree_vm_native_module_create(&interface, &module_b_descriptor_,
                                       allocator, out_module);
@@ -15,6 +15,7 @@
 #ifndef IREE_VM_OPS_H_
 #define IREE_VM_OPS_H_
 
+#include <math.h>
 #include <stdint.h>
 
 #include "iree/base/api.h"
@@ -139,6 +140,21 @@ static inline iree_status_t vm_fail_or_ok(int32_t status_code,
   return iree_ok_status();
 }
 
+//===------------------------------------------------------------------===//
+// ExtI64: Globals
+//===------------------------------------------------------------------===//
+
+static inline int64_t vm_global_load_i64(uint8_t* base, uint32_t byte_offset) {
+  const int64_t* global_ptr = (const int64_t*)(base + byte_offset);
+  return *global_ptr;
+}
+
+static inline void vm_global_store_i64(uint8_t* base, uint32_t byte_offset,
+                                       int64_t value) {
+  int64_t* global_ptr = (int64_t*)(base + byte_offset);
+  *global_ptr = value;
+}
+
 //===------------------------------------------------------------------===//
 // ExtI64: Conditional assignment
 //===------------------------------------------------------------------===//
@@ -222,4 +238,141 @@ static inline int32_t vm_cmp_nz_i64(int64_t operand) {
   return (operand != 0) ? 1 : 0;
 }
 
+//===------------------------------------------------------------------===//
+// ExtF32: Conditional assignment
+//===------------------------------------------------------------------===//
+
+static inline float vm_select_f32(int32_t condition, float true_value,
+                                  float false_value) {
+  return condition ? true_value : false_value;
+}
+
+//===------------------------------------------------------------------===//
+// ExtF32: Native floating-point arithmetic
+//===------------------------------------------------------------------===//
+
+static inline float vm_add_f32(float lhs, float rhs) { return lhs + rhs; }
+static inline float vm_sub_f32(float lhs, float rhs) { return lhs - rhs; }
+static inline float vm_mul_f32(float lhs, float rhs) { return lhs * rhs; }
+static inline float vm_div_f32(float lhs, float rhs) { return lhs / rhs; }
+static inline float vm_rem_f32(float lhs, float rhs) { return fmodf(lhs, rhs); }
+static inline float vm_abs_f32(float operand) { return fabsf(operand); }
+static inline float vm_neg_f32(float operand) { return -operand; }
+static inline float vm_ceil_f32(float operand) { return ceilf(operand); }
+static inline float vm_floor_f32(float operand) { return floorf(operand); }
+
+//===------------------------------------------------------------------===//
+// ExtF32: Casting and type conversion/emulation
+//===------------------------------------------------------------------===//
+
+static inline float vm_cast_si32f32(int32_t operand) { return (float)operand; }
+static inline float vm_cast_ui32f32(int32_t operand) {
+  return (float)(uint32_t)operand;
+}
+// Float to integer casts saturate: NaN converts to 0 and values outside of the
+// integer range clamp to its limits. A plain C cast is undefined behavior for
+// those and produces different results across architectures.
+static inline int32_t vm_cast_f32si32(float operand) {
+  if (isnan(operand)) return 0;
+  if (operand <= (float)INT32_MIN) return INT32_MIN;
+  if (operand >= 2147483648.0f) return INT32_MAX;
+  return (int32_t)operand;
+}
+static inline int32_t vm_cast_f32ui32(float operand) {
+  if (!(operand > 0.0f)) return 0;  // also catches NaN
+  if (operand >= 4294967296.0f) return (int32_t)UINT32_MAX;
+  return (int32_t)(uint32_t)operand;
+}
+
+//===------------------------------------------------------------------===//
+// ExtF32: Comparison ops
+//===------------------------------------------------------------------===//
+// Ordered comparisons are false if either operand is NaN.
+
+static inline int32_t vm_cmp_eq_f32o(float lhs, float rhs) {
+  return (lhs == rhs) ? 1 : 0;
+}
+static inline int32_t vm_cmp_ne_f32o(float lhs, float rhs) {
+  return (lhs < rhs || lhs > rhs) ? 1 : 0;
+}
+static inline int32_t vm_cmp_lt_f32o(float lhs, float rhs) {
+  return (lhs < rhs) ? 1 : 0;
+}
+static inline int32_t vm_cmp_lte_f32o(float lhs, float rhs) {
+  return (lhs <= rhs) ? 1 : 0;
+}
+static inline int32_t vm_cmp_nz_f32(float operand) {
+  return (operand != 0) ? 1 : 0;
+}
+
+//===------------------------------------------------------------------===//
+// ExtF64: Conditional assignment
+//===------------------------------------------------------------------===//
+
+static inline double vm_select_f64(int32_t condition, double true_value,
+                                   double false_value) {
+  return condition ? true_value : false_value;
+}
+
+//===------------------------------------------------------------------===//
+// ExtF64: Native floating-point arithmetic
+//===------------------------------------------------------------------===//
+
+static inline double vm_add_f64(double lhs, double rhs) { return lhs + rhs; }
+static inline double vm_sub_f64(double lhs, double rhs) { return lhs - rhs; }
+static inline double vm_mul_f64(double lhs, double rhs) { return lhs * rhs; }
+static inline double vm_div_f64(double lhs, double rhs) { return lhs / rhs; }
+static inline double vm_rem_f64(double lhs, double rhs) {
+  return fmod(lhs, rhs);
+}
+static inline double vm_abs_f64(double operand) { return fabs(operand); }
+static inline double vm_neg_f64(double operand) { return -operand; }
+static inline double vm_ceil_f64(double operand) { return ceil(operand); }
+static inline double vm_floor_f64(double operand) { return floor(operand); }
+
+//===------------------------------------------------------------------===//
+// ExtF64: Casting and type conversion/emulation
+//===------------------------------------------------------------------===//
+
+static inline double vm_cast_si32f64(int32_t operand) {
+  return (double)operand;
+}
+static inline double vm_cast_ui32f64(int32_t operand) {
+  return (double)(uint32_t)operand;
+}
+static inline int32_t vm_cast_f64si32(double operand) {
+  if (isnan(operand)) return 0;
+  if (operand <= (double)INT32_MIN) return INT32_MIN;
+  if (operand >= (double)INT32_MAX) return INT32_MAX;
+  return (int32_t)operand;
+}
+static inline int32_t vm_cast_f64ui32(double operand) {
+  if (!(operand > 0.0)) return 0;  // also catches NaN
+  if (operand >= (double)UINT32_MAX) return (int32_t)UINT32_MAX;
+  return (int32_t)(uint32_t)operand;
+}
+static inline float vm_trunc_f64f32(double operand) { return (float)operand; }
+static inline double vm_ext_f32f64(float operand) { return (double)operand; }
+
+//===------------------------------------------------------------------===//
+// ExtF64: Comparison ops
+//===------------------------------------------------------------------===//
+// Ordered comparisons are false if either operand is NaN.
+
+static inline int32_t vm_cmp_eq_f64o(double lhs, double rhs) {
+  return (lhs == rhs) ? 1 : 0;
+}
+static inline int32_t vm_cmp_ne_f64o(double lhs, double rhs) {
+  return (lhs < rhs || lhs > rhs) ? 1 : 0;
+}
+static inline int32_t vm_cmp_lt_f64o(double lhs, double rhs) {
+  return (lhs < rhs) ? 1 : 0;
+}
+static inline int32_t vm_cmp_lte_f64o(double lhs, double rhs) {
+  return (lhs <= rhs) ? 1 : 0;
+}
+static inline int32_t vm_cmp_nz_f64(double operand) {
+  return (operand != 0) ? 1 : 0;
+}
+
 #endif  // IREE_VM_OPS_H_
@@ -19,12 +19,19 @@
 
 #include "iree/base/internal/atomics.h"
 
-// TODO(benvanik): dynamic, if we care - otherwise keep small.
-// After a dozen or so types the linear scan will likely start to spill the
-// DCACHE and need to be reworked. I suspect at the time we have >=64 types
-// we'll want to rewrite all of this anyway (using externalized type ID storage
-// or something more complex).
-#define IREE_VM_MAX_TYPE_ID 64
+// Type IDs are assigned sequentially and index a two-level table of type
+// descriptors. Blocks of the table are allocated as types are registered and
+// are never moved or freed such that type ID lookups need no synchronization
+// and cost two dependent loads regardless of how many types are registered.
+#define IREE_VM_REF_TYPE_BLOCK_BITS 6
+#define IREE_VM_REF_TYPE_BLOCK_SIZE (1u << IREE_VM_REF_TYPE_BLOCK_BITS)
+#define IREE_VM_REF_TYPE_BLOCK_MASK (IREE_VM_REF_TYPE_BLOCK_SIZE - 1)
+#define IREE_VM_REF_TYPE_BLOCK_COUNT 1024
+#define IREE_VM_MAX_TYPE_ID \
+  (IREE_VM_REF_TYPE_BLOCK_COUNT * IREE_VM_REF_TYPE_BLOCK_SIZE)
+
+// Initial capacity of the type name hash table. Must be a power of two.
+#define IREE_VM_REF_TYPE_NAME_TABLE_INITIAL_CAPACITY 128
 
 static inline volatile iree_atomic_ref_count_t* iree_vm_get_raw_counter_ptr(
     void* ptr, const iree_vm_ref_type_descriptor_t* type_descriptor) {
@@ -59,60 +66,141 @@ IREE_API_EXPORT void IREE_API_CALL iree_vm_ref_object_release(
   }
 }
 
-// A table of type descriptors registered at startup.
+// Registry of type descriptors registered at startup.
 // These provide quick dereferencing of destruction functions and type names for
-// debugging. Note that this just points to registered descriptors (or NULL) for
-// each type ID in the type range and does not own the descriptors.
+// debugging. Note that this just points to registered descriptors and does not
+// own them.
 //
-// Note that [0] is always the NULL type and has a NULL descriptor. We don't
-// allow types to be registered there.
-static const iree_vm_ref_type_descriptor_t*
-    iree_vm_ref_type_descriptors[IREE_VM_MAX_TYPE_ID] = {0};
+// Note that type ID 0 is always the NULL type and has a NULL descriptor. We
+// don't allow types to be registered there.
+static struct {
+  // Next type ID to assign; all IDs below this have been registered.
+  iree_vm_ref_type_t next_type;
+
+  // Blocks of IREE_VM_REF_TYPE_BLOCK_SIZE descriptors indexed by the upper
+  // bits of the type ID. The first block is static so that the builtin types
+  // can be registered without allocating.
+  const iree_vm_ref_type_descriptor_t** blocks[IREE_VM_REF_TYPE_BLOCK_COUNT];
+  const iree_vm_ref_type_descriptor_t*
+      initial_block[IREE_VM_REF_TYPE_BLOCK_SIZE];
+
+  // Open-addressed hash table of descriptors keyed by type name. Grown by
+  // doubling when half full. Empty slots are NULL.
+  iree_host_size_t name_capacity;
+  const iree_vm_ref_type_descriptor_t** name_table;
+  const iree_vm_ref_type_descriptor_t*
+      initial_name_table[IREE_VM_REF_TYPE_NAME_TABLE_INITIAL_CAPACITY];
+} iree_vm_ref_type_registry = {
+    .next_type = 1,
+    .blocks = {iree_vm_ref_type_registry.initial_block},
+    .name_capacity = IREE_VM_REF_TYPE_NAME_TABLE_INITIAL_CAPACITY,
+    .name_table = iree_vm_ref_type_registry.initial_name_table,
+};
 
 // Returns the type descriptor (or NULL) for the given type ID.
-static const iree_vm_ref_type_descriptor_t* iree_vm_ref_get_type_descriptor(
-    iree_vm_ref_type_t type) {
-  if (type >= IREE_VM_MAX_TYPE_ID) {
-    return NULL;
+static inline const iree_vm_ref_type_descriptor_t*
+iree_vm_ref_get_type_descriptor(iree_vm_ref_type_t type) {
+  if (IREE_UNLIKELY(type >= IREE_VM_MAX_TYPE_ID)) return NULL;
+  const iree_vm_ref_type_descriptor_t** block =
+      iree_vm_ref_type_registry.blocks[type >> IREE_VM_REF_TYPE_BLOCK_BITS];
+  return block ? block[type & IREE_VM_REF_TYPE_BLOCK_MASK] : NULL;
+}
+
+// FNV-1a hash of the type name.
+static uint32_t iree_vm_ref_type_name_hash(iree_string_view_t name) {
+  uint32_t hash = 2166136261u;
+  for (iree_host_size_t i = 0; i < name.size; ++i) {
+    hash = (hash ^ (uint8_t)name.data[i]) * 16777619u;
+  }
+  return hash;
+}
+
+// Returns the slot in |name_table| holding the descriptor named |name| or the
+// empty slot where it would be inserted.
+static const iree_vm_ref_type_descriptor_t** iree_vm_ref_type_name_slot(
+    const iree_vm_ref_type_descriptor_t** name_table,
+    iree_host_size_t name_capacity, iree_string_view_t name) {
+  iree_host_size_t mask = name_capacity - 1;
+  iree_host_size_t i = iree_vm_ref_type_name_hash(name) & mask;
+  while (name_table[i] &&
+         !iree_string_view_equal(name_table[i]->type_name, name)) {
+    i = (i + 1) & mask;
   }
-  return iree_vm_ref_type_descriptors[type];
+  return &name_table[i];
+}
+
+// Doubles the capacity of the name table and rehashes all entries.
+static iree_status_t iree_vm_ref_type_grow_name_table(void) {
+  iree_host_size_t old_capacity = iree_vm_ref_type_registry.name_capacity;
+  const iree_vm_ref_type_descriptor_t** old_table =
+      iree_vm_ref_type_registry.name_table;
+  iree_host_size_t new_capacity = old_capacity * 2;
+  const iree_vm_ref_type_descriptor_t** new_table = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      iree_allocator_system(), new_capacity * sizeof(*new_table),
+      (void**)&new_table));
+  memset(new_table, 0, new_capacity * sizeof(*new_table));
+  for (iree_host_size_t i = 0; i < old_capacity; ++i) {
+    if (!old_table[i]) continue;
+    *iree_vm_ref_type_name_slot(new_table, new_capacity,
+                                old_table[i]->type_name) = old_table[i];
+  }
+  iree_vm_ref_type_registry.name_capacity = new_capacity;
+  iree_vm_ref_type_registry.name_table = new_table;
+  if (old_table != iree_vm_ref_type_registry.initial_name_table) {
+    iree_allocator_free(iree_allocator_system(), (void*)old_table);
+  }
+  return iree_ok_status();
 }
 
 IREE_API_EXPORT iree_status_t IREE_API_CALL
 iree_vm_ref_register_type(iree_vm_ref_type_descriptor_t* descriptor) {
-  for (int i = 1; i <= IREE_VM_MAX_TYPE_ID; ++i) {
-    if (!iree_vm_ref_type_descriptors[i]) {
-      iree_vm_ref_type_descriptors[i] = descriptor;
-      descriptor->type = i;
-      return iree_ok_status();
-    }
+  iree_vm_ref_type_t type = iree_vm_ref_type_registry.next_type;
+  if (type >= IREE_VM_MAX_TYPE_ID) {
+    return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                            "too many user-defined types registered; new type "
+                            "would exceed maximum of %d",
+                            IREE_VM_MAX_TYPE_ID);
+  }
+
+  // Ensure there's space in both tables before making any changes.
+  const iree_vm_ref_type_descriptor_t*** block =
+      &iree_vm_ref_type_registry.blocks[type >> IREE_VM_REF_TYPE_BLOCK_BITS];
+  if (!*block) {
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+        iree_allocator_system(),
+        IREE_VM_REF_TYPE_BLOCK_SIZE * sizeof(**block), (void**)block));
+    memset(*block, 0, IREE_VM_REF_TYPE_BLOCK_SIZE * sizeof(**block));
   }
-  // Too many user-defined types registered; need to increase
-  // IREE_VM_MAX_TYPE_ID.
-  return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
-                          "too many user-defined types registered; new type "
-                          "would exceed maximum of %d",
-                          IREE_VM_MAX_TYPE_ID);
+  if ((type + 1) * 2 > iree_vm_ref_type_registry.name_capacity) {
+    IREE_RETURN_IF_ERROR(iree_vm_ref_type_grow_name_table());
+  }
+
+  descriptor->type = type;
+  (*block)[type & IREE_VM_REF_TYPE_BLOCK_MASK] = descriptor;
+  iree_vm_ref_type_registry.next_type = type + 1;
+
+  // If multiple types share a name the first registered is returned by name.
+  const iree_vm_ref_type_descriptor_t** name_slot = iree_vm_ref_type_name_slot(
+      iree_vm_ref_type_registry.name_table,
+      iree_vm_ref_type_registry.name_capacity, descriptor->type_name);
+  if (!*name_slot) *name_slot = descriptor;
+
+  return iree_ok_status();
 }
 
 IREE_API_EXPORT iree_string_view_t IREE_API_CALL
 iree_vm_ref_type_name(iree_vm_ref_type_t type) {
-  if (type == 0 || type >= IREE_VM_MAX_TYPE_ID) {
-    return iree_string_view_empty();
-  }
-  return iree_vm_ref_type_descriptors[type]->type_name;
+  const iree_vm_ref_type_descriptor_t* descriptor =
+      iree_vm_ref_get_type_descriptor(type);
+  return descriptor ? descriptor->type_name : iree_string_view_empty();
 }
 
 IREE_API_EXPORT const iree_vm_ref_type_descriptor_t* IREE_API_CALL
 iree_vm_ref_lookup_registered_type(iree_string_view_t full_name) {
-  for (int i = 1; i <= IREE_VM_MAX_TYPE_ID; ++i) {
-    if (!iree_vm_ref_type_descriptors[i]) break;
-    if (iree_string_view_compare(iree_vm_ref_type_descriptors[i]->type_name,
-                                 full_name) == 0) {
-      return iree_vm_ref_type_descriptors[i];
-    }
-  }
-  return NULL;
+  return *iree_vm_ref_type_name_slot(iree_vm_ref_type_registry.name_table,
+                                     iree_vm_ref_type_registry.name_capacity,
+                                     full_name);
 }
 
 IREE_API_EXPORT iree_status_t IREE_API_CALL iree_vm_ref_wrap_assign(
@@ -134,6 +134,11 @@ IREE_API_EXPORT void IREE_API_CALL iree_vm_ref_object_release(
 // reference count goes to 0. NULL can be used to no-op the destruction if the
 // type is not owned by the VM.
 //
+// Type IDs are assigned sequentially and the registry grows as needed; lookups
+// by type ID and by name are constant time regardless of the number of types.
+// If multiple types are registered with the same name then lookups by name
+// return the first registered.
+//
 // TODO(benvanik): keep names alive for user types?
 // NOTE: the name is not retained and must be kept live by the caller. Ideally
 // it is stored in static read-only memory in the binary.
@@ -0,0 +1,146 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures ref operations on objects spread across many registered types such
+// that each operation resolves a different type descriptor.
+// All benchmarks report the time per ref.
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/api.h"
+#include "iree/base/logging.h"
+#include "iree/vm/ref.h"
+
+namespace {
+
+struct ref_object_t {
+  iree_vm_ref_object_t ref_object = {1};
+  int data = 1;
+};
+
+static constexpr int kMaxTypeCount = 1024;
+
+// Registers (once) and returns the descriptors of kMaxTypeCount types.
+static iree_vm_ref_type_descriptor_t* GetTypeDescriptors() {
+  // Names and descriptors must outlive the registration.
+  static char type_names[kMaxTypeCount][32];
+  static iree_vm_ref_type_descriptor_t descriptors[kMaxTypeCount];
+  static bool registered = false;
+  if (!registered) {
+    for (int i = 0; i < kMaxTypeCount; ++i) {
+      snprintf(type_names[i], sizeof(type_names[i]), "BenchmarkType%d", i);
+      descriptors[i].type_name = iree_make_cstring_view(type_names[i]);
+      descriptors[i].offsetof_counter =
+          offsetof(ref_object_t, ref_object.counter);
+      descriptors[i].destroy =
+          +[](void* ptr) { delete reinterpret_cast<ref_object_t*>(ptr); };
+      IREE_CHECK_OK(iree_vm_ref_register_type(&descriptors[i]));
+    }
+    registered = true;
+  }
+  return descriptors;
+}
+
+// Wraps one object of each of the first |type_count| types.
+static std::vector<iree_vm_ref_t> MakeRefs(int type_count) {
+  iree_vm_ref_type_descriptor_t* descriptors = GetTypeDescriptors();
+  std::vector<iree_vm_ref_t> refs(type_count);
+  for (int i = 0; i < type_count; ++i) {
+    refs[i] = {0};
+    IREE_CHECK_OK(iree_vm_ref_wrap_assign(new ref_object_t(),
+                                          descriptors[i].type, &refs[i]));
+  }
+  return refs;
+}
+
+static void ReleaseRefs(std::vector<iree_vm_ref_t>& refs) {
+  for (auto& ref : refs) iree_vm_ref_release(&ref);
+}
+
+static void BM_RefRetainRelease(benchmark::State& state) {
+  const int type_count = state.range(0);
+  std::vector<iree_vm_ref_t> refs = MakeRefs(type_count);
+  while (state.KeepRunningBatch(type_count)) {
+    for (int i = 0; i < type_count; ++i) {
+      iree_vm_ref_t ref = {0};
+      iree_vm_ref_retain(&refs[i], &ref);
+      iree_vm_ref_release(&ref);
+    }
+  }
+  ReleaseRefs(refs);
+}
+BENCHMARK(BM_RefRetainRelease)->Arg(8)->Arg(256)->Arg(kMaxTypeCount);
+
+// Wrapping resolves the type descriptor from the type ID.
+static void BM_RefWrapRetain(benchmark::State& state) {
+  const int type_count = state.range(0);
+  std::vector<iree_vm_ref_t> refs = MakeRefs(type_count);
+  while (state.KeepRunningBatch(type_count)) {
+    for (int i = 0; i < type_count; ++i) {
+      iree_vm_ref_t ref = {0};
+      IREE_CHECK_OK(
+          iree_vm_ref_wrap_retain(refs[i].ptr, refs[i].type, &ref));
+      iree_vm_ref_release(&ref);
+    }
+  }
+  ReleaseRefs(refs);
+}
+BENCHMARK(BM_RefWrapRetain)->Arg(8)->Arg(256)->Arg(kMaxTypeCount);
+
+// Releasing the last reference resolves the type descriptor to destroy the
+// object. Includes the cost of allocating and freeing each object.
+static void BM_RefWrapAssignDestroy(benchmark::State& state) {
+  const int type_count = state.range(0);
+  iree_vm_ref_type_descriptor_t* descriptors = GetTypeDescriptors();
+  while (state.KeepRunningBatch(type_count)) {
+    for (int i = 0; i < type_count; ++i) {
+      iree_vm_ref_t ref = {0};
+      IREE_CHECK_OK(iree_vm_ref_wrap_assign(new ref_object_t(),
+                                            descriptors[i].type, &ref));
+      iree_vm_ref_release(&ref);
+    }
+  }
+}
+BENCHMARK(BM_RefWrapAssignDestroy)->Arg(8)->Arg(256)->Arg(kMaxTypeCount);
+
+static void BM_RefCheckDeref(benchmark::State& state) {
+  const int type_count = state.range(0);
+  iree_vm_ref_type_descriptor_t* descriptors = GetTypeDescriptors();
+  std::vector<iree_vm_ref_t> refs = MakeRefs(type_count);
+  while (state.KeepRunningBatch(type_count)) {
+    for (int i = 0; i < type_count; ++i) {
+      IREE_CHECK_OK(iree_vm_ref_check(refs[i], descriptors[i].type));
+      benchmark::DoNotOptimize(refs[i].ptr);
+    }
+  }
+  ReleaseRefs(refs);
+}
+BENCHMARK(BM_RefCheckDeref)->Arg(8)->Arg(256)->Arg(kMaxTypeCount);
+
+static void BM_RefLookupRegisteredType(benchmark::State& state) {
+  const int type_count = state.range(0);
+  iree_vm_ref_type_descriptor_t* descriptors = GetTypeDescriptors();
+  while (state.KeepRunningBatch(type_count)) {
+    for (int i = 0; i < type_count; ++i) {
+      benchmark::DoNotOptimize(
+          iree_vm_ref_lookup_registered_type(descriptors[i].type_name));
+    }
+  }
+}
+BENCHMARK(BM_RefLookupRegisteredType)->Arg(8)->Arg(256)->Arg(kMaxTypeCount);
+
+}  // namespace
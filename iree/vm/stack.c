@@ -189,6 +189,14 @@ struct iree_vm_stack {
   // Allocator used for dynamic stack allocations. May be the null allocator
   // if growth is prohibited.
   iree_allocator_t allocator;
+
+  // True if waits may yield execution instead of blocking.
+  bool yield_enabled;
+
+  // True if |pending_wait| holds a request stored by iree_vm_stack_wait that
+  // has not yet been taken by the module that issued the call.
+  bool has_pending_wait;
+  iree_vm_wait_request_t pending_wait;
 };
 
 //===----------------------------------------------------------------------===//
@@ -236,6 +244,10 @@ iree_vm_stack_deinitialize(iree_vm_stack_t* stack) {
   while (stack->top) {
     iree_status_ignore(iree_vm_stack_function_leave(stack));
   }
+  if (stack->has_pending_wait) {
+    iree_vm_wait_request_reset(&stack->pending_wait);
+    stack->has_pending_wait = false;
+  }
 
   if (stack->owns_frame_storage) {
     iree_allocator_free(stack->allocator, stack->frame_storage);
@@ -278,6 +290,57 @@ IREE_API_EXPORT void IREE_API_CALL iree_vm_stack_free(iree_vm_stack_t* stack) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+IREE_API_EXPORT void IREE_API_CALL
+iree_vm_stack_set_yield_enabled(iree_vm_stack_t* stack, bool enabled) {
+  stack->yield_enabled = enabled;
+}
+
+IREE_API_EXPORT bool IREE_API_CALL
+iree_vm_stack_is_yield_enabled(const iree_vm_stack_t* stack) {
+  return stack->yield_enabled;
+}
+
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_stack_wait(iree_vm_stack_t* stack, iree_vm_wait_request_t* request,
+                   bool* out_yielded) {
+  IREE_ASSERT_ARGUMENT(request);
+  IREE_ASSERT_ARGUMENT(out_yielded);
+  *out_yielded = false;
+
+  // Only the function at the base of the stack or one called directly from
+  // bytecode can yield: native callers have no way to suspend themselves and
+  // would otherwise observe the call as completed without results.
+  iree_vm_stack_frame_header_t* caller_header =
+      stack->top ? stack->top->parent : NULL;
+  bool can_yield = stack->yield_enabled && !stack->has_pending_wait &&
+                   (!caller_header ||
+                    caller_header->type == IREE_VM_STACK_FRAME_BYTECODE);
+  if (!can_yield) {
+    // Block the calling thread until the request is satisfied.
+    IREE_TRACE_ZONE_BEGIN(z0);
+    iree_status_t status =
+        iree_vm_wait_request_await(request, IREE_TIME_INFINITE_FUTURE);
+    iree_vm_wait_request_reset(request);
+    IREE_TRACE_ZONE_END(z0);
+    return status;
+  }
+
+  stack->pending_wait = *request;
+  memset(request, 0, sizeof(*request));
+  stack->has_pending_wait = true;
+  *out_yielded = true;
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT bool IREE_API_CALL iree_vm_stack_take_pending_wait(
+    iree_vm_stack_t* stack, iree_vm_wait_request_t* out_request) {
+  if (IREE_LIKELY(!stack->has_pending_wait)) return false;
+  *out_request = stack->pending_wait;
+  memset(&stack->pending_wait, 0, sizeof(stack->pending_wait));
+  stack->has_pending_wait = false;
+  return true;
+}
+
 IREE_API_EXPORT iree_vm_stack_frame_t* IREE_API_CALL
 iree_vm_stack_current_frame(iree_vm_stack_t* stack) {
   return stack->top ? &stack->top->frame : NULL;
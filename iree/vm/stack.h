@@ -182,6 +182,42 @@ iree_vm_stack_allocate(iree_vm_state_resolver_t state_resolver,
 // Frees a dynamically-allocated |stack| from iree_vm_stack_allocate.
 IREE_API_EXPORT void IREE_API_CALL iree_vm_stack_free(iree_vm_stack_t* stack);
 
+// Enables or disables yielding of calls executing on |stack|.
+// By default stacks have yields disabled and any waits performed by imports
+// block the calling thread. When enabled waits unwind execution back to the
+// caller of begin_call/resume_call with IREE_VM_EXECUTION_RESULT_FLAG_YIELDED
+// and the stack must be kept alive until the call is resumed and completes.
+// Only callers that handle yielded results (such as iree_vm_invocation_t)
+// should enable yields.
+IREE_API_EXPORT void IREE_API_CALL
+iree_vm_stack_set_yield_enabled(iree_vm_stack_t* stack, bool enabled);
+
+// Returns true if calls executing on |stack| may yield.
+IREE_API_EXPORT bool IREE_API_CALL
+iree_vm_stack_is_yield_enabled(const iree_vm_stack_t* stack);
+
+// Waits for |request| on behalf of the function executing in the current
+// frame. Ownership of |request| is always taken.
+//
+// If the stack has yields enabled and the request is not yet satisfied the
+// request is stored on the stack, |out_yielded| is set to true, and the
+// function must return immediately without producing results. The function
+// will be called again with the same arguments when the call is resumed.
+//
+// If yields are disabled, or the function was called from native code that
+// cannot itself be suspended, the calling thread blocks until the request is
+// satisfied and the result of the wait is returned.
+IREE_API_EXPORT iree_status_t IREE_API_CALL
+iree_vm_stack_wait(iree_vm_stack_t* stack, iree_vm_wait_request_t* request,
+                   bool* out_yielded);
+
+// Takes the wait request stored by iree_vm_stack_wait, if any.
+// Returns true and moves the request to |out_request| if a yield is pending.
+// Called by module implementations after their functions return to propagate
+// the yield to their caller.
+IREE_API_EXPORT bool IREE_API_CALL iree_vm_stack_take_pending_wait(
+    iree_vm_stack_t* stack, iree_vm_wait_request_t* out_request);
+
 // Returns the current stack frame or nullptr if the stack is empty.
 IREE_API_EXPORT iree_vm_stack_frame_t* IREE_API_CALL
 iree_vm_stack_current_frame(iree_vm_stack_t* stack);
@@ -0,0 +1,107 @@
+vm.module @arithmetic_ops_f64 {
+
+  //===--------------------------------------------------------------------===//
+  // ExtF64: Native floating-point arithmetic
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_add_f64
+  vm.func @test_add_f64() {
+    %c1 = vm.const.f64 1.5 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %c2 = vm.const.f64 2.25 : f64
+    %c2dno = iree.do_not_optimize(%c2) : f64
+    %v = vm.add.f64 %c1dno, %c2dno : f64
+    %c3 = vm.const.f64 3.75 : f64
+    vm.check.eq %v, %c3, "1.5+2.25=3.75" : f64
+    vm.return
+  }
+
+  vm.export @test_sub_f64
+  vm.func @test_sub_f64() {
+    %c1 = vm.const.f64 3.0 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %c2 = vm.const.f64 2.5 : f64
+    %c2dno = iree.do_not_optimize(%c2) : f64
+    %v = vm.sub.f64 %c1dno, %c2dno : f64
+    %c3 = vm.const.f64 0.5 : f64
+    vm.check.eq %v, %c3, "3.0-2.5=0.5" : f64
+    vm.return
+  }
+
+  vm.export @test_mul_f64
+  vm.func @test_mul_f64() {
+    %c1 = vm.const.f64 2.5 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %c2 = vm.const.f64 -4.0 : f64
+    %c2dno = iree.do_not_optimize(%c2) : f64
+    %v = vm.mul.f64 %c1dno, %c2dno : f64
+    %c3 = vm.const.f64 -10.0 : f64
+    vm.check.eq %v, %c3, "2.5*-4.0=-10.0" : f64
+    vm.return
+  }
+
+  vm.export @test_div_f64
+  vm.func @test_div_f64() {
+    %c1 = vm.const.f64 5.0 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %c2 = vm.const.f64 2.0 : f64
+    %c2dno = iree.do_not_optimize(%c2) : f64
+    %v = vm.div.f64 %c1dno, %c2dno : f64
+    %c3 = vm.const.f64 2.5 : f64
+    vm.check.eq %v, %c3, "5.0/2.0=2.5" : f64
+    vm.return
+  }
+
+  vm.export @test_rem_f64
+  vm.func @test_rem_f64() {
+    %c1 = vm.const.f64 -5.5 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %c2 = vm.const.f64 2.0 : f64
+    %c2dno = iree.do_not_optimize(%c2) : f64
+    %v = vm.rem.f64 %c1dno, %c2dno : f64
+    %c3 = vm.const.f64 -1.5 : f64
+    vm.check.eq %v, %c3, "-5.5%2.0=-1.5" : f64
+    vm.return
+  }
+
+  vm.export @test_abs_f64
+  vm.func @test_abs_f64() {
+    %c1 = vm.const.f64 -1.5 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.abs.f64 %c1dno : f64
+    %c2 = vm.const.f64 1.5 : f64
+    vm.check.eq %v, %c2, "abs(-1.5)=1.5" : f64
+    vm.return
+  }
+
+  vm.export @test_neg_f64
+  vm.func @test_neg_f64() {
+    %c1 = vm.const.f64 1.5 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.neg.f64 %c1dno : f64
+    %c2 = vm.const.f64 -1.5 : f64
+    vm.check.eq %v, %c2, "-(1.5)=-1.5" : f64
+    vm.return
+  }
+
+  vm.export @test_ceil_f64
+  vm.func @test_ceil_f64() {
+    %c1 = vm.const.f64 1.25 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.ceil.f64 %c1dno : f64
+    %c2 = vm.const.f64 2.0 : f64
+    vm.check.eq %v, %c2, "ceil(1.25)=2.0" : f64
+    vm.return
+  }
+
+  vm.export @test_floor_f64
+  vm.func @test_floor_f64() {
+    %c1 = vm.const.f64 -1.25 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.floor.f64 %c1dno : f64
+    %c2 = vm.const.f64 -2.0 : f64
+    vm.check.eq %v, %c2, "floor(-1.25)=-2.0" : f64
+    vm.return
+  }
+
+}
@@ -0,0 +1,253 @@
+vm.module @comparison_ops_f32 {
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.eq.f32.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_eq_0_f32
+  vm.func @test_cmp_eq_0_f32() {
+    %lhs = vm.const.f32 1.5 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 -1.5 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.eq.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "1.5 == -1.5" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_eq_1_f32
+  vm.func @test_cmp_eq_1_f32() {
+    %lhs = vm.const.f32 -1.5 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 -1.5 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.eq.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "-1.5 == -1.5" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_eq_nan_f32
+  vm.func @test_cmp_eq_nan_f32() {
+    %lhs = vm.const.f32 0x7FC00000 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 0x7FC00000 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.eq.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "NaN == NaN" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.ne.f32.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_ne_0_f32
+  vm.func @test_cmp_ne_0_f32() {
+    %lhs = vm.const.f32 1.5 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 1.5 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.ne.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "1.5 != 1.5" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_ne_1_f32
+  vm.func @test_cmp_ne_1_f32() {
+    %lhs = vm.const.f32 1.5 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 -1.5 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.ne.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "1.5 != -1.5" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_ne_nan_f32
+  vm.func @test_cmp_ne_nan_f32() {
+    %lhs = vm.const.f32 0x7FC00000 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 1.5 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.ne.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "NaN != 1.5" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.lt.f32.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_lt_0_f32
+  vm.func @test_cmp_lt_0_f32() {
+    %lhs = vm.const.f32 2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 -2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.lt.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "2.0 < -2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_lt_1_f32
+  vm.func @test_cmp_lt_1_f32() {
+    %lhs = vm.const.f32 -2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.lt.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "-2.0 < 2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_lt_nan_f32
+  vm.func @test_cmp_lt_nan_f32() {
+    %lhs = vm.const.f32 0x7FC00000 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.lt.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "NaN < 2.0" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.lte.f32.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_lte_0_f32
+  vm.func @test_cmp_lte_0_f32() {
+    %lhs = vm.const.f32 2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 -2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.lte.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "2.0 <= -2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_lte_1_f32
+  vm.func @test_cmp_lte_1_f32() {
+    %lhs = vm.const.f32 2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.lte.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "2.0 <= 2.0" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.gt.f32.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_gt_0_f32
+  vm.func @test_cmp_gt_0_f32() {
+    %lhs = vm.const.f32 -2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.gt.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "-2.0 > 2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_gt_1_f32
+  vm.func @test_cmp_gt_1_f32() {
+    %lhs = vm.const.f32 2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 -2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.gt.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "2.0 > -2.0" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.gte.f32.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_gte_0_f32
+  vm.func @test_cmp_gte_0_f32() {
+    %lhs = vm.const.f32 -2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.gte.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "-2.0 >= 2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_gte_1_f32
+  vm.func @test_cmp_gte_1_f32() {
+    %lhs = vm.const.f32 2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 2.0 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.gte.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "2.0 >= 2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_gte_nan_f32
+  vm.func @test_cmp_gte_nan_f32() {
+    %lhs = vm.const.f32 2.0 : f32
+    %lhs_dno = iree.do_not_optimize(%lhs) : f32
+    %rhs = vm.const.f32 0x7FC00000 : f32
+    %rhs_dno = iree.do_not_optimize(%rhs) : f32
+    %actual = vm.cmp.gte.f32.o %lhs_dno, %rhs_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "2.0 >= NaN" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.nz.f32
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_nz_0_f32
+  vm.func @test_cmp_nz_0_f32() {
+    %c = vm.const.f32 0.0 : f32
+    %c_dno = iree.do_not_optimize(%c) : f32
+    %actual = vm.cmp.nz.f32 %c_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "0.0 != 0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_nz_1_f32
+  vm.func @test_cmp_nz_1_f32() {
+    %c = vm.const.f32 -0.0 : f32
+    %c_dno = iree.do_not_optimize(%c) : f32
+    %actual = vm.cmp.nz.f32 %c_dno : f32
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "-0.0 != 0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_nz_2_f32
+  vm.func @test_cmp_nz_2_f32() {
+    %c = vm.const.f32 0.5 : f32
+    %c_dno = iree.do_not_optimize(%c) : f32
+    %actual = vm.cmp.nz.f32 %c_dno : f32
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "0.5 != 0" : i32
+    vm.return
+  }
+
+}
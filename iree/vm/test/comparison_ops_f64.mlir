@@ -0,0 +1,253 @@
+vm.module @comparison_ops_f64 {
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.eq.f64.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_eq_0_f64
+  vm.func @test_cmp_eq_0_f64() {
+    %lhs = vm.const.f64 1.5 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 -1.5 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.eq.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "1.5 == -1.5" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_eq_1_f64
+  vm.func @test_cmp_eq_1_f64() {
+    %lhs = vm.const.f64 -1.5 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 -1.5 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.eq.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "-1.5 == -1.5" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_eq_nan_f64
+  vm.func @test_cmp_eq_nan_f64() {
+    %lhs = vm.const.f64 0x7FF8000000000000 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 0x7FF8000000000000 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.eq.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "NaN == NaN" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.ne.f64.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_ne_0_f64
+  vm.func @test_cmp_ne_0_f64() {
+    %lhs = vm.const.f64 1.5 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 1.5 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.ne.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "1.5 != 1.5" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_ne_1_f64
+  vm.func @test_cmp_ne_1_f64() {
+    %lhs = vm.const.f64 1.5 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 -1.5 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.ne.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "1.5 != -1.5" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_ne_nan_f64
+  vm.func @test_cmp_ne_nan_f64() {
+    %lhs = vm.const.f64 0x7FF8000000000000 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 1.5 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.ne.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "NaN != 1.5" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.lt.f64.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_lt_0_f64
+  vm.func @test_cmp_lt_0_f64() {
+    %lhs = vm.const.f64 2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 -2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.lt.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "2.0 < -2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_lt_1_f64
+  vm.func @test_cmp_lt_1_f64() {
+    %lhs = vm.const.f64 -2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.lt.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "-2.0 < 2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_lt_nan_f64
+  vm.func @test_cmp_lt_nan_f64() {
+    %lhs = vm.const.f64 0x7FF8000000000000 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.lt.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "NaN < 2.0" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.lte.f64.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_lte_0_f64
+  vm.func @test_cmp_lte_0_f64() {
+    %lhs = vm.const.f64 2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 -2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.lte.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "2.0 <= -2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_lte_1_f64
+  vm.func @test_cmp_lte_1_f64() {
+    %lhs = vm.const.f64 2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.lte.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "2.0 <= 2.0" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.gt.f64.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_gt_0_f64
+  vm.func @test_cmp_gt_0_f64() {
+    %lhs = vm.const.f64 -2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.gt.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "-2.0 > 2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_gt_1_f64
+  vm.func @test_cmp_gt_1_f64() {
+    %lhs = vm.const.f64 2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 -2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.gt.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "2.0 > -2.0" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.gte.f64.o
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_gte_0_f64
+  vm.func @test_cmp_gte_0_f64() {
+    %lhs = vm.const.f64 -2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.gte.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "-2.0 >= 2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_gte_1_f64
+  vm.func @test_cmp_gte_1_f64() {
+    %lhs = vm.const.f64 2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 2.0 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.gte.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "2.0 >= 2.0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_gte_nan_f64
+  vm.func @test_cmp_gte_nan_f64() {
+    %lhs = vm.const.f64 2.0 : f64
+    %lhs_dno = iree.do_not_optimize(%lhs) : f64
+    %rhs = vm.const.f64 0x7FF8000000000000 : f64
+    %rhs_dno = iree.do_not_optimize(%rhs) : f64
+    %actual = vm.cmp.gte.f64.o %lhs_dno, %rhs_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "2.0 >= NaN" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.cmp.nz.f64
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cmp_nz_0_f64
+  vm.func @test_cmp_nz_0_f64() {
+    %c = vm.const.f64 0.0 : f64
+    %c_dno = iree.do_not_optimize(%c) : f64
+    %actual = vm.cmp.nz.f64 %c_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "0.0 != 0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_nz_1_f64
+  vm.func @test_cmp_nz_1_f64() {
+    %c = vm.const.f64 -0.0 : f64
+    %c_dno = iree.do_not_optimize(%c) : f64
+    %actual = vm.cmp.nz.f64 %c_dno : f64
+    %expected = vm.const.i32 0 : i32
+    vm.check.eq %actual, %expected, "-0.0 != 0" : i32
+    vm.return
+  }
+
+  vm.export @test_cmp_nz_2_f64
+  vm.func @test_cmp_nz_2_f64() {
+    %c = vm.const.f64 0.5 : f64
+    %c_dno = iree.do_not_optimize(%c) : f64
+    %actual = vm.cmp.nz.f64 %c_dno : f64
+    %expected = vm.const.i32 1 : i32
+    vm.check.eq %actual, %expected, "0.5 != 0" : i32
+    vm.return
+  }
+
+}
@@ -41,4 +41,118 @@ vm.module @control_flow_ops {
     vm.return
   }
 
+  //===--------------------------------------------------------------------===//
+  // vm.cond_br.cmp.* (superinstructions formed from vm.cmp.* + vm.cond_br)
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cond_br_cmp_eq_i32
+  vm.func @test_cond_br_cmp_eq_i32() {
+    %c2 = vm.const.i32 2 : i32
+    %c2dno = iree.do_not_optimize(%c2) : i32
+    %cmp = vm.cmp.eq.i32 %c2dno, %c2 : i32
+    vm.cond_br %cmp, ^bb1, ^bb2
+  ^bb1:
+    vm.return
+  ^bb2:
+    %code = vm.const.i32 2 : i32
+    vm.fail %code, "2 == 2 must take the true branch"
+  }
+
+  vm.export @test_cond_br_cmp_ne_i32
+  vm.func @test_cond_br_cmp_ne_i32() {
+    %c2 = vm.const.i32 2 : i32
+    %c2dno = iree.do_not_optimize(%c2) : i32
+    %cmp = vm.cmp.ne.i32 %c2dno, %c2 : i32
+    vm.cond_br %cmp, ^bb1, ^bb2
+  ^bb1:
+    %code = vm.const.i32 2 : i32
+    vm.fail %code, "2 != 2 must take the false branch"
+  ^bb2:
+    vm.return
+  }
+
+  vm.export @test_cond_br_cmp_lt_i32_s
+  vm.func @test_cond_br_cmp_lt_i32_s() {
+    %cn1 = vm.const.i32 -1 : i32
+    %c2 = vm.const.i32 2 : i32
+    %cn1dno = iree.do_not_optimize(%cn1) : i32
+    %c2dno = iree.do_not_optimize(%c2) : i32
+    %cmp = vm.cmp.lt.i32.s %cn1dno, %c2dno : i32
+    vm.cond_br %cmp, ^bb1, ^bb2
+  ^bb1:
+    vm.return
+  ^bb2:
+    %code = vm.const.i32 2 : i32
+    vm.fail %code, "-1 < 2 (signed) must take the true branch"
+  }
+
+  vm.export @test_cond_br_cmp_lt_i32_u
+  vm.func @test_cond_br_cmp_lt_i32_u() {
+    %cn1 = vm.const.i32 -1 : i32
+    %c2 = vm.const.i32 2 : i32
+    %cn1dno = iree.do_not_optimize(%cn1) : i32
+    %c2dno = iree.do_not_optimize(%c2) : i32
+    %cmp = vm.cmp.lt.i32.u %cn1dno, %c2dno : i32
+    vm.cond_br %cmp, ^bb1, ^bb2
+  ^bb1:
+    %code = vm.const.i32 2 : i32
+    vm.fail %code, "0xFFFFFFFF < 2 (unsigned) must take the false branch"
+  ^bb2:
+    vm.return
+  }
+
+  vm.export @test_cond_br_cmp_loop
+  vm.func @test_cond_br_cmp_loop() {
+    %c0 = vm.const.i32.zero : i32
+    %c1 = vm.const.i32 1 : i32
+    %c10 = vm.const.i32 10 : i32
+    %c10dno = iree.do_not_optimize(%c10) : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %sum : i32):
+    %sum_next = vm.add.i32 %sum, %i : i32
+    %i_next = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %i_next, %c10dno : i32
+    vm.cond_br %cmp, ^loop(%i_next, %sum_next : i32, i32), ^exit(%sum_next : i32)
+  ^exit(%result : i32):
+    %c45 = vm.const.i32 45 : i32
+    vm.check.eq %result, %c45, "sum of 0..9" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // vm.call
+  //===--------------------------------------------------------------------===//
+
+  // Arguments are marshaled per register bank; interleaving i32 and ref
+  // arguments verifies that each lands in the right callee register.
+  vm.func @mixed_args(%a : !vm.list<i32>, %x : i32, %b : !vm.list<i32>,
+                      %y : i32) attributes {noinline} {
+    %c1 = vm.const.i32 1 : i32
+    %c2 = vm.const.i32 2 : i32
+    %c3 = vm.const.i32 3 : i32
+    %c4 = vm.const.i32 4 : i32
+    %sa = vm.list.size %a : (!vm.list<i32>) -> i32
+    %sb = vm.list.size %b : (!vm.list<i32>) -> i32
+    vm.check.eq %sa, %c1, "a" : i32
+    vm.check.eq %x, %c2, "x" : i32
+    vm.check.eq %sb, %c3, "b" : i32
+    vm.check.eq %y, %c4, "y" : i32
+    vm.return
+  }
+
+  vm.export @test_call_mixed_args
+  vm.func @test_call_mixed_args() {
+    %c1 = vm.const.i32 1 : i32
+    %c2 = vm.const.i32 2 : i32
+    %c3 = vm.const.i32 3 : i32
+    %c4 = vm.const.i32 4 : i32
+    %a = vm.list.alloc %c1 : (i32) -> !vm.list<i32>
+    vm.list.resize %a, %c1 : (!vm.list<i32>, i32)
+    %b = vm.list.alloc %c3 : (i32) -> !vm.list<i32>
+    vm.list.resize %b, %c3 : (!vm.list<i32>, i32)
+    vm.call @mixed_args(%a, %c2, %b, %c4) :
+        (!vm.list<i32>, i32, !vm.list<i32>, i32) -> ()
+    vm.return
+  }
+
 }
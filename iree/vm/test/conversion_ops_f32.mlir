@@ -0,0 +1,165 @@
+vm.module @conversion_ops_f32 {
+
+  //===--------------------------------------------------------------------===//
+  // ExtF32: Casting and type conversion/emulation
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cast_si32_f32
+  vm.func @test_cast_si32_f32() {
+    %c1 = vm.const.i32 -3 : i32
+    %c1dno = iree.do_not_optimize(%c1) : i32
+    %v = vm.cast.si32.f32 %c1dno : i32 -> f32
+    %c2 = vm.const.f32 -3.0 : f32
+    vm.check.eq %v, %c2, "cast -3 to f32" : f32
+    vm.return
+  }
+
+  vm.export @test_cast_ui32_f32
+  vm.func @test_cast_ui32_f32() {
+    %c1 = vm.const.i32 -2147483648 : i32
+    %c1dno = iree.do_not_optimize(%c1) : i32
+    %v = vm.cast.ui32.f32 %c1dno : i32 -> f32
+    %c2 = vm.const.f32 2147483648.0 : f32
+    vm.check.eq %v, %c2, "cast unsigned to f32" : f32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_si32
+  vm.func @test_cast_f32_si32() {
+    %c1 = vm.const.f32 -2.5 : f32
+    %c1dno = iree.do_not_optimize(%c1) : f32
+    %v = vm.cast.f32.si32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 -2 : i32
+    vm.check.eq %v, %c2, "cast -2.5 to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_ui32
+  vm.func @test_cast_f32_ui32() {
+    %c1 = vm.const.f32 3.75 : f32
+    %c1dno = iree.do_not_optimize(%c1) : f32
+    %v = vm.cast.f32.ui32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 3 : i32
+    vm.check.eq %v, %c2, "cast 3.75 to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_si32_nan
+  vm.func @test_cast_f32_si32_nan() {
+    %n = vm.const.f32 0.0 : f32
+    %z = vm.const.f32 0.0 : f32
+    %ndno = iree.do_not_optimize(%n) : f32
+    %zdno = iree.do_not_optimize(%z) : f32
+    %c1dno = vm.div.f32 %ndno, %zdno : f32
+    %v = vm.cast.f32.si32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 0 : i32
+    vm.check.eq %v, %c2, "cast NaN to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_si32_inf
+  vm.func @test_cast_f32_si32_inf() {
+    %n = vm.const.f32 1.0 : f32
+    %z = vm.const.f32 0.0 : f32
+    %ndno = iree.do_not_optimize(%n) : f32
+    %zdno = iree.do_not_optimize(%z) : f32
+    %c1dno = vm.div.f32 %ndno, %zdno : f32
+    %v = vm.cast.f32.si32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 2147483647 : i32
+    vm.check.eq %v, %c2, "cast +inf to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_si32_neg_inf
+  vm.func @test_cast_f32_si32_neg_inf() {
+    %n = vm.const.f32 -1.0 : f32
+    %z = vm.const.f32 0.0 : f32
+    %ndno = iree.do_not_optimize(%n) : f32
+    %zdno = iree.do_not_optimize(%z) : f32
+    %c1dno = vm.div.f32 %ndno, %zdno : f32
+    %v = vm.cast.f32.si32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 -2147483648 : i32
+    vm.check.eq %v, %c2, "cast -inf to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_si32_overflow
+  vm.func @test_cast_f32_si32_overflow() {
+    %c1 = vm.const.f32 2147483648.0 : f32
+    %c1dno = iree.do_not_optimize(%c1) : f32
+    %v = vm.cast.f32.si32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 2147483647 : i32
+    vm.check.eq %v, %c2, "cast 2147483648.0 to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_si32_underflow
+  vm.func @test_cast_f32_si32_underflow() {
+    %c1 = vm.const.f32 -2147483904.0 : f32
+    %c1dno = iree.do_not_optimize(%c1) : f32
+    %v = vm.cast.f32.si32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 -2147483648 : i32
+    vm.check.eq %v, %c2, "cast -2147483904.0 to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_ui32_nan
+  vm.func @test_cast_f32_ui32_nan() {
+    %n = vm.const.f32 0.0 : f32
+    %z = vm.const.f32 0.0 : f32
+    %ndno = iree.do_not_optimize(%n) : f32
+    %zdno = iree.do_not_optimize(%z) : f32
+    %c1dno = vm.div.f32 %ndno, %zdno : f32
+    %v = vm.cast.f32.ui32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 0 : i32
+    vm.check.eq %v, %c2, "cast NaN to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_ui32_inf
+  vm.func @test_cast_f32_ui32_inf() {
+    %n = vm.const.f32 1.0 : f32
+    %z = vm.const.f32 0.0 : f32
+    %ndno = iree.do_not_optimize(%n) : f32
+    %zdno = iree.do_not_optimize(%z) : f32
+    %c1dno = vm.div.f32 %ndno, %zdno : f32
+    %v = vm.cast.f32.ui32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 -1 : i32
+    vm.check.eq %v, %c2, "cast +inf to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_ui32_neg_inf
+  vm.func @test_cast_f32_ui32_neg_inf() {
+    %n = vm.const.f32 -1.0 : f32
+    %z = vm.const.f32 0.0 : f32
+    %ndno = iree.do_not_optimize(%n) : f32
+    %zdno = iree.do_not_optimize(%z) : f32
+    %c1dno = vm.div.f32 %ndno, %zdno : f32
+    %v = vm.cast.f32.ui32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 0 : i32
+    vm.check.eq %v, %c2, "cast -inf to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_ui32_overflow
+  vm.func @test_cast_f32_ui32_overflow() {
+    %c1 = vm.const.f32 4294967296.0 : f32
+    %c1dno = iree.do_not_optimize(%c1) : f32
+    %v = vm.cast.f32.ui32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 -1 : i32
+    vm.check.eq %v, %c2, "cast 4294967296.0 to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f32_ui32_underflow
+  vm.func @test_cast_f32_ui32_underflow() {
+    %c1 = vm.const.f32 -1.0 : f32
+    %c1dno = iree.do_not_optimize(%c1) : f32
+    %v = vm.cast.f32.ui32 %c1dno : f32 -> i32
+    %c2 = vm.const.i32 0 : i32
+    vm.check.eq %v, %c2, "cast -1.0 to ui32" : i32
+    vm.return
+  }
+
+}
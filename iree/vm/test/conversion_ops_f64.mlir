@@ -0,0 +1,185 @@
+vm.module @conversion_ops_f64 {
+
+  //===--------------------------------------------------------------------===//
+  // ExtF64: Casting and type conversion/emulation
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_cast_si32_f64
+  vm.func @test_cast_si32_f64() {
+    %c1 = vm.const.i32 -3 : i32
+    %c1dno = iree.do_not_optimize(%c1) : i32
+    %v = vm.cast.si32.f64 %c1dno : i32 -> f64
+    %c2 = vm.const.f64 -3.0 : f64
+    vm.check.eq %v, %c2, "cast -3 to f64" : f64
+    vm.return
+  }
+
+  vm.export @test_cast_ui32_f64
+  vm.func @test_cast_ui32_f64() {
+    %c1 = vm.const.i32 -1 : i32
+    %c1dno = iree.do_not_optimize(%c1) : i32
+    %v = vm.cast.ui32.f64 %c1dno : i32 -> f64
+    %c2 = vm.const.f64 4294967295.0 : f64
+    vm.check.eq %v, %c2, "cast unsigned to f64" : f64
+    vm.return
+  }
+
+  vm.export @test_cast_f64_si32
+  vm.func @test_cast_f64_si32() {
+    %c1 = vm.const.f64 -2.5 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.cast.f64.si32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 -2 : i32
+    vm.check.eq %v, %c2, "cast -2.5 to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_ui32
+  vm.func @test_cast_f64_ui32() {
+    %c1 = vm.const.f64 3.75 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.cast.f64.ui32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 3 : i32
+    vm.check.eq %v, %c2, "cast 3.75 to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_si32_nan
+  vm.func @test_cast_f64_si32_nan() {
+    %n = vm.const.f64 0.0 : f64
+    %z = vm.const.f64 0.0 : f64
+    %ndno = iree.do_not_optimize(%n) : f64
+    %zdno = iree.do_not_optimize(%z) : f64
+    %c1dno = vm.div.f64 %ndno, %zdno : f64
+    %v = vm.cast.f64.si32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 0 : i32
+    vm.check.eq %v, %c2, "cast NaN to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_si32_inf
+  vm.func @test_cast_f64_si32_inf() {
+    %n = vm.const.f64 1.0 : f64
+    %z = vm.const.f64 0.0 : f64
+    %ndno = iree.do_not_optimize(%n) : f64
+    %zdno = iree.do_not_optimize(%z) : f64
+    %c1dno = vm.div.f64 %ndno, %zdno : f64
+    %v = vm.cast.f64.si32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 2147483647 : i32
+    vm.check.eq %v, %c2, "cast +inf to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_si32_neg_inf
+  vm.func @test_cast_f64_si32_neg_inf() {
+    %n = vm.const.f64 -1.0 : f64
+    %z = vm.const.f64 0.0 : f64
+    %ndno = iree.do_not_optimize(%n) : f64
+    %zdno = iree.do_not_optimize(%z) : f64
+    %c1dno = vm.div.f64 %ndno, %zdno : f64
+    %v = vm.cast.f64.si32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 -2147483648 : i32
+    vm.check.eq %v, %c2, "cast -inf to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_si32_overflow
+  vm.func @test_cast_f64_si32_overflow() {
+    %c1 = vm.const.f64 2147483648.0 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.cast.f64.si32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 2147483647 : i32
+    vm.check.eq %v, %c2, "cast 2147483648.0 to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_si32_underflow
+  vm.func @test_cast_f64_si32_underflow() {
+    %c1 = vm.const.f64 -2147483649.0 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.cast.f64.si32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 -2147483648 : i32
+    vm.check.eq %v, %c2, "cast -2147483649.0 to i32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_ui32_nan
+  vm.func @test_cast_f64_ui32_nan() {
+    %n = vm.const.f64 0.0 : f64
+    %z = vm.const.f64 0.0 : f64
+    %ndno = iree.do_not_optimize(%n) : f64
+    %zdno = iree.do_not_optimize(%z) : f64
+    %c1dno = vm.div.f64 %ndno, %zdno : f64
+    %v = vm.cast.f64.ui32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 0 : i32
+    vm.check.eq %v, %c2, "cast NaN to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_ui32_inf
+  vm.func @test_cast_f64_ui32_inf() {
+    %n = vm.const.f64 1.0 : f64
+    %z = vm.const.f64 0.0 : f64
+    %ndno = iree.do_not_optimize(%n) : f64
+    %zdno = iree.do_not_optimize(%z) : f64
+    %c1dno = vm.div.f64 %ndno, %zdno : f64
+    %v = vm.cast.f64.ui32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 -1 : i32
+    vm.check.eq %v, %c2, "cast +inf to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_ui32_neg_inf
+  vm.func @test_cast_f64_ui32_neg_inf() {
+    %n = vm.const.f64 -1.0 : f64
+    %z = vm.const.f64 0.0 : f64
+    %ndno = iree.do_not_optimize(%n) : f64
+    %zdno = iree.do_not_optimize(%z) : f64
+    %c1dno = vm.div.f64 %ndno, %zdno : f64
+    %v = vm.cast.f64.ui32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 0 : i32
+    vm.check.eq %v, %c2, "cast -inf to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_ui32_overflow
+  vm.func @test_cast_f64_ui32_overflow() {
+    %c1 = vm.const.f64 4294967296.0 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.cast.f64.ui32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 -1 : i32
+    vm.check.eq %v, %c2, "cast 4294967296.0 to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_cast_f64_ui32_underflow
+  vm.func @test_cast_f64_ui32_underflow() {
+    %c1 = vm.const.f64 -1.0 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.cast.f64.ui32 %c1dno : f64 -> i32
+    %c2 = vm.const.i32 0 : i32
+    vm.check.eq %v, %c2, "cast -1.0 to ui32" : i32
+    vm.return
+  }
+
+  vm.export @test_trunc_f64_f32
+  vm.func @test_trunc_f64_f32() {
+    %c1 = vm.const.f64 -1.25 : f64
+    %c1dno = iree.do_not_optimize(%c1) : f64
+    %v = vm.trunc.f64.f32 %c1dno : f64 -> f32
+    %c2 = vm.const.f32 -1.25 : f32
+    vm.check.eq %v, %c2, "trunc -1.25 to f32" : f32
+    vm.return
+  }
+
+  vm.export @test_ext_f32_f64
+  vm.func @test_ext_f32_f64() {
+    %c1 = vm.const.f32 0.75 : f32
+    %c1dno = iree.do_not_optimize(%c1) : f32
+    %v = vm.ext.f32.f64 %c1dno : f32 -> f64
+    %c2 = vm.const.f64 0.75 : f64
+    vm.check.eq %v, %c2, "ext 0.75 to f64" : f64
+    vm.return
+  }
+
+}